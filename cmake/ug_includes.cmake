@@ -193,6 +193,8 @@ option(USE_LUAJIT "Use LUA just in time compiler" OFF)
 option(USE_AUTODIFF "Use Autodiff" OFF)
 option(USE_PYBIND11 "Use PYBIND11" OFF)
 option(USE_JSON "Use JSON" OFF)
+option(USE_ZLIB "Use zlib for compressed vtk output" OFF)
+option(ASYNC_IO "Enables asynchronous file output in a background thread. Valid options are ON, OFF" OFF)
 option(USE_XEUS "Use XEUS" OFF)
 
 ################################################################################
@@ -275,10 +277,12 @@ message(STATUS "Info: EMBEDDED_PLUGINS   ${EMBEDDED_PLUGINS} (options are: ON, O
 message(STATUS "Info: COMPILE_INFO       ${COMPILE_INFO} (options are: ON, OFF)")
 message(STATUS "Info: USE_LUA2C          ${USE_LUA2C} (options are: ON, OFF)")
 message(STATUS "Info: USE_LUAJIT         ${USE_LUAJIT} (options are: ON, OFF)")
+message(STATUS "Info: ASYNC_IO           ${ASYNC_IO} (options are: ON, OFF)")
 message(STATUS "")
 message(STATUS "Info: External libraries (path which contains the library or ON if you used uginstall):")
 message(STATUS "Info: HLIBPRO:           ${HLIBPRO}")
 message(STATUS "Info: USE_JSON:          ${USE_JSON} (options are: ON, OFF)")
+message(STATUS "Info: USE_ZLIB:          ${USE_ZLIB} (options are: ON, OFF)")
 message(STATUS "Info: USE_XEUS:          ${USE_XEUS} (options are: ON, OFF)")
 message(STATUS "Info: USE_PYBIND11:      ${USE_PYBIND11} (options are: ON, OFF)")
 message(STATUS "Info: USE_AUTODIFF:      ${USE_AUTODIFF} (options are: ON, OFF)")
@@ -438,6 +442,8 @@ include(${UG_ROOT_CMAKE_PATH}/ug/lua2c.cmake)
 include(${UG_ROOT_CMAKE_PATH}/ug/luajit.cmake)
 # JSON
 include(${UG_ROOT_CMAKE_PATH}/ug/json.cmake)
+# ZLIB
+include(${UG_ROOT_CMAKE_PATH}/ug/zlib.cmake)
 # Pybind11
 include(${UG_ROOT_CMAKE_PATH}/ug/pybind11.cmake)
 # Autodiff
@@ -509,6 +515,14 @@ elseif(WIN32)
 	set(linkLibraries ${linkLibraries} Kernel32)
 endif(UNIX)
 
+########################################
+# threads (used by the asynchronous file output)
+if(ASYNC_IO)
+	find_package(Threads REQUIRED)
+	set(linkLibraries ${linkLibraries} ${CMAKE_THREAD_LIBS_INIT})
+	add_definitions(-DUG_ASYNC_IO)
+endif(ASYNC_IO)
+
 
 
 
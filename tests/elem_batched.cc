@@ -0,0 +1,108 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/spatial_disc/domain_disc.h"
+#include "lib_disc/spatial_disc/elem_disc/neumann_boundary/fv1/neumann_boundary_fv1.h"
+#include "lib_disc/spatial_disc/user_data/std_glob_pos_data.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+#include <cstdio>
+
+// batched element loop test: the defect assembled with the batched functions
+// has to match the defect of the element-wise functions, also for position
+// dependent data
+
+using namespace ug;
+typedef CPUAlgebra A;
+typedef A::vector_type V;
+typedef GridFunction<Domain2d, A> GF;
+
+double max_diff(V const& a, V const& b)
+{
+	double d = 0.;
+	for(size_t i=0; i<a.size(); ++i){
+		d = std::max(d, std::fabs(a[i] - b[i]));
+	}
+	return d;
+}
+
+// position dependent flux
+struct PosFlux : public StdGlobPosData<PosFlux, number, 2>
+{
+	inline void evaluate(number& value, const MathVector<2>& x, number time, int si) const
+	{value = 1.0 + x[0]*x[1] + std::sin(5*x[1]);}
+	virtual bool continuous() const {return true;}
+};
+
+// the same disc with element-wise functions only
+struct NeumannNoBatch : public NeumannBoundaryFV1<Domain2d>
+{
+	NeumannNoBatch() : NeumannBoundaryFV1<Domain2d>("c")
+	{
+		for(int r=0; r<NUM_REFERENCE_OBJECTS; ++r){
+			ReferenceObjectID roid = (ReferenceObjectID) r;
+			this->remove_prep_elem_batch_fct(roid);
+			this->remove_add_jac_A_elem_batch_fct(roid);
+			this->remove_add_def_A_elem_batch_fct(roid);
+			this->remove_add_rhs_elem_batch_fct(roid);
+		}
+	}
+};
+
+void add_data(NeumannBoundaryBase<Domain2d>& neumann)
+{
+	neumann.add(SmartPtr<CplUserData<number, 2> >(new PosFlux), "Dirichlet", "Inner");
+	neumann.add(1.5, "Dirichlet", "Inner");
+	std::vector<number> flux(2); flux[0] = 0.3; flux[1] = -0.7;
+	neumann.add(flux, "Dirichlet", "Inner");
+}
+
+number defect(SmartPtr<ApproximationSpace<Domain2d> > approx,
+              SmartPtr<NeumannBoundaryFV1<Domain2d> > neumann, V& d)
+{
+	add_data(*neumann);
+	DomainDiscretization<Domain2d, A> domDisc(approx);
+	domDisc.add(SmartPtr<IElemDisc<Domain2d> >(neumann));
+
+	GF u(approx);
+	u.set(0.0);
+	domDisc.assemble_defect(d, u);
+	return d.norm();
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		SmartPtr<Domain2d> dom(new Domain2d);
+		LoadDomain(*dom, "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx");
+		GlobalMultiGridRefiner ref(*dom->grid(), dom->refinement_projector());
+		for(int i=0; i<4; ++i) ref.refine();
+
+		SmartPtr<ApproximationSpace<Domain2d> > approx(new ApproximationSpace<Domain2d>(dom));
+		approx->add("c", "Lagrange", 1);
+		approx->init_levels();
+		approx->init_top_surface();
+
+		SmartPtr<NeumannBoundaryFV1<Domain2d> > batched(new NeumannBoundaryFV1<Domain2d>("c"));
+		SmartPtr<NeumannBoundaryFV1<Domain2d> > elemwise(new NeumannNoBatch);
+		std::cout << "batched " << batched->batched_def_A_supported(ROID_TRIANGLE)
+				<< " element-wise " << elemwise->batched_def_A_supported(ROID_TRIANGLE) << "\n";
+		assert(batched->batched_def_A_supported(ROID_TRIANGLE));
+		assert(!elemwise->batched_def_A_supported(ROID_TRIANGLE));
+
+		V dRef, d;
+		const number normRef = defect(approx, elemwise, dRef);
+		defect(approx, batched, d);
+		std::cout << "nonzero " << (normRef > 0) << ", difference " << max_diff(d, dRef) << "\n";
+		assert(normRef > 0);
+		assert(max_diff(d, dRef) == 0.);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,78 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/spatial_disc/domain_disc.h"
+#include "lib_disc/spatial_disc/elem_disc/neumann_boundary/fv1/neumann_boundary_fv1.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+#include <cstdio>
+
+// threaded element loop test: the defect assembled with copies of the disc
+// for every thread has to match the serial defect
+
+using namespace ug;
+typedef CPUAlgebra A;
+typedef A::vector_type V;
+typedef GridFunction<Domain2d, A> GF;
+
+double max_diff(V const& a, V const& b)
+{
+	double d = 0.;
+	for(size_t i=0; i<a.size(); ++i){
+		d = std::max(d, std::fabs(a[i] - b[i]));
+	}
+	return d;
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		SmartPtr<Domain2d> dom(new Domain2d);
+		LoadDomain(*dom, "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx");
+		GlobalMultiGridRefiner ref(*dom->grid(), dom->refinement_projector());
+		for(int i=0; i<4; ++i) ref.refine();
+
+		SmartPtr<ApproximationSpace<Domain2d> > approx(new ApproximationSpace<Domain2d>(dom));
+		approx->add("c", "Lagrange", 1);
+		approx->init_levels();
+		approx->init_top_surface();
+
+		SmartPtr<NeumannBoundaryFV1<Domain2d> > neumann(new NeumannBoundaryFV1<Domain2d>("c"));
+		NeumannBoundaryBase<Domain2d>& base = *neumann;
+		base.add(1.5, "Dirichlet", "Inner");
+		std::vector<number> flux(2); flux[0] = 0.3; flux[1] = -0.7;
+		base.add(flux, "Dirichlet", "Inner");
+
+		SmartPtr<DomainDiscretization<Domain2d, A> > domDisc(new DomainDiscretization<Domain2d, A>(approx));
+		domDisc->add(SmartPtr<IElemDisc<Domain2d> >(neumann));
+		std::cout << "copy supported " << neumann->clone_for_thread_supported() << "\n";
+		assert(neumann->clone_for_thread_supported());
+
+		GF u(approx);
+		u.set(0.0);
+		V dRef, d;
+
+		domDisc->assemble_defect(dRef, u);
+		std::cout << "serial nonzero " << (dRef.norm() > 0) << "\n";
+		assert(dRef.norm() > 0);
+
+		domDisc->ass_tuner()->set_num_threads(4);
+		domDisc->ass_tuner()->set_deterministic_assembling(true);
+		domDisc->assemble_defect(d, u);
+		std::cout << "deterministic " << max_diff(d, dRef) << "\n";
+		assert(max_diff(d, dRef) == 0.);
+
+		domDisc->ass_tuner()->set_deterministic_assembling(false);
+		domDisc->assemble_defect(d, u);
+		std::cout << "colored " << (max_diff(d, dRef) < 1e-14) << "\n";
+		assert(max_diff(d, dRef) < 1e-14);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,115 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/algebra_common/level_schedule.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_algebra/operator/preconditioner/gauss_seidel.h"
+#include "lib_algebra/operator/preconditioner/ilu.h"
+#include <cstdio>
+
+// level scheduled sweep test: Gauss-Seidel type smoothers and ILU applied
+// with several threads have to give the same results as the serial sweeps,
+// bit by bit, also after new values have been set.
+
+using namespace ug;
+typedef CPUAlgebra::matrix_type M;
+typedef CPUAlgebra::vector_type V;
+
+// n x n grid, more rows than the threading minimum
+const size_t n = 130;
+
+// convection-diffusion with the 5-point stencil and upwind convection c
+void convection_diffusion(M& A, double c)
+{
+	A.resize_and_clear(n*n, n*n);
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			const size_t i = y*n + x;
+			A(i,i) = 4 + 1.5*c;
+			if(x>0)   A(i,i-1) = -1 - c;
+			if(x+1<n) A(i,i+1) = -1;
+			if(y>0)   A(i,i-n) = -1 - 0.5*c;
+			if(y+1<n) A(i,i+n) = -1;
+		}
+#ifdef UG_PARALLEL
+	A.set_storage_type(PST_ADDITIVE);
+#endif
+}
+
+// applies the preconditioner to d with the given number of threads
+void apply(V& c, IPreconditioner<CPUAlgebra>& precond,
+           SmartPtr<MatrixOperator<M, V> > op, int numThreads)
+{
+//	the library may be compiled without OpenMP and warns
+	GetLogAssistant().enable_terminal_output(false);
+	SetAlgebraNumThreads(numThreads);
+	GetLogAssistant().enable_terminal_output(true);
+
+	V d(op->get_matrix().num_rows());
+	for(size_t i=0; i<d.size(); ++i) d[i] = std::sin(0.37*i);
+	c.resize(d.size());
+	c.set(0.0);
+#ifdef UG_PARALLEL
+	d.set_storage_type(PST_ADDITIVE);
+	c.set_storage_type(PST_CONSISTENT);
+#endif
+	UG_COND_THROW(!precond.init(op), "init failed");
+	UG_COND_THROW(!precond.apply(c, d), "apply failed");
+}
+
+bool same(const V& a, const V& b)
+{
+	for(size_t i=0; i<a.size(); ++i)
+		if(a[i] != b[i]) return false;
+	return a.size() == b.size();
+}
+
+// serial and threaded results, for two sets of values of the same pattern
+void test(const char* name, IPreconditioner<CPUAlgebra>& precond)
+{
+	SmartPtr<MatrixOperator<M, V> > op(new MatrixOperator<M, V>);
+	V serial, threaded;
+	bool bSame = true;
+	for(int k=0; k<2; ++k){
+		convection_diffusion(op->get_matrix(), 0.5 + k);
+		apply(serial, precond, op, 1);
+		apply(threaded, precond, op, 4);
+		bSame &= same(serial, threaded);
+	}
+	std::cout << name << ": same as serial " << bSame << "\n";
+	assert(bSame);
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+	//	the level of row (x, y) is x + y in both directions
+		M A;
+		convection_diffusion(A, 1.0);
+		TriangularLevelSchedule lower, upper;
+		lower.init_lower(A);
+		upper.init_upper(A);
+		bool bLevels = (lower.num_levels() == 2*n - 1 && upper.num_levels() == 2*n - 1);
+		for(size_t l=0; l<lower.num_levels(); ++l)
+			for(size_t k=lower.level_start(l); k<lower.level_start(l+1); ++k){
+				bLevels &= (lower.row(k) % n + lower.row(k) / n == l);
+				bLevels &= (upper.row(k) % n + upper.row(k) / n == 2*n - 2 - l);
+			}
+		std::cout << "levels " << lower.num_levels() << ", rows by level " << bLevels << "\n";
+		assert(bLevels);
+
+		GaussSeidel<CPUAlgebra> gs;
+		BackwardGaussSeidel<CPUAlgebra> bgs;
+		SymmetricGaussSeidel<CPUAlgebra> sgs;
+		ILU<CPUAlgebra> ilu;
+		test("GaussSeidel", gs);
+		test("BackwardGaussSeidel", bgs);
+		test("SymmetricGaussSeidel", sgs);
+		test("ILU", ilu);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,109 @@
+#include "pcl/pcl_base.h"
+#include "bindings/lua/lua_util.h"
+#include "bindings/lua/compiler/lua_compiler.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+// LUA2VM kernel cache test: a redefined lua function must not reuse the
+// kernel of the old function, even if the old function has been collected
+
+using namespace ug;
+namespace ug{ extern bool useLua2VM; }
+
+lua_State* L;
+
+// the compiler reads the source of a function from its file, so every chunk
+// is written to a file of its own (removed at the end)
+std::vector<std::string> vFile;
+
+void run(const char* code)
+{
+	std::stringstream ss; ss << "lua_cache_" << vFile.size() << ".lua";
+	vFile.push_back(ss.str());
+	std::ofstream f(vFile.back().c_str());
+	f << code << "\n";
+	f.close();
+	if(luaL_dofile(L, vFile.back().c_str()) != 0)
+		UG_THROW("lua error: " << lua_tostring(L, -1));
+}
+
+// evaluates the function on top of the stack (popped) with the interpreter
+double interp(const double* in, int nIn)
+{
+	for(int i=0; i<nIn; ++i) lua_pushnumber(L, in[i]);
+	if(lua_pcall(L, nIn, 1, 0) != 0)
+		UG_THROW("lua error: " << lua_tostring(L, -1));
+	double r = lua_tonumber(L, -1);
+	lua_pop(L, 1);
+	return r;
+}
+
+// compiles and compares the compiled and interpreted results at some points
+bool same(const char* name, LuaFunctionHandle* pHandle)
+{
+	bridge::LUACompiler c;
+	if(!c.create(name, pHandle)) return false;
+	assert(c.num_in() == 4 && c.num_out() == 1);
+	for(int k=0; k<5; ++k){
+		double in[4] = {0.3*k, -1.1*k + 2, 0.5, 0};
+		double res;
+		c.call(&res, in);
+		if(pHandle) lua_rawgeti(L, LUA_REGISTRYINDEX, pHandle->ref);
+		else lua_getglobal(L, name);
+		const double ref = interp(in, 4);
+		if(std::fabs(res - ref) > 1e-14*(1 + std::fabs(ref))) return false;
+	}
+	return true;
+}
+
+void report(const char* what, bool bSame)
+{
+	std::cout << what << " " << bSame << "\n";
+	assert(bSame);
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		L = script::GetDefaultLuaState();
+		useLua2VM = true;
+
+		run("function f(x, y, t, si) return x*y + 1 end");
+		report("first", same("f", NULL));
+		report("cached", same("f", NULL));
+
+		run("function f(x, y, t, si) return x - 2*y end");
+		report("redefined", same("f", NULL));
+
+		// the old function is released, the new one may reuse its memory
+		run("f = nil; collectgarbage(); collectgarbage()");
+		run("function f(x, y, t, si) return y*y - x end");
+		report("collected and redefined", same("f", NULL));
+
+		// handles are cached by their registry reference
+		run("function g(x, y, t, si) return 3*x + y end");
+		LuaFunctionHandle h;
+		lua_getglobal(L, "g");
+		h.ref = luaL_ref(L, LUA_REGISTRYINDEX);
+		report("handle", same("g", &h));
+		report("handle cached", same("g", &h));
+
+		// a new function under a reused reference
+		luaL_unref(L, LUA_REGISTRYINDEX, h.ref);
+		run("function g(x, y, t, si) return x/(1 + y*y) end");
+		lua_getglobal(L, "g");
+		h.ref = luaL_ref(L, LUA_REGISTRYINDEX);
+		report("handle redefined", same("g", &h));
+
+		bridge::LUACompiler::clear_cache();
+		report("after clear", same("f", NULL));
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	for(size_t i=0; i<vFile.size(); ++i) remove(vFile[i].c_str());
+	pcl::Finalize();
+}
@@ -0,0 +1,124 @@
+#include "pcl/pcl_base.h"
+#include "bindings/lua/lua_util.h"
+#include "bindings/lua/compiler/lua_parser_class.h"
+#include "bindings/lua/compiler/vm.h"
+#include "bindings/lua/compiler/register_vm.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+// LUA2VM test: the stack VM and the register VM (single and batched
+// evaluation) have to give the results of the lua interpreter
+
+using namespace ug;
+
+lua_State* L;
+
+// the compiler reads the source of a function from its file, so every chunk
+// is written to a file of its own (removed at the end)
+std::vector<std::string> vFile;
+
+void run(const char* code)
+{
+	std::stringstream ss; ss << "lua_vm_" << vFile.size() << ".lua";
+	vFile.push_back(ss.str());
+	std::ofstream f(vFile.back().c_str());
+	f << code << "\n";
+	f.close();
+	if(luaL_dofile(L, vFile.back().c_str()) != 0)
+		UG_THROW("lua error: " << lua_tostring(L, -1));
+}
+
+// evaluates the global function name with the interpreter
+void interp(const char* name, double* ret, int nOut, const double* in, int nIn)
+{
+	lua_getglobal(L, name);
+	for(int i=0; i<nIn; ++i) lua_pushnumber(L, in[i]);
+	if(lua_pcall(L, nIn, nOut, 0) != 0)
+		UG_THROW("lua error: " << lua_tostring(L, -1));
+	for(int i=0; i<nOut; ++i) ret[i] = lua_tonumber(L, i - nOut);
+	lua_pop(L, nOut);
+}
+
+bool agree(const std::vector<double>& a, const std::vector<double>& b)
+{
+	for(size_t i=0; i<a.size(); ++i)
+		if(std::fabs(a[i] - b[i]) > 1e-14*(1 + std::fabs(b[i]))) return false;
+	return true;
+}
+
+// 37 argument sets, not a multiple of the lane number. The arguments are
+// spread such that the lanes of a block take different branches.
+const size_t N = 37;
+
+void test(const char* name)
+{
+	LUAParserClass parser;
+	UG_COND_THROW(parser.parse_luaFunction(name) != LUAParserClass::LUAParserOK,
+			"could not parse " << name);
+	VMAdd vm;
+	UG_COND_THROW(!parser.createVM(vm), "could not create the VM for " << name);
+	RegisterVM rvm(vm);
+
+	const size_t nIn = vm.num_in(), nOut = vm.num_out();
+	assert(rvm.num_in() == nIn && rvm.num_out() == nOut);
+
+	std::vector<double> in(N*nIn), ref(N*nOut), stack(N*nOut), reg(N*nOut), batch(N*nOut);
+	for(size_t k=0; k<N; ++k){
+		for(size_t i=0; i<nIn; ++i)
+			in[k*nIn + i] = (i == 3) ? double(k%3) : 2*std::sin(1.3*k + 0.7*i);
+		interp(name, &ref[k*nOut], nOut, &in[k*nIn], nIn);
+		vm.execute(&stack[k*nOut], &in[k*nIn]);
+		rvm.execute(&reg[k*nOut], &in[k*nIn]);
+	}
+	rvm.execute_batch(&batch[0], &in[0], N);
+
+	std::cout << name << ": stack " << agree(stack, ref) << " register " << agree(reg, ref)
+			<< " batch " << agree(batch, ref) << "\n";
+	assert(agree(stack, ref) && agree(reg, ref) && agree(batch, ref));
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		L = script::GetDefaultLuaState();
+
+		run("function arith(x, y, t, si) return x*y - 2.5*x/(1 + y*y) + t end");
+		test("arith");
+
+		run("function unary(x, y, t, si) return -(x - y)*(-t) - -x end");
+		test("unary");
+
+		run("function mathfct(x, y, t, si)"
+			"  return math.sin(x)*math.exp(-y*y) + math.cos(t) + math.sqrt(math.abs(x*y))"
+			"    + math.log(1 + x*x) - math.log10(2 + y) + math.floor(y) - math.ceil(x)"
+			"    + math.max(x, y) - math.min(x, t) + math.pi "
+			"end");
+		test("mathfct");
+
+		run("function branch(x, y, t, si)"
+			"  local r = 0"
+			"  if x > y then r = x - y"
+			"  elseif x*x + y*y < 1 and t >= 0.5 then r = 2"
+			"  elseif si == 1 or y <= -1 then r = 3*y"
+			"  else r = -x end"
+			"  if r ~= 0 then r = r + 1 end"
+			"  return r "
+			"end");
+		test("branch");
+
+		run("function multi(x, y, t) return x + y, x - y, x*y end");
+		test("multi");
+
+		run("function sq(a) return a*a + 1 end\n"
+			"function sub(x, y, t, si) local s = sq(x) return s - sq(y) + sq(t) end");
+		test("sub");
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	for(size_t i=0; i<vFile.size(); ++i) remove(vFile[i].c_str());
+	pcl::Finalize();
+}
@@ -0,0 +1,151 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "lib_algebra/operator/linear_solver/gmres.h"
+#include "lib_algebra/operator/preconditioner/ilu.h"
+#include "lib_algebra/operator/convergence_check.h"
+#include "lib_disc/operator/non_linear_operator/newton_solver/newton.h"
+#include <cstdio>
+
+// Newton test: the adaptive reuse of the Jacobian and the Jacobian-free mode
+// have to reach the solution of the full Newton method with less assemblies
+// of the Jacobian, the Jacobian-free mode in the same number of steps.
+
+using namespace ug;
+typedef CPUAlgebra A;
+typedef A::matrix_type M;
+typedef A::vector_type V;
+#define NOT_USED { UG_THROW("not used"); }
+
+// 1d -u'' + k u^3 = 1, u(0) = u(1) = 0, finite differences
+struct CubicDisc : public IAssemble<A>
+{
+	size_t n; number h, k; int numJac;
+	SmartPtr<AssemblingTuner<A> > tuner;
+
+	CubicDisc(size_t n_, number k_) : n(n_), h(1.0/(n_-1)), k(k_), numJac(0), tuner(new AssemblingTuner<A>) {}
+
+	bool bnd(size_t i) {return i==0 || i==n-1;}
+
+	virtual void assemble_jacobian(M& J, const V& u, const GridLevel&)
+	{
+		++numJac;
+		J.resize_and_clear(n, n);
+		for(size_t i=0; i<n; ++i){
+			if(bnd(i)) {J(i,i) = 1.0; continue;}
+			J(i,i) = 2/(h*h) + 3*k*u[i]*u[i];
+			J(i,i-1) = -1/(h*h);
+			J(i,i+1) = -1/(h*h);
+		}
+#ifdef UG_PARALLEL
+		J.set_storage_type(PST_ADDITIVE);
+#endif
+	}
+	virtual void assemble_defect(V& d, const V& u, const GridLevel&)
+	{
+		d.resize(n);
+		for(size_t i=0; i<n; ++i)
+			d[i] = bnd(i) ? u[i] : (2*u[i]-u[i-1]-u[i+1])/(h*h) + k*u[i]*u[i]*u[i] - 1;
+#ifdef UG_PARALLEL
+		d.set_storage_type(PST_ADDITIVE);
+#endif
+	}
+	virtual void adjust_solution(V& u, const GridLevel&) {u[0] = 0; u[n-1] = 0;}
+
+	virtual void assemble_linear(M&, V&, const GridLevel&) NOT_USED
+	virtual void assemble_rhs(V&, const V&, const GridLevel&) NOT_USED
+	virtual void assemble_rhs(V&, const GridLevel&) NOT_USED
+	virtual size_t num_constraints() const {return 0;}
+	virtual SmartPtr<IConstraint<A> > constraint(size_t) NOT_USED
+	virtual SmartPtr<AssemblingTuner<A> > ass_tuner() {return tuner;}
+	virtual ConstSmartPtr<AssemblingTuner<A> > ass_tuner() const {return tuner;}
+};
+
+const size_t N = 101;
+
+// GMRES with ILU as linear solver, returns the convergence check of the Newton method
+SmartPtr<StdConvCheck<V> > setup(NewtonSolver<A>& newton, SmartPtr<CubicDisc> disc,
+                                 number linReduction = 1e-8)
+{
+	SmartPtr<GMRES<V> > gmres(new GMRES<V>(30));
+	gmres->set_preconditioner(make_sp(new ILU<A>));
+	gmres->set_convergence_check(make_sp(new StdConvCheck<V>(100, 1e-14, linReduction, false)));
+	newton.set_linear_solver(gmres);
+	SmartPtr<StdConvCheck<V> > convCheck(new StdConvCheck<V>(30, 1e-9, 1e-12, false));
+	newton.set_convergence_check(convCheck);
+	newton.init(make_sp(new AssembledOperator<A>(disc, GridLevel())));
+	return convCheck;
+}
+
+// solves starting at u
+void solve(NewtonSolver<A>& newton, V& u)
+{
+#ifdef UG_PARALLEL
+	u.set_storage_type(PST_CONSISTENT);
+#endif
+//	the Newton method and GMRES print their steps
+	GetLogAssistant().enable_terminal_output(false);
+	const bool bSolved = newton.apply(u);
+	GetLogAssistant().enable_terminal_output(true);
+	UG_COND_THROW(!bSolved, "Newton failed");
+}
+
+double max_diff(const V& a, const V& b)
+{
+	double d = 0;
+	for(size_t i=0; i<a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+	return d;
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		const number k = 2000;
+		V uFull(N), uReuse(N), uJF(N);
+		uFull.set(0.0); uReuse.set(0.0); uJF.set(0.0);
+
+		SmartPtr<CubicDisc> disc(new CubicDisc(N, k));
+		NewtonSolver<A> full;
+		SmartPtr<StdConvCheck<V> > convCheck = setup(full, disc);
+		solve(full, uFull);
+		const int stepsFull = convCheck->step();
+		std::cout << "full: steps " << stepsFull << ", assemblies " << disc->numJac << "\n";
+		assert(disc->numJac == stepsFull);
+
+		SmartPtr<CubicDisc> discReuse(new CubicDisc(N, k));
+		NewtonSolver<A> reuse;
+		setup(reuse, discReuse);
+		reuse.set_jacobian_reuse_rate(0.5);
+		reuse.set_jacobian_reuse_across_calls(true);
+		solve(reuse, uReuse);
+		std::cout << "reuse: assemblies " << discReuse->numJac
+				<< ", same solution " << (max_diff(uReuse, uFull) < 1e-10) << "\n";
+		assert(discReuse->numJac < disc->numJac && max_diff(uReuse, uFull) < 1e-10);
+
+	//	a second call near the solution keeps the Jacobian of the first call
+		const int numJac = discReuse->numJac;
+		for(size_t i=0; i<uReuse.size(); ++i) uReuse[i] *= 1.001;
+		solve(reuse, uReuse);
+		std::cout << "across calls: assemblies " << discReuse->numJac - numJac
+				<< ", same solution " << (max_diff(uReuse, uFull) < 1e-10) << "\n";
+		assert(discReuse->numJac == numJac && max_diff(uReuse, uFull) < 1e-10);
+
+		SmartPtr<CubicDisc> discJF(new CubicDisc(N, k));
+		NewtonSolver<A> jf;
+	//	the finite differences limit the accuracy of the linear solves
+		convCheck = setup(jf, discJF, 1e-5);
+		jf.set_jacobian_free(true);
+		jf.set_jacobian_reuse_rate(0.5);
+		solve(jf, uJF);
+		const int stepsJF = convCheck->step();
+		std::cout << "Jacobian-free: steps " << stepsJF << ", assemblies " << discJF->numJac
+				<< ", same solution " << (max_diff(uJF, uFull) < 1e-10) << "\n";
+		assert(stepsJF <= stepsFull + 1 && discJF->numJac < disc->numJac && max_diff(uJF, uFull) < 1e-10);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
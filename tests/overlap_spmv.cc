@@ -0,0 +1,131 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_algebra/operator/linear_solver/cg.h"
+#include "lib_algebra/operator/linear_solver/bicgstab.h"
+#include "lib_algebra/operator/convergence_check.h"
+#include <cstdio>
+
+// overlapped halo exchange test: A*x computed while x is made consistent has
+// to match A*x with consistent x, CG and BiCGStab have to solve with it.
+// The nodes of a 1d grid are split into two parts on this process, coupled
+// by an interface from the process to itself.
+
+using namespace ug;
+typedef CPUAlgebra::matrix_type M;
+typedef CPUAlgebra::vector_type V;
+
+// nodes 0..N-1, the nodes FIRST..LAST have slave copies at N..N+LAST-FIRST,
+// the elements between them are assembled at the copies
+const size_t N = 60, FIRST = 20, LAST = 29, NUM = N + LAST - FIRST + 1;
+
+size_t local_index(size_t node, bool bCopy)
+{
+	return bCopy ? N + node - FIRST : node;
+}
+
+void assemble(M& A, SmartPtr<AlgebraLayouts> layouts)
+{
+	A.resize_and_clear(NUM, NUM);
+	for(size_t e=0; e+1<N; ++e){
+		const bool bCopy = (e >= FIRST && e+1 <= LAST);
+		const size_t i = local_index(e, bCopy), j = local_index(e+1, bCopy);
+		A(i,i) += 1.05; A(j,j) += 1.05;
+		A(i,j) += -1;   A(j,i) += -1;
+	}
+	A(0,0) += 1;
+	A.set_storage_type(PST_ADDITIVE);
+	A.set_layouts(layouts);
+}
+
+void init(V& v, SmartPtr<AlgebraLayouts> layouts, ParallelStorageType type)
+{
+	v.resize(NUM);
+	v.set_layouts(layouts);
+	for(size_t i=0; i<NUM; ++i) v[i] = std::sin(0.7*i + 0.2);
+	v.set_storage_type(type);
+	if(type == PST_UNIQUE)
+		for(size_t i=N; i<NUM; ++i) v[i] = 0;
+}
+
+double max_diff(const V& a, const V& b)
+{
+	double d = 0;
+	for(size_t i=0; i<a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+	return d;
+}
+
+// A*x with the overlapped exchange vs. A*x with consistent x
+void test_apply(const char* name, const M& A, SmartPtr<AlgebraLayouts> layouts,
+                ParallelStorageType type)
+{
+	V x, xRef, res(NUM), resRef(NUM);
+	init(x, layouts, type);
+	init(xRef, layouts, type);
+	UG_COND_THROW(!xRef.change_storage_type(PST_CONSISTENT), "no consistent x");
+	A.apply(resRef, xRef);
+
+	A.apply_make_consistent(res, x);
+	std::cout << name << ": consistent " << x.has_storage_type(PST_CONSISTENT)
+			<< ", x " << (max_diff(x, xRef) == 0) << ", A*x " << (max_diff(res, resRef) == 0)
+			<< ", interior rows " << A.last_overlap_timing().numInteriorRows
+			<< ", boundary rows " << A.last_overlap_timing().numBoundaryRows << "\n";
+	assert(x.has_storage_type(PST_CONSISTENT) && max_diff(x, xRef) == 0 && max_diff(res, resRef) == 0);
+}
+
+template<typename TSolver>
+void test_solver(const char* name, TSolver& solver, SmartPtr<MatrixOperator<M, V> > op,
+                 SmartPtr<AlgebraLayouts> layouts)
+{
+	V xExact, b(NUM), x;
+	b.set_layouts(layouts);
+	init(xExact, layouts, PST_UNIQUE);
+	UG_COND_THROW(!xExact.change_storage_type(PST_CONSISTENT), "no consistent x");
+	op->get_matrix().apply(b, xExact);
+	init(x, layouts, PST_CONSISTENT);
+	x.set(0.0);
+
+	solver.set_convergence_check(make_sp(new StdConvCheck<V>(200, 1e-14, 1e-12, false)));
+	UG_COND_THROW(!solver.init(op), "init failed");
+	UG_COND_THROW(!solver.apply(x, b), "apply failed");
+	std::cout << name << ": solved " << (max_diff(x, xExact) < 1e-9) << "\n";
+	assert(max_diff(x, xExact) < 1e-9);
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		SmartPtr<AlgebraLayouts> layouts(new AlgebraLayouts);
+		const int self = pcl::ProcRank();
+		for(size_t k=FIRST; k<=LAST; ++k){
+			layouts->master().interface(self).push_back(local_index(k, false));
+			layouts->slave().interface(self).push_back(local_index(k, true));
+		}
+
+		SmartPtr<MatrixOperator<M, V> > op(new MatrixOperator<M, V>);
+		M& A = op->get_matrix();
+		assemble(A, layouts);
+
+		test_apply("additive", A, layouts, PST_ADDITIVE);
+		test_apply("unique", A, layouts, PST_UNIQUE);
+	//	the ranges are reused for the same pattern, recomputed for a new one
+		test_apply("reused", A, layouts, PST_ADDITIVE);
+		A(FIRST-2, N+1) = 0.0;
+		test_apply("new pattern", A, layouts, PST_ADDITIVE);
+		assemble(A, layouts);
+
+		CG<V> cg;
+		test_solver("CG", cg, op, layouts);
+		cg.set_overlap_communication(true);
+		test_solver("CG overlapped", cg, op, layouts);
+
+		BiCGStab<V> bicgstab;
+		test_solver("BiCGStab", bicgstab, op, layouts);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
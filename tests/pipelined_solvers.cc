@@ -0,0 +1,120 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_algebra/operator/linear_solver/cg.h"
+#include "lib_algebra/operator/linear_solver/pipelined_cg.h"
+#include "lib_algebra/operator/linear_solver/sstep_gmres.h"
+#include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/convergence_check.h"
+#include <cstdio>
+
+// pipelined solver test: PipelinedCG has to solve like CG in about the same
+// number of steps, SStepGMRES has to solve for several s. The nodes of a 1d
+// grid are split into two parts on this process, coupled by an interface from
+// the process to itself, so that the fused reductions and the preconditioner
+// work on distributed vectors.
+
+using namespace ug;
+typedef CPUAlgebra::matrix_type M;
+typedef CPUAlgebra::vector_type V;
+
+// nodes 0..N-1, the nodes FIRST..LAST have slave copies at N..N+LAST-FIRST,
+// the elements between them are assembled at the copies
+const size_t N = 60, FIRST = 20, LAST = 29, NUM = N + LAST - FIRST + 1;
+
+size_t local_index(size_t node, bool bCopy)
+{
+	return bCopy ? N + node - FIRST : node;
+}
+
+// diffusion, with convection c (nonsymmetric for c != 0)
+void assemble(M& A, SmartPtr<AlgebraLayouts> layouts, double c)
+{
+	A.resize_and_clear(NUM, NUM);
+	for(size_t e=0; e+1<N; ++e){
+		const bool bCopy = (e >= FIRST && e+1 <= LAST);
+		const size_t i = local_index(e, bCopy), j = local_index(e+1, bCopy);
+		A(i,i) += 1.05 + c; A(j,j) += 1.05;
+		A(i,j) += -1;       A(j,i) += -1 - c;
+	}
+	A(0,0) += 1;
+	A.set_storage_type(PST_ADDITIVE);
+	A.set_layouts(layouts);
+}
+
+double max_diff(const V& a, const V& b)
+{
+	double d = 0;
+	for(size_t i=0; i<a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+	return d;
+}
+
+// solves A x = A xExact, returns the number of steps
+int solve(IPreconditionedLinearOperatorInverse<V>& solver, SmartPtr<MatrixOperator<M, V> > op,
+          SmartPtr<AlgebraLayouts> layouts)
+{
+	V xExact(NUM), b(NUM), x(NUM);
+	xExact.set_layouts(layouts); b.set_layouts(layouts); x.set_layouts(layouts);
+	for(size_t k=0; k<N; ++k) xExact[k] = std::sin(0.7*k + 0.2);
+	for(size_t k=FIRST; k<=LAST; ++k) xExact[local_index(k, true)] = xExact[k];
+	xExact.set_storage_type(PST_CONSISTENT);
+	op->get_matrix().apply(b, xExact);
+	x.set(0.0);
+
+	SmartPtr<StdConvCheck<V> > convCheck(new StdConvCheck<V>(500, 1e-14, 1e-12, false));
+	solver.set_convergence_check(convCheck);
+	solver.set_preconditioner(make_sp(new Jacobi<CPUAlgebra>(0.8)));
+	UG_COND_THROW(!solver.init(op), solver.name() << ": init failed");
+//	the GMRES variants print their inner steps
+	GetLogAssistant().enable_terminal_output(false);
+	const bool bApplied = solver.apply(x, b);
+	GetLogAssistant().enable_terminal_output(true);
+	UG_COND_THROW(!bApplied, solver.name() << ": apply failed");
+	UG_COND_THROW(max_diff(x, xExact) > 1e-9, solver.name() << ": wrong solution, error "
+				  << max_diff(x, xExact));
+	return convCheck->step();
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		SmartPtr<AlgebraLayouts> layouts(new AlgebraLayouts);
+		const int self = pcl::ProcRank();
+		for(size_t k=FIRST; k<=LAST; ++k){
+			layouts->master().interface(self).push_back(local_index(k, false));
+			layouts->slave().interface(self).push_back(local_index(k, true));
+		}
+		SmartPtr<MatrixOperator<M, V> > op(new MatrixOperator<M, V>);
+
+	//	in exact arithmetic pipelined CG computes the iterates of CG
+		assemble(op->get_matrix(), layouts, 0);
+		CG<V> cg;
+		PipelinedCG<V> pcg;
+		const int stepsCG = solve(cg, op, layouts);
+		const int stepsPCG = solve(pcg, op, layouts);
+		std::cout << "PipelinedCG: solved 1, steps like CG " << (std::abs(stepsPCG - stepsCG) <= 2) << "\n";
+		assert(std::abs(stepsPCG - stepsCG) <= 2);
+
+	//	s-step GMRES for several s, with and without restarts. Without
+	//	restarts, it converges in about the steps of s = 1.
+		assemble(op->get_matrix(), layouts, 0.4);
+		int stepsS1 = 0;
+		const size_t vS[] = {1, 2, 4};
+		for(size_t i=0; i<3; ++i){
+			SStepGMRES<V> sgmres(64, vS[i]);
+			const int steps = solve(sgmres, op, layouts);
+			if(vS[i] == 1) stepsS1 = steps;
+			SStepGMRES<V> restarted(8, vS[i]);
+			solve(restarted, op, layouts);
+			std::cout << "SStepGMRES s=" << vS[i] << ": solved 1, restarted solved 1, steps like s=1 "
+					<< (steps <= stepsS1 + 2*(int)vS[i]) << "\n";
+			assert(steps <= stepsS1 + 2*(int)vS[i]);
+		}
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,138 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/function_spaces/grid_function_global_user_data.h"
+#include "lib_disc/reference_element/reference_mapping_provider.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+#include <cstdio>
+
+// point locator test: GlobalGridFunctionNumberData has to evaluate to the
+// values of the lookup in the search tree it used before the point locator.
+// Points on element boundaries have to be assigned to the same element,
+// independent of the hint, the order of the points and the number of threads.
+
+using namespace ug;
+typedef CPUAlgebra A;
+typedef GridFunction<Domain2d, A> GF;
+typedef GlobalGridFunctionNumberData<GF> Data;
+typedef Data::locator_t Locator;
+
+// the former lookup: element from the search tree, local coordinates from the
+// reference mapping
+bool evaluate_tree(number& value, const Data& data, const lg_ntree<2, 2, Face>& tree,
+                   const Domain2d& dom, const MathVector<2>& x)
+{
+	Face* elem = NULL;
+	if(!FindContainingElement(elem, tree, x)) return false;
+
+	std::vector<MathVector<2> > vCornerCoords;
+	CollectCornerCoordinates(vCornerCoords, *elem, dom);
+	DimReferenceMapping<2, 2>& map
+		= ReferenceMappingProvider::get<2, 2>(elem->reference_object_id(), vCornerCoords);
+	MathVector<2> locPos;
+	VecSet(locPos, 0.5);
+	map.global_to_local(locPos, x);
+	return data.evaluate(value, elem, locPos);
+}
+
+// random points, vertices and edge midpoints of the top level
+void create_points(std::vector<MathVector<2> >& vPos, MultiGrid& mg, const Domain2d& dom)
+{
+	Domain2d::position_accessor_type aaPos = dom.position_accessor();
+	for(size_t i=0; i<500; ++i)
+		vPos.push_back(MathVector<2>(std::sin(1.7*i), std::cos(2.3*i + 0.4)));
+
+	const int top = mg.top_level();
+	for(VertexIterator iter = mg.begin<Vertex>(top); iter != mg.end<Vertex>(top); ++iter)
+		vPos.push_back(aaPos[*iter]);
+	for(EdgeIterator iter = mg.begin<Edge>(top); iter != mg.end<Edge>(top); ++iter){
+		MathVector<2> mid;
+		VecScaleAdd(mid, 0.5, aaPos[(*iter)->vertex(0)], 0.5, aaPos[(*iter)->vertex(1)]);
+		vPos.push_back(mid);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		SmartPtr<Domain2d> dom(new Domain2d);
+		LoadDomain(*dom, "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx");
+		GlobalMultiGridRefiner ref(*dom->grid(), dom->refinement_projector());
+		for(int i=0; i<3; ++i) ref.refine();
+
+		SmartPtr<ApproximationSpace<Domain2d> > approx(new ApproximationSpace<Domain2d>(dom));
+		approx->add("c", "Lagrange", 1);
+		approx->init_top_surface();
+
+		SmartPtr<GF> u(new GF(approx));
+		for(size_t i=0; i<u->size(); ++i) (*u)[i] = std::sin(1.3*i);
+		Data data(u, "c");
+
+		std::vector<Face*> vElem;
+		for(int si=0; si<dom->subset_handler()->num_subsets(); ++si)
+			for(GF::traits<Face>::const_iterator iter = u->begin<Face>(si);
+				iter != u->end<Face>(si); ++iter)
+				vElem.push_back(*iter);
+		lg_ntree<2, 2, Face> tree(*dom->grid(), dom->position_attachment());
+		tree.create_tree(vElem.begin(), vElem.end());
+
+		std::vector<MathVector<2> > vPos;
+		create_points(vPos, *dom->grid(), *dom);
+
+	//	values of the locator and the tree lookup
+		bool bFound = true;
+		number maxDiff = 0;
+		for(size_t i=0; i<vPos.size(); ++i){
+			number value, valueTree;
+			bFound &= data.evaluate(value, vPos[i]);
+			bFound &= evaluate_tree(valueTree, data, tree, *dom, vPos[i]);
+			maxDiff = std::max(maxDiff, std::fabs(value - valueTree));
+		}
+		std::cout << "points " << vPos.size() << ", found " << bFound
+				<< ", same values as the tree lookup " << (maxDiff < 1e-12) << "\n";
+		assert(bFound && maxDiff < 1e-12);
+
+	//	elements of single points, located without hint
+		const Locator& locator = data.locator();
+		std::vector<Face*> vElemSingle(vPos.size());
+		std::vector<MathVector<2> > vLocPos;
+		MathVector<2> locPos;
+		for(size_t i=0; i<vPos.size(); ++i)
+			locator.locate(vElemSingle[i], locPos, vPos[i]);
+
+	//	other hints, a batch, the batch in reverse order and with several threads
+		bool bHint = true;
+		for(size_t i=0; i<vPos.size(); ++i){
+			Face* elem = NULL;
+			locator.locate(elem, locPos, vPos[i], vElemSingle[(i+37) % vPos.size()]);
+			bHint &= (elem == vElemSingle[i]);
+		}
+
+		std::vector<Face*> vElemBatch;
+		locator.locate(vElemBatch, vLocPos, vPos);
+		const bool bBatch = (vElemBatch == vElemSingle);
+
+		std::vector<MathVector<2> > vPosReversed(vPos.rbegin(), vPos.rend());
+		locator.locate(vElemBatch, vLocPos, vPosReversed);
+		const bool bReversed = std::equal(vElemBatch.rbegin(), vElemBatch.rend(), vElemSingle.begin());
+
+		Locator threaded(dom);
+		threaded.create(vElem.begin(), vElem.end());
+		threaded.set_num_threads(4);
+		threaded.locate(vElemBatch, vLocPos, vPos);
+		const bool bThreads = (vElemBatch == vElemSingle);
+
+		std::cout << "same elements: hints " << bHint << ", batch " << bBatch
+				<< ", reversed " << bReversed << ", threads " << bThreads << "\n";
+		assert(bHint && bBatch && bReversed && bThreads);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,121 @@
+#include "pcl/pcl_base.h"
+#include "lib_grid/lib_grid.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+#include "lib_grid/refinement/projectors/refinement_projector.h"
+#include <cstdio>
+
+// threaded refinement test: the grid refined with several threads has to
+// equal the serially refined grid, element by element in the same order.
+
+using namespace ug;
+
+// unconnected hexahedron, tetrahedron, prism, pyramid and octahedron
+void create_grid(MultiGrid& mg)
+{
+	mg.attach_to_vertices(aPosition);
+	Grid::VertexAttachmentAccessor<APosition> aaPos(mg, aPosition);
+
+	std::vector<Vertex*> v;
+	const double hex[8][3] = {{0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+	                          {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1}};
+	for(int i=0; i<8; ++i){
+		v.push_back(*mg.create<RegularVertex>());
+		aaPos[v.back()] = vector3(hex[i][0], hex[i][1], hex[i][2]);
+	}
+	mg.create<Hexahedron>(HexahedronDescriptor(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]));
+
+	v.clear();
+	const double tet[4][3] = {{2,0,0}, {3,0.2,0}, {2.4,1,0}, {2.5,0.4,1}};
+	for(int i=0; i<4; ++i){
+		v.push_back(*mg.create<RegularVertex>());
+		aaPos[v.back()] = vector3(tet[i][0], tet[i][1], tet[i][2]);
+	}
+	mg.create<Tetrahedron>(TetrahedronDescriptor(v[0], v[1], v[2], v[3]));
+
+	v.clear();
+	const double prism[6][3] = {{4,0,0}, {5,0,0}, {4,1,0}, {4,0,1}, {5,0,1}, {4,1,1}};
+	for(int i=0; i<6; ++i){
+		v.push_back(*mg.create<RegularVertex>());
+		aaPos[v.back()] = vector3(prism[i][0], prism[i][1], prism[i][2]);
+	}
+	mg.create<Prism>(PrismDescriptor(v[0], v[1], v[2], v[3], v[4], v[5]));
+
+	v.clear();
+	const double pyra[5][3] = {{6,0,0}, {7,0,0}, {7,1,0}, {6,1,0}, {6.5,0.5,1}};
+	for(int i=0; i<5; ++i){
+		v.push_back(*mg.create<RegularVertex>());
+		aaPos[v.back()] = vector3(pyra[i][0], pyra[i][1], pyra[i][2]);
+	}
+	mg.create<Pyramid>(PyramidDescriptor(v[0], v[1], v[2], v[3], v[4]));
+
+	v.clear();
+	const double octa[6][3] = {{8.5,0.5,-0.7}, {8,0,0}, {9,0,0}, {9,1,0}, {8,1,0}, {8.5,0.5,0.7}};
+	for(int i=0; i<6; ++i){
+		v.push_back(*mg.create<RegularVertex>());
+		aaPos[v.back()] = vector3(octa[i][0], octa[i][1], octa[i][2]);
+	}
+	mg.create<Octahedron>(OctahedronDescriptor(v[0], v[1], v[2], v[3], v[4], v[5]));
+}
+
+void refine(MultiGrid& mg, int numThreads, int numRefs)
+{
+	GlobalMultiGridRefiner ref(mg, make_sp(new RefinementProjector(MakeGeometry3d(mg, aPosition))));
+//	without OpenMP the chunks are created one after another (with a warning)
+	GetLogAssistant().enable_terminal_output(false);
+	ref.set_num_threads(numThreads);
+	GetLogAssistant().enable_terminal_output(true);
+	for(int i=0; i<numRefs; ++i) ref.refine();
+}
+
+size_t num_corners(Vertex* v)				{return 1;}
+Vertex* corner(Vertex* v, size_t i)			{return v;}
+template <class TElem>
+size_t num_corners(TElem* e)				{return e->num_vertices();}
+template <class TElem>
+Vertex* corner(TElem* e, size_t i)			{return e->vertex(i);}
+
+// compares the corners of the elements of type TElem on all levels
+template <class TElem>
+bool same_elements(MultiGrid& mgA, MultiGrid& mgB)
+{
+	Grid::VertexAttachmentAccessor<APosition> aaPosA(mgA, aPosition), aaPosB(mgB, aPosition);
+	if(mgA.num_levels() != mgB.num_levels()) return false;
+	for(size_t lvl=0; lvl<mgA.num_levels(); ++lvl){
+		if(mgA.num<TElem>(lvl) != mgB.num<TElem>(lvl)) return false;
+		typename geometry_traits<TElem>::iterator iterA = mgA.begin<TElem>(lvl),
+		                                         iterB = mgB.begin<TElem>(lvl);
+		for(; iterA != mgA.end<TElem>(lvl); ++iterA, ++iterB){
+			if((*iterA)->reference_object_id() != (*iterB)->reference_object_id()) return false;
+			for(size_t i=0; i<num_corners(*iterA); ++i)
+				if(VecDistance(aaPosA[corner(*iterA, i)], aaPosB[corner(*iterB, i)]) > 0)
+					return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		MultiGrid mgSerial, mgThreaded;
+		create_grid(mgSerial);
+		create_grid(mgThreaded);
+		refine(mgSerial, 1, 3);
+		refine(mgThreaded, 4, 3);
+
+		std::cout << "levels " << mgThreaded.num_levels() << ", volumes on top "
+				<< mgThreaded.num<Volume>(mgThreaded.top_level()) << "\n";
+		std::cout << "vertices " << same_elements<Vertex>(mgSerial, mgThreaded)
+				<< ", edges " << same_elements<Edge>(mgSerial, mgThreaded)
+				<< ", faces " << same_elements<Face>(mgSerial, mgThreaded)
+				<< ", volumes " << same_elements<Volume>(mgSerial, mgThreaded) << "\n";
+		assert(same_elements<Vertex>(mgSerial, mgThreaded) && same_elements<Edge>(mgSerial, mgThreaded)
+			   && same_elements<Face>(mgSerial, mgThreaded) && same_elements<Volume>(mgSerial, mgThreaded));
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,181 @@
+#include "pcl/pcl_base.h"
+#include "common/allocators/slab_allocator.h"
+#include "lib_grid/attachments/attachment_pipe.h"
+#include <algorithm>
+#include <cstdio>
+#include <list>
+
+// slab allocator test: blocks of one size are handed out consecutively,
+// empty slabs are released, concurrent allocations do not overlap.
+// AttachmentPipe test: defragment and align_data_with_elements have to
+// keep the data of the elements.
+
+using namespace ug;
+
+struct TestTag {};
+typedef SlabAllocator<TestTag, 512, 65536> Alloc;
+
+// a slab of 64 KiB holds more than 1300 blocks of 48 bytes
+const size_t BLOCKS = 1300;
+
+void test_slabs()
+{
+	Alloc& a = Alloc::inst();
+	std::vector<void*> v;
+	for(size_t i=0; i<3*BLOCKS; ++i) v.push_back(a.allocate(48));
+	bool bConsecutive = true;
+	for(size_t i=1; i<BLOCKS/2; ++i)
+		bConsecutive &= (static_cast<char*>(v[i]) - static_cast<char*>(v[i-1]) == 48);
+	std::cout << "consecutive " << bConsecutive << ", objects " << a.num_objects()
+			<< ", slabs " << a.num_slabs() << "\n";
+	assert(bConsecutive && a.num_objects() == 3*BLOCKS && a.num_slabs() == 3);
+
+//	freed blocks are reused before a new slab is created
+	void* p = v[10];
+	a.deallocate(v[10], 48);
+	do{
+		v.push_back(a.allocate(48));
+	}while(v.back() != p && a.num_slabs() == 3);
+	v[10] = v.back(); v.pop_back();
+	std::cout << "reused " << (v[10] == p) << ", slabs " << a.num_slabs() << "\n";
+	assert(v[10] == p && a.num_slabs() == 3);
+
+//	all but one empty slab are released
+	for(size_t i=0; i<v.size(); ++i) a.deallocate(v[i], 48);
+	std::cout << "released: objects " << a.num_objects() << ", slabs " << a.num_slabs() << "\n";
+	assert(a.num_objects() == 0 && a.num_slabs() == 1);
+
+//	allocation and deallocation in alternation do not create slabs
+	for(size_t i=0; i<10*BLOCKS; ++i) a.deallocate(a.allocate(48), 48);
+	std::cout << "alternating: slabs " << a.num_slabs() << "\n";
+	assert(a.num_slabs() == 1);
+
+//	large objects
+	p = a.allocate(1000);
+	std::cout << "large: objects " << a.num_objects() << ", slabs " << a.num_slabs() << "\n";
+	assert(a.num_objects() == 1 && a.num_slabs() == 1);
+	a.deallocate(p, 1000);
+}
+
+// allocates blocks of two sizes, writes t into them and frees every second
+// one. The other blocks have to keep their values.
+bool alloc_and_free(int t)
+{
+	Alloc& a = Alloc::inst();
+	const size_t num = 5000;
+	std::vector<int*> v;
+	for(size_t i=0; i<num; ++i){
+		const size_t size = (i % 2) ? 48 : 96;
+		int* p = static_cast<int*>(a.allocate(size));
+		for(size_t j=0; j<size/sizeof(int); ++j) p[j] = t;
+		v.push_back(p);
+	}
+	for(size_t i=0; i<num; i+=2) a.deallocate(v[i], 96);
+	bool bOk = true;
+	for(size_t i=1; i<num; i+=2)
+		for(size_t j=0; j<48/sizeof(int); ++j) bOk = bOk && (v[i][j] == t);
+	for(size_t i=1; i<num; i+=2) a.deallocate(v[i], 48);
+	return bOk;
+}
+
+void test_threads()
+{
+	const int numThreads = 4;
+	int numOk = 0;
+#ifdef UG_OPENMP
+	#pragma omp parallel for num_threads(numThreads) reduction(+:numOk)
+#endif
+	for(int t = 0; t < numThreads; ++t)
+		numOk += alloc_and_free(t);
+	std::cout << "threads: values kept " << (numOk == numThreads) << ", objects "
+			<< Alloc::inst().num_objects() << "\n";
+	assert(numOk == numThreads && Alloc::inst().num_objects() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	elements for an AttachmentPipe
+struct Item
+{
+	Item(int id_) : id(id_), dataIndex(INVALID_ATTACHMENT_INDEX) {}
+	int id;
+	uint dataIndex;
+};
+typedef std::list<Item*> ItemList;
+
+namespace ug{
+template<>
+class attachment_traits<Item*, ItemList>
+{
+	public:
+		typedef Item*&				ElemRef;
+		typedef Item*				ElemPtr;
+		typedef const Item*			ConstElemPtr;
+		typedef ItemList*			ElemHandlerPtr;
+		typedef const ItemList*		ConstElemHandlerPtr;
+		typedef ItemList::iterator	element_iterator;
+
+		static inline element_iterator elements_begin(ElemHandlerPtr pHandler)	{return pHandler->begin();}
+		static inline element_iterator elements_end(ElemHandlerPtr pHandler)	{return pHandler->end();}
+		static inline uint get_data_index(ConstElemHandlerPtr pHandler, ConstElemPtr elem)	{return elem->dataIndex;}
+		static inline void set_data_index(ElemHandlerPtr pHandler, ElemPtr elem, uint index){elem->dataIndex = index;}
+};
+}
+
+typedef AttachmentPipe<Item*, ItemList> Pipe;
+
+// the i-th data entry has to belong to the i-th element
+bool aligned(Pipe& pipe, ItemList& items, Attachment<int>& aVal)
+{
+	Attachment<int>::ContainerType& val = *pipe.get_data_container(aVal);
+	size_t i = 0;
+	for(ItemList::iterator iter = items.begin(); iter != items.end(); ++iter, ++i)
+		if((*iter)->dataIndex != i || val[i] != 10*(*iter)->id) return false;
+	return pipe.num_data_entries() == items.size();
+}
+
+void test_defragment()
+{
+	ItemList items;
+	Pipe pipe(&items);
+	Attachment<int> aVal;
+	pipe.attach(aVal, -1, 0);
+
+	for(int i=0; i<10; ++i){
+		items.push_back(new Item(i));
+		pipe.register_element(items.back());
+		(*pipe.get_data_container(aVal))[items.back()->dataIndex] = 10*i;
+	}
+
+//	erase some elements
+	for(ItemList::iterator iter = items.begin(); iter != items.end();){
+		if((*iter)->id % 3 == 1){
+			pipe.unregister_element(*iter);
+			delete *iter;
+			iter = items.erase(iter);
+		}
+		else ++iter;
+	}
+	std::cout << "fragmented " << pipe.is_fragmented();
+	pipe.defragment();
+	std::cout << ", defragmented " << !pipe.is_fragmented() << ", aligned "
+			<< aligned(pipe, items, aVal) << "\n";
+	assert(!pipe.is_fragmented() && aligned(pipe, items, aVal));
+
+//	reorder the elements
+	items.reverse();
+	pipe.align_data_with_elements();
+	std::cout << "reordered: aligned " << aligned(pipe, items, aVal) << "\n";
+	assert(aligned(pipe, items, aVal));
+
+	for(ItemList::iterator iter = items.begin(); iter != items.end(); ++iter)
+		delete *iter;
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	test_slabs();
+	test_threads();
+	test_defragment();
+	pcl::Finalize();
+}
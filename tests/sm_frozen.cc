@@ -0,0 +1,105 @@
+
+#include "common/util/trace.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_impl.h"
+#include "lib_algebra/cpu_algebra/vector.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "lib_algebra/cpu_algebra/sparsematrix_frozen.cpp"
+
+// sparse matrix snapshot test: products with the CSR and SELL snapshots
+// have to be identical to the products with the flexible layout
+
+typedef ug::SparseMatrix<double> M;
+typedef ug::Vector<double> V;
+
+// rows of very different length, some empty rows, assembled in random order
+void assemble(M& A, int N)
+{
+	A.resize_and_clear(N, N);
+	for(int k=0; k<5*N; ++k){
+		int r = (k*7919) % N;
+		if(r % 11 == 3) continue;
+		int c = (k*104729 + r) % N;
+		A(r, c) += 1. + (k % 13);
+		if(r % 17 == 0){
+			for(int j=0; j<30 && j<N; ++j){
+				A(r, j) += 0.5;
+			}
+		}
+	}
+}
+
+double max_diff(V const& a, V const& b)
+{
+	double d = 0.;
+	for(size_t i=0; i<a.size(); ++i){
+		d = std::max(d, std::fabs(a[i] - b[i]));
+	}
+	return d;
+}
+
+// dest = alpha*v + beta*A*w
+void apply_all(M const& A, V& z, V& y, V const& x)
+{
+	A.apply(z, x);
+	y.set(1.);
+	A.axpy(y, 2., y, -1., x);
+}
+
+void test(int N, int format)
+{
+	M A;
+	assemble(A, N);
+
+	V x(N), zRef(N), yRef(N), z(N), y(N);
+	for(int i=0; i<N; ++i){
+		x[i] = 1. + (i % 7);
+	}
+
+	apply_all(A, zRef, yRef, x);
+	assert(A.frozen_format() == ug::SMFF_NONE);
+
+	A.freeze(format);
+	assert(A.frozen_format() == format);
+	apply_all(A, z, y, x);
+	std::cout << "apply " << max_diff(z, zRef) << " axpy " << max_diff(y, yRef) << "\n";
+	assert(max_diff(z, zRef) == 0.);
+	assert(max_diff(y, yRef) == 0.);
+
+	// changing values does not drop the snapshot, the new values are used
+	for(int r=0; r<N; ++r){
+		for(M::row_iterator it=A.begin_row(r); it!=A.end_row(r); ++it){
+			it.value() *= 2.;
+		}
+	}
+	assert(A.frozen_format() == format);
+	apply_all(A, z, y, x);
+	A.unfreeze();
+	apply_all(A, zRef, yRef, x);
+	std::cout << "scaled " << max_diff(z, zRef) << "\n";
+	assert(max_diff(z, zRef) == 0.);
+	assert(max_diff(y, yRef) == 0.);
+
+	// a new connection drops the snapshot
+	A.freeze(format);
+	A(3, N-1) = 4.;
+	std::cout << "frozen after new connection " << A.frozen_format() << "\n";
+	assert(A.frozen_format() == ug::SMFF_NONE);
+}
+
+int main()
+{
+	std::cout << "== csr 100\n";
+	test(100, ug::SMFF_CSR);
+	std::cout << "== sell 100\n";
+	test(100, ug::SMFF_SELL);
+	std::cout << "== csr 3001\n";
+	test(3001, ug::SMFF_CSR);
+	std::cout << "== sell 3001\n";
+	test(3001, ug::SMFF_SELL);
+}
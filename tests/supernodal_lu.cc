@@ -0,0 +1,167 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/linear_solver/lu.h"
+#include <cstdio>
+
+// supernodal LU test: the supernodal sparse LU has to solve the systems
+// solved by the dense LU, with and without fill-reducing ordering and with
+// blocks. Small pivots have to make the LU fall back to ILUT(0).
+
+using namespace ug;
+
+// convection-diffusion on an n x n grid with the 5-point stencil and upwind
+// convection (c, 0.5*c). Every unknown has a block of size bs, the components
+// are coupled in the diagonal block.
+template<typename M>
+void convection_diffusion(M& A, size_t n, double c)
+{
+	const size_t bs = block_traits<typename M::value_type>::static_num_rows;
+	A.resize_and_clear(n*n, n*n);
+	for(size_t y=0; y<n; ++y)
+		for(size_t x=0; x<n; ++x){
+			const size_t i = y*n + x;
+			for(size_t k=0; k<bs; ++k){
+				BlockRef(A(i,i), k, k) = 4 + 1.5*c;
+				if(k+1 < bs) {BlockRef(A(i,i), k, k+1) = 0.5; BlockRef(A(i,i), k+1, k) = -0.3;}
+				if(x>0)   BlockRef(A(i,i-1), k, k) = -1 - c;
+				if(x+1<n) BlockRef(A(i,i+1), k, k) = -1;
+				if(y>0)   BlockRef(A(i,i-n), k, k) = -1 - 0.5*c;
+				if(y+1<n) BlockRef(A(i,i+n), k, k) = -1;
+			}
+		}
+}
+
+// tridiagonal matrix, the subdiagonal entries are larger than the diagonal
+template<typename M>
+void tridiagonal(M& A, size_t n)
+{
+	A.resize_and_clear(n, n);
+	for(size_t i=0; i<n; ++i){
+		A(i,i) = 1.0;
+		if(i>0)   A(i,i-1) = -1.2;
+		if(i+1<n) A(i,i+1) = 0.1;
+	}
+}
+
+// max norm of b - A x
+template<typename M, typename V>
+double residual(const M& A, const V& x, const V& b)
+{
+	const size_t bs = block_traits<typename M::value_type>::static_num_rows;
+	double res = 0;
+	for(size_t i=0; i<A.num_rows(); ++i)
+		for(size_t r=0; r<bs; ++r){
+			double s = BlockRef(b[i], r);
+			for(typename M::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+				for(size_t c=0; c<bs; ++c)
+					s -= BlockRef(it.value(), r, c) * BlockRef(x[it.index()], c);
+			res = std::max(res, std::fabs(s));
+		}
+	return res;
+}
+
+template<typename V>
+double max_diff(const V& a, const V& b)
+{
+	const size_t bs = block_traits<typename V::value_type>::static_size;
+	double d = 0;
+	for(size_t i=0; i<a.size(); ++i)
+		for(size_t r=0; r<bs; ++r)
+			d = std::max(d, std::fabs(BlockRef(a[i], r) - BlockRef(b[i], r)));
+	return d;
+}
+
+template<typename TAlgebra>
+void solve(LU<TAlgebra>& lu, SmartPtr<MatrixOperator<typename TAlgebra::matrix_type,
+           typename TAlgebra::vector_type> > op, typename TAlgebra::vector_type& x)
+{
+	typedef typename TAlgebra::vector_type V;
+	const size_t bs = block_traits<typename V::value_type>::static_size;
+	V b(op->get_matrix().num_rows());
+	for(size_t i=0; i<b.size(); ++i)
+		for(size_t r=0; r<bs; ++r)
+			BlockRef(b[i], r) = std::sin(0.37*i + r);
+	x.resize(b.size());
+	x.set(0.0);
+#ifdef UG_PARALLEL
+	b.set_storage_type(PST_ADDITIVE);
+	x.set_storage_type(PST_CONSISTENT);
+#endif
+	UG_COND_THROW(!lu.init(op), "init failed");
+	UG_COND_THROW(!lu.apply(x, b), "apply failed");
+	UG_COND_THROW(residual(op->get_matrix(), x, b) > 1e-10, "residual "
+			<< residual(op->get_matrix(), x, b));
+}
+
+// solves with the dense LU and the supernodal LU with the ordering
+// (default or natural) and compares the solutions
+template<typename TAlgebra>
+void test(const char* name, size_t n, double c)
+{
+	typedef typename TAlgebra::matrix_type M;
+	typedef typename TAlgebra::vector_type V;
+	SmartPtr<MatrixOperator<M, V> > op(new MatrixOperator<M, V>);
+	convection_diffusion(op->get_matrix(), n, c);
+#ifdef UG_PARALLEL
+	op->get_matrix().set_storage_type(PST_ADDITIVE);
+#endif
+
+	V xDense, xSN, xNatural, xReused;
+	LU<TAlgebra> dense;
+	dense.set_minimum_for_sparse(1000000);
+	solve(dense, op, xDense);
+
+	LU<TAlgebra> lu;
+	lu.set_minimum_for_sparse(0);
+	lu.set_supernodal(true);
+	solve(lu, op, xSN);
+
+	LU<TAlgebra> natural;
+	natural.set_minimum_for_sparse(0);
+	natural.set_supernodal(true);
+	natural.set_sort_sparse(false);
+	solve(natural, op, xNatural);
+
+	std::cout << name << ": same as dense " << (max_diff(xSN, xDense) < 1e-10)
+			<< ", natural ordering " << (max_diff(xNatural, xDense) < 1e-10);
+	assert(max_diff(xSN, xDense) < 1e-10 && max_diff(xNatural, xDense) < 1e-10);
+
+//	new values, same pattern: the analysis is reused
+	convection_diffusion(op->get_matrix(), n, 2*c);
+	solve(dense, op, xDense);
+	solve(lu, op, xReused);
+	std::cout << ", new values " << (max_diff(xReused, xDense) < 1e-10) << "\n";
+	assert(max_diff(xReused, xDense) < 1e-10);
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		test<CPUAlgebra>("scalar", 30, 1.0);
+		test<CPUBlockAlgebra<2> >("blocks", 15, 0.5);
+
+	//	the pivots are 0.8 times the column maxima
+		typedef CPUAlgebra::matrix_type M;
+		typedef CPUAlgebra::vector_type V;
+		SmartPtr<MatrixOperator<M, V> > op(new MatrixOperator<M, V>);
+		tridiagonal(op->get_matrix(), 50);
+#ifdef UG_PARALLEL
+		op->get_matrix().set_storage_type(PST_ADDITIVE);
+#endif
+		V x;
+		LU<CPUAlgebra> lu;
+		lu.set_minimum_for_sparse(0);
+		lu.set_supernodal(true);
+		solve(lu, op, x);
+		std::cout << "default tolerance solved\n";
+		lu.set_pivot_tolerance(0.9);
+		solve(lu, op, x);
+		std::cout << "fallback solved\n";
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
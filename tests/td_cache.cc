@@ -0,0 +1,239 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/time_disc/theta_time_step.h"
+#include <cstdio>
+
+// linear operator cache test: time steps with the cached system matrix and
+// rhs have to give the same solutions as steps with a full assembling
+
+using namespace ug;
+typedef CPUAlgebra A;
+typedef A::matrix_type M;
+typedef A::vector_type V;
+typedef ConstSmartPtr<VectorTimeSeries<V> > TS;
+#define NOT_USED { UG_THROW("not used"); }
+
+// 1d heat equation u_t = u_xx + f, u(0)=0, u(1)=t, finite differences
+struct HeatDisc : public IDomainDiscretization<A>
+{
+	size_t n; number h; int numJac;
+	SmartPtr<AssemblingTuner<A> > tuner;
+
+	HeatDisc(size_t n_) : n(n_), h(1.0/(n_-1)), numJac(0), tuner(new AssemblingTuner<A>) {}
+
+	number f(size_t i, number t) {return std::sin(3*i*h)*std::cos(t) + 1.0;}
+	bool bnd(size_t i) {return i==0 || i==n-1;}
+	number g(size_t i, number t) {return i==0 ? 0.0 : t;}
+
+	void stiff(V& r, const V& u)
+	{
+		r.resize(n);
+		for(size_t i=0; i<n; ++i)
+			r[i] = bnd(i) ? 0.0 : (2*u[i]-u[i-1]-u[i+1])/(h*h);
+	}
+
+	void jac(M& J, number sa)
+	{
+		++numJac;
+		J.resize_and_clear(n, n);
+		for(size_t i=0; i<n; ++i){
+			if(bnd(i)) {J(i,i) = 1.0; continue;}
+			J(i,i) = 1.0 + sa*2/(h*h);
+			J(i,i-1) = -sa/(h*h);
+			J(i,i+1) = -sa/(h*h);
+		}
+#ifdef UG_PARALLEL
+		J.set_storage_type(PST_ADDITIVE);
+#endif
+	}
+
+	virtual void assemble_jacobian(M& J, TS, const number sa, const GridLevel&) {jac(J, sa);}
+	virtual void assemble_defect(V& d, TS vSol, const std::vector<number>& sm, const std::vector<number>& sa, const GridLevel&)
+	{
+		d.resize(n); d.set(0.0); V r;
+		for(size_t k=0; k<vSol->size(); ++k){
+			const V& u = *vSol->solution(k);
+			stiff(r, u);
+			for(size_t i=0; i<n; ++i)
+				if(!bnd(i)) d[i] += sm[k]*u[i] + sa[k]*(r[i] - f(i, vSol->time(k)));
+		}
+		const V& u0 = *vSol->solution(0);
+		d[0] = u0[0] - g(0, vSol->time(0));
+		d[n-1] = u0[n-1] - g(n-1, vSol->time(0));
+	}
+	virtual void assemble_rhs(V& b, TS vSol, const std::vector<number>& sm, const std::vector<number>& sa, const GridLevel&)
+	{
+		b.resize(n); b.set(0.0); V r;
+		for(size_t k=1; k<vSol->size(); ++k){
+			const V& u = *vSol->solution(k);
+			stiff(r, u);
+			for(size_t i=0; i<n; ++i)
+				if(!bnd(i)) b[i] -= sm[k]*u[i] + sa[k]*(r[i] - f(i, vSol->time(k)));
+		}
+		for(size_t i=0; i<n; ++i)
+			if(!bnd(i)) b[i] += sa[0]*f(i, vSol->time(0));
+		b[0] = g(0, vSol->time(0));
+		b[n-1] = g(n-1, vSol->time(0));
+	}
+	virtual void assemble_linear(M& J, V& b, TS vSol, const std::vector<number>& sm, const std::vector<number>& sa, const GridLevel& gl)
+	{
+		jac(J, sa[0]);
+		assemble_rhs(b, vSol, sm, sa, gl);
+	}
+	virtual void adjust_solution(V& u, number t, const GridLevel&) {u[0] = g(0, t); u[n-1] = g(n-1, t);}
+
+	virtual void prepare_timestep(TS, number, ConstSmartPtr<DoFDistribution>) {}
+	virtual void prepare_timestep(TS, number, const GridLevel&) {}
+	virtual void prepare_timestep_elem(TS, ConstSmartPtr<DoFDistribution>) {}
+	virtual void prepare_timestep_elem(TS, const GridLevel&) {}
+	virtual void finish_timestep(TS, ConstSmartPtr<DoFDistribution>) {}
+	virtual void finish_timestep(TS, const GridLevel&) {}
+	virtual void finish_timestep_elem(TS, const GridLevel&) {}
+	virtual void finish_timestep_elem(TS, ConstSmartPtr<DoFDistribution>) {}
+	virtual void adjust_solution(V&, number, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_jacobian(M&, TS, const number, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_defect(V&, TS, const std::vector<number>&, const std::vector<number>&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_linear(M&, V&, TS, const std::vector<number>&, const std::vector<number>&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_rhs(V&, TS, const std::vector<number>&, const std::vector<number>&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_jacobian(M&, const V&, const GridLevel&) NOT_USED
+	virtual void assemble_jacobian(M&, const V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_defect(V&, const V&, const GridLevel&) NOT_USED
+	virtual void assemble_defect(V&, const V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_linear(M&, V&, const GridLevel&) NOT_USED
+	virtual void assemble_linear(M&, V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_rhs(V&, const V&, const GridLevel&) NOT_USED
+	virtual void assemble_rhs(V&, const V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_rhs(V&, const GridLevel&) NOT_USED
+	virtual void assemble_rhs(V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void adjust_solution(V&, const GridLevel&) NOT_USED
+	virtual void adjust_solution(V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_mass_matrix(M&, const V&, const GridLevel&) NOT_USED
+	virtual void assemble_mass_matrix(M&, const V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual void assemble_stiffness_matrix(M&, const V&, const GridLevel&) NOT_USED
+	virtual void assemble_stiffness_matrix(M&, const V&, ConstSmartPtr<DoFDistribution>) NOT_USED
+	virtual size_t num_constraints() const {return 0;}
+	virtual SmartPtr<IConstraint<A> > constraint(size_t) NOT_USED
+	virtual SmartPtr<AssemblingTuner<A> > ass_tuner() {return tuner;}
+	virtual ConstSmartPtr<AssemblingTuner<A> > ass_tuner() const {return tuner;}
+	virtual void calc_error(const V&, const GridLevel&, V*) NOT_USED
+	virtual void calc_error(const V&, ConstSmartPtr<DoFDistribution>, V*) NOT_USED
+	virtual void calc_error(TS, ConstSmartPtr<DoFDistribution>, const std::vector<number>&, const std::vector<number>&, V*) NOT_USED
+	virtual void calc_error(TS, const std::vector<number>&, const std::vector<number>&, const GridLevel&, V*) NOT_USED
+	virtual void invalidate_error() {}
+	virtual bool is_error_valid() {return true;}
+};
+
+// tridiagonal solve of J c = d
+void solve(const M& J, V& c, const V& d)
+{
+	size_t n = d.size();
+	std::vector<double> a(n), b(n), cc(n), r(n);
+	for(size_t i=0; i<n; ++i){
+		b[i] = J(i,i);
+		a[i] = i>0 ? J(i,i-1) : 0;
+		cc[i] = i+1<n ? J(i,i+1) : 0;
+		r[i] = d[i];
+	}
+	for(size_t i=1; i<n; ++i){
+		double m = a[i]/b[i-1];
+		b[i] -= m*cc[i-1];
+		r[i] -= m*r[i-1];
+	}
+	c.resize(n);
+#ifdef UG_PARALLEL
+	c.set_storage_type(PST_CONSISTENT);
+#endif
+	c[n-1] = r[n-1]/b[n-1];
+	for(int i=n-2; i>=0; --i) c[i] = (r[i] - cc[i]*c[i+1])/b[i];
+}
+
+// 20 steps, every fourth step with twice the step size. The step size is
+// recomputed from the time points, such that equal step sizes may differ
+// in the last bits.
+void run(SmartPtr<MultiStepTimeDiscretization<A> > td, bool bLinear, V& u)
+{
+	SmartPtr<VectorTimeSeries<V> > ts(new VectorTimeSeries<V>);
+	size_t n = 101;
+	SmartPtr<V> u0(new V(n));
+	u0->set(0.0);
+	if(td->num_prev_steps() > 1) ts->push(SmartPtr<V>(new V(*u0)), -0.01);
+	ts->push(u0, 0.0);
+
+	M J; V d, c;
+	u.resize(n); u.set(0.0);
+	number t = 0.0;
+	int k = 0;
+	for(int s=0; s<20; ++s){
+		k += (s%4==3) ? 2 : 1;
+		number dt = k*0.01 - t;
+		for(size_t st=1; st<=td->num_stages(); ++st){
+			td->set_stage(st);
+			td->prepare_step(ts, dt);
+			td->adjust_solution(u, GridLevel());
+			if(bLinear){
+				V b;
+				td->assemble_linear(J, b, GridLevel());
+				solve(J, u, b);
+			}
+			else for(int it=0; it<2; ++it){
+				td->assemble_defect(d, u, GridLevel());
+				td->assemble_jacobian(J, u, GridLevel());
+				solve(J, c, d);
+				u -= c;
+			}
+			ts->push_discard_oldest(SmartPtr<V>(new V(u)), td->future_time());
+		}
+		t = ts->time(0);
+	}
+}
+
+void test(const char* name, bool bLinear)
+{
+	V ref, res;
+	int numJac[2];
+	for(int cache=0; cache<2; ++cache){
+		SmartPtr<HeatDisc> disc(new HeatDisc(101));
+		SmartPtr<MultiStepTimeDiscretization<A> > td;
+		if(std::string(name) == "BDF2"){
+			td = make_sp(new BDF<A>(disc, 2));
+		}else{
+			SmartPtr<ThetaTimeStep<A> > theta(new ThetaTimeStep<A>(disc, 0.5));
+			theta->set_scheme(name);
+			if(std::string(name) == "Theta") theta->set_theta(0.5);
+			td = theta;
+		}
+		td->set_linear_operator_cache(cache);
+		run(td, bLinear, cache ? res : ref);
+		numJac[cache] = disc->numJac;
+	}
+
+	V diff(ref); diff -= res;
+	double relDiff = diff.norm() / ref.norm();
+	std::cout << name << (bLinear ? " linear" : " newton")
+			<< ": assemblings " << numJac[0] << " cached " << numJac[1]
+			<< ", same solution " << (relDiff < 1e-13) << "\n";
+
+	// equal up to rounding: the cached matrix may belong to a step size
+	// differing in the last bits, and the defect d = J*u - b is computed
+	// in another order than the assembled defect
+	assert(relDiff < 1e-13);
+	assert(numJac[1] < numJac[0]);
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		test("Theta", true);
+		test("Theta", false);
+		test("FracStep", true);
+		test("FracStep", false);
+		test("BDF2", true);
+		test("BDF2", false);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,235 @@
+#include "pcl/pcl_base.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
+#include "lib_grid/algorithms/trees/kd_tree_static.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+#include <algorithm>
+#include <cstdio>
+
+// search tree test: box, point and nearest neighbor queries of ntree and
+// KDTreeStatic have to find the elements found by brute force, for trees
+// built with one and several threads and after insertion and removal.
+
+using namespace ug;
+typedef lg_ntree<2, 2, Face> Tree;
+typedef Tree::box_t Box;
+typedef KDTreeStatic<APosition2, 2, vector2> KDTree;
+
+const size_t NUM_QUERIES = 40;
+
+// pseudo random number in [-1, 1]
+number rnd(size_t i, number f)
+{
+	return std::sin(f*i + 0.3);
+}
+
+Box query_box(size_t i)
+{
+	const vector2 c(rnd(i, 1.7), rnd(i, 2.3)), ext(0.2*std::fabs(rnd(i, 0.9)), 0.2*std::fabs(rnd(i, 3.1)));
+	Box box;
+	VecSubtract(box.min, c, ext);
+	VecAdd(box.max, c, ext);
+	return box;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	ntree
+// elements of the tree whose bounding boxes intersect the box
+void tree_in_box(std::vector<Face*>& vOut, const Tree& tree, const Box& box)
+{
+	std::vector<Face*> vCandidates;
+	FindElementsInIntersectingNodes(vCandidates, tree, box);
+	vOut.clear();
+	for(size_t i=0; i<vCandidates.size(); ++i){
+		Box elemBox;
+		Tree::traits::calculate_bounding_box(elemBox, vCandidates[i], tree.common_data());
+		if(Tree::traits::box_box_intersection(elemBox, box)) vOut.push_back(vCandidates[i]);
+	}
+	std::sort(vOut.begin(), vOut.end());
+}
+
+void brute_force_in_box(std::vector<Face*>& vOut, const std::vector<Face*>& vElem,
+                        const Tree& tree, const Box& box)
+{
+	vOut.clear();
+	for(size_t i=0; i<vElem.size(); ++i){
+		Box elemBox;
+		Tree::traits::calculate_bounding_box(elemBox, vElem[i], tree.common_data());
+		if(Tree::traits::box_box_intersection(elemBox, box)) vOut.push_back(vElem[i]);
+	}
+	std::sort(vOut.begin(), vOut.end());
+}
+
+// box queries and point queries at the box centers
+bool same_as_brute_force(const Tree& tree, const std::vector<Face*>& vElem)
+{
+	if(tree.size() != vElem.size()) return false;
+	std::vector<Face*> vTree, vBrute;
+	for(size_t i=0; i<NUM_QUERIES; ++i){
+		const Box box = query_box(i);
+		tree_in_box(vTree, tree, box);
+		brute_force_in_box(vBrute, vElem, tree, box);
+		if(vTree != vBrute) return false;
+
+		vector2 c;
+		VecScaleAdd(c, 0.5, box.min, 0.5, box.max);
+		bool bContained = false;
+		for(size_t j=0; j<vElem.size(); ++j)
+			bContained |= Tree::traits::contains_point(vElem[j], c, tree.common_data());
+		Face* elem = NULL;
+		const bool bFound = FindContainingElement(elem, tree, c);
+		if(bFound != bContained) return false;
+		if(bFound && (!Tree::traits::contains_point(elem, c, tree.common_data())
+		              || !std::binary_search(vBrute.begin(), vBrute.end(), elem)))
+			return false;
+	}
+	return true;
+}
+
+void test_ntree(SmartPtr<Domain2d> dom)
+{
+	MultiGrid& mg = *dom->grid();
+	std::vector<Face*> vElem(mg.begin<Face>(mg.top_level()), mg.end<Face>(mg.top_level()));
+
+	Tree tree(mg, dom->position_attachment());
+	tree.create_tree(vElem.begin(), vElem.end());
+	const bool bSerial = same_as_brute_force(tree, vElem);
+
+	Tree treeThreaded(mg, dom->position_attachment());
+	treeThreaded.set_num_threads(4);
+	treeThreaded.create_tree(vElem.begin(), vElem.end());
+	const bool bThreaded = same_as_brute_force(treeThreaded, vElem);
+	std::cout << "ntree: elements " << vElem.size() << ", serial " << bSerial
+			<< ", threaded " << bThreaded;
+
+//	remove every third element, insert half of them again
+	std::vector<Face*> vKept, vRemoved;
+	for(size_t i=0; i<vElem.size(); ++i){
+		if(i % 3 == 0){
+			tree.remove_element(vElem[i]);
+			vRemoved.push_back(vElem[i]);
+		}
+		else vKept.push_back(vElem[i]);
+	}
+	const bool bRemoved = same_as_brute_force(tree, vKept);
+	for(size_t i=0; i<vRemoved.size(); i+=2){
+		tree.insert_element(vRemoved[i]);
+		vKept.push_back(vRemoved[i]);
+	}
+	const bool bInserted = same_as_brute_force(tree, vKept);
+	std::cout << ", removed " << bRemoved << ", inserted " << bInserted;
+
+//	the tree follows the refinement of the grid
+	treeThreaded.enable_auto_update(true, true);
+	GlobalMultiGridRefiner ref(mg, dom->refinement_projector());
+	ref.refine();
+	treeThreaded.update();
+	vElem.assign(mg.begin<Face>(mg.top_level()), mg.end<Face>(mg.top_level()));
+	const bool bRefined = same_as_brute_force(treeThreaded, vElem);
+	std::cout << ", refined " << bRefined << "\n";
+	assert(bSerial && bThreaded && bRemoved && bInserted && bRefined);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	KDTreeStatic
+// sorted squared distances of the numClosest vertices
+void brute_force_closest(std::vector<number>& vDistOut, const std::vector<Vertex*>& vVrt,
+                         Grid::VertexAttachmentAccessor<APosition2>& aaPos,
+                         const vector2& pos, size_t numClosest)
+{
+	vDistOut.clear();
+	for(size_t i=0; i<vVrt.size(); ++i)
+		vDistOut.push_back(VecDistanceSq(aaPos[vVrt[i]], pos));
+	std::sort(vDistOut.begin(), vDistOut.end());
+	vDistOut.resize(std::min(numClosest, vDistOut.size()));
+}
+
+// the tree computes distances in single precision
+bool same_distances(const std::vector<number>& vDist1, const std::vector<number>& vDist2)
+{
+	if(vDist1.size() != vDist2.size()) return false;
+	for(size_t i=0; i<vDist1.size(); ++i)
+		if(std::fabs(vDist1[i] - vDist2[i]) > 1e-5*(1 + vDist2[i])) return false;
+	return true;
+}
+
+bool same_as_brute_force(KDTree& tree, const std::vector<Vertex*>& vVrt,
+                         Grid::VertexAttachmentAccessor<APosition2>& aaPos)
+{
+	std::vector<Vertex*> vTree, vBrute;
+	for(size_t i=0; i<NUM_QUERIES; ++i){
+		const Box box = query_box(i);
+		tree.get_points_in_box(vTree, box.min, box.max);
+		vBrute.clear();
+		for(size_t j=0; j<vVrt.size(); ++j)
+			if(Tree::traits::box_contains_point(box, aaPos[vVrt[j]])) vBrute.push_back(vVrt[j]);
+		std::sort(vTree.begin(), vTree.end());
+		std::sort(vBrute.begin(), vBrute.end());
+		if(vTree != vBrute) return false;
+
+		vector2 pos(rnd(i, 0.7), rnd(i, 1.3));
+		const size_t numClosest = 1 + i % 9;
+		tree.get_neighbourhood(vTree, pos, numClosest);
+		std::vector<number> vDistTree, vDistBrute;
+		for(size_t j=0; j<vTree.size(); ++j)
+			vDistTree.push_back(VecDistanceSq(aaPos[vTree[j]], pos));
+		std::sort(vDistTree.begin(), vDistTree.end());
+		brute_force_closest(vDistBrute, vVrt, aaPos, pos, numClosest);
+		if(!same_distances(vDistTree, vDistBrute)) return false;
+	}
+	return true;
+}
+
+void test_kd_tree(SmartPtr<Domain2d> dom)
+{
+	MultiGrid& mg = *dom->grid();
+	Grid::VertexAttachmentAccessor<APosition2> aaPos(mg, dom->position_attachment());
+	std::vector<Vertex*> vVrt(mg.begin<Vertex>(mg.top_level() - 1), mg.end<Vertex>(mg.top_level() - 1));
+
+	KDTree tree;
+	tree.create_from_grid(mg, vVrt.begin(), vVrt.end(), aaPos, 20, 8);
+	const bool bSerial = same_as_brute_force(tree, vVrt, aaPos);
+
+	KDTree treeThreaded;
+	treeThreaded.set_num_threads(4);
+	treeThreaded.create_from_grid(mg, vVrt.begin(), vVrt.end(), aaPos, 20, 8);
+	const bool bThreaded = same_as_brute_force(treeThreaded, vVrt, aaPos);
+	std::cout << "KDTreeStatic: vertices " << vVrt.size() << ", serial " << bSerial
+			<< ", threaded " << bThreaded;
+
+//	insert the vertices of the top level, erase every fifth vertex
+	for(VertexIterator iter = mg.begin<Vertex>(mg.top_level()); iter != mg.end<Vertex>(mg.top_level()); ++iter){
+		tree.insert_vertex(*iter);
+		vVrt.push_back(*iter);
+	}
+	const bool bInserted = same_as_brute_force(tree, vVrt, aaPos);
+	bool bErased = true;
+	std::vector<Vertex*> vKept;
+	for(size_t i=0; i<vVrt.size(); ++i){
+		if(i % 5 == 0) bErased &= tree.erase_vertex(vVrt[i]);
+		else vKept.push_back(vVrt[i]);
+	}
+	bErased &= same_as_brute_force(tree, vKept, aaPos);
+	std::cout << ", inserted " << bInserted << ", erased " << bErased << "\n";
+	assert(bSerial && bThreaded && bInserted && bErased);
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		SmartPtr<Domain2d> dom(new Domain2d);
+		LoadDomain(*dom, "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx");
+		GlobalMultiGridRefiner ref(*dom->grid(), dom->refinement_projector());
+		for(int i=0; i<4; ++i) ref.refine();
+
+		test_ntree(dom);
+		test_kd_tree(dom);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,151 @@
+#include "pcl/pcl_base.h"
+#include "lib_grid/lib_grid.h"
+#include "lib_grid/file_io/file_io_ugxb.h"
+#include "lib_grid/refinement/regular_refinement.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+// ugxb test: a grid written to a ugxb file and read again, directly and
+// after the conversion to ugx, has to be the grid which was written, with the
+// same order of the elements and the same subsets. The parts of a partial
+// read have to cover the grid, a truncated file has to be rejected.
+
+using namespace ug;
+
+typedef std::vector<std::pair<number, number> > Centers;
+
+// corners by vertex index and subset of each element of type TElem
+template <class TElem>
+bool same_elements(Grid& g1, SubsetHandler& sh1, Grid& g2, SubsetHandler& sh2)
+{
+	if(g1.num<TElem>() != g2.num<TElem>()) return false;
+	std::map<Vertex*, size_t> ind1, ind2;
+	for(VertexIterator iter = g1.begin<Vertex>(); iter != g1.end<Vertex>(); ++iter)
+		ind1.insert(std::make_pair(*iter, ind1.size()));
+	for(VertexIterator iter = g2.begin<Vertex>(); iter != g2.end<Vertex>(); ++iter)
+		ind2.insert(std::make_pair(*iter, ind2.size()));
+
+	typename geometry_traits<TElem>::iterator iter1 = g1.begin<TElem>(), iter2 = g2.begin<TElem>();
+	for(; iter1 != g1.end<TElem>(); ++iter1, ++iter2){
+		TElem* e1 = *iter1; TElem* e2 = *iter2;
+		if(e1->reference_object_id() != e2->reference_object_id()
+		   || sh1.get_subset_index(e1) != sh2.get_subset_index(e2))
+			return false;
+		for(size_t i=0; i<e1->num_vertices(); ++i)
+			if(ind1[e1->vertex(i)] != ind2[e2->vertex(i)]) return false;
+	}
+	return true;
+}
+
+bool same_grids(Grid& g1, SubsetHandler& sh1, Grid& g2, SubsetHandler& sh2)
+{
+	if(g1.num<Vertex>() != g2.num<Vertex>() || sh1.num_subsets() != sh2.num_subsets())
+		return false;
+	for(int si=0; si<sh1.num_subsets(); ++si)
+		if(sh1.subset_info(si).name != sh2.subset_info(si).name) return false;
+
+	Grid::VertexAttachmentAccessor<APosition> aaPos1(g1, aPosition), aaPos2(g2, aPosition);
+	VertexIterator iter1 = g1.begin<Vertex>(), iter2 = g2.begin<Vertex>();
+	for(; iter1 != g1.end<Vertex>(); ++iter1, ++iter2)
+		if(aaPos1[*iter1] != aaPos2[*iter2] || sh1.get_subset_index(*iter1) != sh2.get_subset_index(*iter2))
+			return false;
+
+	return same_elements<Edge>(g1, sh1, g2, sh2) && same_elements<Face>(g1, sh1, g2, sh2);
+}
+
+// sorted centers of the faces
+void face_centers(Centers& vOut, Grid& g)
+{
+	Grid::VertexAttachmentAccessor<APosition> aaPos(g, aPosition);
+	for(FaceIterator iter = g.begin<Face>(); iter != g.end<Face>(); ++iter){
+		const vector3 c = CalculateCenter(*iter, aaPos);
+		vOut.push_back(std::make_pair(c.x(), c.y()));
+	}
+	std::sort(vOut.begin(), vOut.end());
+}
+
+// the loader may report the error or throw
+bool load(Grid& g, SubsetHandler& sh, const char* filename)
+{
+	g.attach_to_vertices(aPosition);
+	GetLogAssistant().enable_terminal_output(false);
+	bool bLoaded = false;
+	try{
+		bLoaded = LoadGridFromFile(g, sh, filename, aPosition);
+	}
+	catch(UGError&){}
+	GetLogAssistant().enable_terminal_output(true);
+	return bLoaded;
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		Grid grid;
+		SubsetHandler sh(grid);
+		UG_COND_THROW(!load(grid, sh, "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx"),
+					  "loading the ugx file failed");
+		Selector sel(grid);
+		for(int i=0; i<2; ++i){
+			sel.select(grid.begin<Face>(), grid.end<Face>());
+			Refine(grid, sel);
+			sel.clear();
+		}
+
+		UG_COND_THROW(!SaveGridToFile(grid, sh, "ugxb_io.ugxb", aPosition), "saving the ugxb file failed");
+		Grid gridRead;
+		SubsetHandler shRead(gridRead);
+		const bool bLoaded = load(gridRead, shRead, "ugxb_io.ugxb");
+		const bool bSame = bLoaded && same_grids(grid, sh, gridRead, shRead);
+
+		Grid gridUGX;
+		SubsetHandler shUGX(gridUGX);
+		const bool bConverted = ConvertUGXBToUGX("ugxb_io.ugxb", "ugxb_io.ugx")
+								&& load(gridUGX, shUGX, "ugxb_io.ugx")
+								&& same_grids(grid, sh, gridUGX, shUGX);
+		std::cout << "faces " << grid.num<Face>() << ", read 1, same grid " << bSame
+				<< ", same grid after the conversion to ugx " << bConverted << "\n";
+		assert(bSame && bConverted);
+
+	//	the parts contain each face exactly once
+		Centers vCenters, vCentersParts;
+		face_centers(vCenters, grid);
+		bool bParts = true;
+		const int numParts = 3;
+		for(int part=0; part<numParts; ++part){
+			Grid gridPart;
+			SubsetHandler shPart(gridPart);
+			gridPart.attach_to_vertices(aPosition);
+			bParts &= LoadGridPartFromUGXB(gridPart, shPart, "ugxb_io.ugxb", part, numParts);
+			bParts &= (gridPart.num<Face>() > 0 && gridPart.num<Edge>() > 0);
+			face_centers(vCentersParts, gridPart);
+		}
+		std::sort(vCentersParts.begin(), vCentersParts.end());
+		bParts &= (vCentersParts == vCenters);
+
+	//	a file cut in the middle of the blocks
+		std::ifstream in("ugxb_io.ugxb", std::ios::binary);
+		std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		std::ofstream out("ugxb_io_truncated.ugxb", std::ios::binary);
+		out.write(content.data(), content.size() / 2);
+		out.close();
+		Grid gridTruncated;
+		SubsetHandler shTruncated(gridTruncated);
+		const bool bRejected = !load(gridTruncated, shTruncated, "ugxb_io_truncated.ugxb");
+		std::cout << "parts " << numParts << ", same faces " << bParts
+				<< ", truncated file rejected " << bRejected << "\n";
+		assert(bParts && bRejected);
+
+		std::remove("ugxb_io.ugxb");
+		std::remove("ugxb_io.ugx");
+		std::remove("ugxb_io_truncated.ugxb");
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
@@ -0,0 +1,173 @@
+#include "pcl/pcl_base.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/io/vtkoutput.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+#include <zlib.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+// vtk output test: the data arrays of a vtu file written with appended raw and
+// appended zlib compressed binary data have to contain the bytes of the
+// inline base64 encoded arrays. Without zlib support, compressed output has
+// to be rejected.
+
+using namespace ug;
+typedef CPUAlgebra A;
+typedef GridFunction<Domain2d, A> GF;
+typedef std::vector<std::string> Arrays;
+typedef unsigned int UInt32;
+
+std::string read_file(const std::string& filename)
+{
+	std::ifstream in(filename.c_str(), std::ios::binary);
+	UG_COND_THROW(!in, "can't open " << filename);
+	return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+// decodes base64 text, whitespace and padding are skipped
+std::string decode_base64(const std::string& text)
+{
+	static const std::string chars =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::string out;
+	UInt32 bits = 0;
+	int numBits = 0;
+	for(size_t i=0; i<text.size(); ++i){
+		const size_t v = chars.find(text[i]);
+		if(v == std::string::npos) continue;
+		bits = (bits << 6) | (UInt32)v;
+		numBits += 6;
+		if(numBits >= 8){
+			numBits -= 8;
+			out.push_back((char)((bits >> numBits) & 0xFF));
+		}
+	}
+	return out;
+}
+
+UInt32 uint32_at(const std::string& data, size_t pos)
+{
+	UG_COND_THROW(pos + sizeof(UInt32) > data.size(), "data ends at " << data.size());
+	UInt32 v;
+	memcpy(&v, data.data() + pos, sizeof(UInt32));
+	return v;
+}
+
+// the raw array at offset of the appended data, after the UInt32 byte count
+std::string appended_raw(const std::string& appended, size_t offset)
+{
+	const UInt32 size = uint32_at(appended, offset);
+	UG_COND_THROW(offset + sizeof(UInt32) + size > appended.size(), "array exceeds the data");
+	return appended.substr(offset + sizeof(UInt32), size);
+}
+
+// the array at offset, compressed in blocks behind the vtkZLibDataCompressor header
+std::string appended_zlib(const std::string& appended, size_t offset)
+{
+	const UInt32 numBlocks = uint32_at(appended, offset);
+	const UInt32 blockSize = uint32_at(appended, offset + 4);
+	const UInt32 lastSize = uint32_at(appended, offset + 8);
+	size_t pos = offset + 4*(3 + numBlocks);
+	std::string out;
+	for(UInt32 b=0; b<numBlocks; ++b){
+		const UInt32 compSize = uint32_at(appended, offset + 4*(3 + b));
+		uLongf size = (b+1 == numBlocks && lastSize != 0) ? lastSize : blockSize;
+		std::vector<Bytef> buf(size);
+		UG_COND_THROW(pos + compSize > appended.size(), "block exceeds the data");
+		UG_COND_THROW(uncompress(&buf.front(), &size, (const Bytef*)appended.data() + pos, compSize) != Z_OK,
+					  "uncompress failed");
+		out.append((const char*)&buf.front(), size);
+		pos += compSize;
+	}
+	return out;
+}
+
+// the bytes of all DataArrays of a vtu file, without the leading byte counts
+void read_arrays(Arrays& vOut, const std::string& filename)
+{
+	const std::string file = read_file(filename);
+	const bool bZLib = file.find("vtkZLibDataCompressor") != std::string::npos;
+	std::string appended;
+	const size_t appendedTag = file.find("<AppendedData");
+	if(appendedTag != std::string::npos){
+		const size_t start = file.find('_', appendedTag) + 1;
+		appended = file.substr(start, file.rfind("</AppendedData>") - start);
+	}
+
+	vOut.clear();
+	for(size_t tag = file.find("<DataArray"); tag < appendedTag; tag = file.find("<DataArray", tag + 1)){
+		const size_t tagEnd = file.find('>', tag);
+		const std::string attributes = file.substr(tag, tagEnd - tag);
+		const size_t offsetAttr = attributes.find("offset=\"");
+		if(offsetAttr == std::string::npos){
+			const std::string data = decode_base64(file.substr(tagEnd + 1, file.find("</DataArray>", tag) - tagEnd - 1));
+			vOut.push_back(data.substr(sizeof(UInt32), uint32_at(data, 0)));
+		}
+		else{
+			const size_t offset = atol(attributes.c_str() + offsetAttr + 8);
+			vOut.push_back(bZLib ? appended_zlib(appended, offset) : appended_raw(appended, offset));
+		}
+	}
+}
+
+// writes u in the given mode and returns the arrays
+void print(Arrays& vOut, GF& u, const char* name, bool bAppended, bool bCompressed)
+{
+	VTKOutput<2> out;
+	out.select("c", "c");
+	out.set_appended(bAppended);
+	out.set_compressed(bCompressed);
+	out.print(name, u);
+	read_arrays(vOut, std::string(name) + ".vtu");
+	std::remove((std::string(name) + ".vtu").c_str());
+}
+
+int main(int argc, char** argv)
+{
+	pcl::Init(&argc, &argv);
+	try{
+		SmartPtr<Domain2d> dom(new Domain2d);
+		LoadDomain(*dom, "lua/unit_square_unstructured_tris_coarse_left_dirichlet.ugx");
+		GlobalMultiGridRefiner ref(*dom->grid(), dom->refinement_projector());
+		for(int i=0; i<4; ++i) ref.refine();
+
+		SmartPtr<ApproximationSpace<Domain2d> > approx(new ApproximationSpace<Domain2d>(dom));
+		approx->add("c", "Lagrange", 1);
+		approx->init_top_surface();
+		GF u(approx);
+		for(size_t i=0; i<u.size(); ++i) u[i] = std::sin(1.3*i);
+#ifdef UG_PARALLEL
+		u.set_storage_type(PST_CONSISTENT);
+#endif
+
+		Arrays vBase64, vRaw, vZLib;
+		print(vBase64, u, "vtk_binary_base64", false, false);
+		print(vRaw, u, "vtk_binary_raw", true, false);
+		std::cout << "arrays " << vBase64.size() << ", appended raw: same arrays " << (vRaw == vBase64) << "\n";
+		assert(vBase64.size() > 0 && vRaw == vBase64);
+
+	//	with zlib the compressed arrays are compared, without it has to throw
+		bool bZLib = false;
+		if(VTKFileWriter::compression_supported()){
+			print(vZLib, u, "vtk_binary_zlib", true, true);
+			bZLib = (vZLib == vBase64);
+		}
+		else{
+			VTKOutput<2> out;
+			try{ out.set_compressed(true); }
+			catch(UGError&){ bZLib = true; }
+		}
+		std::cout << "appended zlib: same arrays or rejected " << bZLib << "\n";
+		assert(bZLib);
+	}
+	catch(UGError& e){
+		std::cout << "error: " << e.get_msg() << "\n";
+		return 1;
+	}
+	pcl::Finalize();
+}
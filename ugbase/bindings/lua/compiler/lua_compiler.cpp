@@ -37,13 +37,18 @@
 #include "bindings/lua/info_commands.h"
 #include "common/util/file_util.h"
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include "lua_compiler.h"
 #include "lua_compiler_debug.h"
 #include "common/profiler/profiler.h"
+#include "common/stopwatch.h"
 #include "vm.h"
+#include "register_vm.h"
 using namespace std;
 
 namespace ug{
@@ -56,21 +61,140 @@ DebugID DID_LUACOMPILER("LUACompiler");
 namespace bridge {
     
 
+LUACompiledKernel::LUACompiledKernel()
+	: libHandle(nullptr), f(nullptr), iIn(0), iOut(0)
+{
+}
+
+LUACompiledKernel::~LUACompiledKernel()
+{
+	if(libHandle)
+	   	CloseLibrary(libHandle);
+
+    if(pDyn.size() > 0)
+    {
+		string s = string("rm ") + pDyn;
+		UG_DLOG(DID_LUACOMPILER, 2, s << "\n");
+		system(s.c_str());
+	}
+}
+
+LUACompiler::CacheEntry::CacheEntry()
+	: luaRef(LUA_NOREF), bVM(false)
+{
+}
+
+std::map<std::string, LUACompiler::CacheEntry>& LUACompiler::cache()
+{
+	static std::map<std::string, CacheEntry> kernels;
+	return kernels;
+}
+
+void LUACompiler::clear_cache()
+{
+	lua_State* L = script::GetDefaultLuaState();
+	std::map<std::string, CacheEntry>::iterator it = cache().begin();
+	for(; it != cache().end(); ++it)
+		luaL_unref(L, LUA_REGISTRYINDEX, it->second.luaRef);
+	cache().clear();
+}
+
+///	pushes the lua function (global function or handle) on the stack
+static void PushLuaFunction(lua_State* L, const char *functionName, LuaFunctionHandle* pHandle)
+{
+	if(pHandle == nullptr) lua_getglobal(L, functionName);
+	else lua_rawgeti(L, LUA_REGISTRYINDEX, pHandle->ref);
+}
+
+///	returns the cache key: the name of global functions, the registry reference of handles
+static std::string CacheKey(const char *functionName, LuaFunctionHandle* pHandle)
+{
+	if(pHandle == nullptr) return functionName;
+	std::stringstream ss;
+	ss << "__lua_function_handle__" << pHandle->ref;
+	return ss.str();
+}
+
+bool LUACompiler::lookup_cache(const char *functionName, LuaFunctionHandle* pHandle, bool bVM)
+{
+	std::map<std::string, CacheEntry>::iterator it = cache().find(CacheKey(functionName, pHandle));
+	if(it == cache().end()) return false;
+
+	const CacheEntry& entry = it->second;
+	if(entry.bVM != bVM) return false;
+
+//	the entry holds a reference to the compiled lua function. A redefined
+//	function is a different object, even if it reuses the memory.
+	lua_State* L = script::GetDefaultLuaState();
+	PushLuaFunction(L, functionName, pHandle);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, entry.luaRef);
+	const bool bSameFunction = lua_rawequal(L, -1, -2);
+	lua_pop(L, 2);
+	if(!bSameFunction) return false;
+
+	UG_DLOG(DID_LUACOMPILER, 2, "LUACompiler: using cached kernel for " << functionName << "\n");
+	m_name = functionName;
+	set_kernel(entry.kernel, bVM);
+	return true;
+}
+
+void LUACompiler::store_cache(const char *functionName, LuaFunctionHandle* pHandle, bool bVM)
+{
+	lua_State* L = script::GetDefaultLuaState();
+	CacheEntry& entry = cache()[CacheKey(functionName, pHandle)];
+	luaL_unref(L, LUA_REGISTRYINDEX, entry.luaRef);
+	PushLuaFunction(L, functionName, pHandle);
+	entry.luaRef = luaL_ref(L, LUA_REGISTRYINDEX);
+	entry.bVM = bVM;
+	entry.kernel = m_kernel;
+	if(!bInitialized) entry.kernel = SPNULL;
+}
+
+void LUACompiler::set_kernel(SmartPtr<LUACompiledKernel> kernel, bool bUseVM)
+{
+	m_kernel = kernel;
+	if(kernel.valid()){
+		m_f = kernel->f;
+		m_iIn = kernel->iIn;
+		m_iOut = kernel->iOut;
+		bVM = bUseVM;
+		bInitialized = true;
+	}
+	else{
+		m_f = nullptr;
+		bInitialized = false;
+	}
+}
+
 bool LUACompiler::create(const char *functionName, LuaFunctionHandle* pHandle)
 {
+	if(lookup_cache(functionName, pHandle, useLua2VM))
+		return bInitialized;
+
+	bool bSuccess;
 	if(useLua2VM)
-		return createVM(functionName, pHandle);
-	else
-		return createC(functionName, pHandle);
+		bSuccess = createVM(functionName, pHandle);
+	else{
+		bSuccess = createC(functionName, pHandle);
+	//	fall back to the in-process vm, e.g. if no C compiler is available
+		if(!bSuccess){
+			UG_DLOG(DID_LUACOMPILER, 1, "LUA2C: trying LUA2VM for " << functionName << "\n");
+			bSuccess = createVM(functionName, pHandle);
+		}
+	}
+
+	store_cache(functionName, pHandle, useLua2VM);
+	return bSuccess;
 }
 
 bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 {
 #ifdef USE_LUA2C
-	PROFILE_BEGIN_GROUP(LUACompiler_createVM, "LUA2C");
+	PROFILE_BEGIN_GROUP(LUACompiler_createC, "LUA2C");
 	UG_DLOG(DID_LUACOMPILER, 1, "LUA2C: parsing " << functionName << "... ");
 	try{
-		m_f=nullptr;
+		set_kernel(SPNULL, false);
+		SmartPtr<LUACompiledKernel> kernel(new LUACompiledKernel);
 		LUAParserClass parser;
 		int ret = 0;
 		if(pHandle == nullptr){
@@ -108,8 +232,8 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 			return false;
 		}
 
-		m_iIn = parser.num_in();
-		m_iOut = parser.num_out();
+		kernel->iIn = parser.num_in();
+		kernel->iOut = parser.num_out();
 		out.close();
 
 		UG_DLOG(DID_LUACOMPILER, 5, GetFileLines((p+"LUACompiler_output.c").c_str(), 1, -1, true) << "\n");
@@ -135,9 +259,13 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 		bool bTmpFileSuccess=false;
 		m_name = functionName;
 
-		m_pDyn = MakeTmpFile(p+string(functionName), ".dylib", bTmpFileSuccess);
+		kernel->pDyn = MakeTmpFile(p+string(functionName), ".dylib", bTmpFileSuccess);
 
-		string c2s=string("gcc -dynamiclib ") + p+"LUACompiler_output.o -o " + m_pDyn.c_str();
+#ifdef __APPLE__
+		string c2s=string("gcc -dynamiclib ") + p+"LUACompiler_output.o -o " + kernel->pDyn.c_str();
+#else
+		string c2s=string("gcc -shared ") + p+"LUACompiler_output.o -o " + kernel->pDyn.c_str();
+#endif
 
 		if(GetLogAssistant().is_output_process())
 		{	UG_DLOG(DID_LUACOMPILER, 2, "linking line: " << c2s << "\n"); }
@@ -157,7 +285,7 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 			return false;
 		}
 		try{
-		m_libHandle = OpenLibrary(m_pDyn.c_str());
+		kernel->libHandle = OpenLibrary(kernel->pDyn.c_str());
 		}
 		catch(std::string error)
 		{
@@ -165,13 +293,13 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 			UG_LOG("Error is " << error << "\n");
 			return false;
 		}
-		m_f = (LUA2C_Function) GetLibraryProcedure(m_libHandle, functionName);
+		kernel->f = (LUA2C_Function) GetLibraryProcedure(kernel->libHandle, functionName);
 
-		if(m_f !=nullptr) { UG_DLOG(DID_LUACOMPILER, 1, "OK\n"); }
+		if(kernel->f !=nullptr) { UG_DLOG(DID_LUACOMPILER, 1, "OK\n"); }
 		else { UG_DLOG(DID_LUACOMPILER, 1, "FAILED\n"); }
-		if(m_f !=nullptr)
-			bInitialized = true;
-		return m_f != nullptr;
+		if(kernel->f !=nullptr)
+			set_kernel(kernel, false);
+		return kernel->f != nullptr;
 	}
 	catch(...)
 	{
@@ -179,7 +307,8 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 		return false;
 	}
 #else
-	UG_THROW("LUA2C not enabled (use LUA2VM).")
+	UG_DLOG(DID_LUACOMPILER, 1, "LUA2C not enabled (use LUA2VM).\n");
+	return false;
 #endif
 
 }
@@ -188,19 +317,18 @@ bool LUACompiler::createVM(const char *functionName, LuaFunctionHandle* pHandle)
 {
 	PROFILE_BEGIN_GROUP(LUACompiler_createVM, "LUA2VM");
 	m_name = functionName;
-
+	set_kernel(SPNULL, true);
 
 	LUAParserClass parser;
+	SmartPtr<VMAdd> vm(new VMAdd);
 	try
 	{
 		int ret = 0;
 		if(pHandle == nullptr){
-			parser.parse_luaFunction(functionName);
+			ret = parser.parse_luaFunction(functionName);
 		} else {
-			parser.parse_luaFunction(*pHandle);
+			ret = parser.parse_luaFunction(*pHandle);
 		}
-		if(vm != nullptr) delete vm;
-		vm = new VMAdd;
 		if(ret == LUAParserClass::LUAParserError)
 		{
 			UG_LOG("parsing " << functionName << " failed: reduced LUA parser failed.\n");
@@ -236,35 +364,38 @@ bool LUACompiler::createVM(const char *functionName, LuaFunctionHandle* pHandle)
 		return false;
 	}
 	//UG_LOG(" ok.\n");
-	m_iIn = vm->num_in();
-	m_iOut = vm->num_out();
-	bInitialized = true;
-	bVM = true;
+	SmartPtr<LUACompiledKernel> kernel(new LUACompiledKernel);
+	kernel->vm = vm;
+	try
+	{
+		kernel->rvm = make_sp(new RegisterVM(*vm));
+		IF_DEBUG(DID_LUACOMPILER, 5)
+		{	kernel->rvm->print(); }
+	}
+	catch(UGError& e)
+	{
+		UG_DLOG(DID_LUACOMPILER, 1, "LUA2VM: using stack VM for " << functionName
+				<< ", no register program:\n" << e.get_msg() << "\n");
+	}
+	kernel->iIn = vm->num_in();
+	kernel->iOut = vm->num_out();
+	set_kernel(kernel, true);
 	return true;
 }
 
 
 LUACompiler::~LUACompiler()
 {
-	if(vm != nullptr) delete vm;
-
-    UG_DLOG(DID_LUACOMPILER, 2, "removing " << m_name << "\n");
-	if(m_libHandle)
-	   	CloseLibrary(m_libHandle);
-        
-    if(m_pDyn.size() > 0)
-    {
-		string s = string("rm ") + m_pDyn;
-		UG_DLOG(DID_LUACOMPILER, 2, s << "\n");
-		system(s.c_str());
-	}
 }
 
 bool LUACompiler::call(double *ret, const double *in) const
 {
 	if(bVM)
 	{
-		const_cast<LUACompiler*>(this)->vm->execute(ret, in);
+		if(m_kernel->rvm.valid())
+			const_cast<RegisterVM&>(*m_kernel->rvm).execute(ret, in);
+		else
+			const_cast<VMAdd&>(*m_kernel->vm).execute(ret, in);
 		return true;
 	}
 	else
@@ -275,6 +406,101 @@ bool LUACompiler::call(double *ret, const double *in) const
 	}
 }
 
+bool LUACompiler::call(double *ret, const double *in, size_t n) const
+{
+	if(bVM && m_kernel->rvm.valid())
+		const_cast<RegisterVM&>(*m_kernel->rvm).execute_batch(ret, in, n);
+	else if(bVM)
+	{
+		VMAdd& vm = const_cast<VMAdd&>(*m_kernel->vm);
+		for(size_t i = 0; i < n; ++i)
+			vm.execute(ret + i*m_iOut, in + i*m_iIn);
+	}
+	else
+	{
+		UG_ASSERT(m_f != nullptr, "function " << m_name << " not valid");
+		for(size_t i = 0; i < n; ++i)
+			m_f(ret + i*m_iOut, in + i*m_iIn);
+	}
+	return true;
+}
+
+
+
+static void PrintBenchmarkResult(const char *method, double t, double tLua, size_t numPoints,
+                                 const std::vector<double> &vRes, const std::vector<double> &vLua)
+{
+	double maxDiff = 0.0;
+	for(size_t i = 0; i < vRes.size(); ++i)
+		maxDiff = max(maxDiff, fabs(vRes[i] - vLua[i]));
+	UG_LOG(setw(12) << method << setw(14) << t << setw(14) << 1e9 * t / numPoints
+			<< setw(10) << tLua / t << setw(14) << maxDiff << "\n");
+}
+
+void LUACompiler::benchmark(const char *functionName, size_t numPoints)
+{
+	UG_COND_THROW(numPoints == 0, "LUACompiler::benchmark: no points.");
+	LUACompiler vm;
+	UG_COND_THROW(!vm.createVM(functionName), "LUA2VM: could not compile " << functionName);
+	const size_t nIn = vm.num_in(), nOut = vm.num_out();
+
+	std::vector<double> vIn(numPoints * nIn);
+	srand(0);
+	for(size_t i = 0; i < vIn.size(); ++i)
+		vIn[i] = rand() / (RAND_MAX + 1.0);
+	std::vector<double> vLua(numPoints * nOut), vRes(numPoints * nOut);
+
+//	reference: lua interpreter
+	lua_State* L = script::GetDefaultLuaState();
+	double tStart = get_clock_s();
+	for(size_t p = 0; p < numPoints; ++p)
+	{
+		GetLuaNamespace(L, functionName);
+		for(size_t i = 0; i < nIn; ++i)
+			lua_pushnumber(L, vIn[p*nIn + i]);
+		if(lua_pcall(L, nIn, nOut, 0) != 0)
+		{
+			string msg = lua_tostring(L, -1);
+			lua_pop(L, 1);
+			UG_THROW("LUACompiler::benchmark: error calling " << functionName << ": " << msg);
+		}
+		for(size_t o = 0; o < nOut; ++o)
+			vLua[p*nOut + o] = lua_tonumber(L, (int)o - (int)nOut);
+		lua_pop(L, nOut);
+	}
+	const double tLua = get_clock_s() - tStart;
+
+	UG_LOG("Benchmark of " << functionName << " (" << nIn << " inputs, " << nOut
+			<< " outputs) for " << numPoints << " points:\n");
+	UG_LOG(setw(12) << "method" << setw(14) << "time [s]" << setw(14) << "per call [ns]"
+			<< setw(10) << "speedup" << setw(14) << "max. diff" << "\n");
+	PrintBenchmarkResult("lua", tLua, tLua, numPoints, vLua, vLua);
+
+	VMAdd& stackVM = *vm.m_kernel->vm;
+	tStart = get_clock_s();
+	for(size_t p = 0; p < numPoints; ++p)
+		stackVM.execute(&vRes[p*nOut], &vIn[p*nIn]);
+	PrintBenchmarkResult("stack VM", get_clock_s() - tStart, tLua, numPoints, vRes, vLua);
+
+	if(vm.m_kernel->rvm.valid())
+	{
+		tStart = get_clock_s();
+		vm.m_kernel->rvm->execute_batch(&vRes[0], &vIn[0], numPoints);
+		PrintBenchmarkResult("register VM", get_clock_s() - tStart, tLua, numPoints, vRes, vLua);
+	}
+	else
+		UG_LOG(setw(12) << "register VM" << "  function could not be translated\n");
+
+	LUACompiler c;
+	if(c.createC(functionName))
+	{
+		tStart = get_clock_s();
+		c.call(&vRes[0], &vIn[0], numPoints);
+		PrintBenchmarkResult("LUA2C", get_clock_s() - tStart, tLua, numPoints, vRes, vLua);
+	}
+	else
+		UG_LOG(setw(12) << "LUA2C" << "  compilation to C not available\n");
+}
 
 }
 }
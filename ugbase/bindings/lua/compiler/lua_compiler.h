@@ -35,26 +35,65 @@
 
 #include <stdio.h>
 #include <string>
+#include <map>
 #include "common/util/dynamic_library_util.h"
+#include "common/util/smart_pointer.h"
 #include "bindings/lua/lua_function_handle.h"
 
 namespace ug{
 
 class VMAdd;
+class RegisterVM;
 
 namespace bridge {
 
+///	compiled code of a lua function, shared by all LUACompiler using it
+/**
+ * The kernel either consists of a function in a dynamic library created by
+ * the C code generator (LUA2C) or of a VMAdd program (LUA2VM), which runs
+ * in-process and does not need an external compiler. The VMAdd program is
+ * executed by a RegisterVM if it can be translated.
+ */
+struct LUACompiledKernel
+{
+	typedef int (*LUA2C_Function)(double *, const double *) ;
 
+	LUACompiledKernel();
+	~LUACompiledKernel();
+
+	DynLibHandle libHandle;
+	std::string pDyn;
+	LUA2C_Function f;
+	SmartPtr<VMAdd> vm;
+	SmartPtr<RegisterVM> rvm;
+	int iIn, iOut;
+};
 
 class LUACompiler
 {
 	
 private:
-	typedef int (*LUA2C_Function)(double *, const double *) ;
-	
-	DynLibHandle m_libHandle;
-	std::string m_pDyn;
-	VMAdd* vm;
+	typedef LUACompiledKernel::LUA2C_Function LUA2C_Function;
+
+	SmartPtr<LUACompiledKernel> m_kernel;
+
+	///	cache entry of a lua function
+	struct CacheEntry
+	{
+		CacheEntry();
+		int luaRef;		///< registry reference to the compiled lua function
+		bool bVM;
+		SmartPtr<LUACompiledKernel> kernel;
+	};
+
+	///	compiled kernels per function name or handle reference. Failed
+	///	compilations are cached, too.
+	static std::map<std::string, CacheEntry>& cache();
+
+	bool lookup_cache(const char *functionName, LuaFunctionHandle* pHandle, bool bVM);
+	void store_cache(const char *functionName, LuaFunctionHandle* pHandle, bool bVM);
+
+	void set_kernel(SmartPtr<LUACompiledKernel> kernel, bool bVM);
 
 public:
 	std::string m_name;
@@ -66,11 +105,9 @@ public:
 	{ 
 		m_f= nullptr;
 		m_name = "uninitialized"; 
-		m_pDyn = ""; 
-		m_libHandle = nullptr;
+		m_iIn = m_iOut = 0;
 		bInitialized = false;
 		bVM = false;
-		vm = nullptr;
 	}
 	
 	int num_in() const
@@ -93,11 +130,31 @@ public:
 		return bInitialized;
 	}
 	
+	///	marks the function as not compiled, i.e. the interpreter has to be used
+	void invalidate()
+	{
+		bInitialized = false;
+	}
+
+	///	compiles the function (LUA2C or LUA2VM). Kernels are cached.
+	/**	If compilation to C fails, the in-process LUA2VM is tried.*/
 	bool create(const char *functionName, LuaFunctionHandle* pHandle = nullptr);
 	bool createVM(const char *functionName, LuaFunctionHandle* pHandle = nullptr);
 	bool createC(const char *functionName, LuaFunctionHandle* pHandle = nullptr);
 	
 	bool call(double *ret, const double *in) const;
+
+	///	evaluates the function for n argument sets
+	/**	in holds n*num_in() values, ret n*num_out() values.*/
+	bool call(double *ret, const double *in, size_t n) const;
+
+	///	removes all cached kernels (e.g. if lua functions have been redefined)
+	static void clear_cache();
+
+	///	compares timings of lua, LUA2VM and LUA2C for a function with numbers as arguments
+	/**	The function is evaluated for numPoints random argument sets in [0,1).*/
+	static void benchmark(const char *functionName, size_t numPoints);
+
 	virtual ~LUACompiler();
 };
 
@@ -198,7 +198,7 @@ public:
 	int num_in()
 	{
 		nodeType *a = args;
-		int i=0;
+		int i=1;
 		while(a->type == typeOpr)
 		{
 			i++;
@@ -313,6 +313,8 @@ int LUAParserClass::createC(ostream &out)
     }
 
     out << "#define LUAPARSER_MATH_PI 3.1415926535897932384626433832795028841971693\n";
+    out << "static inline double min(double a, double b) { return (a < b) ? a : b; }\n";
+    out << "static inline double max(double a, double b) { return (a > b) ? a : b; }\n";
     out << "// inline function declarations\n";
     out << declarations.str() << "\n";
 
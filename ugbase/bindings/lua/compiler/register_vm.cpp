@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "register_vm.h"
+#include "vm.h"
+#include "common/error.h"
+#include "common/assert.h"
+#include "common/log.h"
+
+using namespace std;
+
+namespace ug{
+
+static bool IsRegisterVMUnary(int op)
+{
+	switch(op)
+	{
+		case LUAPARSER_MATH_COS:
+		case LUAPARSER_MATH_SIN:
+		case LUAPARSER_MATH_EXP:
+		case LUAPARSER_MATH_ABS:
+		case LUAPARSER_MATH_LOG:
+		case LUAPARSER_MATH_LOG10:
+		case LUAPARSER_MATH_SQRT:
+		case LUAPARSER_MATH_FLOOR:
+		case LUAPARSER_MATH_CEIL:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static bool IsRegisterVMBinary(int op)
+{
+	switch(op)
+	{
+		case '+': case '-': case '*': case '/': case '<': case '>':
+		case LUAPARSER_GE:
+		case LUAPARSER_LE:
+		case LUAPARSER_NE:
+		case LUAPARSER_EQ:
+		case LUAPARSER_AND:
+		case LUAPARSER_OR:
+		case LUAPARSER_MATH_POW:
+		case LUAPARSER_MATH_MIN:
+		case LUAPARSER_MATH_MAX:
+			return true;
+		default:
+			return false;
+	}
+}
+
+//	loops over all lanes of a register. The loops have a fixed length, so
+//	that the compiler can vectorize them.
+#define RVM_LANES(expr)		for(int l = 0; l < RegisterVM::NUM_LANES; ++l) d[l] = (expr); break;
+
+static inline void RegisterVMUnary(int op, double *d, const double *x)
+{
+	switch(op)
+	{
+		case LUAPARSER_MATH_COS:	RVM_LANES(cos(x[l]))
+		case LUAPARSER_MATH_SIN:	RVM_LANES(sin(x[l]))
+		case LUAPARSER_MATH_EXP:	RVM_LANES(exp(x[l]))
+		case LUAPARSER_MATH_ABS:	RVM_LANES(fabs(x[l]))
+		case LUAPARSER_MATH_LOG:	RVM_LANES(log(x[l]))
+		case LUAPARSER_MATH_LOG10:	RVM_LANES(log10(x[l]))
+		case LUAPARSER_MATH_SQRT:	RVM_LANES(sqrt(x[l]))
+		case LUAPARSER_MATH_FLOOR:	RVM_LANES(floor(x[l]))
+		case LUAPARSER_MATH_CEIL:	RVM_LANES(ceil(x[l]))
+	}
+}
+
+///	d = x op y, with the semantics of VMAdd::execute_binary
+static inline void RegisterVMBinary(int op, double *d, const double *x, const double *y)
+{
+	switch(op)
+	{
+		case '+':	RVM_LANES(x[l] + y[l])
+		case '-':	RVM_LANES(x[l] - y[l])
+		case '*':	RVM_LANES(x[l] * y[l])
+		case '/':	RVM_LANES(x[l] / y[l])
+		case '<':	RVM_LANES((x[l] < y[l]) ? 1.0 : 0.0)
+		case '>':	RVM_LANES((x[l] > y[l]) ? 1.0 : 0.0)
+		case LUAPARSER_GE:	RVM_LANES((x[l] >= y[l]) ? 1.0 : 0.0)
+		case LUAPARSER_LE:	RVM_LANES((x[l] <= y[l]) ? 1.0 : 0.0)
+		case LUAPARSER_NE:	RVM_LANES((x[l] != y[l]) ? 1.0 : 0.0)
+		case LUAPARSER_EQ:	RVM_LANES((x[l] == y[l]) ? 1.0 : 0.0)
+		case LUAPARSER_AND:	RVM_LANES((x[l] != 0.0 && y[l] != 0.0) ? 1.0 : 0.0)
+		case LUAPARSER_OR:	RVM_LANES((x[l] != 0.0 || y[l] != 0.0) ? 1.0 : 0.0)
+		case LUAPARSER_MATH_POW:	RVM_LANES(pow(x[l], y[l]))
+		case LUAPARSER_MATH_MIN:	RVM_LANES((x[l] < y[l]) ? x[l] : y[l])
+		case LUAPARSER_MATH_MAX:	RVM_LANES((x[l] > y[l]) ? x[l] : y[l])
+	}
+}
+
+#undef RVM_LANES
+
+
+RegisterVM::RegisterVM()
+	: m_nrIn(0), m_nrOut(0), m_retOperands(0), m_pDivergedCond(NULL)
+{
+}
+
+RegisterVM::RegisterVM(VMAdd &vm)
+	: m_nrIn(0), m_nrOut(0), m_retOperands(0), m_pDivergedCond(NULL)
+{
+	SubMap translated;
+	std::set<VMAdd*> inProgress;
+	translate(vm, translated, inProgress);
+}
+
+void RegisterVM::translate(VMAdd &vm, SubMap &translated, std::set<VMAdd*> &inProgress)
+{
+	m_name = vm.m_name;
+	m_nrIn = vm.m_nrIn;
+	m_nrOut = vm.m_nrOut;
+
+//	translate subfunctions first, so that their number of inputs is known
+	inProgress.insert(&vm);
+	for(size_t i = 0; i < vm.subfunctions.size(); ++i)
+	{
+		VMAdd* sub = vm.subfunctions[i].get();
+		UG_COND_THROW(inProgress.count(sub) != 0,
+				"RegisterVM: recursive subfunction " << sub->m_name << " not supported.");
+		SubMap::iterator it = translated.find(sub);
+		if(it == translated.end())
+		{
+			SmartPtr<RegisterVM> rsub(new RegisterVM);
+			rsub->translate(*sub, translated, inProgress);
+			UG_COND_THROW(rsub->num_out() != 1, "RegisterVM: subfunction "
+					<< sub->m_name << " has " << rsub->num_out() << " return values.");
+			it = translated.insert(make_pair(sub, rsub)).first;
+		}
+		m_vSub.push_back(it->second);
+	}
+	inProgress.erase(&vm);
+
+	const std::vector<char> &buf = vm.vmBuf;
+	const int numVar = (int)vm.variables.size();
+	UG_COND_THROW(m_nrIn > (size_t)numVar, "RegisterVM: more inputs than variables in " << m_name);
+
+//	find all jump targets
+	std::set<size_t> targets;
+	for(size_t i = 0; i < buf.size(); )
+	{
+		VMAdd::VMInstruction instr;
+		vm.deserializeVMInstr(i, instr);
+		int iVal;
+		double dVal;
+		switch(instr)
+		{
+			case VMAdd::PUSH_CONSTANT:	vm.deserializeDouble(i, dVal); break;
+			case VMAdd::OP_RETURN:		break;
+			case VMAdd::JMP_IF_FALSE:
+			case VMAdd::JMP:
+				vm.deserializeInt(i, iVal);
+				targets.insert(iVal);
+				break;
+			default:
+				vm.deserializeInt(i, iVal);
+		}
+	}
+
+//	Registers are numbered [variables, stack slots, constants]. Since the
+//	maximal stack depth is known only at the end, constant k is denoted by
+//	-(k+1) until then.
+	std::vector<double> vConst;
+	std::map<unsigned long long, int> constIndex;
+	std::vector<int> slot;
+	size_t maxDepth = 0;
+
+//	depth of the stack at jump targets and the corresponding instruction
+	std::map<size_t, size_t> labelDepth;
+	std::map<size_t, size_t> labelInstr;
+	std::vector<std::pair<size_t, size_t> > jumps;
+	size_t lastLabel = (size_t)-1;
+	bool bReachable = true;
+
+	for(size_t i = 0; i < buf.size(); )
+	{
+		const size_t pos = i;
+		if(targets.count(pos))
+		{
+			std::map<size_t, size_t>::iterator it = labelDepth.find(pos);
+			if(bReachable)
+			{
+				for(size_t d = 0; d < slot.size(); ++d)
+					if(slot[d] != numVar + (int)d){
+						m_vInstr.push_back(Instr(RVM_MOV, 0, numVar + d, slot[d], 0));
+						slot[d] = numVar + d;
+					}
+				UG_COND_THROW(it != labelDepth.end() && it->second != slot.size(),
+						"RegisterVM: inconsistent stack depth at " << pos << " in " << m_name);
+			}
+			else if(it != labelDepth.end())
+			{
+				bReachable = true;
+				slot.resize(it->second);
+				for(size_t d = 0; d < slot.size(); ++d)
+					slot[d] = numVar + d;
+			}
+			labelInstr[pos] = m_vInstr.size();
+			lastLabel = m_vInstr.size();
+		}
+
+		VMAdd::VMInstruction instr;
+		vm.deserializeVMInstr(i, instr);
+		int iVal = 0;
+		double dVal = 0.0;
+		if(instr == VMAdd::PUSH_CONSTANT) vm.deserializeDouble(i, dVal);
+		else if(instr != VMAdd::OP_RETURN) vm.deserializeInt(i, iVal);
+
+	//	code behind a return or an unconditional jump, which is not a jump target
+		if(!bReachable) continue;
+
+		const int d = (int)slot.size();
+		switch(instr)
+		{
+			case VMAdd::PUSH_CONSTANT:
+			{
+				unsigned long long bits;
+				memcpy(&bits, &dVal, sizeof(bits));
+				std::map<unsigned long long, int>::iterator it = constIndex.find(bits);
+				if(it == constIndex.end()){
+					it = constIndex.insert(make_pair(bits, (int)vConst.size())).first;
+					vConst.push_back(dVal);
+				}
+				slot.push_back(-(it->second+1));
+				break;
+			}
+
+			case VMAdd::PUSH_VAR:
+				UG_COND_THROW(iVal < 1 || iVal > numVar, "RegisterVM: invalid variable " << iVal);
+				slot.push_back(iVal-1);
+				break;
+
+			case VMAdd::ASSIGN:
+			{
+				UG_COND_THROW(d < 1, "RegisterVM: stack underflow in " << m_name);
+				UG_COND_THROW(iVal < 1 || iVal > numVar, "RegisterVM: invalid variable " << iVal);
+				const int var = iVal-1;
+			//	values of the variable still on the stack have to be saved first
+				for(int e = 0; e < d-1; ++e)
+					if(slot[e] == var){
+						m_vInstr.push_back(Instr(RVM_MOV, 0, numVar + e, var, 0));
+						slot[e] = numVar + e;
+					}
+				const int src = slot[d-1];
+				slot.pop_back();
+			//	let the instruction computing the value write to the variable directly
+				if(src == numVar + d-1 && !m_vInstr.empty() && lastLabel != m_vInstr.size()
+					&& m_vInstr.back().dst == src && m_vInstr.back().code != RVM_JMP
+					&& m_vInstr.back().code != RVM_JMP_IF_FALSE
+					&& m_vInstr.back().code != RVM_RETURN)
+					m_vInstr.back().dst = var;
+				else if(src != var)
+					m_vInstr.push_back(Instr(RVM_MOV, 0, var, src, 0));
+				break;
+			}
+
+			case VMAdd::OP_UNARY:
+				UG_COND_THROW(d < 1, "RegisterVM: stack underflow in " << m_name);
+				UG_COND_THROW(!IsRegisterVMUnary(iVal), "RegisterVM: unknown unary operator " << iVal);
+				m_vInstr.push_back(Instr(RVM_UNARY, iVal, numVar + d-1, slot[d-1], 0));
+				slot[d-1] = numVar + d-1;
+				break;
+
+			case VMAdd::OP_BINARY:
+			//	the top of the stack is the left operand (see vm.doxygen)
+				UG_COND_THROW(d < 2, "RegisterVM: stack underflow in " << m_name);
+				UG_COND_THROW(!IsRegisterVMBinary(iVal), "RegisterVM: unknown binary operator " << iVal);
+				m_vInstr.push_back(Instr(RVM_BINARY, iVal, numVar + d-2, slot[d-1], slot[d-2]));
+				slot.pop_back();
+				slot[d-2] = numVar + d-2;
+				break;
+
+			case VMAdd::JMP_IF_FALSE:
+			case VMAdd::JMP:
+			{
+				UG_COND_THROW(iVal <= (int)pos || iVal >= (int)buf.size(),
+						"RegisterVM: unsupported jump from " << pos << " to " << iVal << " in " << m_name);
+				int cond = 0;
+				if(instr == VMAdd::JMP_IF_FALSE){
+					UG_COND_THROW(d < 1, "RegisterVM: stack underflow in " << m_name);
+					cond = slot[d-1];
+					slot.pop_back();
+				}
+				for(size_t e = 0; e < slot.size(); ++e)
+					if(slot[e] != numVar + (int)e){
+						m_vInstr.push_back(Instr(RVM_MOV, 0, numVar + e, slot[e], 0));
+						slot[e] = numVar + e;
+					}
+
+				std::map<size_t, size_t>::iterator it = labelDepth.find(iVal);
+				UG_COND_THROW(it != labelDepth.end() && it->second != slot.size(),
+						"RegisterVM: inconsistent stack depth at " << iVal << " in " << m_name);
+				labelDepth[iVal] = slot.size();
+
+				jumps.push_back(make_pair(m_vInstr.size(), (size_t)iVal));
+				if(instr == VMAdd::JMP_IF_FALSE)
+					m_vInstr.push_back(Instr(RVM_JMP_IF_FALSE, 0, 0, cond, 0));
+				else{
+					m_vInstr.push_back(Instr(RVM_JMP, 0, 0, 0, 0));
+					bReachable = false;
+				}
+				break;
+			}
+
+			case VMAdd::OP_CALL:
+			{
+				UG_COND_THROW(iVal < 0 || iVal >= (int)m_vSub.size(), "RegisterVM: invalid subfunction " << iVal);
+				const int nIn = (int)m_vSub[iVal]->num_in();
+				UG_COND_THROW(d < nIn, "RegisterVM: stack underflow in " << m_name);
+				const int offset = (int)m_vOperand.size();
+				for(int e = d - nIn; e < d; ++e)
+					m_vOperand.push_back(slot[e]);
+				m_vInstr.push_back(Instr(RVM_CALL, iVal, numVar + d-nIn, offset, 0));
+				slot.resize(d - nIn);
+				slot.push_back(numVar + d-nIn);
+				break;
+			}
+
+			case VMAdd::OP_RETURN:
+			{
+				UG_COND_THROW(d != (int)m_nrOut, "RegisterVM: returning " << d
+						<< " values instead of " << m_nrOut << " in " << m_name);
+				const int offset = (int)m_vOperand.size();
+				for(int e = 0; e < d; ++e)
+					m_vOperand.push_back(slot[e]);
+				m_vInstr.push_back(Instr(RVM_RETURN, 0, 0, offset, 0));
+				slot.clear();
+				bReachable = false;
+				break;
+			}
+
+			default:
+				UG_THROW("RegisterVM: unknown instruction " << (int)instr << " in " << m_name);
+		}
+		maxDepth = max(maxDepth, slot.size());
+	}
+	UG_COND_THROW(bReachable, "RegisterVM: function " << m_name << " does not end with a return.");
+
+//	resolve jump targets and constant registers
+	for(size_t j = 0; j < jumps.size(); ++j)
+	{
+		std::map<size_t, size_t>::iterator it = labelInstr.find(jumps[j].second);
+		UG_COND_THROW(it == labelInstr.end(), "RegisterVM: invalid jump target in " << m_name);
+		m_vInstr[jumps[j].first].dst = it->second;
+	}
+
+	const int constBase = numVar + (int)maxDepth;
+	for(size_t k = 0; k < m_vInstr.size(); ++k)
+	{
+		Instr &I = m_vInstr[k];
+		if(I.code == RVM_MOV || I.code == RVM_UNARY || I.code == RVM_BINARY
+			|| I.code == RVM_JMP_IF_FALSE)
+		{
+			if(I.a < 0) I.a = constBase - I.a - 1;
+			if(I.b < 0) I.b = constBase - I.b - 1;
+		}
+	}
+	for(size_t k = 0; k < m_vOperand.size(); ++k)
+		if(m_vOperand[k] < 0) m_vOperand[k] = constBase - m_vOperand[k] - 1;
+
+	m_vReg.assign((constBase + vConst.size()) * NUM_LANES, 0.0);
+	for(size_t k = 0; k < vConst.size(); ++k)
+	{
+		double *r = reg(constBase + k);
+		for(int l = 0; l < NUM_LANES; ++l)
+			r[l] = vConst[k];
+	}
+}
+
+bool RegisterVM::run()
+{
+	size_t ip = 0;
+	for(;;)
+	{
+		const Instr &I = m_vInstr[ip++];
+		switch(I.code)
+		{
+			case RVM_MOV:
+			{
+				double *d = reg(I.dst);
+				const double *x = reg(I.a);
+				for(int l = 0; l < NUM_LANES; ++l)
+					d[l] = x[l];
+				break;
+			}
+
+			case RVM_UNARY:
+				RegisterVMUnary(I.op, reg(I.dst), reg(I.a));
+				break;
+
+			case RVM_BINARY:
+				RegisterVMBinary(I.op, reg(I.dst), reg(I.a), reg(I.b));
+				break;
+
+			case RVM_JMP_IF_FALSE:
+			{
+				const double *c = reg(I.a);
+				const bool bFalse = (c[0] == 0.0);
+				for(int l = 1; l < NUM_LANES; ++l)
+					if((c[l] == 0.0) != bFalse){
+						m_pDivergedCond = c;
+						return false;
+					}
+				if(bFalse) ip = I.dst;
+				break;
+			}
+
+			case RVM_JMP:
+				ip = I.dst;
+				break;
+
+			case RVM_CALL:
+			{
+				RegisterVM &sub = *m_vSub[I.op];
+				for(size_t i = 0; i < sub.m_nrIn; ++i)
+				{
+					double *d = sub.reg(i);
+					const double *x = reg(m_vOperand[I.a + i]);
+					for(int l = 0; l < NUM_LANES; ++l)
+						d[l] = x[l];
+				}
+				if(!sub.run()){
+					m_pDivergedCond = sub.m_pDivergedCond;
+					return false;
+				}
+
+				double *d = reg(I.dst);
+				const double *x = sub.reg(sub.m_vOperand[sub.m_retOperands]);
+				for(int l = 0; l < NUM_LANES; ++l)
+					d[l] = x[l];
+				break;
+			}
+
+			case RVM_RETURN:
+				m_retOperands = I.a;
+				return true;
+		}
+	}
+}
+
+void RegisterVM::execute_lanes(double *ret, const double *in, const size_t *vIndex, size_t num)
+{
+//	lanes >= num are filled with the last argument set
+	for(size_t i = 0; i < m_nrIn; ++i)
+	{
+		double *r = reg(i);
+		for(size_t l = 0; l < (size_t)NUM_LANES; ++l)
+			r[l] = in[vIndex[min(l, num-1)] * m_nrIn + i];
+	}
+
+	if(run())
+	{
+		for(size_t o = 0; o < m_nrOut; ++o)
+		{
+			const double *r = reg(m_vOperand[m_retOperands + o]);
+			for(size_t l = 0; l < num; ++l)
+				ret[vIndex[l] * m_nrOut + o] = r[l];
+		}
+		return;
+	}
+
+//	the lanes took different branches: evaluate the lanes of each branch separately
+	size_t vFalse[NUM_LANES], vTrue[NUM_LANES];
+	size_t numFalse = 0, numTrue = 0;
+	for(size_t l = 0; l < num; ++l)
+	{
+		if(m_pDivergedCond[l] == 0.0) vFalse[numFalse++] = vIndex[l];
+		else vTrue[numTrue++] = vIndex[l];
+	}
+	UG_ASSERT(numFalse > 0 && numTrue > 0, "lanes diverged for identical input in " << m_name);
+	execute_lanes(ret, in, vFalse, numFalse);
+	execute_lanes(ret, in, vTrue, numTrue);
+}
+
+void RegisterVM::execute_batch(double *ret, const double *in, size_t n)
+{
+	size_t vIndex[NUM_LANES];
+	for(size_t first = 0; first < n; first += NUM_LANES)
+	{
+		const size_t num = min((size_t)NUM_LANES, n - first);
+		for(size_t l = 0; l < num; ++l)
+			vIndex[l] = first + l;
+		execute_lanes(ret, in, vIndex, num);
+	}
+}
+
+void RegisterVM::execute(double *ret, const double *in)
+{
+	execute_batch(ret, in, 1);
+}
+
+void RegisterVM::print() const
+{
+	UG_LOG("register program " << m_name << ", " << m_nrIn << " inputs, " << m_nrOut
+			<< " outputs, " << m_vReg.size() / NUM_LANES << " registers, "
+			<< m_vSub.size() << " subfunctions\n");
+	for(size_t k = 0; k < m_vInstr.size(); ++k)
+	{
+		const Instr &I = m_vInstr[k];
+		UG_LOG(k << "\t");
+		switch(I.code)
+		{
+			case RVM_MOV:		UG_LOG("MOV r" << I.dst << " = r" << I.a << "\n"); break;
+			case RVM_UNARY:		UG_LOG("UNARY r" << I.dst << " = op" << I.op << "(r" << I.a << ")\n"); break;
+			case RVM_BINARY:	UG_LOG("BINARY r" << I.dst << " = r" << I.a << " op" << I.op << " r" << I.b << "\n"); break;
+			case RVM_JMP_IF_FALSE:	UG_LOG("JMP_IF_FALSE r" << I.a << " " << I.dst << "\n"); break;
+			case RVM_JMP:		UG_LOG("JMP " << I.dst << "\n"); break;
+			case RVM_CALL:		UG_LOG("CALL r" << I.dst << " = " << m_vSub[I.op]->m_name << "\n"); break;
+			case RVM_RETURN:
+				UG_LOG("RETURN");
+				for(size_t o = 0; o < m_nrOut; ++o)
+					UG_LOG(" r" << m_vOperand[I.a + o]);
+				UG_LOG("\n");
+				break;
+		}
+	}
+}
+
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef REGISTER_VM_H_
+#define REGISTER_VM_H_
+
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include "common/util/smart_pointer.h"
+
+namespace ug{
+
+class VMAdd;
+
+///	register based virtual machine evaluating a VMAdd program for batches of inputs
+/**
+ * The stack program of a VMAdd is translated once into a register program:
+ * every variable, every constant and every stack slot gets a register, and
+ * pushes of variables and constants do not produce instructions at all.
+ *
+ * Each register holds NUM_LANES values, so every instruction is executed for
+ * NUM_LANES argument sets at once (in loops of fixed length, which the
+ * compiler can map to SIMD instructions). execute_batch evaluates an array
+ * of argument sets (e.g. all integration points of an element) in blocks of
+ * NUM_LANES. If the lanes of a block take different branches, the block is
+ * split into the lanes taking the same branch, which are evaluated again.
+ *
+ * Programs with constructs the translation does not support (backward jumps,
+ * recursive subfunctions) throw an UGError in the constructor. Then the
+ * VMAdd has to be used directly.
+ */
+class RegisterVM
+{
+	public:
+		enum {NUM_LANES = 8};
+
+	///	translates the program of vm (and its subfunctions)
+		explicit RegisterVM(VMAdd &vm);
+
+	///	evaluates the function for one set of arguments
+		void execute(double *ret, const double *in);
+
+	///	evaluates the function for n argument sets
+	/**	in holds n*num_in() values, ret n*num_out() values.*/
+		void execute_batch(double *ret, const double *in, size_t n);
+
+		size_t num_in() const	{return m_nrIn;}
+		size_t num_out() const	{return m_nrOut;}
+
+		void print() const;
+
+	private:
+		typedef std::map<VMAdd*, SmartPtr<RegisterVM> > SubMap;
+
+		RegisterVM();
+
+		void translate(VMAdd &vm, SubMap &translated, std::set<VMAdd*> &inProgress);
+
+	///	executes the program on the current register contents
+	/**	returns false if the lanes diverge at a conditional jump. The
+	 * condition is then available in m_pDivergedCond.*/
+		bool run();
+
+	///	evaluates the argument sets vIndex[0], ..., vIndex[num-1] (num <= NUM_LANES)
+	/**	If the lanes diverge, they are split according to the branch taken and
+	 * both parts are evaluated separately.*/
+		void execute_lanes(double *ret, const double *in, const size_t *vIndex, size_t num);
+
+		enum Opcode
+		{
+			RVM_MOV=0,		///< reg[dst] = reg[a]
+			RVM_UNARY,		///< reg[dst] = op(reg[a])
+			RVM_BINARY,		///< reg[dst] = reg[a] op reg[b]
+			RVM_JMP_IF_FALSE,	///< if reg[a] == 0 goto dst
+			RVM_JMP,		///< goto dst
+			RVM_CALL,		///< reg[dst] = sub[op](reg[m_vOperand[a+i]])
+			RVM_RETURN		///< return reg[m_vOperand[a+i]]
+		};
+
+		struct Instr
+		{
+			Instr(int code_, int op_, int dst_, int a_, int b_)
+				: code(code_), op(op_), dst(dst_), a(a_), b(b_) {}
+			int code, op, dst, a, b;
+		};
+
+		double* reg(int r)	{return &m_vReg[r*NUM_LANES];}
+
+		std::vector<Instr> m_vInstr;
+
+	///	register lists of call arguments and return values
+		std::vector<int> m_vOperand;
+
+		std::vector<SmartPtr<RegisterVM> > m_vSub;
+
+	///	register file, NUM_LANES values per register. Constants are set once.
+		std::vector<double> m_vReg;
+
+		size_t m_nrIn, m_nrOut;
+
+	///	operand offset of the executed return instruction
+		int m_retOperands;
+
+	///	lanes of the condition register at which run() stopped
+		const double *m_pDivergedCond;
+
+		std::string m_name;
+};
+
+}
+#endif /* REGISTER_VM_H_ */
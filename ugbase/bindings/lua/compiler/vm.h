@@ -47,6 +47,8 @@ namespace ug{
 //////////////////////////////////////////
 class VMAdd
 {
+	friend class RegisterVM;
+
 private:
 	std::vector<char> vmBuf;
 	std::string m_name;
@@ -396,8 +398,8 @@ public:
 			case LUAPARSER_AND: 	a = (a != 0.0 && b != 0.0) ? 1.0 : 0.0; break;
 			case LUAPARSER_OR: 	a = (a != 0 || b != 0) ? 1.0 : 0.0; break;
 			case LUAPARSER_MATH_POW: 	a = pow(b, a); break;
-			case LUAPARSER_MATH_MIN: 	a = (b < a) ? a : b; break;
-			case LUAPARSER_MATH_MAX: 	a = (b > a) ? a : b; break;
+			case LUAPARSER_MATH_MIN: 	a = (b < a) ? b : a; break;
+			case LUAPARSER_MATH_MAX: 	a = (b > a) ? b : a; break;
 		}
 	}
 
@@ -488,10 +490,14 @@ public:
 
 	double call_sub(double *stack, int &SP)
 	{
-		for(size_t i=0; i<m_nrIn; i++)
-			variables[i] = stack[SP+i-1];
 		SP -= m_nrIn;
-		return call(stack, SP);
+		for(size_t i=0; i<m_nrIn; i++)
+			variables[i] = stack[SP+i];
+	//	the subfunction uses the stack above its arguments
+		int subSP = 0;
+		double r = call(stack+SP, subSP);
+		SP += subSP;
+		return r;
 	}
 
 	int execute(double *ret, const double *in)
@@ -79,6 +79,10 @@ extern "C" // default lua
 
 #include "info_commands.h"
 
+#ifdef USE_LUA2C
+#include "compiler/lua_compiler.h"
+#endif
+
 
 using namespace std;
 
@@ -1237,6 +1241,18 @@ void EnableLUA2VM(bool b)
 	useLua2VM=b;
 }
 
+#ifdef USE_LUA2C
+void ClearLUA2CCache()
+{
+	LUACompiler::clear_cache();
+}
+
+void BenchmarkLUA2VM(const char *functionName, size_t numPoints)
+{
+	LUACompiler::benchmark(functionName, numPoints);
+}
+#endif
+
 bool RegisterSerializationCommands(Registry &reg, const char* parentGroup);
 
 bool RegisterInfoCommands(Registry &reg, const char* parentGroup)
@@ -1289,6 +1305,12 @@ bool RegisterInfoCommands(Registry &reg, const char* parentGroup)
 		                 "", "bEnable", "");
 		reg.add_function("EnableLUA2VM", &EnableLUA2VM, grp.c_str(),
 				"", "bEnable", "");
+#ifdef USE_LUA2C
+		reg.add_function("ClearLUA2CCache", &ClearLUA2CCache, grp.c_str(),
+				"", "", "removes all cached compiled lua functions, e.g. after changing global parameters used in them");
+		reg.add_function("BenchmarkLUA2VM", &BenchmarkLUA2VM, grp.c_str(),
+				"", "functionName#numPoints", "compares the lua interpreter, LUA2VM and LUA2C for a function with number arguments");
+#endif
 		reg.add_function("InitSignals", &InitSignals, grp.c_str());
 	}
 	UG_REGISTRY_CATCH_THROW(grp);
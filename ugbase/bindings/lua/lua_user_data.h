@@ -135,7 +135,19 @@ class LuaUserData
 	///	evaluates the data at a given point and time
 		inline TRet evaluate(TData& D, const MathVector<dim>& x, number time, int si) const;
 
+	///	evaluates the data at several points
+	/**
+	 * If the callback has been compiled (LUA2C/LUA2VM), the arguments of all
+	 * points are packed and the compiled kernel is called for all points at
+	 * once. Otherwise, the lua interpreter is called for every point.
+	 */
+		void evaluate_batch(TData vValue[], const MathVector<dim> vGlobIP[],
+		                    number time, int si, const size_t nip) const;
+
 	protected:
+	///	evaluates the data at a given point and time using the lua interpreter
+		TRet evaluate_lua(TData& D, const MathVector<dim>& x, number time, int si) const;
+
 	///	sets that LuaUserData is created by LuaUserDataFactory
 		void set_created_from_factory(bool bFromFactory) {m_bFromFactory = bFromFactory;}
 
@@ -147,8 +159,27 @@ class LuaUserData
 		int m_callbackRef;
 		
 		#ifdef USE_LUA2C
-    	/// LUACompiler type for compiled LUA code
-			bridge::LUACompiler m_luaComp;
+	///	compiles the callback and checks the compiled code against the interpreter
+		void compile_callback(LuaFunctionHandle* pHandle);
+
+	///	compares compiled results with the interpreter for some of the evaluated points
+	/**
+	 * The first points and afterwards the points with a power of two as
+	 * running number are checked, such that the checked points are spread
+	 * over the domain. On mismatch, the compiled code is dropped and false
+	 * is returned.
+	 */
+		bool check_compiled(const TData vValue[], const MathVector<dim> vGlobIP[],
+		                    number time, int si, const size_t nip) const;
+
+    	/// LUACompiler type for compiled LUA code (dropped if check_compiled fails)
+			mutable bridge::LUACompiler m_luaComp;
+
+	///	packed arguments and results for batched evaluation of compiled code
+			mutable std::vector<double> m_vCompIn, m_vCompOut;
+
+	///	number of points evaluated with the compiled code
+			mutable size_t m_numCompEval;
 		#endif
 	///	flag, indicating if created from factory
 		bool m_bFromFactory;
@@ -111,7 +111,8 @@ LuaUserData<TData,dim,TRet>::LuaUserData(const char* luaCallback)
 	check_callback_returns(m_L, m_callbackRef, m_callbackName.c_str(), true);
 	
 	#ifdef USE_LUA2C
-		if(useLuaCompiler) m_luaComp.create(luaCallback);
+		m_numCompEval = 0;
+		if(useLuaCompiler) compile_callback(NULL);
 	#endif
 }
 
@@ -129,11 +130,119 @@ LuaUserData<TData,dim,TRet>::LuaUserData(LuaFunctionHandle handle)
 	check_callback_returns(m_L, m_callbackRef, m_callbackName.c_str(), true);
 
 	#ifdef USE_LUA2C
-//		UG_THROW("LuaFunctionHandle usage currently not supported with LUA2C.");
-		if(useLuaCompiler) m_luaComp.create(m_callbackName.c_str(), &handle);
+		m_numCompEval = 0;
+		if(useLuaCompiler) compile_callback(&handle);
 	#endif
 }
 
+#ifdef USE_LUA2C
+///	returns the largest difference of compiled and interpreted results
+/// \{
+inline number LuaCompiledDeviation(const number& a, const number& b)
+{
+	return fabs(a - b) / std::max(1.0, fabs(b));
+}
+
+template <std::size_t dim>
+inline number LuaCompiledDeviation(const MathVector<dim>& a, const MathVector<dim>& b)
+{
+	number dev = 0;
+	for(size_t i = 0; i < dim; ++i)
+		dev = std::max(dev, LuaCompiledDeviation(a[i], b[i]));
+	return dev;
+}
+
+template <std::size_t dim>
+inline number LuaCompiledDeviation(const MathMatrix<dim, dim>& a, const MathMatrix<dim, dim>& b)
+{
+	number dev = 0;
+	for(size_t i = 0; i < dim; ++i)
+		for(size_t j = 0; j < dim; ++j)
+			dev = std::max(dev, LuaCompiledDeviation(a[i][j], b[i][j]));
+	return dev;
+}
+/// \}
+
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::compile_callback(LuaFunctionHandle* pHandle)
+{
+	if(!m_luaComp.create(m_callbackName.c_str(), pHandle))
+		return;
+
+//	the compiled code must match the signature of the callback
+	const int numIn = dim + 2;
+	const int numOut = lua_traits<TData>::size + lua_traits<TRet>::size;
+	if(m_luaComp.num_in() != numIn || m_luaComp.num_out() != numOut){
+		UG_LOG("WARNING (in " << name() << "): Compiled callback '"
+				<< m_callbackName << "' has " << m_luaComp.num_in() << " arguments and "
+				<< m_luaComp.num_out() << " return values, expected " << numIn
+				<< " and " << numOut << ". Using the lua interpreter.\n");
+		m_luaComp.invalidate();
+		return;
+	}
+
+//	compare compiled and interpreted results at test points spread over
+//	[-10,10]^dim, for several times and subsets. Points at which the
+//	interpreter fails are skipped. The points of the domain are checked
+//	during the evaluation (see check_compiled).
+	for(int k = 0; k < 32; ++k){
+		MathVector<dim> x;
+		const number scale = (k % 2) ? 10.0 : 1.0;
+		for(int i = 0; i < dim; ++i) x[i] = scale * sin(1.7 * (k + 1) * (i + 1));
+		const number time = 0.25 * k;
+		const int si = k % 4;
+
+		TData interp, compiled;
+		try{
+			evaluate_lua(interp, x, time, si);
+		}
+		catch(UGError&){
+			continue;
+		}
+		evaluate_batch(&compiled, &x, time, si, 1);
+
+		if(!m_luaComp.is_valid() || !(LuaCompiledDeviation(compiled, interp) < 1e-10)){
+			UG_LOG("WARNING (in " << name() << "): Compiled callback '"
+					<< m_callbackName << "' does not reproduce the lua results. "
+					"Using the lua interpreter.\n");
+			m_luaComp.invalidate();
+			return;
+		}
+	}
+	m_numCompEval = 0;
+}
+
+template <typename TData, int dim, typename TRet>
+bool LuaUserData<TData,dim,TRet>::
+check_compiled(const TData vValue[], const MathVector<dim> vGlobIP[],
+               number time, int si, const size_t nip) const
+{
+	for(size_t ip = 0; ip < nip; ++ip)
+	{
+		const size_t n = m_numCompEval++;
+		if(n >= 16 && (n & (n - 1)) != 0) continue;
+
+		TData interp;
+		try{
+			evaluate_lua(interp, vGlobIP[ip], time, si);
+		}
+		catch(UGError&){
+			continue;
+		}
+
+		if(!(LuaCompiledDeviation(vValue[ip], interp) < 1e-10)){
+			UG_LOG("WARNING (in " << name() << "): Compiled callback '"
+					<< m_callbackName << "' does not reproduce the lua results"
+					" at " << vGlobIP[ip] << ", time " << time << ", subset "
+					<< si << ". Using the lua interpreter.\n");
+			m_luaComp.invalidate();
+			return false;
+		}
+	}
+	return true;
+}
+#endif
+
 
 template <typename TData, int dim, typename TRet>
 bool LuaUserData<TData,dim,TRet>::
@@ -295,58 +404,101 @@ evaluate(TData& D, const MathVector<dim>& x, number time, int si) const
 		//TData D2;
 		TRet *t=NULL;
 		lua_traits<TData>::read(D, ret, t);
-		return lua_traits<TRet>::do_return(ret[0]);
+		if(check_compiled(&D, &x, time, si, 1))
+			return lua_traits<TRet>::do_return(ret[0]);
 	}
-	else
 	#endif
+	return evaluate_lua(D, x, time, si);
+}
+
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::
+evaluate_batch(TData vValue[], const MathVector<dim> vGlobIP[],
+               number time, int si, const size_t nip) const
+{
+    PROFILE_CALLBACK()
+    #ifdef USE_LUA2C
+	if(useLuaCompiler && m_luaComp.is_valid())
 	{
-	//	push the callback function on the stack
-		lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_callbackRef);
+		const size_t numIn = dim + 2;
+		const size_t numOut = lua_traits<TData>::size + lua_traits<TRet>::size;
+		m_vCompIn.resize(nip * numIn);
+		m_vCompOut.resize(nip * numOut);
+		if(nip == 0) return;
+
+	//	pack the arguments of all points
+		for(size_t ip = 0; ip < nip; ++ip){
+			double* d = &m_vCompIn[ip * numIn];
+			for(int i = 0; i < dim; ++i)
+				d[i] = vGlobIP[ip][i];
+			d[dim] = time;
+			d[dim+1] = si;
+		}
 
-	//  push space coordinates on stack
-		lua_traits<MathVector<dim> >::push(m_L, x);
+		m_luaComp.call(&m_vCompOut[0], &m_vCompIn[0], nip);
 
-	//	push time on stack
-		lua_traits<number>::push(m_L, time);
+		TRet *t = NULL;
+		for(size_t ip = 0; ip < nip; ++ip)
+			lua_traits<TData>::read(vValue[ip], &m_vCompOut[ip * numOut], t);
 
-	//	push subset index on stack
-		lua_traits<int>::push(m_L, si);
+		if(check_compiled(vValue, vGlobIP, time, si, nip)) return;
+	}
+	#endif
 
-	//	compute total args size
-		const int argSize = lua_traits<MathVector<dim> >::size
-							+ lua_traits<number>::size
-							+ lua_traits<int>::size;
+	for(size_t ip = 0; ip < nip; ++ip)
+		evaluate_lua(vValue[ip], vGlobIP[ip], time, si);
+}
 
-	//	compute total return size
-		const int retSize = lua_traits<TData>::size + lua_traits<TRet>::size;
+template <typename TData, int dim, typename TRet>
+TRet LuaUserData<TData,dim,TRet>::
+evaluate_lua(TData& D, const MathVector<dim>& x, number time, int si) const
+{
+//	push the callback function on the stack
+	lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_callbackRef);
 
-	//	call lua function
-		if(lua_pcall(m_L, argSize, retSize, 0) != 0)
-			UG_THROW(name() << "::operator(...): Error while "
-							"running callback '" << m_callbackName << "',"
-							" lua message: "<< lua_tostring(m_L, -1)<<".\n"
-							"Use signature as follows:\n"
-							<< signature());
+//  push space coordinates on stack
+	lua_traits<MathVector<dim> >::push(m_L, x);
 
-		bool res = false;
-		try{
-		//	read return value
-			lua_traits<TData>::read(m_L, D);
+//	push time on stack
+	lua_traits<number>::push(m_L, time);
 
-		//	read return flag (may be void)
-			lua_traits<TRet>::read(m_L, res, -retSize);
-		}
-		UG_CATCH_THROW(name() << "::operator(...): Error while running "
-						"callback '" << m_callbackName << "'.\n"
+//	push subset index on stack
+	lua_traits<int>::push(m_L, si);
+
+//	compute total args size
+	const int argSize = lua_traits<MathVector<dim> >::size
+						+ lua_traits<number>::size
+						+ lua_traits<int>::size;
+
+//	compute total return size
+	const int retSize = lua_traits<TData>::size + lua_traits<TRet>::size;
+
+//	call lua function
+	if(lua_pcall(m_L, argSize, retSize, 0) != 0)
+		UG_THROW(name() << "::operator(...): Error while "
+						"running callback '" << m_callbackName << "',"
+						" lua message: "<< lua_tostring(m_L, -1)<<".\n"
 						"Use signature as follows:\n"
 						<< signature());
 
-	//	pop values
-		lua_pop(m_L, retSize);
+	bool res = false;
+	try{
+	//	read return value
+		lua_traits<TData>::read(m_L, D);
 
-	//	forward flag
-		return lua_traits<TRet>::do_return(res);
+	//	read return flag (may be void)
+		lua_traits<TRet>::read(m_L, res, -retSize);
 	}
+	UG_CATCH_THROW(name() << "::operator(...): Error while running "
+					"callback '" << m_callbackName << "'.\n"
+					"Use signature as follows:\n"
+					<< signature());
+
+//	pop values
+	lua_pop(m_L, retSize);
+
+//	forward flag
+	return lua_traits<TRet>::do_return(res);
 }
 
 template <typename TData, int dim, typename TRet>
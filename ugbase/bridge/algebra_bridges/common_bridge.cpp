@@ -63,6 +63,9 @@
 #include "matrix_diagonal.h"
 
 #include "lib_algebra/operator/energy_convergence_check.h"
+#include "lib_algebra/cpu_algebra/algebra_threading.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_frozen.h"
+#include "lib_algebra/operator/preconditioner/ilu_benchmark.h"
 
 using namespace std;
 
@@ -197,6 +200,10 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<matrix_type>(name, grp)
 			.add_constructor()
 			.add_method("print|hide=true", &matrix_type::p)
+#ifdef UG_PARALLEL
+			.add_method("overlap_timing_string", &matrix_type::overlap_timing_string, "timing", "", "timing of the matrix-vector products with overlapped halo exchange (collective)")
+			.add_method("reset_overlap_timing", &matrix_type::reset_overlap_timing)
+#endif
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Matrix", tag);
 	}
@@ -315,7 +322,11 @@ static void Algebra(Registry& reg, string grp)
 		typedef ILinearIterator<vector_type>  TBase;
 		typedef DebugWritingObject<TAlgebra> TBase2;
 		string name = string("IPreconditioner").append(suffix);
-		reg.add_class_<T, TBase, TBase2>(name, grp);
+		reg.add_class_<T, TBase, TBase2>(name, grp)
+			.add_method("set_approximation", &T::set_approximation, "", "approxOp",
+					"sets a matrix operator used instead of the operator passed to init")
+			.add_method("set_keep_approximation", &T::set_keep_approximation, "", "bKeep",
+					"keep the approximation when initialized with another (e.g. matrix-free) operator, which is then only used for the defect (default false)");
 		reg.add_class_to_group(name, "IPreconditioner", tag);
 	}
 
@@ -502,6 +513,28 @@ static void Common(Registry& reg, string grp)
 			.add_method("compose_file_path", &T::leave_section)
 			.set_construct_as_smart_pointer(true);
 	}
+
+// Threading of the CPU algebra kernels
+	{
+		reg.add_function("SetAlgebraNumThreads", &SetAlgebraNumThreads, grp,
+				"", "numThreads", "sets the number of threads used by SpMV and vector operations");
+		reg.add_function("AlgebraNumThreads", &AlgebraNumThreads, grp,
+				"numThreads", "", "returns the number of threads used by SpMV and vector operations");
+		reg.add_function("AlgebraKernelBenchmark", &AlgebraKernelBenchmark, grp,
+				"", "n#numRepeat", "prints the bandwidth (GB/s) of the algebra kernels compared to a STREAM triad");
+	}
+
+// Snapshots of the sparse matrices for the solve phase
+	{
+		reg.add_function("SetSparseMatrixFreezeFormat", &SetSparseMatrixFreezeFormat, grp,
+				"", "format", "sets the format of the matrix snapshots built in the init of the linear solvers: 'none' (default), 'csr' or 'sell'");
+	}
+
+// Setup of the incomplete factorizations
+	{
+		reg.add_function("ILUSetupBenchmark", &ILUSetupBenchmark, grp,
+				"", "n#numSteps", "prints the setup time per Newton step of ILU and ILUT with and without reuse of the symbolic factorization");
+	}
 }
 
 }; // end Functionality
@@ -152,6 +152,25 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "Jacobi", tag);
 	}
 
+//	Chebyshev
+	{
+		typedef Chebyshev<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("Chebyshev").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Chebyshev accelerated Jacobi smoother")
+			.add_constructor()
+			.template add_constructor<void (*)(int)>("Degree")
+			.add_method("set_degree", &T::set_degree, "", "degree", "degree of the polynomial (number of applications of A)")
+			.add_method("set_eigenvalue_ratio", &T::set_eigenvalue_ratio, "", "ratio", "ratio lambda_max/lambda_min of the smoothed interval")
+			.add_method("set_safety_factor", &T::set_safety_factor, "", "factor", "factor the estimated largest eigenvalue is enlarged with")
+			.add_method("set_num_power_iterations", &T::set_num_power_iterations, "", "numIter", "number of power iterations for the eigenvalue estimate")
+			.add_method("set_max_eigenvalue", &T::set_max_eigenvalue, "", "lambdaMax", "sets the largest eigenvalue of D^{-1}A (0 = estimate)")
+			.add_method("set_eigenvalue_caching", &T::set_eigenvalue_caching, "", "bCache", "keep the estimate for reinitializations with the same matrix and sparsity pattern")
+			.add_method("max_eigenvalue", &T::max_eigenvalue, "lambdaMax")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Chebyshev", tag);
+	}
+
 //	GaussSeidelBase
 	{
 		typedef GaussSeidelBase<TAlgebra> T;
@@ -231,6 +250,8 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_sort", &T::set_sort, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in. default false")
 			.add_method("set_disable_preprocessing", &T::set_disable_preprocessing, "", "disable",
 						"set whether preprocessing (notably, LU factorization) is to be disabled - usable when the operator has not changed; use with care")
+			.add_method("set_reuse_pattern", &T::set_reuse_pattern, "", "bReuse",
+						"reuse the symbolic factorization while the matrix pattern is unchanged (default false)")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
 			.set_construct_as_smart_pointer(true);
@@ -252,6 +273,8 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_ordering_algorithm", &T::set_ordering_algorithm, "", "",
 						"sets an ordering algorithm")
 			.add_method("set_sort", &T::set_sort, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in. default true")
+			.add_method("set_reuse_pattern", &T::set_reuse_pattern, "", "bReuse",
+						"reuse ordering and L/U pattern while the matrix pattern is unchanged, fill-in outside is dropped (default false)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILUT", tag);
 	}
@@ -358,6 +381,117 @@ static void Algebra(Registry& reg, string grp)
 
 }; // end Functionality
 
+#ifdef UG_CPU_1
+/**
+ * Registers the float storage preconditioners and the MixedPrecision wrapper
+ * applying them inside the double precision CPU1 solvers.
+ */
+static void RegisterMixedPrecision(Registry& reg, string grp)
+{
+	typedef CPUFloatAlgebra TFloatAlgebra;
+	typedef TFloatAlgebra::vector_type float_vector_type;
+	string tag = GetAlgebraTag<CPUAlgebra>();
+
+//	ILinearIterator (float)
+	{
+		typedef ILinearIterator<float_vector_type> T;
+		string name = string("ILinearIteratorFloatCPU1");
+		reg.add_class_<T>(name, grp)
+			.add_method("set_damp", static_cast<void (T::*)(number)>(&T::set_damp), "", "damp", "set the damping to a number")
+			.add_method("config_string", &T::config_string, "strConfiguration", "", "string to display configuration of the linear iterator")
+			.add_method("name", &T::name);
+		reg.add_class_to_group(name, "ILinearIteratorFloat", tag);
+	}
+
+//	IPreconditioner (float)
+	{
+		typedef IPreconditioner<TFloatAlgebra> T;
+		typedef ILinearIterator<float_vector_type> TBase;
+		string name = string("IPreconditionerFloatCPU1");
+		reg.add_class_<T, TBase>(name, grp);
+		reg.add_class_to_group(name, "IPreconditionerFloat", tag);
+	}
+
+//	Jacobi (float)
+	{
+		typedef Jacobi<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("JacobiFloatCPU1");
+		reg.add_class_<T,TBase>(name, grp, "Jacobi Preconditioner in float storage")
+			.add_constructor()
+			.add_constructor<void (*)(number)>("DampingFactor")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "JacobiFloat", tag);
+	}
+
+//	GaussSeidel (float)
+	{
+		typedef GaussSeidel<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("GaussSeidelFloatCPU1");
+		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Preconditioner in float storage")
+			.add_constructor()
+			.add_method("set_sor_relax", &T::set_sor_relax, "", "sor relaxation", "sets sor relaxation parameter")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "GaussSeidelFloat", tag);
+	}
+
+//	Symmetric GaussSeidel (float)
+	{
+		typedef SymmetricGaussSeidel<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("SymmetricGaussSeidelFloatCPU1");
+		reg.add_class_<T,TBase>(name, grp, "Symmetric Gauss Seidel Preconditioner in float storage")
+			.add_constructor()
+			.add_method("set_sor_relax", &T::set_sor_relax, "", "sor relaxation", "sets sor relaxation parameter")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "SymmetricGaussSeidelFloat", tag);
+	}
+
+//	Backward GaussSeidel (float)
+	{
+		typedef BackwardGaussSeidel<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("BackwardGaussSeidelFloatCPU1");
+		reg.add_class_<T,TBase>(name, grp, "Backward Gauss Seidel Preconditioner in float storage")
+			.add_constructor()
+			.add_method("set_sor_relax", &T::set_sor_relax, "", "sor relaxation", "sets sor relaxation parameter")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "BackwardGaussSeidelFloat", tag);
+	}
+
+//	ILU (float)
+	{
+		typedef ILU<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("ILUFloatCPU1");
+		reg.add_class_<T,TBase>(name, grp, "Incomplete LU Decomposition in float storage")
+			.add_constructor()
+			.add_method("set_beta", &T::set_beta, "", "beta")
+			.add_method("set_sort_eps", &T::set_sort_eps, "", "eps")
+			.add_method("set_inversion_eps", &T::set_inversion_eps, "", "eps")
+			.add_method("set_sort", &T::set_sort, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in. default false")
+			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "ILUFloat", tag);
+	}
+
+//	MixedPrecision
+	{
+		typedef MixedPrecision<CPUAlgebra> T;
+		typedef IPreconditioner<CPUAlgebra> TBase;
+		string name = string("MixedPrecisionCPU1");
+		reg.add_class_<T,TBase>(name, grp, "Applies a float storage preconditioner in a double precision solver")
+			.add_constructor()
+			.add_constructor<void (*)(SmartPtr<IPreconditioner<TFloatAlgebra> >)>("floatPreconditioner")
+			.add_method("set_preconditioner", &T::set_preconditioner, "", "floatPreconditioner", "sets the preconditioner working in float storage")
+			.add_method("set_num_inner_steps", &T::set_num_inner_steps, "", "numSteps", "number of float preconditioner steps per application")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MixedPrecision", tag);
+	}
+}
+#endif
+
 // end group precond_bridge
 /// \}
 
@@ -371,6 +505,9 @@ void RegisterBridge_Preconditioner(Registry& reg, string grp)
 
 	try{
 		RegisterAlgebraDependent<Functionality>(reg,grp);
+#ifdef UG_CPU_1
+		Preconditioner::RegisterMixedPrecision(reg, grp);
+#endif
 	}
 	UG_REGISTRY_CATCH_THROW(grp);
 }
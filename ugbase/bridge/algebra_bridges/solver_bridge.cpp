@@ -47,8 +47,10 @@
 #include "lib_algebra/operator/linear_solver/auto_linear_solver.h"
 #include "lib_algebra/operator/linear_solver/analyzing_solver.h"
 #include "lib_algebra/operator/linear_solver/cg.h"
+#include "lib_algebra/operator/linear_solver/pipelined_cg.h"
 #include "lib_algebra/operator/linear_solver/bicgstab.h"
 #include "lib_algebra/operator/linear_solver/gmres.h"
+#include "lib_algebra/operator/linear_solver/sstep_gmres.h"
 #include "lib_algebra/operator/linear_solver/lu.h"
 #include "lib_algebra/operator/linear_solver/agglomerating_solver.h"
 #include "lib_algebra/operator/linear_solver/debug_iterator.h"
@@ -213,10 +215,24 @@ static void Algebra(Registry& reg, string grp)
 			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
 			.add_method("add_postprocess_corr", &T::add_postprocess_corr, "adds a postprocess of the corrections", "op")
 			.add_method("remove_postprocess_corr", &T::remove_postprocess_corr, "removes a postprocess of the corrections", "op")
+			.add_method("set_overlap_communication", &T::set_overlap_communication, "", "bOverlap", "if true, the halo exchange of the preconditioned defect is overlapped with the matrix-vector product. default false")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "CG", tag);
 	}
 
+// 	Pipelined CG Solver
+	{
+		typedef PipelinedCG<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("PipelinedCG").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Pipelined Conjugate Gradient Solver (one non-blocking reduction per step)")
+			.add_constructor()
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> > ) )("precond")
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "PipelinedCG", tag);
+	}
+
 // 	BiCGStab Solver
 	{
 		typedef BiCGStab<vector_type> T;
@@ -247,6 +263,19 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "GMRES", tag);
 	}
 
+// 	s-step GMRES Solver
+	{
+		typedef SStepGMRES<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("SStepGMRES").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "s-step (communication avoiding) GMRES Solver")
+			.ADD_CONSTRUCTOR( (size_t restart, size_t s) )("restart#s")
+			.add_method("add_postprocess_corr", &T::add_postprocess_corr, "adds a postprocess of the corrections", "op")
+			.add_method("remove_postprocess_corr", &T::remove_postprocess_corr, "removes a postprocess of the corrections", "op")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "SStepGMRES", tag);
+	}
+
 // 	LU Solver
 	{
 		typedef LU<TAlgebra> T;
@@ -255,7 +284,10 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "LU-Decomposition exact solver")
 			.add_constructor()
 			.add_method("set_minimum_for_sparse", &T::set_minimum_for_sparse, "", "N")
-			.add_method("set_sort_sparse", &T::set_sort_sparse, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in in sparse LU. default true")
+			.add_method("set_sort_sparse", &T::set_sort_sparse, "", "bSort", "if bSort=true, use a fill-reducing ordering in sparse LU. default true")
+			.add_method("set_ordering_algorithm", &T::set_ordering_algorithm, "", "ordering", "fill-reducing ordering of the supernodal sparse LU. default nested dissection")
+			.add_method("set_supernodal", &T::set_supernodal, "", "bSupernodal", "if true, sparse LU is a supernodal factorization, otherwise ILUT(0). default false")
+			.add_method("set_pivot_tolerance", &T::set_pivot_tolerance, "", "tol", "relative pivot tolerance of the supernodal LU, ILUT(0) is used on smaller pivots. default 1e-8")
 			.add_method("set_info", &T::set_info, "", "bInfo", "if true, sparse LU prints some fill-in info")
 			.add_method("set_show_progress", &T::set_show_progress, "", "onoff", "switches the progress indicator on/off")
 			.set_construct_as_smart_pointer(true);
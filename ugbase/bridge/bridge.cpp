@@ -122,6 +122,8 @@ void InitUG(int dim, const AlgebraType& algType, bool verbose)
 				if(blocksize != 1)
 					UG_THROW("ERROR in InitUG: Requested Algebra GPU, Blocksize '" << blocksize << "x" << blocksize << "' is not compiled into binary.");
 			}
+			else if(algType.type() == AlgebraType::CPU_FLOAT)
+				UG_THROW("ERROR in InitUG: Algebra CPUFloat is only available for preconditioners, not for discretizations.");
 	#endif
 
 //	get dim tag
@@ -57,6 +57,7 @@
 #include "lib_disc/time_disc/time_integrator_observers/lua_callback_observer.hpp"
 #include "lib_disc/time_disc/time_integrator_subject.hpp"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/matrix_free_linear_operator.h"
 #include "lib_disc/operator/non_linear_operator/assembled_non_linear_operator.h"
 #include "lib_disc/operator/non_linear_operator/line_search.h"
 #include "lib_disc/operator/linear_operator/nested_iteration/nested_iteration.h"
@@ -183,7 +184,14 @@ static void Algebra(Registry& reg, string parentGroup)
 				"calculate error indicators for elements from error estimators of the elemDiscs")
 			.add_method("invalidate_error", &T::invalidate_error, "", "Marks error indicators as invalid, "
 				"which will prohibit refining and coarsening before a new call to calc_error.")
-			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error indicators are valid");
+			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error indicators are valid")
+			.add_method("set_linear_operator_cache", &T::set_linear_operator_cache, "", "bCache",
+				"caches system matrix and rhs (linear problems only)")
+			.add_method("linear_operator_cache", &T::linear_operator_cache, "cache enabled")
+			.add_method("set_time_dependent_operator", &T::set_time_dependent_operator, "", "bTimeDependent",
+				"reassembles the cached system matrix in every time step")
+			.add_method("invalidate_linear_operator_cache", &T::invalidate_linear_operator_cache, "", "",
+				"discards the cached system matrices and rhs");
 		reg.add_class_to_group(name, "MultiStepTimeDiscretization", tag);
 	}
 
@@ -265,6 +273,26 @@ static void Algebra(Registry& reg, string parentGroup)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "AssembledLinearOperator", tag);
 	}
+
+//	MatrixFreeLinearOperator
+	{
+		std::string grp = parentGroup; grp.append("/Discretization");
+		typedef MatrixFreeLinearOperator<TAlgebra> T;
+		typedef ILinearOperator<vector_type> TBase;
+		string name = string("MatrixFreeLinearOperator").append(suffix);
+		reg.add_class_<T, TBase>(name, grp)
+			.add_constructor()
+			.template add_constructor<void (*)(SmartPtr<IAssemble<TAlgebra> >)>("Assembling Routine")
+			.template add_constructor<void (*)(SmartPtr<IAssemble<TAlgebra> >, const GridLevel&)>("AssemblingRoutine#GridLevel")
+			.add_method("set_discretization", &T::set_discretization)
+			.add_method("set_level", &T::set_level)
+			.add_method("set_dirichlet_values", &T::set_dirichlet_values)
+			.add_method("init", static_cast<void (T::*)(const vector_type&)>(&T::init), "", "u")
+			.add_method("diagonal", &T::diagonal, "Diagonal operator")
+			.add_method("level", &T::level)
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MatrixFreeLinearOperator", tag);
+	}
 	
 
 //	NewtonSolver
@@ -284,6 +312,11 @@ static void Algebra(Registry& reg, string parentGroup)
 			.add_method("disable_line_search", &T::disable_line_search)
 			.add_method("line_search", &T::line_search, "lineSeach", "")
 			.add_method("set_reassemble_J_freq", &T::set_reassemble_J_freq, "reassemble freq. for Jacobian")
+			.add_method("set_jacobian_reuse_rate", &T::set_jacobian_reuse_rate, "", "maxRate", "reuses Jacobian and preconditioner while the Newton rate is below maxRate (0 = disabled)")
+			.add_method("set_jacobian_max_age", &T::set_jacobian_max_age, "", "maxAge", "maximal number of Newton steps with the same Jacobian (0 = unlimited)")
+			.add_method("set_jacobian_reuse_across_calls", &T::set_jacobian_reuse_across_calls, "", "bReuse", "keeps a reused Jacobian between calls of apply")
+			.add_method("set_jacobian_free", &T::set_jacobian_free, "", "bJacobianFree", "applies the Jacobian by finite differences of the defect (JFNK)")
+			.add_method("set_jacobian_free_eps", &T::set_jacobian_free_eps, "", "eps", "relative step size of the finite differences")
 			.add_method("init", &T::init, "success", "op")
 			.add_method("prepare", &T::prepare, "success", "u")
 			.add_method("apply", &T::apply, "success", "u")
@@ -297,6 +330,7 @@ static void Algebra(Registry& reg, string parentGroup)
 			.add_method("total_linsolver_steps", &T::total_linsolver_steps, "total number of linsolver steps", "")
 			.add_method("total_average_linear_steps", &T::total_average_linear_steps, "total average number of linsolver steps per linsolver call", "")
 			.add_method("last_num_newton_steps", &T::last_num_newton_steps, "Number of newton steps performed in last iteration")
+			.add_method("num_jacobian_assemblies", &T::num_jacobian_assemblies, "number of Jacobian assemblies in history")
 			.add_method("add_inner_step_update", &T::add_inner_step_update, "data update called before every linsolver step", "")
 			.add_method("clear_inner_step_update", &T::clear_inner_step_update, "clear inner step update", "")
 			.add_method("add_step_update", &T::add_step_update, "data update called before every Newton step", "")
@@ -250,6 +250,12 @@ static void Algebra(Registry& reg, string grp)
 				"whether matrix is constant in time", "")
 			.add_method("set_matrix_structure_is_const", &T::set_matrix_structure_is_const, "",
 				"whether matrix has constant in time structure", "")
+			.add_method("set_matrix_structure_caching", &T::set_matrix_structure_caching, "",
+				"bCache", "whether the matrix structure is reused while the DoFDistribution does not change (default false)")
+			.add_method("set_num_threads", &T::set_num_threads, "",
+				"numThreads", "number of threads used in the element loops (requires OpenMP)")
+			.add_method("set_deterministic_assembling", &T::set_deterministic_assembling, "",
+				"bDeterministic", "whether threaded assembling reproduces the serial results bitwise")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name+suffix, name, tag);
 	}
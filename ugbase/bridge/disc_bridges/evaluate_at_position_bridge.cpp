@@ -54,6 +54,7 @@
 #include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
 #include "common/util/provider.h"
 #include "lib_disc/domain_util.h"
+#include "lib_disc/domain_point_locator.h"
 #include "lib_disc/time_disc/time_integrator_observers/time_integrator_observer_interface.h"
 
 // pcl includes
@@ -80,7 +81,7 @@ class NumberValuedUserDataEvaluator
 	typedef GridFunction<TDomain, TAlgebra> TGridFunction;
 	typedef typename TGridFunction::template dim_traits<dim>::grid_base_object TElem;	
 
-	typedef lg_ntree<dim, dim, TElem>	tree_t;
+	typedef DomainPointLocator<TDomain> locator_t;
 
 	public:
 
@@ -135,9 +136,46 @@ class NumberValuedUserDataEvaluator
 		#endif
 		}
 
+		// evaluates at many points at once, returns the number of points found
+		size_t evaluate(const std::vector<std::vector<number> >& vPos,
+									std::vector<number>& vResult,
+									std::vector<bool>& vFound,
+									SmartPtr<TGridFunction> u,
+									number time)
+		{
+			if(!m_initialized) 
+				initialize(u);
+
+			std::vector<MathVector<dim> > vGlobalPosition(vPos.size());
+			for(size_t p = 0; p < vPos.size(); p++)
+				for(int i = 0; i < dim; i++)
+					vGlobalPosition[p][i] = vPos[p][i];
+
+			// points not found on this process are evaluated where they are located
+			ElementEvaluator eval(this, u, time);
+			return m_locator->evaluate_global(vResult, vFound, vGlobalPosition, 1, eval);
+		}
+
 
 	private:
 
+		// evaluator passed to the point locator
+		struct ElementEvaluator
+		{
+			ElementEvaluator(NumberValuedUserDataEvaluator* evaluator, SmartPtr<TGridFunction> u, number time)
+				: m_evaluator(evaluator), m_u(u), m_time(time) {}
+
+			bool operator()(number* value, TElem* elem, const MathVector<dim>& locPos, const MathVector<dim>& globalPosition)
+			{
+				m_evaluator->evaluateInElement(*value, elem, locPos, globalPosition, m_u, m_time);
+				return true;
+			}
+
+			NumberValuedUserDataEvaluator* m_evaluator;
+			SmartPtr<TGridFunction> m_u;
+			number m_time;
+		};
+
 		bool evaluateOnThisProcess(const std::vector<number>& pos,
 									number& result,
 									SmartPtr<TGridFunction> u,
@@ -152,12 +190,25 @@ class NumberValuedUserDataEvaluator
 				globalPosition[i] = pos[i];
 			}
 
-			if(!FindContainingElement(elem, *m_tree, globalPosition))
+			MathVector<dim> locPos;
+			if(!m_locator->locate(elem, locPos, globalPosition))
 			{
 				result = 0;
 				return false;
 			}
 
+			evaluateInElement(result, elem, locPos, globalPosition, u, time);
+
+			return true;
+		}
+
+		void evaluateInElement(number& result,
+									TElem* elem,
+									const MathVector<dim>& locPos,
+									const MathVector<dim>& globalPosition,
+									SmartPtr<TGridFunction> u,
+									number time)
+		{
 			//	get corners of element
 			std::vector<MathVector<dim> > vCornerCoords;
 			CollectCornerCoordinates(vCornerCoords, *elem, *u->domain());
@@ -165,16 +216,6 @@ class NumberValuedUserDataEvaluator
 			//	get subset
 			int si = u->domain()->subset_handler()->get_subset_index(elem);
 
-			//	reference object id
-			const ReferenceObjectID roid = elem->reference_object_id();
-
-			//	get local position of DoF
-			DimReferenceMapping<dim, dim>& map
-				= ReferenceMappingProvider::get<dim, dim>(roid, vCornerCoords);
-			MathVector<dim> locPos;
-			VecSet(locPos, 0.5);
-			map.global_to_local(locPos, globalPosition);
-
 			// storage for the result
 			number value;
 
@@ -211,21 +252,19 @@ class NumberValuedUserDataEvaluator
 				UG_CATCH_THROW("NumberValuedUserDataEvaluator: Cannot evaluate data.");
 			}
 
-			result = value;			
-
-			return true;
+			result = value;
 		}
 
 		void initialize(SmartPtr<TGridFunction> u)
 		{
 			m_initialized = true;
 
-			m_tree = make_sp(new tree_t(*u->domain()->grid(), u->domain()->position_attachment()));
-			m_tree->create_tree(u->template begin<TElem>(), u->template end<TElem>());
+			m_locator = make_sp(new locator_t(u->domain()));
+			m_locator->create(u->template begin<TElem>(), u->template end<TElem>());
 		}
 
 		bool m_initialized = false;
-		SmartPtr<tree_t> m_tree;
+		SmartPtr<locator_t> m_locator;
 		SmartPtr<UserData<number, dim> > m_userData;
 
 };
@@ -237,7 +276,7 @@ class VectorValuedUserDataEvaluator
 	typedef GridFunction<TDomain, TAlgebra> TGridFunction;
 	typedef typename TGridFunction::template dim_traits<dim>::grid_base_object TElem;	
 
-	typedef lg_ntree<dim, dim, TElem>	tree_t;
+	typedef DomainPointLocator<TDomain> locator_t;
 
 	public:
 
@@ -305,9 +344,49 @@ class VectorValuedUserDataEvaluator
 		#endif
 		}
 
+		// evaluates at many points at once, returns the number of points found
+		size_t evaluate(const std::vector<std::vector<number> >& vPos,
+									std::vector<number>& vResult,
+									std::vector<bool>& vFound,
+									SmartPtr<TGridFunction> u,
+									number time)
+		{
+			if(!m_initialized) 
+				initialize(u);
+
+			std::vector<MathVector<dim> > vGlobalPosition(vPos.size());
+			for(size_t p = 0; p < vPos.size(); p++)
+				for(int i = 0; i < dim; i++)
+					vGlobalPosition[p][i] = vPos[p][i];
+
+			// points not found on this process are evaluated where they are located
+			ElementEvaluator eval(this, u, time);
+			return m_locator->evaluate_global(vResult, vFound, vGlobalPosition, dim, eval);
+		}
+
 
 	private:
 
+		// evaluator passed to the point locator
+		struct ElementEvaluator
+		{
+			ElementEvaluator(VectorValuedUserDataEvaluator* evaluator, SmartPtr<TGridFunction> u, number time)
+				: m_evaluator(evaluator), m_u(u), m_time(time) {}
+
+			bool operator()(number* value, TElem* elem, const MathVector<dim>& locPos, const MathVector<dim>& globalPosition)
+			{
+				MathVector<dim> result;
+				m_evaluator->evaluateInElement(result, elem, locPos, globalPosition, m_u, m_time);
+				for(int i = 0; i < dim; i++)
+					value[i] = result[i];
+				return true;
+			}
+
+			VectorValuedUserDataEvaluator* m_evaluator;
+			SmartPtr<TGridFunction> m_u;
+			number m_time;
+		};
+
 		bool evaluateOnThisProcessNeighbouring(const std::vector<number>& pos,
 									std::vector<number>& result,
 									SmartPtr<TGridFunction> u,
@@ -327,7 +406,8 @@ class VectorValuedUserDataEvaluator
 				globalPosition[i] = pos[i];
 			}
 
-			if(!FindContainingElement(elem, *m_tree, globalPosition))
+			MathVector<dim> locPos;
+			if(!m_locator->locate(elem, locPos, globalPosition))
 			{
 				return false;
 			}
@@ -461,11 +541,30 @@ class VectorValuedUserDataEvaluator
 				globalPosition[i] = pos[i];
 			}
 
-			if(!FindContainingElement(elem, *m_tree, globalPosition))
+			MathVector<dim> locPos;
+			if(!m_locator->locate(elem, locPos, globalPosition))
 			{
 				return false;
 			}
 
+			MathVector<dim> value;
+			evaluateInElement(value, elem, locPos, globalPosition, u, time);
+
+			for(int i = 0; i < dim; i++)
+			{
+				result[i] = value[i];
+			}
+
+			return true;
+		}
+
+		void evaluateInElement(MathVector<dim>& value,
+									TElem* elem,
+									const MathVector<dim>& locPos,
+									const MathVector<dim>& globalPosition,
+									SmartPtr<TGridFunction> u,
+									number time)
+		{
 			//	get corners of element
 			std::vector<MathVector<dim> > vCornerCoords;
 			CollectCornerCoordinates(vCornerCoords, *elem, *u->domain());
@@ -473,19 +572,6 @@ class VectorValuedUserDataEvaluator
 			//	get subset
 			int si = u->domain()->subset_handler()->get_subset_index(elem);
 
-			//	reference object id
-			const ReferenceObjectID roid = elem->reference_object_id();
-
-			//	get local position of DoF
-			DimReferenceMapping<dim, dim>& map
-				= ReferenceMappingProvider::get<dim, dim>(roid, vCornerCoords);
-			MathVector<dim> locPos;
-			VecSet(locPos, 0.5);
-			map.global_to_local(locPos, globalPosition);
-
-			// storage for the result
-			MathVector<dim> value;
-
 			//	get local solution if needed
 			if(m_userData->requires_grid_fct())
 			{
@@ -518,25 +604,18 @@ class VectorValuedUserDataEvaluator
 				}
 				UG_CATCH_THROW("VectorValuedUserDataEvaluator: Cannot evaluate data.");
 			}
-
-			for(int i = 0; i < dim; i++)
-			{
-				result[i] = value[i];
-			}
-
-			return true;
 		}
 
 		void initialize(SmartPtr<TGridFunction> u)
 		{
 			m_initialized = true;
 
-			m_tree = make_sp(new tree_t(*u->domain()->grid(), u->domain()->position_attachment()));
-			m_tree->create_tree(u->template begin<TElem>(), u->template end<TElem>());
+			m_locator = make_sp(new locator_t(u->domain()));
+			m_locator->create(u->template begin<TElem>(), u->template end<TElem>());
 		}
 
 		bool m_initialized = false;
-		SmartPtr<tree_t> m_tree;
+		SmartPtr<locator_t> m_locator;
 		SmartPtr<UserData<MathVector<dim>, dim> > m_userData;
 
 };
@@ -665,6 +744,28 @@ class VectorValuedUserDataPointEvaluator : public PointEvaluatorBase<TDomain, TA
 		{
 			UG_LOG(" * Write Vector-valued Position Data to '" << this->m_filename << "' ... \n");
 			output << time << this->m_separator;
+
+			if(!m_interpolateOverNeighbouringTriangles)
+			{
+				// locate and evaluate all points at once
+				std::vector<number> vResult;
+				std::vector<bool> vFound;
+				m_evaluator.evaluate(this->m_evaluationPoints, vResult, vFound, uNew, time);
+
+				for(size_t p = 0; p < vFound.size(); p++)
+				{
+					for(int d = 0; d < dim; d++)
+					{
+						if(vFound[p])
+							output << vResult[p*dim + d] << this->m_separator;
+						else
+							output << "NaN" << this->m_separator;
+					}
+				}
+				output << "\n";
+				return;
+			}
+
 			std::vector<number> result;
 			for (auto point : this->m_evaluationPoints)
 			{
@@ -729,12 +830,17 @@ class NumberValuedUserDataPointEvaluator : public PointEvaluatorBase<TDomain, TA
 		{
 			UG_LOG(" * Write Number-valued Position Data to '" << this->m_filename << "' ... \n");
 			output << time << this->m_separator;
-			number result;
-			for (auto point : this->m_evaluationPoints)
+
+			// locate and evaluate all points at once
+			std::vector<number> vResult;
+			std::vector<bool> vFound;
+			m_evaluator.evaluate(this->m_evaluationPoints, vResult, vFound, uNew, time);
+
+			for(size_t p = 0; p < vFound.size(); p++)
 			{
-				if(m_evaluator.evaluate(point, result, uNew, time))
+				if(vFound[p])
 				{					
-					output << result << this->m_separator;					
+					output << vResult[p] << this->m_separator;					
 				}
 				else
 				{					
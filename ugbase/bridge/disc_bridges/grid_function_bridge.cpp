@@ -199,6 +199,8 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.template add_constructor<void (*)(SmartPtr<TFct>, const char*)>("GridFunction#Component")
 			.add_method("evaluate", static_cast<number (T::*)(const MathVector<dim>&) const>(&T::evaluate))
 			.add_method("evaluate_global", static_cast<number (T::*)(std::vector<number>)>(&T::evaluate_global))
+			.add_method("evaluate_global_batch", &T::evaluate_global_batch, "values", "coordinates of all points in a row")
+			.add_method("set_num_threads", &T::set_num_threads, "", "numThreads")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "GlobalGridFunctionNumberData", tag);
 	}
@@ -213,6 +215,8 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.template add_constructor<void (*)(SmartPtr<TFct>, const char*)>("GridFunction#Component")
 			.add_method("evaluate", static_cast<number (T::*)(const MathVector<dim>&) const>(&T::evaluate))
 			.add_method("evaluate_global", static_cast<number (T::*)(std::vector<number>)>(&T::evaluate_global))
+			.add_method("evaluate_global_batch", &T::evaluate_global_batch, "values", "coordinates of all points in a row")
+			.add_method("set_num_threads", &T::set_num_threads, "", "numThreads")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "GlobalEdgeGridFunctionNumberData", tag);
 	}
@@ -602,6 +606,8 @@ static void Common(Registry& reg, string grp)
 		.add_method("init_levels", &T::init_levels)
 		.add_method("init_surfaces", &T::init_surfaces)
 		.add_method("init_top_surface", &T::init_top_surface)
+		.add_method("enable_topology_snapshots", &T::enable_topology_snapshots, "", "bEnable",
+					"uses frozen CSR topology arrays to look up sub-elements of the dof distributions")
 
 		.add_method("clear", &T::clear)
 		.add_method("add_fct", static_cast<void (T::*)(const char*, const char*, int, const char*)>(&T::add),
@@ -286,6 +286,8 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("select_element", static_cast<void (T::*)(SmartPtr<UserData<MathVector<dim>, dim> >, const char*)>(&T::select_element))
 			.add_method("select_element", static_cast<void (T::*)(SmartPtr<UserData<MathMatrix<dim,dim>, dim> >, const char*)>(&T::select_element))
 			.add_method("set_binary", &T::set_binary, "", "bBinary", "should values be printed in binary (base64 encoded way ) or plain ascii")
+			.add_method("set_appended", &T::set_appended, "", "bAppended", "should binary values be written raw into an appended data section")
+			.add_method("set_compressed", &T::set_compressed, "", "bCompressed", "should appended binary values be zlib compressed (requires USE_ZLIB)")
 			.add_method("set_user_defined_comment", static_cast<void (T::*)(const char*)>(&T::set_user_defined_comment))
 			.add_method("set_write_grid", static_cast<void (T::*)(bool)>(&T::set_write_grid))
 			.add_method("set_write_subset_indices", static_cast<void (T::*)(bool)>(&T::set_write_subset_indices))
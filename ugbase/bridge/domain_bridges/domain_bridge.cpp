@@ -53,6 +53,7 @@
 #include "lib_grid/algorithms/grid_statistics.h"
 
 #include "lib_grid/algorithms/subset_util.h"
+#include "lib_grid/algorithms/sfc_ordering.h"
 
 #ifdef UG_PARALLEL
 	#include "lib_disc/parallelization/domain_load_balancer.h"
@@ -81,6 +82,21 @@ static void MinimizeMemoryFootprint(TDomain& dom)
 							 | GRIDOPT_AUTOGENERATE_SIDES);
 }
 
+///	sorts the elements of the domain along a Hilbert curve (see SortGridElementsBySFC)
+template <typename TDomain>
+static void SortDomainElementsBySFC(TDomain& dom)
+{
+	PROFILE_FUNC_GROUP("grid");
+	SortGridElementsBySFC(*dom.grid(), dom.position_attachment(),
+						  dom.subset_handler().get());
+}
+
+///	returns the objects and slabs per size class of the grid object allocator
+static std::string GridObjectAllocatorStatistics()
+{
+	return SlabAllocator<GridObject>::inst().statistics();
+}
+
 template <typename TDomain>
 static void LoadAndRefineDomain(TDomain& domain, const char* filename,
 								int numRefs)
@@ -515,6 +531,8 @@ static void Domain(Registry& reg, string grp)
 	reg.add_function("TestDomainInterfaces", static_cast<bool (*)(TDomain*, bool)>(&TestDomainInterfaces<TDomain>), grp);
 
 	reg.add_function("MinimizeMemoryFootprint", &MinimizeMemoryFootprint<TDomain>, grp);
+	reg.add_function("SortDomainElementsBySFC", &SortDomainElementsBySFC<TDomain>, grp,
+					 "", "dom", "sorts the elements and their attached data along a Hilbert curve");
 }
 
 /**
@@ -527,6 +545,9 @@ static void Domain(Registry& reg, string grp)
  */
 static void Common(Registry& reg, string grp)
 {
+	reg.add_function("GridObjectAllocatorStatistics", &GridObjectAllocatorStatistics,
+					 grp, "statistics", "", "objects and slabs per object size of the grid object allocator");
+
 //	DomainInfo
 	{
 		reg.add_class_<DomainInfo>("DomainInfo", grp)
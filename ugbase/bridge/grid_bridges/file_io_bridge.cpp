@@ -35,6 +35,7 @@
 #include "lib_grid/multi_grid.h"
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/file_io/file_io_ugx.h"
+#include "lib_grid/file_io/file_io_ugxb.h"
 #include "lib_grid/file_io/file_io_vtu.h"
 
 using namespace std;
@@ -138,7 +139,14 @@ void RegisterGridBridge_FileIO(Registry& reg, string parentGroup)
 				grp, "", "mg#filename#offset")
 		.add_function("SaveSurfaceViewTransformed", &SaveSurfaceViewTransformed)
 		.add_function("SaveGridLevelToFile", &SaveGridLevelToFile)
-		.add_function("SetVTURegionOfInterestIdentifier", static_cast<void (*)(char const *)>(&SetVTURegionOfInterestIdentifier) );
+		.add_function("SetVTURegionOfInterestIdentifier", static_cast<void (*)(char const *)>(&SetVTURegionOfInterestIdentifier) )
+		.add_function("LoadGridPartFromUGXB", &LoadGridPartFromUGXB, grp,
+				"", "grid#sh#filename#part#numParts",
+				"Loads a part of a ugxb grid. No parallel interfaces are created.")
+		.add_function("ConvertUGXToUGXB", &ConvertUGXToUGXB, grp,
+				"", "srcFilename#destFilename")
+		.add_function("ConvertUGXBToUGX", &ConvertUGXBToUGX, grp,
+				"", "srcFilename#destFilename");
 }
 
 }//	end of namespace
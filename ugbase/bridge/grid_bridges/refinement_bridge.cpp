@@ -264,6 +264,9 @@ void RegisterGridBridge_Refinement(Registry& reg, string parentGroup)
 		.add_constructor()
 		.add_method("assign_grid", static_cast<void (GlobalMultiGridRefiner::*)(MultiGrid&)>(&GlobalMultiGridRefiner::assign_grid),
 				"", "mg")
+		.add_method("set_num_threads", &GlobalMultiGridRefiner::set_num_threads, "", "numThreads",
+				"number of threads used to build child elements (requires OpenMP)")
+		.add_method("num_threads", &GlobalMultiGridRefiner::num_threads)
 		.set_construct_as_smart_pointer(true);
 
 	{
@@ -34,6 +34,7 @@
 #include "ug.h"
 #include "bridge/bridge.h"
 #include "common/stopwatch.h"
+#include "common/util/async_file_writer.h"
 #include "common/util/file_util.h"
 #include "common/util/path_provider.h"
 #include "common/util/table.h"
@@ -113,6 +114,25 @@ std::vector<std::string> GetDirsInDir(const char* dir)
 	return dirs;
 }
 
+/**
+ * Enables asynchronous file output (VTKOutput, ugx grid files and
+ * ConnectionViewer vectors). The files are assembled in memory and written
+ * by a background thread.
+ *
+ * \param[in]	enable		enables or disables asynchronous output
+ * \param[in]	maxPending	maximal number of files kept in memory at once
+ */
+static void EnableAsyncOutput(bool enable, size_t maxPending)
+{
+	AsyncFileWriter::inst().set_max_pending(maxPending);
+	AsyncFileWriter::inst().enable(enable);
+}
+
+static void FlushAsyncOutput()
+{
+	AsyncFileWriter::inst().flush();
+}
+
 void RegisterBridge_Util(Registry& reg, string parentGroup)
 {
 	string grp(parentGroup);
@@ -170,6 +190,11 @@ void RegisterBridge_Util(Registry& reg, string parentGroup)
 
 	reg.add_function("FindFileInStandardPaths", FindFileInStandardPaths);
 
+	reg.add_function("EnableAsyncOutput", &EnableAsyncOutput, grp,
+	                 "", "enable#maxPending", "Writes output files in a background thread, with at most maxPending files in memory (requires -DASYNC_IO=ON)");
+	reg.add_function("FlushAsyncOutput", &FlushAsyncOutput, grp,
+	                 "", "", "Blocks until all asynchronously written files are complete");
+
 	{
 		typedef Variant T;
 		reg.add_class_<T>("Variant", grp)
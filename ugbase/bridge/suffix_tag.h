@@ -94,6 +94,7 @@ inline std::string GetAlgebraSuffix(const TAlgebraTypeType& algType)
 //	add type
 	if(algType.type() == TAlgebraTypeType::CPU) ss << "CPU";
 	else if(algType.type() == TAlgebraTypeType::GPU) ss << "GPU";
+	else if(algType.type() == TAlgebraTypeType::CPU_FLOAT) ss << "CPUFloat";
 	else UG_THROW("Unknown algebra type.");
 
 //	add blocktype
@@ -120,6 +121,7 @@ inline std::string GetAlgebraTag(const TAlgebraTypeType& algType)
 //	add type
 	if(algType.type() == TAlgebraTypeType::CPU) ss << "CPU";
 	else if(algType.type() == TAlgebraTypeType::GPU) ss << "GPU";
+	else if(algType.type() == TAlgebraTypeType::CPU_FLOAT) ss << "CPUFloat";
 	else UG_THROW("Unknown algebra type.");
 
 //	add blocktype
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__ALIGNED_ALLOCATOR__
+#define __H__UG__ALIGNED_ALLOCATOR__
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+	#include <malloc.h>
+#endif
+
+namespace ug{
+
+///	A std-conforming allocator which aligns all allocations to 'alignment' bytes.
+/**	Use it with std containers whose value type is over-aligned (e.g. declared
+ * with alignas(64) to occupy full cache lines). Before C++17 the default
+ * std::allocator does not honor alignments larger than the alignment of
+ * max_align_t.
+ *
+ * 'alignment' has to be a power of two and a multiple of sizeof(void*).
+ */
+template <class T, std::size_t alignment = 64>
+class AlignedAllocator
+{
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <class U>
+		struct rebind	{typedef AlignedAllocator<U, alignment> other;};
+
+		AlignedAllocator()	{}
+
+		template <class U>
+		AlignedAllocator(const AlignedAllocator<U, alignment>&)	{}
+
+		pointer allocate(size_type n, const void* = 0)
+		{
+			if(n == 0)
+				return NULL;
+			void* p = NULL;
+		#ifdef _WIN32
+			p = _aligned_malloc(n * sizeof(T), alignment);
+		#else
+			if(posix_memalign(&p, alignment, n * sizeof(T)) != 0)
+				p = NULL;
+		#endif
+			if(!p)
+				throw std::bad_alloc();
+			return static_cast<pointer>(p);
+		}
+
+		void deallocate(pointer p, size_type)
+		{
+		#ifdef _WIN32
+			_aligned_free(p);
+		#else
+			free(p);
+		#endif
+		}
+
+		size_type max_size() const	{return size_type(-1) / sizeof(T);}
+
+		template <class U>
+		bool operator==(const AlignedAllocator<U, alignment>&) const	{return true;}
+
+		template <class U>
+		bool operator!=(const AlignedAllocator<U, alignment>&) const	{return false;}
+};
+
+}//	end of namespace
+
+#endif
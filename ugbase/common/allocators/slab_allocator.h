@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__SLAB_ALLOCATOR__
+#define __H__UG__SLAB_ALLOCATOR__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#ifdef UG_OPENMP
+#include <omp.h>
+#endif
+
+namespace ug{
+
+///	Allocates objects of equal size consecutively in large slabs.
+/**	The allocator keeps one size class per object size (rounded to
+ * SLAB_ALIGNMENT bytes). A new slab hands out its blocks in ascending address
+ * order, so objects of one size which are created one after another lie next
+ * to each other in memory. Freed blocks are kept in a free list of their slab
+ * and are reused by the next allocations of this size. A slab whose blocks
+ * are all freed is returned to the system, except for one empty slab per size
+ * class, which is kept to avoid reallocations if objects are created and
+ * destroyed alternately.
+ *
+ * The slabs are slabSize bytes large and aligned to slabSize bytes, so that
+ * the slab of a block is found from its address. slabSize has to be a power
+ * of two.
+ *
+ * Objects larger than maxObjSize are allocated through the global operator new.
+ *
+ * TTag is only used to create separate singletons for separate object
+ * hierarchies (e.g. GridObject).
+ *
+ * The allocator is safe to be used from inside OpenMP parallel regions. Each
+ * size class has a lock of its own, so threads only wait for each other if
+ * they allocate or free objects of the same size at the same time.
+ */
+template <class TTag, std::size_t maxObjSize = 512, std::size_t slabSize = 65536>
+class SlabAllocator
+{
+	public:
+	///	returns the instance of this singleton
+	/**	The instance is never destroyed, since objects may still be released
+	 *	by destructors of other static objects at program exit.*/
+		static SlabAllocator& inst();
+
+	///	allocates a block of numBytes bytes
+		void* allocate(std::size_t numBytes);
+
+	///	make sure that numBytes exactly matches the size passed to allocate
+		void deallocate(void* p, std::size_t numBytes);
+
+	///	returns the number of currently allocated objects (of all sizes)
+		std::size_t num_objects() const;
+
+	///	returns the number of slabs
+		std::size_t num_slabs() const;
+
+	///	returns the memory held by the slabs in bytes
+		std::size_t occupied_memory() const;
+
+	///	returns a table with the objects and slabs per size class
+		std::string statistics() const;
+
+	private:
+		SlabAllocator();
+
+	///	header at the beginning of each slab
+		struct Slab
+		{
+			Slab*			m_prev;			///< neighbors in the list of partial slabs
+			Slab*			m_next;
+			void*			m_freeList;		///< freed blocks of this slab
+			unsigned char*	m_cur;			///< first block never handed out
+			std::size_t		m_numObjects;
+		};
+
+		struct SizeClass
+		{
+			SizeClass() : m_partial(NULL), m_empty(NULL), m_numObjects(0),
+						  m_numSlabs(0)	{}
+
+			Slab*			m_partial;		///< slabs with free blocks
+			Slab*			m_empty;		///< the empty slab kept for reuse
+			std::size_t		m_numObjects;
+			std::size_t		m_numSlabs;
+		#ifdef UG_OPENMP
+			omp_lock_t		m_lock;
+		#endif
+		};
+
+	///	locks a size class for the lifetime of the guard
+		class Guard
+		{
+			public:
+			#ifdef UG_OPENMP
+				Guard(SizeClass& sc) : m_sc(sc)	{omp_set_lock(&m_sc.m_lock);}
+				~Guard()						{omp_unset_lock(&m_sc.m_lock);}
+			private:
+				SizeClass& m_sc;
+			#else
+				Guard(SizeClass&)				{}
+			#endif
+		};
+
+		static const std::size_t SLAB_ALIGNMENT = sizeof(void*) > 8 ? sizeof(void*) : 8;
+
+	///	size of the slab header, the blocks start behind it
+		static const std::size_t SLAB_HEADER_SIZE =
+			((sizeof(Slab) + SLAB_ALIGNMENT - 1) / SLAB_ALIGNMENT) * SLAB_ALIGNMENT;
+
+		static inline std::size_t size_class_index(std::size_t numBytes)
+		{return (numBytes + SLAB_ALIGNMENT - 1) / SLAB_ALIGNMENT;}
+
+		static inline std::size_t num_blocks(std::size_t blockSize)
+		{return (slabSize - SLAB_HEADER_SIZE) / blockSize;}
+
+		static inline Slab* slab_of(void* p)
+		{return reinterpret_cast<Slab*>(reinterpret_cast<std::size_t>(p) & ~(slabSize - 1));}
+
+	///	resets the slab to hand out its blocks from the beginning
+		static void reset_slab(Slab* s);
+
+		Slab* create_slab(SizeClass& sc);
+		void release_slab(SizeClass& sc, Slab* s);
+
+	///	adds a slab to the front or back of the partial slabs / removes it
+	///	\{
+		static void push_partial(SizeClass& sc, Slab* s, bool bFront);
+		static void remove_partial(SizeClass& sc, Slab* s);
+	///	\}
+
+	private:
+		std::vector<SizeClass>	m_vSizeClasses;
+		std::size_t				m_numLargeObjects;
+};
+
+
+///	Implements the operators new and delete through a SlabAllocator
+/**	Derive from this class to allocate the objects of a class hierarchy through
+ * SlabAllocator<TTag>. Please note that the size passed to operator delete
+ * is only correct if the class hierarchy has a virtual destructor.
+ */
+template <class TTag>
+class SlabObject
+{
+	public:
+		static void* operator new(std::size_t size)
+		{return SlabAllocator<TTag>::inst().allocate(size);}
+
+		static void operator delete(void* p, std::size_t size)
+		{SlabAllocator<TTag>::inst().deallocate(p, size);}
+};
+
+}//	end of namespace
+
+////////////////////////////////
+//	include implementation
+#include "slab_allocator_impl.h"
+
+#endif
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__SLAB_ALLOCATOR_IMPL__
+#define __H__UG__SLAB_ALLOCATOR_IMPL__
+
+#include <cassert>
+#include <sstream>
+#include <new>
+#include "common/static_assert.h"
+#include "aligned_allocator.h"
+
+namespace ug{
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+SlabAllocator<TTag, maxObjSize, slabSize>&
+SlabAllocator<TTag, maxObjSize, slabSize>::
+inst()
+{
+	static SlabAllocator<TTag, maxObjSize, slabSize>* alloc =
+			new SlabAllocator<TTag, maxObjSize, slabSize>;
+	return *alloc;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+SlabAllocator<TTag, maxObjSize, slabSize>::
+SlabAllocator() :
+	m_vSizeClasses(size_class_index(maxObjSize) + 1),
+	m_numLargeObjects(0)
+{
+	UG_STATIC_ASSERT((slabSize & (slabSize - 1)) == 0, slab_size_has_to_be_a_power_of_two);
+	UG_STATIC_ASSERT((slabSize - SLAB_HEADER_SIZE) / maxObjSize >= 16,
+					 slab_has_to_hold_16_objects_of_max_size);
+#ifdef UG_OPENMP
+	for(std::size_t i = 0; i < m_vSizeClasses.size(); ++i)
+		omp_init_lock(&m_vSizeClasses[i].m_lock);
+#endif
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+void* SlabAllocator<TTag, maxObjSize, slabSize>::
+allocate(std::size_t numBytes)
+{
+	if(numBytes > maxObjSize){
+#ifdef UG_OPENMP
+		#pragma omp atomic
+#endif
+		++m_numLargeObjects;
+		return ::operator new(numBytes);
+	}
+
+	const std::size_t ind = size_class_index(numBytes);
+	const std::size_t blockSize = ind * SLAB_ALIGNMENT;
+	SizeClass& sc = m_vSizeClasses[ind];
+	Guard guard(sc);
+
+//	take a block of the first partial slab, use the empty or a new slab
+//	if there is none
+	Slab* s = sc.m_partial;
+	if(!s){
+		if(sc.m_empty){
+			s = sc.m_empty;
+			sc.m_empty = NULL;
+		}
+		else
+			s = create_slab(sc);
+		push_partial(sc, s, true);
+	}
+
+	void* p;
+	if(s->m_freeList){
+		p = s->m_freeList;
+		s->m_freeList = *static_cast<void**>(p);
+	}
+	else{
+		p = s->m_cur;
+		s->m_cur += blockSize;
+	}
+	++s->m_numObjects;
+	++sc.m_numObjects;
+
+//	a full slab leaves the partial slabs until a block is freed
+	if(s->m_numObjects == num_blocks(blockSize))
+		remove_partial(sc, s);
+	return p;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+void SlabAllocator<TTag, maxObjSize, slabSize>::
+deallocate(void* p, std::size_t numBytes)
+{
+	if(!p) return;
+
+	if(numBytes > maxObjSize){
+#ifdef UG_OPENMP
+		#pragma omp atomic
+#endif
+		--m_numLargeObjects;
+		::operator delete(p);
+		return;
+	}
+
+	const std::size_t ind = size_class_index(numBytes);
+	const std::size_t blockSize = ind * SLAB_ALIGNMENT;
+	SizeClass& sc = m_vSizeClasses[ind];
+	Guard guard(sc);
+
+	Slab* s = slab_of(p);
+	assert(s->m_numObjects > 0);
+	const bool bWasFull = (s->m_numObjects == num_blocks(blockSize));
+	*static_cast<void**>(p) = s->m_freeList;
+	s->m_freeList = p;
+	--s->m_numObjects;
+	--sc.m_numObjects;
+
+	if(s->m_numObjects == 0){
+	//	keep one empty slab, release the others
+		remove_partial(sc, s);
+		if(!sc.m_empty){
+			reset_slab(s);
+			sc.m_empty = s;
+		}
+		else
+			release_slab(sc, s);
+	}
+	else if(bWasFull)
+		push_partial(sc, s, false);
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+void SlabAllocator<TTag, maxObjSize, slabSize>::
+reset_slab(Slab* s)
+{
+	s->m_prev = s->m_next = NULL;
+	s->m_freeList = NULL;
+	s->m_cur = reinterpret_cast<unsigned char*>(s) + SLAB_HEADER_SIZE;
+	s->m_numObjects = 0;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+typename SlabAllocator<TTag, maxObjSize, slabSize>::Slab*
+SlabAllocator<TTag, maxObjSize, slabSize>::
+create_slab(SizeClass& sc)
+{
+	Slab* s = reinterpret_cast<Slab*>(
+					AlignedAllocator<unsigned char, slabSize>().allocate(slabSize));
+	reset_slab(s);
+	++sc.m_numSlabs;
+	return s;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+void SlabAllocator<TTag, maxObjSize, slabSize>::
+release_slab(SizeClass& sc, Slab* s)
+{
+	AlignedAllocator<unsigned char, slabSize>().deallocate(
+					reinterpret_cast<unsigned char*>(s), slabSize);
+	--sc.m_numSlabs;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+void SlabAllocator<TTag, maxObjSize, slabSize>::
+push_partial(SizeClass& sc, Slab* s, bool bFront)
+{
+	if(!sc.m_partial){
+		s->m_prev = s->m_next = s;
+		sc.m_partial = s;
+		return;
+	}
+
+//	the partial slabs form a ring, m_partial is its front
+	Slab* front = sc.m_partial;
+	s->m_next = front;
+	s->m_prev = front->m_prev;
+	front->m_prev->m_next = s;
+	front->m_prev = s;
+	if(bFront)
+		sc.m_partial = s;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+void SlabAllocator<TTag, maxObjSize, slabSize>::
+remove_partial(SizeClass& sc, Slab* s)
+{
+	if(s->m_next == s)
+		sc.m_partial = NULL;
+	else{
+		s->m_prev->m_next = s->m_next;
+		s->m_next->m_prev = s->m_prev;
+		if(sc.m_partial == s)
+			sc.m_partial = s->m_next;
+	}
+	s->m_prev = s->m_next = NULL;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+std::size_t SlabAllocator<TTag, maxObjSize, slabSize>::
+num_objects() const
+{
+	std::size_t num = m_numLargeObjects;
+	for(std::size_t i = 0; i < m_vSizeClasses.size(); ++i)
+		num += m_vSizeClasses[i].m_numObjects;
+	return num;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+std::size_t SlabAllocator<TTag, maxObjSize, slabSize>::
+num_slabs() const
+{
+	std::size_t num = 0;
+	for(std::size_t i = 0; i < m_vSizeClasses.size(); ++i)
+		num += m_vSizeClasses[i].m_numSlabs;
+	return num;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+std::size_t SlabAllocator<TTag, maxObjSize, slabSize>::
+occupied_memory() const
+{
+	return num_slabs() * slabSize;
+}
+
+template <class TTag, std::size_t maxObjSize, std::size_t slabSize>
+std::string SlabAllocator<TTag, maxObjSize, slabSize>::
+statistics() const
+{
+	std::stringstream ss;
+	ss << "size (bytes)\tobjects\tslabs\n";
+	for(std::size_t i = 0; i < m_vSizeClasses.size(); ++i){
+		const SizeClass& sc = m_vSizeClasses[i];
+		if(sc.m_numSlabs == 0) continue;
+		ss << i * SLAB_ALIGNMENT << "\t\t" << sc.m_numObjects << "\t"
+		   << sc.m_numSlabs << "\n";
+	}
+	ss << "large objects: " << m_numLargeObjects
+	   << ", slab memory: " << occupied_memory() / 1024 << " KiB\n";
+	return ss.str();
+}
+
+}//	end of namespace
+
+#endif
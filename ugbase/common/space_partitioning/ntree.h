@@ -33,6 +33,8 @@
 #ifndef __H__UG__ntree__
 #define __H__UG__ntree__
 
+#include <vector>
+#include "common/allocators/aligned_allocator.h"
 #include "ntree_iterator.h"
 
 namespace ug{
@@ -123,6 +125,9 @@ struct NTreeDesc{
  * Usage:
  *	- Add elements to your tree-instance through the 'add_element' method.
  *	- Call 'rebalance' once all elements have been added.
+ *	- Single elements can afterwards be inserted into or removed from the
+ *	  balanced tree through 'insert_element' and 'remove_element', without
+ *	  rebuilding the whole tree.
  *	- Use traversers to query the tree for elements, e.g.
  *	  'Traverser_FindContainingElement', 'Traverser_FindElementsInIntersectingNodes',
  *	  or 'Traverser_RayElementIntersection'.
@@ -139,6 +144,13 @@ struct NTreeDesc{
  *			is printed. Note that a tree of this depth often results from a bad
  *			underlying geometry and may lead to performance issues.		
  *
+ * \note	If ug4 was compiled with OpenMP, 'rebalance' builds independent
+ *			subtrees concurrently. The number of threads is set through
+ *			'set_num_threads' and defaults to 1. After each rebalance the
+ *			nodes are stored depth-first with all children of a node in one
+ *			consecutive block and the entries of each leaf are stored
+ *			consecutively, so that traversals touch memory in order.
+ *
  * \param tree_dim		Dimension of the tree: binary-trees (tree_dim=1),
  * 						quad-trees (tree_dim=2), and octrees (tree_dim=3)
  *						are supported.
@@ -208,14 +220,40 @@ class ntree
 	/**	\note delayed elements are inserted on a call to rebalance.*/
 		size_t num_delayed_elements() const;
 
+	///	returns the number of elements which were removed through 'remove_element' since the last rebalance.
+	/**	Removed elements still occupy memory until the next call to rebalance.*/
+		size_t num_removed_elements() const;
+
+	///	sets the number of threads used during rebalance (ignored without OpenMP)
+		void set_num_threads(int numThreads);
+
+	///	returns the number of threads used during rebalance
+		int num_threads() const				{return m_numThreads;}
+
 	///	adds an element to the tree.
 	/**	The element will only be scheduled for insertion but won't be inserted
-	 * until rebalance is called.
-	 * \todo	Allow optional on-the-fly insertion of elements.*/
+	 * until rebalance is called. Use 'insert_element' for on-the-fly insertion.*/
 		void add_element(const elem_t& elem);
 
+	///	inserts an element into the balanced tree
+	/**	The element is added to the leaf which contains its center and the
+	 * loose bounding boxes of all nodes on the path to that leaf are enlarged.
+	 * If the leaf thereby reaches the split-threshold, it is split.
+	 * If the center lies outside the root box or if there are delayed elements,
+	 * the whole tree is rebalanced instead.*/
+		void insert_element(const elem_t& elem);
+
+	///	removes an element from the balanced tree
+	/**	The element is searched in the leaf which contains its center first and
+	 * in all leaves, if it is not found there. Removed elements are only
+	 * unlinked. Their memory is released and the bounding boxes are shrunk
+	 * on the next call to 'rebalance'.
+	 * elem_t has to be comparable through operator==.
+	 * \returns false if the element was not found.*/
+		bool remove_element(const elem_t& elem);
+
 	///	rebalances the whole tree
-	/**	The method returns false if some error occurred during rebalancing.*/
+	/**	Delayed elements are inserted and removed elements are released.*/
 		void rebalance();
 
 	///	returns the total number of nodes in the tree
@@ -265,6 +303,9 @@ class ntree
 	///	marks an index as invalid
 		static const size_t s_invalidIndex = -1;
 
+	///	marks an entry as removed (used for Entry::nextEntryInd only)
+		static const size_t s_removedIndex = -2;
+
 
 	///	An Entry combines an element with the index to the next entry in a leaf-node's entry list.
 	/** Note that exactly one 'Entry' object per element exists. Since 'Entry'
@@ -282,8 +323,9 @@ class ntree
 
 
 	/**	The tree is built as a hierarchy of nodes.
-	 * Leaf nodes contain entries.*/
-		struct Node{
+	 * Leaf nodes contain entries. Nodes are aligned to cache lines, so that
+	 * a node never straddles two lines unnecessarily during traversal.*/
+		struct alignas(64) Node{
 			size_t		childNodeInd[s_numChildren]; /// < index into m_nodes. s_invalidIndex: no child node.
 			size_t		firstEntryInd; ///< index into m_entries. s_invalidIndex: no entry
 			size_t		lastEntryInd; ///< index into m_entries. s_invalidIndex: no entry
@@ -309,31 +351,65 @@ class ntree
 			}
 		};
 
+		typedef std::vector<Node, AlignedAllocator<Node, 64> >	node_vector_t;
+
+	///	splits a node into 2^tree_dim child nodes and assigns entries to those children.
+	/**	No recursion is performed. The new nodes are appended to 'nodes'.
+	 * \returns false if the node was not split (e.g. since the maximum depth
+	 *			was reached or since it contains one entry only).*/
+		bool split_node(node_vector_t& nodes, size_t nodeIndex);
+
 	///	splits a node into 2^tree_dim child nodes and assigns entries to those children.
 	/**	If the node-threshold of a child node is surpassed, then the child will
 	 * be splitted recursively.
-	 * Make sure that the given node is a leaf node and thus hasn't got children.*/
-		void split_leaf_node(size_t nodeIndex);
+	 * Make sure that the given node is a leaf node and thus hasn't got children.
+	 * Calls for different nodes may run concurrently, as long as they operate
+	 * on different node vectors.*/
+		void split_leaf_node(node_vector_t& nodes, size_t nodeIndex);
+
+	///	splits the root node and builds independent subtrees concurrently
+		void build_subtrees();
+
+	///	reorders nodes and entries depth-first (see class description)
+		void linearize();
+
+	///	copies the subtree below oldNodeInd to newNodes and its entries to newEntries.
+		void linearize_subtree(node_vector_t& newNodes, size_t newNodeInd,
+							   size_t oldNodeInd, std::vector<Entry>& newEntries,
+							   std::vector<vector_t>& newCenters,
+							   std::vector<box_t>& newBoxes);
+
+	///	calculates centers and bounding boxes of all entries
+		void calculate_entry_data();
 
 	///	returns an index to the leaf-node which contains the given point
 	/**	returns s_invalidIndex if no matching node was found.
 	 * Checks the point against the tight bounding-box of each node.*/
 		size_t find_leaf_node(const vector_t& point, size_t curNode = 0);
 
+	///	removes the entry holding elem from the entry list of the given leaf.
+		bool unlink_entry(size_t nodeIndex, const elem_t& elem);
+
 	///	adds an entry to the given node
 		void add_entry_to_node(Node& node, size_t entryInd);
 
 	///	updates the loose bounding box of the given node
-		void update_loose_bounding_box(Node& node);
+		void update_loose_bounding_box(Node& node) const;
 
 	///	calculates the center of mass of a given node
-		vector_t calculate_center_of_mass(Node& node);
+		vector_t calculate_center_of_mass(const Node& node) const;
 
 		NTreeDesc				m_desc;
 		common_data_t			m_commonData;
-		std::vector<Node>		m_nodes; ///< m_nodes[0] is always considered to be the root node.
+		node_vector_t			m_nodes; ///< m_nodes[0] is always considered to be the root node.
 		std::vector<Entry>		m_entries;
+	///	centers of all non-delayed entries. Indices match m_entries.
+		std::vector<vector_t>	m_entryCenters;
+	///	bounding boxes of all non-delayed entries. Indices match m_entries.
+		std::vector<box_t>		m_entryBoxes;
 		size_t					m_numDelayedElements;
+		size_t					m_numRemovedEntries;
+		int						m_numThreads;
 		bool					m_warningsEnabled;
 };
 
@@ -34,6 +34,8 @@
 #define __H__UG__ntree_impl__
 
 #include <cassert>
+#include <string>
+#include "common/error.h"
 #include "ntree.h"
 
 namespace ug{
@@ -41,6 +43,9 @@ namespace ug{
 template <int tree_dim, int world_dim, class elem_t, class common_data_t>
 ntree<tree_dim, world_dim, elem_t, common_data_t>::
 ntree() :
+	m_numDelayedElements (0),
+	m_numRemovedEntries (0),
+	m_numThreads (1),
 	m_warningsEnabled (true)
 {
 	m_nodes.resize(1);
@@ -63,7 +68,10 @@ clear()
 {
 	clear_nodes();
 	m_entries.clear();
+	m_entryCenters.clear();
+	m_entryBoxes.clear();
 	m_numDelayedElements = 0;
+	m_numRemovedEntries = 0;
 }
 
 
@@ -107,7 +115,7 @@ template <int tree_dim, int world_dim, class elem_t, class common_data_t>
 size_t ntree<tree_dim, world_dim, elem_t, common_data_t>::
 size() const
 {
-	return m_entries.size() - m_numDelayedElements;
+	return m_entries.size() - m_numDelayedElements - m_numRemovedEntries;
 }
 
 
@@ -119,40 +127,163 @@ num_delayed_elements() const
 }
 
 
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+size_t ntree<tree_dim, world_dim, elem_t, common_data_t>::
+num_removed_elements() const
+{
+	return m_numRemovedEntries;
+}
+
+
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+void ntree<tree_dim, world_dim, elem_t, common_data_t>::
+set_num_threads(int numThreads)
+{
+	UG_COND_THROW(numThreads < 1, "ntree::set_num_threads: number of threads "
+				  "has to be at least 1, but " << numThreads << " was given.");
+#ifndef UG_OPENMP
+	if(numThreads > 1){
+		UG_LOG("WARNING in ntree::set_num_threads: ug4 is compiled without "
+			   "OpenMP (cmake -DOPENMP=ON). The tree construction stays serial.\n");
+	}
+#endif
+	m_numThreads = numThreads;
+}
+
+
 template <int tree_dim, int world_dim, class elem_t, class common_data_t>
 void ntree<tree_dim, world_dim, elem_t, common_data_t>::
 add_element(const elem_t& elem)
 {
-//	size_t entryInd = m_entries.size();
 	m_entries.push_back(Entry(elem));
-
 	++m_numDelayedElements;
+}
+
+
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+void ntree<tree_dim, world_dim, elem_t, common_data_t>::
+insert_element(const elem_t& elem)
+{
+	if(m_numDelayedElements > 0 || size() == 0){
+		add_element(elem);
+		rebalance();
+		return;
+	}
+
+	vector_t center;
+	traits::calculate_center(center, elem, m_commonData);
+	if(!traits::box_contains_point(m_nodes[0].tightBox, center)){
+		add_element(elem);
+		rebalance();
+		return;
+	}
+
+	box_t box;
+	traits::calculate_bounding_box(box, elem, m_commonData);
+	box_t looseBox;
+	vector_t offset;
+	offset = SMALL;
+	traits::grow_box(looseBox, box, offset);
+
+//	descend to the leaf which contains the center and enlarge the loose boxes
+//	on the way. Tight boxes of siblings share their faces, which is why the
+//	first matching child is chosen, exactly as during split_node.
+	size_t nodeInd = 0;
+	while(true){
+		Node& node = m_nodes[nodeInd];
+		traits::merge_boxes(node.looseBox, node.looseBox, looseBox);
+		if(node.childNodeInd[0] == s_invalidIndex)
+			break;
+
+		size_t i_child;
+		for(i_child = 0; i_child < s_numChildren; ++i_child){
+			if(traits::box_contains_point(m_nodes[node.childNodeInd[i_child]].tightBox,
+										  center))
+				break;
+		}
+
+		if(i_child == s_numChildren){
+		//	may only happen due to round-off errors
+			add_element(elem);
+			rebalance();
+			return;
+		}
+		nodeInd = node.childNodeInd[i_child];
+	}
+
+	const size_t entryInd = m_entries.size();
+	m_entries.push_back(Entry(elem));
+	m_entryCenters.push_back(center);
+	m_entryBoxes.push_back(box);
+
+	add_entry_to_node(m_nodes[nodeInd], entryInd);
+	if(m_nodes[nodeInd].numEntries >= m_desc.splitThreshold)
+		split_leaf_node(m_nodes, nodeInd);
+}
+
+
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+bool ntree<tree_dim, world_dim, elem_t, common_data_t>::
+remove_element(const elem_t& elem)
+{
+//	delayed entries are not yet linked. They are stored at the end of m_entries.
+	for(size_t i = m_entries.size() - m_numDelayedElements; i < m_entries.size(); ++i){
+		if(m_entries[i].elem == elem){
+			m_entries[i] = m_entries.back();
+			m_entries.pop_back();
+			--m_numDelayedElements;
+			return true;
+		}
+	}
+
+	if(size() == 0)
+		return false;
+
+	vector_t center;
+	traits::calculate_center(center, elem, m_commonData);
+	size_t nodeInd = find_leaf_node(center);
+	if(nodeInd != s_invalidIndex && unlink_entry(nodeInd, elem))
+		return true;
+
+//	the element may have moved since its insertion. Search all leaves.
+	for(size_t i = 0; i < m_nodes.size(); ++i){
+		if((m_nodes[i].childNodeInd[0] == s_invalidIndex)
+		   && (i != nodeInd)
+		   && unlink_entry(i, elem))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 
-//todo	If we allowed for immediate on-the-fly insertion of elements, the following
-//		code could serve as an implementation base. Note, that it is not yet complete.
-//		One would have to update parent boxes if a child box changes etc.
-//		It would make sense to also allow for the specification of a
-//		minimum root-bounding-box, since else most insertions would trigger a rebalance.
-//	{
-//		vector_t center;
-//		traits::calculate_center(center, elem, m_commonData);
-//		size_t nodeInd = find_leaf_node(center);
-//		if(nodeInd == s_invalidIndex){
-//			++m_numDelayedElements;
-//			rebalance();
-//		}
-//		else{
-//			Node& node = m_nodes[nodeInd];
-//			add_entry_to_node(node, entryInd);
-//			if(node.numEntries >= m_desc.splitThreshold)
-//				split_leaf_node(nodeInd);
-//			else{
-//			//todo	the update could be much more efficient (simply unite the
-//			//		old bounding box with the new element's bounding box.
-//				update_loose_bounding_box(node);
-//			}
-//		}
-//	}
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+bool ntree<tree_dim, world_dim, elem_t, common_data_t>::
+unlink_entry(size_t nodeIndex, const elem_t& elem)
+{
+	Node& node = m_nodes[nodeIndex];
+	size_t prevInd = s_invalidIndex;
+	for(size_t entryInd = node.firstEntryInd; entryInd != s_invalidIndex;){
+		Entry& entry = m_entries[entryInd];
+		if(entry.elem == elem){
+			if(prevInd == s_invalidIndex)
+				node.firstEntryInd = entry.nextEntryInd;
+			else
+				m_entries[prevInd].nextEntryInd = entry.nextEntryInd;
+
+			if(node.lastEntryInd == entryInd)
+				node.lastEntryInd = prevInd;
+
+			entry.nextEntryInd = s_removedIndex;
+			--node.numEntries;
+			++m_numRemovedEntries;
+			return true;
+		}
+		prevInd = entryInd;
+		entryInd = entry.nextEntryInd;
+	}
+	return false;
 }
 
 
@@ -160,9 +291,26 @@ template <int tree_dim, int world_dim, class elem_t, class common_data_t>
 void ntree<tree_dim, world_dim, elem_t, common_data_t>::
 rebalance()
 {
+//	release removed entries
+	if(m_numRemovedEntries > 0){
+		size_t numKept = 0;
+		for(size_t i = 0; i < m_entries.size(); ++i){
+			if(m_entries[i].nextEntryInd != s_removedIndex){
+				if(i != numKept)
+					m_entries[numKept] = m_entries[i];
+				++numKept;
+			}
+		}
+		m_entries.erase(m_entries.begin() + numKept, m_entries.end());
+		m_numRemovedEntries = 0;
+	}
+	m_numDelayedElements = 0;
+
 //	push all elements into the root node, calculate its bounding box
 //	and call split_leaf_node if the element threshold is surpassed.
 	clear_nodes();
+	calculate_entry_data();
+
 	Node& root = m_nodes.back();
 	if(!m_entries.empty()){
 		root.firstEntryInd = 0;
@@ -177,39 +325,210 @@ rebalance()
 		update_loose_bounding_box(root);
 		root.tightBox = root.looseBox;
 
-		if(root.numEntries >= m_desc.splitThreshold)
-			split_leaf_node(0);
+		if(root.numEntries >= m_desc.splitThreshold){
+			build_subtrees();
+			linearize();
+		}
+	}
+}
+
+
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+void ntree<tree_dim, world_dim, elem_t, common_data_t>::
+calculate_entry_data()
+{
+	const int numEntries = (int)m_entries.size();
+	m_entryCenters.resize(numEntries);
+	m_entryBoxes.resize(numEntries);
+
+	#ifdef UG_OPENMP
+	#pragma omp parallel for num_threads(m_numThreads)
+	#endif
+	for(int i = 0; i < numEntries; ++i){
+		traits::calculate_center(m_entryCenters[i], m_entries[i].elem, m_commonData);
+		traits::calculate_bounding_box(m_entryBoxes[i], m_entries[i].elem, m_commonData);
+	}
+}
+
+
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+void ntree<tree_dim, world_dim, elem_t, common_data_t>::
+build_subtrees()
+{
+//	split the top levels breadth first until there are enough independent
+//	subtrees to keep all threads busy.
+	std::vector<size_t> frontier(1, 0);
+	if(m_numThreads > 1){
+		const size_t minNumSubtrees = 4 * (size_t)m_numThreads;
+		while(!frontier.empty() && frontier.size() < minNumSubtrees){
+			std::vector<size_t> nextFrontier;
+			for(size_t i = 0; i < frontier.size(); ++i){
+				if(!split_node(m_nodes, frontier[i]))
+					continue;
+				for(size_t i_child = 0; i_child < s_numChildren; ++i_child){
+					size_t childInd = m_nodes[frontier[i]].childNodeInd[i_child];
+					if(m_nodes[childInd].numEntries >= m_desc.splitThreshold)
+						nextFrontier.push_back(childInd);
+				}
+			}
+			frontier.swap(nextFrontier);
+		}
+	}
+
+//	each subtree is built in a separate node vector. Since the entries of
+//	different subtrees are disjoint, the entry lists may be modified concurrently.
+	const int numSubtrees = (int)frontier.size();
+	std::vector<node_vector_t> subtrees(numSubtrees);
+
+	bool bError = false;
+	std::string errMsg;
+
+	#ifdef UG_OPENMP
+	#pragma omp parallel for num_threads(m_numThreads) schedule(dynamic)
+	#endif
+	for(int i = 0; i < numSubtrees; ++i){
+		try{
+			node_vector_t& subtree = subtrees[i];
+			subtree.push_back(m_nodes[frontier[i]]);
+			split_leaf_node(subtree, 0);
+		}
+		catch(UGError& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (NTreeBuildSubtrees)
+			#endif
+			{
+				bError = true;
+				errMsg = err.get_stacktrace();
+			}
+		}
+		catch(std::exception& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (NTreeBuildSubtrees)
+			#endif
+			{
+				bError = true;
+				errMsg = err.what();
+			}
+		}
+	}
+
+	UG_COND_THROW(bError, "ntree::rebalance: building subtrees failed:\n" << errMsg);
+
+//	merge the subtrees into m_nodes. The root of each subtree replaces its
+//	frontier node, all other nodes are appended.
+	for(int i = 0; i < numSubtrees; ++i){
+		node_vector_t& subtree = subtrees[i];
+		const size_t offset = m_nodes.size() - 1;
+		for(size_t j = 0; j < subtree.size(); ++j){
+			Node& n = subtree[j];
+			if(n.childNodeInd[0] != s_invalidIndex){
+				for(size_t i_child = 0; i_child < s_numChildren; ++i_child)
+					n.childNodeInd[i_child] += offset;
+			}
+		}
+		m_nodes[frontier[i]] = subtree[0];
+		m_nodes.insert(m_nodes.end(), subtree.begin() + 1, subtree.end());
 	}
 }
 
 
 template <int tree_dim, int world_dim, class elem_t, class common_data_t>
 void ntree<tree_dim, world_dim, elem_t, common_data_t>::
-split_leaf_node(size_t nodeIndex)
+linearize()
 {
+	node_vector_t newNodes;
+	newNodes.reserve(m_nodes.size());
+	std::vector<Entry> newEntries;
+	newEntries.reserve(m_entries.size());
+	std::vector<vector_t> newCenters;
+	newCenters.reserve(m_entryCenters.size());
+	std::vector<box_t> newBoxes;
+	newBoxes.reserve(m_entryBoxes.size());
+
+	newNodes.push_back(m_nodes[0]);
+	linearize_subtree(newNodes, 0, 0, newEntries, newCenters, newBoxes);
+
+	UG_COND_THROW(newEntries.size() != m_entries.size(),
+				  "ntree::linearize: entries were lost during linearization.");
+
+	m_nodes.swap(newNodes);
+	m_entries.swap(newEntries);
+	m_entryCenters.swap(newCenters);
+	m_entryBoxes.swap(newBoxes);
+}
+
 
-	if(m_nodes[nodeIndex].numEntries <= 1)
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+void ntree<tree_dim, world_dim, elem_t, common_data_t>::
+linearize_subtree(node_vector_t& newNodes, size_t newNodeInd,
+				  size_t oldNodeInd, std::vector<Entry>& newEntries,
+				  std::vector<vector_t>& newCenters,
+				  std::vector<box_t>& newBoxes)
+{
+	const Node& oldNode = m_nodes[oldNodeInd];
+	if(oldNode.childNodeInd[0] == s_invalidIndex){
+		Node& newNode = newNodes[newNodeInd];
+		newNode.firstEntryInd = newNode.lastEntryInd = s_invalidIndex;
+		for(size_t entryInd = oldNode.firstEntryInd; entryInd != s_invalidIndex;
+			entryInd = m_entries[entryInd].nextEntryInd)
+		{
+			const size_t newEntryInd = newEntries.size();
+			newEntries.push_back(m_entries[entryInd]);
+			newCenters.push_back(m_entryCenters[entryInd]);
+			newBoxes.push_back(m_entryBoxes[entryInd]);
+			if(newNode.firstEntryInd == s_invalidIndex)
+				newNode.firstEntryInd = newEntryInd;
+			else
+				newEntries[newNode.lastEntryInd].nextEntryInd = newEntryInd;
+			newNode.lastEntryInd = newEntryInd;
+		}
+		if(newNode.lastEntryInd != s_invalidIndex)
+			newEntries[newNode.lastEntryInd].nextEntryInd = s_invalidIndex;
 		return;
+	}
+
+//	all children of a node are stored in one block
+	const size_t firstChild = newNodes.size();
+	for(size_t i_child = 0; i_child < s_numChildren; ++i_child)
+		newNodes.push_back(m_nodes[oldNode.childNodeInd[i_child]]);
+
+	for(size_t i_child = 0; i_child < s_numChildren; ++i_child)
+		newNodes[newNodeInd].childNodeInd[i_child] = firstChild + i_child;
 
-	if(m_nodes[nodeIndex].level >= m_desc.maxDepth){
+	for(size_t i_child = 0; i_child < s_numChildren; ++i_child){
+		linearize_subtree(newNodes, firstChild + i_child,
+						  m_nodes[oldNodeInd].childNodeInd[i_child],
+						  newEntries, newCenters, newBoxes);
+	}
+}
+
+
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+bool ntree<tree_dim, world_dim, elem_t, common_data_t>::
+split_node(node_vector_t& nodes, size_t nodeIndex)
+{
+	if(nodes[nodeIndex].numEntries <= 1)
+		return false;
+
+	if(nodes[nodeIndex].level >= m_desc.maxDepth){
 		if(m_warningsEnabled){
 			UG_LOG("WARNING in ntree::split_leaf_node(): maximum tree depth "
 				<< m_desc.maxDepth << " reached. No further splits are performed for "
 				" this node. Note that too many elements per node may lead to performance issues.\n"
-				<< "  Number of elements in this node: " << m_nodes[nodeIndex].numEntries << std::endl
-				<< "  Corner coordinates of this node: " << m_nodes[nodeIndex].tightBox << std::endl);
+				<< "  Number of elements in this node: " << nodes[nodeIndex].numEntries << std::endl
+				<< "  Corner coordinates of this node: " << nodes[nodeIndex].tightBox << std::endl);
 		}
-		return;
+		return false;
 	}
 
-	if(m_nodes[nodeIndex].childNodeInd[0] != s_invalidIndex)
-		return;
+	if(nodes[nodeIndex].childNodeInd[0] != s_invalidIndex)
+		return false;
 
-	const size_t firstChild = m_nodes.size();
-	m_nodes.resize(firstChild + s_numChildren);
+	const size_t firstChild = nodes.size();
+	nodes.resize(firstChild + s_numChildren);
 
-//	ATTENTION: Be careful not to resize m_nodes while using node, since this would invalidate the reference!
-	Node& node = m_nodes[nodeIndex];
+//	ATTENTION: Be careful not to resize nodes while using node, since this would invalidate the reference!
+	Node& node = nodes[nodeIndex];
 
 //	calculate center of mass and use the traits class to split the box of
 //	the current node into 's_numChildren' child boxes. Each child box thereby
@@ -224,22 +543,14 @@ split_leaf_node(size_t nodeIndex)
 		Entry& entry = m_entries[entryInd];
 		size_t nextEntryInd = entry.nextEntryInd;
 
-		size_t i_child;
-		vector_t center;
-		traits::calculate_center(center, entry.elem, m_commonData);
-		for(i_child = 0; i_child < s_numChildren; ++i_child){
+		const vector_t& center = m_entryCenters[entryInd];
+		for(size_t i_child = 0; i_child < s_numChildren; ++i_child){
 			if(traits::box_contains_point(childBoxes[i_child], center)){
-				add_entry_to_node(m_nodes[firstChild + i_child], entryInd);
+				add_entry_to_node(nodes[firstChild + i_child], entryInd);
 				++numEntriesAssigned;
 				break;
 			}
 		}
-		/*-- For debugging only: --*
-		if(i_child == s_numChildren){
-			UG_LOG ("ERROR in ntree::split_leaf_node(): Element with center @ " << center
-				<< " does not belong to any child of the box " << node.tightBox << std::endl);
-		}
-		 *--*/
 
 		entryInd = nextEntryInd;
 	}
@@ -255,18 +566,30 @@ split_leaf_node(size_t nodeIndex)
 
 	for(size_t i_child = 0; i_child < s_numChildren; ++i_child){
 		node.childNodeInd[i_child] = firstChild + i_child;
-		Node& childNode = m_nodes[firstChild + i_child];
+		Node& childNode = nodes[firstChild + i_child];
 		childNode.level = node.level + 1;
 		childNode.tightBox = childBoxes[i_child];
 		update_loose_bounding_box(childNode);
 	}
 
-//	since split_leaf_node resizes m_nodes and since this invalidates any references
-//	to m_nodes, we perform the recursion in a last step
+	return true;
+}
+
+
+template <int tree_dim, int world_dim, class elem_t, class common_data_t>
+void ntree<tree_dim, world_dim, elem_t, common_data_t>::
+split_leaf_node(node_vector_t& nodes, size_t nodeIndex)
+{
+	if(!split_node(nodes, nodeIndex))
+		return;
+
+//	since split_node resizes nodes and since this invalidates any references
+//	to nodes, we perform the recursion in a last step
+	const size_t firstChild = nodes[nodeIndex].childNodeInd[0];
 	for(size_t i_child = 0; i_child < s_numChildren; ++i_child){
 		size_t childNodeInd = firstChild + i_child;
-		if(m_nodes[childNodeInd].numEntries >= m_desc.splitThreshold)
-			split_leaf_node(childNodeInd);
+		if(nodes[childNodeInd].numEntries >= m_desc.splitThreshold)
+			split_leaf_node(nodes, childNodeInd);
 	}
 }
 
@@ -312,7 +635,7 @@ add_entry_to_node(Node& node, size_t entryInd)
 
 template <int tree_dim, int world_dim, class elem_t, class common_data_t>
 void ntree<tree_dim, world_dim, elem_t, common_data_t>::
-update_loose_bounding_box(Node& node)
+update_loose_bounding_box(Node& node) const
 {
 	size_t entryInd = node.firstEntryInd;
 	if(entryInd == s_invalidIndex){
@@ -320,16 +643,11 @@ update_loose_bounding_box(Node& node)
 		return;
 	}
 
-	Entry& entry = m_entries[entryInd];
-	traits::calculate_bounding_box(node.looseBox, entry.elem, m_commonData);
-
-	entryInd = entry.nextEntryInd;
+	node.looseBox = m_entryBoxes[entryInd];
+	entryInd = m_entries[entryInd].nextEntryInd;
 	while(entryInd != s_invalidIndex){
-		Entry& entry = m_entries[entryInd];
-		box_t nbox;
-		traits::calculate_bounding_box(nbox, entry.elem, m_commonData);
-		traits::merge_boxes(node.looseBox, node.looseBox, nbox);
-		entryInd = entry.nextEntryInd;
+		traits::merge_boxes(node.looseBox, node.looseBox, m_entryBoxes[entryInd]);
+		entryInd = m_entries[entryInd].nextEntryInd;
 	}
 	
 //todo: Solve box-growing in a more portable way!
@@ -342,18 +660,14 @@ update_loose_bounding_box(Node& node)
 template <int tree_dim, int world_dim, class elem_t, class common_data_t>
 typename ntree<tree_dim, world_dim, elem_t, common_data_t>::vector_t
 ntree<tree_dim, world_dim, elem_t, common_data_t>::
-calculate_center_of_mass(Node& node)
+calculate_center_of_mass(const Node& node) const
 {
 	vector_t centerOfMass;
 	VecSet(centerOfMass, 0);
 
 	for(size_t entryInd = node.firstEntryInd; entryInd != s_invalidIndex;){
-		Entry& entry = m_entries[entryInd];
-
-		vector_t center;
-		traits::calculate_center(center, entry.elem, m_commonData);
-		VecAdd(centerOfMass, centerOfMass, center);
-		entryInd = entry.nextEntryInd;
+		VecAdd(centerOfMass, centerOfMass, m_entryCenters[entryInd]);
+		entryInd = m_entries[entryInd].nextEntryInd;
 	}
 
 	if(node.numEntries > 0)
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "async_file_writer.h"
+
+#include <fstream>
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+
+using namespace std;
+
+namespace ug{
+
+AsyncFileWriter& AsyncFileWriter::inst()
+{
+	static AsyncFileWriter writer;
+	return writer;
+}
+
+AsyncFileWriter::AsyncFileWriter() :
+	m_bEnabled(false),
+	m_maxPending(2),
+	m_bBusy(false),
+	m_bStop(false)
+{
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+#ifdef UG_ASYNC_IO
+	if(m_thread.joinable()){
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_bStop = true;
+		}
+		m_condWork.notify_all();
+	//	the thread writes all remaining buffers before it terminates
+		m_thread.join();
+	}
+#endif
+}
+
+void AsyncFileWriter::enable(bool enable)
+{
+	if(!enable){
+	//	new writes are synchronous, even if flushing the queue fails
+		m_bEnabled = false;
+		flush();
+		return;
+	}
+
+#ifdef UG_ASYNC_IO
+	if(!m_thread.joinable())
+		m_thread = thread(&AsyncFileWriter::run, this);
+	m_bEnabled = true;
+#else
+	UG_THROW("AsyncFileWriter: Asynchronous output is not available. "
+			 "Configure ug4 with -DASYNC_IO=ON.");
+#endif
+}
+
+void AsyncFileWriter::set_max_pending(size_t maxPending)
+{
+	UG_COND_THROW(maxPending < 1, "AsyncFileWriter: at least one pending "
+				  "buffer has to be allowed.");
+#ifdef UG_ASYNC_IO
+	unique_lock<mutex> lock(m_mutex);
+#endif
+	m_maxPending = maxPending;
+}
+
+void AsyncFileWriter::write(const std::string& filename, std::string& content)
+{
+	PROFILE_FUNC_GROUP("output");
+
+	if(!m_bEnabled){
+		if(!write_file(filename, content))
+			UG_THROW("AsyncFileWriter: Could not write to file: " << filename);
+		return;
+	}
+
+#ifdef UG_ASYNC_IO
+	unique_lock<mutex> lock(m_mutex);
+//	the buffer currently written by the background thread counts as pending
+	while(m_queue.size() + (m_bBusy ? 1 : 0) >= m_maxPending && m_error.empty())
+		m_condDone.wait(lock);
+	check_error();
+
+	m_queue.push_back(Job());
+	m_queue.back().filename = filename;
+	m_queue.back().content.swap(content);
+	lock.unlock();
+
+	m_condWork.notify_one();
+#endif
+}
+
+void AsyncFileWriter::flush()
+{
+	PROFILE_FUNC_GROUP("output");
+#ifdef UG_ASYNC_IO
+	unique_lock<mutex> lock(m_mutex);
+	while(!m_queue.empty() || m_bBusy)
+		m_condDone.wait(lock);
+	check_error();
+#endif
+}
+
+void AsyncFileWriter::check_error()
+{
+	if(!m_error.empty()){
+		string msg;
+		msg.swap(m_error);
+		UG_THROW("AsyncFileWriter: " << msg);
+	}
+}
+
+void AsyncFileWriter::run()
+{
+#ifdef UG_ASYNC_IO
+	unique_lock<mutex> lock(m_mutex);
+	for(;;){
+		while(m_queue.empty() && !m_bStop)
+			m_condWork.wait(lock);
+
+		if(m_queue.empty())
+			break;
+
+	//	the buffer is moved out of the queue, so that write() may add
+	//	another one while this one is written
+		Job job;
+		job.filename.swap(m_queue.front().filename);
+		job.content.swap(m_queue.front().content);
+		m_queue.pop_front();
+		m_bBusy = true;
+		lock.unlock();
+
+		bool success = write_file(job.filename, job.content);
+
+		lock.lock();
+		m_bBusy = false;
+		if(!success && m_error.empty())
+			m_error = string("Could not write to file: ") + job.filename;
+		m_condDone.notify_all();
+	}
+#endif
+}
+
+bool AsyncFileWriter::write_file(const std::string& filename,
+								 const std::string& content)
+{
+	ofstream out(filename.c_str(), ios_base::out | ios_base::trunc | ios_base::binary);
+	if(!out)
+		return false;
+	out.write(content.data(), content.size());
+	return out.good();
+}
+
+
+AsyncFileStream::AsyncFileStream(const std::string& filename) :
+	m_filename(filename),
+	m_bAsync(AsyncFileWriter::inst().enabled())
+{
+	if(m_bAsync)
+		return;
+
+	m_fileStream.open(filename.c_str(), ios_base::out | ios_base::trunc);
+}
+
+void AsyncFileStream::close()
+{
+	if(!m_bAsync){
+		m_fileStream.close();
+		return;
+	}
+
+	string content = m_memStream.str();
+	m_memStream.str("");
+	AsyncFileWriter::inst().write(m_filename, content);
+}
+
+}//	end of namespace
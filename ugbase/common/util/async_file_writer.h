@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__UTIL__ASYNC_FILE_WRITER__
+#define __H__UG__COMMON__UTIL__ASYNC_FILE_WRITER__
+
+#include <string>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#ifdef UG_ASYNC_IO
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace ug {
+
+/// \addtogroup ugbase_common_io
+/// \{
+
+///	Writes fully assembled file contents to disk in a background thread
+/**
+ * Output routines which are called repeatedly during a simulation (e.g.
+ * VTKOutput in a time loop) assemble their output into a staging buffer in
+ * memory and pass it to the AsyncFileWriter. If asynchronous output is
+ * enabled, the buffer is queued and written by a background thread while
+ * the caller continues with the computation. Only the raw disk I/O is
+ * performed in the background, i.e. the writer never accesses the grid or
+ * the algebra.
+ *
+ * At most max_pending() buffers (including the one currently written) are
+ * kept in flight. If this limit is reached, write() blocks until the
+ * background thread finished the oldest buffer.
+ * The default of 2 results in double buffering.
+ *
+ * If asynchronous output is disabled (the default), write() writes the
+ * buffer immediately.
+ *
+ * Each process has its own instance. Note that files written asynchronously
+ * are only guaranteed to be complete after flush() was called. This has to
+ * be considered if a file is read back during the same run.
+ *
+ * Errors occurring in the background thread are reported by the next call
+ * to write() or flush() through an UGError.
+ *
+ * Asynchronous output is only available if ug4 is configured with
+ * -DASYNC_IO=ON. Otherwise, enable(true) throws and all files are written
+ * directly.
+ */
+class AsyncFileWriter
+{
+	public:
+	///	returns the instance of the current process
+		static AsyncFileWriter& inst();
+
+	///	enables or disables asynchronous output. Disabling flushes the queue.
+		void enable(bool enable);
+
+	///	returns whether asynchronous output is enabled
+		bool enabled() const	{return m_bEnabled;}
+
+	///	sets the maximal number of buffers which are queued at the same time
+		void set_max_pending(size_t maxPending);
+
+	///	returns the maximal number of buffers which are queued at the same time
+		size_t max_pending() const	{return m_maxPending;}
+
+	///	writes the content to the given file
+	/**	If asynchronous output is enabled, the content is swapped into the
+	 * queue, i.e. 'content' is empty on return.*/
+		void write(const std::string& filename, std::string& content);
+
+	///	blocks until all queued buffers have been written
+		void flush();
+
+	private:
+		AsyncFileWriter();
+		AsyncFileWriter(const AsyncFileWriter&);
+		~AsyncFileWriter();
+
+		struct Job{
+			std::string filename;
+			std::string content;
+		};
+
+	///	main loop of the background thread
+		void run();
+
+	///	writes a buffer to disk. Returns false on failure.
+		static bool write_file(const std::string& filename,
+							   const std::string& content);
+
+	///	throws if the background thread reported an error. mutex has to be locked.
+		void check_error();
+
+	private:
+		bool				m_bEnabled;
+		size_t				m_maxPending;
+
+		std::deque<Job>		m_queue;
+		bool				m_bBusy;
+		bool				m_bStop;
+		std::string			m_error;
+
+#ifdef UG_ASYNC_IO
+		std::thread			m_thread;
+		std::mutex			m_mutex;
+		std::condition_variable	m_condWork;
+		std::condition_variable	m_condDone;
+#endif
+};
+
+///	Output file stream, which is written by the AsyncFileWriter if enabled
+/**
+ * If asynchronous output is enabled, the content is assembled in memory and
+ * passed to the AsyncFileWriter by close(). Otherwise, the content is
+ * streamed to the file directly. close() has to be called to complete the
+ * file.
+ */
+class AsyncFileStream
+{
+	public:
+	///	opens the file (or the memory buffer)
+		AsyncFileStream(const std::string& filename);
+
+	///	returns the stream to write to
+		std::ostream& stream()
+		{
+			if(m_bAsync) return m_memStream;
+			return m_fileStream;
+		}
+
+	///	writes the content (asynchronously) and closes the stream
+		void close();
+
+	private:
+		std::string			m_filename;
+		bool				m_bAsync;
+		std::ostringstream	m_memStream;
+		std::ofstream		m_fileStream;
+};
+
+// end group ugbase_common_io
+/// \}
+
+}//	end of namespace
+
+#endif
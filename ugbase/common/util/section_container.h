@@ -34,6 +34,7 @@
 #define __UTIL__SECTION_CONTAINER__
 
 #include <vector>
+#include <algorithm>
 #include "../types.h"
 
 namespace ug
@@ -125,9 +126,25 @@ class SectionContainer
 	///	takes all elements from the given section container and transfers them to this one.
 		void transfer_elements(SectionContainer& c);
 
+	///	sorts the entries of the given section
+	/**	The sort is stable. cmp has to compare two values of type TValue.
+	 * Only the order of the entries in the container is changed, the entries
+	 * stay in their section. Note that for std::list like containers all
+	 * iterators stay valid.*/
+		template <class TCompare>
+		void sort_section(int sectionIndex, TCompare cmp);
+
 	protected:
 		void add_sections(int num);
 
+	///	compares the values to which two iterators point
+		template <class TCompare>
+		struct IteratorCompare{
+			IteratorCompare(TCompare cmp) : m_cmp(cmp)	{}
+			bool operator()(const iterator& i1, const iterator& i2)	{return m_cmp(*i1, *i2);}
+			TCompare m_cmp;
+		};
+
 	protected:
 		struct Section
 		{
@@ -371,6 +371,35 @@ transfer_elements(SectionContainer& c)
 	}
 }
 
+template <class TValue, class TContainer>
+template <class TCompare>
+void
+SectionContainer<TValue, TContainer>::
+sort_section(int sectionIndex, TCompare cmp)
+{
+	if((sectionIndex < 0) || (sectionIndex >= num_sections())
+		|| (num_elements(sectionIndex) < 2))
+		return;
+
+	std::vector<iterator> vIters;
+	vIters.reserve(num_elements(sectionIndex));
+	for(iterator iter = section_begin(sectionIndex);
+		iter != section_end(sectionIndex); ++iter)
+	{
+		vIters.push_back(iter);
+	}
+
+	std::stable_sort(vIters.begin(), vIters.end(), IteratorCompare<TCompare>(cmp));
+
+//	move the entries to the end of the section in sorted order. Since insert
+//	appends to the section, the section is sorted afterwards.
+	for(size_t i = 0; i < vIters.size(); ++i){
+		TValue val = *vIters[i];
+		erase(vIters[i], sectionIndex);
+		insert(val, sectionIndex);
+	}
+}
+
 }
 
 #endif
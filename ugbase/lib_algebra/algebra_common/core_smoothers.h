@@ -34,6 +34,8 @@
 #define __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "level_schedule.h"
+
 namespace ug
 {
 
@@ -103,33 +105,38 @@ namespace ug
 * \sa gs_step_UR, sgs_step
 */
 template<typename Matrix_type, typename Vector_type>
-void gs_step_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor)
+inline void gs_row_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                      size_t i)
 {
-	// gs LL has preconditioning matrix N = (D-L)^{-1}
-
 	typedef typename Matrix_type::value_type matrix_block;
 	typedef typename Matrix_type::const_row_iterator const_row_it;
 	typename Vector_type::value_type s;
 
+	s = d[i];
+
+	//	loop over all lower left matrix entries.
+	//	Note: Here the corrections c, which have already been computed in previous loops (wrt. i),
+	//	are taken to compute the i-th correction. For example the correction of the second row
+	//	is computed by s[2] = (d[2] - A[2][1] * c[1]); and c[2] = s[2]/A[2][2];
+	const const_row_it rowEnd = A.end_row(i);
+	const_row_it it = A.begin_row(i);
+	for(; it != rowEnd && it.index() < i; ++it)
+		// s -= it.value() * c[it.index()];
+		MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+	// c[i] = relaxFactor * s/A(i,i)
+	const matrix_block& A_ii = it.index() == i ? it.value() : matrix_block(0);
+	InverseMatMult(c[i], relaxFactor, A_ii, s);
+}
+
+template<typename Matrix_type, typename Vector_type>
+void gs_step_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor)
+{
+	// gs LL has preconditioning matrix N = (D-L)^{-1}
+
 	const size_t sz = c.size();
 	for (size_t i = 0; i < sz; ++i)
-	{
-		s = d[i];
-
-		//	loop over all lower left matrix entries.
-		//	Note: Here the corrections c, which have already been computed in previous loops (wrt. i),
-		//	are taken to compute the i-th correction. For example the correction of the second row
-		//	is computed by s[2] = (d[2] - A[2][1] * c[1]); and c[2] = s[2]/A[2][2];
-		const const_row_it rowEnd = A.end_row(i);
-		const_row_it it = A.begin_row(i);
-		for(; it != rowEnd && it.index() < i; ++it)
-			// s -= it.value() * c[it.index()];
-			MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
-
-		// c[i] = relaxFactor * s/A(i,i)
-		const matrix_block& A_ii = it.index() == i ? it.value() : matrix_block(0);
-		InverseMatMult(c[i], relaxFactor, A_ii, s);
-	}
+		gs_row_LL(A, c, d, relaxFactor, i);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -146,27 +153,34 @@ void gs_step_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, cons
  * \param d the vector d.
  * \sa gs_step_LL, sgs_step
  */
+template<typename Matrix_type, typename Vector_type>
+inline void gs_row_UR(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                      size_t i)
+{
+	typename Vector_type::value_type s;
+
+	s = d[i];
+	typename Matrix_type::const_row_iterator diag = A.get_connection(i, i);
+
+	typename Matrix_type::const_row_iterator it = diag; ++it;
+	for(; it != A.end_row(i); ++it)
+		// s -= it.value() * x[it.index()];
+		MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+	// c[i] = relaxFactor * s/A(i,i)
+	InverseMatMult(c[i], relaxFactor, diag.value(), s);
+}
+
 template<typename Matrix_type, typename Vector_type>
 void gs_step_UR(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor)
 {
 	// gs UR has preconditioning matrix N = (D-U)^{-1}
 
-	typename Vector_type::value_type s;
-
 	if(c.size() == 0) return;
 	size_t i = c.size()-1;
 	do
 	{
-		s = d[i];
-		typename Matrix_type::const_row_iterator diag = A.get_connection(i, i);
-		
-		typename Matrix_type::const_row_iterator it = diag; ++it;
-		for(; it != A.end_row(i); ++it)
-			// s -= it.value() * x[it.index()];
-			MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
-
-		// c[i] = relaxFactor * s/A(i,i)
-		InverseMatMult(c[i], relaxFactor, diag.value(), s);
+		gs_row_UR(A, c, d, relaxFactor, i);
 	} while(i-- != 0);
 
 }
@@ -205,6 +219,104 @@ void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const
 	gs_step_UR(A, c, c, relaxFactor);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	level-scheduled (threaded) gauss-seidel steps
+
+///	row operation of the forward gauss-seidel step for RunLevelScheduled
+template<typename Matrix_type, typename Vector_type>
+struct GSRowLL
+{
+	GSRowLL(const Matrix_type &A_, Vector_type &c_, const Vector_type &d_, number relax_)
+		: A(A_), c(c_), d(d_), relax(relax_) {}
+	void operator()(size_t i) {gs_row_LL(A, c, d, relax, i);}
+
+	const Matrix_type &A; Vector_type &c; const Vector_type &d; number relax;
+};
+
+///	row operation of the backward gauss-seidel step for RunLevelScheduled
+template<typename Matrix_type, typename Vector_type>
+struct GSRowUR
+{
+	GSRowUR(const Matrix_type &A_, Vector_type &c_, const Vector_type &d_, number relax_)
+		: A(A_), c(c_), d(d_), relax(relax_) {}
+	void operator()(size_t i) {gs_row_UR(A, c, d, relax, i);}
+
+	const Matrix_type &A; Vector_type &c; const Vector_type &d; number relax;
+};
+
+/**
+ * \brief Performs a forward gauss-seidel-step with the rows processed level by
+ * level on AlgebraNumThreads() threads. The result is identical to gs_step_LL.
+ * \param schedule level schedule of the lower triangle of A, if it is not
+ * valid, the sequential gs_step_LL is used.
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const TriangularLevelSchedule &schedule)
+{
+	const int numThreads = AlgebraNumThreadsFor(c.size());
+	if(numThreads == 1 || !schedule.valid() || schedule.num_rows() != c.size())
+	{
+		gs_step_LL(A, c, d, relaxFactor);
+		return;
+	}
+
+	GSRowLL<Matrix_type, Vector_type> op(A, c, d, relaxFactor);
+	RunLevelScheduled(schedule, op, numThreads);
+}
+
+/**
+ * \brief Performs a backward gauss-seidel-step with the rows processed level by
+ * level on AlgebraNumThreads() threads. The result is identical to gs_step_UR.
+ * \param schedule level schedule of the upper triangle of A, if it is not
+ * valid, the sequential gs_step_UR is used.
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_UR(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const TriangularLevelSchedule &schedule)
+{
+	const int numThreads = AlgebraNumThreadsFor(c.size());
+	if(numThreads == 1 || !schedule.valid() || schedule.num_rows() != c.size())
+	{
+		gs_step_UR(A, c, d, relaxFactor);
+		return;
+	}
+
+	GSRowUR<Matrix_type, Vector_type> op(A, c, d, relaxFactor);
+	RunLevelScheduled(schedule, op, numThreads);
+}
+
+/**
+ * \brief Performs a symmetric gauss-seidel step using the level schedules of the
+ * lower and upper triangle of A. The result is identical to sgs_step.
+ */
+template<typename Matrix_type, typename Vector_type>
+void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+              const TriangularLevelSchedule &lowerSchedule, const TriangularLevelSchedule &upperSchedule)
+{
+	// c1 = (D-L)^{-1} d
+	gs_step_LL(A, c, d, relaxFactor, lowerSchedule);
+
+	// c2 = D c1
+	const int numThreads = AlgebraNumThreadsFor(c.size());
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		size_t iBegin, iEnd;
+		AlgebraThreadBlock(c.size(), AlgebraThreadNum(), numThreads, iBegin, iEnd);
+		typename Vector_type::value_type s;
+		for(size_t i = iBegin; i < iEnd; i++)
+		{
+			s=c[i];
+			MatMult(c[i], 1.0, A(i, i), s);
+		}
+	}
+
+	// c3 = (D-U)^{-1} c2
+	gs_step_UR(A, c, c, relaxFactor, upperSchedule);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 //	diag_step
 /**
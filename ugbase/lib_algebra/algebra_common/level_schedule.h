@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__LEVEL_SCHEDULE__
+#define __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__LEVEL_SCHEDULE__
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "common/error.h"
+#include "lib_algebra/cpu_algebra/algebra_threading.h"
+
+namespace ug
+{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	level schedule of the rows of a sparse triangular solve
+/**
+ * In a forward sweep (solve with the lower triangle) row i depends on all rows
+ * j < i with a_ij != 0, in a backward sweep (upper triangle) on all rows j > i
+ * with a_ij != 0. The level of a row is one more than the maximal level of the
+ * rows it depends on, so that all rows of a level are independent of each
+ * other and can be processed concurrently, once the previous levels are done.
+ * Processing the rows level by level gives exactly the same results as the
+ * sequential sweep.
+ *
+ * The schedule only depends on the sparsity pattern of the matrix. It is
+ * computed once and kept by the smoothers across applications.
+ */
+class TriangularLevelSchedule
+{
+	public:
+		TriangularLevelSchedule() : m_numRows(0) {}
+
+	///	computes the schedule for a forward sweep (lower triangle of A)
+		template <typename TMatrix>
+		void init_lower(const TMatrix& A) {init(A, true);}
+
+	///	computes the schedule for a backward sweep (upper triangle of A)
+		template <typename TMatrix>
+		void init_upper(const TMatrix& A) {init(A, false);}
+
+	///	removes the schedule, e.g. if the matrix has changed
+		void clear()
+		{
+			m_numRows = 0;
+			m_vLevelStart.clear();
+			m_vRow.clear();
+		}
+
+	///	returns if the schedule has been computed
+		bool valid() const {return !m_vLevelStart.empty();}
+
+	///	number of rows of the scheduled matrix
+		size_t num_rows() const {return m_numRows;}
+
+	///	number of levels
+		size_t num_levels() const {return m_vLevelStart.empty() ? 0 : m_vLevelStart.size() - 1;}
+
+	///	rows of level l are row(level_start(l)), ..., row(level_start(l+1)-1)
+		size_t level_start(size_t l) const {return m_vLevelStart[l];}
+
+	///	k-th row of the schedule
+		size_t row(size_t k) const {return m_vRow[k];}
+
+	private:
+		template <typename TMatrix>
+		void init(const TMatrix& A, bool bLower)
+		{
+			typedef typename TMatrix::const_row_iterator const_row_iterator;
+			const size_t n = A.num_rows();
+			clear();
+			m_numRows = n;
+
+			std::vector<size_t> vLevel(n, 0);
+			size_t numLevels = (n > 0) ? 1 : 0;
+			for(size_t k = 0; k < n; ++k)
+			{
+				const size_t i = bLower ? k : n - 1 - k;
+				size_t level = 0;
+				for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+				{
+					const size_t j = it.index();
+					if((bLower && j < i) || (!bLower && j > i))
+						level = std::max(level, vLevel[j] + 1);
+				}
+				vLevel[i] = level;
+				numLevels = std::max(numLevels, level + 1);
+			}
+
+		//	rows sorted by level, ascending inside each level
+			m_vLevelStart.assign(numLevels + 1, 0);
+			for(size_t i = 0; i < n; ++i) ++m_vLevelStart[vLevel[i] + 1];
+			for(size_t l = 0; l < numLevels; ++l) m_vLevelStart[l+1] += m_vLevelStart[l];
+
+			m_vRow.resize(n);
+			std::vector<size_t> vFill(m_vLevelStart.begin(), m_vLevelStart.end() - 1);
+			for(size_t i = 0; i < n; ++i)
+				m_vRow[vFill[vLevel[i]]++] = i;
+		}
+
+	private:
+		size_t m_numRows;
+		std::vector<size_t> m_vLevelStart;
+		std::vector<size_t> m_vRow;
+};
+
+
+///	executes op(i) for all rows of the schedule, level by level, using numThreads threads
+/**
+ * The rows of a level are distributed statically over the threads, the
+ * threads synchronize after each level.
+ */
+template <typename TRowOperation>
+void RunLevelScheduled(const TriangularLevelSchedule& schedule, TRowOperation& op, int numThreads)
+{
+	bool bError = false;
+	std::string errMsg;
+
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		for(size_t l = 0; l < schedule.num_levels(); ++l)
+		{
+			const size_t levelEnd = schedule.level_start(l+1);
+#ifdef UG_OPENMP
+			#pragma omp for schedule(static)
+#endif
+			for(size_t k = schedule.level_start(l); k < levelEnd; ++k)
+			{
+				try{
+					op(schedule.row(k));
+				}
+				catch(UGError& err){
+#ifdef UG_OPENMP
+					#pragma omp critical(RunLevelScheduled)
+#endif
+					{bError = true; errMsg = err.get_stacktrace();}
+				}
+				catch(std::exception& err){
+#ifdef UG_OPENMP
+					#pragma omp critical(RunLevelScheduled)
+#endif
+					{bError = true; errMsg = err.what();}
+				}
+			}
+		}
+	}
+
+	UG_COND_THROW(bError, "RunLevelScheduled: " << errMsg);
+}
+
+/// @}
+
+} // end namespace ug
+
+#endif // __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__LEVEL_SCHEDULE__
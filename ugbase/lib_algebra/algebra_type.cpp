@@ -57,8 +57,9 @@ AlgebraType::AlgebraType(const char* type, int blockSize)
 
 	if(sType == "CPU") m_type = CPU;
 	else if(sType == "GPU") m_type = GPU;
+	else if(sType == "CPUFloat") m_type = CPU_FLOAT;
 	else if(sType == "CRS") { UG_THROW("Type CRS is deprecated, use CPU instead."); }
-	else UG_THROW("Algebra Type '"<<sType<<"' not reconized. Available: CPU, GPU.");
+	else UG_THROW("Algebra Type '"<<sType<<"' not reconized. Available: CPU, GPU, CPUFloat.");
 }
 
 AlgebraType::AlgebraType(const char* type)
@@ -68,8 +69,9 @@ AlgebraType::AlgebraType(const char* type)
 
 	if(sType == "CPU") m_type = CPU;
 	else if(sType == "GPU") m_type = GPU;
+	else if(sType == "CPUFloat") m_type = CPU_FLOAT;
 	else if(sType == "CRS") { UG_THROW("Type CRS is deprecated, use CPU instead."); }
-	else UG_THROW("Algebra Type '"<<sType<<"' not reconized. Available: CPU, CRS.");
+	else UG_THROW("Algebra Type '"<<sType<<"' not reconized. Available: CPU, GPU, CPUFloat.");
 }
 
 
@@ -84,6 +86,7 @@ inline std::ostream& operator<<(std::ostream& out,	const AlgebraType& v)
 	{
 		case AlgebraType::CPU: out << "(CPU, " << ss.str() << ")"; break;
 		case AlgebraType::GPU: out << "(GPU, " << ss.str() << ")"; break;
+		case AlgebraType::CPU_FLOAT: out << "(CPUFloat, " << ss.str() << ")"; break;
 		default: out << "(unknown, " << ss.str() << ")";
 	}
 	return out;
@@ -52,7 +52,8 @@ class AlgebraType
 		enum Type
 		{
 			CPU = 0,
-			GPU = 1
+			GPU = 1,
+			CPU_FLOAT = 2	///< CPU algebra with single precision storage
 		};
 
 	///	indicating variable block size
@@ -41,6 +41,7 @@
 
 #include "common/progress.h"
 #include "common/util/string_util.h"
+#include "common/util/async_file_writer.h"
 
 #ifdef UG_PARALLEL
 #include "pcl/pcl.h"
@@ -404,7 +405,8 @@ void WriteVector(std::string filename, const Vector_type &b, const postype *posi
 {
 	PROFILE_FUNC_GROUP("debug");
 
-	std::fstream file(filename.c_str(), std::ios::out);
+	AsyncFileStream asyncFile(filename);
+	std::ostream& file = asyncFile.stream();
 	size_t rows = b.size();
 	WriteGridHeader(file, positions, rows, dimensions);
 
@@ -419,6 +421,8 @@ void WriteVector(std::string filename, const Vector_type &b, const postype *posi
 			file << i << " " << i << " "
 				 << std::setprecision(std::numeric_limits<number>::digits10 + 1)
 				 << b[i]-(*compareVec)[i] << std::endl;
+
+	asyncFile.close();
 }
 
 template<typename Vector_type, typename postype>
@@ -440,7 +444,8 @@ void WriteVector(std::string filename, const Matrix_type &A, const Vector_type &
 	filename = GetParallelName(A, filename);
 
 	size_t rows = A.num_rows();
-	std::fstream file(filename.c_str(), std::ios::out);
+	AsyncFileStream asyncFile(filename);
+	std::ostream& file = asyncFile.stream();
 	WriteGridHeader(file, positions, rows, dimensions);
 
 	PROGRESS_START(prog, rows, "WriteVectorToConnectionViewer " << dimensions << "d, " << A.num_rows() << "x" << A.num_rows() );
@@ -463,7 +468,10 @@ void WriteVector(std::string filename, const Matrix_type &A, const Vector_type &
 	nameValues.append(".values");
 	file << "v " << nameValues << "\n";
 
-	std::fstream fileValues(nameValues.c_str(), std::ios::out);
+	asyncFile.close();
+
+	AsyncFileStream asyncFileValues(nameValues);
+	std::ostream& fileValues = asyncFileValues.stream();
 	if(compareVec == NULL)
 	{
 		for(size_t i=0; i < rows; i++)
@@ -480,6 +488,7 @@ void WriteVector(std::string filename, const Matrix_type &A, const Vector_type &
 		}
 	}
 
+	asyncFileValues.close();
 }
 
 template<typename Matrix_type, typename Vector_type, typename postype>
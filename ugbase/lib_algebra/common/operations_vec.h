@@ -130,6 +130,76 @@ inline void VecLog(double &dest, const double &v)
 	dest = log (v);
 }
 
+// operations for floats
+//-----------------------------------------------------------------------------
+// (entries of single precision storage algebras, computations in double)
+
+//! calculates dest = alpha1*v1. for floats
+inline void VecScaleAssign(float &dest, double alpha1, const float &v1)
+{
+	dest = alpha1*v1;
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2. for floats
+inline void VecScaleAdd(float &dest, double alpha1, const float &v1, double alpha2, const float &v2)
+{
+	dest = alpha1*v1 + alpha2*v2;
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2 + alpha3*v3. for floats
+inline void VecScaleAdd(float &dest, double alpha1, const float &v1, double alpha2, const float &v2, double alpha3, const float &v3)
+{
+	dest = alpha1*v1 + alpha2*v2 + alpha3*v3;
+}
+
+//! calculates s += scal<a, b>
+inline void VecProdAdd(const float &a, const float &b, double &s)
+{
+	s += (double)a*b;
+}
+
+//! returns scal<a, b>
+inline double VecProd(const float &a, const float &b)
+{
+	return (double)a*b;
+}
+
+//! computes scal<a, b>
+inline void VecProd(const float &a, const float &b, double &s)
+{
+	s = (double)a*b;
+}
+
+//! returns norm_2^2(a)
+inline double VecNormSquared(const float &a)
+{
+	return (double)a*a;
+}
+
+//! calculates s += norm_2^2(a)
+inline void VecNormSquaredAdd(const float &a, double &s)
+{
+	s += (double)a*a;
+}
+
+//! calculates s = a * b (the Hadamard product)
+inline void VecHadamardProd(float &dest, const float &v1, const float &v2)
+{
+	dest = v1 * v2;
+}
+
+//! calculates elementwise exp
+inline void VecExp(float &dest, const float &v)
+{
+	dest = exp (v);
+}
+
+//! calculates elementwise log (natural logarithm)
+inline void VecLog(float &dest, const float &v)
+{
+	dest = log (v);
+}
+
 // templated
 
 // operations for vectors
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cmath>
+#include <iomanip>
+#include "algebra_threading.h"
+#include "common/common.h"
+#include "common/stopwatch.h"
+#include "sparsematrix.h"
+#include "vector.h"
+
+namespace ug{
+
+static int g_algebraNumThreads = 1;
+
+void SetAlgebraNumThreads(int numThreads)
+{
+	UG_COND_THROW(numThreads < 1, "SetAlgebraNumThreads: At least one thread "
+					"required, but "<<numThreads<<" passed.");
+#ifndef UG_OPENMP
+	if(numThreads > 1)
+		UG_LOG("WARNING in SetAlgebraNumThreads: ug4 is compiled without OpenMP "
+				"(cmake -DOPENMP=ON). Algebra kernels stay serial.\n");
+#endif
+	g_algebraNumThreads = numThreads;
+}
+
+int AlgebraNumThreads()
+{
+	return g_algebraNumThreads;
+}
+
+///	STREAM triad a = b + s*c on plain arrays, using the algebra thread blocks
+static void StreamTriad(std::vector<double>& a, const std::vector<double>& b,
+                        const std::vector<double>& c, double s)
+{
+	const size_t n = a.size();
+	const int numThreads = AlgebraNumThreadsFor(n);
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		size_t begin, end;
+		AlgebraThreadBlock(n, AlgebraThreadNum(), numThreads, begin, end);
+		for(size_t i = begin; i < end; ++i)
+			a[i] = b[i] + s*c[i];
+	}
+}
+
+static void PrintBandwidth(const char* name, double bytes, double seconds, double baseline)
+{
+	const double gbs = bytes / seconds * 1e-9;
+	UG_LOG(std::setw(16) << name << ": " << std::setw(10) << std::setprecision(4)
+			<< gbs << " GB/s");
+	if(baseline > 0) UG_LOG("  (" << std::setw(5) << std::setprecision(3)
+							<< 100.0*gbs/baseline << " % of STREAM triad)");
+	UG_LOG("\n");
+}
+
+void AlgebraKernelBenchmark(size_t n, size_t numRepeat)
+{
+	UG_COND_THROW(n == 0 || numRepeat == 0, "AlgebraKernelBenchmark: n and "
+					"numRepeat must be positive.");
+
+//	use a square grid for the 5-point stencil
+	const size_t m = (size_t) std::sqrt((double) n);
+	n = m*m;
+	UG_LOG("AlgebraKernelBenchmark: n = " << n << ", repeats = " << numRepeat
+			<< ", threads = " << AlgebraNumThreads() << "\n");
+
+//	STREAM baseline
+	std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+	StreamTriad(a, b, c, 3.0);
+	double t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		StreamTriad(a, b, c, 3.0);
+	const double triadTime = (get_clock_s() - t) / numRepeat;
+	const double triadGBs = 3.0*sizeof(double)*n / triadTime * 1e-9;
+	PrintBandwidth("STREAM triad", 3.0*sizeof(double)*n, triadTime, 0.0);
+
+//	vector kernels
+	Vector<double> x(n), y(n), z(n);
+	x.set(1.0); y.set(2.0); z.set(0.0);
+
+	t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		VecScaleAdd(z, 1.0, x, 3.0, y);
+	PrintBandwidth("VecScaleAdd", 3.0*sizeof(double)*n, (get_clock_s() - t) / numRepeat, triadGBs);
+
+	double dummy = 0;
+	t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		dummy += x.dotprod(y);
+	PrintBandwidth("dotprod", 2.0*sizeof(double)*n, (get_clock_s() - t) / numRepeat, triadGBs);
+
+	t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		dummy += x.norm();
+	PrintBandwidth("norm", 1.0*sizeof(double)*n, (get_clock_s() - t) / numRepeat, triadGBs);
+
+//	5-point stencil
+	SparseMatrix<double> A;
+	A.resize_and_clear(n, n);
+	for(size_t i = 0; i < m; ++i)
+		for(size_t j = 0; j < m; ++j)
+		{
+			const size_t r = i*m + j;
+			A(r, r) = 4.0;
+			if(i > 0) A(r, r-m) = -1.0;
+			if(i+1 < m) A(r, r+m) = -1.0;
+			if(j > 0) A(r, r-1) = -1.0;
+			if(j+1 < m) A(r, r+1) = -1.0;
+		}
+	A.defragment();
+
+//	values and column indices, row pointers, source and destination vector
+	const double spmvBytes = (sizeof(double) + sizeof(int)) * A.total_num_connections()
+								+ 2.0*sizeof(int)*n + 2.0*sizeof(double)*n;
+
+	A.unfreeze();
+	t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		A.apply(z, x);
+	PrintBandwidth("SpMV", spmvBytes, (get_clock_s() - t) / numRepeat, triadGBs);
+
+//	snapshots (row pointers instead of row start and end, SELL: one position per entry)
+	const double frozenBytes = spmvBytes - sizeof(int)*n;
+	const double sellBytes = spmvBytes + (sizeof(uint32) - 2.0*sizeof(int))*n
+								+ sizeof(uint32)*A.total_num_connections();
+	A.freeze(SMFF_CSR);
+	t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		A.apply(z, x);
+	PrintBandwidth("SpMV frozen CSR", frozenBytes, (get_clock_s() - t) / numRepeat, triadGBs);
+
+	A.freeze(SMFF_SELL);
+	t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		A.apply(z, x);
+	PrintBandwidth("SpMV SELL-C-s", sellBytes, (get_clock_s() - t) / numRepeat, triadGBs);
+	A.unfreeze();
+
+	t = get_clock_s();
+	for(size_t k = 0; k < numRepeat; ++k)
+		A.apply_transposed(z, x);
+	PrintBandwidth("SpMV transposed", spmvBytes + sizeof(double)*n,
+	               (get_clock_s() - t) / numRepeat, triadGBs);
+
+//	prevent the optimizer from removing the reductions
+	if(dummy == -1.0) UG_LOG("");
+}
+
+} // namespace ug
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__ALGEBRA_THREADING__
+#define __H__UG__CPU_ALGEBRA__ALGEBRA_THREADING__
+
+#include <cstddef>
+#include <vector>
+#ifdef UG_OPENMP
+#include <omp.h>
+#endif
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+///	@{
+
+///	loops shorter than this are always executed serially
+const size_t ALGEBRA_THREADING_MIN_SIZE = 16384;
+
+///	sets the number of threads used by the CPU algebra kernels
+/**
+ * The sparse matrix-vector products and the vector operations of the CPU
+ * algebra are split into contiguous blocks of rows, one per thread. The
+ * reductions (dot products, norms) sum the partial results of the blocks
+ * in a fixed order, so that the results are reproducible for a given number
+ * of threads. The default is 1 (serial). Requires compilation with OpenMP.
+ */
+void SetAlgebraNumThreads(int numThreads);
+
+///	returns the number of threads used by the CPU algebra kernels
+int AlgebraNumThreads();
+
+///	returns the number of threads to use for a loop of length n
+inline int AlgebraNumThreadsFor(size_t n)
+{
+#ifdef UG_OPENMP
+	if(n < ALGEBRA_THREADING_MIN_SIZE) return 1;
+	return AlgebraNumThreads();
+#else
+	return 1;
+#endif
+}
+
+///	returns the index of the calling thread inside a threaded algebra kernel
+inline int AlgebraThreadNum()
+{
+#ifdef UG_OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+///	computes the block [begin, end) of thread t, when [0, n) is split into numThreads blocks
+inline void AlgebraThreadBlock(size_t n, int t, int numThreads, size_t& begin, size_t& end)
+{
+	begin = (n * t) / numThreads;
+	end = (n * (t+1)) / numThreads;
+}
+
+///	sums partial results in the order of the threads (deterministic reduction)
+inline double AlgebraSumPartials(const std::vector<double>& vPartial)
+{
+	double sum = 0;
+	for(size_t t = 0; t < vPartial.size(); ++t)
+		sum += vPartial[t];
+	return sum;
+}
+
+///	benchmarks the algebra kernels for the current number of threads
+/**
+ * Measures the memory bandwidth (in GB/s) of a STREAM-like triad on plain
+ * arrays (baseline), and of the VecScaleAdd, dot product, norm and SpMV
+ * (5-point stencil) kernels of the CPU algebra and prints the results.
+ *
+ * \param[in]	n			number of unknowns
+ * \param[in]	numRepeat	number of repetitions per kernel
+ */
+void AlgebraKernelBenchmark(size_t n, size_t numRepeat);
+
+// end group cpu_algebra
+/// \}
+
+} // namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__ALGEBRA_THREADING__ */
@@ -38,11 +38,14 @@
 #include "../algebra_common/sparsematrix_util.h"
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include "common/util/ostream_util.h"
 
 #include "../algebra_common/connection.h"
 #include "../algebra_common/matrixrow.h"
 #include "../common/operations_mat/operations_mat.h"
+#include "algebra_threading.h"
+#include "sparsematrix_frozen.h"
 
 #define PROFILE_SPMATRIX(name) PROFILE_BEGIN_GROUP(name, "SparseMatrix algebra")
 
@@ -82,6 +85,13 @@ namespace ug{
 // cols : 2 3 5 6 | 2 3 6 7 | 8 9 10
 
 
+//! returns a new structure stamp, unique among all sparse matrices of the process
+inline size_t NewSparseMatrixStructureStamp()
+{
+	static std::atomic<size_t> s_lastStamp(0);
+	return ++s_lastStamp;
+}
+
 /** SparseMatrix
  *  \brief sparse matrix for big, variable sparse matrices.
  *
@@ -162,6 +172,16 @@ public:
 			const number &alpha1, const vector_t &v1,
 			const number &beta1, const vector_t &w1) const;
 
+	//! calculate dest = alpha1*v1 + beta1*A*w1 for the rows of some ranges only
+	/** vRange holds the ranges [begin, end) as begin, end, begin, end, ...
+	 * The rows are split among the algebra threads as in axpy, and the
+	 * snapshot is used if it is in CSR format.*/
+	template<typename vector_t>
+	void axpy_row_ranges(vector_t &dest,
+			const number &alpha1, const vector_t &v1,
+			const number &beta1, const vector_t &w1,
+			const std::vector<size_t>& vRange) const;
+
 	//! calculate dest = alpha1*v1 + beta1*A^T*w1 (A = this matrix)
 	template<typename vector_t>
 	void axpy_transposed(vector_t &dest,
@@ -218,6 +238,26 @@ public:
 	void scale(double d);
 	SparseMatrix<value_type> &operator *= (double d) { scale(d); return *this; }
 
+	// snapshot for the solve phase
+	//-------------------------------
+
+	/**
+	 * \brief builds an index snapshot of the matrix that is used by axpy
+	 * The matrix is defragmented and the snapshot (see FrozenSparseMatrix)
+	 * stores only the positions of the entries, the values are read from the
+	 * matrix. Thus, values may be changed freely, the snapshot is only dropped
+	 * when the sparsity pattern changes (new connections, resize, clear).
+	 * Snapshots are never built automatically, see FreezeMatrixForSolve.
+	 * \param format	SMFF_CSR or SMFF_SELL
+	 */
+	void freeze(int format = SMFF_CSR);
+
+	//! removes the snapshot
+	void unfreeze() { invalidate_frozen(); }
+
+	//! returns the format of the current snapshot (SMFF_NONE if there is none)
+	int frozen_format() const { return m_frozen.format(); }
+
 	// submatrix set/get functions
 	//-------------------------------
 
@@ -347,6 +387,35 @@ public:
 	//! returns the total number of connections
 	size_t total_num_connections() const { return nnz; }
 
+	//! returns a stamp of the sparsity pattern
+	/** The stamp changes whenever connections are added or removed, and it
+	 * is unique among all matrices. Equal stamps therefore mean the same
+	 * pattern of the same matrix, e.g. for reusing symbolic factorizations.
+	 * Changing values only (clear_retain_structure, set, scale, ...) and
+	 * defragment() keep the stamp.*/
+	size_t structure_stamp() const
+	{
+		if(m_structureStamp == 0) m_structureStamp = NewSparseMatrixStructureStamp();
+		return m_structureStamp;
+	}
+
+	//! marks the matrix as sized for revision 'revision' of the index set 'pSource'
+	/** The mark is dropped by resize_and_clear, resize_and_keep_values and
+	 * clear_and_free, but not by adding connections. It is used by the
+	 * assembling to detect that the sparsity pattern has been built for the
+	 * same indices before (see AssemblingTuner::set_matrix_structure_caching).*/
+	void set_index_revision(const void* pSource, uint64 revision)
+	{
+		m_pIndexSource = pSource;
+		m_indexRevision = revision;
+	}
+
+	//! returns if the matrix has been marked for this revision of the index set
+	bool has_index_revision(const void* pSource, uint64 revision) const
+	{
+		return pSource != NULL && m_pIndexSource == pSource && m_indexRevision == revision;
+	}
+
 public:
 
 	// Iterators
@@ -703,12 +772,39 @@ private:
     void assureValuesSize(size_t s);
     size_t get_nnz() const { return nnz; }
 
+	//! drops the snapshot, called by all functions that change the sparsity pattern
+	void invalidate_frozen()
+	{
+		if(m_frozen.valid()) m_frozen.clear();
+	}
+
 private:
 	// disallowed operations (not defined):
 	//---------------------------------------
 	SparseMatrix(SparseMatrix&); ///< disallow copy operator
 
 
+protected:
+	//! calculate dest = alpha1*v1 + beta1*A*w1 for the rows [iBegin, iEnd)
+	template<typename vector_t>
+	void axpy_rows(vector_t &dest,
+			const number &alpha1, const vector_t &v1,
+			const number &beta1, const vector_t &w1,
+			size_t iBegin, size_t iEnd) const;
+
+	//! calculate dest = alpha1*v1 + beta1*A*w1 for the rows [first, last) of the concatenated ranges
+	template<typename vector_t>
+	void axpy_row_ranges_part(vector_t &dest,
+			const number &alpha1, const vector_t &v1,
+			const number &beta1, const vector_t &w1,
+			const std::vector<size_t>& vRange, size_t first, size_t last) const;
+
+	//! calculate dest += beta1*A[iBegin:iEnd, .]^T*w1[iBegin:iEnd]
+	template<typename vector_t, typename dest_t>
+	void axpy_transposed_rows(dest_t &dest,
+			const number &beta1, const vector_t &w1,
+			size_t iBegin, size_t iEnd) const;
+
 protected:
 	int get_index_internal(size_t row, int col) const;
     int get_index_const(int r, int c) const;
@@ -747,6 +843,11 @@ protected:
     int m_numCols;
     mutable int iIterators;
 
+    FrozenSparseMatrix<value_type> m_frozen; ///< index snapshot for the solve phase
+    mutable size_t m_structureStamp; ///< stamp of the sparsity pattern, 0 if not yet drawn
+    const void* m_pIndexSource; ///< index set the matrix has been sized for (see set_index_revision)
+    uint64 m_indexRevision; ///< revision of that index set
+
 #ifdef CHECK_ROW_ITERATORS
 public:
     mutable std::vector<int> nrOfRowIterators;
@@ -771,6 +872,13 @@ inline void MatMultTransposedAdd(vector_t &dest,
 	A1.axpy_transposed(dest, alpha1, v1, beta1, w1);
 }
 
+//! builds the snapshot in the format set by SetSparseMatrixFreezeFormat (if any)
+template<typename T>
+inline void FreezeMatrixForSolve(SparseMatrix<T> &A)
+{
+	if(GetSparseMatrixFreezeFormat() != SMFF_NONE)
+		A.freeze(GetSparseMatrixFreezeFormat());
+}
 
 
 
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__SPARSEMATRIX_FROZEN__
+#define __H__UG__CPU_ALGEBRA__SPARSEMATRIX_FROZEN__
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "common/types.h"
+#include "common/assert.h"
+#include "algebra_threading.h"
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+///	@{
+
+///	formats of the index snapshot used by SparseMatrix::axpy
+enum SparseMatrixFreezeFormat
+{
+	SMFF_NONE = 0,	///< never build a snapshot, always use the flexible layout
+	SMFF_CSR = 1,	///< compressed row storage with 32-bit indices
+	SMFF_SELL = 2	///< SELL-C-sigma (sliced ELLPACK, rows sorted by length)
+};
+
+///	sets the format of the snapshots built when a solver is initialized
+/**
+ * If set, the linear solvers call FreezeMatrixForSolve on their operator
+ * in init, which builds a snapshot of the matrix in this format. Valid
+ * formats are "none" (default), "csr" and "sell".
+ */
+void SetSparseMatrixFreezeFormat(const std::string& format);
+
+///	returns the format set by SetSparseMatrixFreezeFormat (SparseMatrixFreezeFormat)
+int GetSparseMatrixFreezeFormat();
+
+
+///	index snapshot of a defragmented SparseMatrix for the solve phase
+/**
+ * The snapshot stores only the positions of the entries of a defragmented
+ * SparseMatrix, the columns and values are read from the arrays of the matrix.
+ * Thus, the values of the matrix may be changed while the snapshot is in use,
+ * only the sparsity pattern must not change.
+ *
+ * In CSR format the row pointers are stored with 32-bit indices. In the
+ * SELL-C-sigma format the rows are grouped in chunks of SELL_C rows, whose
+ * entry positions are stored column-wise and padded to the longest row of the
+ * chunk. Inside windows of SELL_SIGMA rows the rows are sorted by decreasing
+ * length before chunking, so that little padding is needed.
+ *
+ * The entries of every row are summed up in the same order as in the
+ * flexible layout, so that the products are identical.
+ */
+template<typename TValueType>
+class FrozenSparseMatrix
+{
+	public:
+		typedef TValueType value_type;
+
+		enum {SELL_C = 8, SELL_SIGMA = 256};
+
+	public:
+		FrozenSparseMatrix() : m_format(SMFF_NONE), m_numRows(0) {}
+
+	///	returns if a snapshot is present
+		bool valid() const {return m_format != SMFF_NONE;}
+
+	///	returns the format of the snapshot
+		int format() const {return m_format;}
+
+	///	removes the snapshot and frees the memory
+		void clear();
+
+	///	builds the snapshot from the rows of a defragmented SparseMatrix
+		void init(int format, size_t numRows,
+		          const std::vector<int>& rowStart, const std::vector<int>& rowEnd);
+
+	///	calculate dest = alpha1*v1 + beta1*A*w1 with the entries pCol, pValue of A
+		template<typename vector_t>
+		void axpy(vector_t &dest,
+				const number &alpha1, const vector_t &v1,
+				const number &beta1, const vector_t &w1,
+				const int* pCol, const value_type* pValue) const;
+
+	///	calculate dest = alpha1*v1 + beta1*A*w1 for the rows [rowBegin, rowEnd), CSR only
+		template<typename vector_t>
+		void axpy_rows(vector_t &dest,
+				const number &alpha1, const vector_t &v1,
+				const number &beta1, const vector_t &w1,
+				const int* pCol, const value_type* pValue,
+				size_t rowBegin, size_t rowEnd) const
+		{
+			UG_ASSERT(m_format == SMFF_CSR, "row ranges need a CSR snapshot");
+			axpy_csr(dest, alpha1, v1, beta1, w1, pCol, pValue, rowBegin, rowEnd);
+		}
+
+	protected:
+	///	sets dest[row] = alpha1*v1[row] (or scales it, if dest == v1)
+		template<typename vector_t>
+		inline void init_row(size_t row, vector_t &dest,
+				const number &alpha1, const vector_t &v1) const;
+
+		template<typename vector_t>
+		void axpy_csr(vector_t &dest,
+				const number &alpha1, const vector_t &v1,
+				const number &beta1, const vector_t &w1,
+				const int* pCol, const value_type* pValue,
+				size_t rowBegin, size_t rowEnd) const;
+
+		template<typename vector_t>
+		void axpy_sell(vector_t &dest,
+				const number &alpha1, const vector_t &v1,
+				const number &beta1, const vector_t &w1,
+				const int* pCol, const value_type* pValue,
+				size_t chunkBegin, size_t chunkEnd) const;
+
+		size_t num_chunks() const {return m_vChunkStart.size() - 1;}
+
+	protected:
+		int m_format;
+		size_t m_numRows;
+
+	//	CSR: row i is [m_vRowPtr[i], m_vRowPtr[i+1])
+	//	SELL: the position of entry j of slot l in chunk k is stored at
+	//	m_vPos[m_vChunkStart[k] + j*SELL_C + l]
+		std::vector<uint32> m_vRowPtr;
+		std::vector<uint32> m_vPos;
+
+	//	SELL only: row of a slot, length of the row of a slot, chunk offsets
+		std::vector<uint32> m_vSlotRow;
+		std::vector<uint32> m_vSlotLen;
+		std::vector<size_t> m_vChunkStart;
+};
+
+// end group cpu_algebra
+/// \}
+
+} // namespace ug
+
+#include "sparsematrix_frozen_impl.h"
+
+#endif /* __H__UG__CPU_ALGEBRA__SPARSEMATRIX_FROZEN__ */
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__SPARSEMATRIX_FROZEN_IMPL__
+#define __H__UG__CPU_ALGEBRA__SPARSEMATRIX_FROZEN_IMPL__
+
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/common/operations_vec.h"
+
+namespace ug{
+
+template<typename T>
+void FrozenSparseMatrix<T>::clear()
+{
+	m_format = SMFF_NONE;
+	m_numRows = 0;
+	std::vector<uint32>().swap(m_vRowPtr);
+	std::vector<uint32>().swap(m_vPos);
+	std::vector<uint32>().swap(m_vSlotRow);
+	std::vector<uint32>().swap(m_vSlotLen);
+	std::vector<size_t>().swap(m_vChunkStart);
+}
+
+///	sorts rows by decreasing length, ties by row index
+struct FrozenRowLengthCompare
+{
+	FrozenRowLengthCompare(const std::vector<uint32>& vLen) : m_vLen(vLen) {}
+	bool operator()(uint32 a, uint32 b) const
+	{
+		if(m_vLen[a] != m_vLen[b]) return m_vLen[a] > m_vLen[b];
+		return a < b;
+	}
+	const std::vector<uint32>& m_vLen;
+};
+
+template<typename T>
+void FrozenSparseMatrix<T>::init(int format, size_t numRows,
+		const std::vector<int>& rowStart, const std::vector<int>& rowEnd)
+{
+	PROFILE_BEGIN_GROUP(FrozenSparseMatrix_init, "SparseMatrix algebra");
+	clear();
+	if(format == SMFF_NONE) return;
+	UG_COND_THROW(format != SMFF_CSR && format != SMFF_SELL,
+				  "FrozenSparseMatrix: unknown format " << format);
+
+	std::vector<uint32> vLen(numRows);
+	size_t nnz = 0;
+	for(size_t i = 0; i < numRows; ++i)
+	{
+		vLen[i] = (rowStart[i] == -1) ? 0 : rowEnd[i] - rowStart[i];
+		nnz += vLen[i];
+	}
+	UG_COND_THROW(nnz > (size_t) 0xffffffff,
+				  "FrozenSparseMatrix: too many entries for 32-bit indices.");
+
+	m_numRows = numRows;
+	m_format = format;
+
+	if(format == SMFF_CSR)
+	{
+		m_vRowPtr.resize(numRows+1);
+		for(size_t i = 0; i < numRows; ++i)
+			m_vRowPtr[i] = (rowStart[i] == -1) ? rowEnd[i] : rowStart[i];
+		m_vRowPtr[numRows] = m_vRowPtr[numRows-1] + vLen[numRows-1];
+		return;
+	}
+
+//	SELL-C-sigma: sort rows by length inside windows of SELL_SIGMA rows
+	m_vSlotRow.resize(numRows);
+	for(size_t i = 0; i < numRows; ++i) m_vSlotRow[i] = i;
+	for(size_t w = 0; w < numRows; w += SELL_SIGMA)
+		std::sort(m_vSlotRow.begin() + w,
+		          m_vSlotRow.begin() + std::min(w + SELL_SIGMA, numRows),
+		          FrozenRowLengthCompare(vLen));
+
+	const size_t numChunks = (numRows + SELL_C - 1) / SELL_C;
+	m_vSlotLen.resize(numChunks * SELL_C, 0);
+	m_vChunkStart.resize(numChunks+1);
+	size_t size = 0;
+	for(size_t k = 0; k < numChunks; ++k)
+	{
+		m_vChunkStart[k] = size;
+		uint32 width = 0;
+		for(size_t l = 0; l < SELL_C && k*SELL_C + l < numRows; ++l)
+		{
+			const size_t slot = k*SELL_C + l;
+			m_vSlotLen[slot] = vLen[m_vSlotRow[slot]];
+			width = std::max(width, m_vSlotLen[slot]);
+		}
+		size += width * SELL_C;
+	}
+	m_vChunkStart[numChunks] = size;
+
+//	padding entries are never read, since the loops stop at the row length
+	m_vPos.resize(size, 0);
+	for(size_t k = 0; k < numChunks; ++k)
+		for(size_t l = 0; l < SELL_C && k*SELL_C + l < numRows; ++l)
+		{
+			const size_t slot = k*SELL_C + l;
+			const size_t row = m_vSlotRow[slot];
+			for(uint32 j = 0; j < m_vSlotLen[slot]; ++j)
+			{
+				m_vPos[m_vChunkStart[k] + j*SELL_C + l] = rowStart[row]+j;
+			}
+		}
+}
+
+template<typename T>
+template<typename vector_t>
+inline void FrozenSparseMatrix<T>::init_row(size_t row, vector_t &dest,
+		const number &alpha1, const vector_t &v1) const
+{
+	if(alpha1 == 0.0)
+		dest[row] = 0.0;
+	else if(&dest == &v1)
+	{
+		if(alpha1 != 1.0) dest[row] *= alpha1;
+	}
+	else
+		VecScaleAssign(dest[row], alpha1, v1[row]);
+}
+
+template<typename T>
+template<typename vector_t>
+void FrozenSparseMatrix<T>::axpy(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1,
+		const int* pCol, const value_type* pValue) const
+{
+	UG_ASSERT(valid(), "no snapshot present");
+	const size_t numItems = (m_format == SMFF_CSR) ? m_numRows : num_chunks();
+	const int numThreads = AlgebraNumThreadsFor(m_numRows);
+	if(numThreads == 1)
+	{
+		if(m_format == SMFF_CSR)
+			axpy_csr(dest, alpha1, v1, beta1, w1, pCol, pValue, 0, numItems);
+		else
+			axpy_sell(dest, alpha1, v1, beta1, w1, pCol, pValue, 0, numItems);
+		return;
+	}
+
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		size_t begin, end;
+		AlgebraThreadBlock(numItems, AlgebraThreadNum(), numThreads, begin, end);
+		if(m_format == SMFF_CSR)
+			axpy_csr(dest, alpha1, v1, beta1, w1, pCol, pValue, begin, end);
+		else
+			axpy_sell(dest, alpha1, v1, beta1, w1, pCol, pValue, begin, end);
+	}
+}
+
+template<typename T>
+template<typename vector_t>
+void FrozenSparseMatrix<T>::axpy_csr(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1,
+		const int* pCol, const value_type* pValue,
+		size_t rowBegin, size_t rowEnd) const
+{
+	typedef typename vector_t::value_type vec_value_type;
+	for(size_t i = rowBegin; i < rowEnd; ++i)
+	{
+		size_t k = m_vRowPtr[i];
+		const size_t itEnd = m_vRowPtr[i+1];
+		if(alpha1 == 0.0 && k != itEnd)
+		{
+			vec_value_type acc;
+			MatMult(acc, beta1, pValue[k], w1[pCol[k]]);
+			for(++k; k < itEnd; ++k)
+				MatMultAdd(acc, 1.0, acc, beta1, pValue[k], w1[pCol[k]]);
+			dest[i] = acc;
+		}
+		else
+		{
+			init_row(i, dest, alpha1, v1);
+			for(; k < itEnd; ++k)
+				MatMultAdd(dest[i], 1.0, dest[i], beta1, pValue[k], w1[pCol[k]]);
+		}
+	}
+}
+
+template<typename T>
+template<typename vector_t>
+void FrozenSparseMatrix<T>::axpy_sell(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1,
+		const int* pCol, const value_type* pValue,
+		size_t chunkBegin, size_t chunkEnd) const
+{
+	typedef typename vector_t::value_type vec_value_type;
+	vec_value_type acc[SELL_C];
+
+	for(size_t k = chunkBegin; k < chunkEnd; ++k)
+	{
+		const size_t slotBegin = k*SELL_C;
+		const size_t numSlots = std::min((size_t) SELL_C, m_numRows - slotBegin);
+		const uint32* pRow = &m_vSlotRow[slotBegin];
+		const uint32* pLen = &m_vSlotLen[slotBegin];
+		size_t pos = m_vChunkStart[k];
+		uint32 j = 0;
+
+	//	accumulate the rows of the chunk locally
+		if(alpha1 == 0.0 && pLen[0] > 0)
+		{
+			for(size_t l = 0; l < numSlots; ++l)
+				if(pLen[l] > 0)
+				{
+					const uint32 p = m_vPos[pos+l];
+					MatMult(acc[l], beta1, pValue[p], w1[pCol[p]]);
+				}
+				else
+					acc[l] = 0.0;
+			++j; pos += SELL_C;
+		}
+		else
+			for(size_t l = 0; l < numSlots; ++l)
+			{
+				init_row(pRow[l], dest, alpha1, v1);
+				acc[l] = dest[pRow[l]];
+			}
+
+	//	the rows are sorted by decreasing length, so the slots that still
+	//	have entries in column j of the chunk are [0, numActive)
+		const uint32 width = pLen[0];
+		size_t numActive = numSlots;
+		for(; j < width; ++j, pos += SELL_C)
+		{
+			while(pLen[numActive-1] <= j) --numActive;
+			const uint32* pPos = &m_vPos[pos];
+			for(size_t l = 0; l < numActive; ++l)
+				MatMultAdd(acc[l], 1.0, acc[l], beta1, pValue[pPos[l]], w1[pCol[pPos[l]]]);
+		}
+
+		for(size_t l = 0; l < numSlots; ++l)
+			dest[pRow[l]] = acc[l];
+	}
+}
+
+} // namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__SPARSEMATRIX_FROZEN_IMPL__ */
@@ -61,6 +61,9 @@ SparseMatrix<T>::SparseMatrix()
 	PROFILE_SPMATRIX(SparseMatrix_constructor);
 	bNeedsValues = true;
 	iIterators=0;
+	m_structureStamp = 0;
+	m_pIndexSource = NULL;
+	m_indexRevision = 0;
 	nnz = 0;
 	m_numCols = 0;
 	maxValues = 0;
@@ -71,6 +74,9 @@ SparseMatrix<T>::SparseMatrix()
 template<typename T>
 void SparseMatrix<T>::clear_and_free()
 {
+	invalidate_frozen();
+	m_structureStamp = 0;
+	m_pIndexSource = NULL;
 	std::vector<int>().swap(rowStart);
 	std::vector<int>().swap(rowMax);
 	std::vector<int>().swap(rowEnd);
@@ -91,6 +97,9 @@ template<typename T>
 void SparseMatrix<T>::resize_and_clear(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_clear);
+	invalidate_frozen();
+	m_structureStamp = 0;
+	m_pIndexSource = NULL;
 	rowStart.clear(); rowStart.resize(newRows+1, -1);
 	rowMax.clear(); rowMax.resize(newRows);
 	rowEnd.clear(); rowEnd.resize(newRows, -1);
@@ -112,6 +121,9 @@ template<typename T>
 void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_keep_values);
+	invalidate_frozen();
+	m_structureStamp = 0;
+	m_pIndexSource = NULL;
 	//UG_LOG("SparseMatrix resize " << newRows << "x" << newCols << "\n");
 	if(newRows == 0 && newCols == 0)
 		return resize_and_clear(0,0);
@@ -296,10 +308,123 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 		const number &beta1, const vector_t &w1) const
 {
 	PROFILE_SPMATRIX(SparseMatrix_axpy);
+
+//	use the snapshot, if one has been built by freeze
+	if(m_frozen.valid())
+	{
+		m_frozen.axpy(dest, alpha1, v1, beta1, w1,
+		              cols.empty() ? NULL : &cols[0], values.empty() ? NULL : &values[0]);
+		return;
+	}
+
 	check_fragmentation();
+
+	const int numThreads = AlgebraNumThreadsFor(num_rows());
+	if(numThreads == 1)
+	{
+		axpy_rows(dest, alpha1, v1, beta1, w1, 0, num_rows());
+		return;
+	}
+
+//	rows are split into contiguous blocks, no thread writes to another block
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		size_t iBegin, iEnd;
+		AlgebraThreadBlock(num_rows(), AlgebraThreadNum(), numThreads, iBegin, iEnd);
+		axpy_rows(dest, alpha1, v1, beta1, w1, iBegin, iEnd);
+	}
+}
+
+// calculate dest = alpha1*v1 + beta1*A*w1 for the rows of the ranges in vRange
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::axpy_row_ranges(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1,
+		const std::vector<size_t>& vRange) const
+{
+	PROFILE_SPMATRIX(SparseMatrix_axpy_row_ranges);
+	if(!m_frozen.valid()) check_fragmentation();
+
+	size_t numRows = 0;
+	for(size_t r = 0; r + 1 < vRange.size(); r += 2)
+		numRows += vRange[r+1] - vRange[r];
+
+	const int numThreads = AlgebraNumThreadsFor(numRows);
+	if(numThreads == 1)
+	{
+		axpy_row_ranges_part(dest, alpha1, v1, beta1, w1, vRange, 0, numRows);
+		return;
+	}
+
+//	the rows of all ranges are split into contiguous blocks
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		size_t first, last;
+		AlgebraThreadBlock(numRows, AlgebraThreadNum(), numThreads, first, last);
+		axpy_row_ranges_part(dest, alpha1, v1, beta1, w1, vRange, first, last);
+	}
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::axpy_row_ranges_part(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1,
+		const std::vector<size_t>& vRange, size_t first, size_t last) const
+{
+	const bool bCSR = (m_frozen.format() == SMFF_CSR);
+	size_t offset = 0;
+	for(size_t r = 0; r + 1 < vRange.size() && offset < last; r += 2)
+	{
+		const size_t size = vRange[r+1] - vRange[r];
+	//	part of the range in [first, last)
+		const size_t b = std::max(first, offset), e = std::min(last, offset + size);
+		if(b < e)
+		{
+			const size_t iBegin = vRange[r] + (b - offset), iEnd = vRange[r] + (e - offset);
+			if(bCSR)
+				m_frozen.axpy_rows(dest, alpha1, v1, beta1, w1,
+				                   cols.empty() ? NULL : &cols[0], values.empty() ? NULL : &values[0],
+				                   iBegin, iEnd);
+			else
+				axpy_rows(dest, alpha1, v1, beta1, w1, iBegin, iEnd);
+		}
+		offset += size;
+	}
+}
+
+template<typename T>
+void SparseMatrix<T>::freeze(int format)
+{
+	PROFILE_SPMATRIX(SparseMatrix_freeze);
+	invalidate_frozen();
+	if(!bNeedsValues || format == SMFF_NONE || num_rows() == 0) return;
+
+//	the snapshot stores positions, the rows have to be contiguous
+	defragment();
+	if(rowStart[0] != 0) return;
+	for(size_t i = 0; i+1 < num_rows(); ++i)
+		if(rowEnd[i] != rowStart[i+1]) return;
+	if(rowEnd[num_rows()-1] != (int) nnz) return;
+
+	m_frozen.init(format, num_rows(), rowStart, rowEnd);
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::axpy_rows(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1,
+		size_t iBegin, size_t iEnd) const
+{
 	if(alpha1 == 0.0)
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		for(size_t i=iBegin; i < iEnd; i++)
 		{
 			size_t rowIt=rowStart[i];
 			size_t itEnd=rowEnd[i];
@@ -317,20 +442,20 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	else if(&dest == &v1)
 	{
 		if(alpha1 != 1.0) {
-			for(size_t i=0; i < num_rows(); i++)
+			for(size_t i=iBegin; i < iEnd; i++)
 			{
 				dest[i] *= alpha1;
 				mat_mult_add_row(i, dest[i], beta1, w1);
 			}
 		}
 		else
-			for(size_t i=0; i < num_rows(); i++)
+			for(size_t i=iBegin; i < iEnd; i++)
 				mat_mult_add_row(i, dest[i], beta1, w1);
 
 	}
 	else
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		for(size_t i=iBegin; i < iEnd; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			mat_mult_add_row(i, dest[i], beta1, w1);
@@ -358,7 +483,52 @@ void SparseMatrix<T>::axpy_transposed(vector_t &dest,
 	else
 		VecScaleAssign(dest, alpha1, v1);
 
-	for(size_t i=0; i<num_rows(); i++)
+	const int numThreads = AlgebraNumThreadsFor(num_rows());
+	if(numThreads == 1)
+	{
+		axpy_transposed_rows(dest, beta1, w1, 0, num_rows());
+		return;
+	}
+
+//	every thread scatters its block of rows into a private buffer, the
+//	buffers are added to dest in the order of the threads afterwards
+	typedef std::vector<typename vector_t::value_type> buffer_type;
+	std::vector<buffer_type> vBuffer(numThreads);
+	const size_t numCols = dest.size();
+
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		const int t = AlgebraThreadNum();
+		buffer_type& buffer = vBuffer[t];
+		buffer.resize(numCols);
+		for(size_t j = 0; j < numCols; ++j)
+			VecScaleAssign(buffer[j], 0.0, dest[j]);
+
+		size_t iBegin, iEnd;
+		AlgebraThreadBlock(num_rows(), t, numThreads, iBegin, iEnd);
+		axpy_transposed_rows(buffer, beta1, w1, iBegin, iEnd);
+
+	#ifdef UG_OPENMP
+		#pragma omp barrier
+	#endif
+
+		size_t colBegin, colEnd;
+		AlgebraThreadBlock(numCols, t, numThreads, colBegin, colEnd);
+		for(int k = 0; k < numThreads; ++k)
+			for(size_t j = colBegin; j < colEnd; ++j)
+				dest[j] += vBuffer[k][j];
+	}
+}
+
+template<typename T>
+template<typename vector_t, typename dest_t>
+void SparseMatrix<T>::axpy_transposed_rows(dest_t &dest,
+		const number &beta1, const vector_t &w1,
+		size_t iBegin, size_t iEnd) const
+{
+	for(size_t i=iBegin; i<iEnd; i++)
 	{
 
 		size_t itEnd=rowEnd[i];
@@ -600,6 +770,8 @@ int SparseMatrix<T>::get_index(int r, int c)
 	if(rowStart[r] == -1 || rowStart[r] == rowEnd[r])
 	{
 //		UG_LOG("new row\n");
+		m_structureStamp = 0;
+		invalidate_frozen();
 		// row did not start, start new row at the end of cols array
 		assureValuesSize(maxValues+1);
 		rowStart[r] = maxValues;
@@ -629,6 +801,8 @@ int SparseMatrix<T>::get_index(int r, int c)
 	// we did not find it, so we have to add it
 
 	check_row_modifiable(r);
+	m_structureStamp = 0;
+	invalidate_frozen();
 
 #ifndef NDEBUG
 	assert(index == rowEnd[r] || cols[index] > c);
@@ -703,6 +877,8 @@ template<typename T>
 void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 {
 	PROFILE_SPMATRIX(SparseMatrix_copyToNewSize);
+//	the entries are moved, the positions in the snapshot become invalid
+	invalidate_frozen();
 	/*UG_LOG("copyToNewSize: from " << values.size()  << " to " << newSize << "\n");
 	UG_LOG("sizes are " << cols.size() << " and " << values.size() << ", ");
 	UG_LOG(reset_floats << "capacities are " << cols.capacity() << " and " << values.capacity() << ", NNZ = " << nnz << ", fragmentation = " <<
@@ -39,6 +39,7 @@
 #include "algebra_misc.h"
 #include "common/math/ugmath.h"
 #include "vector.h" // for urand
+#include "algebra_threading.h"
 
 #define prefetchReadWrite(a)
 
@@ -73,15 +74,39 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 {
 	UG_ASSERT(m_size == w.m_size,  *this << " has not same size as " << w);
 
-	double sum=0;
-	for(size_t i=0; i<m_size; i++)	sum += VecProd(values[i], w[i]);
-	return sum;
+	const int numThreads = AlgebraNumThreadsFor(m_size);
+	if(numThreads == 1)
+	{
+		double sum=0;
+		for(size_t i=0; i<m_size; i++)	sum += VecProd(values[i], w[i]);
+		return sum;
+	}
+
+//	partial sums are combined in thread order, so that the result does not
+//	depend on the scheduling
+	std::vector<double> vPartial(numThreads, 0.0);
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		const int t = AlgebraThreadNum();
+		size_t iBegin, iEnd;
+		AlgebraThreadBlock(m_size, t, numThreads, iBegin, iEnd);
+		double sum=0;
+		for(size_t i=iBegin; i<iEnd; i++)	sum += VecProd(values[i], w[i]);
+		vPartial[t] = sum;
+	}
+	return AlgebraSumPartials(vPartial);
 }
 
 // assign double to whole Vector
 template<typename value_type>
 inline double Vector<value_type>::operator = (double d)
 {
+#ifdef UG_OPENMP
+	const int numThreads = AlgebraNumThreadsFor(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = d;
 	return d;
@@ -100,6 +125,10 @@ template<typename value_type>
 inline void Vector<value_type>::operator = (const vector_type &v)
 {
 	resize(v.size());
+#ifdef UG_OPENMP
+	const int numThreads = AlgebraNumThreadsFor(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v[i];
 }
@@ -108,6 +137,10 @@ template<typename value_type>
 inline void Vector<value_type>::operator += (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+#ifdef UG_OPENMP
+	const int numThreads = AlgebraNumThreadsFor(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] += v[i];
 }
@@ -116,6 +149,10 @@ template<typename value_type>
 inline void Vector<value_type>::operator -= (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+#ifdef UG_OPENMP
+	const int numThreads = AlgebraNumThreadsFor(m_size);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] -= v[i];
 }
@@ -322,19 +359,104 @@ double operator *(const TRANSPOSED<Vector<value_type> > &x, const Vector<value_t
 template<typename value_type>
 inline double Vector<value_type>::norm() const
 {
-	double d=0;
-	for(size_t i=0; i<size(); ++i)
-		d+=BlockNorm2(values[i]);
-	return sqrt(d);
+	const int numThreads = AlgebraNumThreadsFor(m_size);
+	if(numThreads == 1)
+	{
+		double d=0;
+		for(size_t i=0; i<size(); ++i)
+			d+=BlockNorm2(values[i]);
+		return sqrt(d);
+	}
+
+	std::vector<double> vPartial(numThreads, 0.0);
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		const int t = AlgebraThreadNum();
+		size_t iBegin, iEnd;
+		AlgebraThreadBlock(m_size, t, numThreads, iBegin, iEnd);
+		double d=0;
+		for(size_t i=iBegin; i<iEnd; ++i)
+			d+=BlockNorm2(values[i]);
+		vPartial[t] = d;
+	}
+	return sqrt(AlgebraSumPartials(vPartial));
 }
 
 template<typename value_type>
 inline double Vector<value_type>::maxnorm() const
 {
-	double d=0;
-	for(size_t i=0; i<size(); ++i)
-		d = std::max(d, BlockMaxNorm(values[i]));
-	return d;
+	const int numThreads = AlgebraNumThreadsFor(m_size);
+	if(numThreads == 1)
+	{
+		double d=0;
+		for(size_t i=0; i<size(); ++i)
+			d = std::max(d, BlockMaxNorm(values[i]));
+		return d;
+	}
+
+	std::vector<double> vPartial(numThreads, 0.0);
+#ifdef UG_OPENMP
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		const int t = AlgebraThreadNum();
+		size_t iBegin, iEnd;
+		AlgebraThreadBlock(m_size, t, numThreads, iBegin, iEnd);
+		double d=0;
+		for(size_t i=iBegin; i<iEnd; ++i)
+			d = std::max(d, BlockMaxNorm(values[i]));
+		vPartial[t] = d;
+	}
+	return *std::max_element(vPartial.begin(), vPartial.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// threaded vector operations
+// (more specialized than the template expressions in operations_vec.h, so
+//  these are also used by the ParallelVector versions)
+
+//! calculates dest = alpha1*v1
+template<typename value_type>
+inline void VecScaleAssign(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1)
+{
+	const size_t n = dest.size();
+#ifdef UG_OPENMP
+	const int numThreads = AlgebraNumThreadsFor(n);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
+	for(size_t i=0; i<n; i++)
+		VecScaleAssign(dest[i], alpha1, v1[i]);
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2
+template<typename value_type>
+inline void VecScaleAdd(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1,
+                        double alpha2, const Vector<value_type> &v2)
+{
+	const size_t n = dest.size();
+#ifdef UG_OPENMP
+	const int numThreads = AlgebraNumThreadsFor(n);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2 + alpha3*v3
+template<typename value_type>
+inline void VecScaleAdd(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1,
+                        double alpha2, const Vector<value_type> &v2,
+                        double alpha3, const Vector<value_type> &v3)
+{
+	const size_t n = dest.size();
+#ifdef UG_OPENMP
+	const int numThreads = AlgebraNumThreadsFor(n);
+	#pragma omp parallel for num_threads(numThreads) if(numThreads > 1)
+#endif
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i], alpha3, v3[i]);
 }
 
 template<typename TValueType>
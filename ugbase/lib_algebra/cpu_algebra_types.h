@@ -90,6 +90,34 @@ struct CPUAlgebra
 	}
 };
 
+////////////////////////////////////////////////////////////////////////////////
+//   CPU Float Algebra (Block 1x1 Algebra, single precision storage)
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Scalar algebra storing its entries in single precision. Reductions (dot
+ * products, norms) are still accumulated in double. It is not part of the
+ * algebras the discretizations are compiled for; it is used for
+ * preconditioners whose matrices do not need double precision, e.g. via
+ * the MixedPrecision preconditioner, halving their memory traffic.
+ */
+struct CPUFloatAlgebra
+{
+#ifdef UG_PARALLEL
+		typedef ParallelMatrix<SparseMatrix<float> > matrix_type;
+		typedef ParallelVector<Vector<float> > vector_type;
+#else
+		typedef SparseMatrix<float> matrix_type;
+		typedef Vector<float> vector_type;
+#endif
+
+	static const int blockSize = 1;
+	static AlgebraType get_type()
+	{
+		return AlgebraType(AlgebraType::CPU_FLOAT, 1);
+	}
+};
+
 // end group cpu_algebra
 /// \}
 
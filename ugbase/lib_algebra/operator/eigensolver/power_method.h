@@ -353,6 +353,60 @@ class PowerMethod
 		}
 };
 
+
+/// estimates the largest eigenvalue of B^{-1} A by a few steps of the power method
+/**
+ * In contrast to the PowerMethod class, this function only performs a fixed
+ * (small) number of iterations, as needed e.g. for the eigenvalue bounds of
+ * polynomial smoothers. The estimate is computed from the growth of the
+ * iterates, ||B^{-1} A v|| for normalized v, and approaches the largest
+ * eigenvalue from below.
+ *
+ * \param[in]		A			linear operator (initialized)
+ * \param[in]		BInv		approximate inverse of B (initialized, without damping)
+ * \param[in,out]	v			start vector on entry (consistent), overwritten
+ * \param[in]		numIter		number of power iterations
+ * \returns			estimate of the largest eigenvalue
+ */
+template <typename vector_type>
+number EstimateMaxEigenvalue(ILinearOperator<vector_type>& A,
+                             ILinearIterator<vector_type>& BInv,
+                             vector_type& v, size_t numIter)
+{
+	PROFILE_FUNC_GROUP("PowerMethod");
+
+	SmartPtr<vector_type> spAv = v.clone_without_values();
+	SmartPtr<vector_type> spW = v.clone_without_values();
+
+//	normalize start vector
+	number norm = v.norm();
+	#ifdef UG_PARALLEL
+	v.change_storage_type(PST_CONSISTENT);
+	#endif
+	if(norm == 0.0) return 0.0;
+	v *= 1.0/norm;
+
+	number lambda = 0.0;
+	for(size_t iter = 0; iter < numIter; ++iter)
+	{
+	//	w = B^{-1} A v
+		A.apply(*spAv, v);
+		BInv.apply(*spW, *spAv);
+
+	//	lambda ~ ||w|| / ||v||, with ||v|| = 1
+		lambda = spW->norm();
+		#ifdef UG_PARALLEL
+		spW->change_storage_type(PST_CONSISTENT);
+		#endif
+		if(lambda == 0.0) return 0.0;
+
+	//	v = w / ||w||
+		VecScaleAssign(v, 1.0/lambda, *spW);
+	}
+
+	return lambda;
+}
+
 } // namespace ug
 
 
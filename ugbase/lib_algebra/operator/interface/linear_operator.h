@@ -34,6 +34,10 @@
 #define __H__LIB_ALGEBRA__OPERATOR__INTERFACE__LINEAR_OPERATOR__
 
 #include "operator.h"
+#include "common/error.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallel_storage_type.h"
+#endif
 
 namespace ug{
 
@@ -113,6 +117,13 @@ class ILinearOperator : public IOperator<X,Y>
 	///	default implementation for IOperator interface
 		virtual void prepare(X& u) {}
 
+	///	called by the linear solvers after init, before the operator is applied repeatedly
+	/**
+	 * Operators may build data here, that speeds up the following applies.
+	 * The default implementation does nothing.
+	 */
+		virtual void prepare_for_solve() {}
+
 	// 	applies the operator
 	/**
 	 * This method applies the operator, i.e. f = L*u (or d = J(u)*c in
@@ -125,6 +136,26 @@ class ILinearOperator : public IOperator<X,Y>
 	 */
 		virtual void apply(Y& f, const X& u) = 0;
 
+	// 	applies the operator to a function, that is made consistent
+	/**
+	 * This method computes f = L*u as apply(), but u may be given in any
+	 * parallel storage type and is consistent afterwards. Operators may
+	 * overlap the communication needed for that with the computation. The
+	 * default implementation changes the storage type and calls apply().
+	 *
+	 * \param[in,out]	u		domain function
+	 * \param[out]		f		codomain function
+	 */
+		virtual void apply_make_consistent(Y& f, X& u)
+		{
+#ifdef UG_PARALLEL
+			if(!u.change_storage_type(PST_CONSISTENT))
+				UG_THROW("ILinearOperator::apply_make_consistent: "
+						"Cannot convert u to consistent vector.");
+#endif
+			apply(f, u);
+		}
+
 	// 	applies the operator and subtracts the result from the input
 	/**
 	 * This method applies the operator and subracts the result from the input
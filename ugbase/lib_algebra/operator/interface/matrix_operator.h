@@ -38,6 +38,22 @@
 
 namespace ug{
 
+///	builds the solve phase snapshot of a matrix, if the matrix type supports it
+template <typename M>
+inline void FreezeMatrixForSolve(M& A) {}
+
+///	f = A*u, where u is made consistent (see ILinearOperator::apply_make_consistent)
+/**	Matrix types that can overlap the communication overload this function.*/
+template <typename M, typename Y, typename X>
+inline void MatrixApplyMakeConsistent(const M& A, Y& f, X& u)
+{
+#ifdef UG_PARALLEL
+	if(!u.change_storage_type(PST_CONSISTENT))
+		UG_THROW("MatrixApplyMakeConsistent: Cannot convert u to consistent vector.");
+#endif
+	A.apply(f, u);
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // Matrix based linear operator
@@ -70,6 +86,12 @@ class MatrixOperator :	public virtual ILinearOperator<X,Y>,
 	// 	Apply Operator, i.e. f = f - L*u;
 		virtual void apply_sub(Y& f, const X& u) {matrix_type::matmul_minus(f,u);}
 
+	// 	Apply Operator f = L*u, making u consistent
+		virtual void apply_make_consistent(Y& f, X& u) {MatrixApplyMakeConsistent(get_matrix(), f, u);}
+
+	//	Freeze the matrix for the solve phase (see SetSparseMatrixFreezeFormat)
+		virtual void prepare_for_solve() {FreezeMatrixForSolve(get_matrix());}
+
 	// 	Access to matrix
 		virtual M& get_matrix() {return *this;};
 };
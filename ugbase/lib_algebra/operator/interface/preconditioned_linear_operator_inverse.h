@@ -131,6 +131,8 @@ class IPreconditionedLinearOperatorInverse
 													"Operator for Operator J.");
 			LS_PROFILE_END(LS_InitPrecond);
 
+			J->prepare_for_solve();
+
 			return true;
 		}
 
@@ -146,6 +148,8 @@ class IPreconditionedLinearOperatorInverse
 														"Operator for Operator L.");
 			LS_PROFILE_END(LS_InitPrecond);
 
+			L->prepare_for_solve();
+
 			return true;
 		}
 
@@ -123,20 +123,23 @@ class IPreconditioner :
 	public:
 	///	default constructor
 		IPreconditioner() :
-			m_spDefectOperator(NULL), m_spApproxOperator(NULL), m_bInit(false), m_bOtherApproxOperator(false)
+			m_spDefectOperator(NULL), m_spApproxOperator(NULL), m_bInit(false), m_bOtherApproxOperator(false),
+			m_bKeepApproxForOtherOperator(false)
 		{};
 
 	///	constructor setting debug writer
 		IPreconditioner(SmartPtr<IDebugWriter<algebra_type> > spDebugWriter) :
 			DebugWritingObject<TAlgebra>(spDebugWriter),
-			m_spDefectOperator(NULL), m_spApproxOperator(NULL), m_bInit(false), m_bOtherApproxOperator(false)
+			m_spDefectOperator(NULL), m_spApproxOperator(NULL), m_bInit(false), m_bOtherApproxOperator(false),
+			m_bKeepApproxForOtherOperator(false)
 		{};
 
 	/// clone constructor
 		IPreconditioner( const IPreconditioner<TAlgebra> &parent ) :
 			ILinearIterator<vector_type>(parent),
 			DebugWritingObject<TAlgebra>(parent),
-			m_spDefectOperator(NULL), m_spApproxOperator(NULL), m_bInit(false), m_bOtherApproxOperator(false)
+			m_spDefectOperator(NULL), m_spApproxOperator(NULL), m_bInit(false), m_bOtherApproxOperator(false),
+			m_bKeepApproxForOtherOperator(parent.m_bKeepApproxForOtherOperator)
 		{
 		}
 	protected:
@@ -192,6 +195,14 @@ class IPreconditioner :
 		virtual bool init(SmartPtr<ILinearOperator<vector_type> > J,
 		                  const vector_type& u)
 		{
+		//	keep approximation set by 'set_approximation', if requested
+			if(m_bOtherApproxOperator && m_bKeepApproxForOtherOperator)
+			{
+				m_spDefectOperator = J;
+				m_bInit = true;
+				return true;
+			}
+
 		//	cast to matrix based operator
 			SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp =
 					J.template cast_dynamic<MatrixOperator<matrix_type, vector_type> >();
@@ -359,6 +370,17 @@ class IPreconditioner :
 			m_bOtherApproxOperator = true;
 		}
 
+	///	sets if the approximation is kept when initialized with another operator
+	/**
+	 * If enabled, init(J, u) keeps the matrix operator set by
+	 * 'set_approximation' for the preconditioner and uses J only to update
+	 * the defect. J does not need to be matrix based then, e.g. a
+	 * MatrixFreeLinearOperator with its assembled diagonal as approximation.
+	 * Disabled by default, then init(J, u) initializes the preconditioner
+	 * for J.
+	 */
+		void set_keep_approximation(bool bKeep) {m_bKeepApproxForOtherOperator = bKeep;}
+
 	/// virtual destructor
 		virtual ~IPreconditioner() {};
 
@@ -385,6 +407,9 @@ class IPreconditioner :
 		bool m_bInit;
 
 		bool m_bOtherApproxOperator;
+
+	///	flag if the approximation is kept in init(J, u)
+		bool m_bKeepApproxForOtherOperator;
 };
 
 
@@ -243,21 +243,17 @@ class BiCGStab
 				}
 			// 	... or copy q = p
 				else
-				{
 					q = p;
 
-				// 	make q consistent
-					#ifdef UG_PARALLEL
-					if(!q.change_storage_type(PST_CONSISTENT))
-						UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
-					#endif
-				}
-
-			//	post-process the correction
+			//	post-process the correction (needs a consistent q)
+				#ifdef UG_PARALLEL
+				if(m_corr_post_process.size() > 0 && !q.change_storage_type(PST_CONSISTENT))
+					UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
+				#endif
 				m_corr_post_process.apply (q);
 
-			// 	compute v := A*q
-				linear_operator()->apply(v, q);
+			// 	compute v := A*q, q is made consistent while computing
+				linear_operator()->apply_make_consistent(v, q);
 
 			// 	make v unique
 				#ifdef UG_PARALLEL
@@ -312,21 +308,17 @@ class BiCGStab
 				}
 			// 	... or set q:=s
 				else
-				{
 					q = s;
 
-				// 	make q consistent
-					#ifdef UG_PARALLEL
-					if(!q.change_storage_type(PST_CONSISTENT))
-						UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
-					#endif
-				}
-
-			//	post-process the correction
+			//	post-process the correction (needs a consistent q)
+				#ifdef UG_PARALLEL
+				if(m_corr_post_process.size() > 0 && !q.change_storage_type(PST_CONSISTENT))
+					UG_THROW("BiCGStab: Cannot convert q to consistent vector.");
+				#endif
 				m_corr_post_process.apply (q);
 
-			// 	compute t := A*q
-				linear_operator()->apply(t, q);
+			// 	compute t := A*q, q is made consistent while computing
+				linear_operator()->apply_make_consistent(t, q);
 
 			// 	make t unique
 				#ifdef UG_PARALLEL
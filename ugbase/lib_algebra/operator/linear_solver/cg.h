@@ -80,13 +80,24 @@ class CG
 
 	public:
 	///	constructors
-		CG() : base_type() {}
+		CG() : base_type(), m_bOverlapComm(false) {}
 
 		CG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
-			: base_type ( spPrecond )  {}
+			: base_type ( spPrecond ), m_bOverlapComm(false)  {}
 
 		CG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
-			: base_type ( spPrecond, spConvCheck)  {}
+			: base_type ( spPrecond, spConvCheck), m_bOverlapComm(false)  {}
+
+	///	overlap the halo exchange of the preconditioned defect with A*z
+	/**
+	 * If enabled, the preconditioned defect z is made consistent while A*z
+	 * is computed (see ILinearOperator::apply_make_consistent), and A*p is
+	 * updated by the recurrence A*p = beta*A*p + A*z instead of being
+	 * computed. This costs one more vector update per step and the
+	 * recurrence may differ from A*p by rounding. Not used with
+	 * post-processes of the correction. Default: false
+	 */
+		void set_overlap_communication(bool b) {m_bOverlapComm = b;}
 
 	///	name of solver
 		virtual const char* name() const {return "CG";}
@@ -121,6 +132,12 @@ class CG
 			SmartPtr<vector_type> spZ = x.clone_without_values(); vector_type& z = *spZ;
 			SmartPtr<vector_type> spP = x.clone_without_values(); vector_type& p = *spP;
 
+		//	overlapped halo exchange: q = A*p is updated by t = A*z (needs
+		//	z before the post-process)
+			const bool bOverlap = m_bOverlapComm && m_corr_post_process.size() == 0;
+			SmartPtr<vector_type> spT;
+			if(bOverlap) spT = r.clone_without_values();
+
 			write_debugXR(x, r, convergence_check()->step());
 
 		// 	Preconditioning
@@ -139,9 +156,11 @@ class CG
 			}
 			else z = r;
 			
-		// 	make z consistent
+		// 	make z consistent (and q = A*z, if overlapped)
+			if(bOverlap)
+				linear_operator()->apply_make_consistent(q, z);
 			#ifdef UG_PARALLEL
-			if(!z.change_storage_type(PST_CONSISTENT))
+			else if(!z.change_storage_type(PST_CONSISTENT))
 				UG_THROW("CG::apply_return_defect: "
 								"Cannot convert z to consistent vector.");
 			#endif
@@ -163,7 +182,8 @@ class CG
 			while(!convergence_check()->iteration_ended())
 			{
 			// 	Build q = A*p (q is additive afterwards)
-				linear_operator()->apply(q, p);
+				if(!bOverlap)
+					linear_operator()->apply(q, p);
 
 			// 	lambda = (q,p)
 				number lambda = VecProd(q, p);
@@ -214,9 +234,11 @@ class CG
 				}
 				else z = r;
 				
+			// 	make z consistent (and t = A*z, if overlapped)
+				if(bOverlap)
+					linear_operator()->apply_make_consistent(*spT, z);
 				#ifdef UG_PARALLEL
-			// 	make z consistent
-				if(!z.change_storage_type(PST_CONSISTENT))
+				else if(!z.change_storage_type(PST_CONSISTENT))
 					UG_THROW("CG::apply_return_defect': "
 									"Cannot convert z to consistent vector.");
 				#endif
@@ -233,6 +255,10 @@ class CG
 			// 	new direction p := beta * p + z
 				VecScaleAdd(p, beta, p, 1.0, z);
 
+			//	A*p = beta * A*p + A*z
+				if(bOverlap)
+					VecScaleAdd(q, beta, q, 1.0, *spT);
+
 			// 	remember old rho
 				rhoOld = rho;
 			}
@@ -301,6 +327,9 @@ class CG
 		 * useless kernel parts to prevail in the (floating point) arithmetics.
 		 */
 		PProcessChain<vector_type> m_corr_post_process;
+
+	///	flag if the halo exchange of z is overlapped with A*z
+		bool m_bOverlapComm;
 };
 
 } // end namespace ug
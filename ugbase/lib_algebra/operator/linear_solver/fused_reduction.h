@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_REDUCTION__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_REDUCTION__
+
+#include <vector>
+
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl.h"
+	#include "lib_algebra/parallelization/parallel_vector.h"
+#endif
+
+namespace ug{
+
+///	vector dependent parts of a fused reduction (serial vectors)
+template <typename TVector>
+struct FusedReductionTraits
+{
+	struct request_type {};
+
+	static number local_dotprod(TVector& a, TVector& b) {return a.dotprod(b);}
+
+	static void start(const TVector& v, const std::vector<double>& vLocal,
+	                  std::vector<double>& vGlobal, request_type& request)
+	{
+		vGlobal = vLocal;
+	}
+
+	static void finish(request_type& request) {}
+};
+
+#ifdef UG_PARALLEL
+///	vector dependent parts of a fused reduction (parallel vectors)
+template <typename TVector>
+struct FusedReductionTraits<ParallelVector<TVector> >
+{
+	typedef MPI_Request request_type;
+
+	static number local_dotprod(ParallelVector<TVector>& a, ParallelVector<TVector>& b)
+	{
+		return a.local_dotprod(b);
+	}
+
+	static void start(const ParallelVector<TVector>& v, const std::vector<double>& vLocal,
+	                  std::vector<double>& vGlobal, request_type& request)
+	{
+		vGlobal.resize(vLocal.size());
+		request = MPI_REQUEST_NULL;
+		if(vLocal.empty()) return;
+
+		const pcl::ProcessCommunicator& pc = v.layouts()->proc_comm();
+		if(pc.empty()) {vGlobal = vLocal; return;}
+		pc.iallreduce(&vLocal[0], &vGlobal[0], (int)vLocal.size(),
+		              PCL_DT_DOUBLE, PCL_RO_SUM, request);
+	}
+
+	static void finish(request_type& request)
+	{
+		if(request != MPI_REQUEST_NULL)
+			pcl::MPI_Wait(&request);
+	}
+};
+#endif
+
+///	Several dot products summed up over all processes in one reduction
+/**
+ * Collects the process-local parts of several dot products and sums them up
+ * in a single (non-blocking, if supported by the MPI implementation) global
+ * reduction. Between start() and finish() the caller can perform work that
+ * does not depend on the reduced values, e.g. applying the operator or the
+ * preconditioner. This way the latency of the global reduction is hidden
+ * (pipelined Krylov methods) or at least only paid once for a block of dot
+ * products (s-step Krylov methods).
+ *
+ * In serial the reduction is a plain copy.
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class FusedDotProducts
+{
+	public:
+		typedef FusedReductionTraits<TVector> traits;
+
+	public:
+		FusedDotProducts() : m_bRunning(false) {}
+
+		~FusedDotProducts() {if(m_bRunning) finish();}
+
+	///	removes all products
+		void clear()
+		{
+			UG_COND_THROW(m_bRunning, "FusedDotProducts: clear while reduction in progress.");
+			m_vLocal.clear(); m_vGlobal.clear();
+		}
+
+	///	adds the process-local part of (a,b) and returns its index
+	/**	Storage types are adjusted as in the dot product of the vectors.*/
+		size_t add(TVector& a, TVector& b)
+		{
+			UG_COND_THROW(m_bRunning, "FusedDotProducts: add while reduction in progress.");
+			m_vLocal.push_back((double)traits::local_dotprod(a, b));
+			return m_vLocal.size() - 1;
+		}
+
+	///	starts the global summation over the processes of the vector v
+		void start(const TVector& v)
+		{
+			PROFILE_BEGIN_GROUP(FusedDotProducts_start, "algebra parallelization");
+			UG_COND_THROW(m_bRunning, "FusedDotProducts: reduction already in progress.");
+			traits::start(v, m_vLocal, m_vGlobal, m_request);
+			m_bRunning = true;
+		}
+
+	///	waits for the global summation to complete
+		void finish()
+		{
+			PROFILE_BEGIN_GROUP(FusedDotProducts_finish, "algebra parallelization");
+			if(!m_bRunning) return;
+			traits::finish(m_request);
+			m_bRunning = false;
+		}
+
+	///	number of products
+		size_t size() const {return m_vLocal.size();}
+
+	///	globally summed product (only valid after finish())
+		number operator[](size_t i) const {return m_vGlobal[i];}
+
+	protected:
+	///	process-local parts of the products
+		std::vector<double> m_vLocal;
+
+	///	globally summed products
+		std::vector<double> m_vGlobal;
+
+	///	request of the running reduction
+		typename traits::request_type m_request;
+
+	///	flag indicating a running reduction
+		bool m_bRunning;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_REDUCTION__ */
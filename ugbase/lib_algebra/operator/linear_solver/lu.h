@@ -44,6 +44,9 @@
 #include "../preconditioner/ilut_scalar.h"
 #include "../interface/preconditioned_linear_operator_inverse.h"
 #include "linear_solver.h"
+#include "supernodal_lu.h"
+#include "lib_algebra/ordering_strategies/algorithms/IOrderingAlgorithm.h"
+#include "lib_algebra/ordering_strategies/algorithms/native_nested_dissection.h"
 
 #include "lib_algebra/cpu_algebra_types.h"
 
@@ -68,6 +71,10 @@ class LU
 	///	Base type
 		typedef IMatrixOperatorInverse<matrix_type,vector_type> base_type;
 
+	///	Ordering type
+		typedef std::vector<size_t> ordering_container_type;
+		typedef IOrderingAlgorithm<TAlgebra, ordering_container_type> ordering_algo_type;
+
 		using base_type::init;
 
 	protected:
@@ -75,7 +82,8 @@ class LU
 
 	public:
 	///	constructor
-		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true)
+		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true),
+			m_bSupernodal(false), m_bSupernodalFactors(false)
 		{
 #ifdef LAPACK_AVAILABLE
 			m_iMinimumForSparse = 4000;
@@ -96,6 +104,31 @@ class LU
 		void set_sort_sparse(bool b)
 		{
 			m_bSortSparse = b;
+			m_supernodalLU.clear();
+		}
+
+	///	sets the fill-reducing ordering of the supernodal sparse LU (default: nested dissection)
+		void set_ordering_algorithm(SmartPtr<ordering_algo_type> ordering_algo)
+		{
+			m_spOrderingAlgo = ordering_algo;
+			m_supernodalLU.clear();
+		}
+
+	///	if true, the sparse LU is a supernodal factorization, otherwise ILUT(0) (default)
+	/**
+	 * The supernodal LU only pivots inside the diagonal blocks of its
+	 * supernodes (see SupernodalLU). If a pivot is too small, ILUT(0) is used
+	 * for the matrix instead.
+	 */
+		void set_supernodal(bool b)
+		{
+			m_bSupernodal = b;
+		}
+
+	///	sets the relative pivot tolerance of the supernodal LU (default 1e-8)
+		void set_pivot_tolerance(double tol)
+		{
+			m_supernodalLU.set_pivot_tolerance(tol);
 		}
 
 		void set_info(bool b)
@@ -178,8 +211,87 @@ class LU
 		}
 
 
+	///	factorizes A with the supernodal LU, returns false if a pivot is too small
+		bool init_supernodal(const matrix_type &A)
+		{
+			try{
+			PROFILE_FUNC();
+			m_bDense = false;
+
+#ifdef UG_PARALLEL
+			matrix_type M;
+			M = A;
+
+			MatAddSlaveRowsToMasterRowOverlap0(M);
+
+		//	set zero on slaves
+			std::vector<IndexLayout::Element> vIndex;
+			CollectUniqueElements(vIndex, A.layouts()->slave());
+			SetDirichletRow(M, vIndex);
+#else
+			const matrix_type &M = A;
+#endif
+
+			CPUAlgebra::matrix_type mat;
+			m_size = GetDoubleSparseFromBlockSparse(mat, M);
+
+		//	ordering and symbolic factorization only depend on the sparsity pattern
+			if(m_supernodalLU.pattern_changed(mat))
+			{
+				std::vector<size_t> vNewIndex(m_size);
+				const size_t blockSize = block_traits<typename matrix_type::value_type>::static_num_rows;
+				UG_COND_THROW(blockSize == 0 || m_size != M.num_rows() * blockSize,
+				              "supernodal LU needs matrices with fixed block size.");
+				if(m_bSortSparse)
+				{
+					if(m_spOrderingAlgo.invalid())
+						m_spOrderingAlgo = make_sp(new NativeNestedDissectionOrdering<TAlgebra, ordering_container_type>());
+
+					m_spOrderingAlgo->init(const_cast<matrix_type*>(&M));
+					m_spOrderingAlgo->compute();
+					const ordering_container_type& o = m_spOrderingAlgo->ordering();
+					UG_COND_THROW(o.size() != M.num_rows(), "ordering has size " << o.size()
+									<< ", but matrix has " << M.num_rows() << " rows.");
+
+				//	unknowns of a block stay consecutive
+					for(size_t i = 0; i < o.size(); ++i)
+						for(size_t k = 0; k < blockSize; ++k)
+							vNewIndex[i*blockSize + k] = o[i]*blockSize + k;
+				}
+				else
+					for(size_t i = 0; i < m_size; ++i) vNewIndex[i] = i;
+
+				m_supernodalLU.analyze(mat, vNewIndex);
+			}
+
+			if(!m_supernodalLU.factorize(mat))
+			{
+				UG_LOG("LU: small pivot in the supernodal LU, using ILUT(0).\n");
+				return false;
+			}
+
+			if(m_bInfo)
+			{
+				UG_LOG("LU using supernodal sparse LU on ");
+				print_info(A);
+				UG_LOG("\n	" << m_supernodalLU.num_supernodes() << " supernodes (max. "
+						<< m_supernodalLU.max_supernode_size() << " columns), factors have "
+						<< m_supernodalLU.num_factor_entries() << " entries ("
+						<< GetBytesSizeString(m_supernodalLU.num_factor_entries()*sizeof(double))
+						<< ", fill-in " << (double) m_supernodalLU.num_factor_entries() / mat.total_num_connections()
+						<< ")\n");
+			}
+
+			}UG_CATCH_THROW("LU::" << __FUNCTION__ << " failed")
+			return true;
+		}
+
 		bool init_sparse(const matrix_type &A)
 		{
+			m_bSupernodalFactors = m_bSupernodal && init_supernodal(A);
+			if(m_bSupernodalFactors)
+				return true;
+
 			try{
 			PROFILE_FUNC();
 			m_bDense = false;
@@ -227,7 +339,26 @@ class LU
 		bool solve_sparse(vector_type &x, const vector_type &b)
 		{
 			PROFILE_FUNC();
-			ilut_scalar->solve(x, b);
+			if(!m_bSupernodalFactors)
+			{
+				ilut_scalar->solve(x, b);
+				return true;
+			}
+
+			m_b.resize(m_size);
+			for(size_t i=0, k=0; i<b.size(); i++)
+			{
+				for(size_t j=0; j<GetSize(b[i]); j++)
+					m_b[k++] = BlockRef(b[i],j);
+			}
+
+			m_supernodalLU.solve(m_u, m_b);
+
+			for(size_t i=0, k=0; i<x.size(); i++)
+			{
+				for(size_t j=0; j<GetSize(x[i]); j++)
+					BlockRef(x[i],j) = m_u[k++];
+			}
 			return true;
 		}
 
@@ -386,6 +517,15 @@ class LU
 			ss << " Minimum Entries for Sparse LU: " << m_iMinimumForSparse;
 			if(m_iMinimumForSparse==0)
 				ss << " (= always Sparse LU)";
+			if(m_bSupernodal)
+			{
+				ss << "\n Sparse LU: supernodal, ordering: ";
+				if(!m_bSortSparse) ss << "none";
+				else if(m_spOrderingAlgo.valid()) ss << m_spOrderingAlgo->name();
+				else ss << "nested dissection";
+			}
+			else
+				ss << "\n Sparse LU: ILUT(0)";
 			return ss.str();
 		}
 
@@ -411,6 +551,13 @@ class LU
 		SmartPtr<ILUTScalarPreconditioner<algebra_type> > ilut_scalar;
 		size_t m_iMinimumForSparse;
 		bool m_bSortSparse, m_bInfo, m_bShowProgress;
+
+	/// supernodal sparse LU
+		bool m_bSupernodal;
+	///	true if the current matrix is factorized by the supernodal LU
+		bool m_bSupernodalFactors;
+		SupernodalLU m_supernodalLU;
+		SmartPtr<ordering_algo_type> m_spOrderingAlgo;
 };
 
 } // end namespace ug
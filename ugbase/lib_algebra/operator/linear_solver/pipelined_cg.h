@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "common/profiler/profiler.h"
+#include "fused_reduction.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined CG method as a solver for linear operators
+/**
+ * This class implements the pipelined preconditioned CG method. The two dot
+ * products of one iteration are fused into a single global reduction, which
+ * is started non-blocking and overlapped with the application of the
+ * preconditioner and the operator. Thus, per iteration only one global
+ * synchronization remains and its latency is hidden behind the local work.
+ * Compared to CG, three additional vectors are updated per iteration.
+ *
+ * As residual norm the preconditioned (natural) norm sqrt((r, M^{-1} r)) is
+ * used for the convergence check, since it is available without an
+ * additional reduction. Without preconditioner this is the euclidean norm.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Ghysels, Vanroose, "Hiding global synchronization latency in the
+ *   preconditioned Conjugate Gradient algorithm", Parallel Computing 40
+ *   (2014), Alg. 3
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipelinedCG
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipelinedCG() : base_type() {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipelinedCG";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	///	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipelinedCG_apply_return_defect, "CG algebra");
+		//	check parallel storage types
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect:"
+								"Inadequate storage format of Vectors.");
+			#endif
+
+		// 	rename r as b (for convenience)
+			vector_type& r = b;
+
+		// 	Build defect:  r := b - J(u)*x
+			linear_operator()->apply_sub(r, x);
+
+		// 	create help vectors
+		//	consistent: u = M^-1 r, m = M^-1 w, p, q
+		//	additive:   w = A u, n = A m, s, z
+			SmartPtr<vector_type> spU = x.clone_without_values(); vector_type& u = *spU;
+			SmartPtr<vector_type> spM = x.clone_without_values(); vector_type& m = *spM;
+			SmartPtr<vector_type> spP = x.clone_without_values(); vector_type& p = *spP;
+			SmartPtr<vector_type> spQ = x.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spN = r.clone_without_values(); vector_type& n = *spN;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+
+			write_debugXR(x, r, convergence_check()->step());
+
+		// 	u := M^-1 r, w := A u
+			if(!precondition(u, r)) return false;
+			linear_operator()->apply(w, u);
+
+			prepare_conv_check();
+
+			FusedDotProducts<vector_type> dots;
+			number gammaOld = 0.0, alphaOld = 0.0;
+
+		// 	Iteration loop
+			for(int it = 0; ; ++it)
+			{
+			//	start the reduction of gamma = (r,u) and delta = (w,u)
+				dots.clear();
+				const size_t iGamma = dots.add(r, u);
+				const size_t iDelta = dots.add(w, u);
+				dots.start(r);
+
+			//	overlap with m := M^-1 w, n := A m
+				if(!precondition(m, w)) {dots.finish(); return false;}
+				linear_operator()->apply(n, m);
+
+				dots.finish();
+				const number gamma = dots[iGamma];
+				const number delta = dots[iDelta];
+
+			// 	Check convergence
+				if(gamma < 0.0)
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': (r, M^-1 r)="
+							<< gamma << " is negative. Preconditioner not "
+							"symmetric positive definite. Aborting solver.\n");
+					return false;
+				}
+				if(it == 0) convergence_check()->start_defect(std::sqrt(gamma));
+				else convergence_check()->update_defect(std::sqrt(gamma));
+				if(convergence_check()->iteration_ended()) break;
+
+			//	compute step sizes
+				number beta, lambda;
+				if(it == 0) {beta = 0.0; lambda = delta;}
+				else {beta = gamma / gammaOld; lambda = delta - beta * gamma / alphaOld;}
+
+			//	check lambda
+				if(lambda == 0.0)
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': lambda=" <<
+						lambda<< " is not admitted. Aborting solver.\n");
+					return false;
+				}
+				const number alpha = gamma / lambda;
+
+			//	update directions
+				if(it == 0) {z = n; q = m; s = w; p = u;}
+				else
+				{
+					VecScaleAdd(z, 1.0, n, beta, z);
+					VecScaleAdd(q, 1.0, m, beta, q);
+					VecScaleAdd(s, 1.0, w, beta, s);
+					VecScaleAdd(p, 1.0, u, beta, p);
+				}
+
+			//	update iterate and recurrences
+				VecScaleAdd(x, 1.0, x, alpha, p);
+				VecScaleAdd(r, 1.0, r, -alpha, s);
+				VecScaleAdd(u, 1.0, u, -alpha, q);
+				VecScaleAdd(w, 1.0, w, -alpha, z);
+
+				write_debugXR(x, r, convergence_check()->step());
+
+				gammaOld = gamma;
+				alphaOld = alpha;
+			}
+
+		//	post output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	c := M^-1 d (or a consistent copy of d without preconditioner)
+		bool precondition(vector_type& c, vector_type& d)
+		{
+			if(preconditioner().valid())
+			{
+				enter_precond_debug_section(convergence_check()->step());
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': "
+							"Cannot apply preconditioner. Aborting.\n");
+					this->leave_vector_debug_writer_section();
+					return false;
+				}
+				this->leave_vector_debug_writer_section();
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect: "
+								"Cannot convert correction to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	adjust output of convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ", in Precond-Norm)";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	/// debugger output: solution and residual
+		void write_debugXR(vector_type &x, vector_type &r, int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; snprintf(ext, 20, "_iter%03d", loopCnt);
+			write_debug(r, std::string("PipelinedCG_Residual") + ext + ".vec");
+			write_debug(x, std::string("PipelinedCG_Solution") + ext + ".vec");
+		}
+
+	/// debugger section for the preconditioner
+		void enter_precond_debug_section(int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; snprintf(ext, 20, "_iter%03d", loopCnt);
+			this->enter_vector_debug_writer_section(std::string("PipelinedCG_Precond_") + ext);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__ */
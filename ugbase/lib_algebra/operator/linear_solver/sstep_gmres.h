@@ -0,0 +1,578 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SSTEP_GMRES__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SSTEP_GMRES__
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/operator/interface/pprocess.h"
+#include "fused_reduction.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the s-step (communication avoiding) GMRES method
+/**
+ * This class implements an s-step variant of the (left preconditioned)
+ * restarted GMRES method. Instead of orthogonalizing every new Krylov vector
+ * separately (one global reduction per dot product or at least per step),
+ * a block of s vectors of the monomial basis
+ *
+ * 		p_k = (M^{-1} A)^k v_j / sigma^k,	k = 1, ..., s
+ *
+ * is generated first and is then orthonormalized as a block: block classical
+ * Gram-Schmidt against the current basis combined with a Cholesky QR of the
+ * block, both done twice for stability (BCGS2 + CholQR2). All dot products of
+ * one pass are summed up in a single fused global reduction. Thus only two
+ * global synchronizations are needed per s steps. The Hessenberg matrix is
+ * reconstructed from the orthogonalization coefficients. The scaling sigma
+ * is adapted to the growth of the basis vectors of the previous block.
+ *
+ * If the block becomes numerically rank deficient, it is truncated; if not
+ * even one new direction is found, the Krylov space is invariant and the
+ * restart cycle ends (lucky breakdown).
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Hoemmen, "Communication-avoiding Krylov subspace methods", PhD thesis,
+ *   UC Berkeley, 2010
+ *
+ * - Yamazaki, Tomov, Dongarra, "Mixed-precision Cholesky QR factorization
+ *   and its case studies on Multicore CPU with Multiple GPUs", SIAM J. Sci.
+ *   Comput. 37 (2015)
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class SStepGMRES
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+		typedef std::vector<std::vector<number> > dense_type;
+
+	public:
+	///	constructor setting restart and block size
+		SStepGMRES(size_t restart, size_t s)
+			: m_restart(restart), m_s(s)
+		{
+			check_params();
+		};
+
+	///	constructor setting the preconditioner and the convergence check
+		SStepGMRES(size_t restart, size_t s,
+		           SmartPtr<ILinearIterator<vector_type> > spPrecond,
+		           SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type(spPrecond, spConvCheck), m_restart(restart), m_s(s)
+		{
+			check_params();
+		};
+
+	///	name of solver
+		virtual const char* name() const {return "SStepGMRES";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	// 	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(SStepGMRES_apply_return_defect, "algebra");
+		//	check correct storage type in parallel
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("SStepGMRES: Inadequate storage format of Vectors.");
+			#endif
+
+		//	copy rhs
+			SmartPtr<vector_type> spR = b.clone();
+
+		// 	build defect:  b := b - A*x
+			linear_operator()->apply_sub(*spR, x);
+
+		//	prepare convergence check
+			prepare_conv_check();
+
+		//	compute start defect norm
+			convergence_check()->start(*spR);
+
+		//	storage for basis v, block p, hessenberg h (unrotated: hOrig)
+			const size_t m = m_restart;
+			std::vector<SmartPtr<vector_type> > v(m+1);
+			std::vector<SmartPtr<vector_type> > p(m_s+1);
+			dense_type h(m+1), hOrig(m+1);
+			std::vector<number> gamma(m+1);
+			std::vector<number> c(m+1);
+			std::vector<number> s(m+1);
+
+		//	scaling of the monomial basis
+			number sigma = 1.0;
+
+		//	old norm
+			number oldNorm;
+
+		// 	Iteration loop
+			while(!convergence_check()->iteration_ended())
+			{
+			//	reset hessenberg matrix
+				for(size_t i = 0; i < h.size(); ++i){
+					h[i].assign(m, 0.0); hOrig[i].assign(m, 0.0);
+				}
+
+			//	get storage for first vector v[0]
+				if(v[0].invalid()) v[0] = x.clone_without_values();
+
+			// 	apply v[0] = M^-1 * (b-A*x)
+				if(preconditioner().valid()){
+					if(!preconditioner()->apply(*v[0], *spR)){
+						UG_LOG("SStepGMRES: Cannot apply preconditioner to b-A*x0.\n");
+						return false;
+					}
+				}
+			// 	... or reuse v[0] = (b-A*x)
+				else{
+					SmartPtr<vector_type> tmp = v[0]; v[0] = spR; spR = tmp;
+				}
+
+			// 	make v[0] unique
+				#ifdef UG_PARALLEL
+				if(!v[0]->change_storage_type(PST_UNIQUE))
+					UG_THROW("SStepGMRES: Cannot convert v0 to unique vector.");
+				#endif
+
+			//	post-process the correction
+				m_corr_post_process.apply (*v[0]);
+
+			// 	Compute norm of inital residuum:
+				oldNorm = gamma[0] = v[0]->norm();
+				if(gamma[0] == 0.0) break;
+
+			//	normalize v[0] := v[0] / ||v[0]||
+				*v[0] *= 1./gamma[0];
+
+			//	loop blocks of s steps
+				size_t j = 0;
+				bool bStop = false;
+				while(j < m && !bStop)
+				{
+					const size_t sB = std::min(m_s, m - j);
+
+				//	generate monomial basis p[k] = (M^-1 A)^k v[j] / sigma^k
+					#ifdef UG_PARALLEL
+					if(!v[j]->change_storage_type(PST_CONSISTENT))
+						UG_THROW("SStepGMRES: Cannot convert v["<<j<<"] to consistent vector.");
+					#endif
+					for(size_t k = 1; k <= sB; ++k)
+					{
+						if(p[k].invalid()) p[k] = x.clone_without_values();
+						vector_type& pPrev = (k == 1) ? *v[j] : *p[k-1];
+						if(!apply_preconditioned_operator(*p[k], *spR, pPrev))
+							return false;
+						*p[k] *= 1./sigma;
+					}
+					#ifdef UG_PARALLEL
+					if(!v[j]->change_storage_type(PST_UNIQUE))
+						UG_THROW("SStepGMRES: Cannot convert v["<<j<<"] to unique vector.");
+					for(size_t k = 1; k <= sB; ++k)
+						if(!p[k]->change_storage_type(PST_UNIQUE))
+							UG_THROW("SStepGMRES: Cannot convert p["<<k<<"] to unique vector.");
+					#endif
+
+				//	orthonormalize block against basis and within block
+					dense_type C, R;
+					std::vector<number> vNorm2;
+					const size_t kk = orthonormalize_block(v, j, p, sB, C, R, vNorm2);
+
+				//	reconstruct hessenberg columns j, ..., j+max(kk,1)-1
+					for(size_t i = 0; i <= j; ++i)
+						hOrig[i][j] = sigma * C[i][1];
+					hOrig[j+1][j] = (kk > 0) ? sigma * R[1][1] : 0.0;
+
+					for(size_t k = 2; k <= kk; ++k)
+					{
+						const size_t col = j + k - 1;
+
+					//	sigma * p[k] in basis v[0], ..., v[j+k]
+						for(size_t i = 0; i <= j; ++i)
+							hOrig[i][col] = sigma * C[i][k];
+						for(size_t l = 1; l <= k; ++l)
+							hOrig[j+l][col] = sigma * R[l][k];
+
+					//	subtract images of the other components of p[k-1]
+						for(size_t i = 0; i <= j; ++i)
+							for(size_t row = 0; row <= i+1; ++row)
+								hOrig[row][col] -= C[i][k-1] * hOrig[row][i];
+						for(size_t l = 1; l < k-1; ++l)
+							for(size_t row = 0; row <= j+l+1; ++row)
+								hOrig[row][col] -= R[l][k-1] * hOrig[row][j+l];
+
+						for(size_t row = 0; row <= col+1; ++row)
+							hOrig[row][col] /= R[k-1][k-1];
+					}
+
+				//	new basis vectors
+					for(size_t k = 1; k <= kk; ++k)
+					{
+						SmartPtr<vector_type> tmp = v[j+k]; v[j+k] = p[k]; p[k] = tmp;
+					}
+
+				//	lucky breakdown: Krylov space is invariant
+					size_t numCols = j + kk;
+					if(kk == 0) {numCols = j + 1; bStop = true;}
+
+				//	adapt scaling to the growth of the basis
+					if(kk > 0 && vNorm2[kk] > 0.0)
+					{
+						const number growth = std::pow(std::sqrt(vNorm2[kk]), 1.0 / kk);
+						if(growth > 0.0 && growth < std::numeric_limits<number>::max())
+							sigma *= growth;
+					}
+
+				//	apply givens rotations to the new columns
+					for(size_t col = j; col < numCols; ++col)
+					{
+						for(size_t i = 0; i <= col+1; ++i)
+							h[i][col] = hOrig[i][col];
+
+						for(size_t i = 0; i < col; ++i)
+						{
+							const number hij = h[i][col];
+							const number hi1j = h[i+1][col];
+
+							h[i][col]   =  c[i+1]*hij + s[i+1]*hi1j;
+							h[i+1][col] =  s[i+1]*hij - c[i+1]*hi1j;
+						}
+
+					//	alpha := sqrt(h_jj ^2 + h_{j+1,j}^2)
+						const number alpha = sqrt(h[col][col]*h[col][col]
+						                          + h[col+1][col]*h[col+1][col]);
+
+					//	update s, c
+						s[col+1] = h[col+1][col] / alpha;
+						c[col+1] = h[col][col]   / alpha;
+						h[col][col] = alpha;
+
+					//	compute new norm
+						gamma[col+1] = s[col+1]*gamma[col];
+						gamma[col] = c[col+1]*gamma[col];
+
+						if(preconditioner().valid()) {
+							UG_LOG(std::string(convergence_check()->get_offset(),' '));
+							UG_LOG("% SStepGMRES "<<std::setw(4) <<col+1<<": "
+								   << gamma[col+1] << "    " << gamma[col+1] / oldNorm);
+							UG_LOG(" (in Precond-Norm) \n");
+							oldNorm = gamma[col+1];
+						}
+						else{
+							convergence_check()->update_defect(gamma[col+1]);
+							if(convergence_check()->iteration_ended())
+							{
+								numCols = col + 1; bStop = true;
+								break;
+							}
+						}
+					}
+
+					j = numCols;
+				}
+
+			//	compute coefficients
+				const size_t numIter = j - 1;
+				for(size_t i = numIter; ; --i){
+					for(size_t k = i+1; k <= numIter; ++k)
+						gamma[i] -= h[i][k] * gamma[k];
+
+					gamma[i] /= h[i][i];
+
+					if(i == 0) break;
+				}
+
+			//	x = x + sum_i gamma[i] * v[i]
+				SmartPtr<vector_type> spY = v[0]->clone();
+				*spY *= gamma[0];
+				for(size_t i = 1; i <= numIter; ++i)
+					VecScaleAdd(*spY, 1.0, *spY, gamma[i], *v[i]);
+				#ifdef UG_PARALLEL
+				if(!spY->change_storage_type(PST_CONSISTENT))
+					UG_THROW("SStepGMRES: Cannot convert correction to consistent vector.");
+				#endif
+				VecScaleAdd(x, 1.0, x, 1.0, *spY);
+
+			//	compute fresh defect: b := b - A*x
+				*spR = b;
+				linear_operator()->apply_sub(*spR, x);
+
+				if(preconditioner().valid())
+					convergence_check()->update(*spR);
+			}
+
+		//	print ending output
+			return convergence_check()->post();
+		}
+
+	public:
+		virtual std::string config_string() const
+		{
+			std::stringstream ss;
+			ss << "SStepGMRes ( restart = " << m_restart << ", s = " << m_s << ")\n";
+			ss << base_type::config_string_preconditioner_convergence_check();
+			return ss.str();
+		}
+
+	///	adds a post-process for the iterates
+		void add_postprocess_corr (SmartPtr<IPProcessVector<vector_type> > p)
+		{
+			m_corr_post_process.add (p);
+		}
+
+	///	removes a post-process for the iterates
+		void remove_postprocess_corr (SmartPtr<IPProcessVector<vector_type> > p)
+		{
+			m_corr_post_process.remove (p);
+		}
+
+	protected:
+	///	checks restart and block size
+		void check_params()
+		{
+			UG_COND_THROW(m_restart == 0, "SStepGMRES: restart must be positive.");
+			UG_COND_THROW(m_s == 0, "SStepGMRES: block size s must be positive.");
+		}
+
+	///	prepares the output of the convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	///	computes c := M^-1 * A * u, using r as temporary
+		bool apply_preconditioned_operator(vector_type& c, vector_type& r, vector_type& u)
+		{
+			linear_operator()->apply(r, u);
+
+			if(preconditioner().valid()){
+				if(!preconditioner()->apply(c, r)){
+					UG_LOG("SStepGMRES: Cannot apply preconditioner.\n");
+					return false;
+				}
+			}
+			else c = r;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("SStepGMRES: Cannot convert vector to consistent vector.");
+			#endif
+
+		//	post-process the correction
+			m_corr_post_process.apply (c);
+			return true;
+		}
+
+	///	one pass of block Gram-Schmidt and Cholesky QR
+	/**
+	 * Projects p[1], ..., p[n] against v[0], ..., v[j] (coefficients
+	 * C[i][k]) and orthonormalizes the result by a Cholesky QR (triangular
+	 * factor R[l][k]), using a single fused reduction for all dot products.
+	 * Returns the number of accepted (linearly independent) columns. The
+	 * squared norms of the input columns are written to vNorm2.
+	 */
+		size_t project_cholqr(std::vector<SmartPtr<vector_type> >& v, size_t j,
+		                      std::vector<SmartPtr<vector_type> >& p, size_t n,
+		                      dense_type& C, dense_type& R,
+		                      std::vector<number>& vNorm2)
+		{
+			C.assign(j+1, std::vector<number>(n+1, 0.0));
+			R.assign(n+1, std::vector<number>(n+1, 0.0));
+			dense_type G(n+1, std::vector<number>(n+1, 0.0));
+			vNorm2.assign(n+1, 0.0);
+
+		//	all products in one reduction
+			FusedDotProducts<vector_type> dots;
+			for(size_t k = 1; k <= n; ++k)
+				for(size_t i = 0; i <= j; ++i)
+					dots.add(*v[i], *p[k]);
+			for(size_t k = 1; k <= n; ++k)
+				for(size_t l = k; l <= n; ++l)
+					dots.add(*p[k], *p[l]);
+			dots.start(*p[1]);
+			dots.finish();
+
+			size_t cnt = 0;
+			for(size_t k = 1; k <= n; ++k)
+				for(size_t i = 0; i <= j; ++i)
+					C[i][k] = dots[cnt++];
+			for(size_t k = 1; k <= n; ++k)
+				for(size_t l = k; l <= n; ++l)
+					G[k][l] = dots[cnt++];
+			for(size_t k = 1; k <= n; ++k)
+				vNorm2[k] = G[k][k];
+
+		//	p[k] -= sum_i C[i][k] v[i],  G := G - C^T C
+			for(size_t k = 1; k <= n; ++k)
+			{
+				for(size_t i = 0; i <= j; ++i)
+					VecScaleAdd(*p[k], 1.0, *p[k], -C[i][k], *v[i]);
+				for(size_t l = k; l <= n; ++l)
+					for(size_t i = 0; i <= j; ++i)
+						G[k][l] -= C[i][k] * C[i][l];
+			}
+
+		//	Cholesky factorization G = R^T R
+			size_t numAccepted = n;
+			for(size_t k = 1; k <= n; ++k)
+			{
+				number d = G[k][k];
+				for(size_t q = 1; q < k; ++q) d -= R[q][k] * R[q][k];
+				if(!(d > m_rankTol * vNorm2[k])) {numAccepted = k - 1; break;}
+
+				R[k][k] = std::sqrt(d);
+				for(size_t l = k+1; l <= n; ++l)
+				{
+					number g = G[k][l];
+					for(size_t q = 1; q < k; ++q) g -= R[q][k] * R[q][l];
+					R[k][l] = g / R[k][k];
+				}
+			}
+
+		//	p := p R^{-1}
+			for(size_t k = 1; k <= numAccepted; ++k)
+			{
+				for(size_t l = 1; l < k; ++l)
+					VecScaleAdd(*p[k], 1.0, *p[k], -R[l][k], *p[l]);
+				*p[k] *= 1./R[k][k];
+			}
+
+			return numAccepted;
+		}
+
+	///	orthonormalizes the block p[1], ..., p[n] against v[0], ..., v[j]
+	/**
+	 * Performs two passes of project_cholqr and returns the combined
+	 * coefficients, i.e. p_k = sum_i C[i][k] v_i + sum_{l<=k} R[l][k] q_l
+	 * for the accepted columns k, where q_l are the resulting orthonormal
+	 * vectors (stored in p). C[.][1] is also valid if no column is accepted.
+	 */
+		size_t orthonormalize_block(std::vector<SmartPtr<vector_type> >& v, size_t j,
+		                            std::vector<SmartPtr<vector_type> >& p, size_t n,
+		                            dense_type& C, dense_type& R,
+		                            std::vector<number>& vNorm2)
+		{
+			PROFILE_BEGIN_GROUP(SStepGMRES_orthonormalize_block, "algebra");
+			dense_type C1, R1, C2, R2;
+			std::vector<number> vNorm2Second;
+
+			const size_t n1 = project_cholqr(v, j, p, n, C1, R1, vNorm2);
+			C = C1; R = R1;
+			if(n1 == 0) return 0;
+
+			const size_t n2 = project_cholqr(v, j, p, n1, C2, R2, vNorm2Second);
+
+		//	C := C1 + C2 R1,  R := R2 R1
+			for(size_t k = 1; k <= n1; ++k)
+			{
+				for(size_t i = 0; i <= j; ++i)
+					for(size_t l = 1; l <= k; ++l)
+						C[i][k] += C2[i][l] * R1[l][k];
+
+				for(size_t l = 1; l <= k; ++l)
+				{
+					R[l][k] = 0.0;
+					if(l > n2) continue;
+					for(size_t q = l; q <= k; ++q)
+						R[l][k] += R2[l][q] * R1[q][k];
+				}
+			}
+
+			return n2;
+		}
+
+	protected:
+	///	restart parameter
+		size_t m_restart;
+
+	///	block size (number of steps per orthogonalization)
+		size_t m_s;
+
+	///	relative tolerance for rank deficiency of a block
+		static const number m_rankTol;
+
+	///	postprocessor for the correction in the iterations
+		/**
+		 * These postprocess operations are applied to the preconditioned
+		 * vectors before the orthogonalization. The goal is to prevent the
+		 * useless kernel parts to prevail in the (floating point) arithmetics.
+		 */
+		PProcessChain<vector_type> m_corr_post_process;
+};
+
+template <typename TVector>
+const number SStepGMRES<TVector>::m_rankTol = 1e-12;
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SSTEP_GMRES__ */
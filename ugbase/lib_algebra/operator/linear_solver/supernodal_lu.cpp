@@ -0,0 +1,610 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/small_algebra/small_algebra.h"
+#include "supernodal_lu.h"
+
+namespace ug{
+
+namespace{
+
+const size_t s_invalid = (size_t) -1;
+
+#if defined(LAPACK_AVAILABLE) && defined(BLAS_AVAILABLE)
+///	supernodes with at least this number of columns are handled by LAPACK/BLAS
+const size_t s_minBLASWidth = 4;
+#endif
+
+///	C = A * B^T for column major A (m x k), B (n x k) and C (m x n)
+void DenseMultTransposed(size_t m, size_t n, size_t k, const double* A, size_t lda,
+                         const double* B, size_t ldb, double* C, size_t ldc)
+{
+#if defined(LAPACK_AVAILABLE) && defined(BLAS_AVAILABLE)
+	if(k >= s_minBLASWidth)
+	{
+		gemm(ModeNoTrans, ModeTranspose, (lapack_int) m, (lapack_int) n, (lapack_int) k,
+		     1.0, A, (lapack_int) lda, B, (lapack_int) ldb, 0.0, C, (lapack_int) ldc);
+		return;
+	}
+#endif
+	for(size_t c = 0; c < n; ++c)
+	{
+		double* Cc = C + c*ldc;
+		for(size_t r = 0; r < m; ++r) Cc[r] = 0.0;
+		for(size_t l = 0; l < k; ++l)
+		{
+			const double b = B[c + l*ldb];
+			if(b == 0.0) continue;
+			const double* Al = A + l*lda;
+			for(size_t r = 0; r < m; ++r) Cc[r] += Al[r] * b;
+		}
+	}
+}
+
+} // end anonymous namespace
+
+
+void SupernodalLU::clear()
+{
+	m_n = 0;
+	m_maxSupernodeSize = 0;
+	m_vPatternRowStart.clear(); m_vPatternCol.clear();
+	m_vNewIndex.clear();
+	m_vSupernodeStart.clear(); m_vSupernodeOf.clear();
+	m_vStructStart.clear(); m_vStruct.clear();
+	m_vLOffset.clear(); m_vUOffset.clear();
+	m_vValuePos.clear();
+	m_vFactor.clear(); m_vPivot.clear();
+}
+
+
+bool SupernodalLU::pattern_changed(const matrix_type& A) const
+{
+	if(m_vPatternRowStart.empty() || A.num_rows() != m_n || A.num_cols() != m_n)
+		return true;
+	if(A.total_num_connections() != m_vPatternCol.size())
+		return true;
+
+	for(size_t i = 0; i < m_n; ++i)
+	{
+		size_t k = m_vPatternRowStart[i];
+		for(matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it, ++k)
+			if(k >= m_vPatternRowStart[i+1] || m_vPatternCol[k] != it.index())
+				return true;
+		if(k != m_vPatternRowStart[i+1])
+			return true;
+	}
+	return false;
+}
+
+
+void SupernodalLU::analyze(const matrix_type& A, const std::vector<size_t>& vNewIndex)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	const size_t n = A.num_rows();
+	UG_COND_THROW(A.num_cols() != n, "SupernodalLU::analyze: matrix has to be square, but is "
+					<< n << " x " << A.num_cols() << ".");
+	UG_COND_THROW(vNewIndex.size() != n, "SupernodalLU::analyze: ordering has size "
+					<< vNewIndex.size() << ", but matrix has " << n << " rows.");
+
+	clear();
+	m_n = n;
+	m_vNewIndex = vNewIndex;
+
+	std::vector<size_t> vMark(n, s_invalid);
+	for(size_t i = 0; i < n; ++i)
+	{
+		UG_COND_THROW(vNewIndex[i] >= n || vMark[vNewIndex[i]] != s_invalid,
+		              "SupernodalLU::analyze: ordering is not a permutation.");
+		vMark[vNewIndex[i]] = i;
+	}
+
+//	remember the sparsity pattern
+	m_vPatternRowStart.resize(n + 1);
+	m_vPatternCol.reserve(A.total_num_connections());
+	for(size_t i = 0; i < n; ++i)
+	{
+		m_vPatternRowStart[i] = m_vPatternCol.size();
+		for(matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			m_vPatternCol.push_back(it.index());
+	}
+	m_vPatternRowStart[n] = m_vPatternCol.size();
+	const size_t nnz = m_vPatternCol.size();
+
+//	lower triangle of the symmetrized, permuted pattern by columns
+	std::vector<size_t> vLowerStart(n + 1, 0), vLower;
+	for(size_t i = 0; i < n; ++i)
+		for(size_t k = m_vPatternRowStart[i]; k < m_vPatternRowStart[i+1]; ++k)
+		{
+			const size_t a = m_vNewIndex[i], b = m_vNewIndex[m_vPatternCol[k]];
+			if(a != b) ++vLowerStart[std::min(a, b) + 1];
+		}
+	for(size_t j = 0; j < n; ++j) vLowerStart[j+1] += vLowerStart[j];
+	vLower.resize(vLowerStart[n]);
+	{
+		std::vector<size_t> vFill(vLowerStart.begin(), vLowerStart.end() - 1);
+		for(size_t i = 0; i < n; ++i)
+			for(size_t k = m_vPatternRowStart[i]; k < m_vPatternRowStart[i+1]; ++k)
+			{
+				const size_t a = m_vNewIndex[i], b = m_vNewIndex[m_vPatternCol[k]];
+				if(a != b) vLower[vFill[std::min(a, b)]++] = std::max(a, b);
+			}
+	}
+
+//	remove duplicates (from a_ij and a_ji)
+	{
+		size_t cnt = 0;
+		for(size_t j = 0; j < n; ++j)
+		{
+			std::vector<size_t>::iterator begin = vLower.begin() + vLowerStart[j];
+			std::vector<size_t>::iterator end = vLower.begin() + vLowerStart[j+1];
+			std::sort(begin, end);
+			end = std::unique(begin, end);
+			vLowerStart[j] = cnt;
+			for(; begin != end; ++begin) vLower[cnt++] = *begin;
+		}
+		vLowerStart[n] = cnt;
+		vLower.resize(cnt);
+	}
+
+//	row structure of the lower triangle (transposed)
+	std::vector<size_t> vRowStart(n + 1, 0), vRow(vLower.size());
+	for(size_t k = 0; k < vLower.size(); ++k) ++vRowStart[vLower[k] + 1];
+	for(size_t i = 0; i < n; ++i) vRowStart[i+1] += vRowStart[i];
+	{
+		std::vector<size_t> vFill(vRowStart.begin(), vRowStart.end() - 1);
+		for(size_t j = 0; j < n; ++j)
+			for(size_t k = vLowerStart[j]; k < vLowerStart[j+1]; ++k)
+				vRow[vFill[vLower[k]]++] = j;
+	}
+
+//	elimination tree (with path compression)
+	std::vector<size_t> vParent(n, s_invalid), vAncestor(n, s_invalid);
+	for(size_t i = 0; i < n; ++i)
+		for(size_t k = vRowStart[i]; k < vRowStart[i+1]; ++k)
+		{
+			size_t r = vRow[k];
+			while(vAncestor[r] != s_invalid && vAncestor[r] != i)
+			{
+				const size_t next = vAncestor[r];
+				vAncestor[r] = i;
+				r = next;
+			}
+			if(vAncestor[r] == s_invalid)
+			{
+				vAncestor[r] = i;
+				vParent[r] = i;
+			}
+		}
+	std::vector<size_t>().swap(vAncestor);
+
+//	column counts of L: row i has entries in the columns of its row subtree
+	std::vector<size_t> vColCount(n, 1);
+	std::fill(vMark.begin(), vMark.end(), s_invalid);
+	for(size_t i = 0; i < n; ++i)
+	{
+		vMark[i] = i;
+		for(size_t k = vRowStart[i]; k < vRowStart[i+1]; ++k)
+			for(size_t j = vRow[k]; vMark[j] != i; j = vParent[j])
+			{
+				++vColCount[j];
+				vMark[j] = i;
+			}
+	}
+	std::vector<size_t>().swap(vRow);
+	std::vector<size_t>().swap(vRowStart);
+
+//	supernodes: chains of columns with nested structure
+	m_vSupernodeOf.resize(n);
+	m_vSupernodeStart.push_back(0);
+	for(size_t j = 0; j < n; ++j)
+	{
+		if(j > 0 && !(vParent[j-1] == j && vColCount[j-1] == vColCount[j] + 1))
+			m_vSupernodeStart.push_back(j);
+		m_vSupernodeOf[j] = m_vSupernodeStart.size() - 1;
+	}
+	m_vSupernodeStart.push_back(n);
+	const size_t numSN = m_vSupernodeStart.size() - 1;
+
+//	supernodal elimination tree
+	std::vector<size_t> vChildStart(numSN + 1, 0), vChild;
+	for(size_t s = 0; s < numSN; ++s)
+	{
+		const size_t p = vParent[m_vSupernodeStart[s+1] - 1];
+		if(p != s_invalid) ++vChildStart[m_vSupernodeOf[p] + 1];
+	}
+	for(size_t s = 0; s < numSN; ++s) vChildStart[s+1] += vChildStart[s];
+	vChild.resize(vChildStart[numSN]);
+	{
+		std::vector<size_t> vFill(vChildStart.begin(), vChildStart.end() - 1);
+		for(size_t s = 0; s < numSN; ++s)
+		{
+			const size_t p = vParent[m_vSupernodeStart[s+1] - 1];
+			if(p != s_invalid) vChild[vFill[m_vSupernodeOf[p]]++] = s;
+		}
+	}
+
+//	row structure of the supernodes: own columns, rows of the matrix and
+//	the off-diagonal rows of the children
+	m_vStructStart.resize(numSN + 1);
+	m_vLOffset.resize(numSN);
+	m_vUOffset.resize(numSN);
+	std::fill(vMark.begin(), vMark.end(), s_invalid);
+	size_t factorSize = 0;
+	for(size_t s = 0; s < numSN; ++s)
+	{
+		const size_t first = m_vSupernodeStart[s], last = m_vSupernodeStart[s+1];
+		const size_t width = last - first;
+		m_vStructStart[s] = m_vStruct.size();
+		for(size_t j = first; j < last; ++j) m_vStruct.push_back(j);
+
+		const size_t offDiagStart = m_vStruct.size();
+		for(size_t j = first; j < last; ++j)
+			for(size_t k = vLowerStart[j]; k < vLowerStart[j+1]; ++k)
+			{
+				const size_t r = vLower[k];
+				if(r >= last && vMark[r] != s) {vMark[r] = s; m_vStruct.push_back(r);}
+			}
+		for(size_t c = vChildStart[s]; c < vChildStart[s+1]; ++c)
+		{
+			const size_t child = vChild[c];
+			const size_t childWidth = m_vSupernodeStart[child+1] - m_vSupernodeStart[child];
+			for(size_t k = m_vStructStart[child] + childWidth; k < m_vStructStart[child+1]; ++k)
+			{
+				const size_t r = m_vStruct[k];
+				if(r >= last && vMark[r] != s) {vMark[r] = s; m_vStruct.push_back(r);}
+			}
+		}
+		std::sort(m_vStruct.begin() + offDiagStart, m_vStruct.end());
+		m_vStructStart[s+1] = m_vStruct.size();
+
+		const size_t numRows = m_vStruct.size() - m_vStructStart[s];
+		UG_ASSERT(numRows == vColCount[first], "SupernodalLU::analyze: structure of supernode "
+					<< s << " has " << numRows << " rows, expected " << vColCount[first]);
+
+		m_vLOffset[s] = factorSize;
+		m_vUOffset[s] = factorSize + numRows * width;
+		factorSize += (2*numRows - width) * width;
+		m_maxSupernodeSize = std::max(m_maxSupernodeSize, width);
+	}
+	m_vFactor.resize(factorSize);
+	m_vPivot.resize(n);
+
+//	position of the matrix entries in the panels, grouped by supernode
+	std::vector<size_t> vEntryStart(numSN + 1, 0), vEntry(nnz), vEntryRow(nnz);
+	for(size_t i = 0; i < n; ++i)
+		for(size_t k = m_vPatternRowStart[i]; k < m_vPatternRowStart[i+1]; ++k)
+		{
+			vEntryRow[k] = i;
+			const size_t a = m_vNewIndex[i], b = m_vNewIndex[m_vPatternCol[k]];
+			++vEntryStart[m_vSupernodeOf[std::min(a, b)] + 1];
+		}
+	for(size_t s = 0; s < numSN; ++s) vEntryStart[s+1] += vEntryStart[s];
+	{
+		std::vector<size_t> vFill(vEntryStart.begin(), vEntryStart.end() - 1);
+		for(size_t k = 0; k < nnz; ++k)
+		{
+			const size_t a = m_vNewIndex[vEntryRow[k]], b = m_vNewIndex[m_vPatternCol[k]];
+			vEntry[vFill[m_vSupernodeOf[std::min(a, b)]]++] = k;
+		}
+	}
+
+	m_vValuePos.resize(nnz);
+	for(size_t s = 0; s < numSN; ++s)
+	{
+		const size_t first = m_vSupernodeStart[s], last = m_vSupernodeStart[s+1];
+		const size_t width = last - first;
+		const size_t numRows = m_vStructStart[s+1] - m_vStructStart[s];
+		const size_t numOffDiag = numRows - width;
+		for(size_t k = m_vStructStart[s]; k < m_vStructStart[s+1]; ++k)
+			vMark[m_vStruct[k]] = k - m_vStructStart[s];
+
+		for(size_t e = vEntryStart[s]; e < vEntryStart[s+1]; ++e)
+		{
+			const size_t k = vEntry[e];
+			const size_t a = m_vNewIndex[vEntryRow[k]], b = m_vNewIndex[m_vPatternCol[k]];
+			if(b >= first && b < last)
+			//	column in this supernode: L panel (including the full diagonal block)
+				m_vValuePos[k] = m_vLOffset[s] + (b - first) * numRows + vMark[a];
+			else
+			//	row in this supernode, column behind it: U panel
+				m_vValuePos[k] = m_vUOffset[s] + (a - first) * numOffDiag + vMark[b] - width;
+		}
+	}
+}
+
+
+bool SupernodalLU::factorize(const matrix_type& A)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(m_vPatternRowStart.empty(), "SupernodalLU::factorize: no symbolic analysis.");
+	UG_COND_THROW(A.num_rows() != m_n || A.total_num_connections() != m_vValuePos.size(),
+	              "SupernodalLU::factorize: matrix does not match the analyzed sparsity pattern.");
+	UG_ASSERT(!pattern_changed(A), "SupernodalLU::factorize: sparsity pattern has changed.");
+
+//	scatter the matrix into the panels
+	std::fill(m_vFactor.begin(), m_vFactor.end(), 0.0);
+	size_t k = 0;
+	for(size_t i = 0; i < m_n; ++i)
+		for(matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			m_vFactor[m_vValuePos[k++]] += it.value();
+
+//	right-looking factorization, children are numbered before their parents
+	for(size_t s = 0; s < num_supernodes(); ++s)
+	{
+		if(!factorize_panel(s)) return false;
+		update_ancestors(s);
+	}
+	return true;
+}
+
+
+bool SupernodalLU::factorize_panel(size_t s)
+{
+	const size_t first = m_vSupernodeStart[s];
+	const size_t width = m_vSupernodeStart[s+1] - first;
+	const size_t numRows = m_vStructStart[s+1] - m_vStructStart[s];
+	const size_t numOffDiag = numRows - width;
+	double* L = &m_vFactor[m_vLOffset[s]];
+	double* Ut = &m_vFactor[0] + m_vUOffset[s];
+	size_t* pivot = &m_vPivot[first];
+
+//	largest entries of the columns, the pivots are compared to them
+	if(m_vColMax.size() < width) m_vColMax.resize(width);
+	for(size_t c = 0; c < width; ++c)
+	{
+		m_vColMax[c] = 0.0;
+		for(size_t r = 0; r < numRows; ++r)
+			m_vColMax[c] = std::max(m_vColMax[c], std::fabs(L[r + c*numRows]));
+	}
+
+#if defined(LAPACK_AVAILABLE) && defined(BLAS_AVAILABLE)
+	if(width >= s_minBLASWidth)
+	{
+	//	P D = L_D U_D for the diagonal block
+		std::vector<lapack_int> vPiv(width);
+		lapack_int info = getrf((lapack_int) width, (lapack_int) width, L, (lapack_int) numRows, &vPiv[0]);
+		UG_COND_THROW(info < 0, "SupernodalLU: getrf failed with " << info);
+		for(size_t c = 0; c < width; ++c)
+		{
+			if(!(std::fabs(L[c + c*numRows]) > m_pivotTolerance * m_vColMax[c]))
+			{
+				UG_DLOG(LIB_ALG_LINEAR_SOLVER, 1, "SupernodalLU: small pivot in column "
+						<< first + c << " of the permuted matrix.\n");
+				return false;
+			}
+			pivot[c] = vPiv[c] - 1;
+			if(pivot[c] != c)
+				for(size_t r = 0; r < numOffDiag; ++r)
+					std::swap(Ut[r + c*numOffDiag], Ut[r + pivot[c]*numOffDiag]);
+		}
+
+		if(numOffDiag > 0)
+		{
+		//	L_O = A_O U_D^{-1}, U_O^T = (L_D^{-1} P A_O')^T
+			trsm(true, false, ModeNoTrans, false, (lapack_int) numOffDiag, (lapack_int) width,
+			     1.0, L, (lapack_int) numRows, L + width, (lapack_int) numRows);
+			trsm(true, true, ModeTranspose, true, (lapack_int) numOffDiag, (lapack_int) width,
+			     1.0, L, (lapack_int) numRows, Ut, (lapack_int) numOffDiag);
+		}
+		return true;
+	}
+#endif
+
+//	LU of the whole panel, pivot rows are searched in the diagonal block only
+	for(size_t c = 0; c < width; ++c)
+	{
+		double* Lc = L + c*numRows;
+		size_t p = c;
+		for(size_t r = c + 1; r < width; ++r)
+			if(std::fabs(Lc[r]) > std::fabs(Lc[p])) p = r;
+		if(!(std::fabs(Lc[p]) > m_pivotTolerance * m_vColMax[c]))
+		{
+			UG_DLOG(LIB_ALG_LINEAR_SOLVER, 1, "SupernodalLU: small pivot in column "
+					<< first + c << " of the permuted matrix.\n");
+			return false;
+		}
+
+		pivot[c] = p;
+		if(p != c)
+		{
+			for(size_t j = 0; j < width; ++j)
+				std::swap(L[c + j*numRows], L[p + j*numRows]);
+			for(size_t r = 0; r < numOffDiag; ++r)
+				std::swap(Ut[r + c*numOffDiag], Ut[r + p*numOffDiag]);
+		}
+
+		const double invPivot = 1.0 / Lc[c];
+		for(size_t r = c + 1; r < numRows; ++r) Lc[r] *= invPivot;
+
+		for(size_t j = c + 1; j < width; ++j)
+		{
+			double* Lj = L + j*numRows;
+			const double u = Lj[c];
+			if(u == 0.0) continue;
+			for(size_t r = c + 1; r < numRows; ++r) Lj[r] -= Lc[r] * u;
+		}
+
+	//	U_O^T = (L_D^{-1} P A_O')^T, column c is final after eliminating column c
+		double* Utc = Ut + c*numOffDiag;
+		for(size_t j = c + 1; j < width; ++j)
+		{
+			const double l = L[j + c*numRows];
+			if(l == 0.0) continue;
+			double* Utj = Ut + j*numOffDiag;
+			for(size_t r = 0; r < numOffDiag; ++r) Utj[r] -= Utc[r] * l;
+		}
+	}
+	return true;
+}
+
+
+void SupernodalLU::update_ancestors(size_t s)
+{
+	const size_t width = m_vSupernodeStart[s+1] - m_vSupernodeStart[s];
+	const size_t numRows = m_vStructStart[s+1] - m_vStructStart[s];
+	const size_t numOffDiag = numRows - width;
+	if(numOffDiag == 0) return;
+
+	const double* Lo = &m_vFactor[m_vLOffset[s]] + width;
+	const double* Ut = &m_vFactor[0] + m_vUOffset[s];
+	const size_t* rows = &m_vStruct[m_vStructStart[s] + width];
+
+	if(m_vRelPos.size() < numOffDiag) m_vRelPos.resize(numOffDiag);
+
+//	the off-diagonal rows are grouped by the supernodes containing them
+	for(size_t p = 0; p < numOffDiag; )
+	{
+		const size_t t = m_vSupernodeOf[rows[p]];
+		const size_t tFirst = m_vSupernodeStart[t], tLast = m_vSupernodeStart[t+1];
+		const size_t tWidth = tLast - tFirst;
+		const size_t tNumRows = m_vStructStart[t+1] - m_vStructStart[t];
+		const size_t tNumOffDiag = tNumRows - tWidth;
+		size_t q = p;
+		while(q < numOffDiag && rows[q] < tLast) ++q;
+
+	//	positions of the remaining rows in the structure of t (a superset)
+		const size_t* tRows = &m_vStruct[m_vStructStart[t]];
+		for(size_t r = p, pos = 0; r < numOffDiag; ++r, ++pos)
+		{
+			while(tRows[pos] != rows[r]) ++pos;
+			UG_ASSERT(pos < tNumRows, "SupernodalLU: row " << rows[r] << " not in supernode " << t);
+			m_vRelPos[r] = pos;
+		}
+
+		const size_t numCols = q - p;
+		const size_t numL = numOffDiag - p, numU = numOffDiag - q;
+		if(m_vUpdate.size() < numL * numCols) m_vUpdate.resize(numL * numCols);
+		double* W = &m_vUpdate[0];
+
+	//	L part of t: rows p.. of L_O times columns p..q of U_O
+		DenseMultTransposed(numL, numCols, width, Lo + p, numRows, Ut + p, numOffDiag, W, numL);
+		double* tL = &m_vFactor[m_vLOffset[t]];
+		for(size_t c = 0; c < numCols; ++c)
+		{
+			double* dst = tL + (rows[p + c] - tFirst) * tNumRows;
+			const double* Wc = W + c*numL;
+			for(size_t r = 0; r < numL; ++r) dst[m_vRelPos[p + r]] -= Wc[r];
+		}
+
+	//	U part of t: rows p..q of L_O times columns q.. of U_O
+		if(numU > 0)
+		{
+			DenseMultTransposed(numU, numCols, width, Ut + q, numOffDiag, Lo + p, numRows, W, numU);
+			double* tUt = &m_vFactor[0] + m_vUOffset[t];
+			for(size_t c = 0; c < numCols; ++c)
+			{
+				double* dst = tUt + (rows[p + c] - tFirst) * tNumOffDiag;
+				const double* Wc = W + c*numU;
+				for(size_t r = 0; r < numU; ++r) dst[m_vRelPos[q + r] - tWidth] -= Wc[r];
+			}
+		}
+
+		p = q;
+	}
+}
+
+
+void SupernodalLU::solve(vector_type& x, const vector_type& b)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(b.size() != m_n, "SupernodalLU::solve: vector has size " << b.size()
+					<< ", but the factorized matrix has " << m_n << " rows.");
+	if(x.size() != m_n) x.resize(m_n);
+
+	m_vSolve.resize(m_n);
+	double* y = m_n ? &m_vSolve[0] : NULL;
+	for(size_t i = 0; i < m_n; ++i) y[m_vNewIndex[i]] = b[i];
+
+	const size_t numSN = num_supernodes();
+
+//	forward substitution L y = P b
+	for(size_t s = 0; s < numSN; ++s)
+	{
+		const size_t first = m_vSupernodeStart[s];
+		const size_t width = m_vSupernodeStart[s+1] - first;
+		const size_t numRows = m_vStructStart[s+1] - m_vStructStart[s];
+		const double* L = &m_vFactor[m_vLOffset[s]];
+		const size_t* rows = &m_vStruct[m_vStructStart[s]];
+		double* yd = y + first;
+
+		for(size_t c = 0; c < width; ++c)
+			if(m_vPivot[first + c] != c) std::swap(yd[c], yd[m_vPivot[first + c]]);
+
+		for(size_t c = 0; c < width; ++c)
+		{
+			const double yc = yd[c];
+			if(yc == 0.0) continue;
+			const double* Lc = L + c*numRows;
+			for(size_t r = c + 1; r < width; ++r) yd[r] -= Lc[r] * yc;
+			for(size_t r = width; r < numRows; ++r) y[rows[r]] -= Lc[r] * yc;
+		}
+	}
+
+//	backward substitution U x = y
+	for(size_t s = numSN; s-- > 0; )
+	{
+		const size_t first = m_vSupernodeStart[s];
+		const size_t width = m_vSupernodeStart[s+1] - first;
+		const size_t numRows = m_vStructStart[s+1] - m_vStructStart[s];
+		const size_t numOffDiag = numRows - width;
+		const double* L = &m_vFactor[m_vLOffset[s]];
+		const double* Ut = &m_vFactor[0] + m_vUOffset[s];
+		const size_t* rows = &m_vStruct[m_vStructStart[s] + width];
+		double* yd = y + first;
+
+		for(size_t c = 0; c < width; ++c)
+		{
+			const double* Utc = Ut + c*numOffDiag;
+			double sum = 0.0;
+			for(size_t r = 0; r < numOffDiag; ++r) sum += Utc[r] * y[rows[r]];
+			yd[c] -= sum;
+		}
+
+		for(size_t c = width; c-- > 0; )
+		{
+			const double* Lc = L + c*numRows;
+			yd[c] /= Lc[c];
+			const double yc = yd[c];
+			for(size_t r = 0; r < c; ++r) yd[r] -= Lc[r] * yc;
+		}
+	}
+
+	for(size_t i = 0; i < m_n; ++i) x[i] = y[m_vNewIndex[i]];
+}
+
+} // end namespace ug
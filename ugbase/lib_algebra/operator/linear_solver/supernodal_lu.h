@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_ALGEBRA__SUPERNODAL_LU__
+#define __H__LIB_ALGEBRA__SUPERNODAL_LU__
+
+#include <vector>
+
+#include "lib_algebra/cpu_algebra_types.h"
+
+namespace ug{
+
+///	sparse direct LU factorization of a scalar matrix using supernodes
+/**
+ * The factorization works on the symmetrized sparsity pattern of the matrix
+ * permuted by a given fill-reducing ordering (e.g. nested dissection).
+ *
+ * The symbolic analysis computes the elimination tree, groups consecutive
+ * columns with identical structure of the factors into supernodes and stores
+ * the factors supernode by supernode in dense column major panels. The numeric
+ * factorization then only consists of dense operations on these panels
+ * (BLAS level 3 if LAPACK and BLAS are available) and scattering the update
+ * matrices into the panels of the ancestor supernodes.
+ *
+ * The symbolic analysis only depends on the sparsity pattern and can be reused
+ * for matrices with the same pattern, which is typical for coarse grid
+ * matrices during a Newton iteration or a time stepping.
+ *
+ * Pivoting is done by rows inside the diagonal block of each supernode only,
+ * so that the structure of the factors is not changed. This is weaker than
+ * partial pivoting: rows of the off-diagonal part of a supernode can not be
+ * chosen as pivots, a supernode of a single column is not pivoted at all, and
+ * the growth of the factors is not bounded. Matrices with small diagonal
+ * entries (e.g. saddle point problems) may therefore fail. A pivot is
+ * regarded as too small if its absolute value is less than the pivot
+ * tolerance times the largest absolute value of its column in the panel
+ * (including the off-diagonal rows). factorize then stops and returns false,
+ * and the caller has to use another solver.
+ */
+class SupernodalLU
+{
+	public:
+		typedef CPUAlgebra::matrix_type matrix_type;
+		typedef CPUAlgebra::vector_type vector_type;
+
+	public:
+		SupernodalLU() : m_n(0), m_maxSupernodeSize(0), m_pivotTolerance(1e-8) {}
+
+	///	sets the relative pivot tolerance (default 1e-8)
+		void set_pivot_tolerance(double tol) {m_pivotTolerance = tol;}
+
+	///	returns true if there is no analysis for the sparsity pattern of A
+		bool pattern_changed(const matrix_type& A) const;
+
+	///	symbolic factorization of A permuted by vNewIndex (newInd = vNewIndex[oldInd])
+		void analyze(const matrix_type& A, const std::vector<size_t>& vNewIndex);
+
+	///	numeric factorization of A, requires an analysis for the sparsity pattern of A
+	/**	returns false if a pivot is too small, the factors are invalid then.*/
+		bool factorize(const matrix_type& A);
+
+	///	solves A x = b using the computed factors
+		void solve(vector_type& x, const vector_type& b);
+
+	///	removes analysis and factors
+		void clear();
+
+	///	number of rows of the analyzed matrix
+		size_t num_rows() const {return m_n;}
+
+	///	number of supernodes
+		size_t num_supernodes() const
+		{
+			return m_vSupernodeStart.empty() ? 0 : m_vSupernodeStart.size() - 1;
+		}
+
+	///	number of columns of the largest supernode
+		size_t max_supernode_size() const {return m_maxSupernodeSize;}
+
+	///	number of stored entries of the factors
+		size_t num_factor_entries() const {return m_vFactor.size();}
+
+	private:
+	///	factors the panel of a supernode: diagonal block, off-diagonal L and U parts
+	/**	returns false if a pivot is too small.*/
+		bool factorize_panel(size_t s);
+
+	///	subtracts the update matrix of a factorized supernode from its ancestors
+		void update_ancestors(size_t s);
+
+	private:
+	///	size of the analyzed matrix
+		size_t m_n;
+
+	///	sparsity pattern of the analyzed matrix (compressed rows)
+		std::vector<size_t> m_vPatternRowStart, m_vPatternCol;
+
+	///	fill-reducing ordering, newInd = m_vNewIndex[oldInd]
+		std::vector<size_t> m_vNewIndex;
+
+	///	first column of each supernode (and number of columns at the end)
+		std::vector<size_t> m_vSupernodeStart;
+
+	///	supernode of each (permuted) column
+		std::vector<size_t> m_vSupernodeOf;
+
+	///	row structure of each supernode: its own columns followed by the
+	///	sorted rows of the off-diagonal part
+		std::vector<size_t> m_vStructStart, m_vStruct;
+
+	///	offsets of the L panel (all rows x columns) and of the transposed
+	///	U panel (off-diagonal rows x columns) of each supernode in m_vFactor
+		std::vector<size_t> m_vLOffset, m_vUOffset;
+
+	///	position in m_vFactor of each entry of the matrix in compressed row order
+		std::vector<size_t> m_vValuePos;
+
+	///	dense panels of the factors
+		std::vector<double> m_vFactor;
+
+	///	row interchanges inside the diagonal blocks (local index in the supernode)
+		std::vector<size_t> m_vPivot;
+
+	///	work arrays
+		std::vector<double> m_vUpdate, m_vSolve, m_vColMax;
+		std::vector<size_t> m_vRelPos;
+
+		size_t m_maxSupernodeSize;
+
+	///	relative pivot tolerance
+		double m_pivotTolerance;
+};
+
+} // end namespace ug
+
+#endif /* __H__LIB_ALGEBRA__SUPERNODAL_LU__ */
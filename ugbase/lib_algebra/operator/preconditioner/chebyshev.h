@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/eigensolver/power_method.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+///	Chebyshev accelerated Jacobi smoother
+/**
+ * This preconditioner applies a Chebyshev polynomial in D^{-1} A to the
+ * defect, where D is the (block) diagonal of A. The polynomial of degree k is
+ * chosen to damp the error components belonging to the eigenvalues of
+ * D^{-1} A in the interval [lambda_max / ratio, lambda_max], which makes it
+ * a smoother for multigrid methods. Only applications of A and of the
+ * diagonal are needed, so the smoother works in parallel (and with
+ * threaded SpMV) without any ordering of the unknowns.
+ *
+ * The largest eigenvalue is estimated by a few steps of the power method
+ * (see EstimateMaxEigenvalue) on the first application and is enlarged by a
+ * safety factor. The estimate is kept while the preconditioner is
+ * reinitialized with the same matrix and an unchanged sparsity pattern
+ * (e.g. in Newton steps), unless caching is disabled.
+ *
+ * The application of A uses the operator passed to init. Thus, if a
+ * different approximation is set via 'set_approximation' and kept via
+ * 'set_keep_approximation' (e.g. the diagonal of a matrix-free operator),
+ * the diagonal is taken from that approximation, while A is still applied
+ * as given.
+ *
+ * References:
+ * <ul>
+ * <li> Y. Saad. Iterative Methods for Sparse Linear Systems, 2nd ed., Alg. 12.1
+ * <li> M. Adams, M. Brezina, J. Hu, R. Tuminaro. Parallel multigrid smoothing:
+ *      polynomial versus Gauss-Seidel. J. Comp. Phys. 188 (2003)
+ * </ul>
+ */
+template <typename TAlgebra>
+class Chebyshev : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	protected:
+		using base_type::approx_operator;
+
+	public:
+	///	default constructor
+		Chebyshev()
+			: m_degree(3), m_eigenvalueRatio(30.0), m_safetyFactor(1.1),
+			  m_numPowerIter(10), m_fixedMaxEigenvalue(0.0), m_bCache(true)
+		{init_members();}
+
+	///	constructor setting the polynomial degree
+		Chebyshev(int degree)
+			: m_degree(degree), m_eigenvalueRatio(30.0), m_safetyFactor(1.1),
+			  m_numPowerIter(10), m_fixedMaxEigenvalue(0.0), m_bCache(true)
+		{init_members();}
+
+	/// clone constructor
+		Chebyshev(const Chebyshev<TAlgebra>& parent)
+			: base_type(parent),
+			  m_degree(parent.m_degree), m_eigenvalueRatio(parent.m_eigenvalueRatio),
+			  m_safetyFactor(parent.m_safetyFactor), m_numPowerIter(parent.m_numPowerIter),
+			  m_fixedMaxEigenvalue(parent.m_fixedMaxEigenvalue), m_bCache(parent.m_bCache)
+		{init_members();}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new Chebyshev<algebra_type>(*this));
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	Destructor
+		virtual ~Chebyshev() {};
+
+	///	sets the degree of the polynomial (number of applications of A)
+		void set_degree(int degree)
+		{
+			UG_COND_THROW(degree < 1, "Chebyshev: degree must be positive, but is "<<degree);
+			m_degree = degree;
+		}
+
+	///	sets the ratio lambda_max / lambda_min of the damped eigenvalue interval
+		void set_eigenvalue_ratio(number ratio)
+		{
+			UG_COND_THROW(ratio <= 1.0, "Chebyshev: eigenvalue ratio must be > 1, but is "<<ratio);
+			m_eigenvalueRatio = ratio;
+		}
+
+	///	sets the factor the estimated largest eigenvalue is enlarged with
+		void set_safety_factor(number factor) {m_safetyFactor = factor;}
+
+	///	sets the number of power iterations used to estimate the largest eigenvalue
+		void set_num_power_iterations(int numIter) {m_numPowerIter = numIter;}
+
+	///	sets the largest eigenvalue of D^{-1} A (no estimation), 0 reenables estimation
+		void set_max_eigenvalue(number lambdaMax)
+		{
+			m_fixedMaxEigenvalue = lambdaMax;
+			m_bEigenvalueValid = false;
+		}
+
+	///	enables that the estimate is kept for reinitializations with the same matrix
+	/**	The estimate is kept, as long as the matrix is the same object and its
+	 * sparsity pattern is unchanged (see SparseMatrix::structure_stamp). Changes
+	 * of the values only, e.g. in Newton steps, do not trigger a new estimate.*/
+		void set_eigenvalue_caching(bool bCache) {m_bCache = bCache;}
+
+	///	returns the largest eigenvalue used (0 if not yet estimated)
+		number max_eigenvalue() const {return m_bEigenvalueValid ? m_lambdaMax : 0.0;}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "Chebyshev";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_preprocess, "algebra Chebyshev");
+
+		//	inverse of the diagonal
+			if(!m_spJacobi->init(pOp))
+			{
+				UG_LOG("ERROR in 'Chebyshev::preprocess': Cannot invert diagonal.\n");
+				return false;
+			}
+
+		//	keep eigenvalue estimate only for the same matrix with unchanged pattern
+			const matrix_type* pMat = &pOp->get_matrix();
+			const size_t stamp = pMat->structure_stamp();
+			if(!m_bCache || pMat != m_pMatEstimated || stamp != m_matStampEstimated)
+				m_bEigenvalueValid = false;
+			m_pMatEstimated = pMat;
+			m_matStampEstimated = stamp;
+
+			return true;
+		}
+
+	///	estimates the largest eigenvalue of D^{-1} A
+		void estimate_max_eigenvalue(const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_estimate, "algebra Chebyshev");
+
+			if(m_fixedMaxEigenvalue > 0.0)
+				m_lambdaMax = m_fixedMaxEigenvalue;
+			else
+			{
+				SmartPtr<vector_type> spV = d.clone_without_values();
+				spV->set_random(-1.0, 1.0);
+				m_lambdaMax = m_safetyFactor
+						* EstimateMaxEigenvalue(*this->m_spDefectOperator, *m_spJacobi,
+						                        *spV, m_numPowerIter);
+			}
+
+			UG_COND_THROW(!(m_lambdaMax > 0.0), "Chebyshev: Largest eigenvalue of "
+			              "D^{-1} A estimated as "<<m_lambdaMax<<", but must be positive.");
+
+			m_bEigenvalueValid = true;
+		}
+
+	///	computes c = p(D^{-1} A) D^{-1} d by the Chebyshev iteration
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_step, "algebra Chebyshev");
+
+			if(!m_bEigenvalueValid)
+				estimate_max_eigenvalue(d);
+
+		//	eigenvalue interval [a,b], center and half width
+			const number b = m_lambdaMax;
+			const number a = m_lambdaMax / m_eigenvalueRatio;
+			const number theta = 0.5 * (b + a);
+			const number delta = 0.5 * (b - a);
+			const number sigma = theta / delta;
+
+		//	work vectors: residual r, preconditioned residual z and update p
+			SmartPtr<vector_type> spR = d.clone();
+			SmartPtr<vector_type> spZ = d.clone_without_values();
+			SmartPtr<vector_type> spP = d.clone_without_values();
+			vector_type& r = *spR;
+			vector_type& z = *spZ;
+			vector_type& p = *spP;
+
+		//	first step: c = 1/theta D^{-1} d
+			if(!m_spJacobi->apply(z, r)) return false;
+			VecScaleAssign(p, 1.0/theta, z);
+			c = p;
+
+			number rho = 1.0/sigma;
+			for(int k = 1; k < m_degree; ++k)
+			{
+			//	r := r - A p
+				this->m_spDefectOperator->apply_sub(r, p);
+
+			//	z = D^{-1} r
+				if(!m_spJacobi->apply(z, r)) return false;
+
+			//	p = rho_new * rho * p + 2 rho_new / delta * z
+				const number rhoNew = 1.0 / (2.0*sigma - rho);
+				VecScaleAdd(p, rhoNew*rho, p, 2.0*rhoNew/delta, z);
+				rho = rhoNew;
+
+			//	c := c + p
+				c += p;
+			}
+
+		//	correction is consistent, since all updates are consistent
+			#ifdef UG_PARALLEL
+			c.set_storage_type(PST_CONSISTENT);
+			#endif
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+		void init_members()
+		{
+			m_spJacobi = make_sp(new Jacobi<TAlgebra>(1.0));
+			m_lambdaMax = 0.0;
+			m_bEigenvalueValid = false;
+			m_pMatEstimated = NULL;
+			m_matStampEstimated = 0;
+		}
+
+	protected:
+	///	polynomial degree
+		int m_degree;
+
+	///	ratio lambda_max / lambda_min of the damped interval
+		number m_eigenvalueRatio;
+
+	///	factor the estimate is enlarged with
+		number m_safetyFactor;
+
+	///	number of power iterations
+		int m_numPowerIter;
+
+	///	user-defined largest eigenvalue (0 if estimated)
+		number m_fixedMaxEigenvalue;
+
+	///	flag if the estimate is cached for reinitializations
+		bool m_bCache;
+
+	///	largest eigenvalue used and flag if valid
+		number m_lambdaMax;
+		bool m_bEigenvalueValid;
+
+	///	matrix and its structure stamp the estimate belongs to
+		const matrix_type* m_pMatEstimated;
+		size_t m_matStampEstimated;
+
+	///	inverse of (block) diagonal
+		SmartPtr<IPreconditioner<TAlgebra> > m_spJacobi;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__ */
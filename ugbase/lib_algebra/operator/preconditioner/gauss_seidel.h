@@ -47,6 +47,12 @@
 
 namespace ug{
 
+///	base class of the Gauss-Seidel type preconditioners
+/**
+ * If the CPU algebra uses several threads (see SetAlgebraNumThreads), the
+ * sweeps process the rows level by level (see TriangularLevelSchedule). This
+ * gives the same results as the sequential sweeps.
+ */
 template<typename TAlgebra>
 class GaussSeidelBase : public IPreconditioner<TAlgebra>
 {
@@ -151,6 +157,10 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 //			UG_ASSERT(CheckDiagonalInvertible(A), "GS: A has noninvertible diagonal");
 			UG_COND_THROW(CheckDiagonalInvertible(*pA) == false, name() << ": A has noninvertible diagonal");
 
+		//	the level schedules are rebuilt for the new matrix on first use
+			m_lowerSchedule.clear();
+			m_upperSchedule.clear();
+
 			return true;
 		}
 
@@ -159,6 +169,22 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax) = 0;
 
+	///	level schedule of the lower triangle of A, only computed if threads are used
+		const TriangularLevelSchedule& lower_schedule(const matrix_type &A)
+		{
+			if(!m_lowerSchedule.valid() && AlgebraNumThreadsFor(A.num_rows()) > 1)
+				m_lowerSchedule.init_lower(A);
+			return m_lowerSchedule;
+		}
+
+	///	level schedule of the upper triangle of A, only computed if threads are used
+		const TriangularLevelSchedule& upper_schedule(const matrix_type &A)
+		{
+			if(!m_upperSchedule.valid() && AlgebraNumThreadsFor(A.num_rows()) > 1)
+				m_upperSchedule.init_upper(A);
+			return m_upperSchedule;
+		}
+
 	//	Stepping routine
 		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
 		{
@@ -248,6 +274,9 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 	/// for ordering algorithms
 		SmartPtr<ordering_algo_type> m_spOrderingAlgo;
+
+	///	level schedules for threaded sweeps, kept across applications
+		TriangularLevelSchedule m_lowerSchedule, m_upperSchedule;
 #ifdef NOT_YET
 		ordering_container_type m_ordering, m_old_ordering;
 		std::vector<size_t> m_newIndex, m_oldIndex;
@@ -296,7 +325,7 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_LL(A, c, d, relax);
+			gs_step_LL(A, c, d, relax, base_type::lower_schedule(A));
 		}
 };
 
@@ -341,7 +370,7 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_UR(A, c, d, relax);
+			gs_step_UR(A, c, d, relax, base_type::upper_schedule(A));
 		}
 };
 
@@ -375,7 +404,7 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			sgs_step(A, c, d, relax);
+			sgs_step(A, c, d, relax, base_type::lower_schedule(A), base_type::upper_schedule(A));
 		}
 };
 
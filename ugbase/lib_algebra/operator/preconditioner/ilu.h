@@ -53,6 +53,7 @@
 #include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.h" // for backward compatibility
 
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/algebra_common/level_schedule.h"
 
 namespace ug{
 
@@ -226,6 +227,234 @@ bool FactorizeILUSorted(Matrix_type &A, const number eps = 1e-50)
 }
 
 
+/// symbolic phase of the static pattern ILU(0) and ILU(beta) factorizations
+/**
+ * For every elimination step A(i,.) -= A(i,k)/A(k,k) A(k,.) of
+ * FactorizeILUSorted resp. FactorizeILUBeta the storage offsets of A(i,k),
+ * A(k,k) and of all updated entries are computed once by analyze(). As long
+ * as the sparsity pattern does not change, factorize() then only runs the
+ * numeric phase in place, without any search for entries, and computes the
+ * same values as the original functions.
+ *
+ * Since analyze() defragments the matrix, the offsets only depend on the
+ * pattern: a defragmented matrix with the same pattern (see same_pattern)
+ * can be factorized with the same symbolic factorization.
+ */
+template<typename Matrix_type>
+class ILUSymbolicFactorization
+{
+	public:
+		typedef typename Matrix_type::value_type block_type;
+
+		ILUSymbolicFactorization() : m_bLumpFillIn(false) {}
+
+	///	computes the offsets (adds missing diagonal entries and defragments A)
+	/**	\param bLumpFillIn	if true, entries of row k outside the pattern of
+	 * 						row i are collected for lumping (ILU(beta))*/
+		void analyze(Matrix_type &A, bool bLumpFillIn)
+		{
+			PROFILE_FUNC_GROUP("algebra ILU");
+			typedef typename Matrix_type::const_row_iterator const_row_iterator;
+			clear();
+
+			const size_t n = A.num_rows();
+			for(size_t i = 0; i < n; ++i)
+				if(!A.has_connection(i, i)) A(i,i) = 0.0;
+			A.defragment();
+
+			m_bLumpFillIn = bLumpFillIn;
+			m_vRowStart.resize(n+1, 0);
+			if(n == 0) return;
+
+			const Matrix_type &cA = A;
+			const block_type *base = &cA.begin_row(0).value();
+
+			m_vCol.reserve(A.total_num_connections());
+			m_vDiag.resize(n);
+			for(size_t i = 0; i < n; ++i)
+			{
+				m_vRowStart[i] = m_vCol.size();
+				for(const_row_iterator it = cA.begin_row(i); it != cA.end_row(i); ++it)
+					m_vCol.push_back(it.index());
+				m_vDiag[i] = &cA(i,i) - base;
+			}
+			m_vRowStart[n] = m_vCol.size();
+
+			m_vRowStep.resize(n+1);
+			for(size_t i = 0; i < n; ++i)
+			{
+				m_vRowStep[i] = m_vStep.size();
+				if(i == 0) continue;
+
+				const const_row_iterator rowEnd = cA.end_row(i);
+				for(const_row_iterator it_k = cA.begin_row(i); it_k != rowEnd && (it_k.index() < i); ++it_k)
+				{
+					const size_t k = it_k.index();
+					Step step;
+					step.k = k;
+					step.ik = &it_k.value() - base;
+					step.kk = m_vDiag[k];
+
+				//	merge the rest of row i with row k (both sorted)
+					const_row_iterator it_ij(it_k);
+					++it_ij;
+					for(const_row_iterator it_kj = cA.begin_row(k); it_kj != cA.end_row(k); ++it_kj)
+					{
+						const size_t j = it_kj.index();
+						if(j <= k) continue;
+						while(it_ij != rowEnd && it_ij.index() < j) ++it_ij;
+						if(it_ij != rowEnd && it_ij.index() == j)
+							m_vUpdate.push_back(std::make_pair(&it_ij.value() - base, &it_kj.value() - base));
+						else if(m_bLumpFillIn)
+							m_vLump.push_back(&it_kj.value() - base);
+					}
+					step.updateEnd = m_vUpdate.size();
+					step.lumpEnd = m_vLump.size();
+					m_vStep.push_back(step);
+				}
+			}
+			m_vRowStep[n] = m_vStep.size();
+		}
+
+	///	numeric phase: factorizes A in place, A must be the (defragmented) analyzed matrix
+	/**	\param beta	lumping factor for the fill-in, only used if analyzed with bLumpFillIn
+	 * 	\param eps	smallest allowed quotient |A(k,k)| / |A(i,k)| (no check for ILU(beta))*/
+		void factorize(Matrix_type &A, number beta, number eps) const
+		{
+			PROFILE_FUNC_GROUP("algebra ILU");
+			UG_ASSERT(same_pattern(A), "ILUSymbolicFactorization: matrix pattern "
+							"has changed since the analysis.");
+			if(A.num_rows() == 0) return;
+
+			block_type *a = &A.begin_row(0).value();
+			size_t update = 0, lump = 0;
+			for(size_t i = 1; i < A.num_rows(); ++i)
+			{
+				block_type Nii(a[m_vDiag[i]]); Nii *= 0.0;
+
+				for(size_t s = m_vRowStep[i]; s < m_vRowStep[i+1]; ++s)
+				{
+					const Step &step = m_vStep[s];
+					block_type &a_ik = a[step.ik];
+					block_type &a_kk = a[step.kk];
+
+					if(m_bLumpFillIn)
+						a_ik /= a_kk;
+					else
+					{
+						if(fabs(BlockNorm(a_kk)) < eps * BlockNorm(a_ik))
+							UG_THROW("ILU: Blocknorm of diagonal is near-zero for k="<<step.k<<
+							         " with eps: "<< eps <<", ||A_kk||="<<fabs(BlockNorm(a_kk))
+							         <<", ||A_ik||="<<BlockNorm(a_ik));
+
+						try {a_ik /= a_kk;}
+						UG_CATCH_THROW("Failed to calculate A_ik /= A_kk "
+							"with i = " << i << " and k = " << step.k << ".");
+					}
+
+					for(; update < step.updateEnd; ++update)
+						a[m_vUpdate[update].first] -= a_ik * a[m_vUpdate[update].second];
+					for(; lump < step.lumpEnd; ++lump)
+						Nii -= a_ik * a[m_vLump[lump]];
+				}
+
+			// 	add fill-in to diagonal
+				if(m_bLumpFillIn)
+					AddMult(a[m_vDiag[i]], beta, Nii);
+			}
+		}
+
+	///	returns if A has the analyzed pattern and storage layout
+		bool same_pattern(const Matrix_type &A) const
+		{
+			typedef typename Matrix_type::const_row_iterator const_row_iterator;
+			if(!valid() || A.num_rows() + 1 != m_vRowStart.size()
+				|| A.total_num_connections() != m_vCol.size())
+				return false;
+			if(A.num_rows() == 0) return true;
+
+		//	all rows contain the diagonal and are stored consecutively
+			const block_type *base = &A.begin_row(0).value();
+			for(size_t i = 0; i < A.num_rows(); ++i)
+			{
+				const_row_iterator it = A.begin_row(i);
+				if(it == A.end_row(i)
+					|| &it.value() - base != (std::ptrdiff_t) m_vRowStart[i])
+					return false;
+				for(size_t k = m_vRowStart[i]; k < m_vRowStart[i+1]; ++k, ++it)
+					if(it == A.end_row(i) || it.index() != m_vCol[k])
+						return false;
+				if(it != A.end_row(i)) return false;
+			}
+			return true;
+		}
+
+	///	returns if analyzed with lumping of the fill-in
+		bool lumps_fill_in() const {return m_bLumpFillIn;}
+
+	///	returns if analyzed
+		bool valid() const {return !m_vRowStart.empty();}
+
+	///	frees the memory
+		void clear()
+		{
+			m_bLumpFillIn = false;
+			std::vector<size_t>().swap(m_vRowStart);
+			std::vector<size_t>().swap(m_vCol);
+			std::vector<std::ptrdiff_t>().swap(m_vDiag);
+			std::vector<size_t>().swap(m_vRowStep);
+			std::vector<Step>().swap(m_vStep);
+			std::vector<std::pair<std::ptrdiff_t, std::ptrdiff_t> >().swap(m_vUpdate);
+			std::vector<std::ptrdiff_t>().swap(m_vLump);
+		}
+
+	protected:
+	///	elimination step A(i,.) -= A(i,k)/A(k,k) A(k,.)
+		struct Step
+		{
+			size_t k;				///< eliminated column
+			std::ptrdiff_t ik, kk;	///< offsets of A(i,k) and A(k,k)
+			size_t updateEnd;		///< end of the updates of this step in m_vUpdate
+			size_t lumpEnd;			///< end of the lumped entries of this step in m_vLump
+		};
+
+		bool m_bLumpFillIn;
+
+	///	analyzed pattern (columns of row i: [m_vRowStart[i], m_vRowStart[i+1]) )
+		std::vector<size_t> m_vRowStart;
+		std::vector<size_t> m_vCol;
+
+	///	offsets of the diagonal entries
+		std::vector<std::ptrdiff_t> m_vDiag;
+
+	///	elimination steps of row i: [m_vRowStep[i], m_vRowStep[i+1])
+		std::vector<size_t> m_vRowStep;
+		std::vector<Step> m_vStep;
+
+	///	offsets of the pairs (A(i,j), A(k,j)) updated by the steps
+		std::vector<std::pair<std::ptrdiff_t, std::ptrdiff_t> > m_vUpdate;
+
+	///	offsets of the entries A(k,j) lumped onto the diagonal by the steps
+		std::vector<std::ptrdiff_t> m_vLump;
+};
+
+
+// computes row i of x = L^-1 b, requires the rows j < i with a_ij != 0
+template<typename Matrix_type, typename Vector_type>
+inline void invert_L_row(const Matrix_type &A, Vector_type &x, const Vector_type &b, size_t i)
+{
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	typename Vector_type::value_type s;
+	s = b[i];
+	for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+	{
+		if(it.index() >= i) continue;
+		MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+	}
+	x[i] = s;
+}
+
 // solve x = L^-1 b
 // Returns true on success, or false on issues that lead to some changes in the solution
 // (the solution is computed unless no exceptions are thrown)
@@ -233,23 +462,73 @@ template<typename Matrix_type, typename Vector_type>
 bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b)
 {
 	PROFILE_FUNC_GROUP("algebra ILU");
-	typedef typename Matrix_type::const_row_iterator const_row_iterator;
 
-	typename Vector_type::value_type s;
 	for(size_t i=0; i < x.size(); i++)
+		invert_L_row(A, x, b, i);
+
+	return true;
+}
+
+// computes the last row of x = U^-1 * b
+// Returns false if the last diagonal entry of U is near-zero (the entry of x is set to zero then)
+template<typename Matrix_type, typename Vector_type>
+bool invert_U_last_row(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                       const number eps)
+{
+	typename Vector_type::value_type s;
+
+	// last row diagonal U entry might be close to zero with corresponding close to zero rhs
+	// when solving Navier Stokes system, therefore handle separately
+	size_t i=x.size()-1;
+	s = b[i];
+
+	// check if diag part is significantly smaller than rhs
+	// This may happen when matrix is indefinite with one eigenvalue
+	// zero. In that case, the factorization on the last row is
+	// nearly zero due to round-off errors. In order to allow ill-
+	// scaled matrices (i.e. small matrix entries row-wise) this
+	// is compared to the rhs, that is small in this case as well.
+	//TODO: Note that this may happen for problems with naturally
+	// non-zero kernels, e.g. for the Stokes equation. One should
+	// probably suppress this message in those cases but set the
+	// rhs to 0.
+	if (BlockNorm(A(i,i)) <= eps * BlockNorm(s))
 	{
-		s = b[i];
-		for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
-		{
-			if(it.index() >= i) continue;
-			MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
-		}
-		x[i] = s;
+		UG_LOG("ILU Warning: Near-zero last diagonal entry "
+				"with norm "<<BlockNorm(A(i,i))<<" in U "
+				"for non-near-zero rhs entry with norm "
+				<< BlockNorm(s) << ". Setting rhs to zero.\n"
+				"NOTE: Reduce 'eps' using e.g. ILU::set_inversion_eps(...) "
+				"to avoid this warning. Current eps: " << eps << ".\n")
+		// set correction to zero
+		x[i] = 0;
+		return false;
 	}
 
+	// c[i] = s/uii;
+	InverseMatMult(x[i], 1.0, A(i,i), s);
 	return true;
 }
 
+// computes row i of x = U^-1 * b, requires the rows j > i with a_ij != 0
+template<typename Matrix_type, typename Vector_type>
+inline void invert_U_row(const Matrix_type &A, Vector_type &x, const Vector_type &b, size_t i)
+{
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	typename Vector_type::value_type s;
+	s = b[i];
+	for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+	{
+		if(it.index() <= i) continue;
+		// s -= it.value() * x[it.index()];
+		MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+
+	}
+	// x[i] = s/A(i,i);
+	InverseMatMult(x[i], 1.0, A(i,i), s);
+}
+
 // solve x = U^-1 * b
 // Returns true on success, or false on issues that lead to some changes in the solution
 // (the solution is computed unless no exceptions are thrown)
@@ -258,66 +537,79 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 			  const number eps = 1e-8)
 {
 	PROFILE_FUNC_GROUP("algebra ILU");
-	typedef typename Matrix_type::const_row_iterator const_row_iterator;
-
-	typename Vector_type::value_type s;
 
 	bool result = true;
 
-	// last row diagonal U entry might be close to zero with corresponding close to zero rhs
-	// when solving Navier Stokes system, therefore handle separately
 	if(x.size() > 0)
-	{
-		size_t i=x.size()-1;
-		s = b[i];
-
-		// check if diag part is significantly smaller than rhs
-		// This may happen when matrix is indefinite with one eigenvalue
-		// zero. In that case, the factorization on the last row is
-		// nearly zero due to round-off errors. In order to allow ill-
-		// scaled matrices (i.e. small matrix entries row-wise) this
-		// is compared to the rhs, that is small in this case as well.
-		//TODO: Note that this may happen for problems with naturally
-		// non-zero kernels, e.g. for the Stokes equation. One should
-		// probably suppress this message in those cases but set the
-		// rhs to 0.
-		if (BlockNorm(A(i,i)) <= eps * BlockNorm(s))
-		{
-			UG_LOG("ILU Warning: Near-zero last diagonal entry "
-					"with norm "<<BlockNorm(A(i,i))<<" in U "
-					"for non-near-zero rhs entry with norm "
-					<< BlockNorm(s) << ". Setting rhs to zero.\n"
-					"NOTE: Reduce 'eps' using e.g. ILU::set_inversion_eps(...) "
-					"to avoid this warning. Current eps: " << eps << ".\n")
-			// set correction to zero
-			x[i] = 0;
-			result = false;
-		} else {
-			// c[i] = s/uii;
-			InverseMatMult(x[i], 1.0, A(i,i), s);
-		}
-	}
+		result = invert_U_last_row(A, x, b, eps);
 	if(x.size() <= 1) return result;
 
 	// handle all other rows
 	for(size_t i = x.size()-2; ; --i)
 	{
-		s = b[i];
-		for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
-		{
-			if(it.index() <= i) continue;
-			// s -= it.value() * x[it.index()];
-			MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
-
-		}
-		// x[i] = s/A(i,i);
-		InverseMatMult(x[i], 1.0, A(i,i), s);
+		invert_U_row(A, x, b, i);
 		if(i == 0) break;
 	}
 
 	return result;
 }
 
+// row operation of invert_L for RunLevelScheduled
+template<typename Matrix_type, typename Vector_type>
+struct InvertLRow
+{
+	InvertLRow(const Matrix_type &A_, Vector_type &x_, const Vector_type &b_)
+		: A(A_), x(x_), b(b_) {}
+	void operator()(size_t i) {invert_L_row(A, x, b, i);}
+
+	const Matrix_type &A; Vector_type &x; const Vector_type &b;
+};
+
+// row operation of invert_U for RunLevelScheduled, the last row is handled before
+template<typename Matrix_type, typename Vector_type>
+struct InvertURow
+{
+	InvertURow(const Matrix_type &A_, Vector_type &x_, const Vector_type &b_)
+		: A(A_), x(x_), b(b_) {}
+	void operator()(size_t i) {if(i + 1 < x.size()) invert_U_row(A, x, b, i);}
+
+	const Matrix_type &A; Vector_type &x; const Vector_type &b;
+};
+
+// solve x = L^-1 b, with the rows processed level by level on AlgebraNumThreads() threads
+// (same result as invert_L, which is used if the schedule is not valid)
+template<typename Matrix_type, typename Vector_type>
+bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+              const TriangularLevelSchedule &schedule)
+{
+	const int numThreads = AlgebraNumThreadsFor(x.size());
+	if(numThreads == 1 || !schedule.valid() || schedule.num_rows() != x.size())
+		return invert_L(A, x, b);
+
+	PROFILE_FUNC_GROUP("algebra ILU");
+	InvertLRow<Matrix_type, Vector_type> op(A, x, b);
+	RunLevelScheduled(schedule, op, numThreads);
+	return true;
+}
+
+// solve x = U^-1 * b, with the rows processed level by level on AlgebraNumThreads() threads
+// (same result as invert_U, which is used if the schedule is not valid)
+template<typename Matrix_type, typename Vector_type>
+bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+              const number eps, const TriangularLevelSchedule &schedule)
+{
+	const int numThreads = AlgebraNumThreadsFor(x.size());
+	if(numThreads == 1 || !schedule.valid() || schedule.num_rows() != x.size())
+		return invert_U(A, x, b, eps);
+
+	PROFILE_FUNC_GROUP("algebra ILU");
+	const bool result = invert_U_last_row(A, x, b, eps);
+	InvertURow<Matrix_type, Vector_type> op(A, x, b);
+	RunLevelScheduled(schedule, op, numThreads);
+	return result;
+}
+
+
 ///	ILU / ILU(beta) preconditioner
 template <typename TAlgebra>
 class ILU : public IPreconditioner<TAlgebra>
@@ -355,6 +647,8 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_sortEps(1.e-50),
 			m_invEps(1.e-8),
 			m_bDisablePreprocessing(false),
+			m_bReusePattern(false),
+			m_matStamp(0),
 			m_useConsistentInterfaces(false),
 			m_useOverlap(false),
 			m_spOrderingAlgo(SPNULL),
@@ -369,6 +663,8 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_sortEps(parent.m_sortEps),
 			m_invEps(parent.m_invEps),
 			m_bDisablePreprocessing(parent.m_bDisablePreprocessing),
+			m_bReusePattern(parent.m_bReusePattern),
+			m_matStamp(0),
 			m_useConsistentInterfaces(parent.m_useConsistentInterfaces),
 			m_useOverlap(parent.m_useOverlap),
 			m_spOrderingAlgo(parent.m_spOrderingAlgo),
@@ -412,6 +708,17 @@ class ILU : public IPreconditioner<TAlgebra>
 	/// disable preprocessing (if underlying matrix has not changed)
 		void set_disable_preprocessing(bool bDisable)	{m_bDisablePreprocessing = bDisable;}
 
+	///	reuse the symbolic factorization while the matrix pattern is unchanged (default: false)
+	/**	If the sparsity pattern of the matrix has not changed since the last
+	 * preprocess (see SparseMatrix::structure_stamp), only the values are
+	 * copied into the preallocated factor storage and the numeric
+	 * factorization is run. The results are the same as without reuse.*/
+		void set_reuse_pattern(bool bReuse)
+		{
+			m_bReusePattern = bReuse;
+			if(!bReuse) {m_symbolic.clear(); m_vValuePos.clear();}
+		}
+
 	///	sets the smallest allowed value for sorted factorization
 		void set_sort_eps(number eps)					{m_sortEps = eps;}
 
@@ -524,6 +831,13 @@ class ILU : public IPreconditioner<TAlgebra>
 			write_debug(mat, "ILU_PreProcess_orig_A");
 			#endif
 
+		//	only the numeric phase, if the pattern has not changed since the last call
+			if(refill_values(mat))
+			{
+				factorize();
+				return true;
+			}
+
 			m_ILU = mat;
 
 			#ifdef UG_PARALLEL
@@ -561,6 +875,58 @@ class ILU : public IPreconditioner<TAlgebra>
 
 			apply_ordering();
 
+			if(!m_bReusePattern)
+			{
+			//	the level schedules are rebuilt for the new factors on first use
+				m_lowerSchedule.clear();
+				m_upperSchedule.clear();
+
+			//	Debug output of matrices
+				#ifdef UG_PARALLEL
+				write_overlap_debug(m_ILU, "ILU_prep_03_A_BeforeFactorize");
+				#else
+				write_debug(m_ILU, "ILU_PreProcess_U_BeforeFactor");
+				#endif
+
+			// 	Compute ILU Factorization
+				if (m_beta!=0.0) FactorizeILUBeta(m_ILU, m_beta);
+				else if(matrix_type::rows_sorted) FactorizeILUSorted(m_ILU, m_sortEps);
+				else FactorizeILU(m_ILU);
+				m_ILU.defragment();
+
+			//	Debug output of matrices
+				#ifdef UG_PARALLEL
+				write_overlap_debug(m_ILU, "ILU_prep_04_A_AfterFactorize");
+				#else
+				write_debug(m_ILU, "ILU_PreProcess_U_AfterFactor");
+				#endif
+
+				return true;
+			}
+
+		//	symbolic phase, unless the prepared matrix has the analyzed pattern
+		//	(e.g. in parallel, where the matrix is prepared in every call)
+			m_ILU.defragment();
+			if(m_symbolic.lumps_fill_in() != (m_beta != 0.0)
+				|| !m_symbolic.same_pattern(m_ILU))
+			{
+				m_symbolic.analyze(m_ILU, m_beta != 0.0);
+
+			//	the level schedules are rebuilt for the new pattern on first use
+				m_lowerSchedule.clear();
+				m_upperSchedule.clear();
+			}
+			init_value_positions(mat);
+
+			factorize();
+
+		//	we're done
+			return true;
+		}
+
+	///	numeric factorization of m_ILU with the symbolic factorization
+		void factorize()
+		{
 		//	Debug output of matrices
 			#ifdef UG_PARALLEL
 			write_overlap_debug(m_ILU, "ILU_prep_03_A_BeforeFactorize");
@@ -568,12 +934,8 @@ class ILU : public IPreconditioner<TAlgebra>
 			write_debug(m_ILU, "ILU_PreProcess_U_BeforeFactor");
 			#endif
 
-
-		// 	Compute ILU Factorization
-			if (m_beta!=0.0) FactorizeILUBeta(m_ILU, m_beta);
-			else if(matrix_type::rows_sorted) FactorizeILUSorted(m_ILU, m_sortEps);
-			else FactorizeILU(m_ILU);
-			m_ILU.defragment();
+			const number eps = matrix_type::rows_sorted ? m_sortEps : 1e-15;
+			m_symbolic.factorize(m_ILU, m_beta, eps);
 
 		//	Debug output of matrices
 			#ifdef UG_PARALLEL
@@ -581,21 +943,81 @@ class ILU : public IPreconditioner<TAlgebra>
 			#else
 			write_debug(m_ILU, "ILU_PreProcess_U_AfterFactor");
 			#endif
+		}
 
-		//	we're done
-			return true;
+	///	computes the positions of the entries of mat in m_ILU, if m_ILU is a permuted copy of mat
+		void init_value_positions(const matrix_type &mat)
+		{
+			m_vValuePos.clear();
+			m_matStamp = 0;
+
+		//	the prepared matrix has to contain exactly the entries of mat
+			if(m_useOverlap || m_ILU.total_num_connections() != mat.total_num_connections()
+				|| mat.num_rows() == 0)
+				return;
+			#ifdef UG_PARALLEL
+			if(pcl::NumProcs() > 1) return;
+			#endif
+
+			const matrix_type &ilu = m_ILU;
+			const bool bPermuted = m_spOrderingAlgo.valid() && !m_bSortIsIdentity;
+			const typename matrix_type::value_type *base = &ilu.begin_row(0).value();
+			m_vValuePos.reserve(mat.total_num_connections());
+			for(size_t r = 0; r < mat.num_rows(); ++r)
+			{
+				const size_t Pr = bPermuted ? m_ordering[r] : r;
+				for(typename matrix_type::const_row_iterator it = mat.begin_row(r); it != mat.end_row(r); ++it)
+				{
+					const size_t Pc = bPermuted ? m_ordering[it.index()] : it.index();
+					m_vValuePos.push_back(&ilu(Pr, Pc) - base);
+				}
+			}
+			m_matStamp = mat.structure_stamp();
 		}
 
+	///	copies the values of mat into m_ILU, if the pattern of mat and the ordering are unchanged
+		bool refill_values(matrix_type &mat)
+		{
+			const matrix_type &cmat = mat;
+			if(!m_bReusePattern || m_vValuePos.empty()
+				|| m_symbolic.lumps_fill_in() != (m_beta != 0.0)
+				|| cmat.structure_stamp() != m_matStamp)
+				return false;
+
+		//	the ordering may depend on the values
+			if(m_spOrderingAlgo.valid())
+			{
+				if (m_u) m_spOrderingAlgo->init(&mat, *m_u);
+				else m_spOrderingAlgo->init(&mat);
+				m_spOrderingAlgo->compute();
+				if(m_spOrderingAlgo->ordering() != m_ordering)
+					return false;
+			}
+
+			PROFILE_BEGIN_GROUP(ILU_refill_values, "algebra ILU");
+			typename matrix_type::value_type *a = &m_ILU.begin_row(0).value();
+			size_t k = 0;
+			for(size_t r = 0; r < cmat.num_rows(); ++r)
+				for(typename matrix_type::const_row_iterator it = cmat.begin_row(r); it != cmat.end_row(r); ++it)
+					a[m_vValuePos[k++]] = it.value();
+			return true;
+		}
 
 		void applyLU(vector_type &c, const vector_type &d, vector_type &tmp)
 		{
+		//	level schedules of the factors, only needed if threads are used
+			if(AlgebraNumThreadsFor(m_ILU.num_rows()) > 1 && !m_lowerSchedule.valid())
+			{
+				m_lowerSchedule.init_lower(m_ILU);
+				m_upperSchedule.init_upper(m_ILU);
+			}
 
 			if(m_spOrderingAlgo.invalid() || m_bSortIsIdentity)
 			{
 				// 	apply iterator: c = LU^{-1}*d
-				if(! invert_L(m_ILU, tmp, d)) // h := L^-1 d
+				if(! invert_L(m_ILU, tmp, d, m_lowerSchedule)) // h := L^-1 d
 					print_debugger_message("ILU: There were issues at inverting L\n");
-				if(! invert_U(m_ILU, c, tmp, m_invEps)) // c := U^-1 h = (LU)^-1 d
+				if(! invert_U(m_ILU, c, tmp, m_invEps, m_upperSchedule)) // c := U^-1 h = (LU)^-1 d
 					print_debugger_message("ILU: There were issues at inverting U\n");
 			}
 ///*
@@ -603,9 +1025,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			{
 				// we save one vector here by renaming
 				SetVectorAsPermutation(tmp, d, m_ordering);
-				if(! invert_L(m_ILU, c, tmp)) // c = L^{-1} d
+				if(! invert_L(m_ILU, c, tmp, m_lowerSchedule)) // c = L^{-1} d
 					print_debugger_message("ILU: There were issues at inverting L (after permutation)\n");
-				if(! invert_U(m_ILU, tmp, c, m_invEps)) // tmp = (LU)^{-1} d
+				if(! invert_U(m_ILU, tmp, c, m_invEps, m_upperSchedule)) // tmp = (LU)^{-1} d
 					print_debugger_message("ILU: There were issues at inverting U (after permutation)\n");
 				SetVectorAsPermutation(c, tmp, m_old_ordering);
 			}
@@ -724,6 +1146,14 @@ class ILU : public IPreconditioner<TAlgebra>
 	/// whether or not to disable preprocessing
 		bool m_bDisablePreprocessing;
 
+	///	symbolic factorization, reused while the pattern is unchanged
+		bool m_bReusePattern;
+		ILUSymbolicFactorization<matrix_type> m_symbolic;
+
+	///	positions of the entries of the last matrix in m_ILU, and its structure stamp
+		std::vector<std::ptrdiff_t> m_vValuePos;
+		size_t m_matStamp;
+
 		bool m_useConsistentInterfaces;
 		bool m_useOverlap;
 
@@ -733,6 +1163,9 @@ class ILU : public IPreconditioner<TAlgebra>
 		std::vector<size_t> m_newIndex, m_oldIndex;
 		bool m_bSortIsIdentity;
 
+	///	level schedules of the factors for threaded triangular solves
+		TriangularLevelSchedule m_lowerSchedule, m_upperSchedule;
+
 		const vector_type* m_u;
 };
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include "ilu_benchmark.h"
+#include "ilu.h"
+#include "ilut.h"
+#include "common/common.h"
+#include "common/stopwatch.h"
+#include "lib_algebra/cpu_algebra_types.h"
+
+namespace ug{
+
+typedef CPUAlgebra::matrix_type BenchmarkMatrix;
+typedef CPUAlgebra::vector_type BenchmarkVector;
+
+///	assembles the matrix of Newton step 'step' into the given pattern
+static void AssembleBenchmarkMatrix(BenchmarkMatrix &A, size_t m, size_t step)
+{
+	const size_t n = m*m;
+	if(A.num_rows() == n)
+		A.clear_retain_structure();
+	else
+		A.resize_and_clear(n, n);
+
+	for(size_t i = 0; i < m; ++i)
+		for(size_t j = 0; j < m; ++j)
+		{
+			const size_t r = i*m + j;
+		//	solution dependent diffusion and convection
+			const double k = 1.0 + 0.5*std::sin(0.01*r + 0.7*step);
+			const double v = 0.4*std::cos(0.02*r + 0.3*step);
+			A(r, r) = 4.0*k + 0.1;
+			if(i > 0) A(r, r-m) = -k - v;
+			if(i+1 < m) A(r, r+m) = -k + v;
+			if(j > 0) A(r, r-1) = -k - 0.5*v;
+			if(j+1 < m) A(r, r+1) = -k + 0.5*v;
+		}
+	A.defragment();
+}
+
+///	runs the Newton steps for one preconditioner, c is the preconditioned defect of the last step
+static void BenchmarkSetup(const char *name, ILinearIterator<BenchmarkVector> &precond,
+                           size_t m, size_t numSteps, BenchmarkVector &c)
+{
+	SmartPtr<MatrixOperator<BenchmarkMatrix, BenchmarkVector> > spOp =
+			make_sp(new MatrixOperator<BenchmarkMatrix, BenchmarkVector>());
+	BenchmarkMatrix &A = spOp->get_matrix();
+	const size_t n = m*m;
+
+	double firstTime = 0.0, followTime = 0.0;
+	for(size_t step = 0; step < numSteps; ++step)
+	{
+		AssembleBenchmarkMatrix(A, m, step);
+#ifdef UG_PARALLEL
+		A.set_storage_type(PST_ADDITIVE);
+		A.set_layouts(CreateLocalAlgebraLayouts());
+#endif
+		Stopwatch sw;
+		sw.start();
+		precond.init(spOp);
+		const double ms = sw.ms();
+		if(step == 0) firstTime = ms;
+		else followTime += ms;
+	}
+
+	BenchmarkVector d(n);
+	c.resize(n);
+	for(size_t i = 0; i < n; ++i) d[i] = std::sin(0.37*i);
+#ifdef UG_PARALLEL
+	d.set_storage_type(PST_ADDITIVE);
+	d.set_layouts(CreateLocalAlgebraLayouts());
+	c.set_storage_type(PST_CONSISTENT);
+	c.set_layouts(CreateLocalAlgebraLayouts());
+#endif
+	precond.apply(c, d);
+
+	UG_LOG(std::setw(28) << std::left << name << std::right
+			<< " first step: " << std::setw(9) << std::setprecision(4) << firstTime << " ms,"
+			<< " following steps: " << std::setw(9) << std::setprecision(4)
+			<< (numSteps > 1 ? followTime / (numSteps - 1) : 0.0) << " ms");
+}
+
+///	prints the maximal difference of the results with and without reuse
+static void PrintReuseResult(const BenchmarkVector &c, const BenchmarkVector &cRef)
+{
+	double maxDiff = 0.0;
+	for(size_t i = 0; i < c.size(); ++i)
+		maxDiff = std::max(maxDiff, std::fabs(c[i] - cRef[i]));
+	UG_LOG(",  max |c - c_noreuse| = " << std::setprecision(3) << maxDiff << "\n");
+}
+
+void ILUSetupBenchmark(size_t n, size_t numSteps)
+{
+	UG_COND_THROW(n == 0 || numSteps == 0, "ILUSetupBenchmark: n and "
+					"numSteps must be positive.");
+
+//	use a square grid for the 5-point stencil
+	const size_t m = (size_t) std::sqrt((double) n);
+	n = m*m;
+	UG_LOG("ILUSetupBenchmark: n = " << n << ", Newton steps = " << numSteps << "\n");
+
+	BenchmarkVector cRef, c;
+
+	{
+		ILU<CPUAlgebra> ilu;
+		BenchmarkSetup("ILU", ilu, m, numSteps, cRef);
+		UG_LOG("\n");
+	}
+	{
+		ILU<CPUAlgebra> ilu;
+		ilu.set_reuse_pattern(true);
+		BenchmarkSetup("ILU, reuse pattern", ilu, m, numSteps, c);
+		PrintReuseResult(c, cRef);
+	}
+	{
+		ILU<CPUAlgebra> ilu(0.5);
+		BenchmarkSetup("ILU(beta=0.5)", ilu, m, numSteps, cRef);
+		UG_LOG("\n");
+	}
+	{
+		ILU<CPUAlgebra> ilu(0.5);
+		ilu.set_reuse_pattern(true);
+		BenchmarkSetup("ILU(beta=0.5), reuse pattern", ilu, m, numSteps, c);
+		PrintReuseResult(c, cRef);
+	}
+	{
+		ILUTPreconditioner<CPUAlgebra> ilut(1e-3);
+		ilut.set_show_progress(false);
+		BenchmarkSetup("ILUT(1e-3)", ilut, m, numSteps, cRef);
+		UG_LOG("\n");
+	}
+	{
+		ILUTPreconditioner<CPUAlgebra> ilut(1e-3);
+		ilut.set_show_progress(false);
+		ilut.set_reuse_pattern(true);
+		BenchmarkSetup("ILUT(1e-3), reuse pattern", ilut, m, numSteps, c);
+		PrintReuseResult(c, cRef);
+	}
+}
+
+} // end namespace ug
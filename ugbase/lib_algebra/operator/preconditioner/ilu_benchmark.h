@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_BENCHMARK__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__ILU_BENCHMARK__
+
+#include <cstddef>
+
+namespace ug{
+
+///	benchmarks the setup of ILU and ILUT in a sequence of Newton steps
+/**
+ * Assembles a convection-diffusion 5-point stencil on a square grid whose
+ * coefficients change in every step (the pattern is kept, as done by the
+ * assembling with cached matrix structure) and initializes ILU, ILU(beta)
+ * and ILUT with and without reuse of the symbolic factorization
+ * (set_reuse_pattern). Prints the setup time of the first step and the mean
+ * setup time of the following steps, and the maximal difference of the
+ * preconditioned defects compared to the setup without reuse.
+ *
+ * \param[in]	n			number of unknowns
+ * \param[in]	numSteps	number of Newton steps
+ */
+void ILUSetupBenchmark(size_t n, size_t numSteps);
+
+} // end namespace ug
+
+#endif
@@ -58,7 +58,8 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 	public:
 	///	Constructor
 		ILUTPreconditioner(double eps=1e-6)
-			: m_eps(eps), m_info(false), m_show_progress(true), m_bSortIsIdentity(false)
+			: m_eps(eps), m_info(false), m_show_progress(true), m_bSortIsIdentity(false),
+			  m_bReusePattern(false), m_matStamp(0), m_inputStamp(0)
 		{
 			//default was set true
 			m_spOrderingAlgo = make_sp(new NativeCuthillMcKeeOrdering<TAlgebra, ordering_container_type>());
@@ -71,6 +72,9 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			m_eps = parent.m_eps;
 			set_info(parent.m_info);
 			m_bSortIsIdentity = parent.m_bSortIsIdentity;
+			m_bReusePattern = parent.m_bReusePattern;
+			m_matStamp = 0;
+			m_inputStamp = 0;
 		}
 
 	///	Clone
@@ -105,6 +109,17 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			m_show_progress = s;
 		}
 
+	///	reuse ordering and L/U pattern while the matrix pattern is unchanged (default: false)
+	/**	If the sparsity pattern of the matrix has not changed since the last
+	 * preprocess (see SparseMatrix::structure_stamp), the ordering and the
+	 * pattern of L and U determined by the threshold are kept and only the
+	 * values are computed, in place. Fill-in outside of the old pattern is
+	 * dropped, so the factors may differ from a new ILUT factorization.*/
+		void set_reuse_pattern(bool bReuse)
+		{
+			m_bReusePattern = bReuse;
+		}
+
 		virtual std::string config_string() const
 		{
 			std::stringstream ss;
@@ -191,6 +206,9 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 		virtual bool preprocess_mat(matrix_type &mat)
 		{
 #ifdef 	UG_PARALLEL
+		//	the pattern reuse is keyed on the original matrix
+			m_inputStamp = mat.structure_stamp();
+
 			matrix_type m2;
 			m2 = mat;
 
@@ -241,6 +259,13 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			STATIC_ASSERT(matrix_type::rows_sorted, Matrix_has_to_have_sorted_rows);
 			write_debug(mat, "ILUT_PreprocessIn");
 
+		//	only the numeric phase, if the pattern has not changed since the last call
+			const size_t stamp = (m_inputStamp != 0) ? m_inputStamp : mat.structure_stamp();
+			m_inputStamp = 0;
+			if(m_bReusePattern && stamp == m_matStamp && refactorize(mat))
+				return true;
+			m_matStamp = 0;
+
 			matrix_type* A;
 			matrix_type permA;
 
@@ -396,6 +421,7 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 				m_L.defragment();
 				m_U.defragment();
 			}
+			m_matStamp = stamp;
 
 			if (m_info==true)
 			{
@@ -420,6 +446,78 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			return true;
 		}
 
+	protected:
+	///	numeric ILUT factorization of mat into the L/U pattern of the last factorization
+	/**	Uses the ordering of the last factorization. Returns false if mat has
+	 * entries outside of the pattern of L+U (e.g. after changes of the
+	 * parallel layouts), then a full factorization is needed.*/
+		bool refactorize(const matrix_type &mat)
+		{
+			PROFILE_BEGIN_GROUP(ILUT_refactorize, "ilut algebra");
+			const size_t n = mat.num_rows();
+			if(n == 0 || n != m_L.num_rows() || n != m_U.num_rows()
+				|| mat.num_cols() != m_U.num_cols())
+				return false;
+
+			const bool bPermuted = m_spOrderingAlgo.valid() && !m_bSortIsIdentity;
+			m_vPos.assign(m_U.num_cols(), NULL);
+
+			for(size_t i = 0; i < n; ++i)
+			{
+			//	clear the pattern of row i of L and U and mark its columns
+				for(matrix_row_iterator it = m_L.begin_row(i); it != m_L.end_row(i); ++it)
+				{
+					it.value() = 0.0;
+					m_vPos[it.index()] = &it.value();
+				}
+				for(matrix_row_iterator it = m_U.begin_row(i); it != m_U.end_row(i); ++it)
+				{
+					it.value() = 0.0;
+					m_vPos[it.index()] = &it.value();
+				}
+
+			//	get the row A(i, .) of the reordered matrix
+				const size_t r = bPermuted ? m_old_ordering[i] : i;
+				UG_COND_THROW(mat.num_connections(r) == 0, "row " << i << " has no connections");
+				bool bInPattern = true;
+				for(const_matrix_row_iterator it = mat.begin_row(r); it != mat.end_row(r); ++it)
+				{
+					const size_t j = bPermuted ? m_ordering[it.index()] : it.index();
+					if(m_vPos[j] == NULL) {bInPattern = false; break;}
+					*m_vPos[j] = it.value();
+				}
+
+			//	eliminate all entries L(i, k) with rows U(k, .), fill-in outside of the pattern is dropped
+				if(bInPattern)
+					for(matrix_row_iterator it_k = m_L.begin_row(i); it_k != m_L.end_row(i); ++it_k)
+					{
+						if(it_k.value() == 0.0) continue;
+						const size_t k = it_k.index();
+						matrix_row_iterator k_it = m_U.begin_row(k);
+						UG_COND_THROW(!(m_U.num_connections(k) != 0 && k_it.index() == k), "");
+
+						it_k.value() = it_k.value() / k_it.value();
+						const block_type d = it_k.value();
+						UG_COND_THROW(!BlockMatrixFiniteAndNotTooBig(d, 1e40), "i = " << i << " " << d);
+
+						for(++k_it; k_it != m_U.end_row(k); ++k_it)
+						{
+							block_type *p = m_vPos[k_it.index()];
+							if(p != NULL) *p -= k_it.value() * d;
+						}
+					}
+
+				for(matrix_row_iterator it = m_L.begin_row(i); it != m_L.end_row(i); ++it)
+					m_vPos[it.index()] = NULL;
+				for(matrix_row_iterator it = m_U.begin_row(i); it != m_U.end_row(i); ++it)
+					m_vPos[it.index()] = NULL;
+
+				if(!bInPattern) return false;
+			}
+			return true;
+		}
+
+	public:
 	//	Stepping routine
 		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
 		{
@@ -627,6 +725,12 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 
 		bool m_bSortIsIdentity;
 
+	///	reuse of ordering and L/U pattern, keyed on the structure stamp of the matrix
+		bool m_bReusePattern;
+		size_t m_matStamp;
+		size_t m_inputStamp;
+		std::vector<block_type*> m_vPos;
+
 		const vector_type* m_u;
 };
 
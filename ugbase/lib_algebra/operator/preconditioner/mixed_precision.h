@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__
+
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+///	Preconditioner working in single precision on a float copy of the matrix
+/**
+ * This preconditioner copies the (scalar, double) matrix into a matrix with
+ * float entries and applies a float preconditioner (e.g. ILU, Gauss-Seidel
+ * or Jacobi of the CPUFloatAlgebra) to it. The matrix factors and smoother
+ * copies thus need only half of the memory bandwidth. The defect is rounded
+ * to float on entry, the correction is converted back to double on exit.
+ * Optionally, several inner steps are performed in float (the inner defect
+ * is updated with the float matrix).
+ *
+ * Used in the LinearSolver, this results in a mixed precision iterative
+ * refinement: the residuals are computed in double with the original
+ * matrix, while factorization and smoothing are done in float. It can also
+ * be used within the Krylov solvers.
+ *
+ * \tparam 	TAlgebra		(scalar) algebra type
+ */
+template <typename TAlgebra>
+class MixedPrecision : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Float algebra type
+		typedef CPUFloatAlgebra float_algebra_type;
+
+	///	Float vector type
+		typedef float_algebra_type::vector_type float_vector_type;
+
+	///	Float matrix type
+		typedef float_algebra_type::matrix_type float_matrix_type;
+
+	///	Float preconditioner type
+		typedef IPreconditioner<float_algebra_type> float_precond_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	public:
+	///	default constructor
+		MixedPrecision() : m_numInnerSteps(1) {}
+
+	///	constructor setting the float preconditioner
+		MixedPrecision(SmartPtr<float_precond_type> spPrecond)
+			: m_spPrecond(spPrecond), m_numInnerSteps(1) {}
+
+	/// clone constructor
+		MixedPrecision(const MixedPrecision<TAlgebra> &parent)
+			: base_type(parent), m_numInnerSteps(parent.m_numInnerSteps)
+		{
+			SmartPtr<float_precond_type> spPrecond = parent.m_spPrecond;
+			if(spPrecond.valid())
+				m_spPrecond = spPrecond->clone().template cast_dynamic<float_precond_type>();
+		}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new MixedPrecision<algebra_type>(*this));
+		}
+
+	///	Destructor
+		virtual ~MixedPrecision() {}
+
+	///	sets the preconditioner working on the float matrix
+		void set_preconditioner(SmartPtr<float_precond_type> spPrecond) {m_spPrecond = spPrecond;}
+
+	///	sets the number of steps of the float preconditioner per application
+		void set_num_inner_steps(size_t numSteps)
+		{
+			UG_COND_THROW(numSteps == 0, "MixedPrecision: At least one inner step needed.");
+			m_numInnerSteps = numSteps;
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			return m_spPrecond.valid() && m_spPrecond->supports_parallel();
+		}
+
+		virtual std::string config_string() const
+		{
+			std::stringstream ss;
+			ss << "MixedPrecision (float storage, " << m_numInnerSteps << " inner step(s)) ";
+			if(m_spPrecond.valid()) ss << "with " << m_spPrecond->config_string();
+			else ss << "without float preconditioner";
+			return ss.str();
+		}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "MixedPrecision";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(MixedPrecision_preprocess, "algebra MixedPrecision");
+			UG_COND_THROW(m_spPrecond.invalid(), "MixedPrecision: No float preconditioner set.");
+
+		//	copy matrix to float
+			const matrix_type& A = *pOp;
+			m_spFloatOp = make_sp(new MatrixOperator<float_matrix_type, float_vector_type>());
+			float_matrix_type& Af = m_spFloatOp->get_matrix();
+			Af.resize_and_clear(A.num_rows(), A.num_cols());
+
+			std::vector<typename float_matrix_type::connection> vCon;
+			for(size_t i = 0; i < A.num_rows(); ++i)
+			{
+				vCon.clear();
+				for(typename matrix_type::const_row_iterator conn = A.begin_row(i);
+						conn != A.end_row(i); ++conn)
+				{
+					typename float_matrix_type::connection c;
+					c.iIndex = conn.index();
+					c.dValue = (float) conn.value();
+					vCon.push_back(c);
+				}
+				if(!vCon.empty())
+					Af.set_matrix_row(i, &vCon[0], vCon.size());
+			}
+			Af.defragment();
+
+		//	float help vectors
+			m_d.resize(A.num_rows()); m_c.resize(A.num_rows());
+			if(m_numInnerSteps > 1) m_cSum.resize(A.num_rows());
+			#ifdef UG_PARALLEL
+			Af.set_layouts(A.layouts());
+			Af.set_storage_type(A.get_storage_mask());
+			m_d.set_layouts(A.layouts());
+			m_c.set_layouts(A.layouts());
+			m_cSum.set_layouts(A.layouts());
+			#endif
+
+		//	init float preconditioner
+			if(!m_spPrecond->init(m_spFloatOp))
+			{
+				UG_LOG("MixedPrecision: Cannot init float preconditioner.\n");
+				return false;
+			}
+			return true;
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(MixedPrecision_step, "algebra MixedPrecision");
+
+		//	round defect to float
+			for(size_t i = 0; i < d.size(); ++i) m_d[i] = (float) d[i];
+			#ifdef UG_PARALLEL
+			m_d.set_storage_type(d.get_storage_mask());
+			#endif
+
+		//	apply float preconditioner
+			float_vector_type* pC = &m_c;
+			if(m_numInnerSteps == 1)
+			{
+				if(!m_spPrecond->apply(m_c, m_d)) return false;
+			}
+			else
+			{
+				m_cSum.set(0.0);
+				for(size_t k = 0; k < m_numInnerSteps; ++k)
+				{
+					if(!m_spPrecond->apply_update_defect(m_c, m_d)) return false;
+					#ifdef UG_PARALLEL
+					if(k == 0) m_cSum.set_storage_type(m_c.get_storage_mask());
+					#endif
+					m_cSum += m_c;
+				}
+				pC = &m_cSum;
+			}
+
+		//	correction back to double
+			const float_vector_type& cf = *pC;
+			for(size_t i = 0; i < c.size(); ++i) c[i] = cf[i];
+			#ifdef UG_PARALLEL
+			c.set_storage_type(cf.get_storage_mask());
+			#endif
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	preconditioner working on the float matrix
+		SmartPtr<float_precond_type> m_spPrecond;
+
+	///	float copy of the matrix
+		SmartPtr<MatrixOperator<float_matrix_type, float_vector_type> > m_spFloatOp;
+
+	///	float defect and corrections
+		float_vector_type m_d, m_c, m_cSum;
+
+	///	number of inner steps
+		size_t m_numInnerSteps;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__ */
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "native_nested_dissection.h"
+
+namespace ug{
+
+namespace{
+
+///	breadth-first level structure of a connected part of a subdomain
+struct NDLevelStructure
+{
+///	indices in breadth-first order
+	std::vector<size_t> vOrder;
+
+///	begin of each level in vOrder, the last entry is vOrder.size()
+	std::vector<size_t> vLevelStart;
+
+	size_t num_levels() const {return vLevelStart.size() - 1;}
+};
+
+///	subdomain still to be dissected, numbered starting from firstIndex
+struct NDSubdomain
+{
+	std::vector<size_t> vInd;
+	size_t firstIndex;
+};
+
+///	helper performing the dissection on the symmetrized index graph
+class NestedDissection
+{
+	public:
+		NestedDissection(const std::vector<std::vector<size_t> >& vvNeighbour)
+			: m_visitStamp(0)
+		{
+			const size_t n = vvNeighbour.size();
+
+		//	symmetrize the adjacency and store it in compressed form
+			std::vector<std::vector<size_t> > vvAdj(n);
+			for(size_t i = 0; i < n; ++i)
+				for(size_t k = 0; k < vvNeighbour[i].size(); ++k)
+				{
+					const size_t j = vvNeighbour[i][k];
+					UG_COND_THROW(j >= n, "ComputeNestedDissectionOrder: neighbor index "
+								<< j << " of index " << i << " out of range.");
+					if(j == i) continue;
+					vvAdj[i].push_back(j);
+					vvAdj[j].push_back(i);
+				}
+
+			m_vAdjStart.resize(n + 1);
+			m_vAdjStart[0] = 0;
+			for(size_t i = 0; i < n; ++i)
+			{
+				std::sort(vvAdj[i].begin(), vvAdj[i].end());
+				vvAdj[i].erase(std::unique(vvAdj[i].begin(), vvAdj[i].end()), vvAdj[i].end());
+				m_vAdjStart[i+1] = m_vAdjStart[i] + vvAdj[i].size();
+			}
+
+			m_vAdj.resize(m_vAdjStart[n]);
+			for(size_t i = 0; i < n; ++i)
+			{
+				std::copy(vvAdj[i].begin(), vvAdj[i].end(), m_vAdj.begin() + m_vAdjStart[i]);
+				std::vector<size_t>().swap(vvAdj[i]);
+			}
+
+			m_vDomain.resize(n, 0);
+			m_vVisited.resize(n, 0);
+			m_vLevel.resize(n, 0);
+		}
+
+		void compute(std::vector<size_t>& vNewIndex, size_t minSubdomainSize)
+		{
+			const size_t n = m_vAdjStart.size() - 1;
+			vNewIndex.resize(n);
+			if(n == 0) return;
+
+			size_t domain = 0;
+			std::vector<NDSubdomain> vStack(1);
+			vStack.back().firstIndex = 0;
+			vStack.back().vInd.resize(n);
+			for(size_t i = 0; i < n; ++i) vStack.back().vInd[i] = i;
+
+			NDLevelStructure ls;
+			while(!vStack.empty())
+			{
+				NDSubdomain sd;
+				sd.vInd.swap(vStack.back().vInd);
+				sd.firstIndex = vStack.back().firstIndex;
+				vStack.pop_back();
+
+				const size_t size = sd.vInd.size();
+				if(size == 0) continue;
+
+			//	mark the indices of the subdomain, start with an index of minimal degree
+				++domain;
+				size_t root = sd.vInd[0];
+				for(size_t k = 0; k < size; ++k)
+				{
+					m_vDomain[sd.vInd[k]] = domain;
+					if(degree(sd.vInd[k]) < degree(root)) root = sd.vInd[k];
+				}
+
+				find_pseudo_peripheral(root, domain, ls);
+
+			//	disconnected subdomain: continue with each connected component
+				if(ls.vOrder.size() < size)
+				{
+					const size_t sdDomain = domain;
+					size_t firstIndex = sd.firstIndex;
+					for(size_t k = 0; k < size; ++k)
+					{
+						if(m_vDomain[sd.vInd[k]] != sdDomain) continue;
+						build_level_structure(sd.vInd[k], sdDomain, ls);
+
+						++domain;
+						for(size_t c = 0; c < ls.vOrder.size(); ++c)
+							m_vDomain[ls.vOrder[c]] = domain;
+
+						vStack.push_back(NDSubdomain());
+						vStack.back().vInd = ls.vOrder;
+						vStack.back().firstIndex = firstIndex;
+						firstIndex += ls.vOrder.size();
+					}
+					continue;
+				}
+
+			//	small or elongated subdomain: number in reverse breadth-first order
+				const size_t numLevels = ls.num_levels();
+				if(size <= minSubdomainSize || numLevels < 3)
+				{
+					for(size_t k = 0; k < size; ++k)
+						vNewIndex[ls.vOrder[size - 1 - k]] = sd.firstIndex + k;
+					continue;
+				}
+
+			//	choose the level splitting the subdomain into halves as separator
+				size_t sep = 1;
+				while(sep < numLevels - 2 && ls.vLevelStart[sep+1] < size / 2)
+					++sep;
+
+			//	indices of the separating level without connection to the
+			//	levels behind it belong to the first part
+				NDSubdomain first, second;
+				std::vector<size_t> vSeparator;
+				first.vInd.assign(ls.vOrder.begin(), ls.vOrder.begin() + ls.vLevelStart[sep]);
+				second.vInd.assign(ls.vOrder.begin() + ls.vLevelStart[sep+1], ls.vOrder.end());
+				for(size_t k = ls.vLevelStart[sep]; k < ls.vLevelStart[sep+1]; ++k)
+				{
+					const size_t v = ls.vOrder[k];
+					bool bSeparating = false;
+					for(size_t a = m_vAdjStart[v]; a < m_vAdjStart[v+1]; ++a)
+					{
+						const size_t w = m_vAdj[a];
+						if(m_vVisited[w] == m_visitStamp && m_vLevel[w] == sep + 1)
+						{
+							bSeparating = true;
+							break;
+						}
+					}
+					if(bSeparating) vSeparator.push_back(v);
+					else first.vInd.push_back(v);
+				}
+
+			//	separator indices are eliminated after both parts
+				first.firstIndex = sd.firstIndex;
+				second.firstIndex = first.firstIndex + first.vInd.size();
+				const size_t sepStart = second.firstIndex + second.vInd.size();
+				for(size_t k = 0; k < vSeparator.size(); ++k)
+					vNewIndex[vSeparator[k]] = sepStart + k;
+
+				vStack.push_back(NDSubdomain());
+				vStack.back().vInd.swap(second.vInd);
+				vStack.back().firstIndex = second.firstIndex;
+
+				vStack.push_back(NDSubdomain());
+				vStack.back().vInd.swap(first.vInd);
+				vStack.back().firstIndex = first.firstIndex;
+			}
+		}
+
+	private:
+		size_t degree(size_t v) const {return m_vAdjStart[v+1] - m_vAdjStart[v];}
+
+	///	builds the level structure rooted at root, restricted to the subdomain
+		void build_level_structure(size_t root, size_t domain, NDLevelStructure& ls)
+		{
+			++m_visitStamp;
+			ls.vOrder.clear();
+			ls.vLevelStart.clear();
+
+			ls.vOrder.push_back(root);
+			m_vVisited[root] = m_visitStamp;
+			m_vLevel[root] = 0;
+
+			size_t levelBegin = 0, level = 0;
+			while(levelBegin < ls.vOrder.size())
+			{
+				ls.vLevelStart.push_back(levelBegin);
+				const size_t levelEnd = ls.vOrder.size();
+				for(size_t k = levelBegin; k < levelEnd; ++k)
+				{
+					const size_t v = ls.vOrder[k];
+					for(size_t a = m_vAdjStart[v]; a < m_vAdjStart[v+1]; ++a)
+					{
+						const size_t w = m_vAdj[a];
+						if(m_vDomain[w] != domain || m_vVisited[w] == m_visitStamp)
+							continue;
+						m_vVisited[w] = m_visitStamp;
+						m_vLevel[w] = level + 1;
+						ls.vOrder.push_back(w);
+					}
+				}
+				levelBegin = levelEnd;
+				++level;
+			}
+			ls.vLevelStart.push_back(ls.vOrder.size());
+		}
+
+	///	searches a root with (almost) maximal eccentricity, leaves its level structure in ls
+		void find_pseudo_peripheral(size_t root, size_t domain, NDLevelStructure& ls)
+		{
+			build_level_structure(root, domain, ls);
+			for(size_t it = 0; it < 8; ++it)
+			{
+				const size_t numLevels = ls.num_levels();
+
+			//	candidate of minimal degree in the last level
+				size_t cand = ls.vOrder[ls.vLevelStart[numLevels-1]];
+				for(size_t k = ls.vLevelStart[numLevels-1]; k < ls.vOrder.size(); ++k)
+					if(degree(ls.vOrder[k]) < degree(cand)) cand = ls.vOrder[k];
+				if(cand == root) break;
+
+			//	the eccentricity of the candidate is at least the one of root
+				build_level_structure(cand, domain, ls);
+				root = cand;
+				if(ls.num_levels() <= numLevels) break;
+			}
+		}
+
+		std::vector<size_t> m_vAdjStart, m_vAdj;
+		std::vector<size_t> m_vDomain, m_vVisited, m_vLevel;
+		size_t m_visitStamp;
+};
+
+} // end anonymous namespace
+
+
+void ComputeNestedDissectionOrder(std::vector<size_t>& vNewIndex,
+                                  const std::vector<std::vector<size_t> >& vvNeighbour,
+                                  size_t minSubdomainSize)
+{
+	PROFILE_FUNC();
+	NestedDissection nd(vvNeighbour);
+	nd.compute(vNewIndex, std::max(minSubdomainSize, (size_t) 1));
+}
+
+} // end namespace ug
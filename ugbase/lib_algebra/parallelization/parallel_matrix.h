@@ -40,10 +40,37 @@
 #include "algebra_layouts.h"
 #include "lib_algebra/common/operations.h"
 #include "parallel_vector.h"
+#include <string>
 
 namespace ug
 {
 
+///\ingroup lib_algebra_parallelization
+///	timing of the matrix-vector products with overlapped halo exchange
+struct SpMVOverlapTiming
+{
+	SpMVOverlapTiming()
+		: numCalls(0), numInteriorRows(0), numBoundaryRows(0),
+		  tPost(0.0), tInterior(0.0), tWait(0.0), tBoundary(0.0)
+	{}
+
+	size_t numCalls;		///< number of calls
+	size_t numInteriorRows;	///< rows computed while communicating
+	size_t numBoundaryRows;	///< rows computed after the receives completed
+	double tPost;			///< time to post the interface sends (s)
+	double tInterior;		///< time for the interior rows (s)
+	double tWait;			///< time waiting for the receives (s)
+	double tBoundary;		///< time for the boundary rows (s)
+
+	void add(const SpMVOverlapTiming& t)
+	{
+		numCalls += t.numCalls;
+		numInteriorRows += t.numInteriorRows; numBoundaryRows += t.numBoundaryRows;
+		tPost += t.tPost; tInterior += t.tInterior;
+		tWait += t.tWait; tBoundary += t.tBoundary;
+	}
+};
+
 ///\ingroup lib_algebra_parallelization
 
 ///\brief Wrapper for sequential matrices to handle them in parallel
@@ -78,12 +105,14 @@ class ParallelMatrix : public TMatrix
 	public:
 	///	Default Constructor
 		ParallelMatrix()
-			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts)
+			: TMatrix(), m_type(PST_UNDEFINED), m_numInteriorRows(0), m_numBoundaryRows(0),
+			  m_overlapStamp(0), m_pOverlapSlaveLayout(NULL), m_spAlgebraLayouts(new AlgebraLayouts)
 		{}
 
 	///	Constructor setting the layouts
 		ParallelMatrix(SmartPtr<AlgebraLayouts> layouts)
-			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(layouts)
+			: TMatrix(), m_type(PST_UNDEFINED), m_numInteriorRows(0), m_numBoundaryRows(0),
+			  m_overlapStamp(0), m_pOverlapSlaveLayout(NULL), m_spAlgebraLayouts(layouts)
 		{}
 
 		/////////////////////////
@@ -128,6 +157,16 @@ class ParallelMatrix : public TMatrix
 		template<typename TPVector>
 		bool apply(TPVector &res, const TPVector &x) const;
 
+	/// calculate res = A x, making x consistent
+	/**
+	 * x may be given in any storage type and is consistent afterwards. If A
+	 * is additive and x is unique or additive, the halo exchange is overlapped
+	 * with the product: the rows that do not couple to slave entries are
+	 * computed while the values are exchanged, the remaining rows afterwards.
+	 */
+		template<typename TPVector>
+		bool apply_make_consistent(TPVector &res, TPVector &x) const;
+
 	/// calculate res = A.T x
 		template<typename TPVector>
 		bool apply_transposed(TPVector &res, const TPVector &x) const;
@@ -136,17 +175,68 @@ class ParallelMatrix : public TMatrix
 		template<typename TPVector>
 		bool matmul_minus(TPVector &res, const TPVector &x) const;
 
+	///	timing of the last apply with overlapped halo exchange
+		const SpMVOverlapTiming& last_overlap_timing() const {return m_lastOverlapTiming;}
+
+	///	accumulated timing of all applies with overlapped halo exchange
+		const SpMVOverlapTiming& overlap_timing() const {return m_overlapTiming;}
+
+	///	resets the accumulated timing
+		void reset_overlap_timing() {m_overlapTiming = m_lastOverlapTiming = SpMVOverlapTiming();}
+
+	///	returns the accumulated timing (summed over all processes) as string
+		std::string overlap_timing_string() const;
+
 	///	assignment
 		this_type &operator =(const this_type &M);
 
+	protected:
+	///	res = A*x, making x consistent while computing
+		template<typename TPVector>
+		void overlapped_apply(TPVector &res, TPVector &x) const;
+
+	///	computes the row ranges with and without couplings to slave entries
+	/**	The ranges are kept as long as the sparsity pattern and the layouts
+	 * do not change.*/
+		void update_overlap_ranges(const IndexLayout& slaveLayout) const;
+
 	private:
 	/// type of storage  (i.e. consistent, additiv, additiv unique)
 		uint m_type;
 
+	///	timing of the overlapped applies
+		mutable SpMVOverlapTiming m_lastOverlapTiming;
+		mutable SpMVOverlapTiming m_overlapTiming;
+
+	///	row ranges [begin, end) without (interior) and with (boundary)
+	///	couplings to slave entries, stored as begin, end, begin, end, ...
+		mutable std::vector<size_t> m_vInteriorRange, m_vBoundaryRange;
+		mutable size_t m_numInteriorRows, m_numBoundaryRows;
+
+	///	structure stamp of the matrix and slave layout the ranges belong to
+		mutable size_t m_overlapStamp;
+		mutable const IndexLayout* m_pOverlapSlaveLayout;
+
 	/// algebra layouts and communicators
 		ConstSmartPtr<AlgebraLayouts> m_spAlgebraLayouts;
 };
 
+///	freezes the local matrix (see FreezeMatrixForSolve in matrix_operator.h)
+template<typename T>
+inline void FreezeMatrixForSolve(ParallelMatrix<T>& A)
+{
+	FreezeMatrixForSolve(static_cast<T&>(A));
+}
+
+template<typename T> class SparseMatrix;
+
+///	f = A*u with overlapped halo exchange (see MatrixApplyMakeConsistent in matrix_operator.h)
+template<typename T, typename Y, typename X>
+inline void MatrixApplyMakeConsistent(const ParallelMatrix<SparseMatrix<T> >& A, Y& f, X& u)
+{
+	A.apply_make_consistent(f, u);
+}
+
 //	predaclaration.
 //	this type may already be declared somewhere else, which shouldn't hurt.
 template<typename T>
@@ -33,7 +33,9 @@
 #ifndef __H__LIB_ALGEBRA__PARALLELIZATION__PARALLEL_MATRIX_IMPL__
 #define __H__LIB_ALGEBRA__PARALLELIZATION__PARALLEL_MATRIX_IMPL__
 
+#include <sstream>
 #include "parallel_matrix.h"
+#include "common/stopwatch.h"
 
 namespace ug
 {
@@ -196,6 +198,159 @@ matmul_minus(TPVector &res, const TPVector &x) const
 	return true;
 }
 
+// calculate res = A x, making x consistent
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+apply_make_consistent(TPVector &res, TPVector &x) const
+{
+//	additive matrix and not yet consistent vector: overlap halo exchange
+	if(has_storage_type(PST_ADDITIVE) && !x.has_storage_type(PST_CONSISTENT)
+			&& (x.has_storage_type(PST_UNIQUE) || x.has_storage_type(PST_ADDITIVE))
+			&& !x.layouts()->overlap_enabled())
+	{
+		overlapped_apply(res, x);
+		res.set_storage_type(PST_ADDITIVE);
+		return true;
+	}
+
+	if(!x.change_storage_type(PST_CONSISTENT))
+		UG_THROW("ParallelMatrix::apply_make_consistent: Cannot convert x to consistent vector.");
+	return apply(res, x);
+}
+
+// computes the row ranges with and without couplings to slave entries
+template <typename TMatrix>
+void
+ParallelMatrix<TMatrix>::
+update_overlap_ranges(const IndexLayout& slaveLayout) const
+{
+	if(m_overlapStamp == this->structure_stamp() && m_pOverlapSlaveLayout == &slaveLayout)
+		return;
+
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	std::vector<bool> vSlave(this->num_cols(), false);
+	for(IndexLayout::const_iterator iter = slaveLayout.begin();
+			iter != slaveLayout.end(); ++iter)
+	{
+		const IndexLayout::Interface& interface = slaveLayout.interface(iter);
+		for(IndexLayout::Interface::const_iterator iIter = interface.begin();
+				iIter != interface.end(); ++iIter)
+			vSlave[interface.get_element(iIter)] = true;
+	}
+
+	m_vInteriorRange.clear(); m_vBoundaryRange.clear();
+	m_numInteriorRows = m_numBoundaryRows = 0;
+	for(size_t i = 0; i < this->num_rows(); ++i)
+	{
+		bool bBoundary = false;
+		for(typename TMatrix::const_row_iterator conn = this->begin_row(i);
+				conn != this->end_row(i); ++conn)
+			if(vSlave[conn.index()]) {bBoundary = true; break;}
+
+	//	extend the last range or start a new one
+		std::vector<size_t>& vRange = bBoundary ? m_vBoundaryRange : m_vInteriorRange;
+		if(!vRange.empty() && vRange.back() == i) vRange.back() = i+1;
+		else {vRange.push_back(i); vRange.push_back(i+1);}
+		if(bBoundary) ++m_numBoundaryRows; else ++m_numInteriorRows;
+	}
+
+	m_overlapStamp = this->structure_stamp();
+	m_pOverlapSlaveLayout = &slaveLayout;
+}
+
+// calculate res = A*x, while x is made consistent
+template <typename TMatrix>
+template<typename TPVector>
+void
+ParallelMatrix<TMatrix>::
+overlapped_apply(TPVector &res, TPVector &x) const
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+
+	SpMVOverlapTiming timing;
+	timing.numCalls = 1;
+	double tStart = get_clock_s();
+
+	const IndexLayout& masterLayout = x.layouts()->master();
+	const IndexLayout& slaveLayout = x.layouts()->slave();
+	pcl::InterfaceCommunicator<IndexLayout>& com = x.layouts()->comm();
+
+//	step 1: additive vector: add slave values to master (not overlapped)
+	if(!x.has_storage_type(PST_UNIQUE))
+	{
+		ComPol_VecAdd<TPVector> cpVecAdd(&x);
+		com.send_data(slaveLayout, cpVecAdd);
+		com.receive_data(masterLayout, cpVecAdd);
+		com.communicate();
+	}
+
+//	step 2: post the copy of the master values to the slaves
+	ComPol_VecCopy<TPVector> cpVecCopy(&x);
+	com.send_data(masterLayout, cpVecCopy);
+	com.receive_data(slaveLayout, cpVecCopy);
+	com.communicate_and_resume();
+
+	double tNow = get_clock_s();
+	timing.tPost = tNow - tStart; tStart = tNow;
+
+//	step 3: compute all rows not coupled to the (pending) slave values
+	update_overlap_ranges(slaveLayout);
+	TMatrix::axpy_row_ranges(res, 0.0, res, 1.0, x, m_vInteriorRange);
+	timing.numInteriorRows = m_numInteriorRows;
+	timing.numBoundaryRows = m_numBoundaryRows;
+
+	tNow = get_clock_s();
+	timing.tInterior = tNow - tStart; tStart = tNow;
+
+//	step 4: complete the halo exchange
+	com.wait();
+	x.set_storage_type(PST_CONSISTENT);
+
+	tNow = get_clock_s();
+	timing.tWait = tNow - tStart; tStart = tNow;
+
+//	step 5: compute the remaining rows
+	TMatrix::axpy_row_ranges(res, 0.0, res, 1.0, x, m_vBoundaryRange);
+
+	timing.tBoundary = get_clock_s() - tStart;
+
+	m_lastOverlapTiming = timing;
+	m_overlapTiming.add(timing);
+}
+
+template <typename TMatrix>
+std::string
+ParallelMatrix<TMatrix>::
+overlap_timing_string() const
+{
+//	sum up over all processes
+	const SpMVOverlapTiming& t = m_overlapTiming;
+	double local[7] = {(double)t.numCalls, (double)t.numInteriorRows,
+	                   (double)t.numBoundaryRows, t.tPost, t.tInterior,
+	                   t.tWait, t.tBoundary};
+	double global[7];
+	const pcl::ProcessCommunicator& pc = layouts()->proc_comm();
+	if(pc.empty()) for(int i = 0; i < 7; ++i) global[i] = local[i];
+	else pc.allreduce(local, global, 7, PCL_DT_DOUBLE, PCL_RO_SUM);
+
+	const double numProcs = pc.empty() ? 1.0 : (double)pc.size();
+	const double tComm = global[5] + global[3];
+	std::stringstream ss;
+	ss << "Overlapped SpMV (average over " << numProcs << " procs, "
+		<< global[0] / numProcs << " calls):\n"
+		<< "  rows interior / boundary: " << global[1] / numProcs
+		<< " / " << global[2] / numProcs << "\n"
+		<< "  post sends:     " << global[3] / numProcs << " s\n"
+		<< "  interior rows:  " << global[4] / numProcs << " s (overlapped)\n"
+		<< "  wait receives:  " << global[5] / numProcs << " s (exposed)\n"
+		<< "  boundary rows:  " << global[6] / numProcs << " s\n";
+	if(global[4] + tComm > 0.0)
+		ss << "  hidden fraction of the halo exchange: at least "
+			<< global[4] / (global[4] + tComm) << " (interior/(interior+post+wait))\n";
+	return ss.str();
+}
 
 template<typename matrix_type, typename vector_type>
 ug::ParallelStorageType GetMultType(const ParallelMatrix<matrix_type> &A1, const ParallelVector<vector_type> &x)
@@ -152,6 +152,15 @@ class ParallelVector : public TVector
 	 */
 		inline number dotprod(const this_type& v);
 
+	///	process-local part of the dot product
+	/**
+	 * Adjusts the storage types (as dotprod() does) and returns the dot
+	 * product of the process-local entries, without summing over the
+	 * processes. Used to fuse several reductions into a single (possibly
+	 * non-blocking) allreduce.
+	 */
+		inline number local_dotprod(const this_type& v);
+
 	/// assign number to whole Vector
 		number operator = (number d);
 
@@ -152,6 +152,7 @@ inline size_t GetCols(const T &t);
 } // namespace ug
 
 #include "double.h"
+#include "float.h"
 #include "small_matrix/densevector.h"
 #include "small_matrix/densematrix.h"
 #include "small_matrix/block_dense.h"
@@ -105,6 +105,20 @@ extern "C"
 				 lapack_float *pWork, lapack_int *worksize, lapack_int *info);
 	void dgetri_(lapack_int *n, lapack_double *pColMajorMatrix, lapack_int *lda, const lapack_int *ipiv,
 				 lapack_double *pWork, lapack_int *worksize, lapack_int *info);	
+
+	// BLAS level 3: matrix-matrix product *GEMM
+	void sgemm_(char *transa, char *transb, lapack_int *m, lapack_int *n, lapack_int *k,
+				lapack_float *alpha, const lapack_float *a, lapack_int *lda, const lapack_float *b, lapack_int *ldb,
+				lapack_float *beta, lapack_float *c, lapack_int *ldc);
+	void dgemm_(char *transa, char *transb, lapack_int *m, lapack_int *n, lapack_int *k,
+				lapack_double *alpha, const lapack_double *a, lapack_int *lda, const lapack_double *b, lapack_int *ldb,
+				lapack_double *beta, lapack_double *c, lapack_int *ldc);
+
+	// BLAS level 3: triangular solve with multiple right hand sides *TRSM
+	void strsm_(char *side, char *uplo, char *transa, char *diag, lapack_int *m, lapack_int *n,
+				lapack_float *alpha, const lapack_float *a, lapack_int *lda, lapack_float *b, lapack_int *ldb);
+	void dtrsm_(char *side, char *uplo, char *transa, char *diag, lapack_int *m, lapack_int *n,
+				lapack_double *alpha, const lapack_double *a, lapack_int *lda, lapack_double *b, lapack_int *ldb);
 }
 
 
@@ -319,6 +333,76 @@ inline lapack_int getri(lapack_int n, lapack_double *pColMajorMatrix, lapack_int
 	return info;
 }
 
+
+// matrix-matrix product
+//------------------------
+
+/*
+ *  gemm computes C = alpha*op(A)*op(B) + beta*C (BLAS level 3)
+ *  for column major matrices, op(X) = X or X**T.
+ *
+ *  \param	transposeA, transposeB	form of op(A) and op(B)
+ *  \param	m	number of rows of op(A) and C
+ *  \param	n	number of columns of op(B) and C
+ *  \param	k	number of columns of op(A) and rows of op(B)
+ *  \param	lda, ldb, ldc	leading dimensions of A, B and C
+ */
+inline void gemm(eTransposeMode transposeA, eTransposeMode transposeB, lapack_int m, lapack_int n, lapack_int k,
+		lapack_float alpha, const lapack_float *pColMajorA, lapack_int lda, const lapack_float *pColMajorB, lapack_int ldb,
+		lapack_float beta, lapack_float *pColMajorC, lapack_int ldc)
+{
+	char _transa = TransposeModeToChar(transposeA, false);
+	char _transb = TransposeModeToChar(transposeB, false);
+	sgemm_(&_transa, &_transb, &m, &n, &k, &alpha, pColMajorA, &lda, pColMajorB, &ldb, &beta, pColMajorC, &ldc);
+}
+
+inline void gemm(eTransposeMode transposeA, eTransposeMode transposeB, lapack_int m, lapack_int n, lapack_int k,
+		lapack_double alpha, const lapack_double *pColMajorA, lapack_int lda, const lapack_double *pColMajorB, lapack_int ldb,
+		lapack_double beta, lapack_double *pColMajorC, lapack_int ldc)
+{
+	char _transa = TransposeModeToChar(transposeA, false);
+	char _transb = TransposeModeToChar(transposeB, false);
+	dgemm_(&_transa, &_transb, &m, &n, &k, &alpha, pColMajorA, &lda, pColMajorB, &ldb, &beta, pColMajorC, &ldc);
+}
+
+
+// triangular solve
+//-------------------
+
+/*
+ *  trsm solves op(A)*X = alpha*B (bRightSide = false) or X*op(A) = alpha*B
+ *  (bRightSide = true) for a triangular column major matrix A (BLAS level 3).
+ *  X overwrites B.
+ *
+ *  \param	bRightSide		side on which A is applied
+ *  \param	bLower			A is lower (true) or upper (false) triangular
+ *  \param	transposeMode	form of op(A)
+ *  \param	bUnitDiagonal	if true, the diagonal of A is assumed to be 1 and not referenced
+ *  \param	m, n			number of rows and columns of B
+ *  \param	lda, ldb		leading dimensions of A and B
+ */
+inline void trsm(bool bRightSide, bool bLower, eTransposeMode transposeMode, bool bUnitDiagonal,
+		lapack_int m, lapack_int n, lapack_float alpha, const lapack_float *pColMajorA, lapack_int lda,
+		lapack_float *pColMajorB, lapack_int ldb)
+{
+	char _side = bRightSide ? 'R' : 'L';
+	char _uplo = bLower ? 'L' : 'U';
+	char _trans = TransposeModeToChar(transposeMode, false);
+	char _diag = bUnitDiagonal ? 'U' : 'N';
+	strsm_(&_side, &_uplo, &_trans, &_diag, &m, &n, &alpha, pColMajorA, &lda, pColMajorB, &ldb);
+}
+
+inline void trsm(bool bRightSide, bool bLower, eTransposeMode transposeMode, bool bUnitDiagonal,
+		lapack_int m, lapack_int n, lapack_double alpha, const lapack_double *pColMajorA, lapack_int lda,
+		lapack_double *pColMajorB, lapack_int ldb)
+{
+	char _side = bRightSide ? 'R' : 'L';
+	char _uplo = bLower ? 'L' : 'U';
+	char _trans = TransposeModeToChar(transposeMode, false);
+	char _diag = bUnitDiagonal ? 'U' : 'N';
+	dtrsm_(&_side, &_uplo, &_trans, &_diag, &m, &n, &alpha, pColMajorA, &lda, pColMajorB, &ldb);
+}
+
 }
 
 
@@ -122,6 +122,9 @@ class RevisionCounter
 	///	returns the associated object
 		const void* obj() const {return m_pObj;}
 
+	///	returns the state counter (0 = invalid)
+		uint64 count() const {return m_cnt;}
+
 	protected:
 		const void* m_pObj; ///< associated object
 		uint64 m_cnt; ///< state counter (0 = invalid)
@@ -71,7 +71,8 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 	  m_spSurfView(spSurfView),
 	  m_gridLevel(level),
 	  m_spDoFIndexStorage(spDoFIndexStorage),
-	  m_numIndex(0)
+	  m_numIndex(0),
+	  m_revision(this)
 {
 	if(m_spDoFIndexStorage.invalid())
 		m_spDoFIndexStorage = SmartPtr<DoFIndexStorage>(new DoFIndexStorage(spMG, spDDInfo));
@@ -683,13 +684,13 @@ size_t DoFDistribution::_dof_indices(TBaseElem* elem, size_t fct,
 
 //	collect elements, if needed
 	if(dim >= VERTEX)
-		if(max_dofs(VERTEX) > 0) m_pMG->associated_elements_sorted(vCorner, elem);
+		if(max_dofs(VERTEX) > 0) associated_elements_sorted(vCorner, elem);
 	if(dim >= EDGE)
-		if(max_dofs(EDGE) > 0 || bHang) m_pMG->associated_elements_sorted(vEdge, elem);
+		if(max_dofs(EDGE) > 0 || bHang) associated_elements_sorted(vEdge, elem);
 	if(dim >= FACE)
-		if(max_dofs(FACE) > 0 || bHang) m_pMG->associated_elements_sorted(vFace, elem);
+		if(max_dofs(FACE) > 0 || bHang) associated_elements_sorted(vFace, elem);
 	if(dim >= VOLUME)
-		if(max_dofs(VOLUME) > 0) m_pMG->associated_elements_sorted(vVol, elem);
+		if(max_dofs(VOLUME) > 0) associated_elements_sorted(vVol, elem);
 
 //	get regular dofs on all subelements and the element itself
 //	use specialized function for vertices (since only one position and one reference object)
@@ -1132,13 +1133,13 @@ void DoFDistribution::_indices(TBaseElem* elem, LocalIndices& ind, bool bHang) c
 
 //	collect elements, if needed
 	if(dim >= VERTEX)
-		if(max_dofs(VERTEX) > 0) m_pMG->associated_elements_sorted(vCorner, elem);
+		if(max_dofs(VERTEX) > 0) associated_elements_sorted(vCorner, elem);
 	if(dim >= EDGE)
-		if(max_dofs(EDGE) > 0 || bHang) m_pMG->associated_elements_sorted(vEdge, elem);
+		if(max_dofs(EDGE) > 0 || bHang) associated_elements_sorted(vEdge, elem);
 	if(dim >= FACE)
-		if(max_dofs(FACE) > 0 || bHang) m_pMG->associated_elements_sorted(vFace, elem);
+		if(max_dofs(FACE) > 0 || bHang) associated_elements_sorted(vFace, elem);
 	if(dim >= VOLUME)
-		if(max_dofs(VOLUME) > 0) m_pMG->associated_elements_sorted(vVol, elem);
+		if(max_dofs(VOLUME) > 0) associated_elements_sorted(vVol, elem);
 
 //	get reference object id
 	const ReferenceObjectID roid = elem->reference_object_id();
@@ -1427,8 +1428,23 @@ void DoFDistribution::reinit()
 	}
 }
 
+void DoFDistribution::enable_topology_snapshot(bool bEnable)
+{
+	if(!bEnable){
+		m_spTopology = SPNULL;
+		return;
+	}
+
+	if(m_spTopology.invalid())
+		m_spTopology = make_sp(new TopologySnapshot);
+	m_spTopology->build(*m_spSurfView, m_gridLevel);
+}
+
 void DoFDistribution::reinit()
 {
+	if(m_spTopology.valid())
+		m_spTopology->build(*m_spSurfView, m_gridLevel);
+
 	m_numIndex = 0;
 	m_vNumIndexOnSubset.resize(0);
 	m_vNumIndexOnSubset.resize(num_subsets(), 0);
@@ -1441,6 +1457,8 @@ void DoFDistribution::reinit()
 #ifdef UG_PARALLEL
 	reinit_layouts_and_communicator();
 #endif
+
+	++m_revision;
 }
 
 
@@ -1762,6 +1780,8 @@ void DoFDistribution::permute_indices(const std::vector<size_t>& vNewInd)
 	reinit_layouts_and_communicator();
 #endif
 
+	++m_revision;
+
 //	permute indices in associated vectors
 	permute_values(vNewInd);
 }
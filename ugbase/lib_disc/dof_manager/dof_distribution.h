@@ -34,10 +34,12 @@
 #define __H__UG__LIB_DISC__DOF_MANAGER__DOF_DISTRIBUTION__
 
 #include "lib_grid/tools/surface_view.h"
+#include "lib_grid/tools/topology_snapshot.h"
 #include "lib_disc/domain_traits.h"
 #include "lib_disc/common/local_algebra.h"
 #include "dof_index_storage.h"
 #include "dof_count.h"
+#include "lib_disc/common/revision_counter.h"
 
 #ifdef UG_PARALLEL
 #include "lib_algebra/parallelization/algebra_layouts.h"
@@ -73,6 +75,18 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		///	returns grid level
 		const GridLevel& grid_level() const {return m_gridLevel;}
 
+		///	enables a frozen topology snapshot to look up sub-elements
+		/**
+		 * If enabled, a TopologySnapshot of the grid level is built on each
+		 * reinit and the sub-elements of an element are taken from its CSR
+		 * arrays instead of the grid's associated-element lists. As long as
+		 * the grid changes, the snapshot is invalid and the grid is used.
+		 */
+		void enable_topology_snapshot(bool bEnable);
+
+		///	returns the topology snapshot (invalid if not enabled)
+		ConstSmartPtr<TopologySnapshot> topology_snapshot() const {return m_spTopology;}
+
 	public:
 		template <typename TElem>
 		struct traits
@@ -351,6 +365,16 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// \}
 
 	protected:
+		///	collects the sub-elements of an element sorted by reference order
+		template <typename TContainer, typename TBaseElem>
+		inline void associated_elements_sorted(TContainer& vSubElem, TBaseElem* elem) const
+		{
+			if(m_spTopology.valid()
+				&& m_spTopology->associated_elements_sorted(vSubElem, elem))
+				return;
+			m_pMG->associated_elements_sorted(vSubElem, elem);
+		}
+
 		template <typename TBaseElem>
 		void _indices(TBaseElem* elem, LocalIndices& ind, bool bHang = false) const;
 
@@ -478,6 +502,9 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// DoF-Index Memory Storage
 		SmartPtr<DoFIndexStorage> m_spDoFIndexStorage;
 
+		///	frozen topology of the grid level (optional)
+		SmartPtr<TopologySnapshot> m_spTopology;
+
 	protected:
 		/// number of distributed indices on whole domain
 		size_t m_numIndex;
@@ -495,6 +522,14 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		///	initializes the indices
 		void reinit();
 
+		///	returns the revision of the indices
+		/**
+		 * The revision is increased whenever the indices change (reinit,
+		 * permutation). It can be used to detect if data depending on the
+		 * indices (e.g. a matrix structure) is still valid.
+		 */
+		const RevisionCounter& revision() const {return m_revision;}
+
 	protected:
 		///	initializes the indices
 		template <typename TBaseElem>
@@ -537,6 +572,9 @@ class DoFDistribution : public DoFDistributionInfoProvider
 	 */
 		std::vector<IGridFunction*> m_vpGridFunction;
 
+	///	revision of the indices
+		RevisionCounter m_revision;
+
 #ifdef UG_PARALLEL
 		public:
 		///	returns algebra layouts
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__DOMAIN_POINT_LOCATOR__
+#define __H__UG__LIB_DISC__DOMAIN_POINT_LOCATOR__
+
+#include <vector>
+#include <utility>
+
+#include "common/common.h"
+#include "lib_disc/domain_traits.h"
+#include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
+
+namespace ug{
+
+///	locates many points in the elements of a domain
+/**
+ * The locator finds the elements containing given points and the local
+ * coordinates of the points in these elements. It is intended for the
+ * evaluation of data at many points, e.g. probes or the interpolation between
+ * grids.
+ *
+ * A batch of points is processed in the order of a Hilbert space filling
+ * curve through the points. Each point is searched first in the element
+ * containing the previous point, then by walking through side-neighbors
+ * towards the point (at most max_walk_steps steps). Only if this fails, the
+ * search tree (lg_ntree) is used. Batches can be split among several OpenMP
+ * threads (set_num_threads).
+ *
+ * A point on the boundary of several elements (e.g. a vertex of the grid) is
+ * assigned to the one of them which has been passed first to create. The
+ * result is thus independent of the hint, of the order of the points in a
+ * batch and of the number of threads.
+ *
+ * In parallel, evaluate_global sends points which are not found on a process
+ * to the processes whose bounding box contains them, where they are located
+ * and evaluated.
+ *
+ * The locator stores a snapshot of the elements. It has to be recreated,
+ * if the grid changes.
+ *
+ * \tparam	TDomain		domain type
+ * \tparam	elemDim		dimension of the elements the points are searched in
+ */
+template <typename TDomain, int elemDim = TDomain::dim>
+class DomainPointLocator
+{
+	public:
+	///	world dimension
+		static const int dim = TDomain::dim;
+
+	///	element type
+		typedef typename domain_traits<elemDim>::grid_base_object element_t;
+
+	///	local coordinates in an element
+		typedef MathVector<elemDim> local_position_type;
+
+	///	search tree
+		typedef lg_ntree<dim, dim, element_t> tree_t;
+
+	public:
+	///	constructor. Elements have to be added by create
+		DomainPointLocator(SmartPtr<TDomain> spDomain);
+
+	///	creates the search structures for the given elements
+		template <class TIterator>
+		void create(TIterator elemsBegin, TIterator elemsEnd);
+
+	///	number of threads used for batches of points (requires OpenMP)
+		void set_num_threads(int numThreads);
+
+	///	maximal number of steps through neighbors, before the search tree is used
+		void set_max_walk_steps(size_t maxSteps) {m_maxWalkSteps = maxSteps;}
+
+	///	locates a single point
+	/**
+	 * \param[out]	elemOut		element containing the point
+	 * \param[out]	locPosOut	local coordinates of the point in elemOut
+	 * \param[in]	globPos		point
+	 * \param[in]	hint		(optional) element where the search starts
+	 * \returns		true if the point has been found
+	 */
+		bool locate(element_t*& elemOut, MathVector<elemDim>& locPosOut,
+		            const MathVector<dim>& globPos, element_t* hint = NULL) const;
+
+	///	locates a batch of points
+	/**
+	 * \param[out]	vElemOut	elements containing the points (NULL if not found)
+	 * \param[out]	vLocPosOut	local coordinates of the points in the elements
+	 * \param[in]	vGlobPos	points
+	 * \returns		number of points found
+	 */
+		size_t locate(std::vector<element_t*>& vElemOut,
+		              std::vector<MathVector<elemDim> >& vLocPosOut,
+		              const std::vector<MathVector<dim> >& vGlobPos) const;
+
+	///	evaluates data at points, which may be located on other processes
+	/**
+	 * The points are located on this process first. In parallel, points not
+	 * found are sent to the processes whose bounding box contains them.
+	 * There they are located and evaluated and the results are sent back.
+	 * All processes have to call this method, each with its own points.
+	 *
+	 * The evaluator is called as
+	 * 	bool eval(number* vValueOut, element_t* elem, const MathVector<elemDim>& locPos,
+	 * 	          const MathVector<dim>& globPos)
+	 * and has to write numComp values.
+	 *
+	 * \param[out]	vValueOut	numComp values per point (0 if not found)
+	 * \param[out]	vFoundOut	whether the point has been found on any process
+	 * \param[in]	vGlobPos	points
+	 * \param[in]	numComp		number of values per point
+	 * \param[in]	eval		evaluator
+	 * \returns		number of points found
+	 */
+		template <class TEvaluator>
+		size_t evaluate_global(std::vector<number>& vValueOut,
+		                       std::vector<bool>& vFoundOut,
+		                       const std::vector<MathVector<dim> >& vGlobPos,
+		                       size_t numComp, TEvaluator& eval) const;
+
+	///	the domain
+		SmartPtr<TDomain> domain() const {return m_spDomain;}
+
+	///	number of elements
+		size_t num_elements() const {return m_vElem.size();}
+
+	protected:
+	///	index of an element (or -1 if not in the locator)
+		int elem_index(element_t* elem) const;
+
+	///	searches a point by walking from the element with index start, then in the tree
+		int find(const MathVector<dim>& globPos, int start) const;
+
+	///	smallest index of the elements containing a point, found contains it
+		int smallest_containing(const MathVector<dim>& globPos, int found) const;
+
+	///	computes the local coordinates of a point in an element
+		void local_coordinates(MathVector<elemDim>& locPosOut, element_t* elem,
+		                       const MathVector<dim>& globPos) const;
+
+	///	sorts the points along a Hilbert curve
+		void sfc_order(std::vector<size_t>& vOrderOut,
+		               const std::vector<MathVector<dim> >& vGlobPos) const;
+
+	protected:
+		SmartPtr<TDomain> m_spDomain;
+		typename TDomain::position_accessor_type m_aaPos;
+
+		tree_t m_tree;
+
+	///	elements, their centers and their side neighbors (compressed rows)
+		std::vector<element_t*> m_vElem;
+		std::vector<MathVector<dim> > m_vCenter;
+		std::vector<int> m_vNbrOffset;
+		std::vector<int> m_vNbr;
+
+	///	elements sorted by address, with their index
+		std::vector<std::pair<element_t*, int> > m_vSortedElem;
+
+	///	bounding box of the elements
+		MathVector<dim> m_boxMin, m_boxMax;
+
+		int m_numThreads;
+		size_t m_maxWalkSteps;
+};
+
+}//	end of namespace
+
+#include "domain_point_locator_impl.h"
+
+#endif
@@ -0,0 +1,614 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__DOMAIN_POINT_LOCATOR_IMPL__
+#define __H__UG__LIB_DISC__DOMAIN_POINT_LOCATOR_IMPL__
+
+#include <algorithm>
+#include <limits>
+
+#include "domain_point_locator.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/reference_element/reference_mapping.h"
+#include "lib_grid/algorithms/sfc_ordering.h"
+
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_util.h"
+	#include "pcl/pcl_process_communicator.h"
+#endif
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+//	local coordinates
+////////////////////////////////////////////////////////////////////////////////
+
+///	computes local coordinates with a mapping on the stack
+/**	The mappings of the ReferenceMappingProvider are shared and can therefore
+ * not be used from several threads at once.*/
+template <int refDim, int worldDim>
+struct DomainPointLocatorMapping;
+
+template <int worldDim>
+struct DomainPointLocatorMapping<0, worldDim>
+{
+	static void global_to_local(MathVector<0>& locPos, ReferenceObjectID roid,
+	                            const std::vector<MathVector<worldDim> >& vCorner,
+	                            const MathVector<worldDim>& globPos)
+	{}
+};
+
+template <int worldDim>
+struct DomainPointLocatorMapping<1, worldDim>
+{
+	static void global_to_local(MathVector<1>& locPos, ReferenceObjectID roid,
+	                            const std::vector<MathVector<worldDim> >& vCorner,
+	                            const MathVector<worldDim>& globPos)
+	{
+		switch(roid){
+			case ROID_EDGE: {ReferenceMapping<ReferenceEdge, worldDim> map(vCorner);
+							 map.global_to_local(locPos, globPos); return;}
+			default: UG_THROW("DomainPointLocator: Reference object "<<roid<<" not supported.");
+		}
+	}
+};
+
+template <int worldDim>
+struct DomainPointLocatorMapping<2, worldDim>
+{
+	static void global_to_local(MathVector<2>& locPos, ReferenceObjectID roid,
+	                            const std::vector<MathVector<worldDim> >& vCorner,
+	                            const MathVector<worldDim>& globPos)
+	{
+		switch(roid){
+			case ROID_TRIANGLE: {ReferenceMapping<ReferenceTriangle, worldDim> map(vCorner);
+								 map.global_to_local(locPos, globPos); return;}
+			case ROID_QUADRILATERAL: {ReferenceMapping<ReferenceQuadrilateral, worldDim> map(vCorner);
+									  map.global_to_local(locPos, globPos); return;}
+			default: UG_THROW("DomainPointLocator: Reference object "<<roid<<" not supported.");
+		}
+	}
+};
+
+template <int worldDim>
+struct DomainPointLocatorMapping<3, worldDim>
+{
+	static void global_to_local(MathVector<3>& locPos, ReferenceObjectID roid,
+	                            const std::vector<MathVector<worldDim> >& vCorner,
+	                            const MathVector<worldDim>& globPos)
+	{
+		switch(roid){
+			case ROID_TETRAHEDRON: {ReferenceMapping<ReferenceTetrahedron, worldDim> map(vCorner);
+									map.global_to_local(locPos, globPos); return;}
+			case ROID_PYRAMID: {ReferenceMapping<ReferencePyramid, worldDim> map(vCorner);
+								map.global_to_local(locPos, globPos); return;}
+			case ROID_PRISM: {ReferenceMapping<ReferencePrism, worldDim> map(vCorner);
+							  map.global_to_local(locPos, globPos); return;}
+			case ROID_HEXAHEDRON: {ReferenceMapping<ReferenceHexahedron, worldDim> map(vCorner);
+								   map.global_to_local(locPos, globPos); return;}
+			case ROID_OCTAHEDRON: {ReferenceMapping<ReferenceOctahedron, worldDim> map(vCorner);
+								   map.global_to_local(locPos, globPos); return;}
+			default: UG_THROW("DomainPointLocator: Reference object "<<roid<<" not supported.");
+		}
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//	corners and neighbors
+////////////////////////////////////////////////////////////////////////////////
+
+template <class TElem, class TAAPos>
+inline void DomainPointLocatorCorners(std::vector<typename TAAPos::ValueType>& vCornerOut,
+                                      TElem* elem, const TAAPos& aaPos)
+{
+	CollectCornerCoordinates(vCornerOut, *elem, aaPos);
+}
+
+template <class TAAPos>
+inline void DomainPointLocatorCorners(std::vector<typename TAAPos::ValueType>& vCornerOut,
+                                      Vertex* vrt, const TAAPos& aaPos)
+{
+	vCornerOut.assign(1, aaPos[vrt]);
+}
+
+///	collects the elements sharing a side with an element
+template <int elemDim>
+struct DomainPointLocatorNeighbors
+{
+	template <class TElem>
+	static void collect(std::vector<TElem*>& vNbrOut, Grid& grid, TElem* elem)
+	{
+		typedef typename TElem::side side_t;
+		vNbrOut.clear();
+
+		typename Grid::traits<side_t>::secure_container vSide;
+		typename Grid::traits<TElem>::secure_container vAssoc;
+		grid.associated_elements(vSide, elem);
+		for(size_t s = 0; s < vSide.size(); ++s){
+			grid.associated_elements(vAssoc, vSide[s]);
+			for(size_t a = 0; a < vAssoc.size(); ++a)
+				if(vAssoc[a] != elem)
+					vNbrOut.push_back(vAssoc[a]);
+		}
+	}
+};
+
+///	vertices have no side neighbors
+template <>
+struct DomainPointLocatorNeighbors<0>
+{
+	template <class TElem>
+	static void collect(std::vector<TElem*>& vNbrOut, Grid& grid, TElem* elem)
+	{
+		vNbrOut.clear();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//	DomainPointLocator
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TDomain, int elemDim>
+DomainPointLocator<TDomain, elemDim>::
+DomainPointLocator(SmartPtr<TDomain> spDomain)
+	: m_spDomain(spDomain),
+	  m_aaPos(spDomain->position_accessor()),
+	  m_tree(*spDomain->grid(), spDomain->position_attachment()),
+	  m_numThreads(1),
+	  m_maxWalkSteps(32)
+{
+	VecSet(m_boxMin, std::numeric_limits<number>::max());
+	VecSet(m_boxMax, -std::numeric_limits<number>::max());
+}
+
+template <typename TDomain, int elemDim>
+template <class TIterator>
+void DomainPointLocator<TDomain, elemDim>::
+create(TIterator elemsBegin, TIterator elemsEnd)
+{
+	Grid& grid = *m_spDomain->grid();
+
+//	collect elements and centers, compute bounding box
+	m_vElem.clear();
+	m_vCenter.clear();
+	VecSet(m_boxMin, std::numeric_limits<number>::max());
+	VecSet(m_boxMax, -std::numeric_limits<number>::max());
+	std::vector<MathVector<dim> > vCornerCoords;
+	for(TIterator iter = elemsBegin; iter != elemsEnd; ++iter)
+	{
+		element_t* elem = *iter;
+		DomainPointLocatorCorners(vCornerCoords, elem, m_aaPos);
+
+		MathVector<dim> center;
+		VecSet(center, 0.0);
+		for(size_t co = 0; co < vCornerCoords.size(); ++co){
+			const MathVector<dim>& x = vCornerCoords[co];
+			VecAppend(center, x);
+			for(int d = 0; d < dim; ++d){
+				m_boxMin[d] = std::min(m_boxMin[d], x[d]);
+				m_boxMax[d] = std::max(m_boxMax[d], x[d]);
+			}
+		}
+		VecScale(center, center, 1.0 / (number)vCornerCoords.size());
+
+		m_vElem.push_back(elem);
+		m_vCenter.push_back(center);
+	}
+
+//	index lookup by address
+	m_vSortedElem.resize(m_vElem.size());
+	for(size_t i = 0; i < m_vElem.size(); ++i)
+		m_vSortedElem[i] = std::make_pair(m_vElem[i], (int)i);
+	std::sort(m_vSortedElem.begin(), m_vSortedElem.end());
+
+//	side neighbors, restricted to the elements of the locator
+	m_vNbrOffset.resize(m_vElem.size() + 1);
+	m_vNbr.clear();
+	std::vector<element_t*> vNbrElem;
+	for(size_t i = 0; i < m_vElem.size(); ++i)
+	{
+		m_vNbrOffset[i] = (int)m_vNbr.size();
+		DomainPointLocatorNeighbors<elemDim>::collect(vNbrElem, grid, m_vElem[i]);
+		for(size_t n = 0; n < vNbrElem.size(); ++n){
+			const int nbr = elem_index(vNbrElem[n]);
+			if(nbr < 0) continue;
+			if(std::find(m_vNbr.begin() + m_vNbrOffset[i], m_vNbr.end(), nbr)
+				== m_vNbr.end())
+				m_vNbr.push_back(nbr);
+		}
+	}
+	m_vNbrOffset[m_vElem.size()] = (int)m_vNbr.size();
+
+//	search tree for points not reached by walking
+	m_tree.create_tree(m_vElem.begin(), m_vElem.end());
+}
+
+template <typename TDomain, int elemDim>
+void DomainPointLocator<TDomain, elemDim>::
+set_num_threads(int numThreads)
+{
+	UG_COND_THROW(numThreads < 1, "DomainPointLocator::set_num_threads: "
+				  "number of threads must be positive, but is " << numThreads);
+#ifdef UG_OPENMP
+	m_numThreads = numThreads;
+#else
+	if(numThreads > 1)
+		UG_LOG("WARNING in DomainPointLocator::set_num_threads: ug4 is compiled "
+				"without OpenMP (cmake -DOPENMP=ON). Point location stays serial.\n");
+	m_numThreads = 1;
+#endif
+}
+
+template <typename TDomain, int elemDim>
+int DomainPointLocator<TDomain, elemDim>::
+elem_index(element_t* elem) const
+{
+	typename std::vector<std::pair<element_t*, int> >::const_iterator iter
+		= std::lower_bound(m_vSortedElem.begin(), m_vSortedElem.end(),
+		                   std::make_pair(elem, -1));
+	if(iter == m_vSortedElem.end() || iter->first != elem) return -1;
+	return iter->second;
+}
+
+template <typename TDomain, int elemDim>
+int DomainPointLocator<TDomain, elemDim>::
+find(const MathVector<dim>& globPos, int start) const
+{
+	for(int d = 0; d < dim; ++d)
+		if(globPos[d] < m_boxMin[d] || globPos[d] > m_boxMax[d])
+			return -1;
+
+//	walk through the neighbors towards the point
+	if(start >= 0){
+		int cur = start;
+		number curDist = VecDistanceSq(m_vCenter[cur], globPos);
+		for(size_t step = 0; step <= m_maxWalkSteps; ++step)
+		{
+			if(tree_t::traits::contains_point(m_vElem[cur], globPos, m_tree.common_data()))
+				return smallest_containing(globPos, cur);
+
+			int next = -1;
+			for(int n = m_vNbrOffset[cur]; n < m_vNbrOffset[cur+1]; ++n){
+				const number dist = VecDistanceSq(m_vCenter[m_vNbr[n]], globPos);
+				if(dist < curDist) {curDist = dist; next = m_vNbr[n];}
+			}
+
+		//	check the neighbors, if no neighbor is closer to the point
+			if(next < 0){
+				for(int n = m_vNbrOffset[cur]; n < m_vNbrOffset[cur+1]; ++n)
+					if(tree_t::traits::contains_point(m_vElem[m_vNbr[n]], globPos, m_tree.common_data()))
+						return smallest_containing(globPos, m_vNbr[n]);
+				break;
+			}
+			cur = next;
+		}
+	}
+
+//	search in tree
+	element_t* elem = NULL;
+	if(!FindContainingElement(elem, m_tree, globPos))
+		return -1;
+	return smallest_containing(globPos, elem_index(elem));
+}
+
+template <typename TDomain, int elemDim>
+int DomainPointLocator<TDomain, elemDim>::
+smallest_containing(const MathVector<dim>& globPos, int found) const
+{
+//	points inside an element are not contained in its neighbors
+	int n = m_vNbrOffset[found];
+	for(; n < m_vNbrOffset[found+1]; ++n)
+		if(tree_t::traits::contains_point(m_vElem[m_vNbr[n]], globPos, m_tree.common_data()))
+			break;
+	if(n == m_vNbrOffset[found+1]) return found;
+
+//	points on sides, edges or corners: collect all elements containing the
+//	point, which are connected through sides to the found one
+	std::vector<int> vContaining(1, found);
+	int smallest = found;
+	for(size_t k = 0; k < vContaining.size(); ++k){
+		const int cur = vContaining[k];
+		for(n = m_vNbrOffset[cur]; n < m_vNbrOffset[cur+1]; ++n){
+			const int nbr = m_vNbr[n];
+			if(std::find(vContaining.begin(), vContaining.end(), nbr) != vContaining.end())
+				continue;
+			if(!tree_t::traits::contains_point(m_vElem[nbr], globPos, m_tree.common_data()))
+				continue;
+			vContaining.push_back(nbr);
+			smallest = std::min(smallest, nbr);
+		}
+	}
+	return smallest;
+}
+
+template <typename TDomain, int elemDim>
+void DomainPointLocator<TDomain, elemDim>::
+local_coordinates(MathVector<elemDim>& locPosOut, element_t* elem,
+                  const MathVector<dim>& globPos) const
+{
+	std::vector<MathVector<dim> > vCornerCoords;
+	DomainPointLocatorCorners(vCornerCoords, elem, m_aaPos);
+
+	VecSet(locPosOut, 0.5);
+	DomainPointLocatorMapping<elemDim, dim>::global_to_local
+		(locPosOut, elem->reference_object_id(), vCornerCoords, globPos);
+}
+
+template <typename TDomain, int elemDim>
+bool DomainPointLocator<TDomain, elemDim>::
+locate(element_t*& elemOut, MathVector<elemDim>& locPosOut,
+       const MathVector<dim>& globPos, element_t* hint) const
+{
+	const int index = find(globPos, (hint != NULL) ? elem_index(hint) : -1);
+	if(index < 0) return false;
+
+	elemOut = m_vElem[index];
+	local_coordinates(locPosOut, elemOut, globPos);
+	return true;
+}
+
+template <typename TDomain, int elemDim>
+void DomainPointLocator<TDomain, elemDim>::
+sfc_order(std::vector<size_t>& vOrderOut,
+          const std::vector<MathVector<dim> >& vGlobPos) const
+{
+	const size_t numPos = vGlobPos.size();
+	vOrderOut.resize(numPos);
+	if(numPos == 0) return;
+
+//	bounding box of the points
+	MathVector<dim> lo = vGlobPos[0], hi = vGlobPos[0];
+	for(size_t i = 1; i < numPos; ++i)
+		for(int d = 0; d < dim; ++d){
+			lo[d] = std::min(lo[d], vGlobPos[i][d]);
+			hi[d] = std::max(hi[d], vGlobPos[i][d]);
+		}
+
+//	hilbert index of each point. The resolution is chosen such that there is
+//	about one point per cell, finer cells do not improve the order.
+	int numBits = 1;
+	while(numBits < std::min(32, 64 / dim) && (((uint64)1) << (dim * (numBits-1))) < numPos)
+		++numBits;
+	const number maxCoord = (number)((((uint64)1) << numBits) - 1);
+	std::vector<std::pair<uint64, size_t> > vKey(numPos);
+	for(size_t i = 0; i < numPos; ++i){
+		uint32 coords[dim];
+		for(int d = 0; d < dim; ++d){
+			const number ext = hi[d] - lo[d];
+			coords[d] = (ext > 0) ? (uint32)((vGlobPos[i][d] - lo[d]) / ext * maxCoord) : 0;
+		}
+		vKey[i] = std::make_pair(HilbertIndex(coords, dim, numBits), i);
+	}
+	std::sort(vKey.begin(), vKey.end());
+
+	for(size_t i = 0; i < numPos; ++i)
+		vOrderOut[i] = vKey[i].second;
+}
+
+template <typename TDomain, int elemDim>
+size_t DomainPointLocator<TDomain, elemDim>::
+locate(std::vector<element_t*>& vElemOut,
+       std::vector<MathVector<elemDim> >& vLocPosOut,
+       const std::vector<MathVector<dim> >& vGlobPos) const
+{
+	const size_t numPos = vGlobPos.size();
+	vElemOut.assign(numPos, NULL);
+	vLocPosOut.resize(numPos);
+	if(numPos == 0 || m_vElem.empty()) return 0;
+
+//	neighboring points are processed one after another
+	std::vector<size_t> vOrder;
+	sfc_order(vOrder, vGlobPos);
+
+	const int numThreads = (int)std::min<size_t>(m_numThreads, numPos);
+	const size_t chunk = (numPos + numThreads - 1) / numThreads;
+	size_t numFound = 0;
+	bool bError = false;
+	std::string errMsg;
+
+//	each thread walks through a contiguous part of the curve
+	#ifdef UG_OPENMP
+	#pragma omp parallel for num_threads(numThreads) reduction(+:numFound)
+	#endif
+	for(int t = 0; t < numThreads; ++t)
+	{
+		try{
+			int last = -1;
+			const size_t end = std::min(numPos, (t+1) * chunk);
+			for(size_t k = t * chunk; k < end; ++k)
+			{
+				const size_t i = vOrder[k];
+				const int index = find(vGlobPos[i], last);
+				if(index < 0) continue;
+
+				vElemOut[i] = m_vElem[index];
+				local_coordinates(vLocPosOut[i], vElemOut[i], vGlobPos[i]);
+				last = index;
+				++numFound;
+			}
+		}
+		catch(UGError& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (DomainPointLocatorError)
+			#endif
+			{bError = true; errMsg = err.get_stacktrace();}
+		}
+		catch(std::exception& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (DomainPointLocatorError)
+			#endif
+			{bError = true; errMsg = err.what();}
+		}
+	}
+	UG_COND_THROW(bError, "DomainPointLocator::locate: Cannot locate points: "<<errMsg);
+
+	return numFound;
+}
+
+template <typename TDomain, int elemDim>
+template <class TEvaluator>
+size_t DomainPointLocator<TDomain, elemDim>::
+evaluate_global(std::vector<number>& vValueOut,
+                std::vector<bool>& vFoundOut,
+                const std::vector<MathVector<dim> >& vGlobPos,
+                size_t numComp, TEvaluator& eval) const
+{
+	const size_t numPos = vGlobPos.size();
+	vValueOut.assign(numPos * numComp, 0.0);
+	vFoundOut.assign(numPos, false);
+
+//	points on this process
+	std::vector<element_t*> vElem;
+	std::vector<MathVector<elemDim> > vLocPos;
+	locate(vElem, vLocPos, vGlobPos);
+
+	size_t numFound = 0;
+	for(size_t i = 0; i < numPos; ++i){
+		if(vElem[i] == NULL) continue;
+		if(!eval(&vValueOut[i*numComp], vElem[i], vLocPos[i], vGlobPos[i])) continue;
+		vFoundOut[i] = true;
+		++numFound;
+	}
+
+#ifdef UG_PARALLEL
+	pcl::ProcessCommunicator com;
+	const int numProcs = pcl::NumProcs();
+	const int rank = pcl::ProcRank();
+	if(numProcs <= 1) return numFound;
+
+//	bounding boxes of all processes
+	std::vector<number> vBox(2*dim), vAllBox(2*dim*numProcs);
+	for(int d = 0; d < dim; ++d) {vBox[d] = m_boxMin[d]; vBox[dim+d] = m_boxMax[d];}
+	com.allgather(&vBox[0], 2*dim, PCL_DT_DOUBLE, &vAllBox[0], 2*dim, PCL_DT_DOUBLE);
+
+//	ask the processes whose box contains a missing point
+	std::vector<std::vector<size_t> > vAsked(numProcs);
+	for(size_t i = 0; i < numPos; ++i){
+		if(vFoundOut[i]) continue;
+		for(int p = 0; p < numProcs; ++p){
+			if(p == rank) continue;
+			const number* box = &vAllBox[2*dim*p];
+			bool inside = true;
+			for(int d = 0; d < dim; ++d)
+				if(vGlobPos[i][d] < box[d] || vGlobPos[i][d] > box[dim+d])
+					{inside = false; break;}
+			if(inside) vAsked[p].push_back(i);
+		}
+	}
+
+	std::vector<int> vNumSend(numProcs), vNumRecv(numProcs);
+	for(int p = 0; p < numProcs; ++p) vNumSend[p] = (int)vAsked[p].size();
+	com.alltoall(&vNumSend[0], 1, PCL_DT_INT, &vNumRecv[0], 1, PCL_DT_INT);
+
+//	send the points
+	std::vector<int> vSendTo, vSendSize, vRecvFrom, vRecvSize;
+	std::vector<number> vSendPos, vRecvPos;
+	for(int p = 0; p < numProcs; ++p){
+		if(vNumSend[p] > 0){
+			vSendTo.push_back(p);
+			vSendSize.push_back(vNumSend[p] * dim * sizeof(number));
+			for(size_t k = 0; k < vAsked[p].size(); ++k)
+				for(int d = 0; d < dim; ++d)
+					vSendPos.push_back(vGlobPos[vAsked[p][k]][d]);
+		}
+		if(vNumRecv[p] > 0){
+			vRecvFrom.push_back(p);
+			vRecvSize.push_back(vNumRecv[p] * dim * sizeof(number));
+		}
+	}
+
+	size_t numRecvPos = 0;
+	for(size_t r = 0; r < vRecvSize.size(); ++r) numRecvPos += vRecvSize[r] / (dim * sizeof(number));
+	vRecvPos.resize(numRecvPos * dim);
+
+	com.distribute_data(vRecvPos.empty() ? NULL : &vRecvPos[0],
+	                    vRecvSize.empty() ? NULL : &vRecvSize[0],
+	                    vRecvFrom.empty() ? NULL : &vRecvFrom[0], (int)vRecvFrom.size(),
+	                    vSendPos.empty() ? NULL : &vSendPos[0],
+	                    vSendSize.empty() ? NULL : &vSendSize[0],
+	                    vSendTo.empty() ? NULL : &vSendTo[0], (int)vSendTo.size());
+
+//	locate and evaluate the received points, answer [found, values] per point
+	std::vector<MathVector<dim> > vOtherPos(numRecvPos);
+	for(size_t i = 0; i < numRecvPos; ++i)
+		for(int d = 0; d < dim; ++d)
+			vOtherPos[i][d] = vRecvPos[i*dim + d];
+	locate(vElem, vLocPos, vOtherPos);
+
+	const size_t stride = numComp + 1;
+	std::vector<number> vAnswer(numRecvPos * stride, 0.0);
+	for(size_t i = 0; i < numRecvPos; ++i){
+		if(vElem[i] == NULL) continue;
+		if(eval(&vAnswer[i*stride + 1], vElem[i], vLocPos[i], vOtherPos[i]))
+			vAnswer[i*stride] = 1.0;
+	}
+
+//	send the answers back
+	std::vector<int> vAnswerSize(vRecvSize.size()), vResultSize(vSendSize.size());
+	for(size_t r = 0; r < vRecvSize.size(); ++r)
+		vAnswerSize[r] = vRecvSize[r] / (dim * sizeof(number)) * stride * sizeof(number);
+	for(size_t s = 0; s < vSendSize.size(); ++s)
+		vResultSize[s] = vSendSize[s] / (dim * sizeof(number)) * stride * sizeof(number);
+
+	std::vector<number> vResult(vSendPos.size() / dim * stride);
+	com.distribute_data(vResult.empty() ? NULL : &vResult[0],
+	                    vResultSize.empty() ? NULL : &vResultSize[0],
+	                    vSendTo.empty() ? NULL : &vSendTo[0], (int)vSendTo.size(),
+	                    vAnswer.empty() ? NULL : &vAnswer[0],
+	                    vAnswerSize.empty() ? NULL : &vAnswerSize[0],
+	                    vRecvFrom.empty() ? NULL : &vRecvFrom[0], (int)vRecvFrom.size());
+
+//	the lowest rank finding a point wins
+	size_t offset = 0;
+	for(size_t s = 0; s < vSendTo.size(); ++s){
+		const std::vector<size_t>& vIndex = vAsked[vSendTo[s]];
+		for(size_t k = 0; k < vIndex.size(); ++k, offset += stride){
+			const size_t i = vIndex[k];
+			if(vFoundOut[i] || vResult[offset] == 0.0) continue;
+			for(size_t c = 0; c < numComp; ++c)
+				vValueOut[i*numComp + c] = vResult[offset + 1 + c];
+			vFoundOut[i] = true;
+			++numFound;
+		}
+	}
+#endif
+
+	return numFound;
+}
+
+}//	end of namespace
+
+#endif
@@ -83,6 +83,7 @@ init(SmartPtr<subset_handler_type> spMGSH,
 	m_spDoFDistributionInfo = SmartPtr<DoFDistributionInfo>(new DoFDistributionInfo(spMGSH));
 	m_algebraType = algebraType;
 	m_bAdaptionIsActive = false;
+	m_bTopologySnapshots = false;
 	m_RevCnt = RevisionCounter(this);
 
 	this->set_dof_distribution_info(m_spDoFDistributionInfo);
@@ -343,11 +344,21 @@ void IApproximationSpace::create_dof_distribution(const GridLevel& gl)
 		DoFDistribution(m_spMG, m_spMGSH, m_spDoFDistributionInfo,
 						m_spSurfaceView, gl, m_bGrouped, spIndexStrg));
 
+	if(m_bTopologySnapshots)
+		spDD->enable_topology_snapshot(true);
+
 //	add to list and sort
 	m_vDD.push_back(spDD);
 	std::sort(m_vDD.begin(), m_vDD.end(), SortDD);
 }
 
+void IApproximationSpace::enable_topology_snapshots(bool bEnable)
+{
+	m_bTopologySnapshots = bEnable;
+	for(size_t i = 0; i < m_vDD.size(); ++i)
+		m_vDD[i]->enable_topology_snapshot(bEnable);
+}
+
 void IApproximationSpace::surface_view_required()
 {
 //	allocate surface view if needed
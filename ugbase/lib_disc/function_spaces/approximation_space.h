@@ -161,6 +161,9 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	returns if dofs are grouped
 		bool grouped() const {return m_bGrouped;}
 
+	///	sets if dof distributions use a frozen topology snapshot of the grid
+		void enable_topology_snapshots(bool bEnable);
+
 	///	returns if ghosts might be present on a level
 		bool might_contain_ghosts(int lvl) const;
 
@@ -256,6 +259,9 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	flag if DoFs should be grouped
 		bool m_bGrouped;
 
+	///	flag if dof distributions use a topology snapshot
+		bool m_bTopologySnapshots;
+
 	///	DofDistributionInfo
 		SmartPtr<DoFDistributionInfo> m_spDoFDistributionInfo;
 
@@ -41,6 +41,7 @@
 #include "lib_disc/common/groups_util.h"
 #include "lib_disc/quadrature/quadrature.h"
 #include "lib_disc/domain_util.h"
+#include "lib_disc/domain_point_locator.h"
 #include "lib_disc/local_finite_element/local_finite_element_provider.h"
 #include "lib_disc/spatial_disc/user_data/std_glob_pos_data.h"
 #include "lib_disc/reference_element/reference_mapping_provider.h"
@@ -60,6 +61,7 @@ class GlobalGridFunctionNumberData
 	///	world dimension of grid function
 		static const int dim = TGridFunction::dim;
 		typedef typename TGridFunction::template dim_traits<elemDim>::grid_base_object element_t;
+		typedef DomainPointLocator<typename TGridFunction::domain_type, elemDim> locator_t;
 
 		private:
 	/// grid function
@@ -71,14 +73,14 @@ class GlobalGridFunctionNumberData
 	///	local finite element id
 		LFEID m_lfeID;
 
-		typedef lg_ntree<dim, dim, element_t>	tree_t;
-		tree_t	m_tree;
+	///	locator for points
+		locator_t m_locator;
 
 	public:
 	/// constructor
 		GlobalGridFunctionNumberData(SmartPtr<TGridFunction> spGridFct, const char* cmp)
 		: m_spGridFct(spGridFct),
-		  m_tree(*spGridFct->domain()->grid(), spGridFct->domain()->position_attachment())
+		  m_locator(spGridFct->domain())
 		{
 			//this->set_functions(cmp);
 
@@ -126,7 +128,7 @@ class GlobalGridFunctionNumberData
 //			m_tree.create_tree(spGridFct->template begin<element_t>(si),
 //														spGridFct->template end<element_t>(si));
 
-			m_tree.create_tree(elemsWithGridFunctions.begin(), elemsWithGridFunctions.end());
+			m_locator.create(elemsWithGridFunctions.begin(), elemsWithGridFunctions.end());
 
 		};
 
@@ -156,50 +158,73 @@ class GlobalGridFunctionNumberData
 		inline bool evaluate(number& value, const MathVector<dim>& x) const
 		{
 			element_t* elem = NULL;
-			//try{
-
-				if(!FindContainingElement(elem, m_tree, x)){
-					return false;
-				}
+			MathVector<elemDim> locPos;
+			if(!m_locator.locate(elem, locPos, x))
+				return false;
 
-			//	get corners of element
-				std::vector<MathVector<dim> > vCornerCoords;
-				CollectCornerCoordinates(vCornerCoords, *elem, *m_spGridFct->domain());
+			return evaluate(value, elem, locPos);
+		}
 
-			//	reference object id
-				const ReferenceObjectID roid = elem->reference_object_id();
+		///	evaluates the data at local coordinates of an element
+		inline bool evaluate(number& value, element_t* elem,
+		                     const MathVector<elemDim>& locPos) const
+		{
+		//	reference object id
+			const ReferenceObjectID roid = elem->reference_object_id();
+
+		//	evaluate at shapes at ip
+			const LocalShapeFunctionSet<elemDim>& rTrialSpace =
+					LocalFiniteElementProvider::get<elemDim>(roid, m_lfeID);
+			std::vector<number> vShape;
+			rTrialSpace.shapes(vShape, locPos);
+
+		//	get multiindices of element
+			std::vector<DoFIndex> ind;
+			m_spGridFct->dof_indices(elem, m_fct, ind);
+
+		// 	compute solution at integration point
+			value = 0.0;
+			for(size_t sh = 0; sh < vShape.size(); ++sh)
+			{
+				const number valSH = DoFRef(*m_spGridFct, ind[sh]);
+				value += valSH * vShape[sh];
+			}
 
-			//	get local position of DoF
-				DimReferenceMapping<elemDim, dim>& map
-					= ReferenceMappingProvider::get<elemDim, dim>(roid, vCornerCoords);
-				MathVector<elemDim> locPos;
-				VecSet(locPos, 0.5);
-				map.global_to_local(locPos, x);
+		//	point is found
+			return true;
+		}
 
-			//	evaluate at shapes at ip
-				const LocalShapeFunctionSet<elemDim>& rTrialSpace =
-						LocalFiniteElementProvider::get<elemDim>(roid, m_lfeID);
-				std::vector<number> vShape;
-				rTrialSpace.shapes(vShape, locPos);
+		///	number of threads used to locate batches of points
+		void set_num_threads(int numThreads) {m_locator.set_num_threads(numThreads);}
 
-			//	get multiindices of element
-				std::vector<DoFIndex> ind;
-				m_spGridFct->dof_indices(elem, m_fct, ind);
+		///	the point locator
+		const locator_t& locator() const {return m_locator;}
 
-			// 	compute solution at integration point
-				value = 0.0;
-				for(size_t sh = 0; sh < vShape.size(); ++sh)
-				{
-					const number valSH = DoFRef(*m_spGridFct, ind[sh]);
-					value += valSH * vShape[sh];
-				}
+	protected:
+		///	evaluator passed to the point locator
+		struct LocatorEvaluator
+		{
+			LocatorEvaluator(const GlobalGridFunctionNumberData* pData) : m_pData(pData) {}
+			bool operator()(number* value, element_t* elem, const MathVector<elemDim>& locPos,
+			                const MathVector<dim>& x)
+			{
+				return m_pData->evaluate(*value, elem, locPos);
+			}
+			const GlobalGridFunctionNumberData* m_pData;
+		};
 
-			//	point is found
-				return true;
-			//}
-			//UG_CATCH_THROW("GlobalGridFunctionNumberData: Evaluation failed."
-			//			   << "Point: " << x << ", Element: "
-			//			   << ElementDebugInfo(*m_spGridFct->domain()->grid(), elem));
+	public:
+		/// evaluates at many points on all procs, returns the number of points found
+		/**
+		 * All procs have to call this method. Points not found on a proc are
+		 * evaluated on the proc containing them (see DomainPointLocator).
+		 */
+		inline size_t evaluate_global(std::vector<number>& vValue,
+		                              std::vector<bool>& vFound,
+		                              const std::vector<MathVector<dim> >& vPos) const
+		{
+			LocatorEvaluator eval(this);
+			return m_locator.evaluate_global(vValue, vFound, vPos, 1, eval);
 		}
 
 		/// evaluate value on all procs
@@ -254,6 +279,27 @@ class GlobalGridFunctionNumberData
 
 			return value;
 		}
+
+		// evaluates at given positions (coordinates of all points in a row)
+		std::vector<number> evaluate_global_batch(std::vector<number> vCoord)
+		{
+			if(vCoord.size() % dim != 0)
+				UG_THROW("Expected a multiple of "<<dim<<" components, but given "<<vCoord.size());
+
+			std::vector<MathVector<dim> > vPos(vCoord.size() / dim);
+			for(size_t p = 0; p < vPos.size(); ++p)
+				for(int i = 0; i < dim; i++) vPos[p][i] = vCoord[p*dim + i];
+
+			std::vector<number> vValue;
+			std::vector<bool> vFound;
+			evaluate_global(vValue, vFound, vPos);
+
+			for(size_t p = 0; p < vPos.size(); ++p)
+				if(!vFound[p])
+					UG_THROW("Couldn't find an element containing the specified point: " << vPos[p]);
+
+			return vValue;
+		}
 };
 
 
@@ -174,7 +174,9 @@ inline void interpolate_from_original_fct
 	static const int dim = dom_type::dim;
 	typedef typename DoFDistribution::traits<TElem>::const_iterator const_iter_type;
 
-	// interpolate subset-wise
+	// collect dof positions subset-wise
+	std::vector<DoFIndex> vAllInd;
+	std::vector<MathVector<dim> > vAllPos;
 	size_t numSubsets = u_new->num_subsets();
 	for (size_t si = 0; si < numSubsets; ++si)
 	{
@@ -197,16 +199,25 @@ inline void interpolate_from_original_fct
 				<< ", but grid function has " << ind.size() << std::endl
 				<< "on " << ElementDebugInfo(*u_new->domain()->grid(), *elem_iter) << ".");
 
-			// write values in new grid function
-			for (size_t dof = 0; dof < ind.size(); ++dof)
-			{
-				if (!u_orig.evaluate(DoFRef(*u_new, ind[dof]), globPos[dof]))
-				{
-					DoFRef(*u_new, ind[dof]) = std::numeric_limits<number>::quiet_NaN();
-					//UG_THROW("Interpolation onto new grid did not succeed.\n"
-					//		 "DoF with coords " << globPos[dof] << " is out of range.");
-				}
-			}
+			vAllInd.insert(vAllInd.end(), ind.begin(), ind.end());
+			vAllPos.insert(vAllPos.end(), globPos.begin(), globPos.end());
+		}
+	}
+
+	// locate all dof positions at once
+	std::vector<typename TGGFND::element_t*> vElem;
+	std::vector<typename TGGFND::locator_t::local_position_type> vLocPos;
+	u_orig.locator().locate(vElem, vLocPos, vAllPos);
+
+	// write values in new grid function
+	for (size_t dof = 0; dof < vAllInd.size(); ++dof)
+	{
+		if (vElem[dof] == NULL
+			|| !u_orig.evaluate(DoFRef(*u_new, vAllInd[dof]), vElem[dof], vLocPos[dof]))
+		{
+			DoFRef(*u_new, vAllInd[dof]) = std::numeric_limits<number>::quiet_NaN();
+			//UG_THROW("Interpolation onto new grid did not succeed.\n"
+			//		 "DoF with coords " << vAllPos[dof] << " is out of range.");
 		}
 	}
 }
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "vtk_file_writer.h"
+
+#include <cstring>
+
+#include <boost/archive/iterators/transform_width.hpp>
+#include <boost/archive/iterators/base64_from_binary.hpp>
+#include <boost/archive/iterators/ostream_iterator.hpp>
+
+#ifdef UG_ZLIB
+	#include <zlib.h>
+#endif
+
+#include "common/error.h"
+#include "common/log.h"
+#include "common/profiler/profiler.h"
+#include "common/util/async_file_writer.h"
+
+using namespace std;
+
+namespace ug{
+
+///	base64 encoder using boost iterators. Padding has to be added manually.
+typedef boost::archive::iterators::base64_from_binary<
+			boost::archive::iterators::transform_width<const char*, 6, 8>
+		> base64_text;
+
+VTKFileWriter::VTKFileWriter() :
+	m_out(NULL),
+	m_currFormat(base64_ascii),
+	m_binaryMode(INLINE_BASE64)
+{}
+
+VTKFileWriter::VTKFileWriter(const char* filename) :
+	m_out(NULL),
+	m_currFormat(base64_ascii),
+	m_binaryMode(INLINE_BASE64)
+{
+	open(filename);
+}
+
+VTKFileWriter::~VTKFileWriter()
+{
+	if(m_out){
+		try{
+			close();
+		}
+		catch(UGError& err){
+			UG_LOG("WARNING in ~VTKFileWriter: " << err.get_msg() << "\n");
+		}
+	}
+}
+
+void VTKFileWriter::open(const char* filename)
+{
+	m_filename = filename;
+
+	if(AsyncFileWriter::inst().enabled()){
+		m_memStream.str("");
+		m_out = &m_memStream;
+		return;
+	}
+
+	m_fStream.open(filename, ios_base::out | ios_base::trunc | ios_base::binary);
+	if(!m_fStream.is_open()){
+		UG_THROW("Could not open output file: " << filename);
+	}
+	else if(!m_fStream.good()){
+		UG_THROW("Can not write to output file: " << filename);
+	}
+	m_out = &m_fStream;
+}
+
+void VTKFileWriter::close()
+{
+	if(!m_out)
+		return;
+
+	flush_block();
+	if(m_out == &m_memStream){
+		m_out = NULL;
+		string content = m_memStream.str();
+		m_memStream.str("");
+		AsyncFileWriter::inst().write(m_filename, content);
+	}
+	else{
+		m_out = NULL;
+		m_fStream.close();
+	}
+}
+
+bool VTKFileWriter::compression_supported()
+{
+#ifdef UG_ZLIB
+	return true;
+#else
+	return false;
+#endif
+}
+
+void VTKFileWriter::set_binary_mode(BinaryMode mode)
+{
+	UG_COND_THROW(mode == APPENDED_ZLIB && !compression_supported(),
+				  "VTKFileWriter: zlib compression is not available. "
+				  "Please build ug with USE_ZLIB=ON.");
+	m_binaryMode = mode;
+}
+
+string VTKFileWriter::data_array_format() const
+{
+	if(m_binaryMode == INLINE_BASE64)
+		return "\"binary\"";
+
+	stringstream ss;
+	ss << "\"appended\" offset=\"" << m_appended.size() << "\"";
+	return ss.str();
+}
+
+string VTKFileWriter::file_attributes() const
+{
+	if(m_binaryMode == APPENDED_ZLIB)
+		return " header_type=\"UInt32\" compressor=\"vtkZLibDataCompressor\"";
+	return "";
+}
+
+void VTKFileWriter::write_appended_data()
+{
+	PROFILE_FUNC();
+	flush_block();
+	if(m_binaryMode == INLINE_BASE64)
+		return;
+
+//	the underscore marks the beginning of the data
+	(*m_out) << "  <AppendedData encoding=\"raw\">\n   _";
+	if(!m_appended.empty())
+		m_out->write(&m_appended.front(), m_appended.size());
+	(*m_out) << "\n  </AppendedData>\n";
+	m_appended.clear();
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const fmtflag format)
+{
+	if(format != m_currFormat)
+		flush_block();
+	m_currFormat = format;
+	return *this;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const char* cstr)
+{
+	if(m_currFormat == normal)
+		(*m_out) << cstr;
+	else
+		m_block.insert(m_block.end(), cstr, cstr + strlen(cstr));
+	return *this;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const string& str)
+{
+	if(m_currFormat == normal)
+		(*m_out) << str;
+	else
+		m_block.insert(m_block.end(), str.begin(), str.end());
+	return *this;
+}
+
+void VTKFileWriter::flush_block()
+{
+	if(m_block.empty())
+		return;
+
+	UG_COND_THROW(!m_out || m_out->bad(), "File stream is not open.");
+
+	switch(m_binaryMode){
+		case INLINE_BASE64:
+			write_base64();
+			break;
+		case APPENDED_RAW:
+			m_appended.insert(m_appended.end(), m_block.begin(), m_block.end());
+			break;
+		case APPENDED_ZLIB:{
+		//	the leading UInt32 byte count is replaced by the compression header
+			const size_t headerSize = sizeof(int);
+			if(m_block.size() > headerSize)
+				append_compressed(&m_block.front() + headerSize, m_block.size() - headerSize);
+			else
+				append_compressed(NULL, 0);
+		}break;
+	}
+
+	m_block.clear();
+}
+
+void VTKFileWriter::write_base64()
+{
+//	boost reads beyond the end of the buffer if it isn't a multiple of 3
+	const size_t size = m_block.size();
+	const size_t numPadding = (3 - size % 3) % 3;
+	m_block.resize(size + numPadding, 0);
+	const char* data = &m_block.front();
+
+	copy(base64_text(data), base64_text(data + size),
+		 boost::archive::iterators::ostream_iterator<char>(*m_out));
+
+	for(size_t i = 0; i < numPadding; ++i)
+		(*m_out) << '=';
+}
+
+void VTKFileWriter::append_compressed(const char* data, size_t size)
+{
+#ifdef UG_ZLIB
+	typedef unsigned int UInt32;
+	const size_t numBlocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const size_t lastSize = size % BLOCK_SIZE;
+
+//	header: #blocks, block size, size of last block (0 if full), compressed sizes
+	vector<UInt32> header(3 + numBlocks);
+	header[0] = (UInt32)numBlocks;
+	header[1] = (UInt32)BLOCK_SIZE;
+	header[2] = (UInt32)lastSize;
+
+	const size_t headerPos = m_appended.size();
+	m_appended.resize(headerPos + header.size() * sizeof(UInt32));
+
+	for(size_t i = 0; i < numBlocks; ++i){
+		const size_t blockSize = (i + 1 < numBlocks || lastSize == 0) ? BLOCK_SIZE : lastSize;
+		uLongf compSize = compressBound(blockSize);
+		const size_t pos = m_appended.size();
+		m_appended.resize(pos + compSize);
+		int err = compress2(reinterpret_cast<Bytef*>(&m_appended[pos]), &compSize,
+							reinterpret_cast<const Bytef*>(data + i * BLOCK_SIZE),
+							blockSize, Z_DEFAULT_COMPRESSION);
+		UG_COND_THROW(err != Z_OK, "VTKFileWriter: zlib compression failed (" << err << ").");
+		m_appended.resize(pos + compSize);
+		header[3 + i] = (UInt32)compSize;
+	}
+
+	memcpy(&m_appended[headerPos], &header.front(), header.size() * sizeof(UInt32));
+#else
+	UG_THROW("VTKFileWriter: zlib compression is not available.");
+#endif
+}
+
+} // namespace ug
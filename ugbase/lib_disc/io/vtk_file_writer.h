@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+#define __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ug{
+
+///	File writer for vtu files with inline base64 or appended binary data
+/**
+ * The interface matches Base64FileWriter: text is written in the 'normal'
+ * format, binary data of a DataArray in the 'base64_binary' format. The first
+ * value written in binary format is the UInt32 byte count of the array, as
+ * demanded by vtk.
+ *
+ * Binary data of a DataArray is gathered in a contiguous buffer. When switching
+ * back to 'normal', the buffer is either base64 encoded and written inline
+ * (INLINE_BASE64), or it is moved to the appended data section
+ * (APPENDED_RAW, APPENDED_ZLIB). In the appended modes, the offset of the next
+ * array has to be written to the DataArray tag (see data_array_format) and
+ * write_appended_data has to be called before the closing VTKFile tag. The
+ * appended data is written unencoded with a single write.
+ *
+ * APPENDED_ZLIB compresses each array in blocks of BLOCK_SIZE bytes, using the
+ * block header layout of vtkZLibDataCompressor. It is only available if ug was
+ * built with USE_ZLIB.
+ *
+ * If asynchronous output is enabled in the AsyncFileWriter when the file is
+ * opened, the content is assembled in memory and handed to the AsyncFileWriter
+ * on close, so that the disk I/O overlaps with the following computation.
+ */
+class VTKFileWriter
+{
+	public:
+	///	format flags (same as in Base64FileWriter)
+		enum fmtflag {
+			base64_ascii,
+			base64_binary,
+			normal
+		};
+
+	///	placement and encoding of binary data
+		enum BinaryMode {
+			INLINE_BASE64,
+			APPENDED_RAW,
+			APPENDED_ZLIB
+		};
+
+	///	uncompressed size of the blocks in APPENDED_ZLIB mode
+		static const size_t BLOCK_SIZE = 32768;
+
+	public:
+		VTKFileWriter();
+
+	///	opens the given file for writing
+	/**	\throws UGError if the file can not be opened*/
+		VTKFileWriter(const char* filename);
+
+		~VTKFileWriter();
+
+		void open(const char* filename);
+
+		void close();
+
+	///	returns true if ug was built with zlib support
+		static bool compression_supported();
+
+	///	sets the placement and encoding of binary data. Call before writing any data.
+		void set_binary_mode(BinaryMode mode);
+
+		BinaryMode binary_mode() const		{return m_binaryMode;}
+
+		fmtflag format() const				{return m_currFormat;}
+
+	///	returns the format attribute for the next binary DataArray
+	/**	i.e. "binary" or "appended" offset="...", including quotes.*/
+		std::string data_array_format() const;
+
+	///	returns additional attributes for the VTKFile tag (e.g. the compressor)
+		std::string file_attributes() const;
+
+	///	writes the AppendedData section. Does nothing in INLINE_BASE64 mode.
+		void write_appended_data();
+
+		VTKFileWriter& operator<<(const fmtflag format);
+
+		VTKFileWriter& operator<<(int i)				{dispatch(i); return *this;}
+		VTKFileWriter& operator<<(char c)				{dispatch(c); return *this;}
+		VTKFileWriter& operator<<(const char* cstr);
+		VTKFileWriter& operator<<(const std::string& str);
+		VTKFileWriter& operator<<(float f)				{dispatch(f); return *this;}
+		VTKFileWriter& operator<<(double d)				{dispatch(d); return *this;}
+		VTKFileWriter& operator<<(long l)				{dispatch(l); return *this;}
+		VTKFileWriter& operator<<(size_t s)				{dispatch(s); return *this;}
+
+	private:
+		template <typename T>
+		inline void dispatch(const T& value);
+
+	///	writes or appends the gathered binary data of the current array
+		void flush_block();
+
+	///	writes the current array base64 encoded to the file
+		void write_base64();
+
+	///	appends the given data in blocks compressed with zlib
+		void append_compressed(const char* data, size_t size);
+
+	private:
+		std::string			m_filename;
+		std::ofstream		m_fStream;
+		std::ostringstream	m_memStream;
+	///	either m_fStream or m_memStream (asynchronous output)
+		std::ostream*		m_out;
+		fmtflag				m_currFormat;
+		BinaryMode			m_binaryMode;
+
+	///	binary data of the current DataArray
+		std::vector<char>	m_block;
+
+	///	data of all DataArrays in appended mode
+		std::vector<char>	m_appended;
+};
+
+
+template <typename T>
+inline void VTKFileWriter::dispatch(const T& value)
+{
+	switch(m_currFormat){
+		case base64_binary:{
+			const char* p = reinterpret_cast<const char*>(&value);
+			m_block.insert(m_block.end(), p, p + sizeof(T));
+		}break;
+		case base64_ascii:{
+			std::stringstream ss;
+			ss << value;
+			const std::string& str = ss.str();
+			m_block.insert(m_block.end(), str.begin(), str.end());
+		}break;
+		case normal:
+			(*m_out) << value;
+			break;
+	}
+}
+
+} // namespace ug
+
+#endif /* __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__ */
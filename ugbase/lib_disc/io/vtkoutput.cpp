@@ -77,6 +77,7 @@ print(const char* filename, Domain<TDim>& domain)
 	try
 	{
 		VTKFileWriter File(name.c_str());
+		init_binary_mode(File);
 
 	//	header
 		File << VTKFileWriter::normal;
@@ -87,7 +88,7 @@ print(const char* filename, Domain<TDim>& domain)
 		File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 		if(IsLittleEndian()) File << "LittleEndian";
 		else File << "BigEndian";
-		File << "\">\n";
+		File << "\"" << File.file_attributes() << ">\n";
 
 	//	opening the grid
 		File << "  <UnstructuredGrid>\n";
@@ -118,6 +119,7 @@ print(const char* filename, Domain<TDim>& domain)
 
 	//	write closing xml tags
 		File << "  </UnstructuredGrid>\n";
+		File.write_appended_data();
 		File << "</VTKFile>\n";
 
 	// 	detach help indices
@@ -140,7 +142,7 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "    <Piece NumberOfPoints=\"0\" NumberOfCells=\"0\">\n";
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	(binary ? File.data_array_format() : std::string("\"ascii\"")) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
@@ -149,18 +151,18 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "      </Points>\n";
 	File << "      <Cells>\n";
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	(binary ? File.data_array_format() : std::string("\"ascii\"")) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
 		File << n;
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	(binary ? File.data_array_format() : std::string("\"ascii\"")) << ">\n";
 	File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	(binary ? File.data_array_format() : std::string("\"ascii\"")) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
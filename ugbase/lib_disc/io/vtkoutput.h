@@ -42,14 +42,12 @@
 
 // other ug modules
 #include "common/util/string_util.h"
-#include "common/util/base64_file_writer.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/domain.h"
 #include "lib_disc/spatial_disc/user_data/user_data.h"
+#include "vtk_file_writer.h"
 
 namespace ug{
-// todo this should avoid refactoring all the signatures of VTKOutput, remove it later
-typedef Base64FileWriter VTKFileWriter;
 
 template <typename T>
 struct IteratorProvider
@@ -872,11 +870,29 @@ protected:
 
 	public:
 	///	default constructor
-		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false) {} //TODO: maybe true?
+		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bAppended(false), m_bCompressed(false), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false) {} //TODO: maybe true?
 
 	/// should values be printed in binary (base64 encoded way ) or plain ascii
 		void set_binary(bool b) {m_bBinary = b;};
 
+	/// should binary values be written as raw bytes into an appended data section
+	/**
+	 * If set, the binary data arrays are not base64 encoded inline, but
+	 * collected and written unencoded into an <AppendedData> block at the end
+	 * of the vtu file. This avoids the 4/3 size overhead and the encoding cost.
+	 * Has no effect for ascii output.
+	 */
+		void set_appended(bool b) {m_bAppended = b;};
+
+	/// should the appended binary data be zlib compressed (requires USE_ZLIB)
+		void set_compressed(bool b)
+		{
+			UG_COND_THROW(b && !VTKFileWriter::compression_supported(),
+			              "VTKOutput: Compressed output requires ug to be built"
+			              " with zlib support (cmake -DUSE_ZLIB=ON).");
+			m_bCompressed = b;
+		};
+
 		void set_write_grid(bool b) {m_bWriteGrid = b;};
 
 		void set_write_subset_indices(bool b) {m_bWriteSubsetIndices = b;};
@@ -887,6 +903,25 @@ protected:
 	///	returns true if name for vtk-component is already used
 		bool vtk_name_used(const char* name) const;
 
+	///	sets the binary mode of a freshly opened file according to the options
+		void init_binary_mode(VTKFileWriter& File) const
+		{
+			if(!m_bBinary) return;
+			if(m_bAppended && m_bCompressed)
+				File.set_binary_mode(VTKFileWriter::APPENDED_ZLIB);
+			else if(m_bAppended)
+				File.set_binary_mode(VTKFileWriter::APPENDED_RAW);
+			else
+				File.set_binary_mode(VTKFileWriter::INLINE_BASE64);
+		}
+
+	///	returns the format attribute (incl. quotes) for a DataArray tag
+		std::string data_array_format(VTKFileWriter& File) const
+		{
+			if(!m_bBinary) return "\"ascii\"";
+			return File.data_array_format();
+		}
+
 	///	writes data to stream
 	/**
 	 * The purpose of the function is to convert a double data to binary float
@@ -918,6 +953,10 @@ protected:
 		bool m_bSelectAll;
 	/// print values in binary (base64 encoded way) or plain ascii
 		bool m_bBinary;
+	///	write binary values to an appended raw data section
+		bool m_bAppended;
+	///	compress the appended data section with zlib
+		bool m_bCompressed;
 		std::map<std::string, std::vector<std::string> > m_vSymbFct;
 		std::map<std::string, std::vector<std::string> > m_vSymbFctNodal;
 		std::map<std::string, std::vector<std::string> > m_vSymbFctElem;
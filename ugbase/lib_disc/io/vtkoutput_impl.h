@@ -284,6 +284,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	try
 	{
 		VTKFileWriter File(name.c_str());
+		init_binary_mode(File);
 
 	//	bool if time point should be written to *.vtu file
 	//	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -301,7 +302,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 		File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 		if(IsLittleEndian()) File << "LittleEndian";
 		else File << "BigEndian";
-		File << "\">\n";
+		File << "\"" << File.file_attributes() << ">\n";
 
 	//	writing time point
 		if(bTimeDep)
@@ -338,6 +339,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	//	write closing xml tags
 		File << VTKFileWriter::normal;
 		File << "  </UnstructuredGrid>\n";
+		File.write_appended_data();
 		File << "</VTKFile>\n";
 
 	// 	detach help indices
@@ -417,6 +419,7 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 	try
 	{
 		VTKFileWriter File(name.c_str());
+		init_binary_mode(File);
 
 	//	bool if time point should be written to *.vtu file
 	//	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -434,7 +437,7 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 		File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 		if(IsLittleEndian()) File << "LittleEndian";
 		else File << "BigEndian";
-		File << "\">\n";
+		File << "\"" << File.file_attributes() << ">\n";
 
 	//	writing time point
 		if(bTimeDep)
@@ -471,6 +474,7 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 	//	write closing xml tags
 		File << VTKFileWriter::normal;
 		File << "  </UnstructuredGrid>\n";
+		File.write_appended_data();
 		File << "</VTKFile>\n";
 
 	// 	detach help indices
@@ -822,7 +826,7 @@ write_points(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(m_bBinary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 	int n = 3*sizeof(float) * numVert;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1016,7 +1020,7 @@ write_cell_connectivity(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that connections will be written
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 	int n = sizeof(int) * numConn;
 
 	if(m_bBinary)
@@ -1119,7 +1123,7 @@ write_cell_offsets(VTKFileWriter& File, const T& iterContainer, const SubsetGrou
 	File << VTKFileWriter::normal;
 //	write opening tag indicating that offsets are going to be written
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 	int n = sizeof(int) * numElem;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1234,7 +1238,7 @@ write_cell_types(VTKFileWriter& File, const T& iterContainer, const SubsetGroup&
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1316,7 +1320,7 @@ write_cell_subsets(VTKFileWriter& File, const T& iterContainer, const SubsetGrou
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"regions\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1399,7 +1403,7 @@ write_cell_proc_ranks(VTKFileWriter& File, const T& iterContainer, const SubsetG
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"proc_ranks\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1550,7 +1554,7 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 
 	int n = sizeof(float) * numVert * numCmp;
 	if(m_bBinary)
@@ -1667,7 +1671,7 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 //	write opening tag
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 
 	int n = sizeof(float) * numVert * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -1936,7 +1940,7 @@ write_cell_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 
 	int n = sizeof(float) * numElem * numCmp;
 	if(m_bBinary)
@@ -2074,7 +2078,7 @@ write_cell_values(VTKFileWriter& File, TFunction& u,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	data_array_format(File) << ">\n";
 
 	int n = sizeof(float) * numElem * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
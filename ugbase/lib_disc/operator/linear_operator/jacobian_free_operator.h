@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR__
+
+#include "assembled_linear_operator.h"
+#include "lib_algebra/operator/interface/operator.h"
+
+namespace ug{
+
+///	Jacobian applied by finite differences of a nonlinear operator
+/**
+ * This operator applies the linearization of a nonlinear operator N at a
+ * point u without using an assembled matrix, by the directional difference
+ *
+ * 		J(u)*c \approx ( N(u + h*c) - N(u) ) / h,
+ *
+ * with the step h = eps * (1 + |u|) / |c|. Every application costs one
+ * evaluation of N, i.e. one assembling of the defect.
+ *
+ * Since the class is an AssembledLinearOperator, it also holds an assembled
+ * Jacobian matrix. This matrix is only (re)assembled when 'init(u)' is
+ * called and is used by matrix based preconditioners, while the Krylov
+ * method sees the finite difference operator. Hence, the matrix can lag
+ * behind the linearization point set by 'set_linearization_point', as it is
+ * done in Jacobian-free Newton-Krylov methods.
+ *
+ * Rows of constrained (e.g. Dirichlet) dofs have a vanishing defect and thus
+ * are applied as zero rows. The Newton defect vanishes there as well, so that
+ * the iterates of the Krylov method stay zero in these rows as long as the
+ * preconditioner keeps them zero (as e.g. for identity rows of the matrix).
+ *
+ * \tparam	TAlgebra			algebra type
+ */
+template <typename TAlgebra>
+class JacobianFreeOperator : public AssembledLinearOperator<TAlgebra>
+{
+	public:
+	///	Type of Algebra
+		typedef TAlgebra algebra_type;
+
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Type of Matrix
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Type of base class
+		typedef AssembledLinearOperator<TAlgebra> base_type;
+
+	public:
+	///	Constructor
+		JacobianFreeOperator(SmartPtr<IAssemble<TAlgebra> > ass,
+		                     SmartPtr<IOperator<vector_type> > N);
+
+	///	sets the nonlinear operator N, that is differentiated
+		void set_operator(SmartPtr<IOperator<vector_type> > N) {m_spN = N;}
+
+	///	sets the relative step size of the difference quotient
+		void set_eps(number eps) {m_eps = eps;}
+
+	///	returns the relative step size of the difference quotient
+		number eps() const {return m_eps;}
+
+	///	sets the linearization point u and the defect d = N(u)
+		void set_linearization_point(const vector_type& u, const vector_type& d);
+
+	///	compute f = J(u)*c by a difference quotient of N
+		virtual void apply(vector_type& f, const vector_type& c);
+
+	///	compute f := f - J(u)*c by a difference quotient of N
+		virtual void apply_sub(vector_type& f, const vector_type& c);
+
+	///	returns the number of evaluations of N since construction
+		size_t num_evaluations() const {return m_numEval;}
+
+	///	Destructor
+		virtual ~JacobianFreeOperator() {};
+
+	protected:
+	//	nonlinear operator
+		SmartPtr<IOperator<vector_type> > m_spN;
+
+	//	relative step size
+		number m_eps;
+
+	//	linearization point, its norm and the defect N(u)
+		SmartPtr<vector_type> m_spU;
+		number m_uNorm;
+		SmartPtr<vector_type> m_spD;
+
+	//	work vectors
+		SmartPtr<vector_type> m_spW;
+		SmartPtr<vector_type> m_spF;
+
+	//	evaluation counter
+		size_t m_numEval;
+};
+
+} // namespace ug
+
+// include implementation
+#include "jacobian_free_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR__ */
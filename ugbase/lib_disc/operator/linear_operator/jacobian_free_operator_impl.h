@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR_IMPL__
+
+#include <cmath>
+#include <limits>
+
+#include "jacobian_free_operator.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+template <typename TAlgebra>
+JacobianFreeOperator<TAlgebra>::
+JacobianFreeOperator(SmartPtr<IAssemble<TAlgebra> > ass,
+                     SmartPtr<IOperator<vector_type> > N)
+	: base_type(ass), m_spN(N),
+	  m_eps(std::sqrt(std::numeric_limits<number>::epsilon())),
+	  m_spU(NULL), m_uNorm(0.0), m_spD(NULL), m_spW(NULL), m_spF(NULL),
+	  m_numEval(0)
+{}
+
+template <typename TAlgebra>
+void JacobianFreeOperator<TAlgebra>::
+set_linearization_point(const vector_type& u, const vector_type& d)
+{
+	if(u.size() != d.size())
+		UG_THROW("JacobianFreeOperator: Size of solution ["<<u.size()<<"] and "
+				"defect ["<<d.size()<<"] must match.");
+
+	m_spU = u.clone();
+	m_spD = d.clone();
+	m_spF = d.clone_without_values();
+
+//	the norm changes the storage type, so it is computed on a copy
+	m_spW = u.clone();
+	m_uNorm = m_spW->norm();
+}
+
+template <typename TAlgebra>
+void JacobianFreeOperator<TAlgebra>::apply(vector_type& f, const vector_type& c)
+{
+	PROFILE_FUNC_GROUP("discretization");
+
+	if(m_spU.invalid())
+		UG_THROW("JacobianFreeOperator::apply: Linearization point not set.");
+	if(m_spN.invalid())
+		UG_THROW("JacobianFreeOperator::apply: Nonlinear operator not set.");
+
+#ifdef UG_PARALLEL
+	if(!c.has_storage_type(PST_CONSISTENT))
+		UG_THROW("JacobianFreeOperator::apply: Inadequate storage format of Vector c.");
+#endif
+
+	if(c.size() != m_spU->size())
+		UG_THROW("JacobianFreeOperator::apply: Size of vector c ["<<c.size()
+		         <<"] does not match the linearization point ["<<m_spU->size()<<"].");
+
+//	step size (the norm changes the storage type, so it is computed on a copy)
+	vector_type& w = *m_spW;
+	w = c;
+	const number cNorm = w.norm();
+	if(cNorm == 0.0)
+	{
+		f.set(0.0);
+	#ifdef UG_PARALLEL
+		f.set_storage_type(PST_ADDITIVE);
+	#endif
+		return;
+	}
+	const number h = m_eps * (1.0 + m_uNorm) / cNorm;
+
+//	w = u + h*c
+	w = c;
+	w *= h;
+	w += *m_spU;
+
+//	f = (N(w) - N(u)) / h
+	try{
+		m_spN->apply(f, w);
+	}
+	UG_CATCH_THROW("JacobianFreeOperator::apply: Cannot evaluate operator.");
+	++m_numEval;
+
+	f -= *m_spD;
+	f *= 1.0 / h;
+}
+
+template <typename TAlgebra>
+void JacobianFreeOperator<TAlgebra>::apply_sub(vector_type& f, const vector_type& c)
+{
+#ifdef UG_PARALLEL
+	if(!f.has_storage_type(PST_ADDITIVE))
+		UG_THROW("JacobianFreeOperator::apply_sub: Inadequate storage format of Vector f.");
+#endif
+
+	if(m_spF.invalid())
+		UG_THROW("JacobianFreeOperator::apply_sub: Linearization point not set.");
+
+	apply(*m_spF, c);
+	f -= *m_spF;
+}
+
+} // namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR_IMPL__ */
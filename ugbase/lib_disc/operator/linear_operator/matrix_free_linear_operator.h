@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_LINEAR_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_LINEAR_OPERATOR__
+
+#include "lib_algebra/operator/interface/linear_operator.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_disc/assemble_interface.h"
+
+namespace ug{
+
+///	linear operator applied by element-wise evaluation of an assembling routine
+/**
+ * This operator implements the ILinearOperator interface without storing the
+ * (global) matrix of the operator. Every application f = A*u runs the element
+ * loop of the IAssemble object, where the local matrices are multiplied by the
+ * local values of u and are added to f (see LocalMatVecMapper). Rows set by
+ * constraints (e.g. Dirichlet rows) replace the element contributions in the
+ * same way as in the assembled matrix.
+ *
+ * In addition, the diagonal of the operator can be assembled. It is returned
+ * as a matrix operator with only diagonal entries, that can be passed to
+ * diagonal based preconditioners as approximation (e.g. Jacobi via
+ * 'set_approximation' and 'set_keep_approximation').
+ *
+ * Only Dirichlet type constraints are supported, since other constraints
+ * modify the assembled matrix itself.
+ *
+ * \tparam	TAlgebra			algebra type
+ */
+template <typename TAlgebra>
+class MatrixFreeLinearOperator :
+	public virtual ILinearOperator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Type of Algebra
+		typedef TAlgebra algebra_type;
+
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Type of Matrix
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Type of diagonal operator
+		typedef MatrixOperator<matrix_type, vector_type> diag_operator_type;
+
+	public:
+	///	Default Constructor
+		MatrixFreeLinearOperator();
+
+	///	Constructor
+		MatrixFreeLinearOperator(SmartPtr<IAssemble<TAlgebra> > ass);
+
+	///	Constructor
+		MatrixFreeLinearOperator(SmartPtr<IAssemble<TAlgebra> > ass, const GridLevel& gl);
+
+	///	sets the discretization to be used
+		void set_discretization(SmartPtr<IAssemble<TAlgebra> > ass) {m_spAss = ass; m_bInit = false;}
+
+	///	returns the discretization to be used
+		SmartPtr<IAssemble<TAlgebra> > discretization() {return m_spAss;}
+
+	///	sets the level used for assembling
+		void set_level(const GridLevel& gl) {m_gridLevel = gl; m_bInit = false;}
+
+	///	returns the level
+		const GridLevel& level() const {return m_gridLevel;}
+
+	///	initializes the operator as linearization J(u) at the passed solution
+		virtual void init(const vector_type& u);
+
+	///	initializes the operator for a linear problem
+		virtual void init();
+
+	///	compute f = J(u)*c
+		virtual void apply(vector_type& f, const vector_type& c);
+
+	///	compute f := f - J(u)*c
+		virtual void apply_sub(vector_type& f, const vector_type& c);
+
+	///	returns the diagonal of the operator (assembled if needed)
+		SmartPtr<diag_operator_type> diagonal();
+
+	///	Set Dirichlet values
+		void set_dirichlet_values(vector_type& u);
+
+	///	Destructor
+		virtual ~MatrixFreeLinearOperator() {};
+
+	protected:
+	///	checks that the operator can be applied matrix-free
+		void check_discretization();
+
+	///	runs the element loop of the discretization with the passed mapper
+		void assemble_with_mapper(ILocalToGlobalMapper<TAlgebra>& mapper, matrix_type& mat);
+
+	protected:
+	// 	assembling procedure
+		SmartPtr<IAssemble<TAlgebra> > m_spAss;
+
+	// 	DoF Distribution used
+		GridLevel m_gridLevel;
+
+	//	flags if initialized and if linear (no linearization point)
+		bool m_bInit;
+		bool m_bLinear;
+
+	//	linearization point
+		SmartPtr<vector_type> m_spU;
+
+	//	matrix holding rows written by constraints (no element contributions)
+		matrix_type m_constraintMat;
+
+	//	unused rhs for linear assembling
+		vector_type m_dummyRhs;
+
+	//	diagonal of the operator
+		SmartPtr<diag_operator_type> m_spDiag;
+		bool m_bDiagValid;
+};
+
+} // namespace ug
+
+// include implementation
+#include "matrix_free_linear_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_LINEAR_OPERATOR__ */
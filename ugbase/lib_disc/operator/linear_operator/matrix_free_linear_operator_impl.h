@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_LINEAR_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_LINEAR_OPERATOR_IMPL__
+
+#include "matrix_free_linear_operator.h"
+#include "common/profiler/profiler.h"
+#include "lib_disc/spatial_disc/constraints/constraint_interface.h"
+#include "lib_disc/spatial_disc/local_to_global/matrix_free_mapper.h"
+
+namespace ug{
+
+template <typename TAlgebra>
+MatrixFreeLinearOperator<TAlgebra>::MatrixFreeLinearOperator()
+	: m_spAss(NULL), m_bInit(false), m_bLinear(true),
+	  m_spDiag(new diag_operator_type), m_bDiagValid(false)
+{}
+
+template <typename TAlgebra>
+MatrixFreeLinearOperator<TAlgebra>::
+MatrixFreeLinearOperator(SmartPtr<IAssemble<TAlgebra> > ass)
+	: m_spAss(ass), m_bInit(false), m_bLinear(true),
+	  m_spDiag(new diag_operator_type), m_bDiagValid(false)
+{}
+
+template <typename TAlgebra>
+MatrixFreeLinearOperator<TAlgebra>::
+MatrixFreeLinearOperator(SmartPtr<IAssemble<TAlgebra> > ass, const GridLevel& gl)
+	: m_spAss(ass), m_gridLevel(gl), m_bInit(false), m_bLinear(true),
+	  m_spDiag(new diag_operator_type), m_bDiagValid(false)
+{}
+
+template <typename TAlgebra>
+void MatrixFreeLinearOperator<TAlgebra>::check_discretization()
+{
+	if(m_spAss.invalid())
+		UG_THROW("MatrixFreeLinearOperator: Assembling routine not set.");
+
+	if(m_spAss->ass_tuner()->matrix_is_const())
+		UG_THROW("MatrixFreeLinearOperator: Matrix assembling is disabled "
+				"in the assembling routine (matrix is const).");
+
+//	constraints other than dirichlet work on the assembled matrix
+	for(size_t i = 0; i < m_spAss->num_constraints(); ++i)
+		if(m_spAss->constraint(i)->type() != CT_DIRICHLET)
+			UG_THROW("MatrixFreeLinearOperator: Only dirichlet constraints are "
+					"supported, but constraint "<<i<<" has type "
+					<<m_spAss->constraint(i)->type()<<".");
+}
+
+template <typename TAlgebra>
+void MatrixFreeLinearOperator<TAlgebra>::init(const vector_type& u)
+{
+	check_discretization();
+
+//	remember linearization point
+	m_spU = u.clone();
+	m_bLinear = false;
+	m_bInit = true;
+	m_bDiagValid = false;
+}
+
+template <typename TAlgebra>
+void MatrixFreeLinearOperator<TAlgebra>::init()
+{
+	check_discretization();
+
+	m_spU = SPNULL;
+	m_bLinear = true;
+	m_bInit = true;
+	m_bDiagValid = false;
+}
+
+template <typename TAlgebra>
+void MatrixFreeLinearOperator<TAlgebra>::
+assemble_with_mapper(ILocalToGlobalMapper<TAlgebra>& mapper, matrix_type& mat)
+{
+//	replace the local to global mapping of the discretization temporarily
+	SmartPtr<AssemblingTuner<TAlgebra> > spAssTuner = m_spAss->ass_tuner();
+	ILocalToGlobalMapper<TAlgebra>* pPrevMapper = spAssTuner->mapping();
+	spAssTuner->set_mapping(&mapper);
+
+	try{
+		if(m_bLinear)
+			m_spAss->assemble_linear(mat, m_dummyRhs, m_gridLevel);
+		else
+			m_spAss->assemble_jacobian(mat, *m_spU, m_gridLevel);
+	}
+	catch(...)
+	{
+		spAssTuner->set_mapping(pPrevMapper);
+		throw;
+	}
+
+	spAssTuner->set_mapping(pPrevMapper);
+}
+
+template <typename TAlgebra>
+void MatrixFreeLinearOperator<TAlgebra>::apply(vector_type& f, const vector_type& c)
+{
+	PROFILE_FUNC_GROUP("discretization");
+
+	if(!m_bInit)
+		UG_THROW("MatrixFreeLinearOperator::apply: Operator not initialized.");
+
+#ifdef UG_PARALLEL
+	if(!c.has_storage_type(PST_CONSISTENT))
+		UG_THROW("MatrixFreeLinearOperator::apply: Inadequate storage format of Vector c.");
+#endif
+
+	if(f.size() != c.size())
+		UG_THROW("MatrixFreeLinearOperator::apply: Size of vectors f ["<<f.size()
+		         <<"] and c ["<<c.size()<<"] must match for the operation f = A*c.");
+
+//	element contributions: f = sum_elem A_loc * c_loc
+	f.set(0.0);
+	LocalMatVecMapper<TAlgebra> mapper(c, f);
+	try{
+		assemble_with_mapper(mapper, m_constraintMat);
+	}
+	UG_CATCH_THROW("MatrixFreeLinearOperator::apply: Cannot apply operator.");
+
+	if(m_constraintMat.num_rows() != f.size())
+		UG_THROW("MatrixFreeLinearOperator::apply: Size of operator ["
+		         <<m_constraintMat.num_rows()<<"] does not match size of vector f ["
+		         <<f.size()<<"].");
+
+//	rows set by constraints replace the element contributions
+	typedef typename matrix_type::const_row_iterator const_row_iterator;
+	const matrix_type& C = m_constraintMat;
+	for(size_t i = 0; i < C.num_rows(); ++i)
+	{
+		if(C.num_connections(i) == 0) continue;
+
+		for(size_t r = 0; r < (size_t)GetSize(f[i]); ++r)
+		{
+			bool bConstrained = false;
+			number sum = 0.0;
+			for(const_row_iterator conn = C.begin_row(i); conn != C.end_row(i); ++conn)
+				for(size_t k = 0; k < (size_t)GetCols(conn.value()); ++k)
+				{
+					const number a = BlockRef(conn.value(), r, k);
+					if(a == 0.0) continue;
+					bConstrained = true;
+					sum += a * BlockRef(c[conn.index()], k);
+				}
+
+			if(bConstrained) BlockRef(f[i], r) = sum;
+		}
+	}
+
+#ifdef UG_PARALLEL
+	f.set_storage_type(PST_ADDITIVE);
+#endif
+}
+
+template <typename TAlgebra>
+void MatrixFreeLinearOperator<TAlgebra>::apply_sub(vector_type& f, const vector_type& c)
+{
+#ifdef UG_PARALLEL
+	if(!f.has_storage_type(PST_ADDITIVE))
+		UG_THROW("MatrixFreeLinearOperator::apply_sub: Inadequate storage format of Vector f.");
+#endif
+
+	SmartPtr<vector_type> spTmp = f.clone_without_values();
+	apply(*spTmp, c);
+	f -= *spTmp;
+}
+
+template <typename TAlgebra>
+SmartPtr<typename MatrixFreeLinearOperator<TAlgebra>::diag_operator_type>
+MatrixFreeLinearOperator<TAlgebra>::diagonal()
+{
+	if(!m_bInit)
+		UG_THROW("MatrixFreeLinearOperator::diagonal: Operator not initialized.");
+
+	if(!m_bDiagValid)
+	{
+		PROFILE_BEGIN_GROUP(MatrixFreeLinearOperator_AssembleDiagonal, "discretization");
+		LocalDiagonalMapper<TAlgebra> mapper;
+		try{
+			assemble_with_mapper(mapper, *m_spDiag);
+		}
+		UG_CATCH_THROW("MatrixFreeLinearOperator::diagonal: Cannot assemble diagonal.");
+		m_bDiagValid = true;
+	}
+
+	return m_spDiag;
+}
+
+template <typename TAlgebra>
+void MatrixFreeLinearOperator<TAlgebra>::set_dirichlet_values(vector_type& u)
+{
+	if(m_spAss.invalid())
+		UG_THROW("MatrixFreeLinearOperator: Assembling routine not set.");
+
+	try{
+		m_spAss->adjust_solution(u, m_gridLevel);
+	}
+	UG_CATCH_THROW("MatrixFreeLinearOperator::set_dirichlet_values:"
+				" Cannot adjust solution.");
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_LINEAR_OPERATOR_IMPL__ */
@@ -43,6 +43,7 @@
 #include "lib_disc/assemble_interface.h"
 #include "lib_disc/operator/non_linear_operator/assembled_non_linear_operator.h"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/jacobian_free_operator.h"
 #include "../line_search.h"
 #include "newton_update_interface.h"
 #include "lib_algebra/operator/debug_writer.h"
@@ -81,7 +82,7 @@ class NewtonSolver
 		             SmartPtr<ILineSearch<vector_type> > spLineSearch);
 
 	///	sets the linear solver
-		void set_linear_solver(SmartPtr<ILinearOperatorInverse<vector_type> > LinearSolver) {m_spLinearSolver = LinearSolver;}
+		void set_linear_solver(SmartPtr<ILinearOperatorInverse<vector_type> > LinearSolver) {m_spLinearSolver = LinearSolver; m_bJacobianValid = false;}
 
 	/// sets the convergence check
 		void set_convergence_check(SmartPtr<IConvergenceCheck<vector_type> > spConvCheck);
@@ -123,6 +124,7 @@ class NewtonSolver
 		int total_linsolver_steps() const;
 		double total_average_linear_steps() const;
 		int last_num_newton_steps() const	{return m_lastNumSteps;}
+		int num_jacobian_assemblies() const	{return m_numJacobianAssemblies;}
 	/// \}
 
 	/// resets average linear solver convergence
@@ -148,7 +150,50 @@ class NewtonSolver
 		void set_reassemble_J_freq(int freq)
 			{m_reassembe_J_freq = freq;};
 
+	///	enables the adaptive reuse of the Jacobian (0 == disabled)
+	/**
+	 * If a maximal rate is set, the Jacobian and the initialization of the
+	 * linear solver (i.e. the preconditioner) are kept as long as the Newton
+	 * iteration contracts the defect at least by this rate per step. They are
+	 * reassembled, if the last step had a worse rate, if the maximal age is
+	 * reached or if the linear solver fails with the lagged Jacobian. This
+	 * replaces the fixed frequency set by 'set_reassemble_J_freq'.
+	 */
+		void set_jacobian_reuse_rate(number maxRate)
+			{m_jacobianReuseRate = maxRate;}
+
+	///	sets the maximal number of Newton steps using the same Jacobian (0 == unlimited)
+		void set_jacobian_max_age(int maxAge)
+			{m_jacobianMaxAge = maxAge;}
+
+	///	keeps the Jacobian between calls of apply (e.g. for several time steps)
+	/**
+	 * Only used for the adaptive reuse. The Jacobian of the last call is then
+	 * also used for the first step of the next call, if the algebra size has
+	 * not changed and the last rate was good enough. Note that a changed
+	 * discretization (e.g. a new time step size) is not detected.
+	 */
+		void set_jacobian_reuse_across_calls(bool bReuse)
+			{m_bJacobianReuseAcrossCalls = bReuse;}
+
+	///	enables the Jacobian-free Newton-Krylov mode
+	/**
+	 * In the Jacobian-free mode the linear solver is applied to a
+	 * JacobianFreeOperator, that computes J(u)*c by a difference quotient of
+	 * the defect. The assembled (possibly lagged) Jacobian is only used by the
+	 * preconditioner, thus a Krylov method should be used as linear solver.
+	 */
+		void set_jacobian_free(bool bJacobianFree)
+			{m_bJacobianFree = bJacobianFree; m_bJacobianValid = false;}
+
+	///	sets the relative step size of the difference quotient in the Jacobian-free mode
+		void set_jacobian_free_eps(number eps)
+			{m_jacobianFreeEps = eps;}
+
 	private:
+	///	returns if the Jacobian must be reassembled in the Newton step
+		bool jacobian_needs_update(int loopCnt, const vector_type& u) const;
+
 	///	help functions for debug output
 	///	\{
 		void write_debug(const vector_type& vec, std::string filename);
@@ -178,6 +223,28 @@ class NewtonSolver
 	/// how often to reassemble the Jacobian (0 == 1 == in every step, i.e. classically)
 		int m_reassembe_J_freq;
 
+	///	adaptive reuse of the Jacobian
+	/// \{
+		number m_jacobianReuseRate;
+		int m_jacobianMaxAge;
+		bool m_bJacobianReuseAcrossCalls;
+	/// \}
+
+	///	Jacobian-free mode
+	/// \{
+		bool m_bJacobianFree;
+		number m_jacobianFreeEps;
+		SmartPtr<JacobianFreeOperator<algebra_type> > m_spJF;
+	/// \}
+
+	///	state of the current Jacobian
+	/// \{
+		bool m_bJacobianValid;
+		int m_jacobianAge;
+		number m_lastRate;
+		int m_numJacobianAssemblies;
+	/// \}
+
 	///	call counter
 		int m_dgbCall;
 		int m_lastNumSteps;
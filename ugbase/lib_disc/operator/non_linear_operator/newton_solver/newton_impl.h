@@ -35,6 +35,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <limits>
 
 #include "newton.h"
 #include "lib_disc/function_spaces/grid_function_util.h"
@@ -65,6 +66,16 @@ NewtonSolver(SmartPtr<ILinearOperatorInverse<vector_type> > LinearSolver,
 			m_J(NULL),
 			m_spAss(NULL),
 			m_reassembe_J_freq(0),
+			m_jacobianReuseRate(0.0),
+			m_jacobianMaxAge(0),
+			m_bJacobianReuseAcrossCalls(false),
+			m_bJacobianFree(false),
+			m_jacobianFreeEps(std::sqrt(std::numeric_limits<number>::epsilon())),
+			m_spJF(NULL),
+			m_bJacobianValid(false),
+			m_jacobianAge(0),
+			m_lastRate(0.0),
+			m_numJacobianAssemblies(0),
 			m_dgbCall(0),
 			m_lastNumSteps(0)
 {};
@@ -79,6 +90,16 @@ NewtonSolver() :
 	m_J(NULL),
 	m_spAss(NULL),
 	m_reassembe_J_freq(0),
+	m_jacobianReuseRate(0.0),
+	m_jacobianMaxAge(0),
+	m_bJacobianReuseAcrossCalls(false),
+	m_bJacobianFree(false),
+	m_jacobianFreeEps(std::sqrt(std::numeric_limits<number>::epsilon())),
+	m_spJF(NULL),
+	m_bJacobianValid(false),
+	m_jacobianAge(0),
+	m_lastRate(0.0),
+	m_numJacobianAssemblies(0),
 	m_dgbCall(0),
 	m_lastNumSteps(0)
 {};
@@ -93,6 +114,16 @@ NewtonSolver(SmartPtr<IOperator<vector_type> > N) :
 	m_J(NULL),
 	m_spAss(NULL),
 	m_reassembe_J_freq(0),
+	m_jacobianReuseRate(0.0),
+	m_jacobianMaxAge(0),
+	m_bJacobianReuseAcrossCalls(false),
+	m_bJacobianFree(false),
+	m_jacobianFreeEps(std::sqrt(std::numeric_limits<number>::epsilon())),
+	m_spJF(NULL),
+	m_bJacobianValid(false),
+	m_jacobianAge(0),
+	m_lastRate(0.0),
+	m_numJacobianAssemblies(0),
 	m_dgbCall(0),
 	m_lastNumSteps(0)
 {
@@ -109,6 +140,16 @@ NewtonSolver(SmartPtr<IAssemble<TAlgebra> > spAss) :
 	m_J(NULL),
 	m_spAss(NULL),
 	m_reassembe_J_freq(0),
+	m_jacobianReuseRate(0.0),
+	m_jacobianMaxAge(0),
+	m_bJacobianReuseAcrossCalls(false),
+	m_bJacobianFree(false),
+	m_jacobianFreeEps(std::sqrt(std::numeric_limits<number>::epsilon())),
+	m_spJF(NULL),
+	m_bJacobianValid(false),
+	m_jacobianAge(0),
+	m_lastRate(0.0),
+	m_numJacobianAssemblies(0),
 	m_dgbCall(0),
 	m_lastNumSteps(0)
 {
@@ -135,9 +176,29 @@ bool NewtonSolver<TAlgebra>::init(SmartPtr<IOperator<vector_type> > N)
 		UG_THROW("NewtonSolver: currently only works for AssembledDiscreteOperator.");
 
 	m_spAss = m_N->discretization();
+	m_bJacobianValid = false;
 	return true;
 }
 
+template <typename TAlgebra>
+bool NewtonSolver<TAlgebra>::jacobian_needs_update(int loopCnt, const vector_type& u) const
+{
+//	no Jacobian (and initialized linear solver) available
+	if(!m_bJacobianValid || m_J->num_rows() != u.size())
+		return true;
+
+//	adaptive reuse: keep the Jacobian while the contraction is good
+	if(m_jacobianReuseRate > 0.0)
+	{
+		if(loopCnt == 0 && !m_bJacobianReuseAcrossCalls) return true;
+		if(m_jacobianMaxAge > 0 && m_jacobianAge >= m_jacobianMaxAge) return true;
+		return m_lastRate > m_jacobianReuseRate;
+	}
+
+//	fixed frequency
+	return m_reassembe_J_freq == 0 || loopCnt % m_reassembe_J_freq == 0;
+}
+
 template <typename TAlgebra>
 bool NewtonSolver<TAlgebra>::prepare(vector_type& u)
 {
@@ -157,8 +218,22 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 		UG_THROW("NewtonSolver::apply: Linear Solver not set.");
 
 //	Jacobian
-	if(m_J.invalid() || m_J->discretization() != m_spAss) {
+	if(m_bJacobianFree)
+	{
+		if(m_spJF.invalid() || m_spJF->discretization() != m_spAss) {
+			m_spJF = make_sp(new JacobianFreeOperator<TAlgebra>(m_spAss, m_N));
+		}
+		m_spJF->set_operator(m_N);
+		m_spJF->set_eps(m_jacobianFreeEps);
+		if(m_J.get() != m_spJF.get()) {
+			m_J = m_spJF;
+			m_bJacobianValid = false;
+		}
+	}
+	else if(m_J.invalid() || m_J->discretization() != m_spAss || m_spJF.valid()) {
 		m_J = make_sp(new AssembledLinearOperator<TAlgebra>(m_spAss));
+		m_spJF = SPNULL;
+		m_bJacobianValid = false;
 	}
 	m_J->set_level(m_N->level());
 
@@ -219,48 +294,79 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 		for(size_t i = 0; i < m_innerStepUpdate.size(); ++i)
 			m_innerStepUpdate[i]->update();
 
-	// 	Compute Jacobian
-		try{
-			if(m_reassembe_J_freq == 0 || loopCnt % m_reassembe_J_freq == 0) // if we need to reassemble
+	//	Compute Jacobian and solve linearized system. If the linear solver
+	//	fails with a reused Jacobian, the Jacobian is reassembled and the
+	//	linear solver is applied again.
+		bool bForceJacobian = false;
+		for(;;)
+		{
+			const bool bUpdateJ = bForceJacobian || jacobian_needs_update(loopCnt, u);
+
+		// 	Compute Jacobian
+			try{
+				if(bUpdateJ)
+				{
+					NEWTON_PROFILE_BEGIN(NewtonComputeJacobian);
+					m_bJacobianValid = false;
+					m_J->init(u);
+					NEWTON_PROFILE_END();
+				}
+			}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Jacobian failed.");
+
+		//	Write the current Jacobian for debug and prepare the section for the lin. solver
+			if (this->debug_writer_valid())
 			{
-				NEWTON_PROFILE_BEGIN(NewtonComputeJacobian);
-				m_J->init(u);
-				NEWTON_PROFILE_END();
+				write_debug(m_J->get_matrix(), std::string("NEWTON_Jacobian") + debug_name_ext);
+				this->enter_debug_writer_section(std::string("NEWTON_LinSolver") + debug_name_ext);
 			}
-		}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Jacobian failed.");
-
-	//	Write the current Jacobian for debug and prepare the section for the lin. solver
-		if (this->debug_writer_valid())
-		{
-			write_debug(m_J->get_matrix(), std::string("NEWTON_Jacobian") + debug_name_ext);
-			this->enter_debug_writer_section(std::string("NEWTON_LinSolver") + debug_name_ext);
-		}
 
-	// 	Init Jacobi Inverse
-		try{
-			NEWTON_PROFILE_BEGIN(NewtonPrepareLinSolver);
-			if(!m_spLinearSolver->init(m_J, u))
+		// 	Init Jacobi Inverse (only needed for a new Jacobian)
+			if(bUpdateJ)
 			{
-				UG_LOG("ERROR in 'NewtonSolver::apply': Cannot init Inverse Linear "
-						"Operator for Jacobi-Operator.\n");
-				return false;
+				try{
+					NEWTON_PROFILE_BEGIN(NewtonPrepareLinSolver);
+					if(!m_spLinearSolver->init(m_J, u))
+					{
+						UG_LOG("ERROR in 'NewtonSolver::apply': Cannot init Inverse Linear "
+								"Operator for Jacobi-Operator.\n");
+						return false;
+					}
+					NEWTON_PROFILE_END();
+				}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Linear Solver failed.");
+
+				m_bJacobianValid = true;
+				m_jacobianAge = 0;
+				m_numJacobianAssemblies++;
 			}
-			NEWTON_PROFILE_END();
-		}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Linear Solver failed.");
 
-	// 	Solve Linearized System
-		try{
-			NEWTON_PROFILE_BEGIN(NewtonApplyLinSolver);
-			if(!m_spLinearSolver->apply(*spC, *spD))
+		//	the Jacobian-free operator is linearized at the current solution
+			if(m_spJF.valid())
+				m_spJF->set_linearization_point(u, *spD);
+
+		// 	Solve Linearized System
+			bool bSolved;
+			try{
+				NEWTON_PROFILE_BEGIN(NewtonApplyLinSolver);
+				bSolved = m_spLinearSolver->apply(*spC, *spD);
+				NEWTON_PROFILE_END();
+			}UG_CATCH_THROW("NewtonSolver::apply: Application of Linear Solver failed.");
+
+			this->leave_debug_writer_section();
+
+			if(bSolved) break;
+
+			if(bUpdateJ)
 			{
 				UG_LOG("ERROR in 'NewtonSolver::apply': Cannot apply Inverse Linear "
 						"Operator for Jacobi-Operator.\n");
 				return false;
 			}
-			NEWTON_PROFILE_END();
-		}UG_CATCH_THROW("NewtonSolver::apply: Application of Linear Solver failed.");
 
-		this->leave_debug_writer_section();
+			UG_LOG("   #  Linear solver failed with reused Jacobian, reassembling.\n");
+			bForceJacobian = true;
+			spC->set(0.0);
+		}
+		m_jacobianAge++;
 		
 	//	store convergence history
 		const int numSteps = m_spLinearSolver->step();
@@ -307,6 +413,7 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 		m_spConvCheck->update(*spD);
 		if(loopCnt-1 >= (int)m_vNonLinSolverRates.size()) m_vNonLinSolverRates.resize(loopCnt, 0);
 		m_vNonLinSolverRates[loopCnt-1] += m_spConvCheck->rate();
+		m_lastRate = m_spConvCheck->rate();
 
 	//	write defect for debug
 		if (this->debug_writer_valid())
@@ -410,6 +517,7 @@ void NewtonSolver<TAlgebra>::clear_average_convergence()
 	m_vNonLinSolverRates.clear();
 	m_vLinSolverCalls.clear();
 	m_vTotalLinSolverSteps.clear();
+	m_numJacobianAssemblies = 0;
 }
 
 template <typename TAlgebra>
@@ -448,7 +556,15 @@ std::string NewtonSolver<TAlgebra>::config_string() const
 	ss << " LineSearch: ";
 	if(m_spLineSearch.valid())		ss << ConfigShift(m_spLineSearch->config_string()) << "\n";
 	else							ss << " not set.\n";
-	if(m_reassembe_J_freq != 0)		ss << " Reassembling Jacobian only once per " << m_reassembe_J_freq << " step(s)\n";
+	if(m_jacobianReuseRate > 0.0)
+	{
+		ss << " Reusing Jacobian while the rate is below " << m_jacobianReuseRate;
+		if(m_jacobianMaxAge > 0)			ss << ", for at most " << m_jacobianMaxAge << " step(s)";
+		if(m_bJacobianReuseAcrossCalls)	ss << ", also across calls";
+		ss << "\n";
+	}
+	else if(m_reassembe_J_freq != 0)	ss << " Reassembling Jacobian only once per " << m_reassembe_J_freq << " step(s)\n";
+	if(m_bJacobianFree)				ss << " Jacobian-free Newton-Krylov (difference step eps = " << m_jacobianFreeEps << ")\n";
 	return ss.str();
 }
 
@@ -37,6 +37,7 @@
 #include "lib_grid/tools/selector_grid.h"
 #include "lib_disc/spatial_disc/local_to_global/local_to_global_mapper.h"
 #include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
+#include "lib_disc/common/revision_counter.h"
 
 namespace ug{
 
@@ -107,7 +108,8 @@ class AssemblingTuner
 		m_bSingleAssIndex(false), m_SingleAssIndex(0),
 		m_bForceRegGrid(false), m_bModifySolutionImplemented(false),
 		m_ConstraintTypesEnabled(CT_ALL), m_ElemTypesEnabled(EDT_ALL),
-		m_bMatrixIsConst(false), m_bMatrixStructureIsConst(false), m_bClearOnResize(true) {}
+		m_bMatrixIsConst(false), m_bMatrixStructureIsConst(false), m_bClearOnResize(true),
+		m_bCacheMatrixStructure(false), m_numThreads(1), m_bDeterministic(true) {}
 
 	/// destructor
 		virtual ~AssemblingTuner() {}
@@ -137,6 +139,12 @@ class AssemblingTuner
 				m_defaultMapper.add_local_mat_to_global(mat, lmat);
 		}
 
+	///	returns if a user-defined local to global mapping is set
+		bool mapping_set() const {return m_pMapper != NULL;}
+
+	///	returns the user-defined local to global mapping (NULL if not set)
+		ILocalToGlobalMapper<TAlgebra>* mapping() const {return m_pMapper;}
+
 		void modify_LocalSol(LocalVector& vecMod, const LocalVector& lvec,
 		                         ConstSmartPtr<DoFDistribution> dd) const
 		{
@@ -252,6 +260,27 @@ class AssemblingTuner
 
 		void set_matrix_structure_is_const(bool b) {m_bMatrixStructureIsConst = b;}
 
+	///	sets if the matrix structure is reused automatically
+	/**
+	 * If enabled (default: disabled), a matrix that is resized for the same revision of
+	 * the DoFDistribution it has been assembled for before (see
+	 * DoFDistribution::revision) keeps its sparsity pattern and only its
+	 * values are zeroed. Thus, repeated assembling (e.g. in Newton steps or
+	 * time steps) does not insert the connections again. If the
+	 * DoFDistribution changes (grid adaption, redistribution, reordering),
+	 * the matrix is rebuilt from scratch. The revision is stored in the
+	 * matrix (see SparseMatrix::set_index_revision).
+	 *
+	 * \param[in]	bCache		true to reuse the matrix structure
+	 */
+		void set_matrix_structure_caching(bool bCache)
+		{
+			m_bCacheMatrixStructure = bCache;
+		}
+
+	///	returns if the matrix structure is reused automatically
+		bool matrix_structure_caching() const {return m_bCacheMatrixStructure;}
+
 	/**
 	 * whether matrix is to be modified by assembling
 	 *
@@ -259,6 +288,36 @@ class AssemblingTuner
 	 */
 		bool matrix_is_const() const {return m_bMatrixIsConst;}
 
+	///	sets the number of threads used in the element loops
+	/**
+	 * If more than one thread is requested (and ug4 is compiled with OpenMP),
+	 * the element loops of the jacobian, stiffness matrix and defect assembling
+	 * are executed by several threads. Every thread uses its own
+	 * DataEvaluator and its own copies of the element discretizations (see
+	 * IElemDisc::clone_for_thread). If a disc does not provide such a copy,
+	 * the serial element loop is used.
+	 *
+	 * \param[in]	numThreads		number of threads (1 = serial)
+	 */
+		void set_num_threads(int numThreads);
+
+	///	returns the number of threads used in the element loops
+		int num_threads() const {return m_numThreads;}
+
+	///	sets if the threaded assembling must reproduce the serial results
+	/**
+	 * In the deterministic mode, the local contributions are computed in
+	 * parallel but added to the global matrix/vector in the same order as in
+	 * the serial element loop. Thus, the results are bitwise identical to the
+	 * serial assembling. Otherwise, the elements are colored such that no two
+	 * elements of a color share an index and the local contributions of one
+	 * color are added concurrently.
+	 */
+		void set_deterministic_assembling(bool bDeterministic) {m_bDeterministic = bDeterministic;}
+
+	///	returns if the threaded assembling reproduces the serial results
+		bool deterministic_assembling() const {return m_bDeterministic;}
+
 	protected:
 	///	default LocalToGlobalMapper
 		LocalToGlobalMapper<TAlgebra> m_defaultMapper;
@@ -297,6 +356,15 @@ class AssemblingTuner
 
 	/// disables clearing of vector/matrix on resize
 		bool m_bClearOnResize;
+
+	///	reuses the matrix structure if the DoFDistribution did not change
+		bool m_bCacheMatrixStructure;
+
+	///	number of threads used in the element loops
+		int m_numThreads;
+
+	///	threaded assembling adds local contributions in serial order
+		bool m_bDeterministic;
 };
 
 } // end namespace ug
@@ -37,6 +37,19 @@
 
 namespace ug{
 
+template <typename TAlgebra>
+void AssemblingTuner<TAlgebra>::set_num_threads(int numThreads)
+{
+	UG_COND_THROW(numThreads < 1, "AssemblingTuner::set_num_threads: "
+					"At least one thread required, but "<<numThreads<<" passed.");
+#ifndef UG_OPENMP
+	if(numThreads > 1)
+		UG_LOG("WARNING in AssemblingTuner::set_num_threads: ug4 is compiled "
+				"without OpenMP (cmake -DOPENMP=ON). Assembling stays serial.\n");
+#endif
+	m_numThreads = numThreads;
+}
+
 template <typename TAlgebra>
 void AssemblingTuner<TAlgebra>::resize(ConstSmartPtr<DoFDistribution> dd,
                                   vector_type& vec)	const
@@ -72,6 +85,19 @@ void AssemblingTuner<TAlgebra>::resize(ConstSmartPtr<DoFDistribution> dd,
 					"but the number of indices in the new matrix is different from that in the old one.");
 				mat.clear_retain_structure();
 			}
+			else if (m_bCacheMatrixStructure)
+			{
+			//	keep the structure, if built for the current indices
+				const RevisionCounter& rev = dd->revision();
+				if (rev.valid() && mat.has_index_revision(rev.obj(), rev.count())
+					&& mat.num_rows() == numIndex && mat.num_cols() == numIndex)
+					mat.clear_retain_structure();
+				else
+				{
+					mat.resize_and_clear(numIndex, numIndex);
+					if (rev.valid()) mat.set_index_revision(rev.obj(), rev.count());
+				}
+			}
 			else
 				mat.resize_and_clear(numIndex, numIndex);
 		}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__BATCHED_ELEM_LOOP__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__BATCHED_ELEM_LOOP__
+
+// other ug4 modules
+#include "common/common.h"
+
+// intern headers
+#include "./elem_batch.h"
+#include "./elem_disc_interface.h"
+#include "lib_disc/common/local_algebra.h"
+#include "lib_disc/spatial_disc/ass_tuner.h"
+#include "lib_disc/spatial_disc/user_data/data_evaluator.h"
+
+namespace ug {
+
+/// local storage for the elements of one ElemBatch
+/**
+ * Holds the local indices, local solutions and local results (LocalMatrix
+ * or LocalVector) for up to ElemBatch::MAX_SIZE elements, such that the
+ * memory is reused for all batches of an element loop.
+ *
+ * \tparam	dim			world dimension
+ * \tparam	TLocal		type of local result (LocalMatrix or LocalVector)
+ */
+template <int dim, typename TLocal>
+struct ElemBatchStorage
+{
+	static const size_t MAX_SIZE = ElemBatch<dim>::MAX_SIZE;
+
+	ElemBatch<dim> batch;
+	LocalIndices vInd[MAX_SIZE];
+	LocalVector vU[MAX_SIZE];
+	TLocal vLoc[MAX_SIZE];
+	TLocal* vpLoc[MAX_SIZE];
+
+	ElemBatchStorage() {for(size_t e = 0; e < MAX_SIZE; ++e) vpLoc[e] = &vLoc[e];}
+};
+
+/// fills the next batch of elements, returns the iterator behind the last visited element
+template <typename TElem, typename TIterator, typename TDomain, typename TAlgebra, typename TLocal>
+TIterator FillElemBatch(ElemBatchStorage<TDomain::dim, TLocal>& s,
+                        TIterator iter, TIterator iterEnd,
+                        const TDomain& domain,
+                        ConstSmartPtr<DoFDistribution> dd, bool bUseHanging,
+                        const typename TAlgebra::vector_type& u,
+                        const AssemblingTuner<TAlgebra>& assTuner)
+{
+	static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+	MathVector<TDomain::dim> vCornerCoords[TElem::NUM_VERTICES];
+
+	s.batch.clear(id, TElem::NUM_VERTICES);
+	for(; iter != iterEnd && !s.batch.full(); ++iter)
+	{
+		TElem* elem = *iter;
+		if(!assTuner.element_used(elem)) continue;
+
+		FillCornerCoordinates(vCornerCoords, *elem, domain);
+
+		const size_t e = s.batch.size();
+		dd->indices(elem, s.vInd[e], bUseHanging);
+		s.vU[e].resize(s.vInd[e]);
+		s.vLoc[e].resize(s.vInd[e]);
+		GetLocalVector(s.vU[e], u);
+		s.vLoc[e] = 0.0;
+
+		s.batch.push_back(elem, vCornerCoords, &s.vU[e]);
+	}
+	return iter;
+}
+
+/// assembles the stiffness jacobian of the elements in batches
+/**
+ * The elements are processed in batches of up to ElemBatch::MAX_SIZE
+ * elements. The DataEvaluator must have been prepared for the element type
+ * and Eval.batch_assembling_possible(roid, true) must hold.
+ */
+template <typename TElem, typename TIterator, typename TDomain, typename TAlgebra>
+void BatchedAssembleJacobian(DataEvaluator<TDomain>& Eval,
+                             const TDomain& domain,
+                             ConstSmartPtr<DoFDistribution> dd,
+                             TIterator iterBegin, TIterator iterEnd,
+                             typename TAlgebra::matrix_type& J,
+                             const typename TAlgebra::vector_type& u,
+                             const AssemblingTuner<TAlgebra>& assTuner)
+{
+	ElemBatchStorage<TDomain::dim, LocalMatrix> s;
+
+	TIterator iter = iterBegin;
+	while(iter != iterEnd)
+	{
+		iter = FillElemBatch<TElem, TIterator, TDomain, TAlgebra, LocalMatrix>
+				(s, iter, iterEnd, domain, dd, Eval.use_hanging(), u, assTuner);
+		if(s.batch.empty()) break;
+
+		try{
+			Eval.prepare_elem_batch(s.batch);
+			Eval.add_jac_A_elem_batch(s.vpLoc, s.batch);
+		}
+		UG_CATCH_THROW("BatchedAssembleJacobian: Cannot compute Jacobian (A).");
+
+		try{
+			for(size_t e = 0; e < s.batch.size(); ++e)
+				assTuner.add_local_mat_to_global(J, s.vLoc[e], dd);
+		}
+		UG_CATCH_THROW("BatchedAssembleJacobian: Cannot add local matrix.");
+	}
+}
+
+/// assembles the stationary defect (stiffness part minus rhs) of the elements in batches
+/**
+ * The elements are processed in batches of up to ElemBatch::MAX_SIZE
+ * elements. The DataEvaluator must have been prepared for the element type
+ * and Eval.batch_assembling_possible(roid, false) must hold.
+ */
+template <typename TElem, typename TIterator, typename TDomain, typename TAlgebra>
+void BatchedAssembleDefect(DataEvaluator<TDomain>& Eval,
+                           const TDomain& domain,
+                           ConstSmartPtr<DoFDistribution> dd,
+                           TIterator iterBegin, TIterator iterEnd,
+                           typename TAlgebra::vector_type& d,
+                           const typename TAlgebra::vector_type& u,
+                           const AssemblingTuner<TAlgebra>& assTuner)
+{
+	ElemBatchStorage<TDomain::dim, LocalVector> s;
+	LocalVector vRhs[ElemBatch<TDomain::dim>::MAX_SIZE];
+	LocalVector* vpRhs[ElemBatch<TDomain::dim>::MAX_SIZE];
+	for(size_t e = 0; e < ElemBatch<TDomain::dim>::MAX_SIZE; ++e) vpRhs[e] = &vRhs[e];
+
+	TIterator iter = iterBegin;
+	while(iter != iterEnd)
+	{
+		iter = FillElemBatch<TElem, TIterator, TDomain, TAlgebra, LocalVector>
+				(s, iter, iterEnd, domain, dd, Eval.use_hanging(), u, assTuner);
+		if(s.batch.empty()) break;
+
+		try{
+			Eval.prepare_elem_batch(s.batch);
+			Eval.add_def_A_elem_batch(s.vpLoc, s.batch);
+		}
+		UG_CATCH_THROW("BatchedAssembleDefect: Cannot compute Defect (A).");
+
+		try{
+			for(size_t e = 0; e < s.batch.size(); ++e)
+				{vRhs[e].resize(s.vInd[e]); vRhs[e] = 0.0;}
+			Eval.add_rhs_elem_batch(vpRhs, s.batch);
+			for(size_t e = 0; e < s.batch.size(); ++e)
+				s.vLoc[e].scale_append(-1, vRhs[e]);
+		}
+		UG_CATCH_THROW("BatchedAssembleDefect: Cannot compute Rhs.");
+
+		try{
+			for(size_t e = 0; e < s.batch.size(); ++e)
+				assTuner.add_local_vec_to_global(d, s.vLoc[e], dd);
+		}
+		UG_CATCH_THROW("BatchedAssembleDefect: Cannot add local vector.");
+	}
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__BATCHED_ELEM_LOOP__ */
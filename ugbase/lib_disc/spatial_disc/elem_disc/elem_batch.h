@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_BATCH__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_BATCH__
+
+#include "common/common.h"
+#include "common/math/ugmath.h"
+#include "lib_grid/grid/grid_base_objects.h"
+#include "lib_disc/common/local_algebra.h"
+
+namespace ug{
+
+///	a batch of elements of the same type, that is assembled at once
+/**
+ * An ElemBatch collects up to MAX_SIZE elements of the same reference
+ * object type together with their local solution vectors. The corner
+ * coordinates are stored in structure-of-arrays form, i.e.
+ * coord(co, d)[e] is the d-th component of corner co of element e, so that
+ * batched element kernels can loop over the elements in the innermost loop
+ * and are vectorized by the compiler.
+ *
+ * For simplices (edge in 1d, triangle in 2d, tetrahedron in 3d), the batch
+ * also provides the geometry of the affine reference mapping x = x_0 + J xi
+ * for all elements of the batch (see compute_simplex_geometry).
+ */
+template <int dim>
+class ElemBatch
+{
+	public:
+	///	maximum number of elements in a batch
+		static const size_t MAX_SIZE = 8;
+
+	///	maximum number of corners of an element
+		static const size_t MAX_CORNERS = 8;
+
+	public:
+		ElemBatch() : m_roid(ROID_UNKNOWN), m_numCorner(0), m_size(0) {}
+
+	///	removes all elements and sets the element type of the batch
+		void clear(ReferenceObjectID roid, size_t numCorner)
+		{
+			UG_ASSERT(numCorner <= MAX_CORNERS, "Too many corners: " << numCorner);
+			m_roid = roid; m_numCorner = numCorner; m_size = 0;
+			for(size_t co = 0; co < MAX_CORNERS; ++co)
+				for(int d = 0; d < dim; ++d)
+					for(size_t e = 0; e < MAX_SIZE; ++e)
+						m_vCoord[co][d][e] = 0.0;
+		}
+
+	///	adds an element, returns its position in the batch
+		size_t push_back(GridObject* elem, const MathVector<dim> vCornerCoords[],
+		                 LocalVector* pU)
+		{
+			UG_ASSERT(m_size < MAX_SIZE, "Batch full.");
+			const size_t e = m_size++;
+			m_vElem[e] = elem;
+			m_vpU[e] = pU;
+			for(size_t co = 0; co < m_numCorner; ++co)
+			{
+				m_vCornerCoords[e][co] = vCornerCoords[co];
+				for(int d = 0; d < dim; ++d)
+					m_vCoord[co][d][e] = vCornerCoords[co][d];
+			}
+			return e;
+		}
+
+	///	number of elements in the batch
+		size_t size() const {return m_size;}
+
+	///	returns if no more element can be added
+		bool full() const {return m_size == MAX_SIZE;}
+
+	///	returns if the batch is empty
+		bool empty() const {return m_size == 0;}
+
+	///	reference object id of the elements
+		ReferenceObjectID roid() const {return m_roid;}
+
+	///	number of corners of the elements
+		size_t num_corners() const {return m_numCorner;}
+
+	///	element e of the batch
+		GridObject* elem(size_t e) const {return m_vElem[e];}
+
+	///	local solution of element e
+	/// \{
+		LocalVector& u(size_t e) {return *m_vpU[e];}
+		const LocalVector& u(size_t e) const {return *m_vpU[e];}
+	/// \}
+
+	///	corner coordinates of element e (array-of-structures)
+		const MathVector<dim>* corners(size_t e) const {return m_vCornerCoords[e];}
+
+	///	component d of corner co for all elements (structure-of-arrays)
+		const number* coord(size_t co, int d) const {return m_vCoord[co][d];}
+
+	///	computes the geometry of the affine map for all elements (simplices only)
+	/**
+	 * Computes for every element the Jacobian J of the reference mapping, its
+	 * determinant and the transposed inverse, that maps the reference
+	 * gradients of the shape functions to the physical ones.
+	 * Only for elements with dim+1 corners in dimension dim.
+	 */
+		void compute_simplex_geometry()
+		{
+			UG_COND_THROW(m_numCorner != (size_t)dim+1,
+			              "ElemBatch: simplex geometry requires "<<dim+1<<" corners,"
+			              " but elements have "<<m_numCorner<<".");
+
+		//	J(i,j) = x_{j+1,i} - x_{0,i}
+			for(int i = 0; i < dim; ++i)
+				for(int j = 0; j < dim; ++j)
+					for(size_t e = 0; e < MAX_SIZE; ++e)
+						m_vJ[i][j][e] = m_vCoord[j+1][i][e] - m_vCoord[0][i][e];
+
+		//	unused slots get a regular dummy geometry
+			for(size_t e = m_size; e < MAX_SIZE; ++e)
+				for(int i = 0; i < dim; ++i)
+					for(int j = 0; j < dim; ++j)
+						m_vJ[i][j][e] = (i == j) ? 1.0 : 0.0;
+
+			invert_jacobians();
+		}
+
+	///	Jacobian J(i,j) of the affine map for all elements
+		const number* jacobian(int i, int j) const {return m_vJ[i][j];}
+
+	///	entry (i,j) of the transposed inverse of J for all elements
+		const number* jacobian_inverse_transposed(int i, int j) const {return m_vJInvT[i][j];}
+
+	///	determinant of J for all elements
+		const number* jacobian_det() const {return m_vDetJ;}
+
+	protected:
+	///	computes determinant and transposed inverse of m_vJ (loops over elements inside)
+		void invert_jacobians()
+		{
+			if(dim == 1)
+			{
+				for(size_t e = 0; e < MAX_SIZE; ++e)
+				{
+					m_vDetJ[e] = m_vJ[0][0][e];
+					m_vJInvT[0][0][e] = 1.0 / m_vDetJ[e];
+				}
+			}
+			else if(dim == 2)
+			{
+				for(size_t e = 0; e < MAX_SIZE; ++e)
+				{
+					const number det = m_vJ[0][0][e]*m_vJ[1][1][e] - m_vJ[0][1][e]*m_vJ[1][0][e];
+					const number invDet = 1.0 / det;
+					m_vDetJ[e] = det;
+					m_vJInvT[0][0][e] =  m_vJ[1][1][e] * invDet;
+					m_vJInvT[0][1][e] = -m_vJ[1][0][e] * invDet;
+					m_vJInvT[1][0][e] = -m_vJ[0][1][e] * invDet;
+					m_vJInvT[1][1][e] =  m_vJ[0][0][e] * invDet;
+				}
+			}
+			else
+			{
+			//	cofactor matrix (= det * J^{-T})
+				for(int i = 0; i < dim; ++i)
+					for(int j = 0; j < dim; ++j)
+					{
+						const int i1 = (i+1)%dim, i2 = (i+2)%dim;
+						const int j1 = (j+1)%dim, j2 = (j+2)%dim;
+						for(size_t e = 0; e < MAX_SIZE; ++e)
+							m_vJInvT[i][j][e] = m_vJ[i1][j1][e]*m_vJ[i2][j2][e]
+											  - m_vJ[i1][j2][e]*m_vJ[i2][j1][e];
+					}
+				for(size_t e = 0; e < MAX_SIZE; ++e)
+				{
+					number det = 0;
+					for(int j = 0; j < dim; ++j)
+						det += m_vJ[0][j][e] * m_vJInvT[0][j][e];
+					m_vDetJ[e] = det;
+				}
+				for(int i = 0; i < dim; ++i)
+					for(int j = 0; j < dim; ++j)
+						for(size_t e = 0; e < MAX_SIZE; ++e)
+							m_vJInvT[i][j][e] /= m_vDetJ[e];
+			}
+		}
+
+	protected:
+		ReferenceObjectID m_roid;
+		size_t m_numCorner;
+		size_t m_size;
+
+		GridObject* m_vElem[MAX_SIZE];
+		LocalVector* m_vpU[MAX_SIZE];
+
+	//	corner coordinates, AoS and SoA
+		MathVector<dim> m_vCornerCoords[MAX_SIZE][MAX_CORNERS];
+		number m_vCoord[MAX_CORNERS][dim][MAX_SIZE];
+
+	//	affine geometry (simplices)
+		number m_vJ[dim][dim][MAX_SIZE];
+		number m_vJInvT[dim][dim][MAX_SIZE];
+		number m_vDetJ[MAX_SIZE];
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_BATCH__ */
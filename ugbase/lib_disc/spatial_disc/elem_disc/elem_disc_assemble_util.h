@@ -43,6 +43,8 @@
 // intern headers
 #include "../../reference_element/reference_element.h"
 #include "./elem_disc_interface.h"
+#include "./threaded_elem_loop.h"
+#include "./batched_elem_loop.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/common/local_algebra.h"
 #include "lib_disc/spatial_disc/user_data/data_evaluator.h"
@@ -124,6 +126,19 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if requested
+		if(ThreadedElemLoopPossible(vElemDisc, *spAssTuner))
+		{
+			std::vector<TElem*> vElem;
+			CollectAssembledElements(vElem, iterBegin, iterEnd, *spAssTuner);
+			try{
+				ThreadedElemLoop(vElemDisc, spDomain, dd, vElem, si, bNonRegularGrid, A,
+				                 ThreadedJacobianOp<domain_type, algebra_type>(u, true), *spAssTuner);
+			}
+			UG_CATCH_THROW("AssembleStiffnessMatrix: Threaded element loop failed.");
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -338,6 +353,19 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if requested
+		if(ThreadedElemLoopPossible(vElemDisc, *spAssTuner))
+		{
+			std::vector<TElem*> vElem;
+			CollectAssembledElements(vElem, iterBegin, iterEnd, *spAssTuner);
+			try{
+				ThreadedElemLoop(vElemDisc, spDomain, dd, vElem, si, bNonRegularGrid, J,
+				                 ThreadedJacobianOp<domain_type, algebra_type>(u, false), *spAssTuner);
+			}
+			UG_CATCH_THROW("(stationary) AssembleJacobian: Threaded element loop failed.");
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -353,6 +381,14 @@ public:
 	//	prepare element loop
 		Eval.prepare_elem_loop(id, si);
 
+	//	use batched element kernels if all elem discs provide them
+		if(Eval.batch_assembling_possible(id, true))
+		{
+			BatchedAssembleJacobian<TElem, TIterator, domain_type, algebra_type>
+				(Eval, *spDomain, dd, iterBegin, iterEnd, J, u, *spAssTuner);
+			iterBegin = iterEnd;
+		}
+
 	//	local indices and local algebra
 		LocalIndices ind; LocalVector locU; LocalMatrix locJ;
 
@@ -451,6 +487,19 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if requested
+		if(ThreadedElemLoopPossible(vElemDisc, *spAssTuner))
+		{
+			std::vector<TElem*> vElem;
+			CollectAssembledElements(vElem, iterBegin, iterEnd, *spAssTuner);
+			try{
+				ThreadedElemLoop(vElemDisc, spDomain, dd, vElem, si, bNonRegularGrid, J,
+				                 ThreadedJacobianOp<domain_type, algebra_type>(vSol, s_a0), *spAssTuner);
+			}
+			UG_CATCH_THROW("(instationary) AssembleJacobian: Threaded element loop failed.");
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -589,6 +638,20 @@ public:
 	//	check if at least one element exists, else return
 		if(iterBegin == iterEnd) return;
 
+	//	use the thread-parallel element loop if requested (not with modified solutions)
+		if(ThreadedElemLoopPossible(vElemDisc, *spAssTuner)
+			&& !spAssTuner->modify_solution_enabled())
+		{
+			std::vector<TElem*> vElem;
+			CollectAssembledElements(vElem, iterBegin, iterEnd, *spAssTuner);
+			try{
+				ThreadedElemLoop(vElemDisc, spDomain, dd, vElem, si, bNonRegularGrid, d,
+				                 ThreadedDefectOp<domain_type, algebra_type>(u), *spAssTuner);
+			}
+			UG_CATCH_THROW("(stationary) AssembleDefect: Threaded element loop failed.");
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -604,6 +667,15 @@ public:
 	//	prepare element loop
 		Eval.prepare_elem_loop(id, si);
 
+	//	use batched element kernels if all elem discs provide them
+		if(Eval.batch_assembling_possible(id, false)
+			&& !spAssTuner->modify_solution_enabled())
+		{
+			BatchedAssembleDefect<TElem, TIterator, domain_type, algebra_type>
+				(Eval, *spDomain, dd, iterBegin, iterEnd, d, u, *spAssTuner);
+			iterBegin = iterEnd;
+		}
+
 	//	local indices and local algebra
 		LocalIndices ind; LocalVector locU, locD, tmpLocD;
 
@@ -741,6 +813,20 @@ public:
 					"least "<<vScaleStiff.size()<<" time steps, but only "<<
 					vSol->size() << " passed.");
 
+	//	use the thread-parallel element loop if requested
+		if(ThreadedElemLoopPossible(vElemDisc, *spAssTuner))
+		{
+			std::vector<TElem*> vElem;
+			CollectAssembledElements(vElem, iterBegin, iterEnd, *spAssTuner);
+			try{
+				ThreadedElemLoop(vElemDisc, spDomain, dd, vElem, si, bNonRegularGrid, d,
+				                 ThreadedDefectOp<domain_type, algebra_type>(vSol, vScaleMass, vScaleStiff),
+				                 *spAssTuner);
+			}
+			UG_CATCH_THROW("(instationary) AssembleDefect: Threaded element loop failed.");
+			return;
+		}
+
 	//	create local time series
 		LocalVectorTimeSeries locTimeSeries;
 		locTimeSeries.read_times(vSol);
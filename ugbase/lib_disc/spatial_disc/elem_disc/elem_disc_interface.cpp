@@ -99,6 +99,11 @@ void IElemAssembleFuncs<TLeaf, TDomain>::clear_add_fct(ReferenceObjectID id)
 	m_vElemdMFct[id] = NULL;
 
 	m_vElemRHSFct[id] = NULL;
+
+	m_vPrepareElemBatchFct[id] = NULL;
+	m_vElemJABatchFct[id] = NULL;
+	m_vElemdABatchFct[id] = NULL;
+	m_vElemRHSBatchFct[id] = NULL;
 }
 
 
@@ -198,6 +203,11 @@ set_default_add_fct()
 		m_vElemdMFct[i] = &T::add_def_M_elem;
 
 		m_vElemRHSFct[i] = &T::add_rhs_elem;
+
+		m_vPrepareElemBatchFct[i] = NULL;
+		m_vElemJABatchFct[i] = NULL;
+		m_vElemdABatchFct[i] = NULL;
+		m_vElemRHSBatchFct[i] = NULL;
 	}
 
 	for (size_t i = 0; i < bridge::NUM_ALGEBRA_TYPES; ++i)
@@ -657,6 +667,64 @@ do_add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCorne
 	(this->*m_vElemRHSFct[m_roid])(rhs, elem, vCornerCoords);
 }
 
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::
+do_prep_elem_batch(ElemBatch<dim>& batch)
+{
+	//	access by map
+	for(size_t e = 0; e < batch.size(); ++e)
+		batch.u(e).access_by_map(asLeaf().map());
+
+	//	call assembling routine
+	UG_ASSERT(m_vPrepareElemBatchFct[m_roid]!=NULL, "ElemDisc method prep_elem_batch missing.");
+	(this->*(m_vPrepareElemBatchFct[m_roid]))(batch);
+}
+
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::
+do_add_jac_A_elem_batch(LocalMatrix* vJ[], ElemBatch<dim>& batch)
+{
+	//	access by map
+	for(size_t e = 0; e < batch.size(); ++e)
+	{
+		batch.u(e).access_by_map(asLeaf().map());
+		vJ[e]->access_by_map(asLeaf().map());
+	}
+
+	//	call assembling routine
+	UG_ASSERT(m_vElemJABatchFct[m_roid]!=NULL, "ElemDisc method add_jac_A_elem_batch missing.");
+	(this->*m_vElemJABatchFct[m_roid])(vJ, batch);
+}
+
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::
+do_add_def_A_elem_batch(LocalVector* vD[], ElemBatch<dim>& batch)
+{
+	//	access by map
+	for(size_t e = 0; e < batch.size(); ++e)
+	{
+		batch.u(e).access_by_map(asLeaf().map());
+		vD[e]->access_by_map(asLeaf().map());
+	}
+
+	//	call assembling routine
+	UG_ASSERT(m_vElemdABatchFct[m_roid]!=NULL, "ElemDisc method add_def_A_elem_batch missing.");
+	(this->*m_vElemdABatchFct[m_roid])(vD, batch);
+}
+
+template <typename TLeaf, typename TDomain>
+void IElemAssembleFuncs<TLeaf, TDomain>::
+do_add_rhs_elem_batch(LocalVector* vRhs[], ElemBatch<dim>& batch)
+{
+	//	access by map
+	for(size_t e = 0; e < batch.size(); ++e)
+		vRhs[e]->access_by_map(asLeaf().map());
+
+	//	call assembling routine
+	UG_ASSERT(m_vElemRHSBatchFct[m_roid]!=NULL, "ElemDisc method add_rhs_elem_batch missing.");
+	(this->*m_vElemRHSBatchFct[m_roid])(vRhs, batch);
+}
+
 template <typename TLeaf, typename TDomain>
 void IElemEstimatorFuncs<TLeaf, TDomain>::
 do_prep_err_est_elem_loop(const ReferenceObjectID roid, const int si)
@@ -48,6 +48,7 @@
 #include "lib_disc/domain_util.h"
 #include "lib_disc/domain_traits.h"
 #include "elem_modifier.h"
+#include "elem_batch.h"
 #include "lib_disc/spatial_disc/elem_disc/err_est_data.h"
 #include "bridge/util_algebra_dependent.h"
 #include "lib_disc/common/multi_index.h"
@@ -192,6 +193,28 @@ public:
 	void do_add_def_A_expl_elem(LocalVector& d, LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]);
 	void do_add_def_M_elem(LocalVector& d, LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]);
 	void do_add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[]);
+	/// \}
+
+	///	batched assembling of several elements of one type (see ElemBatch)
+	/**
+	 * An elem disc may register batched versions of prep_elem, add_jac_A_elem,
+	 * add_def_A_elem and add_rhs_elem for an element type, that process all elements of an
+	 * ElemBatch in one call. The local matrices / vectors are passed in the
+	 * order of the elements in the batch. For element types without batched
+	 * functions, the element-wise functions are used.
+	 * \{
+	 */
+	bool batched_jac_A_supported(ReferenceObjectID roid) const
+	{return m_vPrepareElemBatchFct[roid] != NULL && m_vElemJABatchFct[roid] != NULL;}
+	bool batched_def_A_supported(ReferenceObjectID roid) const
+	{return m_vPrepareElemBatchFct[roid] != NULL && m_vElemdABatchFct[roid] != NULL
+			&& m_vElemRHSBatchFct[roid] != NULL;}
+
+	void do_prep_elem_batch(ElemBatch<dim>& batch);
+	void do_add_jac_A_elem_batch(LocalMatrix* vJ[], ElemBatch<dim>& batch);
+	void do_add_def_A_elem_batch(LocalVector* vD[], ElemBatch<dim>& batch);
+	void do_add_rhs_elem_batch(LocalVector* vRhs[], ElemBatch<dim>& batch);
+	/// \}
 
 
 
@@ -214,6 +237,11 @@ protected:
 	template <typename TAssFunc> void set_add_def_M_elem_fct(ReferenceObjectID id, TAssFunc func);
 	template <typename TAssFunc> void set_add_rhs_elem_fct(ReferenceObjectID id, TAssFunc func);
 
+	template <typename TAssFunc> void set_prep_elem_batch_fct(ReferenceObjectID id, TAssFunc func);
+	template <typename TAssFunc> void set_add_jac_A_elem_batch_fct(ReferenceObjectID id, TAssFunc func);
+	template <typename TAssFunc> void set_add_def_A_elem_batch_fct(ReferenceObjectID id, TAssFunc func);
+	template <typename TAssFunc> void set_add_rhs_elem_batch_fct(ReferenceObjectID id, TAssFunc func);
+
 
 
 	//	unregister functions
@@ -233,6 +261,11 @@ protected:
 	void remove_add_def_M_elem_fct(ReferenceObjectID id);
 	void remove_add_rhs_elem_fct(ReferenceObjectID id);
 
+	void remove_prep_elem_batch_fct(ReferenceObjectID id);
+	void remove_add_jac_A_elem_batch_fct(ReferenceObjectID id);
+	void remove_add_def_A_elem_batch_fct(ReferenceObjectID id);
+	void remove_add_rhs_elem_batch_fct(ReferenceObjectID id);
+
 protected:
 	///	sets all assemble functions to the corresponding virtual ones
 	void set_default_add_fct();
@@ -269,6 +302,12 @@ private:
 // 	types of right hand side assemble functions
 	typedef void (T::*ElemRHSFct)(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[]);
 
+// 	types of batched assemble functions
+	typedef void (T::*PrepareElemBatchFct)(const ElemBatch<dim>& batch);
+	typedef void (T::*ElemJABatchFct)(LocalMatrix* vJ[], const ElemBatch<dim>& batch);
+	typedef void (T::*ElemdABatchFct)(LocalVector* vD[], const ElemBatch<dim>& batch);
+	typedef void (T::*ElemRHSBatchFct)(LocalVector* vRhs[], const ElemBatch<dim>& batch);
+
 
 private:
 // 	timestep function pointers
@@ -294,6 +333,12 @@ private:
 // 	Rhs function pointers
 	ElemRHSFct 	m_vElemRHSFct[NUM_REFERENCE_OBJECTS];
 
+// 	batched function pointers (NULL if not implemented)
+	PrepareElemBatchFct	m_vPrepareElemBatchFct[NUM_REFERENCE_OBJECTS];
+	ElemJABatchFct 	m_vElemJABatchFct[NUM_REFERENCE_OBJECTS];
+	ElemdABatchFct 	m_vElemdABatchFct[NUM_REFERENCE_OBJECTS];
+	ElemRHSBatchFct m_vElemRHSBatchFct[NUM_REFERENCE_OBJECTS];
+
 public:
 /// sets the geometric object type
 /**
@@ -851,6 +896,27 @@ public:
 	std::vector<SmartPtr<IElemDiscModifier<TDomain> > >& get_elem_modifier()
 	{ return m_spElemModifier;}
 
+	///	returns an independent copy of this disc for a concurrent assembling thread
+	/**
+	 * The threaded element loops (see AssemblingTuner::set_num_threads) need
+	 * one instance of every element discretization per thread, since the
+	 * element-wise state (e.g. geometries and data imports) is stored in the
+	 * disc. The copy must not share any data written during the element loop
+	 * with this disc, including connected user data.
+	 * The default implementation returns an invalid pointer, which makes the
+	 * assembling fall back to the serial element loop. Discs overriding this
+	 * method must also override clone_for_thread_supported.
+	 */
+	virtual SmartPtr<IElemDisc<TDomain> > clone_for_thread() const
+	{ return SmartPtr<IElemDisc<TDomain> >();}
+
+	///	returns if clone_for_thread returns a valid copy in the current setup
+	/**
+	 * This check is used to select the element loop and must be cheap, i.e.
+	 * it must not create the copy.
+	 */
+	virtual bool clone_for_thread_supported() const {return false;}
+
 protected:
 	///	Approximation Space
 	std::vector<SmartPtr<IElemDiscModifier<TDomain> > > m_spElemModifier;
@@ -33,6 +33,7 @@
 #include "neumann_boundary_fv1.h"
 #include "lib_disc/spatial_disc/disc_util/fv1_geom.h"
 #include "lib_disc/spatial_disc/disc_util/geom_provider.h"
+#include "lib_disc/spatial_disc/user_data/const_user_data.h"
 
 namespace ug{
 
@@ -43,7 +44,7 @@ namespace ug{
 
 template<typename TDomain>
 NeumannBoundaryFV1<TDomain>::NeumannBoundaryFV1(const char* function)
- :NeumannBoundaryBase<TDomain>(function)
+ :NeumannBoundaryBase<TDomain>(function), m_bOwnGeom(false)
 {
 	register_all_funcs(false);
 }
@@ -66,7 +67,7 @@ template<typename TDomain>
 void NeumannBoundaryFV1<TDomain>::
 add(SmartPtr<CplUserData<number, dim> > data, const char* BndSubsets, const char* InnerSubsets)
 {
-	m_vNumberData.push_back(NumberData(data, BndSubsets, InnerSubsets));
+	m_vNumberData.push_back(NumberData(data, BndSubsets, InnerSubsets, this));
 	this->add_inner_subsets(InnerSubsets);
 }
 
@@ -97,6 +98,64 @@ void NeumannBoundaryFV1<TDomain>::update_subset_groups()
 		update_subset_groups(m_vVectorData[i]);
 }
 
+template<typename TDomain>
+bool NeumannBoundaryFV1<TDomain>::clone_for_thread_supported() const
+{
+//	the user data stores the evaluated values and must not be shared, hence
+//	only constant data, that can be copied, is allowed
+	if(this->approx_space().invalid()) return false;
+	if(!this->m_spElemModifier.empty()) return false;
+	if(!m_vBNDNumberData.empty()) return false;
+	for(size_t i = 0; i < m_vNumberData.size(); ++i)
+		if(!m_vNumberData[i].import.constant()) return false;
+	for(size_t i = 0; i < m_vVectorData.size(); ++i)
+		if(!m_vVectorData[i].functor->constant()) return false;
+	return true;
+}
+
+template<typename TDomain>
+SmartPtr<IElemDisc<TDomain> > NeumannBoundaryFV1<TDomain>::clone_for_thread() const
+{
+	if(!clone_for_thread_supported()) return SPNULL;
+
+	SmartPtr<this_type> spClone = make_sp(new this_type(this->symb_fcts()[0].c_str()));
+	spClone->m_bOwnGeom = true;
+	spClone->set_stationary(this->m_bStationaryForced);
+	spClone->set_approximation_space(this->approx_space().cast_const());
+
+//	copy the constant data (evaluated at an arbitrary point)
+	const MathVector<dim> x(0.0);
+	for(size_t i = 0; i < m_vNumberData.size(); ++i){
+		number val;
+		(*m_vNumberData[i].import.user_data())(val, x, 0.0, 0);
+		SmartPtr<CplUserData<number, dim> > spData = make_sp(new ConstUserNumber<dim>(val));
+		spClone->add(spData, m_vNumberData[i].BndSubsetNames.c_str(),
+		             m_vNumberData[i].InnerSubsetNames.c_str());
+	}
+	for(size_t i = 0; i < m_vVectorData.size(); ++i){
+		MathVector<dim> val;
+		(*m_vVectorData[i].functor)(val, x, 0.0, 0);
+		SmartPtr<ConstUserVector<dim> > spConst = make_sp(new ConstUserVector<dim>);
+		for(int d = 0; d < dim; ++d) spConst->set_entry(d, val[d]);
+		SmartPtr<CplUserData<MathVector<dim>, dim> > spData = spConst;
+		spClone->add(spData, m_vVectorData[i].BndSubsetNames.c_str(),
+		             m_vVectorData[i].InnerSubsetNames.c_str());
+	}
+
+	return spClone;
+}
+
+template<typename TDomain>
+template<typename TFVGeom>
+TFVGeom& NeumannBoundaryFV1<TDomain>::geo(ReferenceObjectID roid)
+{
+	if(!m_bOwnGeom) return GeomProvider<TFVGeom>::get();
+
+	if(m_vspOwnGeom[roid].invalid())
+		m_vspOwnGeom[roid] = SmartPtr<void>(SmartPtr<TFVGeom>(new TFVGeom));
+	return *static_cast<TFVGeom*>(m_vspOwnGeom[roid].get());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //	assembling functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -110,7 +169,7 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 	m_si = si;
 
 //	register subsetIndex at Geometry
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	TFVGeom& geo = this->template geo<TFVGeom>(roid);
 
 //	request subset indices as boundary subset. This will force the
 //	creation of boundary subsets when calling geo.update
@@ -161,7 +220,7 @@ void NeumannBoundaryFV1<TDomain>::
 prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[])
 {
 //  update Geometry for this element
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	TFVGeom& geo = this->template geo<TFVGeom>(roid);
 	try{
 		geo.update(elem, vCornerCoords, &(this->subset_handler()));
 	}
@@ -178,12 +237,55 @@ template<typename TElem, typename TFVGeom>
 void NeumannBoundaryFV1<TDomain>::
 add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoords[])
 {
-	const static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	const TFVGeom& geo = this->template geo<TFVGeom>(geometry_traits<TElem>::REFERENCE_OBJECT_ID);
+	add_rhs<TFVGeom>(d, geo, false);
+}
+
+template<typename TDomain>
+template<typename TElem, typename TFVGeom>
+void NeumannBoundaryFV1<TDomain>::
+add_rhs_elem_batch(LocalVector* vRhs[], const ElemBatch<dim>& batch)
+{
+	TFVGeom& geo = this->template geo<TFVGeom>(batch.roid());
+
+	for(size_t e = 0; e < batch.size(); ++e)
+	{
+		try{
+			geo.update(batch.elem(e), batch.corners(e), &(this->subset_handler()));
+		}
+		UG_CATCH_THROW("NeumannBoundaryFV1::add_rhs_elem_batch: "
+							"Cannot update Finite Volume Geometry.");
+
+		add_rhs<TFVGeom>(*vRhs[e], geo, true);
+	}
+}
+
+template<typename TDomain>
+template<typename TFVGeom>
+void NeumannBoundaryFV1<TDomain>::
+add_rhs(LocalVector& d, const TFVGeom& geo, bool bEvalNumberData)
+{
 	typedef typename TFVGeom::BF BF;
 
 //	Number Data
 	for(size_t data = 0; data < m_vNumberData.size(); ++data){
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+
+	//	evaluate the data at the integration points of all boundary subsets
+		if(bEvalNumberData){
+			m_vEvalGloIP.clear();
+			for(size_t s = 0; s < m_vNumberData[data].BndSSGrp.size(); ++s){
+				const std::vector<BF>& vBF = geo.bf(m_vNumberData[data].BndSSGrp[s]);
+				for(size_t i = 0; i < vBF.size(); ++i)
+					m_vEvalGloIP.push_back(vBF[i].global_ip());
+			}
+			if(m_vEvalGloIP.empty()) continue;
+
+			m_vEvalValue.resize(m_vEvalGloIP.size());
+			(*m_vNumberData[data].import.user_data())
+				(&m_vEvalValue[0], &m_vEvalGloIP[0], this->time(), m_si, m_vEvalGloIP.size());
+		}
+
 		size_t ip = 0;
 		for(size_t s = 0; s < m_vNumberData[data].BndSSGrp.size(); ++s){
 			const int si = m_vNumberData[data].BndSSGrp[s];
@@ -191,8 +293,9 @@ add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoor
 
 			for(size_t i = 0; i < vBF.size(); ++i, ++ip){
 				const int co = vBF[i].node_id();
-				d(_C_, co) -= m_vNumberData[data].import[ip]
-				                                    * vBF[i].volume();
+				const number val = bEvalNumberData ? m_vEvalValue[ip]
+				                                   : m_vNumberData[data].import[ip];
+				d(_C_, co) -= val * vBF[i].volume();
 			}
 		}
 	}
@@ -239,7 +342,7 @@ void NeumannBoundaryFV1<TDomain>::
 fsh_elem_loop()
 {
 //	remove subsetIndex from Geometry
-	static TGeom& geo = GeomProvider<TGeom >::get();
+	TGeom& geo = this->template geo<TGeom>(geometry_traits<TElem>::REFERENCE_OBJECT_ID);
 
 
 //	unrequest subset indices as boundary subset. This will force the
@@ -510,7 +613,7 @@ lin_def(const LocalVector& u,
             const size_t nip)
 {
 //  get finite volume geometry
-	const static TFVGeom& geo = GeomProvider<TFVGeom>::get();
+	const TFVGeom& geo = This->template geo<TFVGeom>(geometry_traits<TElem>::REFERENCE_OBJECT_ID);
 	typedef typename TFVGeom::BF BF;
 
 	for(size_t s = 0; s < this->BndSSGrp.size(); ++s)
@@ -633,6 +736,12 @@ void NeumannBoundaryFV1<TDomain>::register_func()
 	this->set_add_def_A_elem_fct(	 id, &T::template add_def_A_elem<TElem, TFVGeom>);
 	this->set_add_def_M_elem_fct(	 id, &T::template add_def_M_elem<TElem, TFVGeom>);
 
+	// batched assembling
+	this->set_prep_elem_batch_fct(		id, &T::template prep_elem_batch<TElem, TFVGeom>);
+	this->set_add_jac_A_elem_batch_fct(	id, &T::template add_jac_A_elem_batch<TElem, TFVGeom>);
+	this->set_add_def_A_elem_batch_fct(	id, &T::template add_def_A_elem_batch<TElem, TFVGeom>);
+	this->set_add_rhs_elem_batch_fct(	id, &T::template add_rhs_elem_batch<TElem, TFVGeom>);
+
 	// error estimator parts
 	this->set_prep_err_est_elem_loop(id, &T::template prep_err_est_elem_loop<TElem, TFVGeom>);
 	this->set_prep_err_est_elem(id, &T::template prep_err_est_elem<TElem, TFVGeom>);
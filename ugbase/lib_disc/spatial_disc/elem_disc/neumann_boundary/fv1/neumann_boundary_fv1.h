@@ -70,6 +70,17 @@ class NeumannBoundaryFV1
 		void add(SmartPtr<CplUserData<MathVector<dim>, dim> > user, 	const char* BndSubsets, const char* InnerSubsets);
 	/// \}
 
+	///	\copydoc IElemDisc::clone_for_thread
+	/**
+	 * A copy is possible, if only constant unconditional data is used. The
+	 * copy gets own constant data with the same values and own finite volume
+	 * geometries.
+	 */
+		virtual SmartPtr<IElemDisc<TDomain> > clone_for_thread() const;
+
+	///	\copydoc IElemDisc::clone_for_thread_supported
+		virtual bool clone_for_thread_supported() const;
+
 	protected:
 		using typename base_type::Data;
 
@@ -77,8 +88,9 @@ class NeumannBoundaryFV1
 		struct NumberData : public base_type::Data
 		{
 			NumberData(SmartPtr<CplUserData<number, dim> > data,
-			           std::string BndSubsets, std::string InnerSubsets)
-				: base_type::Data(BndSubsets, InnerSubsets)
+			           std::string BndSubsets, std::string InnerSubsets,
+			           NeumannBoundaryFV1* This_)
+				: base_type::Data(BndSubsets, InnerSubsets), This(This_)
 			{
 				import.set_data(data);
 			}
@@ -106,6 +118,7 @@ class NeumannBoundaryFV1
 			std::vector<MathVector<2> > vLocIP_dim2;	// might have Neumann bnd for lower-dim elements!
 			std::vector<MathVector<1> > vLocIP_dim1;
 			std::vector<MathVector<dim> > vGloIP;
+			NeumannBoundaryFV1* This;
 		};
 
 	///	Conditional scalar user data
@@ -138,6 +151,20 @@ class NeumannBoundaryFV1
 	///	current inner subset
 		int m_si;
 
+	///	returns the finite volume geometry used for an element type
+	/**
+	 * The shared geometry of the GeomProvider is used, unless the disc is a
+	 * copy for a concurrent thread, that uses own geometries.
+	 */
+		template <typename TFVGeom>
+		TFVGeom& geo(ReferenceObjectID roid);
+
+	///	flag if own geometries are used (copies for threads)
+		bool m_bOwnGeom;
+
+	///	own geometries (indexed by reference object id)
+		SmartPtr<void> m_vspOwnGeom[NUM_REFERENCE_OBJECTS];
+
 	public:
 	///	type of trial space for each function used
 		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid);
@@ -173,6 +200,32 @@ class NeumannBoundaryFV1
 
 	/// \}
 
+	///	batched assembling functions for fv1
+	/**
+	 * The geometry is updated element by element in add_rhs_elem_batch. The
+	 * unconditional number data is evaluated at the global integration
+	 * points there, since the DataEvaluator does not compute import data
+	 * for batches.
+	 * \{
+	 */
+		template<typename TElem, typename TFVGeom>
+		void prep_elem_batch(const ElemBatch<dim>& batch) {}
+		template<typename TElem, typename TFVGeom>
+		void add_rhs_elem_batch(LocalVector* vRhs[], const ElemBatch<dim>& batch);
+	/// \}
+
+	///	adds the rhs for the current geometry
+	/**
+	 * \param[in]	bEvalNumberData	evaluate the number data at the integration
+	 * 								points instead of reading the imports
+	 */
+		template<typename TFVGeom>
+		void add_rhs(LocalVector& d, const TFVGeom& geo, bool bEvalNumberData);
+
+	///	integration points and values for the evaluation of number data
+		std::vector<MathVector<dim> > m_vEvalGloIP;
+		std::vector<number> m_vEvalValue;
+
 		static const int _C_ = 0;
 
 	private:
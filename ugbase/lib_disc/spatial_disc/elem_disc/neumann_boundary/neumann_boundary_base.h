@@ -114,6 +114,10 @@ class NeumannBoundaryBase
 		void add_def_A_elem(LocalVector& d, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]) {}
 		template<typename TElem, typename TFVGeom>
 		void add_def_M_elem(LocalVector& d, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]) {}
+		template<typename TElem, typename TFVGeom>
+		void add_jac_A_elem_batch(LocalMatrix* vJ[], const ElemBatch<dim>& batch) {}
+		template<typename TElem, typename TFVGeom>
+		void add_def_A_elem_batch(LocalVector* vD[], const ElemBatch<dim>& batch) {}
 	/// \}
 };
 
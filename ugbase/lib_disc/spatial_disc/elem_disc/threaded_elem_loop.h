@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__THREADED_ELEM_LOOP__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__THREADED_ELEM_LOOP__
+
+// extern includes
+#include <vector>
+#include <string>
+#include <algorithm>
+#ifdef UG_OPENMP
+#include <omp.h>
+#endif
+
+// other ug4 modules
+#include "common/common.h"
+
+// intern headers
+#include "./elem_disc_interface.h"
+#include "lib_disc/common/local_algebra.h"
+#include "lib_disc/spatial_disc/ass_tuner.h"
+#include "lib_disc/spatial_disc/user_data/data_evaluator.h"
+
+namespace ug {
+
+/// colors elements such that no two elements of one color share an algebra index
+/**
+ * The elements are colored greedily in the passed order: in every sweep, an
+ * element gets the current color, if none of its indices is already used
+ * by an element of that color. Within a color, the elements keep their
+ * relative order.
+ *
+ * \param[out]	vvColorElem		elements for each color
+ * \param[in]	vElem			elements to color
+ * \param[in]	dd				DoF Distribution
+ * \param[in]	bUseHanging		flag if hanging indices are used
+ */
+template <typename TElem>
+void ColorElementsByIndices(std::vector<std::vector<TElem*> >& vvColorElem,
+                            const std::vector<TElem*>& vElem,
+                            ConstSmartPtr<DoFDistribution> dd,
+                            bool bUseHanging)
+{
+	PROFILE_FUNC_GROUP("discretization");
+	vvColorElem.clear();
+
+//	compute the algebra indices of all elements once (CRS-like storage)
+	std::vector<size_t> vOffset(vElem.size() + 1, 0);
+	std::vector<size_t> vIndex;
+	LocalIndices ind;
+	for(size_t e = 0; e < vElem.size(); ++e)
+	{
+		dd->indices(vElem[e], ind, bUseHanging);
+		for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+			for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+				vIndex.push_back(ind.index(fct, dof));
+		vOffset[e+1] = vIndex.size();
+	}
+
+//	mark of the last color that used an index
+	std::vector<int> vMark(dd->num_indices(), -1);
+
+//	sweep the uncolored elements until all are colored
+	std::vector<size_t> vRemaining(vElem.size()), vNextRemaining;
+	for(size_t e = 0; e < vElem.size(); ++e) vRemaining[e] = e;
+
+	for(int color = 0; !vRemaining.empty(); ++color)
+	{
+		vvColorElem.push_back(std::vector<TElem*>());
+		std::vector<TElem*>& vColorElem = vvColorElem.back();
+		vNextRemaining.clear();
+
+		for(size_t r = 0; r < vRemaining.size(); ++r)
+		{
+			const size_t e = vRemaining[r];
+
+			bool bConflict = false;
+			for(size_t k = vOffset[e]; k < vOffset[e+1]; ++k)
+				if(vMark[vIndex[k]] == color) {bConflict = true; break;}
+
+			if(bConflict) {vNextRemaining.push_back(e); continue;}
+
+			for(size_t k = vOffset[e]; k < vOffset[e+1]; ++k)
+				vMark[vIndex[k]] = color;
+			vColorElem.push_back(vElem[e]);
+		}
+
+		vRemaining.swap(vNextRemaining);
+	}
+}
+
+/// returns if the threaded element loop can be used for the passed discs
+/**
+ * The threaded element loop is used if ug4 is compiled with OpenMP, more
+ * than one thread is requested by the assembling tuner and all element
+ * discretizations are able to provide copies for concurrent threads.
+ */
+template <typename TDomain, typename TAlgebra>
+bool ThreadedElemLoopPossible(const std::vector<IElemDisc<TDomain>*>& vElemDisc,
+                              const AssemblingTuner<TAlgebra>& assTuner)
+{
+#ifdef UG_OPENMP
+	if(assTuner.num_threads() <= 1) return false;
+	if(assTuner.single_index_assembling_enabled()) return false;
+	if(assTuner.mapping_set()) return false;
+
+	for(size_t i = 0; i < vElemDisc.size(); ++i)
+		if(!vElemDisc[i]->clone_for_thread_supported())
+			return false;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+///	collects the elements of an iterator range that are used for assembling
+template <typename TElem, typename TIterator, typename TAlgebra>
+void CollectAssembledElements(std::vector<TElem*>& vElem,
+                              TIterator iterBegin, TIterator iterEnd,
+                              const AssemblingTuner<TAlgebra>& assTuner)
+{
+	vElem.clear();
+	for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
+	{
+		TElem* elem = *iter;
+		if(assTuner.element_used(elem))
+			vElem.push_back(elem);
+	}
+}
+
+///	local jacobian of an element (stationary and instationary)
+template <typename TDomain, typename TAlgebra>
+class ThreadedJacobianOp
+{
+	public:
+		typedef typename TAlgebra::vector_type vector_type;
+		typedef typename TAlgebra::matrix_type global_type;
+		typedef LocalMatrix local_type;
+		static const int dim = TDomain::dim;
+
+	///	stationary jacobian (or stiffness matrix, if bStiffOnly is set)
+		ThreadedJacobianOp(const vector_type& u, bool bStiffOnly)
+			: m_pU(&u), m_s_a0(1.0), m_bInstationary(false), m_bStiffOnly(bStiffOnly) {}
+
+	///	instationary jacobian
+		ThreadedJacobianOp(ConstSmartPtr<VectorTimeSeries<vector_type> > vSol, number s_a0)
+			: m_pU(vSol->solution(0).get()), m_vSol(vSol), m_s_a0(s_a0),
+			  m_bInstationary(true), m_bStiffOnly(false) {}
+
+		SmartPtr<DataEvaluator<TDomain> >
+		create_evaluator(const std::vector<IElemDisc<TDomain>*>& vElemDisc,
+		                 ConstSmartPtr<DoFDistribution> dd, bool bNonRegularGrid,
+		                 LocalVectorTimeSeries& locTimeSeries) const
+		{
+			if(!m_bInstationary)
+				return make_sp(new DataEvaluator<TDomain>(m_bStiffOnly ? STIFF : (STIFF | RHS),
+				                vElemDisc, dd->function_pattern(), bNonRegularGrid));
+
+			locTimeSeries.read_times(m_vSol);
+			SmartPtr<DataEvaluator<TDomain> > spEval = make_sp(new DataEvaluator<TDomain>
+						(MASS | STIFF | RHS, vElemDisc, dd->function_pattern(),
+						 bNonRegularGrid, &locTimeSeries));
+			spEval->set_time_point(0);
+			return spEval;
+		}
+
+		void assemble(DataEvaluator<TDomain>& Eval, LocalVectorTimeSeries& locTimeSeries,
+		              GridObject* elem, ReferenceObjectID id, const MathVector<dim> vCornerCoords[],
+		              LocalIndices& ind, LocalVector& locU, LocalVector& tmpLocD,
+		              LocalMatrix& locJ) const
+		{
+			locU.resize(ind); locJ.resize(ind);
+			GetLocalVector(locU, *m_pU);
+
+			if(m_bInstationary && Eval.time_series_needed())
+				locTimeSeries.read_values(m_vSol, ind);
+
+			Eval.prepare_elem(locU, elem, id, vCornerCoords, ind, true);
+
+			locJ = 0.0;
+			if(!m_bInstationary)
+			{
+				Eval.add_jac_A_elem(locJ, locU, elem, vCornerCoords);
+				return;
+			}
+
+			Eval.add_jac_A_elem(locJ, locU, elem, vCornerCoords, PT_INSTATIONARY);
+			locJ *= m_s_a0;
+			Eval.add_jac_A_elem(locJ, locU, elem, vCornerCoords, PT_STATIONARY);
+			Eval.add_jac_M_elem(locJ, locU, elem, vCornerCoords, PT_INSTATIONARY);
+		}
+
+	///	inserts the connections of an element, such that no reallocation happens later
+		void prepare_concurrent_add(global_type& J, const LocalIndices& ind,
+		                            LocalMatrix& locJ) const
+		{
+			locJ.resize(ind); locJ = 0.0;
+			AddLocalMatrixToGlobal(J, locJ);
+		}
+
+		void add(global_type& J, const LocalMatrix& locJ, ConstSmartPtr<DoFDistribution> dd,
+		         const AssemblingTuner<TAlgebra>& assTuner) const
+		{
+			assTuner.add_local_mat_to_global(J, locJ, dd);
+		}
+
+	protected:
+		const vector_type* m_pU;
+		ConstSmartPtr<VectorTimeSeries<vector_type> > m_vSol;
+		number m_s_a0;
+		bool m_bInstationary;
+		bool m_bStiffOnly;
+};
+
+///	local defect of an element (stationary and instationary)
+template <typename TDomain, typename TAlgebra>
+class ThreadedDefectOp
+{
+	public:
+		typedef typename TAlgebra::vector_type vector_type;
+		typedef vector_type global_type;
+		typedef LocalVector local_type;
+		static const int dim = TDomain::dim;
+
+	///	stationary defect
+		ThreadedDefectOp(const vector_type& u)
+			: m_pU(&u), m_pvScaleMass(NULL), m_pvScaleStiff(NULL), m_bInstationary(false) {}
+
+	///	instationary defect
+		ThreadedDefectOp(ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
+		                 const std::vector<number>& vScaleMass,
+		                 const std::vector<number>& vScaleStiff)
+			: m_pU(vSol->solution(0).get()), m_vSol(vSol),
+			  m_pvScaleMass(&vScaleMass), m_pvScaleStiff(&vScaleStiff),
+			  m_bInstationary(true) {}
+
+		SmartPtr<DataEvaluator<TDomain> >
+		create_evaluator(const std::vector<IElemDisc<TDomain>*>& vElemDisc,
+		                 ConstSmartPtr<DoFDistribution> dd, bool bNonRegularGrid,
+		                 LocalVectorTimeSeries& locTimeSeries) const
+		{
+			if(!m_bInstationary)
+				return make_sp(new DataEvaluator<TDomain>(STIFF | RHS,
+				                vElemDisc, dd->function_pattern(), bNonRegularGrid));
+
+			locTimeSeries.read_times(m_vSol);
+			return make_sp(new DataEvaluator<TDomain>(MASS | STIFF | RHS | EXPL,
+						vElemDisc, dd->function_pattern(), bNonRegularGrid,
+						&locTimeSeries, m_pvScaleMass, m_pvScaleStiff));
+		}
+
+		void assemble(DataEvaluator<TDomain>& Eval, LocalVectorTimeSeries& locTimeSeries,
+		              GridObject* elem, ReferenceObjectID id, const MathVector<dim> vCornerCoords[],
+		              LocalIndices& ind, LocalVector& locU, LocalVector& tmpLocD,
+		              LocalVector& locD) const
+		{
+			locD.resize(ind); tmpLocD.resize(ind);
+			locD = 0.0;
+
+			if(!m_bInstationary)
+			{
+				locU.resize(ind);
+				GetLocalVector(locU, *m_pU);
+
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, ind);
+				Eval.add_def_A_elem(locD, locU, elem, vCornerCoords);
+
+				tmpLocD = 0.0;
+				Eval.add_rhs_elem(tmpLocD, elem, vCornerCoords);
+				locD.scale_append(-1, tmpLocD);
+				return;
+			}
+
+			const std::vector<number>& vScaleMass = *m_pvScaleMass;
+			const std::vector<number>& vScaleStiff = *m_pvScaleStiff;
+
+			locTimeSeries.read_values(m_vSol, ind);
+
+			for(size_t t = 0; t < vScaleStiff.size(); ++t)
+			{
+				const number scale_stiff = vScaleStiff[t];
+
+				LocalVector& locUt = locTimeSeries.solution(t);
+				Eval.set_time_point(t);
+				Eval.prepare_elem(locUt, elem, id, vCornerCoords, ind, false);
+
+				tmpLocD = 0.0;
+				Eval.add_def_M_elem(tmpLocD, locUt, elem, vCornerCoords, PT_INSTATIONARY);
+				locD.scale_append(vScaleMass[t], tmpLocD);
+
+				if(scale_stiff != 0.0)
+				{
+					tmpLocD = 0.0;
+					Eval.add_def_A_elem(tmpLocD, locUt, elem, vCornerCoords, PT_INSTATIONARY);
+					locD.scale_append(scale_stiff, tmpLocD);
+				}
+
+				if(t == 0)
+					Eval.add_def_A_elem(locD, locUt, elem, vCornerCoords, PT_STATIONARY);
+
+				if(t == 1)
+				{
+					tmpLocD = 0.0;
+					Eval.add_def_A_expl_elem(tmpLocD, locUt, elem, vCornerCoords, PT_INSTATIONARY);
+					const number dt = m_vSol->time(0) - m_vSol->time(1);
+					locD.scale_append(dt, tmpLocD);
+				}
+
+				if(scale_stiff != 0.0)
+				{
+					tmpLocD = 0.0;
+					Eval.add_rhs_elem(tmpLocD, elem, vCornerCoords, PT_INSTATIONARY);
+					locD.scale_append( - scale_stiff, tmpLocD);
+				}
+
+				if(t == 0)
+				{
+					tmpLocD = 0.0;
+					Eval.add_rhs_elem(tmpLocD, elem, vCornerCoords, PT_STATIONARY);
+					locD.scale_append( -1.0, tmpLocD);
+				}
+			}
+		}
+
+	///	vectors do not change their structure during the assembling
+		void prepare_concurrent_add(global_type& d, const LocalIndices& ind,
+		                            LocalVector& locD) const {}
+
+		void add(global_type& d, const LocalVector& locD, ConstSmartPtr<DoFDistribution> dd,
+		         const AssemblingTuner<TAlgebra>& assTuner) const
+		{
+			assTuner.add_local_vec_to_global(d, locD, dd);
+		}
+
+	protected:
+		const vector_type* m_pU;
+		ConstSmartPtr<VectorTimeSeries<vector_type> > m_vSol;
+		const std::vector<number>* m_pvScaleMass;
+		const std::vector<number>* m_pvScaleStiff;
+		bool m_bInstationary;
+};
+
+/// thread-parallel element loop
+/**
+ * This function computes the local contributions of the passed elements
+ * concurrently and adds them to the global matrix or vector. Every thread
+ * uses its own copies of the element discretizations (thread 0 uses the
+ * passed ones), its own DataEvaluator and its own local algebra.
+ *
+ * In the deterministic mode, the elements are processed in batches: the
+ * local contributions of a batch are computed in parallel and added to the
+ * global object in the serial element order afterwards. Hence, the result is
+ * bitwise identical to the serial loop.
+ * Otherwise, the elements are colored (see ColorElementsByIndices) and all
+ * elements of one color are assembled and added concurrently. For matrices,
+ * the sparsity pattern is inserted beforehand, so that the concurrent adding
+ * never changes the matrix structure.
+ *
+ * \param[in]		vElemDisc		element discretizations
+ * \param[in]		spDomain		domain
+ * \param[in]		dd				DoF Distribution
+ * \param[in]		vElem			elements to assemble (already filtered by the tuner)
+ * \param[in]		si				subset index
+ * \param[in]		bNonRegularGrid flag to indicate if non regular grid is used
+ * \param[in,out]	global			global matrix or vector
+ * \param[in]		op				local assembling operation
+ * \param[in]		assTuner		assemble adapter
+ */
+template <typename TElem, typename TDomain, typename TAlgebra, typename TLocalOp>
+void ThreadedElemLoop(const std::vector<IElemDisc<TDomain>*>& vElemDisc,
+                      ConstSmartPtr<TDomain> spDomain,
+                      ConstSmartPtr<DoFDistribution> dd,
+                      const std::vector<TElem*>& vElem,
+                      int si, bool bNonRegularGrid,
+                      typename TLocalOp::global_type& global,
+                      const TLocalOp& op,
+                      const AssemblingTuner<TAlgebra>& assTuner)
+{
+#ifdef UG_OPENMP
+	PROFILE_FUNC_GROUP("discretization");
+	typedef typename TLocalOp::local_type local_type;
+	static const int dim = TDomain::dim;
+	static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+	if(vElem.empty()) return;
+	const int numThreads = assTuner.num_threads();
+
+//	one set of element discretizations per thread
+	std::vector<std::vector<SmartPtr<IElemDisc<TDomain> > > > vvspClone(numThreads);
+	std::vector<std::vector<IElemDisc<TDomain>*> > vvElemDisc(numThreads, vElemDisc);
+	for(int t = 1; t < numThreads; ++t)
+		for(size_t i = 0; i < vElemDisc.size(); ++i)
+		{
+			vvspClone[t].push_back(vElemDisc[i]->clone_for_thread());
+			UG_COND_THROW(!vvspClone[t].back().valid(), "ThreadedElemLoop: "
+							"Element disc "<<i<<" cannot be copied for thread "<<t);
+			vvElemDisc[t][i] = vvspClone[t].back().get();
+		}
+
+//	one data evaluator and one set of local algebra per thread
+	std::vector<LocalVectorTimeSeries> vLocTimeSeries(numThreads);
+	std::vector<SmartPtr<DataEvaluator<TDomain> > > vspEval(numThreads);
+	std::vector<LocalIndices> vInd(numThreads);
+	std::vector<LocalVector> vLocU(numThreads), vTmpLocD(numThreads);
+	std::vector<local_type> vLoc(numThreads);
+	for(int t = 0; t < numThreads; ++t)
+	{
+		vspEval[t] = op.create_evaluator(vvElemDisc[t], dd, bNonRegularGrid, vLocTimeSeries[t]);
+		vspEval[t]->prepare_elem_loop(id, si);
+	}
+	const bool bUseHanging = vspEval[0]->use_hanging();
+
+//	errors thrown inside the parallel region are rethrown afterwards
+	bool bError = false;
+	std::string errMsg;
+
+	if(assTuner.deterministic_assembling() || assTuner.mapping_set())
+	{
+	//	buffers for the local contributions of one batch
+		const size_t batchSize = 64 * numThreads;
+		std::vector<LocalIndices> vBatchInd(batchSize);
+		std::vector<local_type> vBatchLoc(batchSize);
+
+		for(size_t start = 0; start < vElem.size(); start += batchSize)
+		{
+			const int num = (int) std::min(batchSize, vElem.size() - start);
+
+			#pragma omp parallel for num_threads(numThreads) schedule(static)
+			for(int i = 0; i < num; ++i)
+			{
+				const int t = omp_get_thread_num();
+				TElem* elem = vElem[start + i];
+				MathVector<dim> vCornerCoords[TElem::NUM_VERTICES];
+				try{
+					FillCornerCoordinates(vCornerCoords, *elem, *spDomain);
+					dd->indices(elem, vBatchInd[i], bUseHanging);
+					op.assemble(*vspEval[t], vLocTimeSeries[t], elem, id, vCornerCoords,
+					            vBatchInd[i], vLocU[t], vTmpLocD[t], vBatchLoc[i]);
+				}
+				catch(UGError& err){
+					#pragma omp critical (ThreadedElemLoopError)
+					{bError = true; errMsg = err.get_stacktrace();}
+				}
+				catch(std::exception& err){
+					#pragma omp critical (ThreadedElemLoopError)
+					{bError = true; errMsg = err.what();}
+				}
+			}
+			UG_COND_THROW(bError, "ThreadedElemLoop: Cannot assemble element: "<<errMsg);
+
+		//	add in serial element order
+			for(int i = 0; i < num; ++i)
+				op.add(global, vBatchLoc[i], dd, assTuner);
+		}
+	}
+	else
+	{
+	//	color the elements, such that no two elements of a color share an index
+		std::vector<std::vector<TElem*> > vvColorElem;
+		ColorElementsByIndices(vvColorElem, vElem, dd, bUseHanging);
+
+	//	create the structure, that is written concurrently
+		for(size_t e = 0; e < vElem.size(); ++e)
+		{
+			dd->indices(vElem[e], vInd[0], bUseHanging);
+			op.prepare_concurrent_add(global, vInd[0], vLoc[0]);
+		}
+
+		for(size_t c = 0; c < vvColorElem.size(); ++c)
+		{
+			const std::vector<TElem*>& vColorElem = vvColorElem[c];
+			const int num = (int) vColorElem.size();
+
+			#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 16)
+			for(int i = 0; i < num; ++i)
+			{
+				const int t = omp_get_thread_num();
+				TElem* elem = vColorElem[i];
+				MathVector<dim> vCornerCoords[TElem::NUM_VERTICES];
+				try{
+					FillCornerCoordinates(vCornerCoords, *elem, *spDomain);
+					dd->indices(elem, vInd[t], bUseHanging);
+					op.assemble(*vspEval[t], vLocTimeSeries[t], elem, id, vCornerCoords,
+					            vInd[t], vLocU[t], vTmpLocD[t], vLoc[t]);
+					op.add(global, vLoc[t], dd, assTuner);
+				}
+				catch(UGError& err){
+					#pragma omp critical (ThreadedElemLoopError)
+					{bError = true; errMsg = err.get_stacktrace();}
+				}
+				catch(std::exception& err){
+					#pragma omp critical (ThreadedElemLoopError)
+					{bError = true; errMsg = err.what();}
+				}
+			}
+			UG_COND_THROW(bError, "ThreadedElemLoop: Cannot assemble element: "<<errMsg);
+		}
+	}
+
+//	finish element loop
+	for(int t = 0; t < numThreads; ++t)
+		vspEval[t]->finish_elem_loop();
+#else
+	UG_THROW("ThreadedElemLoop: ug4 must be compiled with OpenMP (cmake -DOPENMP=ON).");
+#endif
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__THREADED_ELEM_LOOP__ */
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__MATRIX_FREE_MAPPER__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__MATRIX_FREE_MAPPER__
+
+// intern headers
+#include "lib_disc/common/local_algebra.h"
+#include "local_to_global_mapper.h"
+
+namespace ug{
+
+/// mapper applying local matrices to a vector instead of storing them
+/**
+ * When this mapper is used for the assembling of a matrix, the local matrices
+ * are not added to the global matrix, but each local matrix is multiplied by
+ * the local values of a vector x and the result is added to a vector y, i.e.
+ * y += A_loc * x_loc. Thus, after the element loop y contains A*x, while the
+ * matrix is not touched. Local vectors (e.g. a right-hand side assembled at
+ * the same time) are discarded.
+ *
+ * \tparam	TAlgebra			type of Algebra
+ */
+template <typename TAlgebra>
+class LocalMatVecMapper : public ILocalToGlobalMapper<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Type of algebra matrix
+		typedef typename algebra_type::matrix_type matrix_type;
+
+	///	Type of algebra vector
+		typedef typename algebra_type::vector_type vector_type;
+
+	public:
+	///	constructor
+		LocalMatVecMapper(const vector_type& x, vector_type& y) : m_pX(&x), m_pY(&y) {}
+
+	///	discards local vectors
+		virtual void add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
+		                                     ConstSmartPtr<DoFDistribution> dd) {}
+
+	///	adds A_loc * x_loc to y
+		virtual void add_local_mat_to_global(matrix_type& mat, const LocalMatrix& lmat,
+		                                     ConstSmartPtr<DoFDistribution> dd)
+		{
+			const vector_type& x = *m_pX;
+			vector_type& y = *m_pY;
+			const LocalIndices& rowInd = lmat.get_row_indices();
+			const LocalIndices& colInd = lmat.get_col_indices();
+
+			for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+				for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+				{
+					number sum = 0.0;
+					for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+						for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+							sum += lmat.value(fct1,dof1,fct2,dof2)
+									* BlockRef(x[colInd.index(fct2,dof2)], colInd.comp(fct2,dof2));
+
+					BlockRef(y[rowInd.index(fct1,dof1)], rowInd.comp(fct1,dof1)) += sum;
+				}
+		}
+
+	///	solution is not modified
+		virtual void modify_LocalSol(LocalVector& vecMod, const LocalVector& lvec,
+		                             ConstSmartPtr<DoFDistribution> dd) {}
+
+	protected:
+		const vector_type* m_pX;
+		vector_type* m_pY;
+};
+
+/// mapper adding only the diagonal (blocks) of local matrices to the global matrix
+/**
+ * When this mapper is used for the assembling of a matrix, only the entries
+ * of the local matrices coupling an algebra index with itself are added. Thus,
+ * the global matrix contains only the diagonal (blocks) of the assembled
+ * operator and needs no further memory. Local vectors are discarded.
+ *
+ * \tparam	TAlgebra			type of Algebra
+ */
+template <typename TAlgebra>
+class LocalDiagonalMapper : public ILocalToGlobalMapper<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Type of algebra matrix
+		typedef typename algebra_type::matrix_type matrix_type;
+
+	///	Type of algebra vector
+		typedef typename algebra_type::vector_type vector_type;
+
+	public:
+	///	discards local vectors
+		virtual void add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
+		                                     ConstSmartPtr<DoFDistribution> dd) {}
+
+	///	adds the diagonal (blocks) of the local matrix to the global matrix
+		virtual void add_local_mat_to_global(matrix_type& mat, const LocalMatrix& lmat,
+		                                     ConstSmartPtr<DoFDistribution> dd)
+		{
+			const LocalIndices& rowInd = lmat.get_row_indices();
+			const LocalIndices& colInd = lmat.get_col_indices();
+
+			for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+				for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+				{
+					const size_t rowIndex = rowInd.index(fct1,dof1);
+					const size_t rowComp = rowInd.comp(fct1,dof1);
+
+					for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+						for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+						{
+							if(colInd.index(fct2,dof2) != rowIndex) continue;
+
+							BlockRef(mat(rowIndex, rowIndex), rowComp, colInd.comp(fct2,dof2))
+										+= lmat.value(fct1,dof1,fct2,dof2);
+						}
+				}
+		}
+
+	///	solution is not modified
+		virtual void modify_LocalSol(LocalVector& vecMod, const LocalVector& lvec,
+		                             ConstSmartPtr<DoFDistribution> dd) {}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__MATRIX_FREE_MAPPER__ */
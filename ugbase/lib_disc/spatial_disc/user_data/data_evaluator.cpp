@@ -216,6 +216,85 @@ prepare_elem(LocalVector& u, GridObject* elem, const ReferenceObjectID roid, con
 	UG_CATCH_THROW("DataEvaluatorBase::prep_elem: Cannot compute data for Export or Linker.");
 }
 
+template <typename TDomain>
+bool DataEvaluator<TDomain>::
+batch_assembling_possible(const ReferenceObjectID roid, bool bJacobian) const
+{
+	if(time_series_needed()) return false;
+	if(!m_vDependentData.empty()) return false;
+
+//	only imports with zero derivative are allowed (those are not listed in
+//	m_vImport), their data is evaluated at global positions by the batched
+//	functions
+	for(int type = 0; type < MAX_PROCESS; ++type)
+		for(int part = 0; part < MAX_PART; ++part)
+			if(!m_vImport[type][part].empty()) return false;
+	for(size_t i = 0; i < m_vPosData.size(); ++i)
+		if(m_vPosData[i]->requires_grid_fct()) return false;
+
+	if(m_vElemDisc[PT_ALL].empty()) return false;
+	for(size_t i = 0; i < m_vElemDisc[PT_ALL].size(); ++i)
+	{
+		if(bJacobian){
+			if(!m_vElemDisc[PT_ALL][i]->batched_jac_A_supported(roid)) return false;
+		}
+		else{
+			if(!m_vElemDisc[PT_ALL][i]->batched_def_A_supported(roid)) return false;
+		}
+	}
+	return true;
+}
+
+template <typename TDomain>
+void DataEvaluator<TDomain>::
+prepare_elem_batch(ElemBatch<dim>& batch)
+{
+	try{
+		for(size_t i = 0; i < m_vElemDisc[PT_ALL].size(); ++i)
+			m_vElemDisc[PT_ALL][i]->do_prep_elem_batch(batch);
+	}
+	UG_CATCH_THROW("DataEvaluatorBase::prepare_elem_batch: Cannot prepare elements.");
+}
+
+template <typename TDomain>
+void DataEvaluator<TDomain>::
+add_jac_A_elem_batch(LocalMatrix* vJ[], ElemBatch<dim>& batch, ProcessType type)
+{
+	UG_ASSERT(m_discPart & STIFF, "Using add_jac_A_elem_batch, but not STIFF requested.");
+
+	try{
+		for(size_t i = 0; i < m_vElemDisc[type].size(); ++i)
+			m_vElemDisc[type][i]->do_add_jac_A_elem_batch(vJ, batch);
+	}
+	UG_CATCH_THROW("DataEvaluatorBase::add_jac_A_elem_batch: Cannot assemble Jacobian (A)");
+}
+
+template <typename TDomain>
+void DataEvaluator<TDomain>::
+add_def_A_elem_batch(LocalVector* vD[], ElemBatch<dim>& batch, ProcessType type)
+{
+	UG_ASSERT(m_discPart & STIFF, "Using add_def_A_elem_batch, but not STIFF requested.");
+
+	try{
+		for(size_t i = 0; i < m_vElemDisc[type].size(); ++i)
+			m_vElemDisc[type][i]->do_add_def_A_elem_batch(vD, batch);
+	}
+	UG_CATCH_THROW("DataEvaluatorBase::add_def_A_elem_batch: Cannot assemble Defect (A)");
+}
+
+template <typename TDomain>
+void DataEvaluator<TDomain>::
+add_rhs_elem_batch(LocalVector* vRhs[], ElemBatch<dim>& batch, ProcessType type)
+{
+	UG_ASSERT(m_discPart & RHS, "Using add_rhs_elem_batch, but not RHS requested.");
+
+	try{
+		for(size_t i = 0; i < m_vElemDisc[type].size(); ++i)
+			m_vElemDisc[type][i]->do_add_rhs_elem_batch(vRhs, batch);
+	}
+	UG_CATCH_THROW("DataEvaluatorBase::add_rhs_elem_batch: Cannot assemble rhs");
+}
+
 template <typename TDomain>
 void DataEvaluator<TDomain>::finish_timestep(const number time, VectorProxyBase* u, size_t algebra_id)
 {
@@ -227,6 +227,34 @@ public:
 		///	compute local rhs for all IElemDiscs
 			void add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[], ProcessType type = PT_ALL);
 
+	////////////////////////////////////////////
+	// Batched assembling
+	///////////////////////////////////////////
+
+		///	returns if the elements of type roid can be assembled in batches
+		/**
+		 * Batched assembling is only possible, if all IElemDiscs provide the
+		 * batched functions for the element type, no dependent user data has
+		 * to be evaluated per element and no local time series is needed.
+		 * Imports are allowed, if their data does not depend on the solution:
+		 * the batched functions evaluate the data of their imports themselves
+		 * at the global positions (see UserData::operator()), since the
+		 * evaluator does not compute import data for batches.
+		 */
+			bool batch_assembling_possible(const ReferenceObjectID roid, bool bJacobian) const;
+
+		///	prepares the elements of a batch for all IElemDiscs
+			void prepare_elem_batch(ElemBatch<dim>& batch);
+
+		///	compute local stiffness matrices of a batch for all IElemDiscs
+			void add_jac_A_elem_batch(LocalMatrix* vJ[], ElemBatch<dim>& batch, ProcessType type = PT_ALL);
+
+		///	compute local stiffness defects of a batch for all IElemDiscs
+			void add_def_A_elem_batch(LocalVector* vD[], ElemBatch<dim>& batch, ProcessType type = PT_ALL);
+
+		///	compute local rhs of a batch for all IElemDiscs
+			void add_rhs_elem_batch(LocalVector* vRhs[], ElemBatch<dim>& batch, ProcessType type = PT_ALL);
+
 			using base_type::time_series_needed;
 protected:
 
@@ -197,7 +197,7 @@ class DataImport : public IDataImport<dim>
 		SmartPtr<ICplUserData<dim> > data() {return m_spUserData.template cast_dynamic<ICplUserData<dim> >();}
 
 	/// returns the connected ICplUserData
-		SmartPtr<CplUserData<TData, dim> > user_data(){return m_spUserData;}
+		SmartPtr<CplUserData<TData, dim> > user_data() const {return m_spUserData;}
 
 	///	returns true if data given
 		virtual bool data_given() const {return m_spUserData.valid();}
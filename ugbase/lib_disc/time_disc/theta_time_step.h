@@ -36,6 +36,9 @@
 // extern libraries
 #include <deque>
 #include <cmath>
+#include <algorithm>
+#include <vector>
+#include <utility>
 
 // other ug libraries
 #include "lib_algebra/cpu_algebra_types.h"
@@ -75,7 +78,10 @@ class MultiStepTimeDiscretization
 	/// constructor
 		MultiStepTimeDiscretization(SmartPtr<IDomainDiscretization<algebra_type> > spDD)
 			: ITimeDiscretization<TAlgebra>(spDD),
-			  m_pPrevSol(NULL)
+			  m_pPrevSol(NULL),
+			  m_bCacheLinearOperator(false),
+			  m_bTimeDependentOperator(false),
+			  m_bCachedRhsValid(false)
 		{}
 
 		virtual ~MultiStepTimeDiscretization(){};
@@ -100,6 +106,54 @@ class MultiStepTimeDiscretization
 
 		virtual number future_time() const {return m_futureTime;}
 
+	public:
+	///	enables caching of the system matrix and the rhs for linear problems
+	/**
+	 * For linear problems the system matrix \f$ M + s_a A \f$ only depends
+	 * on the stiffness scaling of the scheme (i.e. on dt and theta, or the BDF
+	 * coefficients), while the rhs only changes once per time step (or stage).
+	 * If enabled, the system matrix is assembled once for each scaling and
+	 * reused as long as the scaling does not change. The rhs is assembled once
+	 * per time step (or stage), and the defect is then computed as
+	 * \f$ d = (M + s_a A) u - b \f$ by a single SpMV.
+	 * Scalings that agree up to a relative difference of 1e-12 (e.g. the
+	 * same dt recomputed from the time points) share one cached matrix.
+	 *
+	 * \note This must only be used for linear problems: the Jacobian and the
+	 * 		 defect are computed from the matrix of the first assembling and
+	 * 		 do not depend on the current iterate anymore.
+	 * \note The cache is discarded if the grid level or the number of
+	 * 		 unknowns changes. After other changes of the grid or the
+	 * 		 discretization, call invalidate_linear_operator_cache().
+	 */
+		void set_linear_operator_cache(bool bCache)
+		{
+			m_bCacheLinearOperator = bCache;
+			invalidate_linear_operator_cache();
+		}
+
+	///	returns if the system matrix and rhs are cached
+		bool linear_operator_cache() const {return m_bCacheLinearOperator;}
+
+	///	marks the stiffness/mass parts as time-dependent
+	/**
+	 * If the coefficients of the problem change in time, the cached system
+	 * matrix is reassembled in every time step (but still reused for all
+	 * iterations of the step).
+	 */
+		void set_time_dependent_operator(bool bTimeDep)
+		{
+			m_bTimeDependentOperator = bTimeDep;
+			invalidate_linear_operator_cache();
+		}
+
+	///	discards the cached system matrices and rhs
+		void invalidate_linear_operator_cache()
+		{
+			m_vCachedMatrix.clear();
+			m_bCachedRhsValid = false;
+		}
+
 	public:
 		void assemble_jacobian(matrix_type& J, const vector_type& u, const GridLevel& gl);
 
@@ -138,6 +192,18 @@ class MultiStepTimeDiscretization
 		                              number dt, number currentTime,
 		                              ConstSmartPtr<VectorTimeSeries<vector_type> > prevSol) = 0;
 
+	///	returns if the cached system matrix and rhs can be used
+		bool use_linear_operator_cache() const;
+
+	///	returns the cached system matrix for the current scaling, assembles it if needed
+		const matrix_type& cached_matrix(const vector_type& u, const GridLevel& gl);
+
+	///	returns the cached rhs for the current step (or stage), assembles it if needed
+		const vector_type& cached_rhs(const vector_type& u, const GridLevel& gl);
+
+	///	copies a matrix, keeping the sparsity pattern of dest if it matches
+		static void copy_matrix(matrix_type& dest, const matrix_type& src);
+
 		size_t m_prevSteps;					///< number of previous steps needed.
 		std::vector<number> m_vScaleMass;	///< Scaling for mass part
 		std::vector<number> m_vScaleStiff;	///< Scaling for stiffness part
@@ -145,6 +211,13 @@ class MultiStepTimeDiscretization
 		SmartPtr<VectorTimeSeries<vector_type> > m_pPrevSol;	///< Previous solutions
 		number m_dt; 								///< Time Step size
 		number m_futureTime;						///< Future Time
+
+		bool m_bCacheLinearOperator;	///< flag if system matrix and rhs are cached
+		bool m_bTimeDependentOperator;	///< flag if the system matrix changes in time
+		std::vector<std::pair<number, SmartPtr<matrix_type> > > m_vCachedMatrix; ///< cached system matrices and their stiffness scaling
+		GridLevel m_cacheGL;			///< grid level of the cached matrices and rhs
+		SmartPtr<vector_type> m_spCachedRhs;	///< cached rhs of current step (or stage)
+		bool m_bCachedRhsValid;			///< flag if the cached rhs is valid
 };
 
 /// theta time stepping scheme
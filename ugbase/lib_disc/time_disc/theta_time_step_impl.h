@@ -64,6 +64,10 @@ prepare_step(SmartPtr<VectorTimeSeries<vector_type> > prevSol,
 	                              m_dt, m_pPrevSol->time(0),
 	                              m_pPrevSol);
 
+//	the rhs changes with every step (or stage), the matrix only if time-dependent
+	m_bCachedRhsValid = false;
+	if(m_bTimeDependentOperator) m_vCachedMatrix.clear();
+
 //	prepare time step (elemDisc-wise)
 	try
 	{
@@ -95,6 +99,10 @@ prepare_step_elem(SmartPtr<VectorTimeSeries<vector_type> > prevSol,
 	                              m_dt, m_pPrevSol->time(0),
 	                              m_pPrevSol);
 
+//	the rhs changes with every step (or stage), the matrix only if time-dependent
+	m_bCachedRhsValid = false;
+	if(m_bTimeDependentOperator) m_vCachedMatrix.clear();
+
 //	prepare time step (elemDisc-wise)
 	try
 	{
@@ -119,6 +127,15 @@ assemble_jacobian(matrix_type& J, const vector_type& u, const GridLevel& gl)
 				" Number of previous solutions must be at least "<<
 				m_prevSteps <<", but only "<< m_pPrevSol->size() << " passed.");
 
+//	linear problems: copy the cached system matrix
+	if(use_linear_operator_cache())
+	{
+		try{
+			copy_matrix(J, cached_matrix(u, gl));
+		}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble jacobian.");
+		return;
+	}
+
 //	push unknown solution to solution time series
 //	ATTENTION: Here, we must cast away the constness of the solution, but note,
 //			   that we pass pPrevSol as a const object in assemble_... Thus,
@@ -149,6 +166,23 @@ assemble_defect(vector_type& d, const vector_type& u, const GridLevel& gl)
 				" Number of previous solutions must be at least "<<
 				m_prevSteps <<", but only "<< m_pPrevSol->size() << " passed.");
 
+//	linear problems: d = J*u - b with cached system matrix and rhs
+	if(use_linear_operator_cache())
+	{
+		try{
+			const matrix_type& J = cached_matrix(u, gl);
+			const vector_type& b = cached_rhs(u, gl);
+
+			if(d.size() != u.size()) d.resize(u.size());
+#ifdef UG_PARALLEL
+			d.set_layouts(u.layouts());
+#endif
+			J.apply(d, u);
+			d -= b;
+		}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble defect.");
+		return;
+	}
+
 //	push unknown solution to solution time series
 //	ATTENTION: Here, we must cast away the constness of the solution, but note,
 //			   that we pass pPrevSol as a const object in assemble_... Thus,
@@ -168,6 +202,152 @@ assemble_defect(vector_type& d, const vector_type& u, const GridLevel& gl)
 	m_pPrevSol->remove_latest();
 }
 
+template <typename TAlgebra>
+bool MultiStepTimeDiscretization<TAlgebra>::
+use_linear_operator_cache() const
+{
+//	the cache can not be used for partial assemblings
+	return m_bCacheLinearOperator
+			&& !this->m_spDomDisc->ass_tuner()->matrix_is_const()
+			&& !this->m_spDomDisc->ass_tuner()->selected_elements_used();
+}
+
+template <typename TAlgebra>
+const typename MultiStepTimeDiscretization<TAlgebra>::matrix_type&
+MultiStepTimeDiscretization<TAlgebra>::
+cached_matrix(const vector_type& u, const GridLevel& gl)
+{
+//	cache is only valid for one grid level
+	if(gl != m_cacheGL){
+		invalidate_linear_operator_cache();
+		m_cacheGL = gl;
+	}
+
+//	look for the matrix of the current scaling. The scaling is recomputed
+//	from dt (and the previous time points) in every step, so it is compared
+//	with a relative tolerance rather than bitwise
+	const number scaleStiff = m_vScaleStiff[0];
+	const number scaleTol = 1e-12;
+	for(size_t i = 0; i < m_vCachedMatrix.size(); ++i)
+	{
+		const number cachedScale = m_vCachedMatrix[i].first;
+		if(fabs(cachedScale - scaleStiff)
+				> scaleTol * std::max(fabs(cachedScale), fabs(scaleStiff)))
+			continue;
+
+		if(m_vCachedMatrix[i].second->num_rows() == u.size())
+			return *m_vCachedMatrix[i].second;
+
+	//	number of unknowns changed: all cached data is outdated
+		invalidate_linear_operator_cache();
+		break;
+	}
+
+//	the scaling changes (e.g. variable dt), keep at most one matrix per stage
+	if(m_vCachedMatrix.size() > this->num_stages())
+		m_vCachedMatrix.clear();
+
+	PROFILE_BEGIN_GROUP(MultiStepTimeDiscretization_cached_matrix, "discretization MultiStepTimeDiscretization");
+
+//	push unknown solution to solution time series
+//	ATTENTION: Here, we must cast away the constness of the solution, but note,
+//			   that we pass pPrevSol as a const object in assemble_... Thus,
+//			   the solution will not be changed there and we pop it from the
+//			   Solution list afterwards, such that nothing happens to u
+	// \todo: avoid this hack, use smart ptr properly
+	int DummyRefCount = 2;
+	SmartPtr<vector_type> pU(const_cast<vector_type*>(&u), &DummyRefCount);
+	m_pPrevSol->push(pU, m_futureTime);
+
+//	assemble system matrix M + s_a * A
+	SmartPtr<matrix_type> spJ = make_sp(new matrix_type);
+	try{
+		this->m_spDomDisc->assemble_jacobian(*spJ, m_pPrevSol, m_vScaleStiff[0], gl);
+	}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble cached system matrix.");
+
+//	pop unknown solution to solution time series
+	m_pPrevSol->remove_latest();
+
+	m_vCachedMatrix.push_back(std::make_pair(scaleStiff, spJ));
+	return *spJ;
+}
+
+template <typename TAlgebra>
+const typename MultiStepTimeDiscretization<TAlgebra>::vector_type&
+MultiStepTimeDiscretization<TAlgebra>::
+cached_rhs(const vector_type& u, const GridLevel& gl)
+{
+	if(gl != m_cacheGL){
+		invalidate_linear_operator_cache();
+		m_cacheGL = gl;
+	}
+
+	if(m_bCachedRhsValid && m_spCachedRhs->size() == u.size())
+		return *m_spCachedRhs;
+
+	PROFILE_BEGIN_GROUP(MultiStepTimeDiscretization_cached_rhs, "discretization MultiStepTimeDiscretization");
+
+//	push unknown solution to solution time series (not used, but formally needed)
+	m_pPrevSol->push(m_pPrevSol->latest(), m_futureTime);
+
+//	assemble rhs of the current step (or stage)
+	if(m_spCachedRhs.invalid()) m_spCachedRhs = make_sp(new vector_type);
+	try{
+		this->m_spDomDisc->assemble_rhs(*m_spCachedRhs, m_pPrevSol, m_vScaleMass, m_vScaleStiff, gl);
+	}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble cached rhs.");
+
+//	pop unknown solution from solution time series
+	m_pPrevSol->remove_latest();
+
+	m_bCachedRhsValid = true;
+	return *m_spCachedRhs;
+}
+
+template <typename TAlgebra>
+void MultiStepTimeDiscretization<TAlgebra>::
+copy_matrix(matrix_type& dest, const matrix_type& src)
+{
+//	check if the sparsity pattern of dest matches
+	bool bSamePattern = (dest.num_rows() == src.num_rows()
+						&& dest.num_cols() == src.num_cols()
+						&& dest.total_num_connections() == src.total_num_connections());
+	for(size_t i = 0; bSamePattern && i < src.num_rows(); ++i)
+	{
+		if(dest.num_connections(i) != src.num_connections(i))
+			{bSamePattern = false; break;}
+
+		typename matrix_type::const_row_iterator itSrc = src.begin_row(i);
+		typename matrix_type::const_row_iterator itEnd = src.end_row(i);
+		typename matrix_type::const_row_iterator itDest =
+				const_cast<const matrix_type&>(dest).begin_row(i);
+		for(; itSrc != itEnd; ++itSrc, ++itDest)
+			if(itSrc.index() != itDest.index())
+				{bSamePattern = false; break;}
+	}
+
+//	different pattern: full copy
+	if(!bSamePattern){
+		dest = src;
+		return;
+	}
+
+//	same pattern: copy values only, this keeps the structure stamp of dest
+//	such that e.g. symbolic factorizations of preconditioners can be reused
+	for(size_t i = 0; i < src.num_rows(); ++i)
+	{
+		typename matrix_type::const_row_iterator itSrc = src.begin_row(i);
+		typename matrix_type::const_row_iterator itEnd = src.end_row(i);
+		typename matrix_type::row_iterator itDest = dest.begin_row(i);
+		for(; itSrc != itEnd; ++itSrc, ++itDest)
+			itDest.value() = itSrc.value();
+	}
+
+#ifdef UG_PARALLEL
+	dest.set_storage_type(src.get_storage_mask());
+	dest.set_layouts(src.layouts());
+#endif
+}
+
 template <typename TAlgebra>
 void MultiStepTimeDiscretization<TAlgebra>::
 adjust_solution(vector_type& u, const GridLevel& gl)
@@ -190,6 +370,17 @@ assemble_linear(matrix_type& A, vector_type& b, const GridLevel& gl)
 				" Number of previous solutions must be at least "<<
 				m_prevSteps <<", but only "<< m_pPrevSol->size() << " passed.");
 
+//	use the cached system matrix and rhs
+	if(use_linear_operator_cache())
+	{
+		try{
+			const vector_type& u = *m_pPrevSol->latest();
+			copy_matrix(A, cached_matrix(u, gl));
+			b = cached_rhs(u, gl);
+		}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble jacobian.");
+		return;
+	}
+
 
 //	push unknown solution to solution time series (not used, but formally needed)
 	m_pPrevSol->push(m_pPrevSol->latest(), m_futureTime);
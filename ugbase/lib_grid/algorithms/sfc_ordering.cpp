@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "sfc_ordering.h"
+#include "common/assert.h"
+
+namespace ug{
+
+uint64 HilbertIndex(const uint32* coords, int dim, int numBits)
+{
+	UG_ASSERT(dim >= 1 && dim <= 3 && dim * numBits <= 64 && numBits <= 32,
+			  "HilbertIndex: invalid dimension or number of bits.");
+
+//	convert the coordinates to the transposed Hilbert index (J. Skilling,
+//	"Programming the Hilbert curve", AIP Conf. Proc. 707, 2004)
+	uint32 x[3];
+	for(int i = 0; i < dim; ++i)
+		x[i] = coords[i];
+
+	const uint32 m = uint32(1) << (numBits - 1);
+
+//	inverse undo
+	for(uint32 q = m; q > 1; q >>= 1){
+		const uint32 p = q - 1;
+		for(int i = 0; i < dim; ++i){
+			if(x[i] & q)
+				x[0] ^= p;
+			else{
+				const uint32 t = (x[0] ^ x[i]) & p;
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+
+//	gray encode
+	for(int i = 1; i < dim; ++i)
+		x[i] ^= x[i-1];
+	uint32 t = 0;
+	for(uint32 q = m; q > 1; q >>= 1)
+		if(x[dim-1] & q)
+			t ^= q - 1;
+	for(int i = 0; i < dim; ++i)
+		x[i] ^= t;
+
+//	interleave the bits of the transposed index
+	uint64 index = 0;
+	for(int b = numBits - 1; b >= 0; --b)
+		for(int i = 0; i < dim; ++i)
+			index = (index << 1) | ((x[i] >> b) & 1);
+
+	return index;
+}
+
+}//	end of namespace
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_GRID__SFC_ORDERING__
+#define __H__UG__LIB_GRID__SFC_ORDERING__
+
+#include "common/types.h"
+#include "lib_grid/grid/grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_algorithms
+///	@{
+
+///	returns the index of a point on the Hilbert curve through a 2^numBits grid
+/**	coords holds the dim integer coordinates of the point, each in
+ * [0, 2^numBits). dim * numBits may not exceed 64.*/
+UG_API
+uint64 HilbertIndex(const uint32* coords, int dim, int numBits);
+
+///	Sorts the elements of a grid along a Hilbert space filling curve.
+/**	The elements of each base type are sorted by the Hilbert index of their
+ * centers. The order is applied to the element lists of the grid (and, for
+ * a MultiGrid, to its level lists) and the attached data is rearranged in
+ * the new order (see Grid::sort_elements). Traversals through begin/end thus
+ * visit neighboring elements one after another and access the attached data
+ * consecutively.
+ *
+ * In the lists of the grid the elements are grouped by level (for a
+ * MultiGrid) and by subset (if a subset handler is specified) first.
+ * If a subset handler is specified, its subset lists are sorted, too.
+ * Other objects which store element lists, e.g. selectors, are not changed.
+ *
+ * The method is best called after the grid has been loaded, refined or
+ * redistributed and before indices are assigned to the elements (e.g. by an
+ * approximation space), since the order of the elements determines
+ * the order of the indices.
+ *
+ * \param grid	the grid whose elements are sorted
+ * \param aPos	the vertex position attachment (APosition1, APosition2 or APosition)
+ * \param psh	(optional) a GridSubsetHandler or MultiGridSubsetHandler of grid*/
+template <class TAPosition>
+void SortGridElementsBySFC(Grid& grid, TAPosition& aPos,
+						   ISubsetHandler* psh = NULL);
+
+/// @}
+
+}//	end of namespace
+
+////////////////////////////////
+//	include implementation
+#include "sfc_ordering_impl.hpp"
+
+#endif
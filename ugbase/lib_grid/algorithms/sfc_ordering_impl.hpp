@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_GRID__SFC_ORDERING_IMPL__
+#define __H__UG__LIB_GRID__SFC_ORDERING_IMPL__
+
+#include "common/error.h"
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/tools/subset_handler_grid.h"
+#include "lib_grid/tools/subset_handler_multi_grid.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+
+namespace ug{
+
+///	compares elements by level, subset and space filling curve index (in that order)
+template <class TBaseElem>
+class SFCIndexCompare
+{
+	public:
+		typedef Attachment<uint64>	AKey;
+
+		SFCIndexCompare(Grid::AttachmentAccessor<TBaseElem, AKey>& aaKey,
+						const MultiGrid* pmg, const ISubsetHandler* psh) :
+			m_aaKey(aaKey), m_pmg(pmg), m_psh(psh)	{}
+
+		bool operator()(TBaseElem* e1, TBaseElem* e2)
+		{
+			if(m_pmg){
+				const int l1 = m_pmg->get_level(e1);
+				const int l2 = m_pmg->get_level(e2);
+				if(l1 != l2) return l1 < l2;
+			}
+			if(m_psh){
+				const int si1 = m_psh->get_subset_index(e1);
+				const int si2 = m_psh->get_subset_index(e2);
+				if(si1 != si2) return si1 < si2;
+			}
+			return m_aaKey[e1] < m_aaKey[e2];
+		}
+
+	private:
+		Grid::AttachmentAccessor<TBaseElem, AKey>	m_aaKey;
+		const MultiGrid*		m_pmg;
+		const ISubsetHandler*	m_psh;
+};
+
+///	sorts the elements of the given base type along a Hilbert curve through the box [vMin, vMax]
+template <class TBaseElem, class TAPosition>
+void SortGridElementsBySFC(Grid& grid,
+						   Grid::VertexAttachmentAccessor<TAPosition>& aaPos,
+						   const typename TAPosition::ValueType& vMin,
+						   const typename TAPosition::ValueType& vMax,
+						   ISubsetHandler* psh)
+{
+	typedef typename TAPosition::ValueType vector_t;
+	typedef typename geometry_traits<TBaseElem>::iterator iterator;
+	typedef Attachment<uint64> AKey;
+	const int dim = vector_t::Size;
+	const int numBits = (dim == 3) ? 21 : 31;
+
+	if(grid.num<TBaseElem>() == 0)
+		return;
+
+//	the index of each element is computed from the center of the element,
+//	scaled to the integer grid of the Hilbert curve
+	vector_t vScale;
+	const number maxCoord = (number)((uint32(1) << numBits) - 1);
+	for(int d = 0; d < dim; ++d){
+		const number extent = vMax[d] - vMin[d];
+		vScale[d] = (extent > 0) ? maxCoord / extent : 0;
+	}
+
+	AKey aKey;
+	grid.attach_to<TBaseElem>(aKey);
+	Grid::AttachmentAccessor<TBaseElem, AKey> aaKey(grid, aKey);
+
+	uint32 coords[3];
+	for(iterator iter = grid.begin<TBaseElem>(); iter != grid.end<TBaseElem>(); ++iter)
+	{
+		TBaseElem* e = *iter;
+		const vector_t c = CalculateCenter(e, aaPos);
+		for(int d = 0; d < dim; ++d){
+			number x = (c[d] - vMin[d]) * vScale[d];
+			if(x < 0) x = 0;
+			if(x > maxCoord) x = maxCoord;
+			coords[d] = (uint32)x;
+		}
+		aaKey[e] = HilbertIndex(coords, dim, numBits);
+	}
+
+	MultiGrid* pmg = dynamic_cast<MultiGrid*>(&grid);
+	grid.sort_elements<TBaseElem>(SFCIndexCompare<TBaseElem>(aaKey, pmg, psh));
+
+	SFCIndexCompare<TBaseElem> keyCmp(aaKey, NULL, NULL);
+	if(pmg)
+		pmg->get_hierarchy_handler().sort_elements<TBaseElem>(keyCmp);
+
+	if(GridSubsetHandler* gsh = dynamic_cast<GridSubsetHandler*>(psh))
+		gsh->sort_elements<TBaseElem>(keyCmp);
+	else if(MultiGridSubsetHandler* mgsh = dynamic_cast<MultiGridSubsetHandler*>(psh))
+		mgsh->sort_elements<TBaseElem>(keyCmp);
+
+	grid.detach_from<TBaseElem>(aKey);
+}
+
+template <class TAPosition>
+void SortGridElementsBySFC(Grid& grid, TAPosition& aPos, ISubsetHandler* psh)
+{
+	typedef typename TAPosition::ValueType vector_t;
+
+	UG_COND_THROW(!grid.has_vertex_attachment(aPos),
+				  "SortGridElementsBySFC: The position attachment is not "
+				  "attached to the vertices of the grid.");
+	UG_COND_THROW(psh && (psh->grid() != &grid),
+				  "SortGridElementsBySFC: The subset handler has to operate "
+				  "on the given grid.");
+	UG_COND_THROW(psh && !dynamic_cast<GridSubsetHandler*>(psh)
+				  && !dynamic_cast<MultiGridSubsetHandler*>(psh),
+				  "SortGridElementsBySFC: Only GridSubsetHandler and "
+				  "MultiGridSubsetHandler are supported.");
+
+	if(grid.num_vertices() == 0)
+		return;
+
+	Grid::VertexAttachmentAccessor<TAPosition> aaPos(grid, aPos);
+
+	vector_t vMin, vMax;
+	CalculateBoundingBox(vMin, vMax, grid.vertices_begin(), grid.vertices_end(), aaPos);
+
+	SortGridElementsBySFC<Vertex, TAPosition>(grid, aaPos, vMin, vMax, psh);
+	SortGridElementsBySFC<Edge, TAPosition>(grid, aaPos, vMin, vMax, psh);
+	SortGridElementsBySFC<Face, TAPosition>(grid, aaPos, vMin, vMax, psh);
+	SortGridElementsBySFC<Volume, TAPosition>(grid, aaPos, vMin, vMax, psh);
+}
+
+}//	end of namespace
+
+#endif
@@ -33,11 +33,16 @@
 #ifndef __H__UG__lg_ntree__
 #define __H__UG__lg_ntree__
 
+#include <algorithm>
+#include <set>
+#include <vector>
 #include "common/space_partitioning/ntree.h"
 #include "common/space_partitioning/ntree_traverser.h"
 #include "common/math/misc/shapes.h"
 #include "lib_grid/algorithms/ray_element_intersection_util.h"
 #include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+#include "lib_grid/grid/grid_observer.h"
+#include "lib_grid/multi_grid.h"
 
 namespace ug{
 
@@ -333,23 +338,74 @@ struct ntree_traits<3, 3, elem_t, NTreeGridData<3> > :
 
 
 
+///	An ntree for grid elements which can keep itself up to date with its grid.
+/**	Besides the explicit construction through 'create_tree', the tree can
+ * observe its grid (see 'enable_auto_update'). Elements created in the grid
+ * are then collected and inserted on the next call to 'update', elements
+ * which are erased from the grid are removed from the tree immediately.
+ * This avoids a complete rebuild of the tree e.g. after each refinement.
+ *
+ * If 'surfaceOnly' is enabled and the grid is a MultiGrid, the tree only
+ * holds elements without children: an element is removed from the tree once
+ * a child of the same base type is created and it is reinserted during
+ * 'update' if all its children were erased.
+ *
+ * \note	Observer registrations are not copied when a tree is copied.
+ */
 template <int tree_dim, int world_dim, class grid_elem_t>
-class lg_ntree : public ntree<tree_dim, world_dim, grid_elem_t*, NTreeGridData<world_dim> >
+class lg_ntree : public ntree<tree_dim, world_dim, grid_elem_t*, NTreeGridData<world_dim> >,
+				 public GridObserver
 {
 	public:
 		typedef ntree<tree_dim, world_dim, grid_elem_t*, NTreeGridData<world_dim> >	base_t;
 		typedef typename NTreeGridData<world_dim>::position_attachment_t	position_attachment_t;
+		typedef typename grid_elem_t::grid_base_object	grid_base_object_t;
 
-		lg_ntree()
+		lg_ntree() :
+			m_pObservedGrid(NULL),
+			m_surfaceOnly(false),
+			m_parentsReleased(false)
 		{}
 
 		lg_ntree(Grid& grid, position_attachment_t aPos) :
-			m_gridData(grid, aPos)
+			m_gridData(grid, aPos),
+			m_pObservedGrid(NULL),
+			m_surfaceOnly(false),
+			m_parentsReleased(false)
+		{}
+
+		lg_ntree(const lg_ntree& tree) :
+			base_t(tree),
+			GridObserver(),
+			m_gridData(tree.m_gridData),
+			m_pObservedGrid(NULL),
+			m_surfaceOnly(false),
+			m_parentsReleased(false)
 		{}
 
+		virtual ~lg_ntree()
+		{
+			enable_auto_update(false);
+		}
+
+		lg_ntree& operator=(const lg_ntree& tree)
+		{
+			if(this != &tree){
+				enable_auto_update(false);
+				base_t::operator=(tree);
+				m_gridData = tree.m_gridData;
+			}
+			return *this;
+		}
+
 		void set_grid(Grid& grid, position_attachment_t aPos)
 		{
+			const bool autoUpdate = auto_update_enabled();
+			const bool surfaceOnly = m_surfaceOnly;
+			enable_auto_update(false);
 			m_gridData = NTreeGridData<world_dim>(grid, aPos);
+			if(autoUpdate)
+				enable_auto_update(true, surfaceOnly);
 		}
 
 		template <class TIterator>
@@ -358,6 +414,7 @@ class lg_ntree : public ntree<tree_dim, world_dim, grid_elem_t*, NTreeGridData<w
 			base_t::set_common_data(m_gridData);
 
 			base_t::clear();
+			m_vCreated.clear();
 
 			while(elemsBegin != elemsEnd){
 				base_t::add_element(*elemsBegin);
@@ -367,8 +424,224 @@ class lg_ntree : public ntree<tree_dim, world_dim, grid_elem_t*, NTreeGridData<w
 			base_t::rebalance();
 		}
 
+	///	registers the tree as an observer of its grid.
+	/**	Call 'update' after changes to the grid (e.g. after refinement) to
+	 * insert new elements. Erased elements are removed immediately.
+	 * Make sure to call 'set_grid' or to use the constructor with a grid first.
+	 * \param surfaceOnly	only has an effect if the grid is a MultiGrid.
+	 *						see class description.*/
+		void enable_auto_update(bool enable, bool surfaceOnly = false)
+		{
+			if(m_pObservedGrid){
+				m_pObservedGrid->unregister_observer(this);
+				m_pObservedGrid = NULL;
+			}
+			m_vCreated.clear();
+			m_releasedParents.clear();
+			m_parentsReleased = false;
+			m_surfaceOnly = surfaceOnly;
+
+			if(!enable)
+				return;
+
+			Grid* grid = m_gridData.grid_ptr();
+			UG_COND_THROW(!grid, "lg_ntree::enable_auto_update: No grid assigned. "
+						  "Call set_grid first.");
+
+			m_pObservedGrid = grid;
+			grid->register_observer(this, OT_GRID_OBSERVER | observer_type());
+
+		//	parents which already have children are not contained in a surface tree.
+		//	They have to be known, so that they can be reinserted after coarsening.
+			if(MultiGrid* mg = multi_grid()){
+				typedef typename geometry_traits<grid_elem_t>::iterator	iter_t;
+				for(iter_t iter = mg->template begin<grid_elem_t>();
+					iter != mg->template end<grid_elem_t>(); ++iter)
+				{
+					if(static_cast<const MultiGrid*>(mg)->has_children(*iter))
+						m_releasedParents.insert(*iter);
+				}
+			}
+		}
+
+		bool auto_update_enabled() const	{return m_pObservedGrid != NULL;}
+
+	///	returns the number of created elements which were not yet inserted through 'update'
+		size_t num_pending_elements() const	{return m_vCreated.size();}
+
+	///	inserts all elements which were created since the last update.
+	/**	If many elements were created or removed since the last rebalance,
+	 * the whole tree is rebalanced instead of inserting elements one by one.*/
+		void update()
+		{
+			base_t::set_common_data(m_gridData);
+
+			const MultiGrid* mg = multi_grid();
+			if(mg){
+			//	elements which replaced a parent inherit its children
+				for(size_t i = 0; i < m_vCreated.size();){
+					if(mg->has_children(m_vCreated[i])){
+						m_releasedParents.insert(m_vCreated[i]);
+						m_vCreated[i] = m_vCreated.back();
+						m_vCreated.pop_back();
+					}
+					else
+						++i;
+				}
+			}
+
+		//	reinsert parents whose children were erased
+			if(mg && m_parentsReleased){
+				typename std::set<grid_elem_t*>::iterator iter = m_releasedParents.begin();
+				while(iter != m_releasedParents.end()){
+					if(!mg->has_children(*iter)){
+						m_vCreated.push_back(*iter);
+						m_releasedParents.erase(iter++);
+					}
+					else
+						++iter;
+				}
+				m_parentsReleased = false;
+			}
+
+			const size_t numTreeElems = base_t::size();
+			if(m_vCreated.size() > numTreeElems / 4
+			   || base_t::num_removed_elements() > numTreeElems)
+			{
+				for(size_t i = 0; i < m_vCreated.size(); ++i)
+					base_t::add_element(m_vCreated[i]);
+				base_t::rebalance();
+			}
+			else{
+				for(size_t i = 0; i < m_vCreated.size(); ++i)
+					base_t::insert_element(m_vCreated[i]);
+			}
+			m_vCreated.clear();
+		}
+
+	//	grid observer callbacks
+		virtual void grid_to_be_destroyed(Grid* grid)
+		{
+		//	the grid unregisters all observers itself
+			m_pObservedGrid = NULL;
+			elements_to_be_cleared(grid);
+		}
+
+		virtual void elements_to_be_cleared(Grid* grid)
+		{
+			base_t::clear();
+			m_vCreated.clear();
+			m_releasedParents.clear();
+			m_parentsReleased = false;
+		}
+
+		virtual void vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent = NULL,
+									bool replacesParent = false)
+		{elem_created(vrt, pParent, replacesParent);}
+
+		virtual void edge_created(Grid* grid, Edge* e, GridObject* pParent = NULL,
+								  bool replacesParent = false)
+		{elem_created(e, pParent, replacesParent);}
+
+		virtual void face_created(Grid* grid, Face* f, GridObject* pParent = NULL,
+								  bool replacesParent = false)
+		{elem_created(f, pParent, replacesParent);}
+
+		virtual void volume_created(Grid* grid, Volume* vol, GridObject* pParent = NULL,
+									bool replacesParent = false)
+		{elem_created(vol, pParent, replacesParent);}
+
+		virtual void vertex_to_be_erased(Grid* grid, Vertex* vrt, Vertex* replacedBy = NULL)
+		{elem_to_be_erased(vrt);}
+
+		virtual void edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy = NULL)
+		{elem_to_be_erased(e);}
+
+		virtual void face_to_be_erased(Grid* grid, Face* f, Face* replacedBy = NULL)
+		{elem_to_be_erased(f);}
+
+		virtual void volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy = NULL)
+		{elem_to_be_erased(vol);}
+
+	private:
+		uint observer_type() const
+		{
+			switch(grid_base_object_t::BASE_OBJECT_ID){
+				case VERTEX:	return OT_VERTEX_OBSERVER;
+				case EDGE:		return OT_EDGE_OBSERVER;
+				case FACE:		return OT_FACE_OBSERVER;
+				default:		return OT_VOLUME_OBSERVER;
+			}
+		}
+
+	///	returns the observed grid as a MultiGrid if surfaceOnly is enabled, NULL otherwise
+		MultiGrid* multi_grid() const
+		{
+			if(!m_surfaceOnly || !m_pObservedGrid)
+				return NULL;
+			return dynamic_cast<MultiGrid*>(m_pObservedGrid);
+		}
+
+		template <class TElem>
+		void elem_created(TElem* e, GridObject* pParent, bool replacesParent)
+		{
+			grid_elem_t* elem = dynamic_cast<grid_elem_t*>(e);
+			if(!elem)
+				return;
+
+			m_vCreated.push_back(elem);
+
+		//	a replaced parent is erased from the grid and thus handled
+		//	in elem_to_be_erased.
+			if(replacesParent || !pParent || !multi_grid())
+				return;
+
+			if(grid_elem_t* parent = dynamic_cast<grid_elem_t*>(pParent)){
+				if(m_releasedParents.insert(parent).second)
+					remove_from_tree(parent);
+			}
+		}
+
+		template <class TElem>
+		void elem_to_be_erased(TElem* e)
+		{
+			grid_elem_t* elem = dynamic_cast<grid_elem_t*>(e);
+			if(!elem)
+				return;
+
+			if(!m_releasedParents.empty() && m_releasedParents.erase(elem) > 0)
+				return;
+
+			remove_from_tree(elem);
+			if(multi_grid())
+				m_parentsReleased = !m_releasedParents.empty();
+		}
+
+		void remove_from_tree(grid_elem_t* elem)
+		{
+			if(!m_vCreated.empty()){
+				typename std::vector<grid_elem_t*>::iterator iter =
+						std::find(m_vCreated.begin(), m_vCreated.end(), elem);
+				if(iter != m_vCreated.end()){
+					*iter = m_vCreated.back();
+					m_vCreated.pop_back();
+					return;
+				}
+			}
+			base_t::set_common_data(m_gridData);
+			base_t::remove_element(elem);
+		}
+
 	private:
 		NTreeGridData<world_dim>	m_gridData;
+		Grid*						m_pObservedGrid;
+		bool						m_surfaceOnly;
+	///	true if elements were erased while parents were released
+		bool						m_parentsReleased;
+	///	elements which were created since the last call to update
+		std::vector<grid_elem_t*>	m_vCreated;
+	///	elements which are not in the tree, since they have children (surfaceOnly only)
+		std::set<grid_elem_t*>		m_releasedParents;
 };
 
 
@@ -69,16 +69,18 @@ typedef std::list<KDVertexDistance> KDVertexDistanceList;
 ////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////
 //	KDTreeStatic
-///	organizes vertices in a binary-tree structure. Only for static use!
+///	organizes vertices in a binary-tree structure.
 /**
  * A kd-tree allows you to find vertices close to a given position in O(log(n)).
  *
- * This kd-tree should be only used for static geometry. If you intend to
- * add or delete vertices after creation, KDTreeStatic is not suited for your
- * needs.
+ * The tree is built once through create_from_grid. If ug4 was compiled with
+ * OpenMP, the top levels are split serially and the resulting subtrees are
+ * built concurrently (see set_num_threads).
  *
- * This class should be replaced by a dynamic kd-tree, which is capable of
- * dynamic auto-balancing.
+ * Single vertices can be added or removed afterwards through insert_vertex
+ * and erase_vertex. Leaves which grow beyond twice the split threshold are
+ * split again, however the tree is not rebalanced. If the geometry changes
+ * considerably, the tree should be recreated.
  */
 template <class TPositionAttachment, int numDimensions = 3, class TVector = vector3 >
 class KDTreeStatic
@@ -101,10 +103,14 @@ class KDTreeStatic
 		};
 
 	//	the functions
-		KDTreeStatic() : m_pGrid(NULL)	{};
+		KDTreeStatic() : m_pGrid(NULL), m_iSplitThreshold(1), m_iMaxTreeDepth(0),
+						 m_numThreads(1)	{};
 
 		void clear();
 
+	///	sets the number of threads used in create_from_grid (ignored without OpenMP)
+		void set_num_threads(int numThreads);
+
 		template <class TVrtIterator>
 		bool create_from_grid(Grid& grid, TVrtIterator vrtsBegin, TVrtIterator vrtsEnd,
 								TPositionAttachment& aPos, int maxTreeDepth, int splitThreshold,
@@ -116,6 +122,16 @@ class KDTreeStatic
 								int maxTreeDepth, int splitThreshold,
 								KDSplitDimension splitDimension = KDSD_LARGEST);
 
+	///	adds a vertex to the leaf which contains its position.
+	/**	The leaf is split if it holds more than twice the split threshold
+	 * vertices afterwards and if the maximum tree depth was not yet reached.*/
+		void insert_vertex(Vertex* vrt);
+
+	///	removes a vertex from the tree
+	/**	Leaves are not merged if they become small.
+	 * \returns false if the vertex was not found.*/
+		bool erase_vertex(Vertex* vrt);
+
 		bool get_neighbourhood(std::vector<Vertex*>& vrtsOut,
 								typename TPositionAttachment::ValueType& pos, int numClosest);
 
@@ -127,14 +143,34 @@ class KDTreeStatic
 		void get_leafs(std::vector<Node*>& vLeafsOut);
 		
 	protected:
+	///	describes a node which still has to be built from the vertices in [begin, end)
+		struct BuildTask
+		{
+			BuildTask()	{}
+			BuildTask(Node* n, size_t b, size_t e, int dim, int depth) :
+				node(n), begin(b), end(e), splitDimension(dim), maxTreeDepth(depth)	{}
+
+			Node*	node;
+			size_t	begin;
+			size_t	end;
+			int		splitDimension;
+			int		maxTreeDepth;
+		};
+
 		bool get_points_in_box(std::vector<Vertex*>& vrtsOut, Node* pNode,
 								const TVector& boxMin, const TVector& boxMax);
 
 		void neighbourhood(KDVertexDistanceList& vrtsOut, Node* pNode, TVector& pos, int numClosest);
 
-		template <class TVertexIterator>
-		bool create_barycentric(TVertexIterator vrts_begin, TVertexIterator vrts_end,
-								int numVertices, Node* pNode, int actDimension, int maxTreeDepth);
+	///	builds the subtree described by task. The vertices in vrts are reordered.
+		void create_barycentric(VertexVec& vrts, const BuildTask& task);
+
+	///	either turns the node of the task into a leaf or splits it once.
+	/**	Vertices of the two children are moved to [begin, mid) (pos) and
+	 * [mid, end) (neg) of vrts.
+	 * \returns	the number of child tasks written to childTasksOut. Empty
+	 *			children are turned into leaves directly and get no task.*/
+		int split_node(VertexVec& vrts, const BuildTask& task, BuildTask childTasksOut[2]);
 
 		template <class TVertexIterator>
 		int get_largest_dimension(TVertexIterator vrts_begin, TVertexIterator vrts_end);
@@ -149,6 +185,8 @@ class KDTreeStatic
 		Grid*	m_pGrid;
 		Grid::VertexAttachmentAccessor<TPositionAttachment>	m_aaPos;
 		int		m_iSplitThreshold;
+		int		m_iMaxTreeDepth;
+		int		m_numThreads;
 		Node	m_parentNode;
 		KDSplitDimension	m_splitDimension;	//	how is the next split dimension choosen?
 
@@ -33,10 +33,13 @@
 #ifndef __H__LIB_GRID__KD_TREE_IMPL__
 #define __H__LIB_GRID__KD_TREE_IMPL__
 
+#include <algorithm>
 #include <list>
+#include <string>
 #include <vector>
 #include "lib_grid/grid/grid.h"
 #include "common/math/ugmath.h"
+#include "common/error.h"
 
 namespace ug
 {
@@ -81,6 +84,22 @@ create_from_grid(Grid& grid, TVrtIterator vrtsBegin, TVrtIterator vrtsEnd,
 							splitThreshold, splitDimension);
 }
 
+template<class TPositionAttachment, int numDimensions, class TVector>
+void
+KDTreeStatic<TPositionAttachment, numDimensions, TVector>::
+set_num_threads(int numThreads)
+{
+	UG_COND_THROW(numThreads < 1, "KDTreeStatic::set_num_threads: number of "
+				  "threads has to be at least 1, but " << numThreads << " was given.");
+#ifndef UG_OPENMP
+	if(numThreads > 1){
+		UG_LOG("WARNING in KDTreeStatic::set_num_threads: ug4 is compiled without "
+			   "OpenMP (cmake -DOPENMP=ON). The tree construction stays serial.\n");
+	}
+#endif
+	m_numThreads = numThreads;
+}
+
 template<class TPositionAttachment, int numDimensions, class TVector>
 template <class TVrtIterator>
 bool
@@ -94,8 +113,139 @@ create_from_grid(Grid& grid, TVrtIterator vrtsBegin, TVrtIterator vrtsEnd,
 	m_pGrid = &grid;
 	m_aaPos = aaPos;
 	m_iSplitThreshold = splitThreshold;
+	m_iMaxTreeDepth = maxTreeDepth;
 	m_splitDimension = splitDimension;	//	how the split dimensions are chosen
-	return create_barycentric(vrtsBegin, vrtsEnd, grid.num_vertices(), &m_parentNode, 0, maxTreeDepth);
+
+//	the vertices are partitioned in place. Each node owns a consecutive
+//	range of vrts during construction.
+	VertexVec vrts(vrtsBegin, vrtsEnd);
+
+//	split the top levels until there are enough independent subtrees to keep
+//	all threads busy.
+	std::vector<BuildTask> tasks(1, BuildTask(&m_parentNode, 0, vrts.size(),
+											  0, maxTreeDepth));
+	if(m_numThreads > 1){
+		const size_t minNumTasks = 4 * (size_t)m_numThreads;
+		while(!tasks.empty() && tasks.size() < minNumTasks){
+			std::vector<BuildTask> nextTasks;
+			for(size_t i = 0; i < tasks.size(); ++i){
+				BuildTask childTasks[2];
+				int numChildTasks = split_node(vrts, tasks[i], childTasks);
+				for(int j = 0; j < numChildTasks; ++j)
+					nextTasks.push_back(childTasks[j]);
+			}
+			tasks.swap(nextTasks);
+		}
+	}
+
+	const int numTasks = (int)tasks.size();
+	bool bError = false;
+	std::string errMsg;
+
+	#ifdef UG_OPENMP
+	#pragma omp parallel for num_threads(m_numThreads) schedule(dynamic)
+	#endif
+	for(int i = 0; i < numTasks; ++i){
+		try{
+			create_barycentric(vrts, tasks[i]);
+		}
+		catch(UGError& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (KDTreeStaticCreate)
+			#endif
+			{
+				bError = true;
+				errMsg = err.get_stacktrace();
+			}
+		}
+		catch(std::exception& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (KDTreeStaticCreate)
+			#endif
+			{
+				bError = true;
+				errMsg = err.what();
+			}
+		}
+	}
+
+	UG_COND_THROW(bError, "KDTreeStatic::create_from_grid failed:\n" << errMsg);
+	return true;
+}
+
+template<class TPositionAttachment, int numDimensions, class TVector>
+void
+KDTreeStatic<TPositionAttachment, numDimensions, TVector>::
+insert_vertex(Vertex* vrt)
+{
+	UG_COND_THROW(!m_pGrid, "KDTreeStatic::insert_vertex: call create_from_grid first.");
+	const typename TPositionAttachment::ValueType& pos = m_aaPos[vrt];
+
+//	find the leaf. Use the same criterion as during construction.
+	Node* pNode = &m_parentNode;
+	int depth = 0;
+	int splitDimension = 0;
+	while(pNode->m_pChild[0] || pNode->m_pChild[1]){
+		splitDimension = pNode->m_iSplitDimension;
+		if(pos.coord(splitDimension) >= pNode->m_fSplitValue)
+			pNode = pNode->m_pChild[0];
+		else
+			pNode = pNode->m_pChild[1];
+		++depth;
+	}
+
+	if(!pNode->m_pvVertices)
+		pNode->m_pvVertices = new VertexVec;
+	pNode->m_pvVertices->push_back(vrt);
+
+	if((int)pNode->m_pvVertices->size() > 2 * m_iSplitThreshold
+	   && depth < m_iMaxTreeDepth)
+	{
+		VertexVec vrts;
+		vrts.swap(*pNode->m_pvVertices);
+		delete pNode->m_pvVertices;
+		pNode->m_pvVertices = NULL;
+
+		int nextDim = splitDimension;
+		if(depth > 0)
+			nextDim = get_next_split_dimension(splitDimension, vrts.begin(), vrts.end());
+		create_barycentric(vrts, BuildTask(pNode, 0, vrts.size(), nextDim,
+										   m_iMaxTreeDepth - depth));
+	}
+}
+
+template<class TPositionAttachment, int numDimensions, class TVector>
+bool
+KDTreeStatic<TPositionAttachment, numDimensions, TVector>::
+erase_vertex(Vertex* vrt)
+{
+	const typename TPositionAttachment::ValueType& pos = m_aaPos[vrt];
+
+	Node* pNode = &m_parentNode;
+	while(pNode->m_pChild[0] || pNode->m_pChild[1]){
+		if(pos.coord(pNode->m_iSplitDimension) >= pNode->m_fSplitValue)
+			pNode = pNode->m_pChild[0];
+		else
+			pNode = pNode->m_pChild[1];
+	}
+
+	std::vector<Node*> vLeafs(1, pNode);
+	for(int i_try = 0; i_try < 2; ++i_try){
+		for(size_t i = 0; i < vLeafs.size(); ++i){
+			VertexVec* vrts = vLeafs[i]->m_pvVertices;
+			if(!vrts)
+				continue;
+			VertexVec::iterator iter = std::find(vrts->begin(), vrts->end(), vrt);
+			if(iter != vrts->end()){
+				*iter = vrts->back();
+				vrts->pop_back();
+				return true;
+			}
+		}
+	//	the vertex may have moved since its insertion. Search all leaves.
+		get_leafs(vLeafs);
+	}
+	return false;
 }
 
 template<class TPositionAttachment, int numDimensions, class TVector>
@@ -119,7 +269,7 @@ KDTreeStatic<TPositionAttachment, numDimensions, TVector>::
 get_points_in_box(std::vector<Vertex*>& vrtsOut, const TVector& boxMin, const TVector& boxMax)
 {
 	vrtsOut.clear();
-	return get_vertices_in_box(vrtsOut, &m_parentNode, boxMin, boxMax);
+	return get_points_in_box(vrtsOut, &m_parentNode, boxMin, boxMax);
 }
 
 template<class TPositionAttachment, int numDimensions, class TVector>
@@ -272,65 +422,83 @@ neighbourhood(KDVertexDistanceList& vrtsOut, Node* pNode, TVector& pos, int numC
 }
 
 template<class TPositionAttachment, int numDimensions, class TVector>
-template <class TVertexIterator>
-bool
+void
 KDTreeStatic<TPositionAttachment, numDimensions, TVector>::
-create_barycentric(TVertexIterator vrts_begin, TVertexIterator vrts_end, int numVertices,
-					Node* pNode, int actDimension, int maxTreeDepth)
+create_barycentric(VertexVec& vrts, const BuildTask& task)
 {
+	BuildTask childTasks[2];
+	int numChildTasks = split_node(vrts, task, childTasks);
+	for(int i = 0; i < numChildTasks; ++i)
+		create_barycentric(vrts, childTasks[i]);
+}
+
+template<class TPositionAttachment, int numDimensions, class TVector>
+int
+KDTreeStatic<TPositionAttachment, numDimensions, TVector>::
+split_node(VertexVec& vrts, const BuildTask& task, BuildTask childTasksOut[2])
+{
+	Node* pNode = task.node;
+	const int numVertices = (int)(task.end - task.begin);
+	VertexVec::iterator vrtsBegin = vrts.begin() + task.begin;
+	VertexVec::iterator vrtsEnd = vrts.begin() + task.end;
+
 //	check if we are in a leaf
+	if((task.maxTreeDepth < 1) || (numVertices <= m_iSplitThreshold))
 	{
-		if((maxTreeDepth < 1) || (numVertices <= m_iSplitThreshold))
-		{
-		//	we are
-			pNode->m_pvVertices = new VertexVec;
-		//	loop through the points and add them to the node
-			for(TVertexIterator iter = vrts_begin; iter != vrts_end; iter++)
-				pNode->m_pvVertices->push_back(*iter);
-		//	we're done
-			return true;
-		}
+	//	we are. add the points to the node
+		pNode->m_pvVertices = new VertexVec(vrtsBegin, vrtsEnd);
+		return 0;
 	}
 
 //	loop through the points and calculate the barycentre
+	const int actDimension = task.splitDimension;
 	float barycentre = 0;
 	{
-		for(TVertexIterator iter = vrts_begin; iter != vrts_end; iter++)
+		for(VertexVec::iterator iter = vrtsBegin; iter != vrtsEnd; iter++)
 			barycentre += m_aaPos[*iter].coord(actDimension);
 		barycentre /= (float)numVertices;
 	}
 
-//	fill the lists for the poitive and negative subnodes
-	std::list<Vertex*> lstPos;
-	std::list<Vertex*> lstNeg;
-	int numPos = 0;
-	int numNeg = 0;
+//	move the vertices of the positive subnode to the front of the range
+//	and those of the negative subnode to its back.
+	VertexVec::iterator vrtsMid = vrtsBegin;
+	for(VertexVec::iterator iter = vrtsBegin; iter != vrtsEnd; ++iter)
 	{
-		for(TVertexIterator iter = vrts_begin; iter != vrts_end; iter++, numPos++, numNeg++)
-		{
-			if(m_aaPos[*iter].coord(actDimension) >= barycentre)
-				lstPos.push_back(*iter);
-			else
-				lstNeg.push_back(*iter);
+		if(m_aaPos[*iter].coord(actDimension) >= barycentre){
+			std::swap(*iter, *vrtsMid);
+			++vrtsMid;
 		}
 	}
+	const size_t mid = task.begin + (vrtsMid - vrtsBegin);
+
 //	create the subnodes
-	bool bSuccess = true;
-	{
-		pNode->m_iSplitDimension = actDimension;
-		pNode->m_fSplitValue = barycentre;
+	pNode->m_iSplitDimension = actDimension;
+	pNode->m_fSplitValue = barycentre;
+
+	for(int i = 0; i < 2; ++i)
+		pNode->m_pChild[i] = new Node;
+
+//	empty subnodes are leaves without vertices
+	int numChildTasks = 0;
+//	the positive one
+	if(mid > task.begin)
+		childTasksOut[numChildTasks++] =
+			BuildTask(pNode->m_pChild[0], task.begin, mid,
+					  get_next_split_dimension(actDimension, vrtsBegin, vrtsMid),
+					  task.maxTreeDepth - 1);
+	else
+		pNode->m_pChild[0]->m_pvVertices = new VertexVec;
+
+//	the negative one
+	if(mid < task.end)
+		childTasksOut[numChildTasks++] =
+			BuildTask(pNode->m_pChild[1], mid, task.end,
+					  get_next_split_dimension(actDimension, vrtsMid, vrtsEnd),
+					  task.maxTreeDepth - 1);
+	else
+		pNode->m_pChild[1]->m_pvVertices = new VertexVec;
 
-		for(int i = 0; i < 2; ++i)
-			pNode->m_pChild[i] = new Node;
-	//	the positive one
-		if(!lstPos.empty())
-			bSuccess &= create_barycentric(lstPos.begin(), lstPos.end(), numPos, pNode->m_pChild[0], get_next_split_dimension(actDimension, lstPos.begin(), lstPos.end()), maxTreeDepth - 1);
-	//	the negative one
-		if(!lstNeg.empty())
-			bSuccess &= create_barycentric(lstNeg.begin(), lstNeg.end(), numNeg, pNode->m_pChild[1], get_next_split_dimension(actDimension, lstNeg.begin(), lstNeg.end()), maxTreeDepth - 1);
-	}
-//	done
-	return bSuccess;
+	return numChildTasks;
 }
 
 template<class TPositionAttachment, int numDimensions, class TVector>
@@ -390,6 +390,14 @@ class UG_API AttachmentPipe
 	/**	Aligns data with elements and removes unused data-memory.*/
 		void defragment();
 
+	///	Aligns the data with the current order of the elements.
+	/**	In contrast to defragment, this method always rebuilds the data
+	 * arrays, so that the i-th data entry corresponds to the i-th element
+	 * afterwards. Call it after the elements have been reordered, to have
+	 * the data arrays traversed in the same order as the elements.
+	 * Unused data-memory is removed, too.*/
+		void align_data_with_elements();
+
 	/**\brief attaches a new data-array to the pipe.
 	 *
 	 * Attachs a new attachment and creates a container which holds the
@@ -292,44 +292,56 @@ defragment()
 	if(!is_fragmented())
 		return;
 
+	align_data_with_elements();
+}
+
+template <class TElem, class TElemHandler>
+void
+AttachmentPipe<TElem, TElemHandler>::
+align_data_with_elements()
+{
 //	if num_elements == 0, then simply resize all data-containers to 0.
 	if(num_elements() == 0)
 	{
 	//	just clear the attachment containers.
-		for(AttachmentEntryIterator iter = m_attachmentEntryContainer.begin();
-			iter != m_attachmentEntryContainer.end(); iter++)
-		{
-			(*iter).m_pContainer->resize(0);
-		}
+		resize_attachment_containers(0);
 		m_stackFreeEntries = UINTStack();
 		m_numDataEntries = 0;
 	}
 	else
 	{
 	//	calculate the fragmentation array. It has to be of the same size as the fragmented data containers.
-		std::vector<uint> vNewIndices(num_data_entries(), INVALID_ATTACHMENT_INDEX);
+		std::vector<size_t> vNewIndices(get_container_size(), INVALID_ATTACHMENT_INDEX);
 
-	//	iterate through the elements and calculate the new index of each
+	//	iterate through the elements and calculate the new index of each.
+	//	The indices of the elements are only changed afterwards, since the
+	//	element list itself may store its links in the data of this pipe.
+		std::vector<TElem> vElems;
+		vElems.reserve(num_elements());
 		size_t counter = 0;
 		typename atraits::element_iterator iter = atraits::elements_begin(m_pHandler);
 		typename atraits::element_iterator end = atraits::elements_end(m_pHandler);
 
 		for(; iter != end; ++iter){
 			vNewIndices[atraits::get_data_index(m_pHandler, (*iter))] = counter;
-			atraits::set_data_index(m_pHandler, (*iter), counter);
+			vElems.push_back(*iter);
 			++counter;
 		}
 
+		for(size_t i = 0; i < vElems.size(); ++i)
+			atraits::set_data_index(m_pHandler, vElems[i], i);
+
 	//	after defragmentation there are no free indices.
 		m_stackFreeEntries = UINTStack();
 		m_numDataEntries = counter;
+		m_containerSize = counter;
 
 	//	now iterate through the attached data-containers and defragment each one.
 		{
 			for(AttachmentEntryIterator iter = m_attachmentEntryContainer.begin();
 						iter != m_attachmentEntryContainer.end(); iter++)
 			{
-				(*iter).m_pContainer->defragment(&vNewIndices.front(), num_elements());
+				(*iter).m_pContainer->defragment(&vNewIndices.front(), counter);
 			}
 		}
 	}
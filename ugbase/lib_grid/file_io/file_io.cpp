@@ -53,6 +53,7 @@
 #include "file_io_dump.h"
 #include "file_io_ncdf.h"
 #include "file_io_ugx.h"
+#include "file_io_ugxb.h"
 #include "file_io_msh.h"
 #include "file_io_stl.h"
 #include "file_io_tikz.h"
@@ -199,7 +200,16 @@ static bool LoadGrid(Grid& grid, ISubsetHandler* psh,
 	//	handled. Then all those which only work with 3d position types are processed.
 		string tfile = FindFileInStandardPaths(filename);
 		if(!tfile.empty()){
-			if(tfile.find(".ugx") != string::npos){
+			if(tfile.find(".ugxb") != string::npos){
+				if(psh)
+					retVal = LoadGridFromUGXB(grid, *psh, tfile.c_str(), aPos);
+				else{
+				//	we have to create a temporary subset handler
+					SubsetHandler shTmp(grid);
+					retVal = LoadGridFromUGXB(grid, shTmp, tfile.c_str(), aPos);
+				}
+			}
+			else if(tfile.find(".ugx") != string::npos){
 				if(psh)
 					retVal = LoadGridFromUGX(grid, *psh, tfile.c_str(), aPos);
 				else{
@@ -265,7 +275,16 @@ static bool LoadGrid(Grid& grid, SPProjectionHandler* ph, size_t& num_ph, ISubse
 	//	handled. Then all those which only work with 3d position types are processed.
 		string tfile = FindFileInStandardPaths(filename);
 		if(!tfile.empty()){
-			if(tfile.find(".ugx") != string::npos){
+			if(tfile.find(".ugxb") != string::npos){
+				if(psh)
+					retVal = LoadGridFromUGXB(grid, *ph, num_ph, *psh, additionalSHNames, ash, tfile.c_str(), aPos);
+				else{
+				//	we have to create a temporary subset handler
+					SubsetHandler shTmp(grid);
+					retVal = LoadGridFromUGXB(grid, *ph, num_ph, shTmp, additionalSHNames, ash, tfile.c_str(), aPos);
+				}
+			}
+			else if(tfile.find(".ugx") != string::npos){
 				if(psh)
 					retVal = LoadGridFromUGX(grid, *ph, num_ph, *psh, additionalSHNames, ash, tfile.c_str(), aPos);
 				else{
@@ -431,7 +450,15 @@ static bool SaveGrid(Grid& grid, ISubsetHandler* psh,
 					 const char* filename, TAPos& aPos)
 {
 	string strName = filename;
-	if(strName.find(".ugx") != string::npos){
+	if(strName.find(".ugxb") != string::npos){
+		if(psh)
+			return SaveGridToUGXB(grid, *psh, strName.c_str(), aPos);
+		else {
+			SubsetHandler shTmp(grid);
+			return SaveGridToUGXB(grid, shTmp, strName.c_str(), aPos);
+		}
+	}
+	else if(strName.find(".ugx") != string::npos){
 		 #if (defined UG_PARALLEL && defined UG_DEBUG)
 		 std::size_t found=strName.find(".ugx");
 		 strName=strName.replace(found, 4, "");
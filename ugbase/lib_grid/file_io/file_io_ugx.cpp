@@ -36,6 +36,7 @@
 #include <boost/archive/text_iarchive.hpp>
 #include "common/common.h"
 #include "common/util/file_util.h"
+#include "common/util/async_file_writer.h"
 #include "file_io_ugx.h"
 #include "common/boost_serialization_routines.h"
 #include "common/parser/rapidxml/rapidxml_print.hpp"
@@ -110,6 +111,16 @@ write_to_stream(std::ostream& out)
 bool GridWriterUGX::
 write_to_file(const char* filename)
 {
+	if(AsyncFileWriter::inst().enabled()){
+	//	the document is printed right away, only the disk I/O is deferred
+		stringstream ss;
+		if(!write_to_stream(ss))
+			return false;
+		string content = ss.str();
+		AsyncFileWriter::inst().write(filename, content);
+		return true;
+	}
+
 	ofstream out(filename);
 	if(out){
 		return write_to_stream(out);
@@ -0,0 +1,1150 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include "common/common.h"
+#include "file_io_ugxb.h"
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#ifdef UG_POSIX
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+#include "common/boost_serialization_routines.h"
+#include "common/util/archivar.h"
+#include "common/util/factory.h"
+#include "file_io_ugx.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/refinement/projectors/projectors.h"
+#include "lib_grid/tools/subset_handler_grid.h"
+#include "lib_grid/tools/selector_grid.h"
+
+using namespace std;
+
+namespace ug
+{
+
+static const char UGXB_MAGIC[4] = {'U', 'G', 'X', 'B'};
+static const uint32 UGXB_BYTE_ORDER = 0x01020304;
+
+static inline uint64 AlignUGXB(uint64 offset)
+{
+	return (offset + UGXB_ALIGNMENT - 1) / UGXB_ALIGNMENT * UGXB_ALIGNMENT;
+}
+
+///	returns whether [offset, offset + size) lies in [0, totalSize), without overflow
+static inline bool RangeFitsUGXB(uint64 offset, uint64 size, uint64 totalSize)
+{
+	return offset <= totalSize && size <= totalSize - offset;
+}
+
+///	returns whether count entries of entrySize bytes fit into size bytes, without overflow
+static inline bool EntriesFitUGXB(uint64 count, uint64 entrySize, uint64 size)
+{
+	return entrySize == 0 || count <= size / entrySize;
+}
+
+////////////////////////////////////////////////////////////////////////
+bool SaveGridToUGXB(Grid& grid, ISubsetHandler& sh,
+					const char* filename)
+{
+	if(grid.has_vertex_attachment(aPosition))
+		return SaveGridToUGXB(grid, sh, filename, aPosition);
+	else if(grid.has_vertex_attachment(aPosition2))
+		return SaveGridToUGXB(grid, sh, filename, aPosition2);
+	else if(grid.has_vertex_attachment(aPosition1))
+		return SaveGridToUGXB(grid, sh, filename, aPosition1);
+
+	UG_LOG("ERROR in SaveGridToUGXB: no standard attachment found.\n");
+	return false;
+}
+
+bool LoadGridFromUGXB(Grid& grid, ISubsetHandler& sh,
+					  const char* filename)
+{
+	if(grid.has_vertex_attachment(aPosition))
+		return LoadGridFromUGXB(grid, sh, filename, aPosition);
+	else if(grid.has_vertex_attachment(aPosition2))
+		return LoadGridFromUGXB(grid, sh, filename, aPosition2);
+	else if(grid.has_vertex_attachment(aPosition1))
+		return LoadGridFromUGXB(grid, sh, filename, aPosition1);
+
+//	no standard position attachments are available.
+//	Attach aPosition and use it.
+	grid.attach_to_vertices(aPosition);
+	return LoadGridFromUGXB(grid, sh, filename, aPosition);
+}
+
+template <class TAPosition>
+static bool LoadGridPartFromUGXB(Grid& grid, ISubsetHandler& sh,
+								 GridReaderUGXB& reader, TAPosition& aPos,
+								 int part, int numParts)
+{
+	if(!reader.grid_part(grid, 0, aPos, part, numParts))
+		return false;
+
+	if(reader.num_subset_handlers(0) > 0)
+		reader.subset_handler(sh, 0, 0);
+
+	return true;
+}
+
+bool LoadGridPartFromUGXB(Grid& grid, ISubsetHandler& sh, const char* filename,
+						  int part, int numParts)
+{
+	GridReaderUGXB reader;
+	if(!reader.open_file(filename)){
+		UG_LOG("ERROR in LoadGridPartFromUGXB: Can't read file: " << filename << std::endl);
+		return false;
+	}
+
+	if(reader.num_grids() < 1){
+		UG_LOG("ERROR in LoadGridPartFromUGXB: File contains no grid.\n");
+		return false;
+	}
+
+	if(grid.has_vertex_attachment(aPosition))
+		return LoadGridPartFromUGXB(grid, sh, reader, aPosition, part, numParts);
+	else if(grid.has_vertex_attachment(aPosition2))
+		return LoadGridPartFromUGXB(grid, sh, reader, aPosition2, part, numParts);
+	else if(grid.has_vertex_attachment(aPosition1))
+		return LoadGridPartFromUGXB(grid, sh, reader, aPosition1, part, numParts);
+
+	grid.attach_to_vertices(aPosition);
+	return LoadGridPartFromUGXB(grid, sh, reader, aPosition, part, numParts);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	conversion between ugx and ugxb
+///	reads the i-th grid with a position attachment of the given dimension
+template <class TReader>
+static bool ReadGridWithDim(TReader& reader, Grid& grid, size_t i, size_t dim)
+{
+	switch(dim){
+		case 1:	grid.attach_to_vertices(aPosition1);
+				return reader.grid(grid, i, aPosition1);
+		case 2:	grid.attach_to_vertices(aPosition2);
+				return reader.grid(grid, i, aPosition2);
+		default:grid.attach_to_vertices(aPosition);
+				return reader.grid(grid, i, aPosition);
+	}
+}
+
+template <class TWriter>
+static bool AddGridWithDim(TWriter& writer, Grid& grid, const char* name, size_t dim)
+{
+	switch(dim){
+		case 1:	return writer.add_grid(grid, name, aPosition1);
+		case 2:	return writer.add_grid(grid, name, aPosition2);
+		default:return writer.add_grid(grid, name, aPosition);
+	}
+}
+
+///	transfers all contents of a reader to a new file written by TWriter.
+/**	The readers and writers of ugx and ugxb files share their interfaces.*/
+template <class TWriter, class TReader>
+static bool TransferGridFile(TReader& reader, const vector<size_t>& dims,
+							 const char* destFilename)
+{
+	vector<SmartPtr<Grid> > grids;
+	vector<SmartPtr<ISubsetHandler> > subsetHandlers;
+	vector<SmartPtr<ISelector> > selectors;
+	vector<SmartPtr<ProjectionHandler> > projectionHandlers;
+
+//	the writer has to be destroyed before the grids
+	TWriter writer;
+
+	for(size_t i = 0; i < reader.num_grids(); ++i){
+		SmartPtr<Grid> grid = make_sp(new Grid(GRIDOPT_NONE));
+		grids.push_back(grid);
+
+		if(!ReadGridWithDim(reader, *grid, i, dims[i]))
+			return false;
+
+		if(!AddGridWithDim(writer, *grid, reader.get_grid_name(i), dims[i]))
+			return false;
+
+		vector<ISubsetHandler*> gridSHs;
+		for(size_t j = 0; j < reader.num_subset_handlers(i); ++j){
+			SmartPtr<ISubsetHandler> sh = make_sp(new SubsetHandler(*grid));
+			subsetHandlers.push_back(sh);
+			gridSHs.push_back(sh.get());
+			reader.subset_handler(*sh, j, i);
+			writer.add_subset_handler(*sh, reader.get_subset_handler_name(i, j), i);
+		}
+
+		for(size_t j = 0; j < reader.num_selectors(i); ++j){
+			SmartPtr<ISelector> sel = make_sp(new Selector(*grid));
+			selectors.push_back(sel);
+			reader.selector(*sel, j, i);
+			writer.add_selector(*sel, reader.get_selector_name(i, j), i);
+		}
+
+		for(size_t j = 0; j < reader.num_projection_handlers(i); ++j){
+			size_t shIndex = reader.get_projection_handler_subset_handler_index(j, i);
+			UG_COND_THROW(shIndex >= gridSHs.size(),
+						  "Bad subset handler index in projection handler: " << shIndex);
+			SmartPtr<ProjectionHandler> ph = make_sp(new ProjectionHandler(gridSHs[shIndex]));
+			projectionHandlers.push_back(ph);
+			reader.projection_handler(*ph, j, i);
+			writer.add_projection_handler(*ph, reader.get_projection_handler_name(i, j), i);
+		}
+	}
+
+	return writer.write_to_file(destFilename);
+}
+
+bool ConvertUGXToUGXB(const char* srcFilename, const char* destFilename)
+{
+	UGXFileInfo info;
+	GridReaderUGX reader;
+	if(!info.parse_file(srcFilename) || !reader.parse_file(srcFilename)){
+		UG_LOG("ERROR in ConvertUGXToUGXB: Can't read file: " << srcFilename << std::endl);
+		return false;
+	}
+
+	vector<size_t> dims;
+	for(size_t i = 0; i < reader.num_grids(); ++i)
+		dims.push_back(info.grid_world_dimension(i));
+
+	return TransferGridFile<GridWriterUGXB>(reader, dims, destFilename);
+}
+
+bool ConvertUGXBToUGX(const char* srcFilename, const char* destFilename)
+{
+	GridReaderUGXB reader;
+	if(!reader.open_file(srcFilename)){
+		UG_LOG("ERROR in ConvertUGXBToUGX: Can't read file: " << srcFilename << std::endl);
+		return false;
+	}
+
+	vector<size_t> dims;
+	for(size_t i = 0; i < reader.num_grids(); ++i)
+		dims.push_back(reader.grid_world_dimension(i));
+
+	return TransferGridFile<GridWriterUGX>(reader, dims, destFilename);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	implementation of GridWriterUGXB
+GridWriterUGXB::GridWriterUGXB()
+{
+}
+
+GridWriterUGXB::~GridWriterUGXB()
+{
+//	detach m_aInt from the grids
+	for(size_t i = 0; i < m_vEntries.size(); ++i){
+		Grid* grid = m_vEntries[i].grid;
+		grid->detach_from_vertices(m_aInt);
+		grid->detach_from_edges(m_aInt);
+		grid->detach_from_faces(m_aInt);
+		grid->detach_from_volumes(m_aInt);
+	}
+}
+
+GridWriterUGXB::Block& GridWriterUGXB::
+new_block(UGXBBlockType type, int grid, const char* name)
+{
+	m_blocks.push_back(Block());
+	Block& b = m_blocks.back();
+	memset(&b.info, 0, sizeof(UGXBBlockInfo));
+	b.info.type = type;
+	b.info.valueType = UGXB_BYTE;
+	b.info.grid = grid;
+	b.info.owner = -1;
+	b.info.index = -1;
+	b.info.objType = -1;
+	b.name = name;
+	return b;
+}
+
+void GridWriterUGXB::
+init_grid_attachments(Grid& grid)
+{
+	UG_COND_THROW(grid.num<Vertex>() != grid.num<RegularVertex>()
+				  || grid.num<Edge>() != grid.num<RegularEdge>()
+				  || grid.num<Face>() != grid.num<Triangle>() + grid.num<Quadrilateral>(),
+				  "GridWriterUGXB: Grids with constrained or constraining elements "
+				  "(hanging nodes) can't be written to ugxb files. Please use ugx instead.");
+
+	grid.attach_to_vertices(m_aInt);
+	grid.attach_to_edges(m_aInt);
+	grid.attach_to_faces(m_aInt);
+	grid.attach_to_volumes(m_aInt);
+
+	Grid::VertexAttachmentAccessor<AInt> aaIndVRT(grid, m_aInt);
+	Grid::EdgeAttachmentAccessor<AInt> aaIndEDGE(grid, m_aInt);
+	Grid::FaceAttachmentAccessor<AInt> aaIndFACE(grid, m_aInt);
+	Grid::VolumeAttachmentAccessor<AInt> aaIndVOL(grid, m_aInt);
+
+//	the indices have to match the order of the element blocks written in add_grid
+	AssignIndices(grid.begin<RegularVertex>(), grid.end<RegularVertex>(), aaIndVRT, 0);
+	AssignIndices(grid.begin<RegularEdge>(), grid.end<RegularEdge>(), aaIndEDGE, 0);
+
+	int baseInd = 0;
+	AssignIndices(grid.begin<Triangle>(), grid.end<Triangle>(), aaIndFACE, baseInd);
+	baseInd += grid.num<Triangle>();
+	AssignIndices(grid.begin<Quadrilateral>(), grid.end<Quadrilateral>(), aaIndFACE, baseInd);
+
+	baseInd = 0;
+	AssignIndices(grid.begin<Tetrahedron>(), grid.end<Tetrahedron>(), aaIndVOL, baseInd);
+	baseInd += grid.num<Tetrahedron>();
+	AssignIndices(grid.begin<Hexahedron>(), grid.end<Hexahedron>(), aaIndVOL, baseInd);
+	baseInd += grid.num<Hexahedron>();
+	AssignIndices(grid.begin<Prism>(), grid.end<Prism>(), aaIndVOL, baseInd);
+	baseInd += grid.num<Prism>();
+	AssignIndices(grid.begin<Pyramid>(), grid.end<Pyramid>(), aaIndVOL, baseInd);
+	baseInd += grid.num<Pyramid>();
+	AssignIndices(grid.begin<Octahedron>(), grid.end<Octahedron>(), aaIndVOL, baseInd);
+}
+
+void GridWriterUGXB::
+add_subset_handler(ISubsetHandler& sh, const char* name,
+				   size_t refGridIndex)
+{
+	if(refGridIndex >= m_vEntries.size()){
+		UG_LOG("GridWriterUGXB::add_subset_handler: bad refGridIndex. Aborting.\n");
+		return;
+	}
+
+	Entry& entry = m_vEntries[refGridIndex];
+	const int shIndex = (int)entry.subsetHandlers.size();
+	const int gridIndex = (int)refGridIndex;
+	entry.subsetHandlers.push_back(&sh);
+
+	Block& shBlock = new_block(UGXB_SUBSET_HANDLER, gridIndex, name);
+	shBlock.info.owner = shIndex;
+	shBlock.info.count = sh.num_subsets();
+
+	for(int i = 0; i < sh.num_subsets(); ++i){
+		const SubsetInfo& si = sh.subset_info(i);
+		Block& b = new_block(UGXB_SUBSET, gridIndex, si.name.c_str());
+		b.info.valueType = UGXB_FLOAT64;
+		b.info.owner = shIndex;
+		b.info.index = i;
+		b.info.tupleSize = 5;
+		b.info.count = 1;
+		b.data.resize(5 * sizeof(double));
+		double* p = reinterpret_cast<double*>(&b.data.front());
+		for(size_t j = 0; j < 4; ++j)
+			p[j] = si.color[j];
+		p[4] = si.subsetState;
+
+		if(sh.contains_vertices(i))
+			add_subset_elements<Vertex>(sh, shIndex, i, gridIndex);
+		if(sh.contains_edges(i))
+			add_subset_elements<Edge>(sh, shIndex, i, gridIndex);
+		if(sh.contains_faces(i))
+			add_subset_elements<Face>(sh, shIndex, i, gridIndex);
+		if(sh.contains_volumes(i))
+			add_subset_elements<Volume>(sh, shIndex, i, gridIndex);
+	}
+}
+
+void GridWriterUGXB::
+add_selector(ISelector& sel, const char* name, size_t refGridIndex)
+{
+	if(refGridIndex >= m_vEntries.size()){
+		UG_LOG("GridWriterUGXB::add_selector: bad refGridIndex. Aborting.\n");
+		return;
+	}
+
+	Entry& entry = m_vEntries[refGridIndex];
+	const int selIndex = entry.numSelectors++;
+	const int gridIndex = (int)refGridIndex;
+
+	Block& selBlock = new_block(UGXB_SELECTOR, gridIndex, name);
+	selBlock.info.owner = selIndex;
+
+	if(sel.contains_vertices())
+		add_selector_elements<Vertex>(sel, selIndex, gridIndex);
+	if(sel.contains_edges())
+		add_selector_elements<Edge>(sel, selIndex, gridIndex);
+	if(sel.contains_faces())
+		add_selector_elements<Face>(sel, selIndex, gridIndex);
+	if(sel.contains_volumes())
+		add_selector_elements<Volume>(sel, selIndex, gridIndex);
+}
+
+void GridWriterUGXB::
+add_projector(RefinementProjector& proj, int phIndex, int si,
+			  bool isDefault, int gridIndex)
+{
+	static Factory<RefinementProjector, ProjectorTypes>	projFac;
+	static Archivar<boost::archive::text_oarchive, RefinementProjector, ProjectorTypes>	archivar;
+
+	stringstream ss;
+	boost::archive::text_oarchive ar(ss, boost::archive::no_header);
+	archivar.archive(ar, proj);
+	const string str = ss.str();
+
+	Block& b = new_block(UGXB_PROJECTOR, gridIndex);
+	b.infoStr = projFac.class_name(proj);
+	b.info.owner = phIndex;
+	b.info.index = si;
+	b.info.objType = isDefault ? 1 : 0;
+	b.info.tupleSize = 1;
+	b.info.count = str.size();
+	b.data.assign(str.begin(), str.end());
+}
+
+void GridWriterUGXB::
+add_projection_handler(ProjectionHandler& ph, const char* name, size_t refGridIndex)
+{
+	if(refGridIndex >= m_vEntries.size()){
+		UG_LOG("GridWriterUGXB::add_projection_handler: bad refGridIndex. Aborting.\n");
+		return;
+	}
+
+	Entry& entry = m_vEntries[refGridIndex];
+	const int phIndex = entry.numProjectionHandlers++;
+	const int gridIndex = (int)refGridIndex;
+
+//	find subset handler index in subset handler array
+	size_t shIndex = 0;
+	const size_t nSH = entry.subsetHandlers.size();
+	for(; shIndex < nSH; ++shIndex)
+		if(entry.subsetHandlers[shIndex] == ph.subset_handler())
+			break;
+
+	UG_COND_THROW(shIndex == nSH, "ERROR in 'GridWriterUGXB::add_projection_handler': "
+		"No matching SubsetHandler could be found.\n"
+		"Please make sure to add the associated SubsetHandler before adding a ProjectionHandler");
+
+	Block& phBlock = new_block(UGXB_PROJECTION_HANDLER, gridIndex, name);
+	phBlock.info.owner = phIndex;
+	phBlock.info.index = (int32)shIndex;
+
+	if(ph.default_projector().valid())
+		add_projector(*ph.default_projector(), phIndex, -1, true, gridIndex);
+
+	for(int i = -1; i < (int)ph.num_projectors(); ++i){
+		if(!ph.projector(i).valid())
+			continue;
+		add_projector(*ph.projector(i), phIndex, i, false, gridIndex);
+	}
+}
+
+bool GridWriterUGXB::
+write_to_file(const char* filename)
+{
+	ofstream out(filename, ios::out | ios::binary);
+	if(!out){
+		UG_LOG("GridWriterUGXB::write_to_file: Can't open file " << filename << "\n");
+		return false;
+	}
+
+	UGXBHeader header;
+	memset(&header, 0, sizeof(UGXBHeader));
+	memcpy(header.magic, UGXB_MAGIC, 4);
+	header.version = UGXB_VERSION;
+	header.byteOrder = UGXB_BYTE_ORDER;
+	header.numBlocks = (uint32)m_blocks.size();
+
+//	the header is rewritten once all offsets are known
+	out.write(reinterpret_cast<const char*>(&header), sizeof(UGXBHeader));
+
+	const char padding[UGXB_ALIGNMENT] = {0};
+	uint64 pos = sizeof(UGXBHeader);
+
+	vector<UGXBBlockInfo> index(m_blocks.size());
+	string strings;
+
+	for(size_t i = 0; i < m_blocks.size(); ++i){
+		Block& b = m_blocks[i];
+		UGXBBlockInfo& info = index[i];
+		info = b.info;
+
+	//	names are zero terminated, so that they can be returned as c-strings
+		info.nameOffset = strings.size();
+		info.nameLength = (uint32)b.name.size();
+		strings.append(b.name);
+		strings.push_back(0);
+		info.infoOffset = strings.size();
+		info.infoLength = (uint32)b.infoStr.size();
+		strings.append(b.infoStr);
+		strings.push_back(0);
+
+		const uint64 offset = AlignUGXB(pos);
+		out.write(padding, offset - pos);
+		info.offset = offset;
+		info.size = b.data.size();
+		if(!b.data.empty())
+			out.write(&b.data.front(), b.data.size());
+		pos = offset + b.data.size();
+	}
+
+	header.stringsOffset = AlignUGXB(pos);
+	header.stringsSize = strings.size();
+	out.write(padding, header.stringsOffset - pos);
+	out.write(strings.c_str(), strings.size());
+	pos = header.stringsOffset + strings.size();
+
+	header.indexOffset = AlignUGXB(pos);
+	out.write(padding, header.indexOffset - pos);
+	if(!index.empty())
+		out.write(reinterpret_cast<const char*>(&index.front()),
+				  index.size() * sizeof(UGXBBlockInfo));
+
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(UGXBHeader));
+
+	if(!out){
+		UG_LOG("GridWriterUGXB::write_to_file: Failed to write file " << filename << "\n");
+		return false;
+	}
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	implementation of GridReaderUGXB
+GridReaderUGXB::GridReaderUGXB() :
+	m_data(NULL),
+	m_size(0),
+	m_bMapped(false),
+	m_blockInfos(NULL),
+	m_numBlocks(0),
+	m_strings(NULL)
+{
+}
+
+GridReaderUGXB::~GridReaderUGXB()
+{
+	close_file();
+}
+
+bool GridReaderUGXB::
+open_file(const char* filename)
+{
+	close_file();
+
+#ifdef UG_POSIX
+	int fd = open(filename, O_RDONLY);
+	if(fd < 0){
+		UG_LOG("GridReaderUGXB::open_file: Can't open file " << filename << "\n");
+		return false;
+	}
+
+	struct stat st;
+	if(fstat(fd, &st) != 0 || st.st_size == 0){
+		::close(fd);
+		UG_LOG("GridReaderUGXB::open_file: Can't access file " << filename << "\n");
+		return false;
+	}
+
+	void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if(p == MAP_FAILED){
+		UG_LOG("GridReaderUGXB::open_file: Can't map file " << filename << "\n");
+		return false;
+	}
+
+	m_data = static_cast<const char*>(p);
+	m_size = st.st_size;
+	m_bMapped = true;
+#else
+	ifstream in(filename, ios::in | ios::binary);
+	if(!in){
+		UG_LOG("GridReaderUGXB::open_file: Can't open file " << filename << "\n");
+		return false;
+	}
+
+	in.seekg(0, ios::end);
+	m_buffer.resize(in.tellg());
+	in.seekg(0, ios::beg);
+	if(!m_buffer.empty())
+		in.read(&m_buffer.front(), m_buffer.size());
+	if(!in || m_buffer.empty()){
+		UG_LOG("GridReaderUGXB::open_file: Can't read file " << filename << "\n");
+		return false;
+	}
+
+	m_data = &m_buffer.front();
+	m_size = m_buffer.size();
+#endif
+
+//	check the header
+	const UGXBHeader* header = reinterpret_cast<const UGXBHeader*>(m_data);
+	if(m_size < sizeof(UGXBHeader) || memcmp(header->magic, UGXB_MAGIC, 4) != 0){
+		UG_LOG("GridReaderUGXB::open_file: " << filename << " is not a ugxb file.\n");
+		close_file();
+		return false;
+	}
+
+	if(header->byteOrder != UGXB_BYTE_ORDER){
+		UG_LOG("GridReaderUGXB::open_file: " << filename << " was written with "
+			   "a different byte order. This is not supported.\n");
+		close_file();
+		return false;
+	}
+
+	if(header->version > UGXB_VERSION){
+		UG_LOG("GridReaderUGXB::open_file: unsupported ugxb version "
+			   << header->version << " in " << filename << "\n");
+		close_file();
+		return false;
+	}
+
+	if(!RangeFitsUGXB(header->indexOffset, 0, m_size)
+		|| !EntriesFitUGXB(header->numBlocks, sizeof(UGXBBlockInfo), m_size - header->indexOffset)
+		|| !RangeFitsUGXB(header->stringsOffset, header->stringsSize, m_size))
+	{
+		UG_LOG("GridReaderUGXB::open_file: " << filename << " is truncated.\n");
+		close_file();
+		return false;
+	}
+
+	m_blockInfos = reinterpret_cast<const UGXBBlockInfo*>(m_data + header->indexOffset);
+	m_numBlocks = header->numBlocks;
+	m_strings = m_data + header->stringsOffset;
+
+	for(size_t i = 0; i < m_numBlocks; ++i){
+		const UGXBBlockInfo& info = m_blockInfos[i];
+		if(!RangeFitsUGXB(info.offset, info.size, m_size)
+			|| !RangeFitsUGXB(info.nameOffset, (uint64)info.nameLength + 1, header->stringsSize)
+			|| !RangeFitsUGXB(info.infoOffset, (uint64)info.infoLength + 1, header->stringsSize))
+		{
+			UG_LOG("GridReaderUGXB::open_file: Bad block " << i << " in " << filename << "\n");
+			close_file();
+			return false;
+		}
+	}
+
+	if(!init_entries()){
+		close_file();
+		return false;
+	}
+
+	return true;
+}
+
+void GridReaderUGXB::
+close_file()
+{
+#ifdef UG_POSIX
+	if(m_bMapped)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+	m_data = NULL;
+	m_size = 0;
+	m_bMapped = false;
+	m_buffer.clear();
+	m_blockInfos = NULL;
+	m_numBlocks = 0;
+	m_strings = NULL;
+	m_entries.clear();
+}
+
+bool GridReaderUGXB::
+init_entries()
+{
+	m_entries.clear();
+	for(size_t i = 0; i < m_numBlocks; ++i){
+		if(m_blockInfos[i].type == UGXB_GRID)
+			m_entries.push_back(GridEntry(i));
+	}
+
+	for(size_t i = 0; i < m_numBlocks; ++i){
+		const UGXBBlockInfo& info = m_blockInfos[i];
+		if(info.type == UGXB_GRID)
+			continue;
+
+		if(info.grid < 0 || info.grid >= (int)m_entries.size()){
+			UG_LOG("GridReaderUGXB: Bad grid index in block " << i << "\n");
+			return false;
+		}
+
+		GridEntry& ge = m_entries[info.grid];
+		switch(info.type){
+			case UGXB_VERTICES:
+				if(!EntriesFitUGXB(info.count, (uint64)info.tupleSize * sizeof(double), info.size)){
+					UG_LOG("GridReaderUGXB: Bad vertex block " << i << "\n");
+					return false;
+				}
+				ge.vertexBlocks.push_back(i);
+				break;
+			case UGXB_ELEMENTS:
+				if(info.objType < EDGE || info.objType > VOLUME
+					|| !EntriesFitUGXB(info.count, (uint64)info.tupleSize * sizeof(int32), info.size))
+				{
+					UG_LOG("GridReaderUGXB: Bad element block " << i << "\n");
+					return false;
+				}
+				ge.elementBlocks[info.objType].push_back(i);
+				break;
+			case UGXB_ATTACHMENT:
+				if(info.objType < VERTEX || info.objType > VOLUME
+					|| info.count >= info.size / sizeof(uint64))
+				{
+					UG_LOG("GridReaderUGXB: Bad attachment block " << i << "\n");
+					return false;
+				}
+				ge.attachmentBlocks.push_back(i);
+				break;
+			case UGXB_SUBSET_HANDLER:
+				ge.subsetHandlerBlocks.push_back(i);
+				break;
+			case UGXB_SUBSET_ELEMENTS:
+				if(!EntriesFitUGXB(info.count, sizeof(int32), info.size)){
+					UG_LOG("GridReaderUGXB: Bad subset block " << i << "\n");
+					return false;
+				}
+				break;
+			case UGXB_SELECTOR_ELEMENTS:
+				if(!EntriesFitUGXB(info.count, 2 * sizeof(int32), info.size)){
+					UG_LOG("GridReaderUGXB: Bad selector block " << i << "\n");
+					return false;
+				}
+				break;
+			case UGXB_SELECTOR:
+				ge.selectorBlocks.push_back(i);
+				break;
+			case UGXB_PROJECTION_HANDLER:
+				ge.projectionHandlerBlocks.push_back(i);
+				break;
+			default:
+			//	all other blocks are referenced through their owners
+				break;
+		}
+	}
+
+	return true;
+}
+
+std::string GridReaderUGXB::
+block_name(size_t i) const
+{
+	return std::string(m_strings + m_blockInfos[i].nameOffset,
+					   m_blockInfos[i].nameLength);
+}
+
+std::string GridReaderUGXB::
+block_info_string(size_t i) const
+{
+	return std::string(m_strings + m_blockInfos[i].infoOffset,
+					   m_blockInfos[i].infoLength);
+}
+
+const GridReaderUGXB::GridEntry& GridReaderUGXB::
+grid_entry(size_t refGridIndex) const
+{
+	UG_COND_THROW(refGridIndex >= m_entries.size(),
+				  "Bad refGridIndex: " << refGridIndex);
+	return m_entries[refGridIndex];
+}
+
+const char* GridReaderUGXB::
+get_grid_name(size_t index) const
+{
+	return m_strings + block_info(grid_entry(index).block).nameOffset;
+}
+
+size_t GridReaderUGXB::
+grid_world_dimension(size_t index) const
+{
+	return block_info(grid_entry(index).block).index;
+}
+
+GridObject* GridReaderUGXB::
+create_element(Grid& grid, int roid, Vertex** c)
+{
+	switch(roid){
+		case ROID_EDGE:
+			return *grid.create<RegularEdge>(EdgeDescriptor(c[0], c[1]));
+		case ROID_TRIANGLE:
+			return *grid.create<Triangle>(TriangleDescriptor(c[0], c[1], c[2]));
+		case ROID_QUADRILATERAL:
+			return *grid.create<Quadrilateral>(
+						QuadrilateralDescriptor(c[0], c[1], c[2], c[3]));
+		case ROID_TETRAHEDRON:
+			return *grid.create<Tetrahedron>(
+						TetrahedronDescriptor(c[0], c[1], c[2], c[3]));
+		case ROID_HEXAHEDRON:
+			return *grid.create<Hexahedron>(
+						HexahedronDescriptor(c[0], c[1], c[2], c[3],
+											 c[4], c[5], c[6], c[7]));
+		case ROID_PRISM:
+			return *grid.create<Prism>(
+						PrismDescriptor(c[0], c[1], c[2], c[3], c[4], c[5]));
+		case ROID_PYRAMID:
+			return *grid.create<Pyramid>(
+						PyramidDescriptor(c[0], c[1], c[2], c[3], c[4]));
+		case ROID_OCTAHEDRON:
+			return *grid.create<Octahedron>(
+						OctahedronDescriptor(c[0], c[1], c[2], c[3], c[4], c[5]));
+		default:
+			UG_THROW("GridReaderUGXB: Unsupported element type in element block: " << roid);
+	}
+	return NULL;
+}
+
+void GridReaderUGXB::
+select_part(GridEntry& ge, int part, int numParts,
+			std::vector<char> elemMasks[4])
+{
+	size_t numVrts = 0;
+	for(size_t i = 0; i < ge.vertexBlocks.size(); ++i)
+		numVrts += block_info(ge.vertexBlocks[i]).count;
+
+	size_t numElems[4] = {numVrts, 0, 0, 0};
+	int topDim = 0;
+	for(int d = 1; d < 4; ++d){
+		for(size_t i = 0; i < ge.elementBlocks[d].size(); ++i)
+			numElems[d] += block_info(ge.elementBlocks[d][i]).count;
+		if(numElems[d] > 0)
+			topDim = d;
+	}
+
+//	the elements of highest dimension are split into contiguous ranges
+	const uint64 n = numElems[topDim];
+	const uint64 first = n * part / numParts;
+	const uint64 last = n * (part + 1) / numParts;
+
+	for(int d = 0; d <= topDim; ++d)
+		elemMasks[d].assign(numElems[d], 0);
+
+	for(uint64 i = first; i < last; ++i)
+		elemMasks[topDim][i] = 1;
+
+	if(topDim == 0)
+		return;
+
+//	collect the corners of the loaded elements and mark their vertices
+	vector<const int32*> topCorners;
+	vector<int> topNumCorners;
+	size_t elemInd = 0;
+	for(size_t ib = 0; ib < ge.elementBlocks[topDim].size(); ++ib){
+		const size_t b = ge.elementBlocks[topDim][ib];
+		const UGXBBlockInfo& info = block_info(b);
+		const int32* p = reinterpret_cast<const int32*>(block_data(b));
+		for(uint64 i = 0; i < info.count; ++i, ++elemInd, p += info.tupleSize){
+			if(!elemMasks[topDim][elemInd])
+				continue;
+			topCorners.push_back(p);
+			topNumCorners.push_back(info.tupleSize);
+			for(size_t j = 0; j < info.tupleSize; ++j){
+				UG_COND_THROW(p[j] < 0 || p[j] >= (int32)numVrts,
+							  "GridReaderUGXB: Bad vertex index in element block: " << p[j]);
+				elemMasks[VERTEX][p[j]] = 1;
+			}
+		}
+	}
+
+//	vertex to loaded element adjacency (compressed row storage)
+	vector<size_t> vrtOffsets(numVrts + 1, 0);
+	for(size_t i = 0; i < topCorners.size(); ++i)
+		for(int j = 0; j < topNumCorners[i]; ++j)
+			++vrtOffsets[topCorners[i][j] + 1];
+	for(size_t i = 0; i < numVrts; ++i)
+		vrtOffsets[i + 1] += vrtOffsets[i];
+
+	vector<size_t> vrtElems(vrtOffsets.back());
+	vector<size_t> fill(vrtOffsets.begin(), vrtOffsets.end() - 1);
+	for(size_t i = 0; i < topCorners.size(); ++i)
+		for(int j = 0; j < topNumCorners[i]; ++j)
+			vrtElems[fill[topCorners[i][j]]++] = i;
+
+//	lower dimensional elements are loaded, if they are sides of loaded elements
+	for(int d = 1; d < topDim; ++d){
+		elemInd = 0;
+		for(size_t ib = 0; ib < ge.elementBlocks[d].size(); ++ib){
+			const size_t b = ge.elementBlocks[d][ib];
+			const UGXBBlockInfo& info = block_info(b);
+			const int32* p = reinterpret_cast<const int32*>(block_data(b));
+			for(uint64 i = 0; i < info.count; ++i, ++elemInd, p += info.tupleSize){
+				bool allCornersLoaded = true;
+				for(size_t j = 0; j < info.tupleSize; ++j){
+					UG_COND_THROW(p[j] < 0 || p[j] >= (int32)numVrts,
+								  "GridReaderUGXB: Bad vertex index in element block: " << p[j]);
+					if(!elemMasks[VERTEX][p[j]]){
+						allCornersLoaded = false;
+						break;
+					}
+				}
+
+				if(!allCornersLoaded)
+					continue;
+
+				for(size_t k = vrtOffsets[p[0]]; k < vrtOffsets[p[0] + 1]; ++k){
+					const int32* tc = topCorners[vrtElems[k]];
+					const int32* tcEnd = tc + topNumCorners[vrtElems[k]];
+					size_t j = 1;
+					for(; j < info.tupleSize; ++j)
+						if(find(tc, tcEnd, p[j]) == tcEnd)
+							break;
+					if(j == info.tupleSize){
+						elemMasks[d][elemInd] = 1;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+void GridReaderUGXB::
+read_attachments(GridEntry& ge, Grid& grid)
+{
+	for(size_t i = 0; i < ge.attachmentBlocks.size(); ++i){
+		const size_t b = ge.attachmentBlocks[i];
+		switch(block_info(b).objType){
+			case VERTEX:	read_attachment<Vertex>(grid, b, ge.vertices); break;
+			case EDGE:		read_attachment<Edge>(grid, b, ge.edges); break;
+			case FACE:		read_attachment<Face>(grid, b, ge.faces); break;
+			case VOLUME:	read_attachment<Volume>(grid, b, ge.volumes); break;
+		}
+	}
+}
+
+size_t GridReaderUGXB::
+num_subset_handlers(size_t refGridIndex) const
+{
+	return grid_entry(refGridIndex).subsetHandlerBlocks.size();
+}
+
+const char* GridReaderUGXB::
+get_subset_handler_name(size_t refGridIndex, size_t subsetHandlerIndex) const
+{
+	const GridEntry& ge = grid_entry(refGridIndex);
+	UG_COND_THROW(subsetHandlerIndex >= ge.subsetHandlerBlocks.size(),
+				  "Bad subsetHandlerIndex: " << subsetHandlerIndex);
+	return m_strings + block_info(ge.subsetHandlerBlocks[subsetHandlerIndex]).nameOffset;
+}
+
+bool GridReaderUGXB::
+subset_handler(ISubsetHandler& shOut, size_t subsetHandlerIndex,
+			   size_t refGridIndex)
+{
+	if(refGridIndex >= m_entries.size()){
+		UG_LOG("GridReaderUGXB::subset_handler: bad refGridIndex. Aborting.\n");
+		return false;
+	}
+
+	GridEntry& ge = m_entries[refGridIndex];
+	if(subsetHandlerIndex >= ge.subsetHandlerBlocks.size()){
+		UG_LOG("GridReaderUGXB::subset_handler: bad subsetHandlerIndex. Aborting.\n");
+		return false;
+	}
+
+	const int shIndex = block_info(ge.subsetHandlerBlocks[subsetHandlerIndex]).owner;
+
+//	subsets and their elements follow the subset handler block
+	for(size_t i = ge.subsetHandlerBlocks[subsetHandlerIndex] + 1; i < m_numBlocks; ++i){
+		const UGXBBlockInfo& info = block_info(i);
+		if(info.grid != (int)refGridIndex || info.owner != shIndex)
+			continue;
+
+		if(info.type == UGXB_SUBSET){
+		//	retrieve an initial subset-info from shOut, so that initialised values are kept.
+			SubsetInfo si = shOut.subset_info(info.index);
+			si.name = block_name(i);
+			if(info.size >= 5 * sizeof(double)){
+				const double* p = reinterpret_cast<const double*>(block_data(i));
+				for(size_t j = 0; j < 4; ++j)
+					si.color[j] = p[j];
+				si.subsetState = (uint)p[4];
+			}
+			shOut.set_subset_info(info.index, si);
+		}
+		else if(info.type == UGXB_SUBSET_ELEMENTS){
+			switch(info.objType){
+				case VERTEX:
+					if(shOut.elements_are_supported(SHE_VERTEX))
+						read_subset_elements<Vertex>(shOut, i, info.index, ge.vertices);
+					break;
+				case EDGE:
+					if(shOut.elements_are_supported(SHE_EDGE))
+						read_subset_elements<Edge>(shOut, i, info.index, ge.edges);
+					break;
+				case FACE:
+					if(shOut.elements_are_supported(SHE_FACE))
+						read_subset_elements<Face>(shOut, i, info.index, ge.faces);
+					break;
+				case VOLUME:
+					if(shOut.elements_are_supported(SHE_VOLUME))
+						read_subset_elements<Volume>(shOut, i, info.index, ge.volumes);
+					break;
+			}
+		}
+	}
+
+	return true;
+}
+
+size_t GridReaderUGXB::
+num_selectors(size_t refGridIndex) const
+{
+	return grid_entry(refGridIndex).selectorBlocks.size();
+}
+
+const char* GridReaderUGXB::
+get_selector_name(size_t refGridIndex, size_t selectorIndex) const
+{
+	const GridEntry& ge = grid_entry(refGridIndex);
+	UG_COND_THROW(selectorIndex >= ge.selectorBlocks.size(),
+				  "Bad selectorIndex: " << selectorIndex);
+	return m_strings + block_info(ge.selectorBlocks[selectorIndex]).nameOffset;
+}
+
+bool GridReaderUGXB::
+selector(ISelector& selOut, size_t selectorIndex, size_t refGridIndex)
+{
+	if(refGridIndex >= m_entries.size()){
+		UG_LOG("GridReaderUGXB::selector: bad refGridIndex. Aborting.\n");
+		return false;
+	}
+
+	GridEntry& ge = m_entries[refGridIndex];
+	if(selectorIndex >= ge.selectorBlocks.size()){
+		UG_LOG("GridReaderUGXB::selector: bad selectorIndex. Aborting.\n");
+		return false;
+	}
+
+	const int selIndex = block_info(ge.selectorBlocks[selectorIndex]).owner;
+
+	for(size_t i = ge.selectorBlocks[selectorIndex] + 1; i < m_numBlocks; ++i){
+		const UGXBBlockInfo& info = block_info(i);
+		if(info.grid != (int)refGridIndex || info.owner != selIndex)
+			continue;
+
+		if(info.type == UGXB_SELECTOR_ELEMENTS){
+			switch(info.objType){
+				case VERTEX:
+					if(selOut.elements_are_supported(SE_VERTEX))
+						read_selector_elements<Vertex>(selOut, i, ge.vertices);
+					break;
+				case EDGE:
+					if(selOut.elements_are_supported(SE_EDGE))
+						read_selector_elements<Edge>(selOut, i, ge.edges);
+					break;
+				case FACE:
+					if(selOut.elements_are_supported(SE_FACE))
+						read_selector_elements<Face>(selOut, i, ge.faces);
+					break;
+				case VOLUME:
+					if(selOut.elements_are_supported(SE_VOLUME))
+						read_selector_elements<Volume>(selOut, i, ge.volumes);
+					break;
+			}
+		}
+	}
+
+	return true;
+}
+
+size_t GridReaderUGXB::
+num_projection_handlers(size_t refGridIndex) const
+{
+	return grid_entry(refGridIndex).projectionHandlerBlocks.size();
+}
+
+const char* GridReaderUGXB::
+get_projection_handler_name(size_t refGridIndex, size_t phIndex) const
+{
+	const GridEntry& ge = grid_entry(refGridIndex);
+	UG_COND_THROW(phIndex >= ge.projectionHandlerBlocks.size(),
+				  "Bad projection-handler-index: " << phIndex);
+	return m_strings + block_info(ge.projectionHandlerBlocks[phIndex]).nameOffset;
+}
+
+size_t GridReaderUGXB::
+get_projection_handler_subset_handler_index(size_t phIndex, size_t refGridIndex)
+{
+	const GridEntry& ge = grid_entry(refGridIndex);
+	UG_COND_THROW(phIndex >= ge.projectionHandlerBlocks.size(),
+				  "Bad projection-handler-index: " << phIndex);
+	return block_info(ge.projectionHandlerBlocks[phIndex]).index;
+}
+
+SPRefinementProjector GridReaderUGXB::
+read_projector(size_t block)
+{
+	static Factory<RefinementProjector, ProjectorTypes>	projFac;
+	static Archivar<boost::archive::text_iarchive, RefinementProjector, ProjectorTypes>	archivar;
+
+	const string type = block_info_string(block);
+	try {
+		SPRefinementProjector proj = projFac.create(type);
+
+		string str(block_data(block), block_info(block).size);
+		stringstream ss(str, ios_base::in);
+		boost::archive::text_iarchive ar(ss, boost::archive::no_header);
+		archivar.archive(ar, *proj);
+		return proj;
+	}
+	catch(boost::archive::archive_exception& e){
+		UG_LOG("WARNING: Couldn't read projector of type '" << type << "'." << std::endl);
+	}
+	return SPRefinementProjector();
+}
+
+bool GridReaderUGXB::
+projection_handler(ProjectionHandler& phOut, size_t phIndex, size_t refGridIndex)
+{
+	const GridEntry& ge = grid_entry(refGridIndex);
+	UG_COND_THROW(phIndex >= ge.projectionHandlerBlocks.size(),
+				  "Bad projection-handler-index: " << phIndex);
+
+	const int owner = block_info(ge.projectionHandlerBlocks[phIndex]).owner;
+
+	for(size_t i = ge.projectionHandlerBlocks[phIndex] + 1; i < m_numBlocks; ++i){
+		const UGXBBlockInfo& info = block_info(i);
+		if(info.grid != (int)refGridIndex || info.owner != owner)
+			continue;
+
+		if(info.type == UGXB_PROJECTOR){
+			SPRefinementProjector proj = read_projector(i);
+			if(!proj.valid())
+				continue;
+
+			if(info.objType == 1)
+				phOut.set_default_projector(proj);
+			else
+				phOut.set_projector(info.index, proj);
+		}
+	}
+
+	return true;
+}
+
+}//	end of namespace
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_UGXB__
+#define __H__LIB_GRID__FILE_IO_UGXB__
+
+#include <vector>
+#include <string>
+#include "common/types.h"
+#include "lib_grid/grid/grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+#include "lib_grid/tools/selector_interface.h"
+#include "lib_grid/common_attachments.h"
+#include "lib_grid/refinement/projectors/projection_handler.h"
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+//	UGXB file layout
+/**	\defgroup lib_grid_file_io_ugxb ugxb
+ * \ingroup lib_grid
+ *
+ * The binary ugx variant stores the same data as a ugx file (grids, subset
+ * handlers, selectors, projection handlers and global attachments) in typed
+ * blocks. The file starts with a UGXBHeader, which points to an index of
+ * UGXBBlockInfo entries and to a string table holding all names. Each block
+ * starts at an offset aligned to UGXB_ALIGNMENT, so that a memory mapped file
+ * can be accessed directly through pointers to int32 or float64 arrays.
+ *
+ * Vertices are numbered in the order of their block, edges, faces and volumes
+ * in the order of their element blocks (i.e. per base object type the
+ * element blocks are concatenated). Subset, selector and attachment blocks
+ * refer to those indices.
+ *
+ * Files are written in the byte order of the writing machine. Reading a file
+ * with a different byte order is not supported.
+ * \{ */
+
+///	alignment of blocks in ugxb files (in bytes)
+const uint64 UGXB_ALIGNMENT = 64;
+
+///	current version of the ugxb format
+const uint32 UGXB_VERSION = 1;
+
+enum UGXBBlockType{
+	UGXB_GRID = 1,				///< index: position dimension
+	UGXB_VERTICES,				///< float64, tupleSize: position dimension
+	UGXB_ELEMENTS,				///< int32 corner indices, index: ReferenceObjectID
+	UGXB_SUBSET_HANDLER,		///< owner: subset handler, count: number of subsets
+	UGXB_SUBSET,				///< owner, index: subset, data: color[4] (float64), state
+	UGXB_SUBSET_ELEMENTS,		///< int32, owner, index: subset, objType
+	UGXB_SELECTOR,				///< owner: selector
+	UGXB_SELECTOR_ELEMENTS,		///< int32 (element, status), owner, objType
+	UGXB_PROJECTION_HANDLER,	///< owner: projection handler, index: subset handler
+	UGXB_PROJECTOR,				///< text archive, owner, index: subset, objType: 1 for default, info: type
+	UGXB_ATTACHMENT				///< serialized values, objType, index: pass-on, info: type
+};
+
+enum UGXBValueType{
+	UGXB_BYTE = 0,
+	UGXB_INT32,
+	UGXB_FLOAT64,
+	UGXB_UINT64
+};
+
+///	header at the beginning of each ugxb file
+struct UGXBHeader{
+	char	magic[4];		///< "UGXB"
+	uint32	version;
+	uint32	byteOrder;		///< 0x01020304 in the byte order of the writer
+	uint32	numBlocks;
+	uint64	indexOffset;	///< offset of the UGXBBlockInfo array
+	uint64	stringsOffset;	///< offset of the string table
+	uint64	stringsSize;
+	uint64	reserved;
+};
+
+///	entry of the block index of a ugxb file
+struct UGXBBlockInfo{
+	uint32	type;			///< UGXBBlockType
+	uint32	valueType;		///< UGXBValueType
+	int32	grid;			///< index of the grid the block belongs to
+	int32	owner;			///< index of the owning subset handler, selector or projection handler
+	int32	index;			///< block-type specific index (see UGXBBlockType)
+	int32	objType;		///< base object type or block-type specific flag
+	uint32	tupleSize;		///< number of values per entry
+	uint32	nameLength;
+	uint64	count;			///< number of entries
+	uint64	offset;			///< offset of the data from the beginning of the file
+	uint64	size;			///< size of the data in bytes
+	uint64	nameOffset;		///< offset of the name in the string table
+	uint64	infoOffset;		///< offset of an additional string in the string table
+	uint32	infoLength;
+	uint32	reserved;
+};
+
+/** \} */
+
+
+////////////////////////////////////////////////////////////////////////
+///	Writes a grid together with a subset handler to a ugxb file.
+template <class TAPosition>
+bool SaveGridToUGXB(Grid& grid, ISubsetHandler& sh,
+					const char* filename, TAPosition& aPos);
+
+///	Writes a grid to a ugxb file using the standard position attachment of highest dimension
+bool SaveGridToUGXB(Grid& grid, ISubsetHandler& sh, const char* filename);
+
+///	Reads the first grid and subset handler of a ugxb file.
+template <class TAPosition>
+bool LoadGridFromUGXB(Grid& grid, ISubsetHandler& sh,
+					  const char* filename, TAPosition& aPos);
+
+///	Reads the first grid, subset handlers and projection handler of a ugxb file.
+/**	Behaves like the corresponding LoadGridFromUGX overload.*/
+template <class TAPosition>
+bool LoadGridFromUGXB(Grid& grid, SPProjectionHandler& ph, size_t& num_ph,
+					  ISubsetHandler& sh, std::vector<std::string> additionalSHNames,
+					  std::vector<SmartPtr<ISubsetHandler> > ash,
+					  const char* filename, TAPosition& aPos);
+
+///	Reads a ugxb file using the standard position attachment of highest dimension
+/**	If no standard attachment is found, aPosition will be attached and used.*/
+bool LoadGridFromUGXB(Grid& grid, ISubsetHandler& sh, const char* filename);
+
+///	Reads the part-th of numParts parts of the first grid of a ugxb file.
+/**	The elements of highest dimension are split into numParts contiguous
+ * ranges (with respect to their order in the file). Only the elements of the
+ * given range, their vertices and the lower dimensional elements which are
+ * sides of loaded elements are created. Since sides are identified through
+ * their corners, the grid has to be conforming. Subsets and global
+ * attachments are restricted to the loaded elements.
+ *
+ * If the grid was sorted along a space filling curve before it was written
+ * (see SortGridElementsBySFC), each part is a compact piece of the domain.
+ *
+ * \note	No parallel interfaces are created. Vertices and sides shared by
+ *			several parts are duplicated in each of them, the loaded parts are
+ *			independent serial grids. In parallel runs they have to be
+ *			connected by the caller (e.g. by a redistribution of a grid
+ *			loaded on one process) before they can be used in a distributed
+ *			discretization.*/
+bool LoadGridPartFromUGXB(Grid& grid, ISubsetHandler& sh, const char* filename,
+						  int part, int numParts);
+
+///	Converts a ugx file to a ugxb file
+/**	All grids, subset handlers, selectors, projection handlers and global
+ * attachments are transferred. Grids with hanging nodes are not supported.*/
+bool ConvertUGXToUGXB(const char* srcFilename, const char* destFilename);
+
+///	Converts a ugxb file to a ugx file
+bool ConvertUGXBToUGX(const char* srcFilename, const char* destFilename);
+
+
+////////////////////////////////////////////////////////////////////////
+///	Writes grids and associated data to ugxb files.
+/**	The interface matches GridWriterUGX. Make sure that all elements added
+ * via one of the add_* methods exist until the writer is destroyed.
+ *
+ * Grids containing constrained or constraining elements (hanging nodes)
+ * can't be written to ugxb files. Use GridWriterUGX for those.*/
+class GridWriterUGXB
+{
+	public:
+		GridWriterUGXB();
+		virtual ~GridWriterUGXB();
+
+	/**	TPositionAttachments value type has to be compatible with MathVector.
+	 *	Make sure that aPos is attached to the vertices of the grid.*/
+		template <class TPositionAttachment>
+		bool add_grid(Grid& grid, const char* name,
+					  TPositionAttachment& aPos);
+
+		void add_subset_handler(ISubsetHandler& sh, const char* name,
+								size_t refGridIndex);
+
+		void add_selector(ISelector& sel, const char* name,
+						  size_t refGridIndex);
+
+		void add_projection_handler(ProjectionHandler& ph, const char* name,
+									size_t refGridIndex);
+
+		bool write_to_file(const char* filename);
+
+	protected:
+		struct Block{
+			UGXBBlockInfo		info;
+			std::string			name;
+			std::string			infoStr;
+			std::vector<char>	data;
+		};
+
+		struct Entry{
+			Entry() : grid(NULL), numSelectors(0), numProjectionHandlers(0)	{}
+			Entry(Grid* g) : grid(g), numSelectors(0), numProjectionHandlers(0)	{}
+			Grid* grid;
+			std::vector<const ISubsetHandler*> subsetHandlers;
+			int numSelectors;
+			int numProjectionHandlers;
+		};
+
+	protected:
+	///	appends a new block and returns it
+		Block& new_block(UGXBBlockType type, int grid, const char* name = "");
+
+	///	assigns indices to all elements of the grid and checks for unsupported elements
+		void init_grid_attachments(Grid& grid);
+
+		template <class TElem>
+		void add_element_block(Grid& grid, int gridIndex);
+
+		template <class TElem>
+		void add_subset_elements(const ISubsetHandler& sh, int shIndex,
+								 int si, int gridIndex);
+
+		template <class TElem>
+		void add_selector_elements(const ISelector& sel, int selIndex,
+								   int gridIndex);
+
+		void add_projector(RefinementProjector& proj, int phIndex, int si,
+						   bool isDefault, int gridIndex);
+
+		template <class TElem>
+		void add_global_attachments(Grid& grid, int gridIndex);
+
+	protected:
+		std::vector<Block>	m_blocks;
+		std::vector<Entry>	m_vEntries;
+
+	///	attached to the elements of each grid during add_grid
+		AInt	m_aInt;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+///	Grants read access to ugxb files.
+/**	The file is memory mapped (or read en-block on systems without mmap).
+ * No parsing is performed, the blocks are accessed through the index at
+ * the end of the file. The interface matches GridReaderUGX.*/
+class GridReaderUGXB
+{
+	public:
+		GridReaderUGXB();
+		virtual ~GridReaderUGXB();
+
+	///	maps the given file and reads its index
+		bool open_file(const char* filename);
+
+	///	releases the mapping
+		void close_file();
+
+	///	returns the number of grids
+		inline size_t num_grids() const	{return m_entries.size();}
+
+	///	fills the given grid with the elements of the i-th grid.
+		template <class TPositionAttachment>
+		bool grid(Grid& gridOut, size_t index, TPositionAttachment& aPos);
+
+	///	fills the given grid with the part-th of numParts parts of the i-th grid
+	/**	\sa LoadGridPartFromUGXB*/
+		template <class TPositionAttachment>
+		bool grid_part(Grid& gridOut, size_t index, TPositionAttachment& aPos,
+					   int part, int numParts);
+
+	///	returns the name of the i-th grid
+		const char* get_grid_name(size_t index) const;
+
+	///	returns the dimension of the positions of the i-th grid
+		size_t grid_world_dimension(size_t index) const;
+
+	///	returns the number of subset handlers for the given grid
+		size_t num_subset_handlers(size_t refGridIndex) const;
+
+	///	returns the name of the given subset handler
+		const char* get_subset_handler_name(size_t refGridIndex,
+											size_t subsetHandlerIndex) const;
+
+	///	fills the given subset-handler
+		bool subset_handler(ISubsetHandler& shOut,
+							size_t subsetHandlerIndex,
+							size_t refGridIndex);
+
+	///	returns the number of selectors for the given grid
+		size_t num_selectors(size_t refGridIndex) const;
+
+	///	returns the name of the given selector
+		const char* get_selector_name(size_t refGridIndex, size_t selectorIndex) const;
+
+	///	fills the given selector
+		bool selector(ISelector& selOut, size_t selectorIndex, size_t refGridIndex);
+
+	///	returns the number of projection-handlers for the given grid
+		size_t num_projection_handlers(size_t refGridIndex) const;
+
+	///	returns the name of the given projection-handler
+		const char* get_projection_handler_name(size_t refGridIndex, size_t phIndex) const;
+
+	///	returns the subset handler index for a projection handler
+		size_t get_projection_handler_subset_handler_index(size_t phIndex, size_t refGridIndex);
+
+	///	fills the given projection-handler
+		bool projection_handler(ProjectionHandler& phOut, size_t phIndex, size_t refGridIndex);
+
+	///	direct access to the blocks of the file
+	/// \{
+		inline size_t num_blocks() const					{return m_numBlocks;}
+		inline const UGXBBlockInfo& block_info(size_t i) const	{return m_blockInfos[i];}
+		inline const char* block_data(size_t i) const		{return m_data + m_blockInfos[i].offset;}
+		std::string block_name(size_t i) const;
+		std::string block_info_string(size_t i) const;
+	/// \}
+
+	protected:
+		struct GridEntry
+		{
+			GridEntry(size_t b) : block(b), grid(NULL)	{}
+			size_t				block;
+			Grid*				grid;
+			std::vector<size_t>	vertexBlocks;
+			std::vector<size_t>	elementBlocks[4];
+			std::vector<size_t>	attachmentBlocks;
+			std::vector<size_t>	subsetHandlerBlocks;
+			std::vector<size_t>	selectorBlocks;
+			std::vector<size_t>	projectionHandlerBlocks;
+			std::vector<Vertex*>	vertices;
+			std::vector<Edge*>		edges;
+			std::vector<Face*>		faces;
+			std::vector<Volume*>	volumes;
+		};
+
+	protected:
+	///	sorts the blocks into grid entries
+		bool init_entries();
+
+	///	creates the vertices of the given grid entry. vrtMask may be empty.
+		template <class TAAPos>
+		void create_vertices(GridEntry& ge, Grid& grid, TAAPos aaPos,
+							 const std::vector<char>& vrtMask);
+
+	///	creates the elements of a base object type. elemMask may be empty.
+		template <class TElem>
+		void create_elements(GridEntry& ge, Grid& grid,
+							 std::vector<TElem*>& elemsOut,
+							 const std::vector<char>& elemMask);
+
+	///	creates an element of the given reference object type
+		GridObject* create_element(Grid& grid, int roid, Vertex** corners);
+
+	///	marks the elements of a part and the vertices and sides they need
+		void select_part(GridEntry& ge, int part, int numParts,
+						 std::vector<char> elemMasks[4]);
+
+		template <class TElem>
+		void read_attachment(Grid& grid, size_t block, std::vector<TElem*>& elems);
+
+		void read_attachments(GridEntry& ge, Grid& grid);
+
+		template <class TElem>
+		void read_subset_elements(ISubsetHandler& shOut, size_t block, int si,
+								  std::vector<TElem*>& elems);
+
+		template <class TElem>
+		void read_selector_elements(ISelector& selOut, size_t block,
+									std::vector<TElem*>& elems);
+
+		SPRefinementProjector read_projector(size_t block);
+
+		template <class TElem>
+		std::vector<TElem*>& elements(GridEntry& ge);
+
+		const GridEntry& grid_entry(size_t refGridIndex) const;
+
+	protected:
+		const char*				m_data;
+		size_t					m_size;
+		bool					m_bMapped;
+		std::vector<char>		m_buffer;
+		const UGXBBlockInfo*	m_blockInfos;
+		size_t					m_numBlocks;
+		const char*				m_strings;
+		std::vector<GridEntry>	m_entries;
+};
+
+}//	end of namespace
+
+////////////////////////////////
+//	include implementation
+#include "file_io_ugxb_impl.hpp"
+
+#endif
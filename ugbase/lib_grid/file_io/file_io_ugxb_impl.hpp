@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_UGXB_IMPL__
+#define __H__LIB_GRID__FILE_IO_UGXB_IMPL__
+
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "lib_grid/global_attachments.h"
+#include "common/util/binary_buffer.h"
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+template <class TAPosition>
+bool SaveGridToUGXB(Grid& grid, ISubsetHandler& sh, const char* filename,
+					TAPosition& aPos)
+{
+	GridWriterUGXB ugxbWriter;
+	ugxbWriter.add_grid(grid, "defGrid", aPos);
+	ugxbWriter.add_subset_handler(sh, "defSH", 0);
+
+	return ugxbWriter.write_to_file(filename);
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TAPosition>
+bool LoadGridFromUGXB(Grid& grid, SPProjectionHandler& ph, size_t& num_ph,
+					  ISubsetHandler& sh, std::vector<std::string> additionalSHNames,
+					  std::vector<SmartPtr<ISubsetHandler> > ash,
+					  const char* filename, TAPosition& aPos)
+{
+	GridReaderUGXB ugxbReader;
+	if(!ugxbReader.open_file(filename)){
+		UG_LOG("ERROR in LoadGridFromUGXB: Can't read file: " << filename << std::endl);
+		return false;
+	}
+
+	if(ugxbReader.num_grids() < 1){
+		UG_LOG("ERROR in LoadGridFromUGXB: File contains no grid.\n");
+		return false;
+	}
+
+	if(!ugxbReader.grid(grid, 0, aPos))
+		return false;
+
+	if(ugxbReader.num_subset_handlers(0) > 0)
+		ugxbReader.subset_handler(sh, 0, 0);
+
+	for(size_t i_name = 0; i_name < additionalSHNames.size(); ++i_name){
+		for(size_t i_sh = 0; i_sh < ugxbReader.num_subset_handlers(0); ++i_sh){
+			if(additionalSHNames[i_name] == ugxbReader.get_subset_handler_name(0, i_sh))
+				ugxbReader.subset_handler(*ash[i_name], i_sh, 0);
+		}
+	}
+
+	if(ugxbReader.num_projection_handlers(0) > 0){
+		ugxbReader.projection_handler(*ph, 0, 0);
+		size_t shIndex = ugxbReader.get_projection_handler_subset_handler_index(0, 0);
+		std::string shName = ugxbReader.get_subset_handler_name(0, shIndex);
+
+		if(shIndex > 0){
+			for(size_t i_name = 0; i_name < additionalSHNames.size(); ++i_name)
+				if(shName == additionalSHNames[i_name]){
+					try {ph->set_subset_handler(ash[i_name]);}
+					UG_CATCH_THROW("Additional subset handler '"<< shName << "' has not been added to the domain.\n"
+									"Do so by using Domain::create_additional_subset_handler(std::string name).");
+				}
+		}
+	}
+
+	return true;
+}
+
+template <class TAPosition>
+bool LoadGridFromUGXB(Grid& grid, ISubsetHandler& sh, const char* filename,
+					  TAPosition& aPos)
+{
+	GridReaderUGXB ugxbReader;
+	if(!ugxbReader.open_file(filename)){
+		UG_LOG("ERROR in LoadGridFromUGXB: Can't read file: " << filename << std::endl);
+		return false;
+	}
+
+	if(ugxbReader.num_grids() < 1){
+		UG_LOG("ERROR in LoadGridFromUGXB: File contains no grid.\n");
+		return false;
+	}
+
+	if(!ugxbReader.grid(grid, 0, aPos))
+		return false;
+
+	if(ugxbReader.num_subset_handlers(0) > 0)
+		ugxbReader.subset_handler(sh, 0, 0);
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	implementation of GridWriterUGXB
+template <class TPositionAttachment>
+bool GridWriterUGXB::
+add_grid(Grid& grid, const char* name, TPositionAttachment& aPos)
+{
+	typedef typename TPositionAttachment::ValueType TPos;
+
+	if(!grid.has_vertex_attachment(aPos)){
+		UG_LOG("  position attachment missing in grid " << name << std::endl);
+		return false;
+	}
+
+	Grid::VertexAttachmentAccessor<TPositionAttachment> aaPos(grid, aPos);
+
+	const int gridIndex = (int)m_vEntries.size();
+	init_grid_attachments(grid);
+	m_vEntries.push_back(Entry(&grid));
+
+	Block& gridBlock = new_block(UGXB_GRID, gridIndex, name);
+	gridBlock.info.index = (int32)TPos::Size;
+
+//	write vertices. Since only regular vertices are supported, the order
+//	of the vertex-iterator matches the indices assigned in init_grid_attachments.
+	if(grid.num<Vertex>() > 0){
+		Block& b = new_block(UGXB_VERTICES, gridIndex);
+		b.info.valueType = UGXB_FLOAT64;
+		b.info.objType = VERTEX;
+		b.info.tupleSize = TPos::Size;
+		b.info.count = grid.num<Vertex>();
+		b.data.resize(b.info.count * TPos::Size * sizeof(double));
+
+		double* p = reinterpret_cast<double*>(&b.data.front());
+		for(VertexIterator iter = grid.begin<Vertex>(); iter != grid.end<Vertex>(); ++iter){
+			const TPos& v = aaPos[*iter];
+			for(size_t i = 0; i < TPos::Size; ++i)
+				*p++ = v[i];
+		}
+	}
+
+//	write elements in the order in which the indices were assigned
+	add_element_block<RegularEdge>(grid, gridIndex);
+	add_element_block<Triangle>(grid, gridIndex);
+	add_element_block<Quadrilateral>(grid, gridIndex);
+	add_element_block<Tetrahedron>(grid, gridIndex);
+	add_element_block<Hexahedron>(grid, gridIndex);
+	add_element_block<Prism>(grid, gridIndex);
+	add_element_block<Pyramid>(grid, gridIndex);
+	add_element_block<Octahedron>(grid, gridIndex);
+
+	add_global_attachments<Vertex>(grid, gridIndex);
+	add_global_attachments<Edge>(grid, gridIndex);
+	add_global_attachments<Face>(grid, gridIndex);
+	add_global_attachments<Volume>(grid, gridIndex);
+
+	return true;
+}
+
+template <class TElem>
+void GridWriterUGXB::
+add_element_block(Grid& grid, int gridIndex)
+{
+	typedef typename geometry_traits<TElem>::iterator iterator;
+	static const size_t numCorners = TElem::NUM_VERTICES;
+
+	if(grid.num<TElem>() == 0)
+		return;
+
+	Block& b = new_block(UGXB_ELEMENTS, gridIndex);
+	b.info.valueType = UGXB_INT32;
+	b.info.index = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+	b.info.objType = geometry_traits<TElem>::BASE_OBJECT_ID;
+	b.info.tupleSize = numCorners;
+	b.info.count = grid.num<TElem>();
+	b.data.resize(b.info.count * numCorners * sizeof(int32));
+
+	Grid::VertexAttachmentAccessor<AInt> aaInd(grid, m_aInt);
+	int32* p = reinterpret_cast<int32*>(&b.data.front());
+	for(iterator iter = grid.begin<TElem>(); iter != grid.end<TElem>(); ++iter){
+		TElem* e = *iter;
+		for(size_t i = 0; i < numCorners; ++i)
+			*p++ = aaInd[e->vertex(i)];
+	}
+}
+
+template <class TElem>
+void GridWriterUGXB::
+add_subset_elements(const ISubsetHandler& sh, int shIndex, int si, int gridIndex)
+{
+	typedef typename geometry_traits<TElem>::const_iterator iterator;
+
+	Grid& grid = *sh.grid();
+	Grid::AttachmentAccessor<TElem, AInt> aaInd(grid, m_aInt);
+
+	std::vector<int32> vInd;
+	GridObjectCollection goc = sh.get_grid_objects_in_subset(si);
+	for(size_t lvl = 0; lvl < goc.num_levels(); ++lvl)
+		for(iterator iter = goc.begin<TElem>(lvl); iter != goc.end<TElem>(lvl); ++iter)
+			vInd.push_back(aaInd[*iter]);
+
+	if(vInd.empty())
+		return;
+
+	Block& b = new_block(UGXB_SUBSET_ELEMENTS, gridIndex);
+	b.info.valueType = UGXB_INT32;
+	b.info.owner = shIndex;
+	b.info.index = si;
+	b.info.objType = TElem::BASE_OBJECT_ID;
+	b.info.tupleSize = 1;
+	b.info.count = vInd.size();
+	b.data.resize(vInd.size() * sizeof(int32));
+	memcpy(&b.data.front(), &vInd.front(), b.data.size());
+}
+
+template <class TElem>
+void GridWriterUGXB::
+add_selector_elements(const ISelector& sel, int selIndex, int gridIndex)
+{
+	typedef typename geometry_traits<TElem>::const_iterator iterator;
+
+	Grid& grid = *sel.grid();
+	Grid::AttachmentAccessor<TElem, AInt> aaInd(grid, m_aInt);
+
+	std::vector<int32> vInd;
+	GridObjectCollection goc = sel.get_grid_objects();
+	for(size_t lvl = 0; lvl < goc.num_levels(); ++lvl){
+		for(iterator iter = goc.begin<TElem>(lvl); iter != goc.end<TElem>(lvl); ++iter){
+			vInd.push_back(aaInd[*iter]);
+			vInd.push_back((int32)sel.get_selection_status(*iter));
+		}
+	}
+
+	if(vInd.empty())
+		return;
+
+	Block& b = new_block(UGXB_SELECTOR_ELEMENTS, gridIndex);
+	b.info.valueType = UGXB_INT32;
+	b.info.owner = selIndex;
+	b.info.objType = TElem::BASE_OBJECT_ID;
+	b.info.tupleSize = 2;
+	b.info.count = vInd.size() / 2;
+	b.data.resize(vInd.size() * sizeof(int32));
+	memcpy(&b.data.front(), &vInd.front(), b.data.size());
+}
+
+template <class TElem>
+void GridWriterUGXB::
+add_global_attachments(Grid& grid, int gridIndex)
+{
+	typedef typename geometry_traits<TElem>::iterator iterator;
+	const std::vector<std::string>& attachmentNames =
+				GlobalAttachments::declared_attachment_names();
+
+	for(size_t ia = 0; ia < attachmentNames.size(); ++ia){
+		const std::string& name = attachmentNames[ia];
+		if(!GlobalAttachments::is_attached<TElem>(grid, name))
+			continue;
+
+	//	each value is serialized separately, so that a partial read can pick
+	//	the values of the loaded elements through the offset table.
+		GridDataSerializationHandler handler;
+		GlobalAttachments::add_data_serializer<TElem>(handler, grid, name);
+
+	//	values are written in the order of the indices assigned in init_grid_attachments
+		Grid::AttachmentAccessor<TElem, AInt> aaInd(grid, m_aInt);
+		std::vector<TElem*> elems(grid.num<TElem>());
+		for(iterator iter = grid.begin<TElem>(); iter != grid.end<TElem>(); ++iter)
+			elems[aaInd[*iter]] = *iter;
+
+		BinaryBuffer buf;
+		handler.write_infos(buf);
+
+		std::vector<uint64> offsets;
+		offsets.reserve(elems.size() + 1);
+		for(size_t i = 0; i < elems.size(); ++i){
+			offsets.push_back(buf.write_pos());
+			handler.serialize(buf, elems[i]);
+		}
+		offsets.push_back(buf.write_pos());
+
+		Block& b = new_block(UGXB_ATTACHMENT, gridIndex, name.c_str());
+		b.infoStr = GlobalAttachments::type_name(name);
+		b.info.valueType = UGXB_BYTE;
+		b.info.objType = TElem::BASE_OBJECT_ID;
+		b.info.index = (int32)GlobalAttachments::attachment_pass_on_behaviour(name);
+		b.info.tupleSize = 1;
+		b.info.count = grid.num<TElem>();
+
+		const size_t offsetBytes = offsets.size() * sizeof(uint64);
+		b.data.resize(offsetBytes + buf.write_pos());
+		memcpy(&b.data.front(), &offsets.front(), offsetBytes);
+		if(buf.write_pos() > 0)
+			memcpy(&b.data.front() + offsetBytes, buf.buffer(), buf.write_pos());
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	implementation of GridReaderUGXB
+template <class TPositionAttachment>
+bool GridReaderUGXB::
+grid(Grid& gridOut, size_t index, TPositionAttachment& aPos)
+{
+	return grid_part(gridOut, index, aPos, 0, 1);
+}
+
+template <class TPositionAttachment>
+bool GridReaderUGXB::
+grid_part(Grid& gridOut, size_t index, TPositionAttachment& aPos,
+		  int part, int numParts)
+{
+	if(num_grids() <= index){
+		UG_LOG("  GridReaderUGXB::grid: bad grid index!\n");
+		return false;
+	}
+
+	UG_COND_THROW(numParts < 1 || part < 0 || part >= numParts,
+				  "GridReaderUGXB: invalid part " << part << " of " << numParts);
+
+	Grid& grid = gridOut;
+	GridEntry& ge = m_entries[index];
+	ge.grid = &grid;
+
+//	as in GridReaderUGX, all grid options are disabled during creation
+	uint gridopts = grid.get_options();
+	grid.set_options(GRIDOPT_NONE);
+
+	if(!grid.has_vertex_attachment(aPos))
+		grid.attach_to_vertices(aPos);
+
+	Grid::VertexAttachmentAccessor<TPositionAttachment> aaPos(grid, aPos);
+
+//	masks are left empty if the whole grid is read
+	std::vector<char> vMasks[4];
+	if(numParts > 1)
+		select_part(ge, part, numParts, vMasks);
+
+	create_vertices(ge, grid, aaPos, vMasks[VERTEX]);
+	create_elements<Edge>(ge, grid, ge.edges, vMasks[EDGE]);
+	create_elements<Face>(ge, grid, ge.faces, vMasks[FACE]);
+	create_elements<Volume>(ge, grid, ge.volumes, vMasks[VOLUME]);
+
+	read_attachments(ge, grid);
+
+	grid.set_options(gridopts);
+	return true;
+}
+
+template <class TAAPos>
+void GridReaderUGXB::
+create_vertices(GridEntry& ge, Grid& grid, TAAPos aaPos,
+				const std::vector<char>& vrtMask)
+{
+	typedef typename TAAPos::ValueType TPos;
+
+	ge.vertices.clear();
+	for(size_t ib = 0; ib < ge.vertexBlocks.size(); ++ib){
+		const UGXBBlockInfo& info = block_info(ge.vertexBlocks[ib]);
+		const double* p = reinterpret_cast<const double*>(block_data(ge.vertexBlocks[ib]));
+		const size_t tupleSize = info.tupleSize;
+	//	TPos::Size is not defined out of class and must not be bound to a reference
+		const size_t posDim = TPos::Size;
+		const size_t numCoords = std::min(tupleSize, posDim);
+
+		for(uint64 i = 0; i < info.count; ++i, p += tupleSize){
+			if(!vrtMask.empty() && !vrtMask[ge.vertices.size()]){
+				ge.vertices.push_back(NULL);
+				continue;
+			}
+
+			Vertex* vrt = *grid.create<RegularVertex>();
+			TPos& v = aaPos[vrt];
+			size_t d = 0;
+			for(; d < numCoords; ++d)
+				v[d] = p[d];
+			for(; d < TPos::Size; ++d)
+				v[d] = 0;
+			ge.vertices.push_back(vrt);
+		}
+	}
+}
+
+template <class TElem>
+void GridReaderUGXB::
+create_elements(GridEntry& ge, Grid& grid, std::vector<TElem*>& elemsOut,
+				const std::vector<char>& elemMask)
+{
+	elemsOut.clear();
+	const std::vector<size_t>& blocks = ge.elementBlocks[TElem::BASE_OBJECT_ID];
+	Vertex* corners[MAX_VOLUME_VERTICES];
+
+	for(size_t ib = 0; ib < blocks.size(); ++ib){
+		const UGXBBlockInfo& info = block_info(blocks[ib]);
+		const int32* p = reinterpret_cast<const int32*>(block_data(blocks[ib]));
+		const size_t numCorners = info.tupleSize;
+		UG_COND_THROW(numCorners > MAX_VOLUME_VERTICES,
+					  "GridReaderUGXB: Bad number of corners in element block: "
+					  << numCorners);
+
+		for(uint64 i = 0; i < info.count; ++i, p += numCorners){
+			if(!elemMask.empty() && !elemMask[elemsOut.size()]){
+				elemsOut.push_back(NULL);
+				continue;
+			}
+
+			for(size_t j = 0; j < numCorners; ++j){
+				UG_COND_THROW(p[j] < 0 || p[j] >= (int32)ge.vertices.size()
+							  || !ge.vertices[p[j]],
+							  "GridReaderUGXB: Bad vertex index in element block: " << p[j]);
+				corners[j] = ge.vertices[p[j]];
+			}
+
+			elemsOut.push_back(static_cast<TElem*>(
+									create_element(grid, info.index, corners)));
+		}
+	}
+}
+
+template <class TElem>
+void GridReaderUGXB::
+read_attachment(Grid& grid, size_t block, std::vector<TElem*>& elems)
+{
+	const UGXBBlockInfo& info = block_info(block);
+	std::string name = block_name(block);
+	std::string type = block_info_string(block);
+
+	if(!GlobalAttachments::is_declared(name)){
+		if(GlobalAttachments::type_is_registered(type))
+			GlobalAttachments::declare_attachment(name, type, info.index != 0);
+		else
+			return;
+	}
+
+	UG_COND_THROW(type.compare(GlobalAttachments::type_name(name)) != 0,
+				  "Attachment type mismatch. Expecting type: " <<
+				  GlobalAttachments::type_name(name)
+				  << ", but given type is: " << type);
+
+	UG_COND_THROW(info.count != elems.size(),
+				  "GridReaderUGXB: Attachment '" << name << "' holds " << info.count
+				  << " values, but " << elems.size() << " elements were read.");
+
+	GlobalAttachments::attach<TElem>(grid, name);
+
+	const uint64* offsets = reinterpret_cast<const uint64*>(block_data(block));
+	const size_t offsetBytes = (info.count + 1) * sizeof(uint64);
+	const size_t dataSize = info.size - offsetBytes;
+
+	BinaryBuffer buf(dataSize);
+	buf.write(block_data(block) + offsetBytes, dataSize);
+
+	GridDataSerializationHandler handler;
+	GlobalAttachments::add_data_serializer<TElem>(handler, grid, name);
+	handler.deserialization_starts();
+	handler.read_infos(buf);
+	for(size_t i = 0; i < elems.size(); ++i){
+		if(!elems[i])
+			continue;
+		buf.set_read_pos(offsets[i]);
+		handler.deserialize(buf, elems[i]);
+	}
+	handler.deserialization_done();
+}
+
+template <class TElem>
+void GridReaderUGXB::
+read_subset_elements(ISubsetHandler& shOut, size_t block, int si,
+					 std::vector<TElem*>& elems)
+{
+	const UGXBBlockInfo& info = block_info(block);
+	const int32* p = reinterpret_cast<const int32*>(block_data(block));
+	for(uint64 i = 0; i < info.count; ++i){
+		UG_COND_THROW(p[i] < 0 || p[i] >= (int32)elems.size(),
+					  "GridReaderUGXB: Bad element index in subset block: " << p[i]);
+		if(elems[p[i]])
+			shOut.assign_subset(elems[p[i]], si);
+	}
+}
+
+template <class TElem>
+void GridReaderUGXB::
+read_selector_elements(ISelector& selOut, size_t block,
+					   std::vector<TElem*>& elems)
+{
+	const UGXBBlockInfo& info = block_info(block);
+	const int32* p = reinterpret_cast<const int32*>(block_data(block));
+	for(uint64 i = 0; i < info.count; ++i, p += 2){
+		UG_COND_THROW(p[0] < 0 || p[0] >= (int32)elems.size(),
+					  "GridReaderUGXB: Bad element index in selector block: " << p[0]);
+		if(elems[p[0]])
+			selOut.select(elems[p[0]], (byte)p[1]);
+	}
+}
+
+template <> inline std::vector<Vertex*>& GridReaderUGXB::
+elements<Vertex>(GridEntry& ge)		{return ge.vertices;}
+
+template <> inline std::vector<Edge*>& GridReaderUGXB::
+elements<Edge>(GridEntry& ge)		{return ge.edges;}
+
+template <> inline std::vector<Face*>& GridReaderUGXB::
+elements<Face>(GridEntry& ge)		{return ge.faces;}
+
+template <> inline std::vector<Volume*>& GridReaderUGXB::
+elements<Volume>(GridEntry& ge)		{return ge.volumes;}
+
+}//	end of namespace
+
+#endif
@@ -418,6 +418,18 @@ class UG_API Grid
 		template <class TGeomObj>
 		void reserve(size_t num);
 
+	///	Sorts the elements of the given base type with the given comparison.
+	/**	The elements of each concrete type (e.g. Triangle, Quadrilateral) are
+	 * sorted separately. cmp has to compare two pointers to TBaseElem.
+	 * Afterwards the data attached to the elements is stored in the new
+	 * order of the elements, so that traversals of the elements access
+	 * the attached data consecutively.
+	 * Element pointers and iterators remain valid. Attachment data arrays
+	 * obtained through get_data_array are invalidated.
+	 * \sa SortGridElementsBySFC*/
+		template <class TBaseElem, class TCompare>
+		void sort_elements(TCompare cmp);
+
 	////////////////////////////////////////////////
 	//	element deletion
 		void erase(GridObject* geomObj);
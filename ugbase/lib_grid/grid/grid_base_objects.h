@@ -44,6 +44,7 @@
 #include "lib_grid/attachments/attached_list.h"
 #include "common/util/hash_function.h"
 #include "common/allocators/small_object_allocator.h"
+#include "common/allocators/slab_allocator.h"
 #include "common/math/ugmath_types.h"
 #include "common/util/pointer_const_array.h"
 
@@ -151,9 +152,13 @@ template<> class attachment_traits<Volume*, ElementStorage<Volume> >;
  * In order to be used by libGrid, all derivatives of GridObject
  * have to specialize geometry_traits<GeomObjectType>.
  *
+ * GridObjects are allocated through SlabAllocator<GridObject>. Objects of
+ * the same concrete type are thus stored consecutively in memory in the order
+ * of their creation.
+ *
  * \ingroup lib_grid_grid_objects
  */
-class UG_API GridObject/* : public SmallObject<>*/
+class UG_API GridObject : public SlabObject<GridObject>
 {
 	friend class Grid;
 	friend class attachment_traits<Vertex*, ElementStorage<Vertex> >;
@@ -136,6 +136,18 @@ void Grid::reserve(size_t num)
 	element_storage<TGeomObj>().m_attachmentPipe.reserve(num);
 }
 
+template <class TBaseElem, class TCompare>
+void Grid::sort_elements(TCompare cmp)
+{
+	typename traits<TBaseElem>::SectionContainer& secCon =
+									element_storage<TBaseElem>().m_sectionContainer;
+
+	for(int i = 0; i < secCon.num_sections(); ++i)
+		secCon.sort_section(i, cmp);
+
+	element_storage<TBaseElem>().m_attachmentPipe.align_data_with_elements();
+}
+
 ////////////////////////////////////////////////////////////////////////
 //	erase
 template <class GeomObjIter>
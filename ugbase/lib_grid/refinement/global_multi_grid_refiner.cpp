@@ -31,6 +31,7 @@
  */
 
 #include <cassert>
+#include <string>
 #include "common/profiler/profiler.h"
 #include "global_multi_grid_refiner.h"
 #include "lib_grid/algorithms/algorithms.h"
@@ -54,16 +55,242 @@ using namespace std;
 namespace ug
 {
 
+namespace{
+
+///	children and new vertices of a consecutive range of parents
+template <class TElem>
+struct RefinementChunk
+{
+	vector<TElem*>	children;
+///	for each parent: the new inner vertex or NULL
+	vector<Vertex*>	newVrts;
+///	for each parent: the number of children. -1 if refinement failed.
+	vector<int>		numChildren;
+};
+
+///	splits an edge. Creates the new edge vertex too.
+class EdgeRefinement
+{
+	public:
+		EdgeRefinement(MultiGrid& mg) : m_mg(mg)	{}
+
+		bool operator()(Edge* e, vector<Edge*>& vEdgesOut, Vertex*& newVrtOut)
+		{
+			newVrtOut = new RegularVertex;
+			Vertex* substituteVrts[2];
+			substituteVrts[0] = m_mg.get_child_vertex(e->vertex(0));
+			substituteVrts[1] = m_mg.get_child_vertex(e->vertex(1));
+			return e->refine(vEdgesOut, newVrtOut, substituteVrts);
+		}
+
+	private:
+		MultiGrid&	m_mg;
+};
+
+///	refines a face, using the children of its vertices and edges
+class FaceRefinement
+{
+	public:
+		FaceRefinement(MultiGrid& mg) : m_mg(mg)	{}
+
+		bool operator()(Face* f, vector<Face*>& vFacesOut, Vertex*& newVrtOut)
+		{
+		//	collect child-vertices
+			m_vVrts.clear();
+			for(uint j = 0; j < f->num_vertices(); ++j)
+				m_vVrts.push_back(m_mg.get_child_vertex(f->vertex(j)));
+
+		//	collect the associated edges
+			m_vEdgeVrts.clear();
+			for(uint j = 0; j < f->num_edges(); ++j)
+				m_vEdgeVrts.push_back(m_mg.get_child_vertex(m_mg.get_edge(f, j)));
+
+			newVrtOut = NULL;
+			return f->refine(vFacesOut, &newVrtOut, &m_vEdgeVrts.front(), NULL,
+							 &m_vVrts.front());
+		}
+
+	private:
+		MultiGrid&		m_mg;
+		vector<Vertex*>	m_vVrts;
+		vector<Vertex*>	m_vEdgeVrts;
+};
+
+///	refines a volume, using the children of its vertices, edges and faces
+class VolumeRefinement
+{
+	public:
+		VolumeRefinement(MultiGrid& mg, IGeometry3d* geom) :
+			m_mg(mg), m_geom(geom), m_corners(6, vector3(0, 0, 0))	{}
+
+		bool operator()(Volume* v, vector<Volume*>& vVolsOut, Vertex*& newVrtOut)
+		{
+		//	collect child-vertices
+			m_vVrts.clear();
+			for(uint j = 0; j < v->num_vertices(); ++j)
+				m_vVrts.push_back(m_mg.get_child_vertex(v->vertex(j)));
+
+		//	collect the associated edges
+			m_vEdgeVrts.clear();
+			for(uint j = 0; j < v->num_edges(); ++j)
+				m_vEdgeVrts.push_back(m_mg.get_child_vertex(m_mg.get_edge(v, j)));
+
+		//	collect associated face-vertices
+			m_vFaceVrts.clear();
+			for(uint j = 0; j < v->num_faces(); ++j)
+				m_vFaceVrts.push_back(m_mg.get_child_vertex(m_mg.get_face(v, j)));
+
+		//	if we're performing tetrahedral or octahedral refinement, we have to collect
+		//	the corner coordinates, so that the refinement algorithm may choose
+		//	the best interior diagonal.
+			vector3* pCorners = NULL;
+			if((v->num_vertices() == 4) && m_geom){
+				for(size_t i = 0; i < 4; ++i){
+					m_corners[i] = m_geom->pos(v->vertex(i));
+				}
+				pCorners = &m_corners.front();
+			}
+			if((v->reference_object_id() == ROID_OCTAHEDRON) && m_geom){
+				for(size_t i = 0; i < 6; ++i){
+					m_corners[i] = m_geom->pos(v->vertex(i));
+				}
+				pCorners = &m_corners.front();
+			}
+
+			newVrtOut = NULL;
+			return v->refine(vVolsOut, &newVrtOut, &m_vEdgeVrts.front(),
+							 &m_vFaceVrts.front(), NULL, RegularVertex(),
+							 &m_vVrts.front(), pCorners);
+		}
+
+	private:
+		MultiGrid&		m_mg;
+		IGeometry3d*	m_geom;
+		vector<Vertex*>	m_vVrts;
+		vector<Vertex*>	m_vEdgeVrts;
+		vector<Vertex*>	m_vFaceVrts;
+		vector<vector3>	m_corners;
+};
+
+///	deletes the children and new vertices of the given chunks and clears them
+template <class TElem>
+void DeleteChildren(vector<RefinementChunk<TElem> >& chunks)
+{
+	for(size_t i = 0; i < chunks.size(); ++i){
+		RefinementChunk<TElem>& chunk = chunks[i];
+		for(size_t j = 0; j < chunk.children.size(); ++j)
+			delete chunk.children[j];
+		for(size_t j = 0; j < chunk.newVrts.size(); ++j)
+			delete chunk.newVrts[j];
+	}
+	chunks.clear();
+}
+
+///	creates the children of all given parents.
+/**	The parents are split into one consecutive chunk per thread. Children are
+ * only created, not registered at the grid. This happens serially afterwards.
+ * If the creation fails, all children and new vertices created so far are
+ * deleted and an error is thrown.*/
+template <class TElem, class TRefinement>
+void CreateChildren(vector<RefinementChunk<TElem> >& chunksOut,
+					const vector<TElem*>& parents,
+					const TRefinement& refinement,
+					int numThreads)
+{
+	const int numChunks = max(1, min(numThreads, (int)parents.size()));
+	chunksOut.clear();
+	chunksOut.resize(numChunks);
+
+	bool bError = false;
+	std::string errMsg;
+
+	#ifdef UG_OPENMP
+	#pragma omp parallel for num_threads(numThreads) schedule(static, 1)
+	#endif
+	for(int i_chunk = 0; i_chunk < numChunks; ++i_chunk){
+		try{
+			RefinementChunk<TElem>& chunk = chunksOut[i_chunk];
+			const size_t begin = (parents.size() * i_chunk) / numChunks;
+			const size_t end = (parents.size() * (i_chunk + 1)) / numChunks;
+			chunk.newVrts.reserve(end - begin);
+			chunk.numChildren.reserve(end - begin);
+
+			TRefinement refine = refinement;
+			vector<TElem*> vChildren;
+			for(size_t i = begin; i < end; ++i){
+				Vertex* newVrt = NULL;
+				bool bRefined;
+				try{
+					bRefined = refine(parents[i], vChildren, newVrt);
+				}
+				catch(...){
+					delete newVrt;
+					throw;
+				}
+
+				if(bRefined){
+					chunk.children.insert(chunk.children.end(),
+										  vChildren.begin(), vChildren.end());
+					chunk.numChildren.push_back((int)vChildren.size());
+				}
+				else
+					chunk.numChildren.push_back(-1);
+				chunk.newVrts.push_back(newVrt);
+			}
+		}
+		catch(UGError& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (GlobalMultiGridRefinerCreateChildren)
+			#endif
+			{
+				bError = true;
+				errMsg = err.get_stacktrace();
+			}
+		}
+		catch(std::exception& err){
+			#ifdef UG_OPENMP
+			#pragma omp critical (GlobalMultiGridRefinerCreateChildren)
+			#endif
+			{
+				bError = true;
+				errMsg = err.what();
+			}
+		}
+	}
+
+	if(bError){
+	//	the children are not registered at the grid yet
+		DeleteChildren(chunksOut);
+		UG_THROW("GlobalMultiGridRefiner: creating child elements failed:\n"
+				 << errMsg);
+	}
+}
+
+///	returns the total number of children in the given chunks
+template <class TElem>
+size_t NumChildren(const vector<RefinementChunk<TElem> >& chunks)
+{
+	size_t num = 0;
+	for(size_t i = 0; i < chunks.size(); ++i)
+		num += chunks[i].children.size();
+	return num;
+}
+
+}//	end of anonymous namespace
+
+
 GlobalMultiGridRefiner::
 GlobalMultiGridRefiner(SPRefinementProjector projector) :
 	IRefiner(projector),
-	m_pMG(NULL)
+	m_pMG(NULL),
+	m_numThreads(1)
 {
 }
 
 GlobalMultiGridRefiner::
 GlobalMultiGridRefiner(MultiGrid& mg, SPRefinementProjector projector) :
-	IRefiner(projector)
+	IRefiner(projector),
+	m_numThreads(1)
 {
 	m_pMG = NULL;
 	assign_grid(mg);
@@ -80,6 +307,19 @@ void GlobalMultiGridRefiner::grid_to_be_destroyed(Grid* grid)
 	m_pMG = NULL;
 }
 
+void GlobalMultiGridRefiner::set_num_threads(int numThreads)
+{
+	UG_COND_THROW(numThreads < 1, "GlobalMultiGridRefiner::set_num_threads: number "
+				  "of threads has to be at least 1, but " << numThreads << " was given.");
+#ifndef UG_OPENMP
+	if(numThreads > 1){
+		UG_LOG("WARNING in GlobalMultiGridRefiner::set_num_threads: ug4 is compiled "
+			   "without OpenMP (cmake -DOPENMP=ON). Refinement stays serial.\n");
+	}
+#endif
+	m_numThreads = numThreads;
+}
+
 void GlobalMultiGridRefiner::assign_grid(MultiGrid& mg)
 {
 	assign_grid(&mg);
@@ -162,6 +402,15 @@ void GlobalMultiGridRefiner::perform_refinement()
 		}
 	}
 
+//	child elements are created concurrently. Grid::get_edge and Grid::get_face
+//	must not auto-enable options from inside a thread.
+	if(m_numThreads > 1){
+		if(mg.num_faces() > 0)
+			mg.enable_options(VRTOPT_STORE_ASSOCIATED_EDGES);
+		if(mg.num_volumes() > 0)
+			mg.enable_options(VRTOPT_STORE_ASSOCIATED_EDGES | VRTOPT_STORE_ASSOCIATED_FACES);
+	}
+
 	if(mg.num_levels() == 0)
 		return;
 
@@ -231,19 +480,6 @@ void GlobalMultiGridRefiner::perform_refinement()
 		mg.enable_hierarchical_insertion(true);
 
 
-//	some buffers
-	vector<Vertex*> vVrts;
-	vector<Vertex*> vEdgeVrts;
-	vector<Vertex*> vFaceVrts;
-	vector<Edge*>	vEdges;
-	vector<Face*>		vFaces;
-	vector<Volume*>		vVols;
-	
-//	some repeatedly used objects
-	EdgeDescriptor ed;
-	FaceDescriptor fd;
-	VolumeDescriptor vd;
-
 	UG_DLOG(LIB_GRID, 1, "  creating new vertices\n");
 
 //	create new vertices from marked vertices
@@ -256,195 +492,164 @@ void GlobalMultiGridRefiner::perform_refinement()
 		Vertex* v = *iter;
 
 	//	create a new vertex in the next layer.
-		//GMGR_PROFILE(GMGR_Refine_CreatingVertices);
 		Vertex* nVrt = *mg.create_by_cloning(v, v);
 
 	//	allow refCallback to calculate a new position
 		if(m_projector.valid())
 			m_projector->new_vertex(nVrt, v);
-		//GMGR_PROFILE_END();
 	}
 
-
+//	Edges, faces and volumes are refined in two steps each: First the
+//	children of all parents are created concurrently. Only the children of
+//	the lower dimensional parents have to be registered for this. Then the
+//	children are registered serially in the order of their parents.
 	UG_DLOG(LIB_GRID, 1, "  creating new edges\n");
 
-//	create new vertices and edges from marked edges
-	for(EdgeIterator iter = mg.begin<Edge>(oldTopLevel);
-		iter != mg.end<Edge>(oldTopLevel); ++iter)
 	{
-		if(!refinement_is_allowed(*iter))
-			continue;
+		vector<Edge*> parents;
+		parents.reserve(mg.num<Edge>(oldTopLevel));
+		for(EdgeIterator iter = mg.begin<Edge>(oldTopLevel);
+			iter != mg.end<Edge>(oldTopLevel); ++iter)
+		{
+			if(!refinement_is_allowed(*iter))
+				continue;
 
-	//	collect_objects_for_refine removed all edges that already were
-	//	refined. No need to check that again.
-		Edge* e = *iter;
+			Edge* e = *iter;
+			assert(refinement_is_allowed(e->vertex(0))
+					&& refinement_is_allowed(e->vertex(1)));
+			parents.push_back(e);
+		}
 
-	//	debug: make sure that both vertices may be refined
-/*		#ifdef UG_DEBUG
-			if(!refinement_is_allowed(e->vertex(0))
-				|| !refinement_is_allowed(e->vertex(1)))
-			{
-				UG_LOG("Can't refine edge between vertices ");
-				if(mg.has_vertex_attachment(aPosition)){
-					Grid::VertexAttachmentAccessor<APosition> aaPos(mg, aPosition);
-					UG_LOG(aaPos[e->vertex(0)] << " and " << aaPos[e->vertex(1)] << endl);
-				}
-				else if(mg.has_vertex_attachment(aPosition2)){
-					Grid::VertexAttachmentAccessor<APosition2> aaPos(mg, aPosition2);
-					UG_LOG(aaPos[e->vertex(0)] << " and " << aaPos[e->vertex(1)] << endl);
-				}
-				else if(mg.has_vertex_attachment(aPosition1)){
-					Grid::VertexAttachmentAccessor<APosition1> aaPos(mg, aPosition1);
-					UG_LOG(aaPos[e->vertex(0)] << " and " << aaPos[e->vertex(1)] << endl);
-				}
-			}
-		#endif // UG_DEBUG
-*/
+		vector<RefinementChunk<Edge> > chunks;
+		GMGR_PROFILE(GMGR_CreateEdges);
+		CreateChildren(chunks, parents, EdgeRefinement(mg), m_numThreads);
+		GMGR_PROFILE_END();
 
-		assert(refinement_is_allowed(e->vertex(0))
-				&& refinement_is_allowed(e->vertex(1)));
+		mg.reserve<Vertex>(mg.num<Vertex>() + parents.size());
+		mg.reserve<Edge>(mg.num<Edge>() + NumChildren(chunks));
 
-		//GMGR_PROFILE(GMGR_Refine_CreatingEdgeVertices);
-	//	create two new edges by edge-split
-		RegularVertex* nVrt = *mg.create<RegularVertex>(e);
+		GMGR_PROFILE(GMGR_RegisterEdges);
+		size_t parentInd = 0;
+		for(size_t i_chunk = 0; i_chunk < chunks.size(); ++i_chunk){
+			RefinementChunk<Edge>& chunk = chunks[i_chunk];
+			size_t childInd = 0;
+			for(size_t i = 0; i < chunk.numChildren.size(); ++i, ++parentInd){
+				Edge* e = parents[parentInd];
+				Vertex* nVrt = chunk.newVrts[i];
+				mg.register_element(nVrt, e);
 
-	//	allow refCallback to calculate a new position
-		if(m_projector.valid())
-			m_projector->new_vertex(nVrt, e);
-		//GMGR_PROFILE_END();
-
-	//	split the edge
-		//GMGR_PROFILE(GMGR_Refine_CreatingEdges);
-		Vertex* substituteVrts[2];
-		substituteVrts[0] = mg.get_child_vertex(e->vertex(0));
-		substituteVrts[1] = mg.get_child_vertex(e->vertex(1));
-
-		e->refine(vEdges, nVrt, substituteVrts);
-		assert((vEdges.size() == 2) && "RegularEdge refine produced wrong number of edges.");
-		mg.register_element(vEdges[0], e);
-		mg.register_element(vEdges[1], e);
-		//GMGR_PROFILE_END();
+			//	allow refCallback to calculate a new position
+				if(m_projector.valid())
+					m_projector->new_vertex(nVrt, e);
+
+				assert((chunk.numChildren[i] == 2) && "RegularEdge refine produced wrong number of edges.");
+				for(int j = 0; j < chunk.numChildren[i]; ++j, ++childInd)
+					mg.register_element(chunk.children[childInd], e);
+			}
+		}
+		GMGR_PROFILE_END();
 	}
 
 
 	UG_DLOG(LIB_GRID, 1, "  creating new faces\n");
 
-//	create new vertices and faces from marked faces
-	for(FaceIterator iter = mg.begin<Face>(oldTopLevel);
-		iter != mg.end<Face>(oldTopLevel); ++iter)
 	{
-		if(!refinement_is_allowed(*iter))
-			continue;
-			
-		Face* f = *iter;
-	//	collect child-vertices
-		vVrts.clear();
-		for(uint j = 0; j < f->num_vertices(); ++j)
-			vVrts.push_back(mg.get_child_vertex(f->vertex(j)));
-
-	//	collect the associated edges
-		vEdgeVrts.clear();
-		//bool bIrregular = false;
-		for(uint j = 0; j < f->num_edges(); ++j)
-			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(f, j)));
-
-		//GMGR_PROFILE(GMGR_Refine_CreatingFaces);
-		Vertex* newVrt;
-		if(f->refine(vFaces, &newVrt, &vEdgeVrts.front(), NULL, &vVrts.front())){
-		//	if a new vertex was generated, we have to register it
-			if(newVrt){
-				//GMGR_PROFILE(GMGR_Refine_CreatingVertices);
-				mg.register_element(newVrt, f);
-			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
-					m_projector->new_vertex(newVrt, f);
-				//GMGR_PROFILE_END();
-			}
-
-		//	register the new faces and assign status
-			for(size_t j = 0; j < vFaces.size(); ++j)
-				mg.register_element(vFaces[j], f);
+		vector<Face*> parents;
+		parents.reserve(mg.num<Face>(oldTopLevel));
+		for(FaceIterator iter = mg.begin<Face>(oldTopLevel);
+			iter != mg.end<Face>(oldTopLevel); ++iter)
+		{
+			if(refinement_is_allowed(*iter))
+				parents.push_back(*iter);
 		}
-		else{
-			LOG("  WARNING in Refine: could not refine face.\n");
+
+		vector<RefinementChunk<Face> > chunks;
+		GMGR_PROFILE(GMGR_CreateFaces);
+		CreateChildren(chunks, parents, FaceRefinement(mg), m_numThreads);
+		GMGR_PROFILE_END();
+
+		mg.reserve<Face>(mg.num<Face>() + NumChildren(chunks));
+
+		GMGR_PROFILE(GMGR_RegisterFaces);
+		size_t parentInd = 0;
+		for(size_t i_chunk = 0; i_chunk < chunks.size(); ++i_chunk){
+			RefinementChunk<Face>& chunk = chunks[i_chunk];
+			size_t childInd = 0;
+			for(size_t i = 0; i < chunk.numChildren.size(); ++i, ++parentInd){
+				Face* f = parents[parentInd];
+				if(chunk.numChildren[i] < 0){
+					LOG("  WARNING in Refine: could not refine face.\n");
+					continue;
+				}
+
+			//	if a new vertex was generated, we have to register it
+				if(Vertex* newVrt = chunk.newVrts[i]){
+					mg.register_element(newVrt, f);
+				//	allow refCallback to calculate a new position
+					if(m_projector.valid())
+						m_projector->new_vertex(newVrt, f);
+				}
+
+			//	register the new faces and assign status
+				for(int j = 0; j < chunk.numChildren[i]; ++j, ++childInd)
+					mg.register_element(chunk.children[childInd], f);
+			}
 		}
-		//GMGR_PROFILE_END();
+		GMGR_PROFILE_END();
 	}
 
 
 	UG_DLOG(LIB_GRID, 1, "  creating new volumes\n");
 
-//	only used for tetrahedron or octahedron refinement
-	vector<vector3> corners(6, vector3(0, 0, 0));
-
-//	create new vertices and volumes from marked volumes
-	for(VolumeIterator iter = mg.begin<Volume>(oldTopLevel);
-		iter != mg.end<Volume>(oldTopLevel); ++iter)
 	{
-		if(!refinement_is_allowed(*iter))
-			continue;
-
-		Volume* v = *iter;
-		//GMGR_PROFILE(GMGR_Refining_Volume);
-
-	//	collect child-vertices
-		//GMGR_PROFILE(GMGR_CollectingVolumeVertices);
-		vVrts.clear();
-		for(uint j = 0; j < v->num_vertices(); ++j)
-			vVrts.push_back(mg.get_child_vertex(v->vertex(j)));
-		//GMGR_PROFILE_END();
-
-	//	collect the associated edges
-		vEdgeVrts.clear();
-		//GMGR_PROFILE(GMGR_CollectingVolumeEdgeVertices);
-		//bool bIrregular = false;
-		for(uint j = 0; j < v->num_edges(); ++j)
-			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(v, j)));
-		//GMGR_PROFILE_END();
-
-	//	collect associated face-vertices
-		vFaceVrts.clear();
-		//GMGR_PROFILE(GMGR_CollectingVolumeFaceVertices);
-		for(uint j = 0; j < v->num_faces(); ++j)
-			vFaceVrts.push_back(mg.get_child_vertex(mg.get_face(v, j)));
-		//GMGR_PROFILE_END();
-
-	//	if we're performing tetrahedral or octahedral refinement, we have to collect
-	//	the corner coordinates, so that the refinement algorithm may choose
-	//	the best interior diagonal.
-		vector3* pCorners = NULL;
-		if((v->num_vertices() == 4) && m_projector.valid()){
-			for(size_t i = 0; i < 4; ++i){
-				corners[i] = m_projector->geometry()->pos(v->vertex(i));
-			}
-			pCorners = &corners.front();
-		}
-		if((v->reference_object_id() == ROID_OCTAHEDRON) && m_projector.valid()){
-			for(size_t i = 0; i < 6; ++i){
-				corners[i] = m_projector->geometry()->pos(v->vertex(i));
-			}
-			pCorners = &corners.front();
+		vector<Volume*> parents;
+		parents.reserve(mg.num<Volume>(oldTopLevel));
+		for(VolumeIterator iter = mg.begin<Volume>(oldTopLevel);
+			iter != mg.end<Volume>(oldTopLevel); ++iter)
+		{
+			if(refinement_is_allowed(*iter))
+				parents.push_back(*iter);
 		}
 
-		Vertex* newVrt;
-		if(v->refine(vVols, &newVrt, &vEdgeVrts.front(), &vFaceVrts.front(),
-					NULL, RegularVertex(), &vVrts.front(), pCorners)){
-		//	if a new vertex was generated, we have to register it
-			if(newVrt){
-				mg.register_element(newVrt, v);
-			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
-					m_projector->new_vertex(newVrt, v);
-			}
+	//	the geometry is only used to choose the best interior diagonal of
+	//	tetrahedrons and octahedrons
+		IGeometry3d* geom = NULL;
+		if(m_projector.valid())
+			geom = m_projector->geometry().get();
 
-		//	register the new faces and assign status
-			for(size_t j = 0; j < vVols.size(); ++j)
-				mg.register_element(vVols[j], v);
-		}
-		else{
-			LOG("  WARNING in Refine: could not refine volume.\n");
+		vector<RefinementChunk<Volume> > chunks;
+		GMGR_PROFILE(GMGR_CreateVolumes);
+		CreateChildren(chunks, parents, VolumeRefinement(mg, geom), m_numThreads);
+		GMGR_PROFILE_END();
+
+		mg.reserve<Volume>(mg.num<Volume>() + NumChildren(chunks));
+
+		GMGR_PROFILE(GMGR_RegisterVolumes);
+		size_t parentInd = 0;
+		for(size_t i_chunk = 0; i_chunk < chunks.size(); ++i_chunk){
+			RefinementChunk<Volume>& chunk = chunks[i_chunk];
+			size_t childInd = 0;
+			for(size_t i = 0; i < chunk.numChildren.size(); ++i, ++parentInd){
+				Volume* v = parents[parentInd];
+				if(chunk.numChildren[i] < 0){
+					LOG("  WARNING in Refine: could not refine volume.\n");
+					continue;
+				}
+
+			//	if a new vertex was generated, we have to register it
+				if(Vertex* newVrt = chunk.newVrts[i]){
+					mg.register_element(newVrt, v);
+				//	allow refCallback to calculate a new position
+					if(m_projector.valid())
+						m_projector->new_vertex(newVrt, v);
+				}
+
+			//	register the new volumes and assign status
+				for(int j = 0; j < chunk.numChildren[i]; ++j, ++childInd)
+					mg.register_element(chunk.children[childInd], v);
+			}
 		}
-		//GMGR_PROFILE_END();
+		GMGR_PROFILE_END();
 	}
 
 //	done - clean up
@@ -44,6 +44,13 @@ namespace ug
 ///	\addtogroup lib_grid_algorithms_refinement
 ///	@{
 
+///	Refines all elements of the top level of a MultiGrid.
+/**	If ug4 was compiled with OpenMP, the child elements of each refinement
+ * phase (edges, faces, volumes) are built concurrently (see set_num_threads).
+ * Their registration at the grid and all observer notifications are
+ * performed serially afterwards in the order of the parents, so that the
+ * resulting grid is identical to the one of a serial refinement.
+ */
 class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 {
 	public:
@@ -67,6 +74,10 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 
 		virtual bool save_marks_to_file(const char* filename);
 
+	///	sets the number of threads used to build child elements (ignored without OpenMP)
+		void set_num_threads(int numThreads);
+		int num_threads() const					{return m_numThreads;}
+
 	protected:
 	///	returns the number of (globally) marked edges on this level of the hierarchy
 		virtual void num_marked_edges_local(std::vector<int>& numMarkedEdgesOut);
@@ -107,6 +118,7 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 		
 	protected:
 		MultiGrid*	m_pMG;
+		int			m_numThreads;
 };
 
 /// @}
@@ -141,6 +141,12 @@ class UG_API GridSubsetHandler : public ISubsetHandler
 		template <class TElem>
 		void clear_subset_elements(int subsetIndex);
 
+	///	sorts the elements of the given base type in each subset with the given comparison.
+	/**	The elements of each concrete type are sorted separately. cmp has to
+	 * compare two pointers to TBaseElem.*/
+		template <class TBaseElem, class TCompare>
+		void sort_elements(TCompare cmp);
+
 	//	geometric-object-collection
 		virtual GridObjectCollection
 		get_grid_objects_in_subset(int subsetIndex) const;
@@ -141,6 +141,22 @@ clear_subset_elements(int subsetIndex)
 	}
 }
 
+template <class TBaseElem, class TCompare>
+void
+GridSubsetHandler::
+sort_elements(TCompare cmp)
+{
+	if(m_pGrid == NULL)
+		return;
+
+	for(int si = 0; si < (int)num_subsets_in_list(); ++si){
+		typename Grid::traits<TBaseElem>::SectionContainer& secCon =
+											section_container<TBaseElem>(si);
+		for(int i = 0; i < secCon.num_sections(); ++i)
+			secCon.sort_section(i, cmp);
+	}
+}
+
 template <class TElem>
 uint
 GridSubsetHandler::
@@ -149,6 +149,12 @@ class UG_API MultiGridSubsetHandler : public ISubsetHandler
 		template <class TElem>
 		void clear_subset_elements(int subsetIndex, int level);
 
+	///	sorts the elements of the given base type in each subset and level with the given comparison.
+	/**	The elements of each concrete type are sorted separately. cmp has to
+	 * compare two pointers to TBaseElem.*/
+		template <class TBaseElem, class TCompare>
+		void sort_elements(TCompare cmp);
+
 	///	returns a GridObjectCollection
 	/**	the returned GridObjectCollection hold the elements of the
 	 *	specified subset on the given level.*/
@@ -151,6 +151,23 @@ clear_subset_elements(int subsetIndex, int level)
 	}
 }
 
+template <class TBaseElem, class TCompare>
+void MultiGridSubsetHandler::
+sort_elements(TCompare cmp)
+{
+	if(m_pGrid == NULL)
+		return;
+
+	for(int lvl = 0; lvl < (int)num_levels(); ++lvl){
+		for(int si = 0; si < (int)num_subsets_in_list(); ++si){
+			typename Grid::traits<TBaseElem>::SectionContainer& secCon =
+										section_container<TBaseElem>(si, lvl);
+			for(int i = 0; i < secCon.num_sections(); ++i)
+				secCon.sort_section(i, cmp);
+		}
+	}
+}
+
 template <class TElem>
 uint
 MultiGridSubsetHandler::
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "topology_snapshot.h"
+#include "surface_view.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+TopologySnapshot::
+TopologySnapshot() :
+	m_pMG(NULL),
+	m_bValid(false),
+	m_aID("TopologySnapshot_ID", false)
+{
+}
+
+TopologySnapshot::
+TopologySnapshot(MultiGrid& mg, int lvl) :
+	m_pMG(NULL),
+	m_bValid(false),
+	m_aID("TopologySnapshot_ID", false)
+{
+	build(mg, lvl);
+}
+
+TopologySnapshot::
+TopologySnapshot(SurfaceView& sv, const GridLevel& gl) :
+	m_pMG(NULL),
+	m_bValid(false),
+	m_aID("TopologySnapshot_ID", false)
+{
+	build(sv, gl);
+}
+
+TopologySnapshot::
+~TopologySnapshot()
+{
+	clear();
+}
+
+void TopologySnapshot::
+clear()
+{
+	if(m_pMG){
+		m_pMG->unregister_observer(this);
+		m_pMG->detach_from_all(m_aID);
+		m_aaID.invalidate();
+		m_pMG = NULL;
+	}
+
+	m_bValid = false;
+	for(int i = 0; i < 4; ++i){
+		m_adjVrt[i].clear();
+		m_adjEdge[i].clear();
+		m_adjFace[i].clear();
+		m_adjVol[i].clear();
+	}
+}
+
+void TopologySnapshot::
+init(MultiGrid& mg)
+{
+	clear();
+	m_pMG = &mg;
+	mg.attach_to_all_dv(m_aID, -1);
+	m_aaID.access(mg, m_aID);
+	mg.register_observer(this, OT_FULL_OBSERVER);
+}
+
+void TopologySnapshot::
+build(MultiGrid& mg, int lvl)
+{
+	PROFILE_FUNC_GROUP("grid");
+	init(mg);
+
+	if(lvl == GridLevel::TOP)
+		lvl = (int)mg.num_levels() - 1;
+
+	if(lvl >= 0 && lvl < (int)mg.num_levels()){
+		add_elements<Vertex>(mg.begin<Vertex>(lvl), mg.end<Vertex>(lvl));
+		add_elements<Edge>(mg.begin<Edge>(lvl), mg.end<Edge>(lvl));
+		add_elements<Face>(mg.begin<Face>(lvl), mg.end<Face>(lvl));
+		add_elements<Volume>(mg.begin<Volume>(lvl), mg.end<Volume>(lvl));
+	}
+
+	build_adjacencies();
+}
+
+void TopologySnapshot::
+build(SurfaceView& sv, const GridLevel& gl)
+{
+	MultiGrid& mg = *sv.subset_handler()->multi_grid();
+	if(gl.is_level()){
+		build(mg, gl.level());
+		return;
+	}
+
+	PROFILE_FUNC_GROUP("grid");
+	init(mg);
+
+	if(mg.num_levels() > 0){
+		add_elements<Vertex>(sv.begin<Vertex>(gl, SurfaceView::ALL),
+							 sv.end<Vertex>(gl, SurfaceView::ALL));
+		add_elements<Edge>(sv.begin<Edge>(gl, SurfaceView::ALL),
+						   sv.end<Edge>(gl, SurfaceView::ALL));
+		add_elements<Face>(sv.begin<Face>(gl, SurfaceView::ALL),
+						   sv.end<Face>(gl, SurfaceView::ALL));
+		add_elements<Volume>(sv.begin<Volume>(gl, SurfaceView::ALL),
+							 sv.end<Volume>(gl, SurfaceView::ALL));
+	}
+
+	build_adjacencies();
+}
+
+template <class TElem, class TIterator>
+void TopologySnapshot::
+add_elements(TIterator iter, TIterator iterEnd)
+{
+	std::vector<TElem*>& elems = adjacency_to<TElem>(TElem::dim).elems;
+	for(; iter != iterEnd; ++iter){
+		TElem* e = *iter;
+		m_aaID[e] = (int)elems.size();
+		elems.push_back(e);
+	}
+}
+
+template <class TElem>
+void TopologySnapshot::
+build_identity()
+{
+	Adjacency<TElem>& adj = adjacency_to<TElem>(TElem::dim);
+	const int numElems = (int)adj.elems.size();
+
+	adj.offsets.resize(numElems + 1);
+	adj.ids.resize(numElems);
+	for(int i = 0; i < numElems; ++i){
+		adj.offsets[i] = i;
+		adj.ids[i] = i;
+	}
+	adj.offsets[numElems] = numElems;
+}
+
+template <class TElem, class TAssElem>
+void TopologySnapshot::
+build_downward()
+{
+	const std::vector<TElem*>& elems = adjacency_to<TElem>(TElem::dim).elems;
+	Adjacency<TAssElem>& adj = adjacency_to<TAssElem>(TElem::dim);
+
+	adj.clear();
+	adj.offsets.reserve(elems.size() + 1);
+	adj.offsets.push_back(0);
+
+	typename Grid::traits<TAssElem>::secure_container assElems;
+	for(size_t i = 0; i < elems.size(); ++i){
+		m_pMG->associated_elements_sorted(assElems, elems[i]);
+		for(size_t j = 0; j < assElems.size(); ++j){
+			adj.elems.push_back(assElems[j]);
+			adj.ids.push_back(m_aaID[assElems[j]]);
+		}
+		adj.offsets.push_back((int)adj.ids.size());
+	}
+}
+
+template <class TElem, class TAssElem>
+void TopologySnapshot::
+build_upward()
+{
+//	the upward relation is the transpose of the downward relation from
+//	TAssElem to TElem. Entries of sub-elements outside the snapshot are skipped.
+	const int numElems = (int)adjacency_to<TElem>(TElem::dim).elems.size();
+	const std::vector<TAssElem*>& assElems = adjacency_to<TAssElem>(TAssElem::dim).elems;
+	const Adjacency<TElem>& down = adjacency_to<TElem>(TAssElem::dim);
+	Adjacency<TAssElem>& up = adjacency_to<TAssElem>(TElem::dim);
+
+	up.clear();
+	up.offsets.resize(numElems + 1, 0);
+	for(size_t k = 0; k < down.ids.size(); ++k)
+		if(down.ids[k] >= 0)
+			++up.offsets[down.ids[k] + 1];
+
+	for(int i = 0; i < numElems; ++i)
+		up.offsets[i + 1] += up.offsets[i];
+
+	up.ids.resize(up.offsets[numElems]);
+	up.elems.resize(up.offsets[numElems]);
+
+	std::vector<int> vPos(up.offsets.begin(), up.offsets.end() - 1);
+	for(size_t a = 0; a < assElems.size(); ++a){
+		for(int k = down.offsets[a]; k < down.offsets[a + 1]; ++k){
+			const int i = down.ids[k];
+			if(i < 0) continue;
+			up.ids[vPos[i]] = (int)a;
+			up.elems[vPos[i]] = assElems[a];
+			++vPos[i];
+		}
+	}
+}
+
+void TopologySnapshot::
+build_adjacencies()
+{
+	build_identity<Vertex>();
+	build_identity<Edge>();
+	build_identity<Face>();
+	build_identity<Volume>();
+
+	build_downward<Edge, Vertex>();
+	build_downward<Face, Vertex>();
+	build_downward<Face, Edge>();
+	build_downward<Volume, Vertex>();
+	build_downward<Volume, Edge>();
+	build_downward<Volume, Face>();
+
+	build_upward<Vertex, Edge>();
+	build_upward<Vertex, Face>();
+	build_upward<Vertex, Volume>();
+	build_upward<Edge, Face>();
+	build_upward<Edge, Volume>();
+	build_upward<Face, Volume>();
+
+	m_bValid = true;
+}
+
+size_t TopologySnapshot::
+occupied_memory() const
+{
+	size_t mem = 0;
+	for(int i = 0; i < 4; ++i){
+		mem += (m_adjVrt[i].offsets.capacity() + m_adjVrt[i].ids.capacity()) * sizeof(int)
+				+ m_adjVrt[i].elems.capacity() * sizeof(Vertex*);
+		mem += (m_adjEdge[i].offsets.capacity() + m_adjEdge[i].ids.capacity()) * sizeof(int)
+				+ m_adjEdge[i].elems.capacity() * sizeof(Edge*);
+		mem += (m_adjFace[i].offsets.capacity() + m_adjFace[i].ids.capacity()) * sizeof(int)
+				+ m_adjFace[i].elems.capacity() * sizeof(Face*);
+		mem += (m_adjVol[i].offsets.capacity() + m_adjVol[i].ids.capacity()) * sizeof(int)
+				+ m_adjVol[i].elems.capacity() * sizeof(Volume*);
+	}
+	return mem;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	grid observer callbacks
+void TopologySnapshot::
+grid_to_be_destroyed(Grid* grid)
+{
+	clear();
+}
+
+void TopologySnapshot::
+elements_to_be_cleared(Grid* grid)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent, bool replacesParent)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+edge_created(Grid* grid, Edge* e, GridObject* pParent, bool replacesParent)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+face_created(Grid* grid, Face* f, GridObject* pParent, bool replacesParent)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+volume_created(Grid* grid, Volume* vol, GridObject* pParent, bool replacesParent)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+vertex_to_be_erased(Grid* grid, Vertex* vrt, Vertex* replacedBy)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+face_to_be_erased(Grid* grid, Face* f, Face* replacedBy)
+{
+	m_bValid = false;
+}
+
+void TopologySnapshot::
+volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy)
+{
+	m_bValid = false;
+}
+
+}//	end of namespace
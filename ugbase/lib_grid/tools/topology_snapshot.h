@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_GRID__TOOLS__TOPOLOGY_SNAPSHOT__
+#define __H__UG__LIB_GRID__TOOLS__TOPOLOGY_SNAPSHOT__
+
+#include <vector>
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/grid/grid_observer.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "grid_level.h"
+
+namespace ug{
+
+class SurfaceView;
+
+/** \ingroup lib_grid_tools
+ *  \{ */
+
+///	A frozen, read-only view on the topology of a grid level or surface view
+/**	The snapshot assigns consecutive integer ids to all vertices, edges, faces
+ * and volumes of a multi-grid level or of a surface view and stores the
+ * adjacency between all of them in compressed-row (CSR) arrays. Downward
+ * relations (e.g. the edges of a face) are stored in the order of the
+ * reference element, i.e. they match Grid::associated_elements_sorted.
+ * Upward relations (e.g. the faces of a vertex) are ordered by element id.
+ *
+ * Element ids are accessible through an int attachment which the snapshot
+ * attaches to all elements of the underlying grid. Sub-elements which are
+ * not part of the snapshot (e.g. shadows of a surface view which are not
+ * contained in the view) have the id -1, their pointers are stored
+ * nevertheless.
+ *
+ * The snapshot registers itself as an observer at the grid. As soon as an
+ * element is created or erased, it is marked as invalid and all queries
+ * return -1 or false, so that callers can fall back to the
+ * regular grid methods. An invalid snapshot has to be rebuilt through
+ * one of the build methods.
+ *
+ * Level snapshots contain all elements of the given level, surface snapshots
+ * contain all elements of the surface view in the state SurfaceView::ALL.
+ */
+class UG_API TopologySnapshot : public GridObserver
+{
+	public:
+	///	CSR adjacency of one element dimension to elements of type TAssElem
+		template <class TAssElem>
+		struct Adjacency{
+			std::vector<int>		offsets;
+			std::vector<int>		ids;
+			std::vector<TAssElem*>	elems;
+
+			void clear();
+		};
+
+	public:
+		TopologySnapshot();
+		TopologySnapshot(MultiGrid& mg, int lvl);
+		TopologySnapshot(SurfaceView& sv, const GridLevel& gl);
+
+		virtual ~TopologySnapshot();
+
+	///	builds the snapshot for all elements of a level of the given multi grid
+		void build(MultiGrid& mg, int lvl);
+
+	///	builds the snapshot for all elements of a surface view on the given grid level
+	/**	If gl is a level grid level, the snapshot is built from all elements
+	 * of that level.*/
+		void build(SurfaceView& sv, const GridLevel& gl);
+
+	///	releases all arrays and detaches from the grid
+		void clear();
+
+	///	returns true if the snapshot has been built and the grid has not changed since
+		inline bool valid() const							{return m_bValid;}
+
+	///	returns the underlying multi grid (NULL if not built)
+		inline MultiGrid* multi_grid() const				{return m_pMG;}
+
+	///	number of elements of the given dimension in the snapshot
+		inline size_t num(int dim) const;
+
+		template <class TElem>
+		inline size_t num() const							{return num(TElem::dim);}
+
+	///	returns the id of an element or -1 if it is not contained in a valid snapshot
+	/// \{
+		inline int id(Vertex* e) const;
+		inline int id(Edge* e) const;
+		inline int id(Face* e) const;
+		inline int id(Volume* e) const;
+	/// \}
+
+	///	returns the element of the given id
+		template <class TElem>
+		inline typename TElem::grid_base_object* element(int id) const;
+
+	///	number of elements of dimension assDim associated with element (dim, id)
+		inline size_t num_associated(int dim, int id, int assDim) const;
+
+	///	ids of the elements of dimension assDim associated with element (dim, id)
+	/**	The returned array has num_associated(dim, id, assDim) entries. For
+	 * dim == assDim it contains the element itself.*/
+		inline const int* associated_ids(int dim, int id, int assDim) const;
+
+	///	fills a secure container with the associated elements of e without copying
+	/**	Returns false if the snapshot is invalid or if e is not contained in it.
+	 * Downward relations are sorted as in Grid::associated_elements_sorted.
+	 * The container references the snapshot's arrays and thus must not
+	 * be used after the snapshot is rebuilt, cleared or destroyed.
+	 * \{ */
+		template <class TElem>
+		inline bool associated_elements_sorted(Grid::traits<Vertex>::secure_container& elemsOut, TElem* e) const;
+		template <class TElem>
+		inline bool associated_elements_sorted(Grid::traits<Edge>::secure_container& elemsOut, TElem* e) const;
+		template <class TElem>
+		inline bool associated_elements_sorted(Grid::traits<Face>::secure_container& elemsOut, TElem* e) const;
+		template <class TElem>
+		inline bool associated_elements_sorted(Grid::traits<Volume>::secure_container& elemsOut, TElem* e) const;
+	/** \} */
+
+	///	returns the adjacency of elements of dimension dim to elements of type TAssElem
+		template <class TAssElem>
+		inline const Adjacency<TAssElem>& adjacency(int dim) const;
+
+	///	memory in bytes used by the adjacency arrays
+		size_t occupied_memory() const;
+
+	//	grid observer callbacks
+		virtual void grid_to_be_destroyed(Grid* grid);
+		virtual void elements_to_be_cleared(Grid* grid);
+
+		virtual void vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent = NULL,
+									bool replacesParent = false);
+		virtual void edge_created(Grid* grid, Edge* e, GridObject* pParent = NULL,
+									bool replacesParent = false);
+		virtual void face_created(Grid* grid, Face* f, GridObject* pParent = NULL,
+									bool replacesParent = false);
+		virtual void volume_created(Grid* grid, Volume* vol, GridObject* pParent = NULL,
+									bool replacesParent = false);
+
+		virtual void vertex_to_be_erased(Grid* grid, Vertex* vrt, Vertex* replacedBy = NULL);
+		virtual void edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy = NULL);
+		virtual void face_to_be_erased(Grid* grid, Face* f, Face* replacedBy = NULL);
+		virtual void volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy = NULL);
+
+	private:
+	//	copy construction and assignment are not supported
+		TopologySnapshot(const TopologySnapshot&);
+		TopologySnapshot& operator=(const TopologySnapshot&);
+
+	///	attaches the id attachment and registers at the grid
+		void init(MultiGrid& mg);
+
+	///	assigns ids, collects downward adjacencies and transposes them
+		void build_adjacencies();
+
+		template <class TElem, class TIterator>
+		void add_elements(TIterator iter, TIterator iterEnd);
+
+		template <class TElem>
+		void build_identity();
+
+		template <class TElem, class TAssElem>
+		void build_downward();
+
+		template <class TElem, class TAssElem>
+		void build_upward();
+
+		template <class TElem, class TAssElem>
+		inline bool associated(typename Grid::traits<TAssElem>::secure_container& elemsOut, TElem* e) const;
+
+		template <class TAssElem>
+		inline Adjacency<TAssElem>& adjacency_to(int dim);
+
+		inline const std::vector<int>& offsets(int dim, int assDim) const;
+		inline const std::vector<int>& ids(int dim, int assDim) const;
+
+	private:
+		MultiGrid*	m_pMG;
+		bool		m_bValid;
+
+	///	ids of the elements
+		AInt									m_aID;
+		MultiElementAttachmentAccessor<AInt>	m_aaID;
+
+	///	adjacency of elements of dimension i to vertices, edges, faces and volumes
+	/**	The entry of an element type to itself contains the identity and the
+	 * list of all elements of that type, indexed by id.*/
+		Adjacency<Vertex>	m_adjVrt[4];
+		Adjacency<Edge>		m_adjEdge[4];
+		Adjacency<Face>		m_adjFace[4];
+		Adjacency<Volume>	m_adjVol[4];
+};
+
+/** \} */
+
+}//	end of namespace
+
+#include "topology_snapshot_impl.hpp"
+
+#endif
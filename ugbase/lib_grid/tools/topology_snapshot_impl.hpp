@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: agent
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_GRID__TOOLS__TOPOLOGY_SNAPSHOT_IMPL__
+#define __H__UG__LIB_GRID__TOOLS__TOPOLOGY_SNAPSHOT_IMPL__
+
+namespace ug{
+
+template <class TAssElem>
+void TopologySnapshot::Adjacency<TAssElem>::clear()
+{
+	offsets.clear();
+	ids.clear();
+	elems.clear();
+}
+
+template <> inline const TopologySnapshot::Adjacency<Vertex>&
+TopologySnapshot::adjacency<Vertex>(int dim) const		{return m_adjVrt[dim];}
+
+template <> inline const TopologySnapshot::Adjacency<Edge>&
+TopologySnapshot::adjacency<Edge>(int dim) const		{return m_adjEdge[dim];}
+
+template <> inline const TopologySnapshot::Adjacency<Face>&
+TopologySnapshot::adjacency<Face>(int dim) const		{return m_adjFace[dim];}
+
+template <> inline const TopologySnapshot::Adjacency<Volume>&
+TopologySnapshot::adjacency<Volume>(int dim) const		{return m_adjVol[dim];}
+
+template <> inline TopologySnapshot::Adjacency<Vertex>&
+TopologySnapshot::adjacency_to<Vertex>(int dim)			{return m_adjVrt[dim];}
+
+template <> inline TopologySnapshot::Adjacency<Edge>&
+TopologySnapshot::adjacency_to<Edge>(int dim)			{return m_adjEdge[dim];}
+
+template <> inline TopologySnapshot::Adjacency<Face>&
+TopologySnapshot::adjacency_to<Face>(int dim)			{return m_adjFace[dim];}
+
+template <> inline TopologySnapshot::Adjacency<Volume>&
+TopologySnapshot::adjacency_to<Volume>(int dim)			{return m_adjVol[dim];}
+
+
+inline size_t TopologySnapshot::num(int dim) const
+{
+	switch(dim){
+		case VERTEX:	return m_adjVrt[VERTEX].elems.size();
+		case EDGE:		return m_adjEdge[EDGE].elems.size();
+		case FACE:		return m_adjFace[FACE].elems.size();
+		case VOLUME:	return m_adjVol[VOLUME].elems.size();
+		default:		UG_THROW("TopologySnapshot: invalid dimension " << dim);
+	}
+}
+
+inline int TopologySnapshot::id(Vertex* e) const	{return m_bValid ? m_aaID[e] : -1;}
+inline int TopologySnapshot::id(Edge* e) const		{return m_bValid ? m_aaID[e] : -1;}
+inline int TopologySnapshot::id(Face* e) const		{return m_bValid ? m_aaID[e] : -1;}
+inline int TopologySnapshot::id(Volume* e) const	{return m_bValid ? m_aaID[e] : -1;}
+
+template <class TElem>
+inline typename TElem::grid_base_object* TopologySnapshot::element(int id) const
+{
+	typedef typename TElem::grid_base_object TBaseElem;
+	UG_ASSERT(id >= 0 && id < (int)num<TBaseElem>(), "Invalid id: " << id);
+	return adjacency<TBaseElem>(TBaseElem::dim).elems[id];
+}
+
+inline const std::vector<int>& TopologySnapshot::offsets(int dim, int assDim) const
+{
+	switch(assDim){
+		case VERTEX:	return m_adjVrt[dim].offsets;
+		case EDGE:		return m_adjEdge[dim].offsets;
+		case FACE:		return m_adjFace[dim].offsets;
+		case VOLUME:	return m_adjVol[dim].offsets;
+		default:		UG_THROW("TopologySnapshot: invalid dimension " << assDim);
+	}
+}
+
+inline const std::vector<int>& TopologySnapshot::ids(int dim, int assDim) const
+{
+	switch(assDim){
+		case VERTEX:	return m_adjVrt[dim].ids;
+		case EDGE:		return m_adjEdge[dim].ids;
+		case FACE:		return m_adjFace[dim].ids;
+		case VOLUME:	return m_adjVol[dim].ids;
+		default:		UG_THROW("TopologySnapshot: invalid dimension " << assDim);
+	}
+}
+
+inline size_t TopologySnapshot::num_associated(int dim, int id, int assDim) const
+{
+	const std::vector<int>& o = offsets(dim, assDim);
+	UG_ASSERT(id >= 0 && id + 1 < (int)o.size(), "Invalid id: " << id);
+	return o[id + 1] - o[id];
+}
+
+inline const int* TopologySnapshot::associated_ids(int dim, int id, int assDim) const
+{
+	const std::vector<int>& vIDs = ids(dim, assDim);
+	const int first = offsets(dim, assDim)[id];
+	if(first == (int)vIDs.size()) return NULL;
+	return &vIDs[first];
+}
+
+template <class TElem, class TAssElem>
+inline bool TopologySnapshot::
+associated(typename Grid::traits<TAssElem>::secure_container& elemsOut, TElem* e) const
+{
+	typedef typename TElem::grid_base_object TBaseElem;
+
+	const int i = id(static_cast<TBaseElem*>(e));
+	if(i < 0) return false;
+
+	const Adjacency<TAssElem>& adj = adjacency<TAssElem>(TBaseElem::dim);
+	const int first = adj.offsets[i];
+	const int num = adj.offsets[i + 1] - first;
+	if(num > 0)	elemsOut.set_external_array(&adj.elems[first], num);
+	else		elemsOut.clear();
+	return true;
+}
+
+template <class TElem>
+inline bool TopologySnapshot::
+associated_elements_sorted(Grid::traits<Vertex>::secure_container& elemsOut, TElem* e) const
+{
+	return associated<TElem, Vertex>(elemsOut, e);
+}
+
+template <class TElem>
+inline bool TopologySnapshot::
+associated_elements_sorted(Grid::traits<Edge>::secure_container& elemsOut, TElem* e) const
+{
+	return associated<TElem, Edge>(elemsOut, e);
+}
+
+template <class TElem>
+inline bool TopologySnapshot::
+associated_elements_sorted(Grid::traits<Face>::secure_container& elemsOut, TElem* e) const
+{
+	return associated<TElem, Face>(elemsOut, e);
+}
+
+template <class TElem>
+inline bool TopologySnapshot::
+associated_elements_sorted(Grid::traits<Volume>::secure_container& elemsOut, TElem* e) const
+{
+	return associated<TElem, Volume>(elemsOut, e);
+}
+
+}//	end of namespace
+
+#endif
@@ -325,6 +325,24 @@ allreduce(const void* sendBuf, void* recBuf, int count,
 	MPI_Allreduce(const_cast<void*>(sendBuf), recBuf, count, type, op, m_comm->m_mpiComm);
 }
 
+void
+ProcessCommunicator::
+iallreduce(const void* sendBuf, void* recBuf, int count,
+		   DataType type, ReduceOperation op, MPI_Request& request) const
+{
+	PCL_PROFILE(pcl_ProcCom_iallreduce);
+	request = MPI_REQUEST_NULL;
+	if(is_local()) {memcpy(recBuf, sendBuf, count*GetSize(type)); return;}
+	UG_COND_THROW(empty(),	"ERROR in ProcessCommunicator::iallreduce: empty communicator.");
+
+#if MPI_VERSION >= 3
+	MPI_Iallreduce(const_cast<void*>(sendBuf), recBuf, count, type, op,
+				   m_comm->m_mpiComm, &request);
+#else
+	MPI_Allreduce(const_cast<void*>(sendBuf), recBuf, count, type, op, m_comm->m_mpiComm);
+#endif
+}
+
 size_t ProcessCommunicator::
 allreduce(const size_t &t, pcl::ReduceOperation op) const
 {
@@ -288,6 +288,15 @@ class ProcessCommunicator
 		void allreduce(const void* sendBuf, void* recBuf, int count,
 					   DataType type, ReduceOperation op) const;
 
+	///	starts a non-blocking MPI_Iallreduce on the processes of the communicator.
+	/**	The buffers have to stay valid until the request has been completed,
+	 * e.g. through pcl::MPI_Wait. If the MPI implementation does not support
+	 * non-blocking collectives, a blocking allreduce is performed and the
+	 * request is set to MPI_REQUEST_NULL.*/
+		void iallreduce(const void* sendBuf, void* recBuf, int count,
+						DataType type, ReduceOperation op,
+						MPI_Request& request) const;
+
 	/** simplified allreduce for size=1. calls allreduce for parameter t,
 	 * and then returns the result.
 	 * \param t the input parameter
@@ -35,6 +35,7 @@
 #include "ug.h"
 #include "common/error.h"
 #include "common/log.h"
+#include "common/util/async_file_writer.h"
 #include "common/util/path_provider.h"
 #include "common/util/os_info.h"
 #include "common/profiler/profiler.h"
@@ -262,6 +263,14 @@ int UGInit(int *argcp, char ***argvp, int parallelOutputProcRank)
 int UGFinalizeNoPCLFinalize()
 {
 	EnableMemTracker(false);
+
+//	make sure that all asynchronously written files are complete
+	try{
+		AsyncFileWriter::inst().flush();
+	}
+	catch(UGError& err){
+		UG_LOG("WARNING: " << err.get_msg() << "\n");
+	}
 	ug::GetLogAssistant().flush_error_log();
 	
 	if (outputProfileStats) {